@@ -0,0 +1,100 @@
+/**
+ * @file CPP_ADC.hpp
+ * @brief Canales de ADC resueltos en tiempo de compilación (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef CPP_ADC_HPP_
+#define CPP_ADC_HPP_
+
+#include "CPP_PIN.hpp"
+#include "HRI_ADC.h"
+
+/**
+ * @addtogroup CPP
+ * @{
+ */
+
+namespace lpc845
+{
+
+/**
+ * @brief Canal de ADC asociado a un pin
+ *
+ * La configuración del ADC en sí (clock, calibración y secuencias) se sigue haciendo con el @ref ADC del HAL. Esta
+ * clase resuelve en tiempo de compilación el canal correspondiente al pin, rechazando los pines sin función de ADC.
+ *
+ * @tparam pin_t Pin del canal (ver @ref Pin)
+ */
+template <typename pin_t>
+class AdcChannel
+{
+	static_assert(pin_t::ADC_CHANNEL >= 0, "El pin no tiene funcion de ADC");
+
+public:
+	static constexpr uint8_t CHANNEL = pin_t::ADC_CHANNEL; //!< Número de canal
+	static constexpr uint32_t MASK = (1UL << CHANNEL); //!< Máscara del canal para las secuencias de conversión
+
+	/**
+	 * @brief Habilitar la función analógica del pin
+	 *
+	 * Habilita la función fija en la *SWM* e inhabilita el pull-up/pull-down del pin, igual que
+	 * @ref hal_adc_sequence_config para cada canal de la secuencia.
+	 */
+	static inline void enable(void)
+	{
+		swm_fixed_enable<HAL_BOARD_ARG0(HAL_BOARD_FIXED_ADC_0) + CHANNEL>();
+
+		clock_enable<SYSCON_ENABLE_CLOCK_SEL_IOCON>();
+		pin_t::pull_mode(IOCON_PULL_NONE);
+		clock_disable<SYSCON_ENABLE_CLOCK_SEL_IOCON>();
+	}
+
+	/**
+	 * @brief Inhabilitar la función analógica del pin
+	 */
+	static inline void disable(void)
+	{
+		swm_fixed_disable<HAL_BOARD_ARG0(HAL_BOARD_FIXED_ADC_0) + CHANNEL>();
+	}
+
+	/**
+	 * @brief Leer el registro de datos del canal
+	 * @return Valor del registro *DAT* del canal
+	 */
+	static inline uint32_t read_raw(void)
+	{
+		return reg32<ADC_BASE + offsetof(ADC_per_t, DAT[CHANNEL])>();
+	}
+
+	/**
+	 * @brief Leer el resultado de la última conversión del canal
+	 * @return Resultado de 12 bits
+	 */
+	static inline uint16_t read(void)
+	{
+		return static_cast<uint16_t>((read_raw() >> 4) & 0x0FFF);
+	}
+
+	/**
+	 * @brief Consultar si hay un resultado nuevo para el canal
+	 *
+	 * La lectura del registro de datos borra el indicador, por lo que el resultado debe tomarse de @ref read_raw.
+	 *
+	 * @return Distinto de cero si el resultado no fue leído
+	 */
+	static inline uint32_t data_valid(void)
+	{
+		return read_raw() & (1UL << 31);
+	}
+};
+
+} // namespace lpc845
+
+/**
+ * @}
+ */
+
+#endif /* CPP_ADC_HPP_ */
@@ -0,0 +1,81 @@
+/**
+ * @file CPP_LPC845.hpp
+ * @brief Interfaz de plantillas de C++ sobre el HPL (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup CPP Interfaz de C++
+ *
+ * # Introducción
+ *
+ * Las funciones del HPL y del HAL reciben la instancia y el puerto/pin como enteros en tiempo de ejecución, por lo que
+ * cada llamado pasa por tablas (@ref IOCON_PIN_TABLE, el arreglo de periféricos *USART*) o por un *switch* según la
+ * instancia, aun cuando ésta es constante. Esta interfaz, formada únicamente por archivos de cabecera de C++17,
+ * representa los pines y los periféricos como tipos, de forma que las direcciones y máscaras se resuelven en tiempo
+ * de compilación y cada llamado se compila como uno o dos accesos a registros.
+ *
+ * Los tipos disponibles son:
+ * 	- @ref lpc845::Pin "Pin<puerto, pin>": GPIO e *IOCON* de un pin.
+ * 	- @ref lpc845::Usart "Usart<instancia>": registros de datos, estado y configuración y asignación de pines.
+ * 	- @ref lpc845::Spi "Spi<instancia>": registros de datos, estado y configuración y asignación de pines.
+ * 	- @ref lpc845::AdcChannel "AdcChannel<pin>": canal de ADC correspondiente a un pin.
+ * 	.
+ *
+ * # Verificaciones en tiempo de compilación
+ *
+ * Los usos incorrectos no compilan: pines inexistentes en el microcontrolador, instancias inexistentes, pines sin
+ * función de ADC, funciones que la instancia no tiene (RTS y CTS en la USART3 y USART4, SSEL2 y SSEL3 en la SPI1).
+ *
+ * ~~~{.cpp}
+ * #include <CPP_LPC845.hpp>
+ *
+ * using led = lpc845::Pin<1, 2>;
+ * using uart = lpc845::Usart<0>;
+ * using pote = lpc845::AdcChannel<lpc845::Pin<0, 7>>;
+ *
+ * int main(void)
+ * {
+ * 	led::output();
+ * 	led::set();
+ *
+ * 	uart::assign_txd<lpc845::Pin<0, 25>>();
+ * 	uart::assign_rxd<lpc845::Pin<0, 24>>();
+ *
+ * 	pote::enable();
+ *
+ * 	// lpc845::AdcChannel<lpc845::Pin<0, 8>> no compila: el pin no tiene función de ADC
+ * 	...
+ * }
+ * ~~~
+ *
+ * # Relación con el HAL
+ *
+ * La interfaz no reemplaza al HAL: el cálculo de baudrates, las colas de transmisión y recepción y las
+ * interrupciones se siguen manejando con los módulos del HAL, que pueden usarse en conjunto con esta interfaz ya que
+ * los archivos de cabecera de C tienen guardas *extern "C"*. Las posiciones de las funciones en la *SWM* se toman de
+ * las definiciones de @ref BOARD, por lo que ambas interfaces comparten una única descripción del hardware.
+ *
+ * @{
+ */
+
+#ifndef CPP_LPC845_HPP_
+#define CPP_LPC845_HPP_
+
+#if !defined (__cplusplus) || (__cplusplus < 201703L)
+#error "La interfaz de C++ de la libreria requiere C++17"
+#endif
+
+#include "CPP_REG.hpp"
+#include "CPP_PIN.hpp"
+#include "CPP_USART.hpp"
+#include "CPP_SPI.hpp"
+#include "CPP_ADC.hpp"
+
+#endif /* CPP_LPC845_HPP_ */
+
+/**
+ * @}
+ */
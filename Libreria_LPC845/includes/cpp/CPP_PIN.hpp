@@ -0,0 +1,234 @@
+/**
+ * @file CPP_PIN.hpp
+ * @brief Pines del microcontrolador resueltos en tiempo de compilación (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef CPP_PIN_HPP_
+#define CPP_PIN_HPP_
+
+#include "CPP_REG.hpp"
+#include "HRI_GPIO.h"
+#include "HRI_IOCON.h"
+#include "HPL_IOCON.h"
+
+/**
+ * @addtogroup CPP
+ * @{
+ */
+
+namespace lpc845
+{
+
+/**
+ * @brief Obtener la posición del registro de *IOCON* de un puerto/pin
+ *
+ * Los registros de *IOCON* no están ordenados por número de pin, por lo que la posición se obtiene de la estructura
+ * del HRI en lugar de la tabla @ref IOCON_PIN_TABLE.
+ *
+ * @param[in] portpin Puerto/pin
+ * @return Posición del registro respecto de la dirección base del *IOCON*
+ */
+constexpr uint32_t iocon_offset(uint8_t portpin)
+{
+	switch(portpin)
+	{
+	case 0: return offsetof(IOCON_per_t, PIO0_0);
+	case 1: return offsetof(IOCON_per_t, PIO0_1);
+	case 2: return offsetof(IOCON_per_t, PIO0_2);
+	case 3: return offsetof(IOCON_per_t, PIO0_3);
+	case 4: return offsetof(IOCON_per_t, PIO0_4);
+	case 5: return offsetof(IOCON_per_t, PIO0_5);
+	case 6: return offsetof(IOCON_per_t, PIO0_6);
+	case 7: return offsetof(IOCON_per_t, PIO0_7);
+	case 8: return offsetof(IOCON_per_t, PIO0_8);
+	case 9: return offsetof(IOCON_per_t, PIO0_9);
+	case 10: return offsetof(IOCON_per_t, PIO0_10);
+	case 11: return offsetof(IOCON_per_t, PIO0_11);
+	case 12: return offsetof(IOCON_per_t, PIO0_12);
+	case 13: return offsetof(IOCON_per_t, PIO0_13);
+	case 14: return offsetof(IOCON_per_t, PIO0_14);
+	case 15: return offsetof(IOCON_per_t, PIO0_15);
+	case 16: return offsetof(IOCON_per_t, PIO0_16);
+	case 17: return offsetof(IOCON_per_t, PIO0_17);
+	case 18: return offsetof(IOCON_per_t, PIO0_18);
+	case 19: return offsetof(IOCON_per_t, PIO0_19);
+	case 20: return offsetof(IOCON_per_t, PIO0_20);
+	case 21: return offsetof(IOCON_per_t, PIO0_21);
+	case 22: return offsetof(IOCON_per_t, PIO0_22);
+	case 23: return offsetof(IOCON_per_t, PIO0_23);
+	case 24: return offsetof(IOCON_per_t, PIO0_24);
+	case 25: return offsetof(IOCON_per_t, PIO0_25);
+	case 26: return offsetof(IOCON_per_t, PIO0_26);
+	case 27: return offsetof(IOCON_per_t, PIO0_27);
+	case 28: return offsetof(IOCON_per_t, PIO0_28);
+	case 29: return offsetof(IOCON_per_t, PIO0_29);
+	case 30: return offsetof(IOCON_per_t, PIO0_30);
+	case 31: return offsetof(IOCON_per_t, PIO0_31);
+	case 32: return offsetof(IOCON_per_t, PIO1_0);
+	case 33: return offsetof(IOCON_per_t, PIO1_1);
+	case 34: return offsetof(IOCON_per_t, PIO1_2);
+	case 35: return offsetof(IOCON_per_t, PIO1_3);
+	case 36: return offsetof(IOCON_per_t, PIO1_4);
+	case 37: return offsetof(IOCON_per_t, PIO1_5);
+	case 38: return offsetof(IOCON_per_t, PIO1_6);
+	case 39: return offsetof(IOCON_per_t, PIO1_7);
+	case 40: return offsetof(IOCON_per_t, PIO1_8);
+	case 41: return offsetof(IOCON_per_t, PIO1_9);
+	case 42: return offsetof(IOCON_per_t, PIO1_10);
+	case 43: return offsetof(IOCON_per_t, PIO1_11);
+	case 44: return offsetof(IOCON_per_t, PIO1_12);
+	case 45: return offsetof(IOCON_per_t, PIO1_13);
+	case 46: return offsetof(IOCON_per_t, PIO1_14);
+	case 47: return offsetof(IOCON_per_t, PIO1_15);
+	case 48: return offsetof(IOCON_per_t, PIO1_16);
+	case 49: return offsetof(IOCON_per_t, PIO1_17);
+	case 50: return offsetof(IOCON_per_t, PIO1_18);
+	case 51: return offsetof(IOCON_per_t, PIO1_19);
+	case 52: return offsetof(IOCON_per_t, PIO1_20);
+	case 53: return offsetof(IOCON_per_t, PIO1_21);
+	default: return 0;
+	}
+}
+
+/**
+ * @brief Obtener el canal de ADC de un puerto/pin
+ * @param[in] portpin Puerto/pin
+ * @return Canal de ADC del pin, o -1 si el pin no tiene función de ADC
+ */
+constexpr int8_t adc_channel_of(uint8_t portpin)
+{
+	switch(portpin)
+	{
+	case HAL_BOARD_PORTPIN(0, 7): return 0;
+	case HAL_BOARD_PORTPIN(0, 6): return 1;
+	case HAL_BOARD_PORTPIN(0, 14): return 2;
+	case HAL_BOARD_PORTPIN(0, 23): return 3;
+	case HAL_BOARD_PORTPIN(0, 22): return 4;
+	case HAL_BOARD_PORTPIN(0, 21): return 5;
+	case HAL_BOARD_PORTPIN(0, 20): return 6;
+	case HAL_BOARD_PORTPIN(0, 19): return 7;
+	case HAL_BOARD_PORTPIN(0, 18): return 8;
+	case HAL_BOARD_PORTPIN(0, 17): return 9;
+	case HAL_BOARD_PORTPIN(0, 13): return 10;
+	case HAL_BOARD_PORTPIN(0, 4): return 11;
+	default: return -1;
+	}
+}
+
+/**
+ * @brief Pin del microcontrolador
+ *
+ * Todas las funciones son estáticas y operan sobre direcciones y máscaras constantes, por lo que cada una se compila
+ * como uno o dos accesos a registros.
+ *
+ * @tparam port Número de puerto
+ * @tparam pin Número de pin
+ */
+template <uint8_t port, uint8_t pin>
+class Pin
+{
+	static_assert(((port == 0) && (pin < 32)) || ((port == 1) && (pin < 22)), "Puerto/pin inexistente en el LPC845");
+
+public:
+	static constexpr uint8_t PORT = port; //!< Número de puerto
+	static constexpr uint8_t PIN = pin; //!< Número de pin
+	static constexpr uint8_t PORTPIN = HAL_BOARD_PORTPIN(port, pin); //!< Número de puerto/pin
+	static constexpr uint32_t MASK = (1UL << pin); //!< Máscara del pin dentro de los registros del puerto
+	static constexpr int8_t ADC_CHANNEL = adc_channel_of(PORTPIN); //!< Canal de ADC, o -1 si no tiene
+
+	/**
+	 * @brief Poner el pin en estado alto
+	 */
+	static inline void set(void)
+	{
+		reg32<GPIO_BASE + offsetof(GPIO_per_t, SET[port])>() = MASK;
+	}
+
+	/**
+	 * @brief Poner el pin en estado bajo
+	 */
+	static inline void clear(void)
+	{
+		reg32<GPIO_BASE + offsetof(GPIO_per_t, CLR[port])>() = MASK;
+	}
+
+	/**
+	 * @brief Invertir el estado del pin
+	 */
+	static inline void toggle(void)
+	{
+		reg32<GPIO_BASE + offsetof(GPIO_per_t, NOT[port])>() = MASK;
+	}
+
+	/**
+	 * @brief Escribir el estado del pin
+	 * @param[in] value Estado a escribir
+	 */
+	static inline void write(uint8_t value)
+	{
+		*reinterpret_cast<volatile uint8_t *>(GPIO_BASE + offsetof(GPIO_per_t, B) + PORTPIN) = value;
+	}
+
+	/**
+	 * @brief Leer el estado del pin
+	 * @return Estado del pin
+	 */
+	static inline uint8_t read(void)
+	{
+		return *reinterpret_cast<volatile uint8_t *>(GPIO_BASE + offsetof(GPIO_per_t, B) + PORTPIN);
+	}
+
+	/**
+	 * @brief Configurar el pin como salida
+	 */
+	static inline void output(void)
+	{
+		reg32<GPIO_BASE + offsetof(GPIO_per_t, DIRSET[port])>() = MASK;
+	}
+
+	/**
+	 * @brief Configurar el pin como entrada
+	 */
+	static inline void input(void)
+	{
+		reg32<GPIO_BASE + offsetof(GPIO_per_t, DIRCLR[port])>() = MASK;
+	}
+
+	/**
+	 * @brief Escribir un conjunto de campos del registro de *IOCON* del pin
+	 *
+	 * El clock del *IOCON* debe estar habilitado (ver @ref IOCON_init).
+	 *
+	 * @param[in] flags Combinación de las configuraciones *HAL_BOARD_IOCON_xxx*
+	 * @param[in] mask Campos a escribir
+	 */
+	static inline void iocon(uint32_t flags, uint32_t mask = HAL_BOARD_IOCON_MASK)
+	{
+		volatile uint32_t &reg = reg32<IOCON_BASE + iocon_offset(PORTPIN)>();
+
+		reg = (reg & ~mask) | (flags & mask);
+	}
+
+	/**
+	 * @brief Configurar modo de funcionamiento (pull up, pull down, etc) del pin
+	 *
+	 * El clock del *IOCON* debe estar habilitado (ver @ref IOCON_init).
+	 *
+	 * @param[in] pull_mode Modo de funcionamiento
+	 */
+	static inline void pull_mode(IOCON_pull_mode_en pull_mode)
+	{
+		iocon(static_cast<uint32_t>(pull_mode) << 3, HAL_BOARD_IOCON_PULL_REPEATER);
+	}
+};
+
+} // namespace lpc845
+
+/**
+ * @}
+ */
+
+#endif /* CPP_PIN_HPP_ */
@@ -0,0 +1,169 @@
+/**
+ * @file CPP_REG.hpp
+ * @brief Acceso a registros con direcciones conocidas en tiempo de compilación (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef CPP_REG_HPP_
+#define CPP_REG_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "HRI_SYSCON.h"
+#include "HRI_SWM.h"
+#include "HPL_SYSCON.h"
+#include "HAL_BOARD.h"
+
+/**
+ * @addtogroup CPP
+ * @{
+ */
+
+namespace lpc845
+{
+
+/**
+ * @brief Obtener una referencia a un registro de 32 bits
+ *
+ * A diferencia de los punteros a periféricos del HRI, que se definen en otra unidad de compilación, la dirección es
+ * una constante del programa, por lo que el acceso se compila como un único *load* o *store*.
+ *
+ * @tparam address Dirección del registro
+ * @return Referencia al registro
+ */
+template <uint32_t address>
+static inline volatile uint32_t &reg32(void)
+{
+	static_assert((address % 4) == 0, "Registro de 32 bits desalineado");
+
+	return *reinterpret_cast<volatile uint32_t *>(address);
+}
+
+/**
+ * @brief Obtener una referencia a un periférico
+ * @tparam per_t Tipo de la estructura de registros del periférico
+ * @tparam base Dirección base del periférico
+ * @return Referencia a la estructura de registros
+ */
+template <typename per_t, uint32_t base>
+static inline volatile per_t &peripheral(void)
+{
+	return *reinterpret_cast<volatile per_t *>(base);
+}
+
+/**
+ * @brief Habilitar el clock de un periférico
+ * @tparam sel Periférico a habilitar
+ */
+template <SYSCON_enable_clock_sel_en sel>
+static inline void clock_enable(void)
+{
+	if constexpr(sel < 32)
+	{
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, SYSAHBCLKCTRL0)>() |= (1UL << sel);
+	}
+	else
+	{
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, SYSAHBCLKCTRL1)>() |= (1UL << (sel - 32));
+	}
+}
+
+/**
+ * @brief Inhabilitar el clock de un periférico
+ * @tparam sel Periférico a inhabilitar
+ */
+template <SYSCON_enable_clock_sel_en sel>
+static inline void clock_disable(void)
+{
+	if constexpr(sel < 32)
+	{
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, SYSAHBCLKCTRL0)>() &= ~(1UL << sel);
+	}
+	else
+	{
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, SYSAHBCLKCTRL1)>() &= ~(1UL << (sel - 32));
+	}
+}
+
+/**
+ * @brief Generar un pulso de reset en un periférico
+ * @tparam sel Periférico a resetear
+ */
+template <SYSCON_reset_sel_en sel>
+static inline void reset_pulse(void)
+{
+	if constexpr(sel < 32)
+	{
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, PRESETCTRL0)>() &= ~(1UL << sel);
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, PRESETCTRL0)>() |= (1UL << sel);
+	}
+	else
+	{
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, PRESETCTRL1)>() &= ~(1UL << (sel - 32));
+		reg32<SYSCON_BASE + offsetof(SYSCON_per_t, PRESETCTRL1)>() |= (1UL << (sel - 32));
+	}
+}
+
+/**
+ * @brief Asignar una función movible a un puerto/pin
+ *
+ * Habilita el clock de la *SWM* únicamente durante la escritura, igual que las funciones de inicialización del HAL.
+ *
+ * @tparam index Posición del byte de la función dentro de los registros *PINASSIGN* (ver *HAL_BOARD_FUNC_xxx*)
+ * @tparam portpin Puerto/pin a asignar
+ */
+template <uint8_t index, uint8_t portpin>
+static inline void swm_assign(void)
+{
+	static_assert(index < (HAL_BOARD_PINASSIGN_REGS * 4), "Funcion movible inexistente");
+	static_assert(portpin <= HAL_BOARD_PORTPIN_LAST, "Puerto/pin inexistente");
+
+	constexpr uint32_t address = SWM_BASE + offsetof(SWM_per_t, PINASSIGN0) + ((index / 4) * 4);
+	constexpr uint32_t shift = (index % 4) * 8;
+
+	clock_enable<SYSCON_ENABLE_CLOCK_SEL_SWM>();
+	reg32<address>() = (reg32<address>() & ~(0xFFUL << shift)) | (static_cast<uint32_t>(portpin) << shift);
+	clock_disable<SYSCON_ENABLE_CLOCK_SEL_SWM>();
+}
+
+/**
+ * @brief Habilitar una función fija
+ * @tparam bit Posición del bit de la función dentro de los registros *PINENABLE* (ver *HAL_BOARD_FIXED_xxx*)
+ */
+template <uint8_t bit>
+static inline void swm_fixed_enable(void)
+{
+	static_assert(bit < 64, "Funcion fija inexistente");
+
+	constexpr uint32_t address = SWM_BASE + offsetof(SWM_per_t, PINENABLE0) + ((bit / 32) * 4);
+
+	clock_enable<SYSCON_ENABLE_CLOCK_SEL_SWM>();
+	reg32<address>() &= ~(1UL << (bit % 32));
+	clock_disable<SYSCON_ENABLE_CLOCK_SEL_SWM>();
+}
+
+/**
+ * @brief Inhabilitar una función fija
+ * @tparam bit Posición del bit de la función dentro de los registros *PINENABLE* (ver *HAL_BOARD_FIXED_xxx*)
+ */
+template <uint8_t bit>
+static inline void swm_fixed_disable(void)
+{
+	static_assert(bit < 64, "Funcion fija inexistente");
+
+	constexpr uint32_t address = SWM_BASE + offsetof(SWM_per_t, PINENABLE0) + ((bit / 32) * 4);
+
+	clock_enable<SYSCON_ENABLE_CLOCK_SEL_SWM>();
+	reg32<address>() |= (1UL << (bit % 32));
+	clock_disable<SYSCON_ENABLE_CLOCK_SEL_SWM>();
+}
+
+} // namespace lpc845
+
+/**
+ * @}
+ */
+
+#endif /* CPP_REG_HPP_ */
@@ -0,0 +1,213 @@
+/**
+ * @file CPP_SPI.hpp
+ * @brief Instancias de SPI resueltas en tiempo de compilación (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef CPP_SPI_HPP_
+#define CPP_SPI_HPP_
+
+#include "CPP_REG.hpp"
+#include "HRI_SPI.h"
+
+/**
+ * @addtogroup CPP
+ * @{
+ */
+
+namespace lpc845
+{
+
+/**
+ * @brief Instancia de SPI
+ *
+ * Resuelve en tiempo de compilación la dirección base, el clock, el reset y las posiciones de la *SWM* de la
+ * instancia.
+ *
+ * @tparam inst Instancia de SPI (0 o 1)
+ */
+template <uint8_t inst>
+class Spi
+{
+	static_assert(inst < 2, "Instancia de SPI inexistente");
+
+	static constexpr uint32_t BASES[] = { SPI0_BASE, SPI1_BASE };
+	static constexpr SYSCON_enable_clock_sel_en CLOCKS[] = { SYSCON_ENABLE_CLOCK_SEL_SPI0, SYSCON_ENABLE_CLOCK_SEL_SPI1 };
+	static constexpr SYSCON_reset_sel_en RESETS[] = { SYSCON_RESET_SEL_SPI0, SYSCON_RESET_SEL_SPI1 };
+
+	static constexpr uint8_t SCK[] = { HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_SCK), HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI1_SCK) };
+	static constexpr uint8_t MOSI[] = { HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_MOSI), HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI1_MOSI) };
+	static constexpr uint8_t MISO[] = { HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_MISO), HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI1_MISO) };
+
+	static constexpr uint8_t SSEL[2][4] =
+	{
+		{
+			HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_SSEL0), HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_SSEL1),
+			HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_SSEL2), HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI0_SSEL3)
+		},
+		{
+			HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI1_SSEL0), HAL_BOARD_ARG0(HAL_BOARD_FUNC_SPI1_SSEL1), 0xFF, 0xFF
+		}
+	};
+
+	template <uint32_t offset>
+	static inline volatile uint32_t &reg(void)
+	{
+		return reg32<BASES[inst] + offset>();
+	}
+
+public:
+	static constexpr uint8_t INSTANCE = inst; //!< Número de instancia
+	static constexpr uint32_t BASE = BASES[inst]; //!< Dirección base de la instancia
+
+	/**
+	 * @brief Habilitar el clock de la instancia y resetearla
+	 */
+	static inline void power_up(void)
+	{
+		clock_enable<CLOCKS[inst]>();
+		reset_pulse<RESETS[inst]>();
+	}
+
+	/**
+	 * @brief Inhabilitar el clock de la instancia
+	 */
+	static inline void power_down(void)
+	{
+		clock_disable<CLOCKS[inst]>();
+	}
+
+	/**
+	 * @brief Escribir el registro de configuración
+	 * @param[in] cfg Valor del registro *CFG*. Incluye el bit *ENABLE*
+	 */
+	static inline void config(uint32_t cfg)
+	{
+		reg<offsetof(SPI_per_t, CFG)>() = cfg;
+	}
+
+	/**
+	 * @brief Fijar el divisor de clock
+	 * @param[in] div Valor del registro *DIV* (el clock se divide por div + 1)
+	 */
+	static inline void config_div(uint16_t div)
+	{
+		reg<offsetof(SPI_per_t, DIV)>() = div;
+	}
+
+	/**
+	 * @brief Consultar si hay un dato recibido
+	 * @return Distinto de cero si hay un dato disponible
+	 */
+	static inline uint32_t rx_ready(void)
+	{
+		return reg<offsetof(SPI_per_t, STAT)>() & (1 << 0);
+	}
+
+	/**
+	 * @brief Consultar si se puede escribir un dato a transmitir
+	 * @return Distinto de cero si el registro de transmisión está libre
+	 */
+	static inline uint32_t tx_ready(void)
+	{
+		return reg<offsetof(SPI_per_t, STAT)>() & (1 << 1);
+	}
+
+	/**
+	 * @brief Consultar si el maestro está inactivo
+	 * @return Distinto de cero si no hay transferencia en curso
+	 */
+	static inline uint32_t master_idle(void)
+	{
+		return reg<offsetof(SPI_per_t, STAT)>() & (1 << 8);
+	}
+
+	/**
+	 * @brief Escribir los bits de control de las próximas transferencias
+	 * @param[in] ctl Valor del registro *TXCTL*
+	 */
+	static inline void write_control(uint32_t ctl)
+	{
+		reg<offsetof(SPI_per_t, TXCTL)>() = ctl;
+	}
+
+	/**
+	 * @brief Escribir un dato a transmitir con los bits de control vigentes
+	 * @param[in] data Dato a transmitir
+	 */
+	static inline void write(uint16_t data)
+	{
+		reg<offsetof(SPI_per_t, TXDAT)>() = data;
+	}
+
+	/**
+	 * @brief Escribir un dato a transmitir junto con sus bits de control
+	 * @param[in] data_ctl Valor del registro *TXDATCTL*
+	 */
+	static inline void write_with_control(uint32_t data_ctl)
+	{
+		reg<offsetof(SPI_per_t, TXDATCTL)>() = data_ctl;
+	}
+
+	/**
+	 * @brief Leer el dato recibido
+	 * @return Dato recibido
+	 */
+	static inline uint16_t read(void)
+	{
+		return static_cast<uint16_t>(reg<offsetof(SPI_per_t, RXDAT)>());
+	}
+
+	/**
+	 * @brief Asignar el pin de clock
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_sck(void)
+	{
+		swm_assign<SCK[inst], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar el pin MOSI
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_mosi(void)
+	{
+		swm_assign<MOSI[inst], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar el pin MISO
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_miso(void)
+	{
+		swm_assign<MISO[inst], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar un pin de selección de esclavo
+	 * @tparam ssel Número de selección de esclavo (0 a 3 para la SPI0, 0 o 1 para la SPI1)
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <uint8_t ssel, typename pin_t>
+	static inline void assign_ssel(void)
+	{
+		static_assert((ssel < 4) && (SSEL[inst][ssel % 4] != 0xFF), "Seleccion de esclavo inexistente en la instancia");
+
+		swm_assign<SSEL[inst][ssel % 4], pin_t::PORTPIN>();
+	}
+};
+
+} // namespace lpc845
+
+/**
+ * @}
+ */
+
+#endif /* CPP_SPI_HPP_ */
@@ -0,0 +1,254 @@
+/**
+ * @file CPP_USART.hpp
+ * @brief Instancias de USART resueltas en tiempo de compilación (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef CPP_USART_HPP_
+#define CPP_USART_HPP_
+
+#include "CPP_REG.hpp"
+#include "HRI_USART.h"
+
+/**
+ * @addtogroup CPP
+ * @{
+ */
+
+namespace lpc845
+{
+
+/**
+ * @brief Instancia de USART
+ *
+ * Resuelve en tiempo de compilación la dirección base, el clock, el reset y las posiciones de la *SWM* de la
+ * instancia, en lugar de las tablas y los *switch* por instancia del HPL.
+ *
+ * @tparam inst Instancia de USART (0 a 4)
+ */
+template <uint8_t inst>
+class Usart
+{
+	static_assert(inst < 5, "Instancia de USART inexistente");
+
+	static constexpr uint32_t BASES[] = { UART0_BASE, UART1_BASE, UART2_BASE, UART3_BASE, UART4_BASE };
+
+	static constexpr SYSCON_enable_clock_sel_en CLOCKS[] =
+	{
+		SYSCON_ENABLE_CLOCK_SEL_UART0, SYSCON_ENABLE_CLOCK_SEL_UART1, SYSCON_ENABLE_CLOCK_SEL_UART2,
+		SYSCON_ENABLE_CLOCK_SEL_UART3, SYSCON_ENABLE_CLOCK_SEL_UART4
+	};
+
+	static constexpr SYSCON_reset_sel_en RESETS[] =
+	{
+		SYSCON_RESET_SEL_UART0, SYSCON_RESET_SEL_UART1, SYSCON_RESET_SEL_UART2,
+		SYSCON_RESET_SEL_UART3, SYSCON_RESET_SEL_UART4
+	};
+
+	static constexpr uint8_t TXD[] =
+	{
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U0_TXD), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U1_TXD),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U2_TXD), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U3_TXD),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U4_TXD)
+	};
+
+	static constexpr uint8_t RXD[] =
+	{
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U0_RXD), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U1_RXD),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U2_RXD), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U3_RXD),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U4_RXD)
+	};
+
+	static constexpr uint8_t SCLK[] =
+	{
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U0_SCLK), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U1_SCLK),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U2_SCLK), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U3_SCLK),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U4_SCLK)
+	};
+
+	static constexpr uint8_t RTS[] =
+	{
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U0_RTS), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U1_RTS),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U2_RTS)
+	};
+
+	static constexpr uint8_t CTS[] =
+	{
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U0_CTS), HAL_BOARD_ARG0(HAL_BOARD_FUNC_U1_CTS),
+		HAL_BOARD_ARG0(HAL_BOARD_FUNC_U2_CTS)
+	};
+
+	template <uint32_t offset>
+	static inline volatile uint32_t &reg(void)
+	{
+		return reg32<BASES[inst] + offset>();
+	}
+
+public:
+	static constexpr uint8_t INSTANCE = inst; //!< Número de instancia
+	static constexpr uint32_t BASE = BASES[inst]; //!< Dirección base de la instancia
+
+	/**
+	 * @brief Habilitar el clock de la instancia y resetearla
+	 */
+	static inline void power_up(void)
+	{
+		clock_enable<CLOCKS[inst]>();
+		reset_pulse<RESETS[inst]>();
+	}
+
+	/**
+	 * @brief Inhabilitar el clock de la instancia
+	 */
+	static inline void power_down(void)
+	{
+		clock_disable<CLOCKS[inst]>();
+	}
+
+	/**
+	 * @brief Escribir el registro de configuración
+	 *
+	 * El bit *ENABLE* forma parte del registro, por lo que con una única escritura se configura y habilita la
+	 * instancia.
+	 *
+	 * @param[in] cfg Valor del registro *CFG*
+	 */
+	static inline void config(uint32_t cfg)
+	{
+		reg<offsetof(USART_per_t, CFG)>() = cfg;
+	}
+
+	/**
+	 * @brief Fijar el divisor de baudrate
+	 * @param[in] brgval Valor del registro *BRG*
+	 */
+	static inline void config_brg(uint16_t brgval)
+	{
+		reg<offsetof(USART_per_t, BRG)>() = brgval;
+	}
+
+	/**
+	 * @brief Habilitar la instancia
+	 */
+	static inline void enable(void)
+	{
+		reg<offsetof(USART_per_t, CFG)>() |= 1;
+	}
+
+	/**
+	 * @brief Inhabilitar la instancia
+	 */
+	static inline void disable(void)
+	{
+		reg<offsetof(USART_per_t, CFG)>() &= ~1UL;
+	}
+
+	/**
+	 * @brief Consultar si hay un dato recibido
+	 * @return Distinto de cero si hay un dato disponible
+	 */
+	static inline uint32_t rx_ready(void)
+	{
+		return reg<offsetof(USART_per_t, STAT)>() & (1 << 0);
+	}
+
+	/**
+	 * @brief Consultar si se puede escribir un dato a transmitir
+	 * @return Distinto de cero si el registro de transmisión está libre
+	 */
+	static inline uint32_t tx_ready(void)
+	{
+		return reg<offsetof(USART_per_t, STAT)>() & (1 << 2);
+	}
+
+	/**
+	 * @brief Consultar si el transmisor está inactivo
+	 * @return Distinto de cero si no hay transmisión en curso
+	 */
+	static inline uint32_t tx_idle(void)
+	{
+		return reg<offsetof(USART_per_t, STAT)>() & (1 << 3);
+	}
+
+	/**
+	 * @brief Escribir un dato a transmitir
+	 * @param[in] data Dato a transmitir
+	 */
+	static inline void write(uint32_t data)
+	{
+		reg<offsetof(USART_per_t, TXDAT)>() = data;
+	}
+
+	/**
+	 * @brief Leer el dato recibido
+	 * @return Dato recibido
+	 */
+	static inline uint32_t read(void)
+	{
+		return reg<offsetof(USART_per_t, RXDAT)>();
+	}
+
+	/**
+	 * @brief Asignar el pin de transmisión
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_txd(void)
+	{
+		swm_assign<TXD[inst], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar el pin de recepción
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_rxd(void)
+	{
+		swm_assign<RXD[inst], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar el pin de clock para el modo sincrónico
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_sclk(void)
+	{
+		swm_assign<SCLK[inst], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar el pin de RTS
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_rts(void)
+	{
+		static_assert(inst < 3, "La USART3 y la USART4 no tienen RTS");
+
+		swm_assign<RTS[(inst < 3) ? inst : 0], pin_t::PORTPIN>();
+	}
+
+	/**
+	 * @brief Asignar el pin de CTS
+	 * @tparam pin_t Pin a asignar (ver @ref Pin)
+	 */
+	template <typename pin_t>
+	static inline void assign_cts(void)
+	{
+		static_assert(inst < 3, "La USART3 y la USART4 no tienen CTS");
+
+		swm_assign<CTS[(inst < 3) ? inst : 0], pin_t::PORTPIN>();
+	}
+};
+
+} // namespace lpc845
+
+/**
+ * @}
+ */
+
+#endif /* CPP_USART_HPP_ */
@@ -50,6 +50,39 @@
  * - n: Entero entre 0 y 31.
  * - \f$V_{ref}\f$: Tensión de referencia de la *Voltage Ladder*.
  *
+ * # Conversión de baja resolución por aproximaciones sucesivas
+ *
+ * Conectando una entrada a la entrada positiva del comparador y la *Voltage Ladder* a la negativa, es posible
+ * realizar una búsqueda binaria sobre los 32 pasos de la ladder y obtener una lectura de 5 bits de la entrada, sin
+ * utilizar ni perturbar las secuencias del *ADC*. Esto se realiza mediante hal_acmp_ladder_sar_read().
+ *
+ * Cada uno de los 5 pasos de la búsqueda consiste en escribir el paso de la ladder, esperar el tiempo de
+ * establecimiento de la ladder y del comparador, y leer la salida del comparador. El costo aproximado en ciclos de
+ * CPU de una conversión es:
+ *
+ * \f{eqnarray*}{
+ * 		C = 5 \cdot (C_{paso} + N_{espera} \cdot C_{espera}) + C_{fijo}
+ * \f}
+ *
+ * Donde \f$C_{paso}\f$, \f$C_{espera}\f$ y \f$C_{fijo}\f$ son @ref HAL_ACMP_LADDER_SAR_CYCLES_PER_STEP,
+ * @ref HAL_ACMP_LADDER_SAR_CYCLES_PER_SETTLE_LOOP y @ref HAL_ACMP_LADDER_SAR_CYCLES_OVERHEAD, y \f$N_{espera}\f$ es la
+ * cantidad de iteraciones de espera pedida por el usuario. La función hal_acmp_ladder_sar_cycles_get() devuelve este
+ * valor. La cantidad de iteraciones de espera debe elegirse de modo de cubrir el tiempo de establecimiento de la
+ * ladder indicado en la hoja de datos para la frecuencia de clock utilizada.
+ *
+ * # Supervisión de ventana
+ *
+ * La función hal_acmp_window_watch_start() configura al comparador para supervisar que una entrada se mantenga
+ * dentro de una banda definida por dos pasos de la ladder, generando un callback únicamente cuando la entrada sale
+ * de la banda. Dado que existe un único comparador, en cada momento hay un solo umbral armado en hardware: la salida
+ * por ese umbral se detecta inmediatamente por interrupción. El umbral armado se alterna en cada llamado a
+ * hal_acmp_window_watch_tick(), pensada para ser llamada desde alguna interrupción periódica ya existente (por
+ * ejemplo, el callback del @ref SYSTICK), por lo que la salida por el umbral no armado se detecta dentro de un
+ * período de dicha interrupción.
+ *
+ * @note La conversión por aproximaciones sucesivas, la supervisión de ventana y la detección de cruces por cero
+ * utilizan el comparador en forma excluyente.
+ *
  * # Salida del comparador como trigger de hardware de otros periféricos
  *
  * Es posible interconectar la salida del *ACMP* a señales de otros periféricos, de modo de implementar
@@ -57,6 +90,29 @@
  *
  * Por ejemplo, uno de los posibles triggers de hardware para disparar conversiones del periférico *ADC*, es esta señal de salida del *ACMP*.
  *
+ * # Detección de cruces por cero
+ *
+ * La salida del comparador puede ser llevada a un canal de captura del @ref CTIMER, de modo que cada cruce de la
+ * señal comparada quede marcado con el valor del contador del *CTIMER* en hardware. Como la switch matrix no ofrece
+ * una conexión interna entre ambos periféricos, la salida del comparador se asigna a un pin externo y el canal de
+ * captura toma su señal del mismo pin. Con esta configuración, la función hal_acmp_zero_cross_init() permite:
+ *
+ * - Obtener período, frecuencia y fase actual de la señal mediante hal_acmp_zero_cross_get(), sin el *jitter*
+ * propio de tomar marcas de tiempo por software en la interrupción del comparador.
+ * - Ejecutar un callback sincronizado en fase: en cada cruce se programa un canal de *MATCH* del *CTIMER* para
+ * que interrumpa en el ángulo configurado respecto del cruce (por ejemplo, para control de fase de un triac).
+ * El ángulo puede cambiarse en tiempo de ejecución mediante hal_acmp_zero_cross_set_phase().
+ * .
+ *
+ * \f{eqnarray*}{
+ * 		f = \frac{f_{CT}}{T_{cuentas} \cdot k}
+ * \f}
+ *
+ * Donde \f$T_{cuentas}\f$ es la cantidad de cuentas del *CTIMER* entre cruces consecutivos y *k* es 1 si se detecta
+ * un único flanco o 2 si se detectan ambos flancos. En este último caso, los ángulos se miden sobre cada semiciclo.
+ *
+ * @note El *CTIMER* debe estar inicializado en modo timer y contando en forma libre (sin reset por *MATCH*).
+ *
  * # Campos de aplicación típicos
  *
  * - Comparación de niveles analógicos sin necesidad de convertir los mismos.
@@ -70,6 +126,7 @@
 #define HAL_ACMP_H_
 
 #include "HAL_GPIO.h"
+#include "HAL_CTIMER.h"
 
 #if defined (__cplusplus)
 extern "C" {
@@ -138,6 +195,62 @@ typedef struct
 	uint8_t step; /**< Configura qué fracción de la tensión de referencia estará será la tensión de salida de la Voltage Ladder.*/
 }hal_acmp_ladder_config_t;
 
+/** Ciclos de CPU aproximados de cada paso de la conversión por aproximaciones sucesivas, sin contar la espera.*/
+#define		HAL_ACMP_LADDER_SAR_CYCLES_PER_STEP			(24)
+
+/** Ciclos de CPU aproximados de cada iteración de espera de establecimiento.*/
+#define		HAL_ACMP_LADDER_SAR_CYCLES_PER_SETTLE_LOOP	(8)
+
+/** Ciclos de CPU aproximados de la preparación y restauración de la configuración del comparador.*/
+#define		HAL_ACMP_LADDER_SAR_CYCLES_OVERHEAD			(80)
+
+/** Eventos de la supervisión de ventana.*/
+typedef enum
+{
+	HAL_ACMP_WINDOW_EVENT_BELOW = 0, /**< La entrada quedó por debajo del umbral inferior.*/
+	HAL_ACMP_WINDOW_EVENT_ABOVE /**< La entrada quedó por encima del umbral superior.*/
+}hal_acmp_window_event_en;
+
+/** Tipo de dato para callbacks de la supervisión de ventana.*/
+typedef void (*hal_acmp_window_callback_t)(hal_acmp_window_event_en event);
+
+/** Estructura de configuración de la supervisión de ventana.*/
+typedef struct
+{
+	hal_acmp_input_voltage_sel_en input; /**< Entrada a supervisar.*/
+	uint8_t low_step; /**< Paso de la ladder correspondiente al umbral inferior (0 a 31).*/
+	uint8_t high_step; /**< Paso de la ladder correspondiente al umbral superior (0 a 31).*/
+	uint32_t settle_loops; /**< Iteraciones de espera de establecimiento luego de cambiar el umbral.*/
+	hal_acmp_window_callback_t callback; /**< Callback a ejecutar al salir la entrada de la banda.*/
+}hal_acmp_window_config_t;
+
+/** Estructura de configuración de la detección de cruces por cero.*/
+typedef struct
+{
+	hal_gpio_portpin_en portpin; /**< Pin en el cual se refleja la salida del comparador y del cual la toma el *CTIMER*.*/
+	hal_ctimer_capture_sel_en capture; /**< Canal de captura del *CTIMER* a utilizar (0 a 2).*/
+	hal_acmp_edge_sel_en edge_sel; /**< Flancos de la salida del comparador considerados como cruces.*/
+	hal_ctimer_match_sel_en match; /**< Canal de match del *CTIMER* utilizado para el callback sincronizado en fase.*/
+	uint16_t phase_angle; /**< Ángulo del callback respecto del cruce, en décimas de grado (0 a 3599).*/
+	void (*callback)(void); /**< Callback sincronizado en fase. Si es NULL, no se utiliza el canal de match.*/
+}hal_acmp_zero_cross_config_t;
+
+/** Mediciones de la detección de cruces por cero.*/
+typedef struct
+{
+	uint32_t period_ticks; /**< Cuentas del *CTIMER* entre los dos últimos cruces.*/
+	uint32_t frequency_mhz; /**< Frecuencia de la señal en milihertz.*/
+	uint32_t last_crossing; /**< Valor del contador del *CTIMER* en el último cruce.*/
+	uint16_t phase; /**< Fase actual de la señal en décimas de grado, medida desde el último cruce.*/
+}hal_acmp_zero_cross_data_t;
+
+/** Resultados posibles de la lectura de mediciones de cruces por cero.*/
+typedef enum
+{
+	HAL_ACMP_ZERO_CROSS_RESULT_OK = 0, /**< Mediciones válidas.*/
+	HAL_ACMP_ZERO_CROSS_RESULT_NOT_LOCKED /**< Todavía no se detectaron dos cruces consecutivos.*/
+}hal_acmp_zero_cross_result_en;
+
 /**
  * @brief Inicialización del periférico Comparador Analógico.
  * @see hal_acmp_deinit
@@ -220,6 +333,95 @@ void hal_acmp_output_pin_set(hal_gpio_portpin_en port_pin);
  */
 void hal_acmp_output_pin_clear();
 
+/**
+ * @brief Realiza una conversión de 5 bits de una entrada por búsqueda binaria sobre la *Voltage Ladder*.
+ *
+ * Al finalizar, las entradas, el paso y la habilitación de la ladder, y la habilitación de interrupciones del
+ * comparador son restaurados a sus valores previos.
+ *
+ * @param[in] input Entrada a convertir. No puede ser la salida de la ladder.
+ * @param[in] settle_loops Iteraciones de espera de establecimiento en cada paso.
+ * @return Paso de la ladder más alto cuya tensión es menor a la de la entrada (0 a 31).
+ * @pre Comparador inicializado, referencia de la ladder configurada y pines de la entrada configurados mediante
+ * hal_acmp_input_select().
+ * @see hal_acmp_ladder_sar_cycles_get
+ */
+uint8_t hal_acmp_ladder_sar_read(hal_acmp_input_voltage_sel_en input, uint32_t settle_loops);
+
+/**
+ * @brief Obtener el costo aproximado en ciclos de CPU de una conversión por aproximaciones sucesivas.
+ * @param[in] settle_loops Iteraciones de espera de establecimiento en cada paso.
+ * @return Ciclos de CPU aproximados de una llamada a hal_acmp_ladder_sar_read().
+ */
+uint32_t hal_acmp_ladder_sar_cycles_get(uint32_t settle_loops);
+
+/**
+ * @brief Comienza la supervisión de ventana de una entrada.
+ *
+ * Si al comenzar la entrada ya se encuentra fuera de la banda, el callback se ejecuta inmediatamente.
+ *
+ * @param[in] config Puntero a estructura con parámetros de configuración deseados.
+ * @pre Comparador inicializado, referencia de la ladder configurada y pines de la entrada configurados mediante
+ * hal_acmp_input_select().
+ * @see hal_acmp_window_watch_tick
+ * @see hal_acmp_window_watch_stop
+ */
+void hal_acmp_window_watch_start(const hal_acmp_window_config_t *config);
+
+/**
+ * @brief Alterna el umbral armado de la supervisión de ventana.
+ *
+ * Debe ser llamada periódicamente. Puede ser llamada desde un contexto de interrupción.
+ *
+ * @see hal_acmp_window_watch_start
+ */
+void hal_acmp_window_watch_tick(void);
+
+/**
+ * @brief Detiene la supervisión de ventana.
+ * @see hal_acmp_window_watch_start
+ */
+void hal_acmp_window_watch_stop(void);
+
+/**
+ * @brief Inicializa la detección de cruces por cero con marcas de tiempo del *CTIMER*.
+ *
+ * Asigna la salida del comparador y el canal de captura al mismo pin, y configura la interrupción de captura.
+ * Si se especifica un callback, además configura el canal de match para ejecutarlo en el ángulo indicado.
+ *
+ * @param[in] config Puntero a estructura con parámetros de configuración deseados.
+ * @pre Comparador configurado e inicializado, y *CTIMER* inicializado en modo timer y contando.
+ * @see hal_acmp_zero_cross_config_t
+ * @see hal_acmp_zero_cross_deinit
+ */
+void hal_acmp_zero_cross_init(const hal_acmp_zero_cross_config_t *config);
+
+/**
+ * @brief De-inicializa la detección de cruces por cero.
+ *
+ * Libera el canal de captura, el canal de match y el pin utilizados.
+ *
+ * @see hal_acmp_zero_cross_init
+ */
+void hal_acmp_zero_cross_deinit(void);
+
+/**
+ * @brief Cambia el ángulo del callback sincronizado en fase.
+ *
+ * El nuevo ángulo se hace efectivo a partir del próximo cruce.
+ *
+ * @param[in] phase_angle Ángulo respecto del cruce, en décimas de grado (0 a 3599).
+ */
+void hal_acmp_zero_cross_set_phase(uint16_t phase_angle);
+
+/**
+ * @brief Obtener las mediciones de la señal.
+ * @param[out] data Puntero a estructura donde guardar las mediciones.
+ * @return Resultado de la operación.
+ * @see hal_acmp_zero_cross_data_t
+ */
+hal_acmp_zero_cross_result_en hal_acmp_zero_cross_get(hal_acmp_zero_cross_data_t *data);
+
 #if defined (__cplusplus)
 } // extern "C"
 #endif
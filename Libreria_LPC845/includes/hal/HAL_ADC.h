@@ -65,8 +65,10 @@
  *
  * Este periférico contiene un bloque de autocalibración, el cual debe ser utilizado luego de cada reinicio
  * del microcontrolador o cada vez que se sale de modo de bajo consumo, para obtener la resolución y presición
- * especificada por el fabricante. La librería implementa la calibración por hardware en las funciones
- * @ref hal_adc_init_sync_mode y @ref hal_adc_init_async_mode.
+ * especificada por el fabricante. Las funciones @ref hal_adc_init_sync_mode y @ref hal_adc_init_async_mode
+ * registran la calibración por hardware como una inicialización diferida (ver @ref STARTUP), la cual se ejecuta en
+ * la primera llamada a @ref hal_adc_sequence_config, o antes si la aplicación llama a
+ * @ref hal_startup_deferred_run_next. De esta forma, la inicialización del *ADC* no demora el arranque.
  *
  * @note La autocalibración debe realizarse cuando el **microcontrolador** sale de un modo de funcionamiento
  * de bajo consumo, no cuando el periférico *ADC* sale de modo bajo consumo.
@@ -132,6 +134,26 @@
  * @note La frecuencia de muestreo se configura en las funciones de inicialización @ref hal_adc_init_sync_mode o
  * @ref hal_adc_init_async_mode.
  *
+ * # Estadísticas por canal
+ *
+ * La librería puede acumular estadísticas de cada canal (mínimo, máximo, media, valor eficaz y varianza)
+ * directamente en la interrupción de fin de secuencia/conversión, sin que el usuario deba guardar y recorrer
+ * los resultados en su programa principal. Cada muestra nueva se acumula con un costo constante (comparación
+ * de mínimo/máximo, suma y suma de cuadrados enteras), y los valores derivados recién se calculan al momento
+ * de consultarlos.
+ *
+ * Las estadísticas se organizan en *ventanas*: el usuario obtiene una copia consistente de lo acumulado hasta
+ * el momento mediante @ref hal_adc_stats_get, pudiendo en el mismo llamado reiniciar la ventana. La copia se
+ * realiza inhibiendo momentáneamente las interrupciones de secuencia, por lo que es seguro llamarla desde el
+ * programa principal mientras la interrupción sigue acumulando.
+ *
+ * Cada ventana admite hasta @ref HAL_ADC_STATS_MAX_SAMPLES muestras por canal. Una vez alcanzado dicho límite,
+ * las muestras siguientes se descartan hasta que la ventana se reinicie, lo cual es informado en
+ * hal_adc_stats_t::saturated.
+ *
+ * @note Las estadísticas se habilitan con @ref hal_adc_stats_enable. Los canales con estadísticas habilitadas
+ * siguen pudiendo leerse con @ref hal_adc_sequence_get_result.
+ *
  * # Campos de aplicación típicos
  *
  * - Audio/Video
@@ -244,6 +266,9 @@
 extern "C" {
 #endif
 
+/** Cantidad máxima de muestras acumulables por canal en una ventana de estadísticas */
+#define		HAL_ADC_STATS_MAX_SAMPLES		(1 << 20)
+
 /** Selección de fuente de clock para el *ADC* */
 typedef enum
 {
@@ -357,6 +382,14 @@ typedef enum
 	HAL_ADC_COMPARISON_CROSSING_UPWARD /**< El resultado de la conversión actual cruzó algún umbral hacia arriba */
 }hal_adc_compare_crossing_result_en;
 
+/** Resultado de obtención de estadísticas de un canal */
+typedef enum
+{
+	HAL_ADC_STATS_RESULT_VALID = 0, /**< Estadísticas válidas */
+	HAL_ADC_STATS_RESULT_NO_SAMPLES, /**< No se acumularon muestras en la ventana actual */
+	HAL_ADC_STATS_RESULT_INVALID_CHANNEL /**< El canal no tiene estadísticas habilitadas */
+}hal_adc_stats_result_en;
+
 /**
  * @brief Tipo de dato para callback de interrupcion de sequencia
  *
@@ -413,10 +446,24 @@ typedef struct
 	hal_adc_compare_crossing_result_en result_crossing; /**< Resultado si está cruzando */
 }hal_adc_channel_compare_result_t;
 
+/** Estadísticas de un canal en una ventana de acumulación */
+typedef struct
+{
+	uint32_t samples; /**< Cantidad de muestras acumuladas en la ventana */
+	uint16_t min; /**< Mínimo valor convertido */
+	uint16_t max; /**< Máximo valor convertido */
+	uint16_t mean; /**< Valor medio (redondeado hacia abajo) */
+	uint16_t rms; /**< Valor eficaz (redondeado hacia abajo) */
+	uint32_t variance; /**< Varianza poblacional, en cuentas de *ADC* al cuadrado */
+	uint32_t sum; /**< Suma de las muestras de la ventana */
+	uint64_t sum_sq; /**< Suma de los cuadrados de las muestras de la ventana */
+	uint8_t saturated; /**< Distinto de cero si se descartaron muestras por alcanzar @ref HAL_ADC_STATS_MAX_SAMPLES */
+}hal_adc_stats_t;
+
 /**
  * @brief Inicializar el *ADC* en modo **asincrónico**
  *
- * Realiza la calibración de hardware y fija la frecuencia de muestreo deseada.
+ * Fija la frecuencia de muestreo deseada y registra la calibración de hardware como inicialización diferida.
  *
  * @note Solamente se debe realizar el llamado a una de las dos funciones de inicialización del *ADC*.
  *
@@ -433,7 +480,7 @@ void hal_adc_init_async_mode(uint32_t sample_freq, uint8_t div, hal_adc_clock_so
 /**
  * @brief Inicializar el *ADC* en modo **sincrónico**
  *
- * Realiza la calibración de hardware y fija la frecuencia de muestreo deseada.
+ * Fija la frecuencia de muestreo deseada y registra la calibración de hardware como inicialización diferida.
  *
  * @note Solamente se debe realizar el llamado a una de las dos funciones de inicialización del *ADC*.
  *
@@ -589,6 +636,50 @@ void hal_adc_threshold_register_interrupt(adc_comparison_interrupt_t callback, v
  */
 void hal_adc_threshold_get_comparison_results(hal_adc_channel_compare_result_t *results);
 
+/**
+ * @brief Habilitar la acumulación de estadísticas en canales de una secuencia
+ *
+ * Cada vez que se genere la interrupción de la secuencia, las conversiones válidas de los canales indicados
+ * serán acumuladas en su ventana de estadísticas. Si la secuencia no tenía un callback asociado, esta función
+ * habilita igualmente su interrupción.
+ *
+ * @note Las ventanas de los canales indicados son reiniciadas.
+ *
+ * @param[in] sequence Secuencia en la cual se convierten los canales
+ * @param[in] channels Canales a acumular. Cada uno de los bits representa el canal. Los canales que no
+ * pertenezcan a la secuencia son ignorados
+ * @see hal_adc_stats_disable
+ * @see hal_adc_stats_get
+ * @pre Haber configurado la secuencia mediante @ref hal_adc_sequence_config
+ */
+void hal_adc_stats_enable(hal_adc_sequence_sel_en sequence, uint16_t channels);
+
+/**
+ * @brief Inhabilitar la acumulación de estadísticas en una secuencia
+ *
+ * Si la secuencia no tiene un callback asociado, se inhabilita su interrupción.
+ *
+ * @param[in] sequence Secuencia a inhabilitar
+ * @see hal_adc_stats_enable
+ */
+void hal_adc_stats_disable(hal_adc_sequence_sel_en sequence);
+
+/**
+ * @brief Obtener las estadísticas acumuladas de un canal
+ *
+ * La copia de los acumuladores se realiza con las interrupciones de secuencia inhibidas, por lo que puede
+ * llamarse desde el programa principal sin riesgo de obtener datos inconsistentes. Los valores derivados
+ * (media, valor eficaz y varianza) se calculan fuera de dicha sección.
+ *
+ * @param[in] channel Canal a consultar
+ * @param[out] stats Puntero a donde guardar las estadísticas
+ * @param[in] reset Si es distinto de cero, la ventana del canal se reinicia luego de copiarla
+ * @return Resultado de la función
+ * @see hal_adc_stats_t
+ * @see hal_adc_stats_result_en
+ */
+hal_adc_stats_result_en hal_adc_stats_get(uint8_t channel, hal_adc_stats_t *stats, uint8_t reset);
+
 #if defined (__cplusplus)
 } // extern "C"
 #endif
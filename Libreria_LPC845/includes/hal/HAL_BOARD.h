@@ -0,0 +1,325 @@
+/**
+ * @file HAL_BOARD.h
+ * @brief Declaraciones a nivel de aplicacion de la tabla de pines de la placa (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup BOARD Tabla de pines de la placa
+ *
+ * # Introducción
+ *
+ * Cada función de inicialización de periférico asigna sus pines mediante la @ref SWM y configura el @ref IOCON
+ * por separado, habilitando y deshabilitando el clock de dichos módulos en cada llamado. Este módulo permite
+ * describir la configuración de pines de toda la placa en una única tabla, la cual se resuelve en tiempo de
+ * compilación en las imágenes finales de los registros *PINASSIGN*, *PINENABLE* y en la lista de configuraciones de
+ * *IOCON*, y se aplica en una única pasada mediante @ref hal_board_apply.
+ *
+ * # Descripción de la tabla
+ *
+ * La tabla se escribe como una macro que recibe tres macros como parámetros, una por cada tipo de entrada:
+ * 	- *MOVABLE(función, puerto/pin)*: Asigna una función movible (ver los nombres en las definiciones
+ * 	*HAL_BOARD_FUNC_xxx*) a un puerto/pin.
+ * 	- *FIXED(función)*: Habilita una función fija (ver los nombres en las definiciones *HAL_BOARD_FIXED_xxx*).
+ * 	- *IOCON(puerto/pin, configuración)*: Configura un puerto/pin con una combinación de las definiciones
+ * 	*HAL_BOARD_IOCON_xxx*.
+ * 	.
+ *
+ * Los puertos/pines se indican como @ref hal_gpio_portpin_en o mediante @ref HAL_BOARD_PORTPIN.
+ *
+ * ~~~{.c}
+ * #define BOARD_PINS(MOVABLE, FIXED, IOCON) \
+ * 	FIXED(SWCLK) \
+ * 	FIXED(SWDIO) \
+ * 	FIXED(RESETN) \
+ * 	MOVABLE(U0_TXD, HAL_GPIO_PORTPIN_0_25) \
+ * 	MOVABLE(U0_RXD, HAL_GPIO_PORTPIN_0_24) \
+ * 	IOCON(HAL_GPIO_PORTPIN_0_24, HAL_BOARD_IOCON_PULL_UP | HAL_BOARD_IOCON_HYSTERESIS) \
+ * 	FIXED(ADC_0) \
+ * 	IOCON(HAL_GPIO_PORTPIN_0_7, HAL_BOARD_IOCON_PULL_NONE)
+ *
+ * HAL_BOARD_DEFINE(board_pins, BOARD_PINS);
+ *
+ * int main(void)
+ * {
+ * 	hal_board_apply(&board_pins);
+ * 	...
+ * }
+ * ~~~
+ *
+ * La tabla describe la configuración completa de la *SWM*: las funciones fijas no habilitadas en la tabla quedan
+ * deshabilitadas, incluyendo *SWCLK*, *SWDIO* y *RESETN*, que el microcontrolador habilita luego de un reset. Para
+ * conservar la depuración, dichas funciones deben figurar en la tabla.
+ *
+ * Las configuraciones de *IOCON* escriben los campos de modo (pull-up/pull-down), histéresis, inversión, open
+ * drain, modo de muestreo y divisor de clock del pin. Los demás campos del registro no se modifican.
+ *
+ * # Verificaciones en tiempo de compilación
+ *
+ * La macro @ref HAL_BOARD_DEFINE rechaza en tiempo de compilación:
+ * 	- Puertos/pines inexistentes.
+ * 	- Funciones movibles o fijas asignadas más de una vez.
+ * 	- Más de una función que maneje el mismo pin. Se consideran funciones que manejan el pin a las salidas y
+ * 	entradas/salidas movibles y a todas las funciones fijas. Las entradas movibles pueden compartir el pin con otras
+ * 	funciones (por ejemplo, para leer la salida de otro periférico).
+ * 	- Más de una configuración de *IOCON* para el mismo pin.
+ * 	.
+ *
+ * @note Las funciones de inicialización de los periféricos siguen asignando los pines indicados en sus
+ * configuraciones. En los casos que lo admiten, se puede indicar @ref HAL_GPIO_PORTPIN_NOT_USED para que la
+ * inicialización no modifique la asignación hecha por la tabla.
+ *
+ * @{
+ */
+
+#ifndef HAL_BOARD_H_
+#define HAL_BOARD_H_
+
+#include <stdint.h>
+#include "HAL_GPIO.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Obtener el número de puerto/pin a partir del puerto y el pin */
+#define		HAL_BOARD_PORTPIN(port, pin)	(((port) * 32) + (pin))
+
+/** Último puerto/pin existente en el microcontrolador */
+#define		HAL_BOARD_PORTPIN_LAST			HAL_BOARD_PORTPIN(1, 21)
+
+/** Cantidad de registros *PINASSIGN* */
+#define		HAL_BOARD_PINASSIGN_REGS		(15)
+
+/** Valor de puerto/pin que indica el final de la lista de configuraciones de *IOCON* */
+#define		HAL_BOARD_IOCON_END				(0xFF)
+
+/** Función que maneja el pin (salida o entrada/salida) */
+#define		HAL_BOARD_DRIVER				1
+
+/** Función que únicamente lee el pin */
+#define		HAL_BOARD_INPUT					0
+
+/**
+ * @defgroup BOARD_IOCON Configuraciones de IOCON
+ * @{
+ */
+#define		HAL_BOARD_IOCON_PULL_NONE		(0 << 3) /**< Sin pull-up ni pull-down */
+#define		HAL_BOARD_IOCON_PULL_DOWN		(1 << 3) /**< Pull-down */
+#define		HAL_BOARD_IOCON_PULL_UP			(2 << 3) /**< Pull-up */
+#define		HAL_BOARD_IOCON_PULL_REPEATER	(3 << 3) /**< Repetidor */
+#define		HAL_BOARD_IOCON_HYSTERESIS		(1 << 5) /**< Histéresis habilitada */
+#define		HAL_BOARD_IOCON_INVERT			(1 << 6) /**< Entrada invertida */
+#define		HAL_BOARD_IOCON_OPEN_DRAIN		(1 << 10) /**< Salida open drain */
+#define		HAL_BOARD_IOCON_SAMPLE(n)		((n) << 11) /**< Filtro de n muestras (0 a 3) */
+#define		HAL_BOARD_IOCON_CLK_DIV(n)		((n) << 13) /**< Divisor de clock del filtro (0 a 6) */
+#define		HAL_BOARD_IOCON_MASK			(0xFC78) /**< Campos escritos por la tabla */
+/**
+ * @}
+ */
+
+/*
+ * Funciones movibles: posición del byte dentro de los registros PINASSIGN y tipo de función
+ */
+#define		HAL_BOARD_FUNC_U0_TXD			0, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U0_RXD			1, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U0_RTS			2, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U0_CTS			3, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U0_SCLK			4, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U1_TXD			5, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U1_RXD			6, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U1_RTS			7, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U1_CTS			8, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U1_SCLK			9, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U2_TXD			10, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U2_RXD			11, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U2_RTS			12, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U2_CTS			13, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U2_SCLK			14, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_SCK			15, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_MOSI		16, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_MISO		17, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_SSEL0		18, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_SSEL1		19, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_SSEL2		20, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI0_SSEL3		21, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI1_SCK			22, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI1_MOSI		23, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI1_MISO		24, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI1_SSEL0		25, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SPI1_SSEL1		26, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_IN_A			27, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_SCT_IN_B			28, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_SCT_IN_C			29, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_SCT_IN_D			30, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_SCT_OUT0			31, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_OUT1			32, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_OUT2			33, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_OUT3			34, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_OUT4			35, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_OUT5			36, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_SCT_OUT6			37, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_I2C1_SDA			38, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_I2C1_SCL			39, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_I2C2_SDA			40, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_I2C2_SCL			41, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_I2C3_SDA			42, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_I2C3_SCL			43, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_COMP0_OUT		44, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_CLKOUT			45, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_GPIO_INT_BMAT	46, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U3_TXD			47, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U3_RXD			48, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U3_SCLK			49, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U4_TXD			50, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_U4_RXD			51, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_U4_SCLK			52, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_T0_MAT0			53, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_T0_MAT1			54, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_T0_MAT2			55, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_T0_MAT3			56, HAL_BOARD_DRIVER
+#define		HAL_BOARD_FUNC_T0_CAP0			57, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_T0_CAP1			58, HAL_BOARD_INPUT
+#define		HAL_BOARD_FUNC_T0_CAP2			59, HAL_BOARD_INPUT
+
+/*
+ * Funciones fijas: posición del bit dentro de los registros PINENABLE y puerto/pin que ocupan
+ */
+#define		HAL_BOARD_FIXED_ACMP_I1			0, HAL_BOARD_PORTPIN(0, 0)
+#define		HAL_BOARD_FIXED_ACMP_I2			1, HAL_BOARD_PORTPIN(0, 1)
+#define		HAL_BOARD_FIXED_ACMP_I3			2, HAL_BOARD_PORTPIN(0, 14)
+#define		HAL_BOARD_FIXED_ACMP_I4			3, HAL_BOARD_PORTPIN(0, 23)
+#define		HAL_BOARD_FIXED_ACMP_I5			4, HAL_BOARD_PORTPIN(0, 30)
+#define		HAL_BOARD_FIXED_SWCLK			5, HAL_BOARD_PORTPIN(0, 3)
+#define		HAL_BOARD_FIXED_SWDIO			6, HAL_BOARD_PORTPIN(0, 2)
+#define		HAL_BOARD_FIXED_XTALIN			7, HAL_BOARD_PORTPIN(0, 8)
+#define		HAL_BOARD_FIXED_XTALOUT			8, HAL_BOARD_PORTPIN(0, 9)
+#define		HAL_BOARD_FIXED_RESETN			9, HAL_BOARD_PORTPIN(0, 5)
+#define		HAL_BOARD_FIXED_CLKIN			10, HAL_BOARD_PORTPIN(0, 1)
+#define		HAL_BOARD_FIXED_VDDCMP			11, HAL_BOARD_PORTPIN(0, 6)
+#define		HAL_BOARD_FIXED_I2C0_SDA		12, HAL_BOARD_PORTPIN(0, 11)
+#define		HAL_BOARD_FIXED_I2C0_SCL		13, HAL_BOARD_PORTPIN(0, 10)
+#define		HAL_BOARD_FIXED_ADC_0			14, HAL_BOARD_PORTPIN(0, 7)
+#define		HAL_BOARD_FIXED_ADC_1			15, HAL_BOARD_PORTPIN(0, 6)
+#define		HAL_BOARD_FIXED_ADC_2			16, HAL_BOARD_PORTPIN(0, 14)
+#define		HAL_BOARD_FIXED_ADC_3			17, HAL_BOARD_PORTPIN(0, 23)
+#define		HAL_BOARD_FIXED_ADC_4			18, HAL_BOARD_PORTPIN(0, 22)
+#define		HAL_BOARD_FIXED_ADC_5			19, HAL_BOARD_PORTPIN(0, 21)
+#define		HAL_BOARD_FIXED_ADC_6			20, HAL_BOARD_PORTPIN(0, 20)
+#define		HAL_BOARD_FIXED_ADC_7			21, HAL_BOARD_PORTPIN(0, 19)
+#define		HAL_BOARD_FIXED_ADC_8			22, HAL_BOARD_PORTPIN(0, 18)
+#define		HAL_BOARD_FIXED_ADC_9			23, HAL_BOARD_PORTPIN(0, 17)
+#define		HAL_BOARD_FIXED_ADC_10			24, HAL_BOARD_PORTPIN(0, 13)
+#define		HAL_BOARD_FIXED_ADC_11			25, HAL_BOARD_PORTPIN(0, 4)
+#define		HAL_BOARD_FIXED_DACOUT0			26, HAL_BOARD_PORTPIN(0, 17)
+#define		HAL_BOARD_FIXED_DACOUT1			27, HAL_BOARD_PORTPIN(0, 29)
+#define		HAL_BOARD_FIXED_CAPT_X0			28, HAL_BOARD_PORTPIN(0, 31)
+#define		HAL_BOARD_FIXED_CAPT_X1			29, HAL_BOARD_PORTPIN(1, 0)
+#define		HAL_BOARD_FIXED_CAPT_X2			30, HAL_BOARD_PORTPIN(1, 1)
+#define		HAL_BOARD_FIXED_CAPT_X3			31, HAL_BOARD_PORTPIN(1, 2)
+#define		HAL_BOARD_FIXED_CAPT_X4			32, HAL_BOARD_PORTPIN(1, 3)
+#define		HAL_BOARD_FIXED_CAPT_X5			33, HAL_BOARD_PORTPIN(1, 4)
+#define		HAL_BOARD_FIXED_CAPT_X6			34, HAL_BOARD_PORTPIN(1, 5)
+#define		HAL_BOARD_FIXED_CAPT_X7			35, HAL_BOARD_PORTPIN(1, 6)
+#define		HAL_BOARD_FIXED_CAPT_X8			36, HAL_BOARD_PORTPIN(1, 7)
+#define		HAL_BOARD_FIXED_CAPT_YL			37, HAL_BOARD_PORTPIN(1, 8)
+#define		HAL_BOARD_FIXED_CAPT_YH			38, HAL_BOARD_PORTPIN(1, 9)
+
+/** Configuración de *IOCON* de un puerto/pin */
+typedef struct
+{
+	uint8_t portpin; /**< Puerto/pin a configurar */
+	uint16_t flags; /**< Combinación de las configuraciones de *IOCON* */
+}hal_board_iocon_t;
+
+/** Imágenes de registros de la tabla de pines de la placa */
+typedef struct
+{
+	union
+	{
+		uint8_t bytes[HAL_BOARD_PINASSIGN_REGS * 4]; /**< Complemento de cada byte de los registros *PINASSIGN* */
+		uint32_t words[HAL_BOARD_PINASSIGN_REGS]; /**< Complemento de los registros *PINASSIGN* */
+	}pinassign; /**< Funciones movibles. Se guarda el complemento para que las no asignadas valgan 0xFF */
+	uint64_t fixed; /**< Funciones fijas habilitadas. El bit n corresponde al bit n de *PINENABLE0:PINENABLE1* */
+	const hal_board_iocon_t *iocon; /**< Configuraciones de *IOCON*, terminadas en @ref HAL_BOARD_IOCON_END */
+}hal_board_config_t;
+
+/*
+ * Macros auxiliares para recorrer la tabla
+ */
+#define		HAL_BOARD_ARG0(...)						HAL_BOARD_ARG0_(__VA_ARGS__)
+#define		HAL_BOARD_ARG0_(a, b)					a
+#define		HAL_BOARD_ARG1(...)						HAL_BOARD_ARG1_(__VA_ARGS__)
+#define		HAL_BOARD_ARG1_(a, b)					b
+#define		HAL_BOARD_SKIP(...)
+
+#define		HAL_BOARD_X_RANGE(func, portpin)		+ ((portpin) > HAL_BOARD_PORTPIN_LAST)
+#define		HAL_BOARD_X_IOCON_RANGE(portpin, flags)	+ ((portpin) > HAL_BOARD_PORTPIN_LAST)
+#define		HAL_BOARD_X_FUNC_SUM(func, portpin)		+ (1ULL << HAL_BOARD_ARG0(HAL_BOARD_FUNC_##func))
+#define		HAL_BOARD_X_FUNC_OR(func, portpin)		| (1ULL << HAL_BOARD_ARG0(HAL_BOARD_FUNC_##func))
+#define		HAL_BOARD_X_FIXED_SUM(func)				+ (1ULL << HAL_BOARD_ARG0(HAL_BOARD_FIXED_##func))
+#define		HAL_BOARD_X_FIXED_OR(func)				| (1ULL << HAL_BOARD_ARG0(HAL_BOARD_FIXED_##func))
+#define		HAL_BOARD_X_DRIVER_SUM(func, portpin)	+ (HAL_BOARD_ARG1(HAL_BOARD_FUNC_##func) ? (1ULL << (portpin)) : 0)
+#define		HAL_BOARD_X_DRIVER_OR(func, portpin)	| (HAL_BOARD_ARG1(HAL_BOARD_FUNC_##func) ? (1ULL << (portpin)) : 0)
+#define		HAL_BOARD_X_FIXED_PIN_SUM(func)			+ (1ULL << HAL_BOARD_ARG1(HAL_BOARD_FIXED_##func))
+#define		HAL_BOARD_X_FIXED_PIN_OR(func)			| (1ULL << HAL_BOARD_ARG1(HAL_BOARD_FIXED_##func))
+#define		HAL_BOARD_X_IOCON_SUM(portpin, flags)	+ (1ULL << (portpin))
+#define		HAL_BOARD_X_IOCON_OR(portpin, flags)	| (1ULL << (portpin))
+#define		HAL_BOARD_X_PINASSIGN(func, portpin)	[HAL_BOARD_ARG0(HAL_BOARD_FUNC_##func)] = (uint8_t) ~(portpin),
+#define		HAL_BOARD_X_IOCON(portpin, flags)		{ (portpin), (flags) },
+
+/**
+ * @brief Definir la tabla de pines de la placa
+ *
+ * Define una variable constante del tipo @ref hal_board_config_t con las imágenes de registros correspondientes a la
+ * tabla, verificando la tabla en tiempo de compilación.
+ *
+ * @param[in] name Nombre de la variable a definir
+ * @param[in] list Macro con la tabla de pines
+ */
+#define		HAL_BOARD_DEFINE(name, list) \
+	_Static_assert((0 list(HAL_BOARD_X_RANGE, HAL_BOARD_SKIP, HAL_BOARD_X_IOCON_RANGE)) == 0, \
+			"Tabla de pines " #name ": puerto/pin inexistente"); \
+	_Static_assert((0ULL list(HAL_BOARD_X_FUNC_SUM, HAL_BOARD_SKIP, HAL_BOARD_SKIP)) == \
+			(0ULL list(HAL_BOARD_X_FUNC_OR, HAL_BOARD_SKIP, HAL_BOARD_SKIP)), \
+			"Tabla de pines " #name ": funcion movible asignada mas de una vez"); \
+	_Static_assert((0ULL list(HAL_BOARD_SKIP, HAL_BOARD_X_FIXED_SUM, HAL_BOARD_SKIP)) == \
+			(0ULL list(HAL_BOARD_SKIP, HAL_BOARD_X_FIXED_OR, HAL_BOARD_SKIP)), \
+			"Tabla de pines " #name ": funcion fija habilitada mas de una vez"); \
+	_Static_assert((0ULL list(HAL_BOARD_X_DRIVER_SUM, HAL_BOARD_X_FIXED_PIN_SUM, HAL_BOARD_SKIP)) == \
+			(0ULL list(HAL_BOARD_X_DRIVER_OR, HAL_BOARD_X_FIXED_PIN_OR, HAL_BOARD_SKIP)), \
+			"Tabla de pines " #name ": mas de una funcion maneja el mismo pin"); \
+	_Static_assert((0ULL list(HAL_BOARD_SKIP, HAL_BOARD_SKIP, HAL_BOARD_X_IOCON_SUM)) == \
+			(0ULL list(HAL_BOARD_SKIP, HAL_BOARD_SKIP, HAL_BOARD_X_IOCON_OR)), \
+			"Tabla de pines " #name ": pin con mas de una configuracion de IOCON"); \
+	static const hal_board_iocon_t name##_iocon[] = { \
+		list(HAL_BOARD_SKIP, HAL_BOARD_SKIP, HAL_BOARD_X_IOCON) \
+		{ HAL_BOARD_IOCON_END, 0 } \
+	}; \
+	const hal_board_config_t name = { \
+		.pinassign = { .bytes = { list(HAL_BOARD_X_PINASSIGN, HAL_BOARD_SKIP, HAL_BOARD_SKIP) } }, \
+		.fixed = (0ULL list(HAL_BOARD_SKIP, HAL_BOARD_X_FIXED_OR, HAL_BOARD_SKIP)), \
+		.iocon = name##_iocon \
+	}
+
+/**
+ * @brief Aplicar la tabla de pines de la placa
+ *
+ * Escribe todos los registros *PINASSIGN* y *PINENABLE* y las configuraciones de *IOCON* de la tabla, habilitando
+ * el clock de la *SWM* y del *IOCON* una única vez.
+ *
+ * @param[in] config Tabla definida mediante @ref HAL_BOARD_DEFINE
+ */
+void hal_board_apply(const hal_board_config_t *config);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_BOARD_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,153 @@
+/**
+ * @file HAL_CRC.h
+ * @brief Declaraciones a nivel de aplicacion del periferico CRC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup CRC Motor de CRC
+ *
+ * # Introducción
+ *
+ * El LPC845 incluye un motor de cálculo de *CRC* (código de redundancia cíclica) por hardware, con los polinomios
+ * *CRC-CCITT* (0x1021), *CRC-16* (0x8005) y *CRC-32* (0x04C11DB7). Cada dato escrito en el periférico se procesa en
+ * un único ciclo de bus, por lo que el cálculo es varias veces más rápido que cualquier implementación por software,
+ * sin necesidad de tablas en memoria.
+ *
+ * # Configuración
+ *
+ * Además del polinomio y la semilla, se puede invertir el orden de los bits de cada byte de entrada (*reflected
+ * input*), invertir el orden de los bits del resultado (*reflected output*), y complementar la entrada y/o el
+ * resultado. Las variantes más utilizadas se encuentran predefinidas:
+ * 	- @ref HAL_CRC_CONFIG_CRC32 (*Ethernet*, *zlib*, *PNG*): verificación 0xCBF43926
+ * 	- @ref HAL_CRC_CONFIG_CCITT_FALSE: verificación 0x29B1
+ * 	- @ref HAL_CRC_CONFIG_XMODEM: verificación 0x31C3
+ * 	- @ref HAL_CRC_CONFIG_MODBUS: verificación 0x4B37
+ * 	.
+ *
+ * El valor de verificación es el resultado de calcular el CRC de los nueve caracteres ASCII "123456789".
+ *
+ * # Cálculo incremental
+ *
+ * La función @ref hal_crc_start comienza un cálculo, y la función @ref hal_crc_update agrega datos al mismo, tantas
+ * veces como sea necesario (por ejemplo, a medida que se reciben los datos de una trama). Los datos se escriben de a
+ * 32 bits mientras su dirección esté alineada, y de a un byte en los extremos. El resultado parcial o final se
+ * obtiene mediante @ref hal_crc_get.
+ *
+ * # Cálculo por DMA
+ *
+ * Para bloques grandes de memoria (por ejemplo, la verificación de una imagen de firmware en flash), la función
+ * @ref hal_crc_dma_start programa un canal de DMA para escribir los datos en el periférico, de a 32 bits y en bloques
+ * de hasta 4KB, sin intervención del CPU. La función @ref hal_crc_dma_process debe llamarse periódicamente para
+ * programar el siguiente bloque y, al finalizar, procesar los bytes finales no alineados. Mientras el cálculo por DMA
+ * está en curso no debe llamarse a ninguna otra función de este módulo.
+ *
+ * @{
+ */
+
+#ifndef HAL_CRC_H_
+#define HAL_CRC_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Configuración para *CRC-32* */
+#define		HAL_CRC_CONFIG_CRC32			{ HAL_CRC_POLYNOMIAL_CRC32, 1, 0, 1, 1, 0xFFFFFFFF }
+
+/** Configuración para *CRC-16/CCITT-FALSE* */
+#define		HAL_CRC_CONFIG_CCITT_FALSE		{ HAL_CRC_POLYNOMIAL_CCITT, 0, 0, 0, 0, 0xFFFF }
+
+/** Configuración para *CRC-16/XMODEM* */
+#define		HAL_CRC_CONFIG_XMODEM			{ HAL_CRC_POLYNOMIAL_CCITT, 0, 0, 0, 0, 0x0000 }
+
+/** Configuración para *CRC-16/MODBUS* */
+#define		HAL_CRC_CONFIG_MODBUS			{ HAL_CRC_POLYNOMIAL_CRC16, 1, 0, 1, 0, 0xFFFF }
+
+/** Polinomio del CRC */
+typedef enum
+{
+	HAL_CRC_POLYNOMIAL_CCITT = 0, /**< x^16 + x^12 + x^5 + 1 */
+	HAL_CRC_POLYNOMIAL_CRC16, /**< x^16 + x^15 + x^2 + 1 */
+	HAL_CRC_POLYNOMIAL_CRC32 /**< x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x + 1 */
+}hal_crc_polynomial_en;
+
+/** Estado del cálculo por DMA */
+typedef enum
+{
+	HAL_CRC_DMA_STATUS_DONE = 0, /**< Cálculo finalizado (o no iniciado) */
+	HAL_CRC_DMA_STATUS_BUSY /**< Cálculo en curso */
+}hal_crc_dma_status_en;
+
+/** Configuración de un cálculo */
+typedef struct
+{
+	hal_crc_polynomial_en polynomial; /**< Polinomio */
+	uint8_t reverse_input; /**< Distinto de cero para invertir el orden de los bits de cada byte de entrada */
+	uint8_t complement_input; /**< Distinto de cero para complementar los datos de entrada */
+	uint8_t reverse_output; /**< Distinto de cero para invertir el orden de los bits del resultado */
+	uint8_t complement_output; /**< Distinto de cero para complementar el resultado */
+	uint32_t seed; /**< Semilla (valor inicial) */
+}hal_crc_config_t;
+
+/**
+ * @brief Inicializar el periférico CRC
+ */
+void hal_crc_init(void);
+
+/**
+ * @brief Comenzar un cálculo
+ * @param[in] config Configuración del cálculo
+ * @pre Haber inicializado el periférico mediante @ref hal_crc_init
+ */
+void hal_crc_start(const hal_crc_config_t *config);
+
+/**
+ * @brief Agregar datos al cálculo en curso
+ * @param[in] data Datos a agregar
+ * @param[in] length Cantidad de bytes
+ */
+void hal_crc_update(const void *data, uint32_t length);
+
+/**
+ * @brief Obtener el resultado del cálculo en curso
+ * @return Resultado (en los 16 bits menos significativos para los polinomios de 16 bits)
+ */
+uint32_t hal_crc_get(void);
+
+/**
+ * @brief Calcular el CRC de un bloque de datos
+ * @param[in] config Configuración del cálculo
+ * @param[in] data Datos
+ * @param[in] length Cantidad de bytes
+ * @return Resultado
+ */
+uint32_t hal_crc_compute(const hal_crc_config_t *config, const void *data, uint32_t length);
+
+/**
+ * @brief Comenzar a agregar un bloque de datos al cálculo en curso mediante DMA
+ * @param[in] channel Canal de DMA a utilizar (0 a 24)
+ * @param[in] data Datos a agregar. Deben permanecer válidos hasta finalizar
+ * @param[in] length Cantidad de bytes
+ */
+void hal_crc_dma_start(uint8_t channel, const void *data, uint32_t length);
+
+/**
+ * @brief Avanzar el cálculo por DMA
+ * @return Estado del cálculo. Una vez finalizado, el resultado se obtiene mediante @ref hal_crc_get
+ */
+hal_crc_dma_status_en hal_crc_dma_process(void);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_CRC_H_ */
+
+/**
+ * @}
+ */
@@ -106,6 +106,23 @@ extern "C" {
  * @note Para hacer cambios en el duty establecido para un canal, el usuario debe simplemente volver a llamar a la
  * función hal_ctimer_pwm_mode_channel_config() con los parámetros deseados.
  *
+ * # Captura
+ *
+ * En modo **Timer** se cuenta además con 4 *canales de captura*. Ante el flanco configurado en la *señal de captura*
+ * del canal, el periférico copia el valor actual del contador en el registro de captura correspondiente, sin
+ * intervención del microcontrolador. Esto permite obtener marcas de tiempo de eventos externos cuya precisión no
+ * depende de la latencia de interrupciones.
+ *
+ * La configuración de cada canal se establece llamando a la función hal_ctimer_timer_mode_capture_config() con su
+ * correspondiente estructura hal_ctimer_capture_config_t. El valor capturado se lee con la función
+ * hal_ctimer_timer_mode_capture_read().
+ *
+ * @note Únicamente los canales de captura 0 a 2 pueden asociarse a pines externos del microcontrolador.
+ *
+ * Para trabajar directamente en cuentas del contador (por ejemplo, al programar un *MATCH* a partir de un valor
+ * capturado), se ofrecen las funciones hal_ctimer_timer_mode_counter_read(), hal_ctimer_timer_mode_match_change_ticks()
+ * y hal_ctimer_timer_mode_clock_get().
+ *
  * # Campos de aplicación típicos
  *
  * - Medición de tiempos.
@@ -210,6 +227,42 @@ typedef enum
 	HAL_CTIMER_PWM_CHANNEL_2 /**< Canal de PWM 2.*/
 }hal_ctimer_pwm_channel_sel_en;
 
+/** Selección del canal de captura del *CTIMER*.*/
+typedef enum
+{
+	HAL_CTIMER_CAPTURE_0 = 0, /**< Canal de captura 0.*/
+	HAL_CTIMER_CAPTURE_1, /**< Canal de captura 1.*/
+	HAL_CTIMER_CAPTURE_2, /**< Canal de captura 2.*/
+	HAL_CTIMER_CAPTURE_3 /**< Canal de captura 3.*/
+}hal_ctimer_capture_sel_en;
+
+/** Flanco de la *señal de captura* que dispara la captura del contador.*/
+typedef enum
+{
+	HAL_CTIMER_CAPTURE_EDGE_RISING = 0, /**< Flanco ascendente.*/
+	HAL_CTIMER_CAPTURE_EDGE_FALLING, /**< Flanco descendente.*/
+	HAL_CTIMER_CAPTURE_EDGE_BOTH /**< Ambos flancos.*/
+}hal_ctimer_capture_edge_en;
+
+/** Estructura de configuración de un canal de captura para el modo timer.*/
+typedef struct
+{
+	hal_ctimer_capture_edge_en edge;
+	/**< Flanco de la *señal de captura* ante el cual se captura el valor del contador.*/
+	uint8_t interrupt_on_capture;
+	/**< Si este parámetro no es 0, estará habilitada la generación de interrupciones al producirse una captura
+	en el canal de esta configuración. Se ejecutará la función especificada en hal_ctimer_capture_config_t::callback.*/
+	uint8_t enable_external_pin;
+	/**< Si este parámetro no es 0, la *señal de captura* del canal configurado será tomada del pin externo
+	del microcontrolador determinado por el parámetro hal_ctimer_capture_config_t::capture_pin. */
+	hal_gpio_portpin_en capture_pin;
+	/**< Selección de pin externo del microcontrolador del cual tomar la *señal de captura* del canal configurado,
+	cuando hal_ctimer_capture_config_t::enable_external_pin lo habilite.*/
+	void (*callback)(void);
+	/**< Cuando hal_ctimer_capture_config_t::interrupt_on_capture lo habilite, ésta será la función a ejecutar cuando
+	el *CTIMER* genere una interrupción al haberse producido una captura en el canal de esta configuración.*/
+}hal_ctimer_capture_config_t;
+
 /**
  * @brief Inicialización del periférico *CTIMER* en modo timer.
  *
@@ -314,6 +367,57 @@ void hal_ctimer_match_set_output(hal_ctimer_match_sel_en match);
  */
 void hal_ctimer_match_clear_output(hal_ctimer_match_sel_en match);
 
+/**
+ * @brief Cambia el valor de *MATCH* del canal de match especificado, en cuentas del contador.
+ *
+ * A diferencia de hal_ctimer_timer_mode_match_change_value(), el valor no es convertido desde microsegundos, por lo
+ * que esta función es apta para ser llamada desde un contexto de interrupción.
+ *
+ * @param[in] match Canal de *match* a configurar.
+ * @param[in] match_ticks Nuevo valor de match, en cuentas del contador.
+ * @see hal_ctimer_timer_mode_match_change_value
+ * @see hal_ctimer_timer_mode_clock_get
+ */
+void hal_ctimer_timer_mode_match_change_ticks(hal_ctimer_match_sel_en match, uint32_t match_ticks);
+
+/**
+ * @brief Configurar un canal de captura
+ *
+ * El canal de captura especificado por el parámetro *capture_sel* será configurado según la
+ * estructura *capture_config*.
+ *
+ * @note Antes de llamar a esta función, el periférico debiera de haber sido inicializado con
+ * la función hal_ctimer_timer_mode_init().
+ * @note Esta función no dispara ni detiene el contador.
+ *
+ * @param[in] capture_sel Canal de captura a configurar.
+ * @param[in] capture_config Estructura con los parámetros de configuración deseados.
+ * @see hal_ctimer_capture_config_t
+ * @see hal_ctimer_timer_mode_capture_read
+ */
+void hal_ctimer_timer_mode_capture_config(hal_ctimer_capture_sel_en capture_sel, const hal_ctimer_capture_config_t *capture_config);
+
+/**
+ * @brief Lee el último valor capturado por un canal de captura.
+ * @param[in] capture_sel Canal de captura a consultar.
+ * @return Valor del contador en el momento de la última captura.
+ * @see hal_ctimer_timer_mode_capture_config
+ */
+uint32_t hal_ctimer_timer_mode_capture_read(hal_ctimer_capture_sel_en capture_sel);
+
+/**
+ * @brief Lee el valor actual del contador del *CTIMER*.
+ * @return Valor actual del contador.
+ */
+uint32_t hal_ctimer_timer_mode_counter_read(void);
+
+/**
+ * @brief Obtener la frecuencia de conteo del *CTIMER*.
+ * @return Frecuencia de conteo en Hz.
+ * @see hal_ctimer_timer_mode_init
+ */
+uint32_t hal_ctimer_timer_mode_clock_get(void);
+
 /**
  * @brief Inicialización del periférico *CTIMER* en modo PWM.
  *
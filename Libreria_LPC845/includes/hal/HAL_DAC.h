@@ -38,6 +38,41 @@
  * @note Existe una relación entre velocidad de conversión y consumo de energía del periférico. La velocidad de
  * conversión del periférico, se configura en la función @ref hal_dac_init.
  *
+ * # Generación de formas de onda
+ *
+ * Cada *DAC* posee un contador interno que decrementa con el clock del sistema y que, al llegar a cero, se recarga
+ * y genera una interrupción. Con el doble buffer habilitado, el valor escrito en la interrupción queda precargado y
+ * es transferido a la salida recién en el siguiente timeout del contador, con lo cual la actualización de la salida
+ * no tiene *jitter* aunque la latencia de la interrupción varíe. Sobre este mecanismo se implementan dos modos:
+ * 		- Reproducción de tabla (@ref hal_dac_wave_table_start): Se recorre una tabla de muestras en forma cíclica,
+ * 		una muestra por período de muestreo.
+ * 		- Síntesis digital directa (DDS) (@ref hal_dac_wave_dds_start): Un acumulador de fase de 32 bits se
+ * 		incrementa en cada período de muestreo y sus bits más significativos indexan una tabla de \f$2^N\f$
+ * 		muestras. La frecuencia generada resulta:
+ *
+ * \f{eqnarray*}{
+ * 		f_{out} = \frac{M \cdot f_s}{2^{32}}
+ * \f}
+ *
+ * 		Siendo M la palabra de sintonía. La frecuencia puede cambiarse en tiempo de ejecución mediante
+ * 		@ref hal_dac_wave_dds_set_frequency sin discontinuidades de fase.
+ *
+ * 		- Streaming desde buffer circular (@ref hal_dac_stream_start): Las muestras son tomadas de un buffer circular
+ * 		alimentado por la aplicación mediante @ref hal_dac_stream_write, por ejemplo con datos PCM recibidos por
+ * 		@ref USART o @ref SPI. El buffer es de un único productor (que puede ser otra interrupción) y un único
+ * 		consumidor (la interrupción del *DAC*), por lo que el traspaso de muestras no requiere inhibir interrupciones;
+ * 		solo la actualización de las estadísticas se realiza con las interrupciones enmascaradas durante unas pocas
+ * 		instrucciones. La reproducción comienza una vez que el buffer alcanzó la mitad
+ * 		de su capacidad; a partir de ahí, cada período de muestreo sin muestras disponibles se contabiliza como un
+ * 		*underrun* y se mantiene el último valor en la salida. Los niveles máximo y mínimo de ocupación pueden
+ * 		consultarse con @ref hal_dac_stream_get_stats para dimensionar el buffer.
+ * 		.
+ *
+ * Se provee la tabla @ref hal_dac_wave_sine_table con un ciclo de senoidal de amplitud completa, apta para el modo
+ * DDS. Los valores de las tablas son directamente los valores de 10 bits a escribir en el *DAC*.
+ *
+ * @note La interrupción del *DAC1* es compartida con la del canal 5 de @ref PININT.
+ *
  * # Campos de aplicación típicos
  *
  * - Generación de señales de naturaleza analógica
@@ -79,6 +114,12 @@
 extern "C" {
 #endif
 
+/** Frecuencia de muestreo máxima admitida para la generación de formas de onda */
+#define		HAL_DAC_WAVE_MAX_SAMPLE_RATE		(1000000)
+
+/** Cantidad de bits de índice de la tabla senoidal provista */
+#define		HAL_DAC_WAVE_SINE_TABLE_BITS		(8)
+
 /** Enumeraciones de instancias disponibles de *DAC* */
 typedef enum
 {
@@ -103,6 +144,28 @@ typedef struct
 	uint8_t dma_request : 1; /**< Pedido de DMA */
 }hal_dac_ctrl_config_t;
 
+/** Resultados posibles de las funciones de generación de formas de onda */
+typedef enum
+{
+	HAL_DAC_WAVE_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_DAC_WAVE_RESULT_INVALID_RATE, /**< Frecuencia de muestreo no alcanzable con el clock actual */
+	HAL_DAC_WAVE_RESULT_INVALID_TABLE, /**< Tabla nula o de longitud inválida */
+	HAL_DAC_WAVE_RESULT_INVALID_FREQUENCY, /**< Frecuencia de salida mayor a la mitad de la de muestreo */
+	HAL_DAC_WAVE_RESULT_WRONG_MODE /**< El *DAC* no se encuentra en el modo requerido */
+}hal_dac_wave_result_en;
+
+/** Estadísticas del streaming desde buffer circular */
+typedef struct
+{
+	uint32_t underruns; /**< Cantidad de períodos de muestreo sin muestras disponibles */
+	uint16_t level; /**< Cantidad de muestras actualmente en el buffer */
+	uint16_t high_watermark; /**< Máxima ocupación observada */
+	uint16_t low_watermark; /**< Mínima ocupación observada una vez comenzada la reproducción */
+}hal_dac_stream_stats_t;
+
+/** Tabla de un ciclo de senoidal de amplitud completa (valores de 1 a 1023) */
+extern const uint16_t hal_dac_wave_sine_table[1 << HAL_DAC_WAVE_SINE_TABLE_BITS];
+
 /**
  * @brief Inicialización del DAC
  *
@@ -130,6 +193,96 @@ void hal_dac_update_value(hal_dac_sel_en dac, uint16_t new_value);
  */
 void hal_dac_config_ctrl(hal_dac_sel_en dac, hal_dac_ctrl_config_t * config);
 
+/**
+ * @brief Comenzar la reproducción cíclica de una tabla de muestras
+ *
+ * El contador interno del *DAC* y el doble buffer quedan habilitados, y en cada interrupción del *DAC* se precarga
+ * la siguiente muestra de la tabla.
+ *
+ * @param[in] dac Que DAC utilizar
+ * @param[in] table Tabla de muestras a reproducir. Debe permanecer válida mientras dure la reproducción
+ * @param[in] length Cantidad de muestras de la tabla
+ * @param[in] sample_rate Frecuencia de muestreo en Hz
+ * @return Resultado de la operación
+ * @pre Haber inicializado el periférico
+ */
+hal_dac_wave_result_en hal_dac_wave_table_start(hal_dac_sel_en dac, const uint16_t *table, uint16_t length, uint32_t sample_rate);
+
+/**
+ * @brief Comenzar la síntesis digital directa (DDS) de una forma de onda
+ * @param[in] dac Que DAC utilizar
+ * @param[in] table Tabla de un ciclo de la forma de onda, de 2^table_bits muestras. Debe permanecer válida
+ * mientras dure la síntesis
+ * @param[in] table_bits Cantidad de bits de índice de la tabla (de 1 a 16)
+ * @param[in] sample_rate Frecuencia de muestreo en Hz
+ * @param[in] frequency Frecuencia de salida en Hz
+ * @return Resultado de la operación
+ * @pre Haber inicializado el periférico
+ */
+hal_dac_wave_result_en hal_dac_wave_dds_start(hal_dac_sel_en dac, const uint16_t *table, uint8_t table_bits, uint32_t sample_rate, uint32_t frequency);
+
+/**
+ * @brief Cambiar la frecuencia de salida de la síntesis en curso
+ *
+ * El cambio se aplica en la siguiente muestra, manteniendo la continuidad de fase.
+ *
+ * @param[in] dac Que DAC actualizar
+ * @param[in] frequency Nueva frecuencia de salida en Hz
+ * @return Resultado de la operación
+ * @pre Haber comenzado la síntesis mediante @ref hal_dac_wave_dds_start
+ */
+hal_dac_wave_result_en hal_dac_wave_dds_set_frequency(hal_dac_sel_en dac, uint32_t frequency);
+
+/**
+ * @brief Comenzar el streaming de muestras desde un buffer circular
+ * @param[in] dac Que DAC utilizar
+ * @param[in] buffer Memoria para el buffer circular. Debe permanecer válida mientras dure el streaming
+ * @param[in] size Cantidad de muestras del buffer. Debe ser potencia de 2, entre 2 y 32768
+ * @param[in] sample_rate Frecuencia de muestreo en Hz
+ * @return Resultado de la operación
+ * @pre Haber inicializado el periférico
+ */
+hal_dac_wave_result_en hal_dac_stream_start(hal_dac_sel_en dac, uint16_t *buffer, uint16_t size, uint32_t sample_rate);
+
+/**
+ * @brief Cargar muestras en el buffer circular del streaming
+ *
+ * Se cargan tantas muestras como lugar libre haya en el buffer. Esta función no debe ser llamada en forma
+ * concurrente desde distintos contextos para un mismo *DAC*.
+ *
+ * @param[in] dac Que DAC alimentar
+ * @param[in] samples Muestras a cargar (valores de 10 bits)
+ * @param[in] count Cantidad de muestras a cargar
+ * @return Cantidad de muestras efectivamente cargadas
+ * @pre Haber comenzado el streaming mediante @ref hal_dac_stream_start
+ */
+uint16_t hal_dac_stream_write(hal_dac_sel_en dac, const uint16_t *samples, uint16_t count);
+
+/**
+ * @brief Obtener la cantidad de lugares libres en el buffer circular del streaming
+ * @param[in] dac Que DAC consultar
+ * @return Cantidad de muestras que pueden cargarse sin descartar datos
+ */
+uint16_t hal_dac_stream_get_free(hal_dac_sel_en dac);
+
+/**
+ * @brief Obtener las estadísticas del streaming
+ * @param[in] dac Que DAC consultar
+ * @param[out] stats Estadísticas del streaming
+ * @param[in] reset Si es distinto de cero, reinicia la cuenta de underruns y los niveles máximo y mínimo
+ * @return Resultado de la operación
+ */
+hal_dac_wave_result_en hal_dac_stream_get_stats(hal_dac_sel_en dac, hal_dac_stream_stats_t *stats, uint8_t reset);
+
+/**
+ * @brief Detener la generación de formas de onda
+ *
+ * El *DAC* mantiene el último valor convertido.
+ *
+ * @param[in] dac Que DAC detener
+ */
+void hal_dac_wave_stop(hal_dac_sel_en dac);
+
 #if defined (__cplusplus)
 } // extern "C"
 #endif
@@ -0,0 +1,211 @@
+/**
+ * @file HAL_DIV.h
+ * @brief Declaraciones a nivel de aplicacion de las rutinas de división entera (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup DIV División entera
+ *
+ * # Introducción
+ *
+ * El núcleo Cortex-M0+ no dispone de instrucción de división, por lo que cada división entera se resuelve por
+ * software. El LPC845 incluye en su ROM rutinas de división optimizadas, las cuales obtienen el cociente y el resto
+ * en un único llamado. Este módulo permite utilizarlas explícitamente, independientemente de que el proyecto
+ * defina *__USE_ROMDIVIDE* (el cual redirige las divisiones del compilador mediante *aeabi_romdiv_patch.s*).
+ *
+ * Las funciones de la librería que dividen en tiempo de ejecución utilizan este módulo.
+ *
+ * # Divisor constante
+ *
+ * Cuando se divide muchas veces por el mismo divisor (por ejemplo, en una interrupción), la división puede
+ * reemplazarse por una multiplicación por el recíproco del divisor. La función @ref hal_div_reciprocal_init calcula
+ * (una única vez, con @ref hal_div_unsigned_64) los parámetros del recíproco, y luego @ref hal_div_reciprocal_apply
+ * obtiene el cociente exacto para cualquier numerador de 32 bits utilizando únicamente multiplicaciones,
+ * sumas y desplazamientos:
+ *
+ * ~~~{.c}
+ * static hal_div_reciprocal_t div_by_period;
+ *
+ * hal_div_reciprocal_init(&div_by_period, period);
+ *
+ * // En la interrupcion
+ * cycles = hal_div_reciprocal_apply(&div_by_period, ticks);
+ * ~~~
+ *
+ * # Numeradores de 64 bits
+ *
+ * La función @ref hal_div_unsigned_64 divide un numerador de 64 bits por un divisor de 32 bits mediante divisiones de
+ * 32 bits de la ROM, en lugar de la división de 64 bits de la biblioteca (que, a diferencia de las de 32 bits, no es
+ * redirigida por *aeabi_romdiv_patch.s*). Permite calcular expresiones del tipo (a * b) / c sin desborde ni punto
+ * flotante.
+ *
+ * # Medición
+ *
+ * El costo de cada alternativa depende del divisor y del numerador, por lo que conviene medirlo para los casos de
+ * la aplicación. La función @ref hal_div_benchmark mide, para un divisor dado, @ref HAL_DIV_BENCHMARK_ITERATIONS
+ * divisiones con la división del compilador, con @ref hal_div_unsigned y con @ref hal_div_reciprocal_apply,
+ * mediante un contador por hardware provisto por la aplicación:
+ *
+ * ~~~{.c}
+ * static const uint32_t divisors[] = { 3, 10, 1000, 12000000 };
+ * hal_div_benchmark_t results[4];
+ *
+ * for(counter = 0; counter < 4; counter++)
+ * {
+ * 	hal_div_benchmark(divisors[counter], ctimer_counter_read, &results[counter]);
+ * }
+ * ~~~
+ *
+ * La división del compilador corresponde a la de *libgcc* si el proyecto no define *__USE_ROMDIVIDE*, y a la de la ROM
+ * (a través de *aeabi_romdiv_patch.s*) si lo define, por lo que la comparación con *libgcc* requiere compilar sin
+ * dicho símbolo. A todos los tiempos medidos debe restarse el costo del lazo vacío (campo *overhead*).
+ *
+ * @{
+ */
+
+#ifndef HAL_DIV_H_
+#define HAL_DIV_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Cantidad de divisiones de cada medición de @ref hal_div_benchmark */
+#define		HAL_DIV_BENCHMARK_ITERATIONS		256
+
+/** Resultados posibles de las funciones de división */
+typedef enum
+{
+	HAL_DIV_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_DIV_RESULT_DIVISION_BY_ZERO /**< El divisor es cero */
+}hal_div_result_en;
+
+/** Cociente y resto de una división con signo */
+typedef struct
+{
+	int32_t quot; /**< Cociente */
+	int32_t rem; /**< Resto */
+}hal_div_signed_result_t;
+
+/** Cociente y resto de una división sin signo */
+typedef struct
+{
+	uint32_t quot; /**< Cociente */
+	uint32_t rem; /**< Resto */
+}hal_div_unsigned_result_t;
+
+/** Parámetros de división por un divisor constante */
+typedef struct
+{
+	uint32_t divisor; /**< Divisor */
+	uint32_t multiplier; /**< Multiplicador (parte baja del recíproco escalado) */
+	uint8_t shift_1; /**< Primer desplazamiento */
+	uint8_t shift_2; /**< Segundo desplazamiento */
+}hal_div_reciprocal_t;
+
+/**
+ * @brief Callback de lectura de un contador por hardware
+ * @return Valor actual del contador (ascendente)
+ */
+typedef uint32_t (*hal_div_timestamp_callback)(void);
+
+/** Resultados de la medición de una alternativa de división, en unidades del contador provisto */
+typedef struct
+{
+	uint32_t overhead; /**< Lazo sin división */
+	uint32_t compiler; /**< División del compilador */
+	uint32_t rom; /**< @ref hal_div_unsigned */
+	uint32_t reciprocal; /**< @ref hal_div_reciprocal_apply */
+}hal_div_benchmark_t;
+
+/**
+ * @brief División sin signo
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente
+ */
+uint32_t hal_div_unsigned(uint32_t numerator, uint32_t denominator);
+
+/**
+ * @brief División con signo
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente, truncado hacia cero
+ */
+int32_t hal_div_signed(int32_t numerator, int32_t denominator);
+
+/**
+ * @brief División sin signo obteniendo cociente y resto
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente y resto
+ */
+hal_div_unsigned_result_t hal_div_unsigned_divmod(uint32_t numerator, uint32_t denominator);
+
+/**
+ * @brief División con signo obteniendo cociente y resto
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente, truncado hacia cero, y resto con el signo del numerador
+ */
+hal_div_signed_result_t hal_div_signed_divmod(int32_t numerator, int32_t denominator);
+
+/**
+ * @brief División sin signo de un numerador de 64 bits
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente
+ */
+uint64_t hal_div_unsigned_64(uint64_t numerator, uint32_t denominator);
+
+/**
+ * @brief Calcular los parámetros de división por un divisor constante
+ * @param[out] reciprocal Parámetros calculados
+ * @param[in] divisor Divisor
+ * @return Resultado de la operación
+ */
+hal_div_result_en hal_div_reciprocal_init(hal_div_reciprocal_t *reciprocal, uint32_t divisor);
+
+/**
+ * @brief Dividir por un divisor constante
+ * @param[in] reciprocal Parámetros calculados con @ref hal_div_reciprocal_init
+ * @param[in] numerator Numerador
+ * @return Cociente
+ */
+uint32_t hal_div_reciprocal_apply(const hal_div_reciprocal_t *reciprocal, uint32_t numerator);
+
+/**
+ * @brief Dividir por un divisor constante obteniendo cociente y resto
+ * @param[in] reciprocal Parámetros calculados con @ref hal_div_reciprocal_init
+ * @param[in] numerator Numerador
+ * @return Cociente y resto
+ */
+hal_div_unsigned_result_t hal_div_reciprocal_divmod(const hal_div_reciprocal_t *reciprocal, uint32_t numerator);
+
+/**
+ * @brief Medir el costo de las alternativas de división para un divisor
+ *
+ * Se realizan @ref HAL_DIV_BENCHMARK_ITERATIONS divisiones con cada alternativa, con numeradores distribuidos en
+ * todo el rango de 32 bits.
+ *
+ * @param[in] divisor Divisor a medir
+ * @param[in] timestamp Lectura de un contador por hardware
+ * @param[out] result Tiempos medidos
+ * @return Resultado de la operación
+ */
+hal_div_result_en hal_div_benchmark(uint32_t divisor, hal_div_timestamp_callback timestamp, hal_div_benchmark_t *result);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_DIV_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,170 @@
+/**
+ * @file HAL_EEPROM.h
+ * @brief Declaraciones a nivel de aplicacion de la emulacion de EEPROM en flash (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup EEPROM Emulación de EEPROM
+ *
+ * # Introducción
+ *
+ * El LPC845 no dispone de memoria EEPROM, y la flash únicamente puede escribirse de a páginas de 64 bytes previamente
+ * borradas. Reescribir un sector completo por cada valor modificado es lento y desgasta la flash, por lo que este
+ * módulo implementa un almacenamiento de pares clave/valor de 32 bits estructurado como registro: cada modificación
+ * se agrega a continuación de las anteriores, y el valor vigente de cada clave es el último escrito.
+ *
+ * # Organización
+ *
+ * Se utilizan dos bancos de igual cantidad de sectores consecutivos, de los cuales uno solo está activo. La primera
+ * página de cada banco es su encabezado (con un número de secuencia), y las siguientes contienen hasta
+ * @ref HAL_EEPROM_RECORDS_PER_PAGE registros cada una, protegidas por un CRC.
+ *
+ * Las escrituras se acumulan en una página en RAM, la cual se graba en flash al completarse o al llamar a
+ * @ref hal_eeprom_flush. Escribir una clave que ya está en la página en RAM reemplaza su valor, por lo que los
+ * contadores que cambian seguido consumen una única entrada por página grabada. Las escrituras no grabadas se pierden
+ * ante un corte de energía.
+ *
+ * Cuando el banco activo se llena, el valor vigente de cada clave se copia al otro banco (previamente borrado), se
+ * graba el encabezado del nuevo banco con el número de secuencia siguiente, y recién entonces se borra el banco
+ * anterior.
+ *
+ * # Cortes de energía
+ *
+ * Ninguna página se graba más de una vez entre borrados. Una página cuya grabación fue interrumpida no cumple su CRC y
+ * se ignora, y un banco cuyo encabezado no fue grabado no se considera válido, por lo que un corte en cualquier punto
+ * conserva el estado de la última página grabada completa. Si al inicializar ambos bancos son válidos (corte antes de
+ * borrar el banco anterior), se utiliza el de mayor secuencia y se borra el otro.
+ *
+ * # Índice
+ *
+ * Las claves son números de 0 a *max_keys* - 1 (por ejemplo, los valores de un *enum* de la aplicación). Durante la
+ * inicialización se recorren las páginas grabadas del banco activo (a lo sumo la cantidad de páginas de un banco) y se
+ * arma en RAM un índice con la posición en flash del último registro de cada clave, de modo que cada lectura es de
+ * tiempo constante.
+ *
+ * # Dimensionamiento
+ *
+ * Cada banco debe alojar el encabezado, una página por cada @ref HAL_EEPROM_RECORDS_PER_PAGE claves, y al menos una
+ * página libre. Cuantas más páginas libres queden tras la compactación, menos frecuentes son los borrados: por
+ * ejemplo, con 100 claves y bancos de 2 sectores (32 páginas), se graban 16 páginas entre compactaciones.
+ *
+ * # Pruebas en PC
+ *
+ * Las lecturas de flash se realizan mediante la macro @ref HAL_EEPROM_FLASH_POINTER, y las escrituras mediante
+ * @ref IAP. Definiendo dicha macro y reemplazando el módulo @ref IAP por una simulación sobre un arreglo en memoria,
+ * este módulo puede compilarse y probarse en una PC, incluyendo la simulación de cortes de energía.
+ *
+ * @{
+ */
+
+#ifndef HAL_EEPROM_H_
+#define HAL_EEPROM_H_
+
+#include <stdint.h>
+#include "HAL_IAP.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#ifndef HAL_EEPROM_FLASH_POINTER
+/** Puntero para leer una dirección de flash */
+#define		HAL_EEPROM_FLASH_POINTER(address)		((const uint8_t *) (address))
+#endif
+
+/** Cantidad de registros por página */
+#define		HAL_EEPROM_RECORDS_PER_PAGE				7
+
+/** Valor del índice para una clave sin registros */
+#define		HAL_EEPROM_INDEX_EMPTY					0xFFFF
+
+/** Resultados de las funciones de EEPROM */
+typedef enum
+{
+	HAL_EEPROM_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_EEPROM_RESULT_NOT_FOUND, /**< La clave no tiene valor */
+	HAL_EEPROM_RESULT_INVALID_KEY, /**< Clave fuera de rango */
+	HAL_EEPROM_RESULT_CONFIG_ERROR, /**< Los bancos no alcanzan para la cantidad de claves */
+	HAL_EEPROM_RESULT_FLASH_ERROR /**< Falló un borrado o una escritura de flash */
+}hal_eeprom_result_en;
+
+/** Configuración de una EEPROM emulada */
+typedef struct
+{
+	uint32_t first_sector; /**< Primer sector del primer banco. El segundo banco le sigue inmediatamente */
+	uint32_t bank_sectors; /**< Cantidad de sectores de cada banco */
+	uint16_t *index; /**< Índice en RAM, de *max_keys* elementos */
+	uint16_t max_keys; /**< Cantidad de claves */
+}hal_eeprom_config_t;
+
+/** Estado de una EEPROM emulada */
+typedef struct
+{
+	hal_eeprom_config_t config; /**< Configuración */
+	uint32_t bank_address; /**< Dirección del banco activo */
+	uint32_t sequence; /**< Número de secuencia del banco activo */
+	uint32_t next_page; /**< Desplazamiento de la próxima página libre en el banco activo */
+	uint32_t staging[HAL_IAP_PAGE_SIZE / sizeof(uint32_t)]; /**< Página de registros aún no grabados */
+	uint8_t staged_count; /**< Cantidad de registros aún no grabados */
+	uint32_t page_writes; /**< Cantidad de páginas grabadas desde la inicialización */
+	uint32_t compactions; /**< Cantidad de compactaciones desde la inicialización */
+}hal_eeprom_t;
+
+/**
+ * @brief Inicializar una EEPROM emulada
+ *
+ * Recupera el banco activo y arma el índice. Si ningún banco es válido, ambos se borran.
+ *
+ * @param[out] eeprom Estado de la EEPROM
+ * @param[in] config Configuración deseada
+ * @return Resultado de la operación
+ */
+hal_eeprom_result_en hal_eeprom_init(hal_eeprom_t *eeprom, const hal_eeprom_config_t *config);
+
+/**
+ * @brief Leer el valor de una clave
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[in] key Clave a leer
+ * @param[out] value Valor de la clave
+ * @return Resultado de la operación
+ */
+hal_eeprom_result_en hal_eeprom_read(const hal_eeprom_t *eeprom, uint16_t key, uint32_t *value);
+
+/**
+ * @brief Escribir el valor de una clave
+ *
+ * El valor se acumula en la página en RAM, la cual se graba al completarse. Si el valor no cambió, no se escribe.
+ *
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[in] key Clave a escribir
+ * @param[in] value Valor a escribir
+ * @return Resultado de la operación
+ */
+hal_eeprom_result_en hal_eeprom_write(hal_eeprom_t *eeprom, uint16_t key, uint32_t value);
+
+/**
+ * @brief Grabar en flash las escrituras acumuladas
+ * @param[in] eeprom Estado de la EEPROM
+ * @return Resultado de la operación
+ */
+hal_eeprom_result_en hal_eeprom_flush(hal_eeprom_t *eeprom);
+
+/**
+ * @brief Borrar todos los valores
+ * @param[in] eeprom Estado de la EEPROM
+ * @return Resultado de la operación
+ */
+hal_eeprom_result_en hal_eeprom_format(hal_eeprom_t *eeprom);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_EEPROM_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,198 @@
+/**
+ * @file HAL_IAP.h
+ * @brief Declaraciones a nivel de aplicacion de la programacion en aplicacion (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup IAP Programación en aplicación (IAP)
+ *
+ * # Introducción
+ *
+ * La ROM del LPC845 incluye rutinas de programación en aplicación (*IAP*), mediante las cuales el programa puede
+ * borrar y escribir su propia memoria flash, por ejemplo para actualizar el firmware en campo o para guardar
+ * configuraciones persistentes. La flash de 64KB se organiza en 64 sectores de 1KB, cada uno de ellos formado por 16
+ * páginas de 64 bytes.
+ *
+ * # Operaciones
+ *
+ * Cada operación de borrado o escritura requiere previamente un comando de preparación de los sectores afectados,
+ * el cual este módulo envía automáticamente:
+ * 	- @ref hal_iap_erase_sectors borra sectores completos.
+ * 	- @ref hal_iap_erase_pages borra páginas individuales, lo cual permite modificar una zona chica sin borrar (y
+ * 	desgastar) el sector completo.
+ * 	- @ref hal_iap_program escribe datos de a páginas. Cada escritura se divide en la menor cantidad de operaciones
+ * 	posibles (de 1024, 512, 256, 128 o 64 bytes), ya que el tiempo de cada operación depende poco de su tamaño.
+ * 	- @ref hal_iap_blank_check y @ref hal_iap_compare permiten verificar el resultado.
+ * 	.
+ *
+ * # Interrupciones
+ *
+ * Mientras la flash se borra o escribe la misma no puede leerse, por lo que ninguna rutina de interrupción ubicada
+ * en flash (ni la tabla de vectores) puede ejecutarse. Por esta razón, este módulo enmascara las interrupciones
+ * (mediante *PRIMASK*) durante cada comando, y las restituye a su estado anterior al finalizar. Las interrupciones que
+ * ocurran mientras tanto quedan pendientes y se atienden al finalizar el comando, con una latencia de hasta la
+ * duración del mismo. Con el símbolo *HAL_RAMFUNC_ENABLE* definido, el tramo que enmascara las interrupciones y llama
+ * a la ROM se ubica en RAM (ver @ref RAMFUNC).
+ *
+ * # Requisitos
+ *
+ * Las rutinas en ROM utilizan los 32 bytes superiores de la SRAM, los cuales deben reservarse en el linker script (en
+ * MCUXpresso, mediante la opción *Reserve RAM for IAP*, o reduciendo el tamaño de la región de RAM). Los datos a
+ * escribir deben estar en RAM y alineados a 32 bits.
+ *
+ * # Medición
+ *
+ * La función @ref hal_iap_benchmark borra y escribe un sector de prueba midiendo la duración de cada operación
+ * mediante un contador por hardware provisto por la aplicación (por ejemplo, el de un timer en modo libre), ya que
+ * los contadores mantenidos por interrupciones no avanzan mientras las mismas están enmascaradas.
+ *
+ * @{
+ */
+
+#ifndef HAL_IAP_H_
+#define HAL_IAP_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Tamaño de la memoria flash en bytes */
+#define		HAL_IAP_FLASH_SIZE				(64 * 1024)
+
+/** Tamaño de un sector en bytes */
+#define		HAL_IAP_SECTOR_SIZE				1024
+
+/** Tamaño de una página en bytes */
+#define		HAL_IAP_PAGE_SIZE				64
+
+/** Cantidad de sectores */
+#define		HAL_IAP_SECTOR_AMOUNT			(HAL_IAP_FLASH_SIZE / HAL_IAP_SECTOR_SIZE)
+
+/** Cantidad de páginas */
+#define		HAL_IAP_PAGE_AMOUNT				(HAL_IAP_FLASH_SIZE / HAL_IAP_PAGE_SIZE)
+
+/** Sector al cual pertenece una dirección de flash */
+#define		HAL_IAP_ADDRESS_TO_SECTOR(x)	((x) / HAL_IAP_SECTOR_SIZE)
+
+/** Página a la cual pertenece una dirección de flash */
+#define		HAL_IAP_ADDRESS_TO_PAGE(x)		((x) / HAL_IAP_PAGE_SIZE)
+
+/** Códigos de estado de las rutinas IAP */
+typedef enum
+{
+	HAL_IAP_STATUS_SUCCESS = 0, /**< Comando exitoso */
+	HAL_IAP_STATUS_INVALID_COMMAND, /**< Comando inválido */
+	HAL_IAP_STATUS_SRC_ADDR_ERROR, /**< Dirección de origen no alineada a 32 bits */
+	HAL_IAP_STATUS_DST_ADDR_ERROR, /**< Dirección de destino no alineada a una página */
+	HAL_IAP_STATUS_SRC_ADDR_NOT_MAPPED, /**< Dirección de origen fuera del mapa de memoria */
+	HAL_IAP_STATUS_DST_ADDR_NOT_MAPPED, /**< Dirección de destino fuera del mapa de memoria */
+	HAL_IAP_STATUS_COUNT_ERROR, /**< Cantidad de bytes no múltiplo de una página */
+	HAL_IAP_STATUS_INVALID_SECTOR, /**< Número de sector o página inválido */
+	HAL_IAP_STATUS_SECTOR_NOT_BLANK, /**< Sector no vacío */
+	HAL_IAP_STATUS_SECTOR_NOT_PREPARED, /**< Sector no preparado para escritura */
+	HAL_IAP_STATUS_COMPARE_ERROR, /**< Los datos comparados difieren */
+	HAL_IAP_STATUS_BUSY, /**< Interfaz de programación ocupada */
+	HAL_IAP_STATUS_PARAM_ERROR /**< Parámetro inválido */
+}hal_iap_status_en;
+
+/**
+ * @brief Callback de lectura de un contador por hardware
+ * @return Valor actual del contador (ascendente)
+ */
+typedef uint32_t (*hal_iap_timestamp_callback)(void);
+
+/** Resultados de la medición de tiempos, en unidades del contador provisto */
+typedef struct
+{
+	uint32_t sector_erase; /**< Borrado de un sector */
+	uint32_t page_erase; /**< Borrado de una página */
+	uint32_t sector_program; /**< Escritura de un sector en una única operación */
+	uint32_t sector_program_by_pages; /**< Escritura de un sector de a una página por operación */
+}hal_iap_benchmark_t;
+
+/**
+ * @brief Borrar sectores
+ * @param[in] start_sector Primer sector a borrar
+ * @param[in] end_sector Último sector a borrar (inclusive)
+ * @return Código de estado
+ */
+hal_iap_status_en hal_iap_erase_sectors(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Borrar páginas
+ * @param[in] start_page Primera página a borrar
+ * @param[in] end_page Última página a borrar (inclusive)
+ * @return Código de estado
+ */
+hal_iap_status_en hal_iap_erase_pages(uint32_t start_page, uint32_t end_page);
+
+/**
+ * @brief Escribir datos en flash
+ * @param[in] address Dirección de flash, alineada a una página
+ * @param[in] data Datos a escribir, en RAM y alineados a 32 bits
+ * @param[in] length Cantidad de bytes, múltiplo de @ref HAL_IAP_PAGE_SIZE
+ * @return Código de estado
+ * @pre Las páginas a escribir deben estar borradas
+ */
+hal_iap_status_en hal_iap_program(uint32_t address, const void *data, uint32_t length);
+
+/**
+ * @brief Verificar que un rango de sectores esté borrado
+ * @param[in] start_sector Primer sector a verificar
+ * @param[in] end_sector Último sector a verificar (inclusive)
+ * @param[out] non_blank_address Dirección de la primera palabra no borrada. Puede ser NULL
+ * @return @ref HAL_IAP_STATUS_SUCCESS si los sectores están borrados, o @ref HAL_IAP_STATUS_SECTOR_NOT_BLANK
+ */
+hal_iap_status_en hal_iap_blank_check(uint32_t start_sector, uint32_t end_sector, uint32_t *non_blank_address);
+
+/**
+ * @brief Comparar el contenido de la flash con datos en RAM
+ * @param[in] address Dirección de flash, alineada a 32 bits
+ * @param[in] data Datos a comparar, alineados a 32 bits
+ * @param[in] length Cantidad de bytes, múltiplo de 4
+ * @return @ref HAL_IAP_STATUS_SUCCESS si coinciden, o @ref HAL_IAP_STATUS_COMPARE_ERROR
+ */
+hal_iap_status_en hal_iap_compare(uint32_t address, const void *data, uint32_t length);
+
+/**
+ * @brief Leer el identificador de la parte
+ * @param[out] part_id Identificador de la parte
+ * @return Código de estado
+ */
+hal_iap_status_en hal_iap_read_part_id(uint32_t *part_id);
+
+/**
+ * @brief Leer el número de serie único del dispositivo
+ * @param[out] uid Número de serie (128 bits)
+ * @return Código de estado
+ */
+hal_iap_status_en hal_iap_read_uid(uint32_t uid[4]);
+
+/**
+ * @brief Medir los tiempos de borrado y escritura
+ *
+ * El sector de prueba se borra y se escribe repetidas veces con el contenido de *buffer*, y queda borrado al
+ * finalizar.
+ *
+ * @param[in] sector Sector de prueba, que no debe contener código ni datos
+ * @param[in] buffer Datos de prueba de @ref HAL_IAP_SECTOR_SIZE bytes, en RAM y alineados a 32 bits
+ * @param[in] timestamp Lectura de un contador por hardware
+ * @param[out] result Tiempos medidos
+ * @return Código de estado de la primera operación fallida, o @ref HAL_IAP_STATUS_SUCCESS
+ */
+hal_iap_status_en hal_iap_benchmark(uint32_t sector, const void *buffer, hal_iap_timestamp_callback timestamp, hal_iap_benchmark_t *result);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_IAP_H_ */
+
+/**
+ * @}
+ */
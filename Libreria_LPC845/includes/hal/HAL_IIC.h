@@ -0,0 +1,241 @@
+/**
+ * @file HAL_IIC.h
+ * @brief Declaraciones a nivel de aplicacion del periferico IIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup IIC Bus de Circuitos Inter-Integrados (IIC)
+ *
+ * # Introducción
+ *
+ * El bus *IIC* (también llamado *I2C*) es un bus serie sincrónico de dos líneas (*SDA* y *SCL*), ambas de tipo
+ * colector abierto, en el cual un dispositivo *master* direcciona a uno o más dispositivos *slave* mediante
+ * direcciones de 7 bits. El LPC845 dispone de cuatro instancias, cada una de las cuales puede funcionar como master,
+ * como slave, o ambas a la vez.
+ *
+ * # Cola de transacciones en modo master
+ *
+ * Las transacciones del modo master se describen mediante estructuras del tipo @ref hal_iic_master_transaction_t,
+ * que pertenecen a la aplicación y se encolan en la instancia correspondiente mediante
+ * @ref hal_iic_master_transaction_queue. Cada transacción consiste en una escritura opcional seguida de una lectura
+ * opcional: si ambas están presentes, la lectura se realiza mediante un *start repetido*, sin liberar el bus, que es
+ * la forma habitual de leer registros de sensores y memorias. Una transacción sin datos únicamente direcciona al
+ * slave, y permite detectar su presencia.
+ *
+ * Toda la transacción se resuelve en la interrupción de la instancia, y al finalizar se actualiza el campo *result*
+ * de la misma y se llama a su callback (si existe) desde la interrupción, tras lo cual comienza la siguiente
+ * transacción de la cola. De esta manera la aplicación puede encolar varias lecturas y continuar con otras tareas, sin
+ * esperas activas byte a byte. La estructura de la transacción y sus buffers deben permanecer válidos hasta que la
+ * misma finalice, y una transacción finalizada puede volver a encolarse (incluso desde su propio callback).
+ *
+ * # Modo slave
+ *
+ * En modo slave se pueden configurar hasta cuatro direcciones (la primera con una máscara de bits ignorados). Ante
+ * cada direccionamiento, incluyendo los *start repetidos*, se llama al callback de selección indicando la dirección y
+ * el sentido de la transferencia; en el caso de una lectura del master, el callback puede indicar la respuesta
+ * mediante @ref hal_iic_slave_tx_set. Los datos escritos por el master se acumulan en el buffer de recepción y se
+ * entregan al callback de recepción al finalizar cada tramo de escritura.
+ *
+ * # Fast-mode Plus
+ *
+ * Los pines *PIO0_10* (*SCL*) y *PIO0_11* (*SDA*) son pines de colector abierto reales, con la capacidad de corriente
+ * necesaria para el modo *Fast-mode Plus* (hasta 1MHz), y son los únicos utilizables para ello. Por esta razón, la
+ * instancia 0 utiliza siempre dichos pines y su configuración de modo de pin depende de la velocidad pedida. Las
+ * demás instancias utilizan pines asignables mediante la *Switch Matrix*, configurados como colector abierto, y
+ * quedan limitadas al modo *Fast-mode* (400KHz).
+ *
+ * @{
+ */
+
+#ifndef HAL_IIC_H_
+#define HAL_IIC_H_
+
+#include <stdint.h>
+#include "HAL_SYSCON.h"
+#include "HAL_GPIO.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Valor de dirección de slave para indicar que la misma no se utiliza */
+#define		HAL_IIC_SLAVE_ADDRESS_NOT_USED			0xFF
+
+/** Velocidad máxima en modo *Fast-mode* */
+#define		HAL_IIC_FAST_MODE_BITRATE				400000
+
+/** Velocidad máxima en modo *Fast-mode Plus* (únicamente instancia 0) */
+#define		HAL_IIC_FAST_MODE_PLUS_BITRATE			1000000
+
+/** Selección de instancia de IIC */
+typedef enum
+{
+	HAL_IIC_0 = 0, /**< Instancia 0 (pines fijos *PIO0_10* y *PIO0_11*) */
+	HAL_IIC_1, /**< Instancia 1 */
+	HAL_IIC_2, /**< Instancia 2 */
+	HAL_IIC_3 /**< Instancia 3 */
+}hal_iic_sel_en;
+
+/** Resultado de una transacción en modo master */
+typedef enum
+{
+	HAL_IIC_RESULT_OK = 0, /**< Transacción finalizada correctamente, o encolada correctamente */
+	HAL_IIC_RESULT_PENDING, /**< Transacción encolada o en curso */
+	HAL_IIC_RESULT_BUSY, /**< La transacción ya se encuentra encolada */
+	HAL_IIC_RESULT_NACK_ADDRESS, /**< El slave no reconoció su dirección */
+	HAL_IIC_RESULT_NACK_DATA, /**< El slave no reconoció un dato escrito */
+	HAL_IIC_RESULT_ARBITRATION_LOST, /**< Otro master tomó el bus */
+	HAL_IIC_RESULT_BUS_ERROR /**< Condición de start o stop fuera de lugar */
+}hal_iic_result_en;
+
+/** Sentido de una transferencia en modo slave, visto desde el master */
+typedef enum
+{
+	HAL_IIC_SLAVE_DIRECTION_WRITE = 0, /**< El master escribe datos al slave */
+	HAL_IIC_SLAVE_DIRECTION_READ /**< El master lee datos del slave */
+}hal_iic_slave_direction_en;
+
+struct hal_iic_master_transaction;
+
+/**
+ * @brief Callback de finalización de una transacción en modo master
+ *
+ * Se llama desde la interrupción de la instancia.
+ *
+ * @param[in] inst Instancia en la cual finalizó la transacción
+ * @param[in] transaction Transacción finalizada
+ */
+typedef void (*hal_iic_master_callback)(hal_iic_sel_en inst, struct hal_iic_master_transaction *transaction);
+
+/** Transacción en modo master */
+typedef struct hal_iic_master_transaction
+{
+	uint8_t address; /**< Dirección de 7 bits del slave */
+	const uint8_t *tx_data; /**< Datos a escribir. Puede ser NULL si *tx_length* es cero */
+	uint32_t tx_length; /**< Cantidad de datos a escribir */
+	uint8_t *rx_data; /**< Buffer para los datos a leer. Puede ser NULL si *rx_length* es cero */
+	uint32_t rx_length; /**< Cantidad de datos a leer, luego de un start repetido si hay datos a escribir */
+	hal_iic_master_callback callback; /**< Callback de finalización. Puede ser NULL */
+	void *data; /**< Dato de usuario */
+	volatile hal_iic_result_en result; /**< Resultado de la transacción. Inicialmente @ref HAL_IIC_RESULT_OK (cero) */
+	struct hal_iic_master_transaction *next; /**< Uso interno */
+}hal_iic_master_transaction_t;
+
+/** Configuración de una instancia */
+typedef struct
+{
+	hal_syscon_peripheral_clock_sel_en clock_source; /**< Fuente de clock del periférico */
+	hal_gpio_portpin_en sda_portpin; /**< Puerto/pin de SDA. Ignorado en la instancia 0 */
+	hal_gpio_portpin_en scl_portpin; /**< Puerto/pin de SCL. Ignorado en la instancia 0 */
+	uint8_t fast_mode_plus; /**< Distinto de cero para configurar los pines en modo *Fast-mode Plus* (instancia 0) */
+}hal_iic_config_t;
+
+/**
+ * @brief Callback de selección en modo slave
+ *
+ * Se llama desde la interrupción ante cada direccionamiento, incluyendo los start repetidos.
+ *
+ * @param[in] inst Instancia direccionada
+ * @param[in] address_index Índice de la dirección que coincidió (0 a 3)
+ * @param[in] direction Sentido de la transferencia
+ */
+typedef void (*hal_iic_slave_select_callback)(hal_iic_sel_en inst, uint8_t address_index, hal_iic_slave_direction_en direction);
+
+/**
+ * @brief Callback de recepción en modo slave
+ *
+ * Se llama desde la interrupción al finalizar un tramo de escritura del master (por start repetido o por stop) en el
+ * cual se haya recibido al menos un dato.
+ *
+ * @param[in] inst Instancia direccionada
+ * @param[in] address_index Índice de la dirección que coincidió (0 a 3)
+ * @param[in] data Datos recibidos (en el buffer de recepción configurado)
+ * @param[in] length Cantidad de datos recibidos
+ */
+typedef void (*hal_iic_slave_rx_callback)(hal_iic_sel_en inst, uint8_t address_index, const uint8_t *data, uint32_t length);
+
+/** Configuración del modo slave */
+typedef struct
+{
+	uint8_t address[4]; /**< Direcciones de 7 bits, o @ref HAL_IIC_SLAVE_ADDRESS_NOT_USED */
+	uint8_t address_0_mask; /**< Bits de la dirección 0 que se ignoran en la comparación */
+	uint8_t *rx_buffer; /**< Buffer de recepción */
+	uint32_t rx_size; /**< Tamaño del buffer de recepción. Los datos que no entran no se reconocen */
+	hal_iic_slave_select_callback select_callback; /**< Callback de selección. Puede ser NULL */
+	hal_iic_slave_rx_callback rx_callback; /**< Callback de recepción. Puede ser NULL */
+}hal_iic_slave_config_t;
+
+/**
+ * @brief Inicializar una instancia de IIC
+ *
+ * Asigna los pines, selecciona la fuente de clock y habilita el periférico.
+ *
+ * @param[in] inst Instancia a inicializar
+ * @param[in] config Configuración deseada
+ */
+void hal_iic_init(hal_iic_sel_en inst, const hal_iic_config_t *config);
+
+/**
+ * @brief Inicializar el modo master de una instancia
+ *
+ * El período de bit se divide en un estado bajo algo más largo que el estado alto, para cumplir los tiempos mínimos
+ * de los modos *Fast-mode* y *Fast-mode Plus*.
+ *
+ * @param[in] inst Instancia a inicializar
+ * @param[in] bitrate Velocidad deseada en Hz
+ * @return Velocidad obtenida en Hz, menor o igual a la deseada
+ * @pre Haber inicializado la instancia mediante @ref hal_iic_init
+ */
+uint32_t hal_iic_master_init(hal_iic_sel_en inst, uint32_t bitrate);
+
+/**
+ * @brief Encolar una transacción en modo master
+ *
+ * Puede llamarse tanto desde la aplicación como desde un callback.
+ *
+ * @param[in] inst Instancia en la cual encolar la transacción
+ * @param[in] transaction Transacción a encolar
+ * @return @ref HAL_IIC_RESULT_OK si la transacción se encoló, o @ref HAL_IIC_RESULT_BUSY si ya estaba encolada
+ * @pre Haber inicializado el modo master mediante @ref hal_iic_master_init
+ */
+hal_iic_result_en hal_iic_master_transaction_queue(hal_iic_sel_en inst, hal_iic_master_transaction_t *transaction);
+
+/**
+ * @brief Consultar si la cola de transacciones de una instancia está vacía
+ * @param[in] inst Instancia a consultar
+ * @return Distinto de cero si no hay transacciones encoladas ni en curso
+ */
+uint8_t hal_iic_master_is_idle(hal_iic_sel_en inst);
+
+/**
+ * @brief Inicializar el modo slave de una instancia
+ * @param[in] inst Instancia a inicializar
+ * @param[in] config Configuración deseada
+ * @pre Haber inicializado la instancia mediante @ref hal_iic_init
+ */
+void hal_iic_slave_init(hal_iic_sel_en inst, const hal_iic_slave_config_t *config);
+
+/**
+ * @brief Configurar la respuesta a las lecturas del master en modo slave
+ *
+ * Cada lectura del master comienza desde el principio de la respuesta, y una vez agotada la misma se transmite 0xFF.
+ * Normalmente se llama desde el callback de selección.
+ *
+ * @param[in] inst Instancia a configurar
+ * @param[in] data Datos de la respuesta. Deben permanecer válidos mientras se utilicen
+ * @param[in] length Cantidad de datos de la respuesta
+ */
+void hal_iic_slave_tx_set(hal_iic_sel_en inst, const uint8_t *data, uint32_t length);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_IIC_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,124 @@
+/**
+ * @file HAL_MRT.h
+ * @brief Declaraciones a nivel de aplicacion del periferico MRT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup MRT Multi-Rate Timer (MRT)
+ *
+ * # Introducción
+ *
+ * El *MRT* cuenta con 4 canales independientes de 31 bits que cuentan en forma descendente a partir de un intervalo
+ * cargado, excitados por el clock del sistema. Al llegar a cero, cada canal pide la interrupción (común a los cuatro
+ * canales) y, según su modo, se recarga con el intervalo (modo repetitivo) o se detiene (modo *one-shot*).
+ *
+ * # Reparto de canales
+ *
+ * Los canales son utilizados por distintos módulos de la librería (por ejemplo, la recepción de tramas de la
+ * @ref USART y la medición periódica de latencia del @ref NVIC), por lo que cada canal debe reservarse mediante
+ * @ref hal_mrt_channel_claim antes de utilizarse. La reserva falla si el canal ya está en uso, en lugar de que dos
+ * módulos reprogramen el mismo canal.
+ *
+ * # Rutina de interrupción
+ *
+ * Esta librería no define la rutina *MRT_IRQHandler*: la primera reserva instala una rutina propia en la tabla de
+ * vectores en RAM mediante @ref hal_nvic_install_handler, la cual limpia el flag y llama al callback de cada canal
+ * reservado que pidió la interrupción. Si quedan pendientes flags de canales no reservados, se llama a continuación
+ * a la rutina que estaba instalada previamente (por ejemplo, una *MRT_IRQHandler* definida por la aplicación), de
+ * modo que la aplicación puede seguir manejando por su cuenta los canales que no reservó.
+ *
+ * @{
+ */
+
+#ifndef HAL_MRT_H_
+#define HAL_MRT_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Cantidad de canales del *MRT* */
+#define		HAL_MRT_CHANNEL_AMOUNT			4
+
+/** Máximo intervalo cargable en un canal */
+#define		HAL_MRT_MAX_INTERVAL			0x7FFFFFFF
+
+/** Resultados de las funciones del *MRT* */
+typedef enum
+{
+	HAL_MRT_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_MRT_RESULT_CHANNEL_BUSY, /**< El canal está reservado por otro módulo */
+	HAL_MRT_RESULT_INVALID /**< Parámetros inválidos */
+}hal_mrt_result_en;
+
+/** Modos de funcionamiento de un canal */
+typedef enum
+{
+	HAL_MRT_MODE_REPEAT = 0, /**< Recarga el intervalo al llegar a cero */
+	HAL_MRT_MODE_ONE_SHOT, /**< Se detiene al llegar a cero */
+	HAL_MRT_MODE_ONE_SHOT_BUS_STALL /**< Detiene el bus durante el intervalo (demoras cortas) */
+}hal_mrt_mode_en;
+
+/**
+ * @brief Tipo de dato para el callback de interrupción de un canal
+ * @param[in] channel Canal que pidió la interrupción
+ * @note Estos callbacks se ejecutan en el contexto de una interrupción.
+ */
+typedef void (*hal_mrt_callback_t)(uint8_t channel);
+
+/**
+ * @brief Reservar y configurar un canal del *MRT*
+ *
+ * El canal queda detenido, con su interrupción habilitada. Habilita el clock del periférico si es necesario.
+ *
+ * @param[in] channel Canal a reservar (0 a 3)
+ * @param[in] mode Modo de funcionamiento del canal
+ * @param[in] callback Callback a ejecutar en cada interrupción del canal. No puede ser NULL
+ * @return Resultado de la operación
+ */
+hal_mrt_result_en hal_mrt_channel_claim(uint8_t channel, hal_mrt_mode_en mode, hal_mrt_callback_t callback);
+
+/**
+ * @brief Liberar un canal del *MRT*
+ *
+ * El canal se detiene y se inhabilita su interrupción.
+ *
+ * @param[in] channel Canal a liberar
+ */
+void hal_mrt_channel_release(uint8_t channel);
+
+/**
+ * @brief Comenzar el conteo de un canal, descartando el conteo en curso
+ * @param[in] channel Canal a utilizar (0 a 3)
+ * @param[in] interval Intervalo en ciclos del clock del sistema (hasta @ref HAL_MRT_MAX_INTERVAL)
+ * @return Resultado de la operación. Con parámetros inválidos el canal no se modifica
+ */
+hal_mrt_result_en hal_mrt_channel_start(uint8_t channel, uint32_t interval);
+
+/**
+ * @brief Detener el conteo de un canal
+ * @param[in] channel Canal a detener
+ */
+void hal_mrt_channel_stop(uint8_t channel);
+
+/**
+ * @brief Obtener la cuenta actual de un canal
+ * @param[in] channel Canal a consultar
+ * @return Cuenta actual (descendente), o cero si el canal es inválido
+ */
+uint32_t hal_mrt_channel_get_value(uint8_t channel);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_MRT_H_ */
+
+/**
+ * @}
+ */
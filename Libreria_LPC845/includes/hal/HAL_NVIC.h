@@ -0,0 +1,306 @@
+/**
+ * @file HAL_NVIC.h
+ * @brief Declaraciones a nivel de aplicacion del controlador de interrupciones NVIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup NVIC Controlador de interrupciones (NVIC)
+ *
+ * # Introducción
+ *
+ * El *NVIC* es el controlador de interrupciones del núcleo Cortex-M0+. Cada periférico de la librería habilita sus
+ * interrupciones en el *NVIC* desde sus funciones de inicialización, y sus rutinas de interrupción invocan los
+ * callbacks registrados por el usuario.
+ *
+ * # Tabla de vectores en RAM
+ *
+ * La tabla de vectores definida en el archivo de startup reside en la memoria flash y no puede modificarse en tiempo
+ * de ejecución. Mediante la función @ref hal_nvic_vector_table_relocate la tabla es copiada a RAM y el registro
+ * *VTOR* del núcleo pasa a apuntar a dicha copia. A partir de ese momento, la función @ref hal_nvic_install_handler
+ * permite instalar una rutina de interrupción directamente en la tabla, evitando la indirección de las rutinas de
+ * la librería (rutina de la librería, verificación de flags y callback del usuario).
+ *
+ * @note Una rutina instalada directamente reemplaza a la de la librería, por lo que es responsable de limpiar los
+ * flags de interrupción del periférico. La función @ref hal_nvic_install_handler devuelve la rutina anteriormente
+ * instalada, de modo de poder restaurarla luego.
+ *
+ * @note La tabla en RAM ocupa 256 bytes, por la alineación que requiere el registro *VTOR*.
+ *
+ * # Prioridades
+ *
+ * El núcleo admite 4 niveles de prioridad, siendo @ref HAL_NVIC_PRIORITY_HIGHEST la más urgente. Las funciones de
+ * inicialización de los periféricos habilitan sus interrupciones sin modificar su prioridad, por lo que todas
+ * quedan en la prioridad por defecto (la más urgente) salvo que se indique lo contrario. Para asignar las
+ * prioridades de toda la aplicación en un único lugar, se dispone de la función @ref hal_nvic_priority_map_apply,
+ * la cual recibe una tabla constante de pares fuente/prioridad:
+ *
+ * ~~~{.c}
+ * static const hal_nvic_priority_map_t priority_map[] = {
+ * 	{ HAL_NVIC_IRQ_SEL_CTIMER, HAL_NVIC_PRIORITY_HIGHEST },
+ * 	{ HAL_NVIC_IRQ_SEL_UART0, HAL_NVIC_PRIORITY_HIGH },
+ * 	{ HAL_NVIC_IRQ_SEL_SYSTICK, HAL_NVIC_PRIORITY_LOWEST },
+ * };
+ *
+ * hal_nvic_priority_map_apply(priority_map, sizeof(priority_map) / sizeof(priority_map[0]));
+ * ~~~
+ *
+ * # Secciones críticas
+ *
+ * El Cortex-M0+ no dispone del registro *BASEPRI*, por lo que enmascarar únicamente las interrupciones de menor
+ * prioridad se implementa inhabilitando en el *NVIC* las fuentes cuya prioridad sea igual o menos urgente que la
+ * indicada. La función @ref hal_nvic_critical_enter devuelve el conjunto de fuentes que efectivamente inhabilitó,
+ * y @ref hal_nvic_critical_exit vuelve a habilitar únicamente ese conjunto, por lo que las secciones críticas
+ * pueden anidarse.
+ *
+ * @note Para que las secciones críticas utilicen las prioridades correctas, las prioridades deben modificarse
+ * mediante las funciones de este módulo.
+ *
+ * # Medición de latencia
+ *
+ * Para cada fuente de interrupción puede registrarse la latencia observada mediante @ref hal_nvic_latency_record,
+ * obteniéndose luego mínimo, máximo e histograma mediante @ref hal_nvic_latency_get. La latencia debe calcularse a
+ * partir de una marca de tiempo de hardware del evento, por ejemplo, en un callback de captura del @ref CTIMER:
+ *
+ * ~~~{.c}
+ * hal_nvic_latency_record(HAL_NVIC_IRQ_SEL_CTIMER,
+ * 		hal_ctimer_timer_mode_counter_read() - hal_ctimer_timer_mode_capture_read(HAL_CTIMER_CAPTURE_0));
+ * ~~~
+ *
+ * Adicionalmente, @ref hal_nvic_latency_probe_start utiliza el canal 3 del *MRT* como generador periódico de
+ * interrupciones y registra la latencia de cada una, de modo de medir la latencia que sufre una interrupción de
+ * cierta prioridad bajo la carga real de la aplicación. El histograma tiene @ref HAL_NVIC_LATENCY_HISTOGRAM_BINS
+ * intervalos de ancho creciente en potencias de 2, comenzando por [0, @ref HAL_NVIC_LATENCY_HISTOGRAM_FIRST_BIN).
+ *
+ * @note La función @ref hal_nvic_irq_latency_set permite fijar una latencia mínima determinística, eliminando el
+ * *jitter* de entrada a las interrupciones a costa de aumentar la latencia.
+ *
+ * @{
+ */
+
+#ifndef HAL_NVIC_H_
+#define HAL_NVIC_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Fuentes de interrupción y excepciones del sistema */
+typedef enum
+{
+	HAL_NVIC_IRQ_SEL_HARDFAULT = -13, /**< Excepción HardFault */
+	HAL_NVIC_IRQ_SEL_SVCALL = -5, /**< Excepción SVCall */
+	HAL_NVIC_IRQ_SEL_PENDSV = -2, /**< Excepción PendSV */
+	HAL_NVIC_IRQ_SEL_SYSTICK = -1, /**< Excepción del @ref SYSTICK */
+	HAL_NVIC_IRQ_SEL_SPI0 = 0, /**< Interrupción de SPI0 */
+	HAL_NVIC_IRQ_SEL_SPI1, /**< Interrupción de SPI1 */
+	HAL_NVIC_IRQ_SEL_DAC0, /**< Interrupción de DAC0 */
+	HAL_NVIC_IRQ_SEL_UART0, /**< Interrupción de USART0 */
+	HAL_NVIC_IRQ_SEL_UART1, /**< Interrupción de USART1 */
+	HAL_NVIC_IRQ_SEL_UART2, /**< Interrupción de USART2 */
+	HAL_NVIC_IRQ_SEL_IIC1 = 7, /**< Interrupción de I2C1 */
+	HAL_NVIC_IRQ_SEL_IIC0, /**< Interrupción de I2C0 */
+	HAL_NVIC_IRQ_SEL_SCT, /**< Interrupción de SCT */
+	HAL_NVIC_IRQ_SEL_MRT, /**< Interrupción de MRT */
+	HAL_NVIC_IRQ_SEL_CMP_CAPT, /**< Interrupción del comparador analógico */
+	HAL_NVIC_IRQ_SEL_WDT, /**< Interrupción del watchdog */
+	HAL_NVIC_IRQ_SEL_BOD, /**< Interrupción de brown-out */
+	HAL_NVIC_IRQ_SEL_FLASH, /**< Interrupción de la flash */
+	HAL_NVIC_IRQ_SEL_WKT, /**< Interrupción de WKT */
+	HAL_NVIC_IRQ_SEL_ADC_SEQA, /**< Interrupción de secuencia A del ADC */
+	HAL_NVIC_IRQ_SEL_ADC_SEQB, /**< Interrupción de secuencia B del ADC */
+	HAL_NVIC_IRQ_SEL_ADC_THCMP, /**< Interrupción de comparación de umbrales del ADC */
+	HAL_NVIC_IRQ_SEL_ADC_OVR, /**< Interrupción de overrun del ADC */
+	HAL_NVIC_IRQ_SEL_DMA, /**< Interrupción de DMA */
+	HAL_NVIC_IRQ_SEL_IIC2, /**< Interrupción de I2C2 */
+	HAL_NVIC_IRQ_SEL_IIC3, /**< Interrupción de I2C3 */
+	HAL_NVIC_IRQ_SEL_CTIMER, /**< Interrupción de CTIMER */
+	HAL_NVIC_IRQ_SEL_PININT0, /**< Interrupción de PININT0 */
+	HAL_NVIC_IRQ_SEL_PININT1, /**< Interrupción de PININT1 */
+	HAL_NVIC_IRQ_SEL_PININT2, /**< Interrupción de PININT2 */
+	HAL_NVIC_IRQ_SEL_PININT3, /**< Interrupción de PININT3 */
+	HAL_NVIC_IRQ_SEL_PININT4, /**< Interrupción de PININT4 */
+	HAL_NVIC_IRQ_SEL_PININT5_DAC1, /**< Interrupción de PININT5 y DAC1 */
+	HAL_NVIC_IRQ_SEL_PININT6_UART3, /**< Interrupción de PININT6 y USART3 */
+	HAL_NVIC_IRQ_SEL_PININT7_UART4 /**< Interrupción de PININT7 y USART4 */
+}hal_nvic_irq_sel_en;
+
+/** Cantidad de fuentes de interrupción cuya latencia puede medirse en simultáneo */
+#define		HAL_NVIC_LATENCY_SLOTS				(4)
+
+/** Cantidad de intervalos del histograma de latencias */
+#define		HAL_NVIC_LATENCY_HISTOGRAM_BINS		(8)
+
+/** Límite superior, en ciclos, del primer intervalo del histograma de latencias */
+#define		HAL_NVIC_LATENCY_HISTOGRAM_FIRST_BIN	(16)
+
+/** Niveles de prioridad de interrupciones */
+typedef enum
+{
+	HAL_NVIC_PRIORITY_HIGHEST = 0, /**< Prioridad más urgente */
+	HAL_NVIC_PRIORITY_HIGH, /**< Prioridad alta */
+	HAL_NVIC_PRIORITY_LOW, /**< Prioridad baja */
+	HAL_NVIC_PRIORITY_LOWEST /**< Prioridad menos urgente */
+}hal_nvic_priority_en;
+
+/** Entrada de una tabla de prioridades */
+typedef struct
+{
+	hal_nvic_irq_sel_en irq; /**< Fuente de interrupción */
+	hal_nvic_priority_en priority; /**< Prioridad a asignar */
+}hal_nvic_priority_map_t;
+
+/** Estado guardado por una sección crítica */
+typedef struct
+{
+	uint32_t irq_mask; /**< Fuentes de interrupción inhabilitadas por la sección crítica */
+	uint8_t systick; /**< Flag de interrupción del @ref SYSTICK inhabilitada por la sección crítica */
+}hal_nvic_critical_t;
+
+/** Resultados posibles de las funciones de medición de latencia */
+typedef enum
+{
+	HAL_NVIC_LATENCY_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_NVIC_LATENCY_RESULT_NO_SLOT, /**< No quedan lugares para nuevas fuentes de interrupción */
+	HAL_NVIC_LATENCY_RESULT_NO_SAMPLES, /**< No hay mediciones para la fuente de interrupción */
+	HAL_NVIC_LATENCY_RESULT_BUSY, /**< El canal 3 del *MRT* está reservado por otro módulo */
+	HAL_NVIC_LATENCY_RESULT_INVALID_INTERVAL /**< Período nulo o mayor a @ref HAL_MRT_MAX_INTERVAL */
+}hal_nvic_latency_result_en;
+
+/** Estadísticas de latencia de una fuente de interrupción, en ciclos de clock */
+typedef struct
+{
+	uint32_t samples; /**< Cantidad de mediciones */
+	uint16_t min; /**< Latencia mínima */
+	uint16_t max; /**< Latencia máxima */
+	uint32_t histogram[HAL_NVIC_LATENCY_HISTOGRAM_BINS]; /**< Cantidad de mediciones en cada intervalo */
+}hal_nvic_latency_stats_t;
+
+/** Tipo de dato para rutinas de interrupción */
+typedef void (*hal_nvic_handler_t)(void);
+
+/**
+ * @brief Copiar la tabla de vectores a RAM y reubicarla mediante el registro *VTOR*
+ *
+ * Si la tabla ya fue reubicada, la función no tiene efecto.
+ */
+void hal_nvic_vector_table_relocate(void);
+
+/**
+ * @brief Instalar una rutina de interrupción directamente en la tabla de vectores
+ *
+ * Si la tabla de vectores todavía no fue reubicada a RAM, se reubica en este momento.
+ *
+ * @param[in] irq Fuente de interrupción o excepción
+ * @param[in] handler Rutina de interrupción a instalar
+ * @return Rutina de interrupción anteriormente instalada
+ */
+hal_nvic_handler_t hal_nvic_install_handler(hal_nvic_irq_sel_en irq, hal_nvic_handler_t handler);
+
+/**
+ * @brief Fijar la prioridad de una fuente de interrupción o excepción
+ * @param[in] irq Fuente de interrupción o excepción (no admite @ref HAL_NVIC_IRQ_SEL_HARDFAULT)
+ * @param[in] priority Prioridad deseada
+ */
+void hal_nvic_set_priority(hal_nvic_irq_sel_en irq, hal_nvic_priority_en priority);
+
+/**
+ * @brief Obtener la prioridad de una fuente de interrupción o excepción
+ * @param[in] irq Fuente de interrupción o excepción
+ * @return Prioridad actual. @ref HAL_NVIC_IRQ_SEL_HARDFAULT, de prioridad fija más urgente que cualquier otra, se
+ * informa como @ref HAL_NVIC_PRIORITY_HIGHEST
+ */
+hal_nvic_priority_en hal_nvic_get_priority(hal_nvic_irq_sel_en irq);
+
+/**
+ * @brief Aplicar una tabla de prioridades
+ * @param[in] map Tabla de pares fuente/prioridad
+ * @param[in] entries Cantidad de entradas de la tabla
+ */
+void hal_nvic_priority_map_apply(const hal_nvic_priority_map_t *map, uint8_t entries);
+
+/**
+ * @brief Comenzar una sección crítica
+ *
+ * Se inhabilitan las fuentes de interrupción habilitadas cuya prioridad sea igual o menos urgente que la indicada,
+ * incluyendo la del @ref SYSTICK. Las de prioridad más urgente continúan atendiéndose.
+ *
+ * @param[in] priority Prioridad más urgente a enmascarar
+ * @return Estado a pasar a @ref hal_nvic_critical_exit
+ */
+hal_nvic_critical_t hal_nvic_critical_enter(hal_nvic_priority_en priority);
+
+/**
+ * @brief Terminar una sección crítica
+ * @param[in] state Estado devuelto por @ref hal_nvic_critical_enter
+ */
+void hal_nvic_critical_exit(hal_nvic_critical_t state);
+
+/**
+ * @brief Fijar la latencia mínima de interrupciones del MCU
+ * @param[in] cycles Cantidad mínima de ciclos entre el pedido de interrupción y la entrada a la rutina
+ */
+void hal_nvic_irq_latency_set(uint8_t cycles);
+
+/**
+ * @brief Obtener la latencia mínima de interrupciones del MCU
+ * @return Cantidad mínima de ciclos entre el pedido de interrupción y la entrada a la rutina
+ */
+uint8_t hal_nvic_irq_latency_get(void);
+
+/**
+ * @brief Registrar una medición de latencia de una fuente de interrupción
+ *
+ * Pensada para ser llamada al comienzo de la rutina o callback de la interrupción medida.
+ *
+ * @param[in] irq Fuente de interrupción medida
+ * @param[in] cycles Latencia medida en ciclos de clock
+ * @return Resultado de la operación
+ */
+hal_nvic_latency_result_en hal_nvic_latency_record(hal_nvic_irq_sel_en irq, uint32_t cycles);
+
+/**
+ * @brief Obtener las estadísticas de latencia de una fuente de interrupción
+ * @param[in] irq Fuente de interrupción
+ * @param[out] stats Estadísticas de latencia
+ * @param[in] reset Si es distinto de cero, se reinician las estadísticas de la fuente
+ * @return Resultado de la operación
+ */
+hal_nvic_latency_result_en hal_nvic_latency_get(hal_nvic_irq_sel_en irq, hal_nvic_latency_stats_t *stats, uint8_t reset);
+
+/**
+ * @brief Comenzar la medición periódica de latencia mediante el *MRT*
+ *
+ * El canal 3 del *MRT* se reserva mediante @ref hal_mrt_channel_claim y genera una interrupción cada
+ * *interval_cycles* ciclos del clock del sistema, cuya latencia se registra bajo la fuente @ref HAL_NVIC_IRQ_SEL_MRT.
+ * La latencia registrada incluye el despacho de la rutina de interrupción del @ref MRT. Los demás canales del *MRT*
+ * siguen siendo atendidos normalmente, con la prioridad indicada.
+ *
+ * @param[in] interval_cycles Período de las interrupciones generadas, en ciclos del clock del sistema (1 a
+ * @ref HAL_MRT_MAX_INTERVAL)
+ * @param[in] priority Prioridad con la cual medir
+ * @return Resultado de la operación
+ * @see hal_nvic_latency_probe_stop
+ */
+hal_nvic_latency_result_en hal_nvic_latency_probe_start(uint32_t interval_cycles, hal_nvic_priority_en priority);
+
+/**
+ * @brief Detener la medición periódica de latencia
+ *
+ * Se libera el canal 3 del *MRT*.
+ */
+void hal_nvic_latency_probe_stop(void);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_NVIC_H_ */
+
+/**
+ * @}
+ */
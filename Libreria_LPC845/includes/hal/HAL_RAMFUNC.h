@@ -0,0 +1,165 @@
+/**
+ * @file HAL_RAMFUNC.h
+ * @brief Declaraciones a nivel de aplicacion para ubicar funciones en RAM (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup RAMFUNC Ejecución desde RAM
+ *
+ * # Introducción
+ *
+ * Con el clock del sistema a 30MHz, la memoria flash del LPC845 requiere estados de espera, por lo que el código
+ * ejecutado desde flash demora más ciclos que el mismo código ejecutado desde la SRAM. Para las rutinas de
+ * interrupción de uso intensivo, esta diferencia se traduce directamente en latencia y en tiempo de CPU.
+ *
+ * # Funcionamiento
+ *
+ * Si el proyecto se compila con el símbolo *HAL_RAMFUNC_ENABLE* definido, las rutinas de interrupción de la
+ * librería marcadas con @ref HAL_RAMFUNC (y las funciones internas que éstas llaman) se ubican en la sección
+ * @ref HAL_RAMFUNC_SECTION. Si el símbolo no está definido, la macro no tiene efecto y todo el código permanece en
+ * flash.
+ *
+ * Las funciones afectadas son:
+ * 	- *SysTick_Handler*
+ * 	- *UART0_IRQHandler*, *UART1_IRQHandler*, *UART2_IRQHandler* y las rutinas de la USART3 y USART4
+ * 	- *SPI0_IRQHandler* y *SPI1_IRQHandler*
+ * 	- *I2C0_IRQHandler*, *I2C1_IRQHandler*, *I2C2_IRQHandler* y *I2C3_IRQHandler*
+ * 	- *CTIMER0_IRQHandler*
+ * 	- *ADC_SEQA_IRQHandler* y *ADC_SEQB_IRQHandler*
+ * 	- *hal_mrt_irq*, la rutina de interrupción del @ref MRT que la librería instala en la tabla de vectores
+ * 	- *SCT_IRQHandler*
+ * 	- @ref hal_div_reciprocal_apply y @ref hal_div_reciprocal_divmod
+ * 	- El llamado a las rutinas de la ROM de @ref IAP, con las interrupciones enmascaradas
+ *
+ * Los callbacks del usuario pueden ubicarse también en RAM marcándolos con la misma macro:
+ *
+ * ~~~{.c}
+ * HAL_RAMFUNC static void uart_rx_callback(hal_usart_sel_en inst, void *data)
+ * {
+ * 	...
+ * }
+ * ~~~
+ *
+ * # Soporte del linker
+ *
+ * El nombre de sección por defecto es el que utiliza el *managed linker script* de MCUXpresso (equivalente a la
+ * macro *__RAMFUNC(RAM)* de *cr_section_macros.h*): el linker ubica estas secciones en la primera región de RAM junto
+ * con la sección *.data*, y el código de inicio las copia desde flash junto con los datos inicializados, por lo que
+ * no es necesaria ninguna configuración adicional. Con otro linker script, puede definirse
+ * @ref HAL_RAMFUNC_SECTION con el nombre de una sección que el script copie a RAM al inicio.
+ *
+ * Los llamados entre funciones en flash y funciones en RAM superan el alcance de la instrucción *BL*, por lo que el
+ * linker agrega automáticamente *veneers* para dichos llamados. Las funciones del HPL son *static inline*, por lo que
+ * se compilan dentro de la rutina que las llama siempre que la optimización esté habilitada.
+ *
+ * # Costo en RAM
+ *
+ * Cada función ubicada en RAM ocupa su tamaño tanto en flash (imagen a copiar) como en RAM. El costo resultante se
+ * reporta al final de la compilación como el aumento de la columna *data* de *arm-none-eabi-size*, y en detalle en
+ * el archivo *.map* del proyecto, buscando las secciones que comienzan con *.ramfunc*. Comparando ambos reportes
+ * compilando con y sin *HAL_RAMFUNC_ENABLE* se obtiene el costo exacto para la configuración de optimización en
+ * uso.
+ *
+ * Para obtener este costo desde la propia aplicación, el linker script puede definir los símbolos
+ * *__hal_ramfunc_start* y *__hal_ramfunc_end* alrededor de las secciones *.ramfunc*, y la función
+ * @ref hal_ramfunc_footprint informa la cantidad de bytes entre ambos. Por ejemplo, en el template *data.ldt* de MCUXpresso:
+ *
+ * ~~~
+ * __hal_ramfunc_start = .;
+ * *(.ramfunc*)
+ * __hal_ramfunc_end = .;
+ * ~~~
+ *
+ * Si el linker script no los define, la función devuelve cero.
+ *
+ * # Medición
+ *
+ * La función @ref hal_ramfunc_benchmark ejecuta @ref HAL_RAMFUNC_BENCHMARK_ITERATIONS veces una misma rutina
+ * representativa de una interrupción (lectura de un registro, guardado en un buffer circular y actualización de
+ * contadores), una vez ubicada en flash y otra en RAM, y mide ambos tiempos mediante un contador por hardware
+ * provisto por la aplicación. Cada iteración es un llamado a la rutina, por lo que el tiempo en RAM incluye el
+ * *veneer* de un llamado desde flash. Informa además el resultado de @ref hal_ramfunc_footprint:
+ *
+ * ~~~{.c}
+ * static uint32_t ctimer_counter_read(void)
+ * {
+ * 	return CTIMER->TC;
+ * }
+ *
+ * hal_ramfunc_benchmark_t result;
+ *
+ * hal_ramfunc_benchmark(ctimer_counter_read, &result);
+ * ~~~
+ *
+ * La copia en RAM de la rutina de medición se ubica siempre en @ref HAL_RAMFUNC_SECTION, esté o no definido
+ * *HAL_RAMFUNC_ENABLE*, y sólo ocupa RAM si la aplicación llama a @ref hal_ramfunc_benchmark (el linker descarta las
+ * secciones no referenciadas). La ganancia sobre las rutinas propias de la librería puede medirse también con las
+ * funciones de medición de latencia del @ref NVIC, compilando con y sin *HAL_RAMFUNC_ENABLE*.
+ *
+ * @{
+ */
+
+#ifndef HAL_RAMFUNC_H_
+#define HAL_RAMFUNC_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Cantidad de llamados a la rutina de cada medición de @ref hal_ramfunc_benchmark */
+#define		HAL_RAMFUNC_BENCHMARK_ITERATIONS	256
+
+#ifndef HAL_RAMFUNC_SECTION
+/** Sección en la cual ubicar las funciones en RAM */
+#define		HAL_RAMFUNC_SECTION			".ramfunc.$RAM"
+#endif
+
+#if defined (HAL_RAMFUNC_ENABLE)
+/** Atributo para ubicar una función en RAM */
+#define		HAL_RAMFUNC					__attribute__ ((section(HAL_RAMFUNC_SECTION)))
+#else
+/** Atributo para ubicar una función en RAM */
+#define		HAL_RAMFUNC
+#endif
+
+/**
+ * @brief Callback de lectura de un contador por hardware
+ * @return Valor actual del contador (ascendente)
+ */
+typedef uint32_t (*hal_ramfunc_timestamp_callback)(void);
+
+/** Resultados de la medición, en unidades del contador provisto */
+typedef struct
+{
+	uint32_t flash; /**< Rutina ejecutada desde flash */
+	uint32_t ram; /**< Rutina ejecutada desde RAM */
+	uint32_t footprint; /**< Bytes de las secciones *.ramfunc* (ver @ref hal_ramfunc_footprint) */
+}hal_ramfunc_benchmark_t;
+
+/**
+ * @brief Obtener el tamaño de las funciones ubicadas en RAM
+ * @return Bytes entre *__hal_ramfunc_start* y *__hal_ramfunc_end*, o cero si el linker script no los define
+ */
+uint32_t hal_ramfunc_footprint(void);
+
+/**
+ * @brief Medir la misma rutina ejecutada desde flash y desde RAM
+ * @param[in] timestamp Lectura de un contador por hardware
+ * @param[out] result Tiempos medidos y tamaño de las funciones en RAM
+ */
+void hal_ramfunc_benchmark(hal_ramfunc_timestamp_callback timestamp, hal_ramfunc_benchmark_t *result);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_RAMFUNC_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,303 @@
+/**
+ * @file HAL_SCT.h
+ * @brief Declaraciones a nivel de aplicacion del periferico SCT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup SCT State Configurable Timer (SCT)
+ *
+ * # Introducción
+ *
+ * El *SCT* es un contador combinado con un motor de eventos y estados: cada uno de sus 8 eventos se produce ante un
+ * valor de match del contador, una condición sobre una entrada o salida, o una combinación de ambos, y solo en los
+ * estados en los que está habilitado. Cada evento puede activar o desactivar cualquiera de las 7 salidas, pasar a
+ * otro estado, reiniciar o detener el contador y generar una interrupción, todo por hardware y sin intervención de
+ * la CPU.
+ *
+ * En esta librería el contador se utiliza siempre como un único contador de 32 bits, excitado por el clock del
+ * *SCT* (ver @ref SYSCON) dividido por un prescaler. El periférico puede utilizarse en modo PWM o como máquina de
+ * estados, pero no en ambos modos a la vez.
+ *
+ * # Modo PWM
+ *
+ * A diferencia del @ref CTIMER, que provee 3 canales de PWM, el *SCT* permite hasta 7 salidas de PWM independientes
+ * de igual frecuencia. El modo se inicializa mediante @ref hal_sct_pwm_init, y cada salida mediante
+ * @ref hal_sct_pwm_channel_config. El *duty* se expresa en décimas de porciento, al igual que en el @ref CTIMER, y se
+ * modifica mediante @ref hal_sct_pwm_duty_set: el nuevo valor se aplica al comenzar el período siguiente, por lo que
+ * nunca se generan pulsos truncados.
+ *
+ * Se puede elegir entre PWM alineado al flanco (todas las salidas se activan al comienzo del período) y PWM
+ * centrado, en el cual el contador cuenta hacia arriba y luego hacia abajo, y cada pulso queda centrado en el
+ * período. El PWM centrado genera menos armónicos en puentes de motores, ya que las conmutaciones de las distintas
+ * salidas no coinciden.
+ *
+ * ## Pares complementarios
+ *
+ * En modo centrado, @ref hal_sct_pwm_pair_config configura dos salidas como un par complementario para manejar una
+ * rama de un puente: la salida alta está activa en el centro del período, y la salida baja en los extremos, con un
+ * *tiempo muerto* en cada conmutación durante el cual ambas están inactivas, evitando el cortocircuito de la rama.
+ *
+ * # Máquina de estados
+ *
+ * @ref hal_sct_machine_init configura el periférico a partir de una tabla declarativa de eventos del tipo
+ * @ref hal_sct_event_t. Los registros de match se asignan automáticamente, compartiendo un mismo registro entre
+ * los eventos con igual valor de match. Esto permite delegar al hardware secuencias que habitualmente se resuelven
+ * en interrupciones, como la conmutación de un motor según sus sensores de efecto Hall o los patrones de un motor paso
+ * a paso. Por ejemplo, la secuencia de paso completo de un motor paso a paso en las salidas 0 a 3, avanzando un paso
+ * cada *STEP_TICKS* cuentas:
+ *
+ * ~~~{.c}
+ * static const hal_sct_event_t steps[] =
+ * {
+ * 	{ .states = 1 << 0, .match_value = STEP_TICKS, .next_state = 1, .set_outputs = 0x03, .clear_outputs = 0x0C, .limit = 1 },
+ * 	{ .states = 1 << 1, .match_value = STEP_TICKS, .next_state = 2, .set_outputs = 0x06, .clear_outputs = 0x09, .limit = 1 },
+ * 	{ .states = 1 << 2, .match_value = STEP_TICKS, .next_state = 3, .set_outputs = 0x0C, .clear_outputs = 0x03, .limit = 1 },
+ * 	{ .states = 1 << 3, .match_value = STEP_TICKS, .next_state = 0, .set_outputs = 0x09, .clear_outputs = 0x06, .limit = 1 }
+ * };
+ * ~~~
+ *
+ * Los cuatro eventos comparten un único registro de match, cuyo valor puede modificarse en funcionamiento mediante
+ * @ref hal_sct_machine_match_set para variar la velocidad.
+ *
+ * @note Los valores de match se comparan contra el contador, que comienza en cero al iniciar y luego de cada evento
+ * que lo reinicia (campo *limit*). Las entradas del *SCT* se asignan a pines mediante @ref hal_sct_input_pin_assign y
+ * las salidas mediante @ref hal_sct_output_pin_assign.
+ *
+ * @{
+ */
+
+#ifndef HAL_SCT_H_
+#define HAL_SCT_H_
+
+#include <stdint.h>
+#include "HAL_GPIO.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Cantidad de salidas */
+#define		HAL_SCT_OUTPUT_AMOUNT				7
+
+/** Cantidad de entradas */
+#define		HAL_SCT_INPUT_AMOUNT				4
+
+/** Cantidad de eventos */
+#define		HAL_SCT_EVENT_AMOUNT				8
+
+/** Cantidad de estados */
+#define		HAL_SCT_STATE_AMOUNT				8
+
+/** Valor de estado siguiente para permanecer en el estado actual */
+#define		HAL_SCT_STATE_KEEP					0xFF
+
+/** Resultados de las funciones del SCT */
+typedef enum
+{
+	HAL_SCT_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_SCT_RESULT_RESOURCE_ERROR, /**< No quedan eventos o registros de match disponibles */
+	HAL_SCT_RESULT_PARAM_ERROR /**< Parámetro fuera de rango */
+}hal_sct_result_en;
+
+/** Fuente de clock del SCT */
+typedef enum
+{
+	HAL_SCT_CLOCK_SOURCE_FRO = 0, /**< Free running oscillator */
+	HAL_SCT_CLOCK_SOURCE_SYS_PLL = 2 /**< Phase locked loop */
+}hal_sct_clock_source_en;
+
+/** Alineación del PWM */
+typedef enum
+{
+	HAL_SCT_PWM_ALIGN_EDGE = 0, /**< Alineado al flanco: las salidas se activan al comienzo del período */
+	HAL_SCT_PWM_ALIGN_CENTER /**< Centrado: cada pulso queda centrado en el período */
+}hal_sct_pwm_align_en;
+
+/** Configuración del modo PWM */
+typedef struct
+{
+	hal_sct_clock_source_en clock_source; /**< Fuente de clock */
+	uint32_t frequency; /**< Frecuencia del PWM en Hz */
+	hal_sct_pwm_align_en align; /**< Alineación */
+}hal_sct_pwm_config_t;
+
+/** Configuración de un canal de PWM */
+typedef struct
+{
+	uint8_t output; /**< Salida del SCT (0 a 6) */
+	hal_gpio_portpin_en portpin; /**< Puerto/pin de la salida */
+	uint8_t active_low; /**< Distinto de cero si la salida está activa en estado bajo */
+	uint32_t duty; /**< Duty inicial en décimas de porciento (1 equivale a 0.1%) */
+}hal_sct_pwm_channel_config_t;
+
+/** Configuración de un par complementario de PWM */
+typedef struct
+{
+	uint8_t output_high; /**< Salida del lado alto, activa en el centro del período (0 a 6) */
+	hal_gpio_portpin_en portpin_high; /**< Puerto/pin del lado alto */
+	uint8_t output_low; /**< Salida del lado bajo, activa en los extremos del período (0 a 6) */
+	hal_gpio_portpin_en portpin_low; /**< Puerto/pin del lado bajo */
+	uint32_t dead_time_ns; /**< Tiempo muerto en nanosegundos, redondeado hacia arriba a cuentas del contador */
+	uint32_t duty; /**< Duty inicial del lado alto en décimas de porciento */
+}hal_sct_pwm_pair_config_t;
+
+/** Condición de un evento */
+typedef enum
+{
+	HAL_SCT_EVENT_CONDITION_MATCH = 0, /**< Valor de match del contador */
+	HAL_SCT_EVENT_CONDITION_INPUT, /**< Condición sobre una entrada */
+	HAL_SCT_EVENT_CONDITION_MATCH_OR_INPUT, /**< Cualquiera de ambas */
+	HAL_SCT_EVENT_CONDITION_MATCH_AND_INPUT /**< Ambas simultáneamente */
+}hal_sct_event_condition_en;
+
+/** Condición sobre una entrada */
+typedef enum
+{
+	HAL_SCT_INPUT_CONDITION_LOW = 0, /**< Entrada en estado bajo */
+	HAL_SCT_INPUT_CONDITION_RISE, /**< Flanco ascendente */
+	HAL_SCT_INPUT_CONDITION_FALL, /**< Flanco descendente */
+	HAL_SCT_INPUT_CONDITION_HIGH /**< Entrada en estado alto */
+}hal_sct_input_condition_en;
+
+/** Evento de la máquina de estados */
+typedef struct
+{
+	uint8_t states; /**< Estados en los cuales el evento está habilitado (bit n = estado n) */
+	hal_sct_event_condition_en condition; /**< Condición del evento */
+	uint32_t match_value; /**< Valor del contador para las condiciones con match */
+	uint8_t input; /**< Entrada (0 a 3) para las condiciones con entrada */
+	hal_sct_input_condition_en input_condition; /**< Condición sobre la entrada */
+	uint8_t next_state; /**< Estado siguiente, o @ref HAL_SCT_STATE_KEEP */
+	uint8_t set_outputs; /**< Salidas que se activan (bit n = salida n) */
+	uint8_t clear_outputs; /**< Salidas que se desactivan (bit n = salida n) */
+	uint8_t limit; /**< Distinto de cero para reiniciar el contador */
+	uint8_t halt; /**< Distinto de cero para detener el contador */
+	uint8_t interrupt; /**< Distinto de cero para llamar al callback */
+}hal_sct_event_t;
+
+/**
+ * @brief Callback de eventos de la máquina de estados
+ *
+ * Se llama desde la interrupción del SCT.
+ *
+ * @param[in] event Índice del evento en la tabla de eventos
+ */
+typedef void (*hal_sct_callback_t)(uint8_t event);
+
+/** Configuración de la máquina de estados */
+typedef struct
+{
+	hal_sct_clock_source_en clock_source; /**< Fuente de clock */
+	uint16_t prescaler; /**< División del clock del contador (1 a 256) */
+	uint8_t initial_state; /**< Estado inicial */
+	uint8_t initial_outputs; /**< Estado inicial de las salidas (bit n = salida n) */
+	const hal_sct_event_t *events; /**< Tabla de eventos */
+	uint8_t event_amount; /**< Cantidad de eventos (hasta @ref HAL_SCT_EVENT_AMOUNT) */
+	hal_sct_callback_t callback; /**< Callback de eventos. Puede ser NULL */
+}hal_sct_machine_config_t;
+
+/**
+ * @brief Asignar una salida del SCT a un pin
+ * @param[in] output Salida (0 a 6)
+ * @param[in] portpin Puerto/pin a asignar
+ */
+void hal_sct_output_pin_assign(uint8_t output, hal_gpio_portpin_en portpin);
+
+/**
+ * @brief Asignar una entrada del SCT a un pin
+ * @param[in] input Entrada (0 a 3)
+ * @param[in] portpin Puerto/pin a asignar
+ */
+void hal_sct_input_pin_assign(uint8_t input, hal_gpio_portpin_en portpin);
+
+/**
+ * @brief Inicializar el modo PWM
+ *
+ * El contador queda detenido hasta llamar a @ref hal_sct_start.
+ *
+ * @param[in] config Configuración deseada
+ * @return Resultado de la operación
+ */
+hal_sct_result_en hal_sct_pwm_init(const hal_sct_pwm_config_t *config);
+
+/**
+ * @brief Configurar un canal de PWM
+ * @param[in] config Configuración del canal
+ * @return Resultado de la operación
+ * @pre Haber inicializado el modo PWM mediante @ref hal_sct_pwm_init
+ */
+hal_sct_result_en hal_sct_pwm_channel_config(const hal_sct_pwm_channel_config_t *config);
+
+/**
+ * @brief Configurar un par complementario de PWM con tiempo muerto
+ * @param[in] config Configuración del par
+ * @return Resultado de la operación
+ * @pre Haber inicializado el modo PWM centrado mediante @ref hal_sct_pwm_init
+ */
+hal_sct_result_en hal_sct_pwm_pair_config(const hal_sct_pwm_pair_config_t *config);
+
+/**
+ * @brief Modificar el duty de un canal o par de PWM
+ *
+ * El nuevo valor se aplica al comenzar el período siguiente.
+ *
+ * @param[in] output Salida del canal, o salida del lado alto del par
+ * @param[in] duty Duty en décimas de porciento (1 equivale a 0.1%)
+ */
+void hal_sct_pwm_duty_set(uint8_t output, uint32_t duty);
+
+/**
+ * @brief Inicializar el modo máquina de estados
+ *
+ * El contador queda detenido hasta llamar a @ref hal_sct_start.
+ *
+ * @param[in] config Configuración deseada
+ * @return Resultado de la operación
+ */
+hal_sct_result_en hal_sct_machine_init(const hal_sct_machine_config_t *config);
+
+/**
+ * @brief Modificar el valor de match de un evento de la máquina de estados
+ *
+ * El nuevo valor se aplica la próxima vez que se reinicie el contador, y afecta a todos los eventos que comparten el
+ * registro de match con el evento indicado.
+ *
+ * @param[in] event Índice del evento en la tabla de eventos
+ * @param[in] value Nuevo valor de match
+ */
+void hal_sct_machine_match_set(uint8_t event, uint32_t value);
+
+/**
+ * @brief Obtener el estado actual de la máquina de estados
+ * @return Estado actual
+ */
+uint8_t hal_sct_state_get(void);
+
+/**
+ * @brief Obtener la frecuencia del contador
+ * @return Frecuencia del contador en Hz
+ */
+uint32_t hal_sct_counter_freq_get(void);
+
+/**
+ * @brief Poner en marcha el contador
+ */
+void hal_sct_start(void);
+
+/**
+ * @brief Detener el contador
+ */
+void hal_sct_stop(void);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_SCT_H_ */
+
+/**
+ * @}
+ */
@@ -105,6 +105,52 @@ typedef struct
 	uint32_t : 4;
 }hal_spi_master_mode_tx_data_t;
 
+/**
+ * @brief Callback de activación de un slave select en modo slave
+ *
+ * Recibe la instancia y el slave select activado.
+ */
+typedef void (*hal_spi_slave_mode_select_callback)(hal_spi_sel_en, hal_spi_ssel_sel_en);
+
+/**
+ * @brief Callback de fin de transacción en modo slave
+ *
+ * Recibe la instancia, el slave select de la transacción, el buffer de recepción y la cantidad de datos recibidos.
+ * El buffer de recepción vuelve a utilizarse en la transacción siguiente al retornar el callback.
+ */
+typedef void (*hal_spi_slave_mode_transfer_callback)(hal_spi_sel_en, hal_spi_ssel_sel_en, const uint8_t *, uint32_t);
+
+/** Resultado de la inicialización en modo slave */
+typedef enum
+{
+	HAL_SPI_SLAVE_MODE_INIT_RESULT_OK = 0, /**< Inicialización exitosa */
+	HAL_SPI_SLAVE_MODE_INIT_RESULT_INVALID_DATA_LENGTH /**< Largo de palabra mayor a 8 bits */
+}hal_spi_slave_mode_init_result_en;
+
+/** Resultado de la carga de una respuesta en modo slave */
+typedef enum
+{
+	HAL_SPI_SLAVE_MODE_TX_RESULT_OK = 0, /**< Respuesta cargada */
+	HAL_SPI_SLAVE_MODE_TX_RESULT_BUSY /**< Ya había una respuesta en espera */
+}hal_spi_slave_mode_tx_result_en;
+
+/** Configuración del modo slave */
+typedef struct
+{
+	hal_syscon_peripheral_clock_sel_en clock_source; /**< Fuente de clock del periférico */
+	hal_spi_clock_mode_en clock_mode; /**< Modo de clock */
+	hal_spi_data_length_en data_length; /**< Largo de palabra, hasta 8 bits */
+	hal_gpio_portpin_en sck_portpin; /**< Puerto/pin de SCK */
+	hal_gpio_portpin_en miso_portpin; /**< Puerto/pin de MISO */
+	hal_gpio_portpin_en mosi_portpin; /**< Puerto/pin de MOSI */
+	hal_gpio_portpin_en ssel_portpin[4]; /**< Puertos/pines de los slave select */
+	hal_spi_ssel_polarity_en ssel_polarity[4]; /**< Polaridad de los slave select */
+	uint8_t *rx_buffer; /**< Buffer de recepción de cada transacción */
+	uint32_t rx_size; /**< Tamaño del buffer de recepción. Los datos que lo excedan se descartan */
+	hal_spi_slave_mode_select_callback select_callback; /**< Callback de activación de slave select. Puede ser NULL */
+	hal_spi_slave_mode_transfer_callback transfer_callback; /**< Callback de fin de transacción. Puede ser NULL */
+}hal_spi_slave_mode_config_t;
+
 /**
  * @brief Inicializar SPI en modo master
  * @param[in] inst Instancia de SPI a inicializar
@@ -147,6 +193,94 @@ void hal_spi_master_mode_tx_register_callback(hal_spi_sel_en inst, void (*new_ca
  */
 void hal_spi_master_mode_rx_register_callback(hal_spi_sel_en inst, void (*new_callback)(void));
 
+/**
+ * @brief Transferir un bloque de datos de 8 bits por encuesta
+ *
+ * La función no retorna hasta completar la transferencia. Si *end_of_transfer* es cero, el slave select permanece
+ * activo al finalizar, de modo que la transferencia puede continuarse con otro llamado (por ejemplo, fase de comando
+ * y fase de datos). Si no se pasa buffer de recepción, las palabras se transmiten con *RXIGNORE*, sin esperar ni
+ * leer los datos recibidos.
+ *
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] tx Datos a transmitir. Si es NULL se transmite @ref HAL_SPI_DUMMY_BYTE
+ * @param[out] rx Buffer donde guardar los datos recibidos. Puede ser NULL
+ * @param[in] length Cantidad de datos a transferir
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ * @pre Haber inicializado la instancia en modo master, sin callback de recepción registrado
+ */
+void hal_spi_master_mode_transfer(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint8_t *tx, uint8_t *rx, uint32_t length, uint8_t end_of_transfer);
+
+/**
+ * @brief Desactivar el slave select de una transferencia que quedó abierta
+ * @param[in] inst Instancia a utilizar
+ */
+void hal_spi_master_mode_end_transfer(hal_spi_sel_en inst);
+
+/**
+ * @brief Transmitir un bloque de datos de 16 bits por encuesta
+ *
+ * Las palabras se transmiten con *RXIGNORE*. Sólo la primera palabra se escribe junto con el control, las demás se
+ * escriben directamente en el registro de datos, lo cual permite mantener el bus ocupado a clocks altos.
+ *
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] data Datos a transmitir
+ * @param[in] length Cantidad de datos a transmitir
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ * @pre Haber inicializado la instancia en modo master
+ */
+void hal_spi_master_mode_write_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint16_t *data, uint32_t length, uint8_t end_of_transfer);
+
+/**
+ * @brief Transmitir un mismo dato de 16 bits repetidas veces por encuesta
+ *
+ * Igual que @ref hal_spi_master_mode_write_16, pero sin leer los datos de memoria.
+ *
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] value Dato a transmitir
+ * @param[in] count Cantidad de veces a transmitir el dato
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ * @pre Haber inicializado la instancia en modo master
+ */
+void hal_spi_master_mode_fill_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, uint16_t value, uint32_t count, uint8_t end_of_transfer);
+
+/**
+ * @brief Inicializar SPI en modo slave
+ *
+ * En modo slave el dato a transmitir debe estar cargado antes del primer flanco de SCK. Las respuestas se cargan
+ * por adelantado mediante @ref hal_spi_slave_mode_tx_queue: la primera palabra de cada respuesta se escribe en el
+ * periférico al terminar la transacción anterior (o al cargarla, si no había ninguna), y las siguientes desde la
+ * interrupción de TXRDY, que se atiende mientras se transmite la palabra anterior. Si la respuesta se agota, o no
+ * hay ninguna cargada, se transmite @ref HAL_SPI_DUMMY_BYTE.
+ *
+ * Los datos recibidos se acumulan en el buffer de recepción y se entregan al callback de fin de transacción al
+ * desactivarse el slave select.
+ *
+ * El slave select de la transacción se obtiene del estado que el periférico guarda junto con cada dato recibido.
+ * Con un único slave select configurado el callback de activación se llama al activarse, y con varios, al recibir
+ * la primera palabra de la transacción.
+ *
+ * @param[in] inst Instancia de SPI a inicializar
+ * @param[in] config Configuracion deseada
+ * @return Resultado de la inicialización
+ */
+hal_spi_slave_mode_init_result_en hal_spi_slave_mode_init(hal_spi_sel_en inst, const hal_spi_slave_mode_config_t *config);
+
+/**
+ * @brief Cargar la respuesta de una transacción en modo slave
+ *
+ * Se mantienen dos respuestas: la de la próxima transacción y una en espera, que pasa a ser la próxima al terminar
+ * la transacción en curso. Los datos no se copian, por lo que el buffer no debe modificarse hasta que se utilice.
+ *
+ * @param[in] inst Instancia a utilizar
+ * @param[in] data Datos a transmitir
+ * @param[in] length Cantidad de datos a transmitir
+ * @return Resultado de la carga
+ */
+hal_spi_slave_mode_tx_result_en hal_spi_slave_mode_tx_queue(hal_spi_sel_en inst, const uint8_t *data, uint32_t length);
+
 #if defined (__cplusplus)
 } // extern "C"
 #endif
@@ -0,0 +1,204 @@
+/**
+ * @file HAL_SPI_LCD.h
+ * @brief Declaraciones a nivel de aplicacion del controlador de displays SPI (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup SPI_LCD Displays SPI
+ *
+ * # Introducción
+ *
+ * Controlador para displays color con interfaz SPI de 4 hilos y juego de comandos MIPI DCS (ST7735, ILI9341, ST7789 y
+ * similares), en formato RGB565, conectados a una instancia de @ref SPI en modo master y a un pin de datos/comando
+ * (*D/C*).
+ *
+ * Un framebuffer completo de un display de 320x240 ocupa 150KB, y aún uno de 160x128 ocupa 40KB, bastante más que la
+ * SRAM del LPC845. Por eso este controlador no mantiene una copia de la imagen: la aplicación indica qué zonas
+ * cambiaron y dibuja los píxeles a pedido, de a un segmento de línea por vez, en un buffer chico.
+ *
+ * # Zonas modificadas
+ *
+ * La pantalla se divide en baldosas de @ref HAL_SPI_LCD_TILE_SIZE x @ref HAL_SPI_LCD_TILE_SIZE píxeles, y se mantiene
+ * un bit por baldosa indicando si debe redibujarse. La función @ref hal_spi_lcd_invalidate marca las baldosas que
+ * intersecan un rectángulo, y la función @ref hal_spi_lcd_flush redibuja únicamente las baldosas marcadas:
+ * 	- Las baldosas marcadas contiguas de una fila se agrupan en un rectángulo, y las filas siguientes con el mismo
+ * 	grupo marcado se agregan al mismo rectángulo, de modo que cada rectángulo requiere una única ventana.
+ * 	- La ventana (*CASET* y *RASET*) se envía con dos palabras de 16 bits por coordenada en lugar de cuatro bytes, y
+ * 	cada comando de ventana se omite si su rango coincide con el de la ventana anterior.
+ * 	- Los píxeles de cada rectángulo se piden a la aplicación mediante el callback de dibujo, de a lo sumo el tamaño
+ * 	del buffer de línea por llamado, y se transmiten en palabras de 16 bits (un píxel por palabra, sin reordenar bytes).
+ *
+ * # Primitivas directas
+ *
+ * La función @ref hal_spi_lcd_fill pinta un rectángulo de un color sólido transmitiendo el mismo valor repetidas
+ * veces, sin ocupar memoria, y la función @ref hal_spi_lcd_draw transmite un rectángulo de píxeles desde memoria (por
+ * ejemplo un ícono en flash). Ambas dibujan inmediatamente y no modifican las zonas marcadas; si la misma zona está
+ * marcada, el callback de dibujo debe generar el mismo contenido.
+ *
+ * # Inicialización del display
+ *
+ * La secuencia de inicialización depende del controlador y del panel, y requiere demoras de hasta 120ms, por lo que
+ * queda a cargo de la aplicación mediante @ref hal_spi_lcd_command. Al menos debe configurarse el formato de 16 bits
+ * por píxel (*COLMOD* = 0x55) y la orientación (*MADCTL*) coherente con el ancho y el alto configurados.
+ *
+ * # Medición
+ *
+ * El campo *bytes_sent* del estado del display acumula la cantidad de bytes transmitidos, incluyendo comandos y
+ * parámetros, para comparar el costo de cada actualización.
+ *
+ * @{
+ */
+
+#ifndef HAL_SPI_LCD_H_
+#define HAL_SPI_LCD_H_
+
+#include <stdint.h>
+#include "HAL_SPI.h"
+#include "HAL_GPIO.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#ifndef HAL_SPI_LCD_TILE_SIZE
+/** Lado en píxeles de las baldosas de seguimiento de zonas modificadas */
+#define		HAL_SPI_LCD_TILE_SIZE			16
+#endif
+
+#ifndef HAL_SPI_LCD_MAX_HEIGHT
+/** Alto máximo del display en píxeles */
+#define		HAL_SPI_LCD_MAX_HEIGHT			320
+#endif
+
+/** Cantidad máxima de filas de baldosas */
+#define		HAL_SPI_LCD_TILE_ROWS			((HAL_SPI_LCD_MAX_HEIGHT + HAL_SPI_LCD_TILE_SIZE - 1) / HAL_SPI_LCD_TILE_SIZE)
+
+/** Ancho máximo del display en píxeles (una fila de baldosas se representa con 32 bits) */
+#define		HAL_SPI_LCD_MAX_WIDTH			(32 * HAL_SPI_LCD_TILE_SIZE)
+
+/** Conversión de componentes de 8 bits a RGB565 */
+#define		HAL_SPI_LCD_RGB565(r, g, b)		((uint16_t) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+
+/** Resultado de la inicialización de un display */
+typedef enum
+{
+	HAL_SPI_LCD_RESULT_OK = 0, /**< Inicialización exitosa */
+	HAL_SPI_LCD_RESULT_INVALID_CONFIG /**< Dimensiones fuera de rango o buffer de línea vacío */
+}hal_spi_lcd_result_en;
+
+/**
+ * @brief Callback de dibujo
+ *
+ * Debe escribir en *pixels* el color RGB565 de *length* píxeles consecutivos de una línea, comenzando por (*x*, *y*).
+ *
+ * @param[in] x Columna del primer píxel
+ * @param[in] y Fila de los píxeles
+ * @param[in] length Cantidad de píxeles
+ * @param[out] pixels Buffer de línea donde escribir los píxeles
+ * @param[in] data Dato de usuario
+ */
+typedef void (*hal_spi_lcd_render_callback)(uint16_t x, uint16_t y, uint16_t length, uint16_t *pixels, void *data);
+
+/** Configuración de un display */
+typedef struct
+{
+	hal_spi_sel_en spi; /**< Instancia de SPI a la cual está conectado el display */
+	hal_spi_ssel_sel_en ssel; /**< Slave select del display */
+	hal_gpio_portpin_en dc_portpin; /**< Puerto/pin de datos/comando */
+	uint16_t width; /**< Ancho en píxeles, en la orientación configurada. A lo sumo @ref HAL_SPI_LCD_MAX_WIDTH */
+	uint16_t height; /**< Alto en píxeles, en la orientación configurada. A lo sumo @ref HAL_SPI_LCD_MAX_HEIGHT */
+	uint16_t x_offset; /**< Columna de la memoria del controlador correspondiente a la columna 0 del panel */
+	uint16_t y_offset; /**< Fila de la memoria del controlador correspondiente a la fila 0 del panel */
+	uint16_t *line_buffer; /**< Buffer de línea para el callback de dibujo */
+	uint16_t line_buffer_length; /**< Tamaño del buffer de línea en píxeles. Al menos 1 */
+	hal_spi_lcd_render_callback render_callback; /**< Callback de dibujo */
+	void *render_data; /**< Dato de usuario para el callback de dibujo */
+}hal_spi_lcd_config_t;
+
+/** Estado de un display */
+typedef struct
+{
+	hal_spi_lcd_config_t config; /**< Configuración */
+	uint32_t dirty[HAL_SPI_LCD_TILE_ROWS]; /**< Baldosas a redibujar, un bit por columna de baldosas */
+	uint32_t column_window; /**< Último rango de columnas enviado (inicio en los bits 31 a 16), o 0xFFFFFFFF */
+	uint32_t row_window; /**< Último rango de filas enviado (inicio en los bits 31 a 16), o 0xFFFFFFFF */
+	uint32_t bytes_sent; /**< Cantidad de bytes transmitidos */
+}hal_spi_lcd_t;
+
+/**
+ * @brief Inicializar el controlador de un display
+ *
+ * Configura el pin de datos/comando y marca la pantalla completa para redibujar.
+ *
+ * @param[out] lcd Estado del display
+ * @param[in] config Configuración deseada
+ * @return Resultado de la inicialización
+ * @pre Haber inicializado la instancia de SPI en modo master y configurado la transmisión
+ */
+hal_spi_lcd_result_en hal_spi_lcd_init(hal_spi_lcd_t *lcd, const hal_spi_lcd_config_t *config);
+
+/**
+ * @brief Enviar un comando con sus parámetros
+ * @param[in] lcd Estado del display
+ * @param[in] command Comando
+ * @param[in] params Parámetros. Puede ser NULL si *length* es cero
+ * @param[in] length Cantidad de parámetros
+ */
+void hal_spi_lcd_command(hal_spi_lcd_t *lcd, uint8_t command, const uint8_t *params, uint32_t length);
+
+/**
+ * @brief Marcar un rectángulo para redibujar
+ * @param[in] lcd Estado del display
+ * @param[in] x Columna del rectángulo
+ * @param[in] y Fila del rectángulo
+ * @param[in] width Ancho del rectángulo
+ * @param[in] height Alto del rectángulo
+ */
+void hal_spi_lcd_invalidate(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+/**
+ * @brief Marcar la pantalla completa para redibujar
+ * @param[in] lcd Estado del display
+ */
+void hal_spi_lcd_invalidate_all(hal_spi_lcd_t *lcd);
+
+/**
+ * @brief Redibujar las zonas marcadas
+ * @param[in] lcd Estado del display
+ */
+void hal_spi_lcd_flush(hal_spi_lcd_t *lcd);
+
+/**
+ * @brief Pintar un rectángulo de un color sólido
+ * @param[in] lcd Estado del display
+ * @param[in] x Columna del rectángulo
+ * @param[in] y Fila del rectángulo
+ * @param[in] width Ancho del rectángulo
+ * @param[in] height Alto del rectángulo
+ * @param[in] color Color RGB565
+ */
+void hal_spi_lcd_fill(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
+
+/**
+ * @brief Dibujar un rectángulo de píxeles
+ * @param[in] lcd Estado del display
+ * @param[in] x Columna del rectángulo
+ * @param[in] y Fila del rectángulo
+ * @param[in] width Ancho del rectángulo
+ * @param[in] height Alto del rectángulo
+ * @param[in] pixels Píxeles RGB565, por filas de *width* píxeles. Se dibuja únicamente la parte dentro de la pantalla
+ */
+void hal_spi_lcd_draw(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_SPI_LCD_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,216 @@
+/**
+ * @file HAL_SPI_NOR.h
+ * @brief Declaraciones a nivel de aplicacion del controlador de memorias flash NOR SPI (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup SPI_NOR Memorias flash NOR SPI
+ *
+ * # Introducción
+ *
+ * Controlador para memorias flash NOR con interfaz SPI y juego de comandos JEDEC estándar (familias W25Qxx, MX25Lxx,
+ * AT25SFxxx, etc.), con direcciones de 24 bits, conectadas a una instancia de @ref SPI en modo master.
+ *
+ * Una programación de página demora típicamente entre 0.5 y 3 ms, y un borrado de sector decenas de milisegundos,
+ * durante los cuales la memoria indica *WIP* (*Write In Progress*) en su registro de estado. Para no esperar ese
+ * tiempo en el lazo principal, las programaciones y borrados se encolan y se ejecutan desde
+ * @ref hal_spi_nor_poll.
+ *
+ * # Cola de programación y borrado
+ *
+ * Las funciones @ref hal_spi_nor_program y @ref hal_spi_nor_erase sólo agregan la operación a la cola y retornan
+ * inmediatamente. Las programaciones que cruzan un límite de página se dividen automáticamente. Los datos a
+ * programar **no se copian**, por lo que el buffer no debe modificarse hasta que la operación termine (ver
+ * @ref hal_spi_nor_is_idle).
+ *
+ * La función @ref hal_spi_nor_poll debe llamarse periódicamente, típicamente desde el callback del @ref SYSTICK
+ * con un período de 1 ms. En cada llamado lee el registro de estado una única vez: si la memoria sigue ocupada
+ * retorna, y si no, inicia la siguiente página u operación de la cola.
+ *
+ * # Lecturas
+ *
+ * Las lecturas sólo pueden realizarse con la cola vacía y la memoria libre; en caso contrario retornan
+ * @ref HAL_SPI_NOR_RESULT_BUSY. Para lecturas chicas se utiliza un caché de lectura anticipada de
+ * @ref HAL_SPI_NOR_CACHE_SIZE bytes: ante un fallo se lee el bloque completo a partir de la dirección pedida, de
+ * modo que las lecturas siguientes consecutivas no repiten el comando y la dirección. El caché se invalida al
+ * encolar una programación o un borrado.
+ *
+ * Para leer grandes volúmenes en forma secuencial se dispone de la lectura continua (@ref hal_spi_nor_stream_begin,
+ * @ref hal_spi_nor_stream_read y @ref hal_spi_nor_stream_end), que mantiene el slave select activo entre bloques.
+ * Mientras dura una lectura continua no se ejecutan operaciones de la cola.
+ *
+ * Las fases de comando y dirección se transmiten con *RXIGNORE*, sin leer los datos recibidos.
+ *
+ * @note La función @ref hal_spi_nor_poll puede llamarse desde una interrupción. Las demás funciones deben llamarse
+ * desde el lazo principal.
+ *
+ * @{
+ */
+
+#ifndef HAL_SPI_NOR_H_
+#define HAL_SPI_NOR_H_
+
+#include <stdint.h>
+#include "HAL_SPI.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#ifndef HAL_SPI_NOR_QUEUE_LENGTH
+/** Cantidad de operaciones que pueden encolarse (potencia de 2) */
+#define		HAL_SPI_NOR_QUEUE_LENGTH		8
+#endif
+
+#ifndef HAL_SPI_NOR_CACHE_SIZE
+/** Tamaño en bytes del caché de lectura anticipada */
+#define		HAL_SPI_NOR_CACHE_SIZE			32
+#endif
+
+/** Tamaño de página de programación */
+#define		HAL_SPI_NOR_PAGE_SIZE			256
+
+/** Resultado de las operaciones sobre la memoria */
+typedef enum
+{
+	HAL_SPI_NOR_RESULT_OK = 0, /**< Operación exitosa o encolada */
+	HAL_SPI_NOR_RESULT_BUSY, /**< Hay operaciones pendientes o una lectura continua en curso */
+	HAL_SPI_NOR_RESULT_QUEUE_FULL, /**< La cola de operaciones está llena */
+	HAL_SPI_NOR_RESULT_PARAM_ERROR /**< Parámetros inválidos */
+}hal_spi_nor_result_en;
+
+/** Tamaño de borrado */
+typedef enum
+{
+	HAL_SPI_NOR_ERASE_4K = 0, /**< Sector de 4KB */
+	HAL_SPI_NOR_ERASE_32K, /**< Bloque de 32KB */
+	HAL_SPI_NOR_ERASE_64K, /**< Bloque de 64KB */
+	HAL_SPI_NOR_ERASE_CHIP /**< Memoria completa */
+}hal_spi_nor_erase_en;
+
+/** Operación encolada */
+typedef struct
+{
+	uint8_t command; /**< Comando de la operación */
+	uint32_t address; /**< Dirección de la próxima página o del borrado */
+	const uint8_t *data; /**< Datos restantes a programar */
+	uint32_t length; /**< Cantidad de datos restantes a programar */
+}hal_spi_nor_op_t;
+
+/** Estado de una memoria */
+typedef struct
+{
+	hal_spi_sel_en spi; /**< Instancia de SPI */
+	hal_spi_ssel_sel_en ssel; /**< Slave select de la memoria */
+	volatile uint8_t bus_locked; /**< Distinto de cero mientras el lazo principal utiliza el bus */
+	volatile uint8_t write_in_progress; /**< Distinto de cero si la última operación iniciada puede no haber terminado */
+	volatile uint8_t queue_head; /**< Índice de escritura de la cola */
+	volatile uint8_t queue_tail; /**< Índice de lectura de la cola */
+	hal_spi_nor_op_t queue[HAL_SPI_NOR_QUEUE_LENGTH]; /**< Cola de operaciones */
+	uint32_t cache_address; /**< Dirección del primer byte del caché */
+	uint32_t cache_length; /**< Cantidad de bytes válidos en el caché */
+	uint8_t cache[HAL_SPI_NOR_CACHE_SIZE]; /**< Caché de lectura anticipada */
+}hal_spi_nor_t;
+
+/**
+ * @brief Inicializar el controlador de una memoria
+ * @param[out] nor Estado de la memoria. Debe tener duración estática
+ * @param[in] spi Instancia de SPI a la cual está conectada la memoria
+ * @param[in] ssel Slave select de la memoria
+ * @pre Haber inicializado la instancia de SPI en modo master y configurado la transmisión
+ */
+void hal_spi_nor_init(hal_spi_nor_t *nor, hal_spi_sel_en spi, hal_spi_ssel_sel_en ssel);
+
+/**
+ * @brief Leer la identificación JEDEC de la memoria
+ * @param[in] nor Estado de la memoria
+ * @param[out] id Fabricante, tipo y capacidad, en los bits 23 a 16, 15 a 8 y 7 a 0 respectivamente
+ * @return Resultado de la operación
+ */
+hal_spi_nor_result_en hal_spi_nor_read_id(hal_spi_nor_t *nor, uint32_t *id);
+
+/**
+ * @brief Leer datos de la memoria
+ * @param[in] nor Estado de la memoria
+ * @param[in] address Dirección inicial
+ * @param[out] data Buffer donde guardar los datos
+ * @param[in] length Cantidad de datos a leer
+ * @return Resultado de la operación
+ */
+hal_spi_nor_result_en hal_spi_nor_read(hal_spi_nor_t *nor, uint32_t address, uint8_t *data, uint32_t length);
+
+/**
+ * @brief Encolar una programación
+ * @param[in] nor Estado de la memoria
+ * @param[in] address Dirección inicial
+ * @param[in] data Datos a programar. No se copian
+ * @param[in] length Cantidad de datos a programar
+ * @return Resultado de la operación
+ * @pre La zona a programar debe estar borrada
+ */
+hal_spi_nor_result_en hal_spi_nor_program(hal_spi_nor_t *nor, uint32_t address, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Encolar un borrado
+ * @param[in] nor Estado de la memoria
+ * @param[in] size Tamaño del borrado
+ * @param[in] address Dirección dentro del sector o bloque a borrar. Se ignora para @ref HAL_SPI_NOR_ERASE_CHIP
+ * @return Resultado de la operación
+ */
+hal_spi_nor_result_en hal_spi_nor_erase(hal_spi_nor_t *nor, hal_spi_nor_erase_en size, uint32_t address);
+
+/**
+ * @brief Avanzar la cola de operaciones
+ *
+ * Lee el registro de estado si hay una operación en curso y, si la memoria está libre, inicia la siguiente
+ * operación de la cola. No tiene efecto si el lazo principal está utilizando el bus.
+ *
+ * @param[in] nor Estado de la memoria
+ */
+void hal_spi_nor_poll(hal_spi_nor_t *nor);
+
+/**
+ * @brief Consultar si terminaron todas las operaciones encoladas
+ * @param[in] nor Estado de la memoria
+ * @return Distinto de cero si la cola está vacía y la memoria libre
+ */
+uint8_t hal_spi_nor_is_idle(const hal_spi_nor_t *nor);
+
+/**
+ * @brief Comenzar una lectura continua
+ *
+ * Envía el comando y la dirección, y deja el slave select activo.
+ *
+ * @param[in] nor Estado de la memoria
+ * @param[in] address Dirección inicial
+ * @return Resultado de la operación
+ */
+hal_spi_nor_result_en hal_spi_nor_stream_begin(hal_spi_nor_t *nor, uint32_t address);
+
+/**
+ * @brief Leer el siguiente bloque de una lectura continua
+ * @param[in] nor Estado de la memoria
+ * @param[out] data Buffer donde guardar los datos
+ * @param[in] length Cantidad de datos a leer
+ * @pre Haber comenzado la lectura mediante @ref hal_spi_nor_stream_begin
+ */
+void hal_spi_nor_stream_read(hal_spi_nor_t *nor, uint8_t *data, uint32_t length);
+
+/**
+ * @brief Terminar una lectura continua
+ * @param[in] nor Estado de la memoria
+ */
+void hal_spi_nor_stream_end(hal_spi_nor_t *nor);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_SPI_NOR_H_ */
+
+/**
+ * @}
+ */
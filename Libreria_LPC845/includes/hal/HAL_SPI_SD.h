@@ -0,0 +1,271 @@
+/**
+ * @file HAL_SPI_SD.h
+ * @brief Declaraciones a nivel de aplicacion del controlador de tarjetas SD en modo SPI (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup SPI_SD Tarjetas SD en modo SPI
+ *
+ * # Introducción
+ *
+ * Controlador de dispositivo de bloques para tarjetas SD/SDHC/SDXC (incluyendo microSD) conectadas a una instancia de
+ * @ref SPI en modo master. Los bloques son siempre de 512 bytes y se direccionan por número de bloque,
+ * independientemente de que la tarjeta utilice direccionamiento por byte (SDSC) o por bloque (SDHC/SDXC).
+ *
+ * # Funcionamiento no bloqueante
+ *
+ * Las tarjetas SD tienen fases de ocupado largas e impredecibles: la inicialización puede demorar hasta un segundo,
+ * y cada bloque escrito puede demorar desde decenas de microsegundos hasta cientos de milisegundos. Para no detener
+ * el lazo principal durante esas fases, las funciones de este módulo sólo inician las operaciones, y la función
+ * @ref hal_spi_sd_process las hace avanzar.
+ *
+ * Cada llamado a @ref hal_spi_sd_process realiza una cantidad acotada de trabajo: un intento de inicialización, la
+ * transferencia de un bloque, o la lectura de a lo sumo @ref HAL_SPI_SD_POLL_BYTES bytes esperando que la tarjeta
+ * termine una fase de ocupado. El valor retornado indica el estado del controlador:
+ * 	- @ref HAL_SPI_SD_STATUS_READY: no hay operaciones en curso, puede iniciarse una lectura o escritura.
+ * 	- @ref HAL_SPI_SD_STATUS_BUSY: hay una operación en curso.
+ * 	- @ref HAL_SPI_SD_STATUS_WRITE_READY: hay una escritura abierta esperando más bloques.
+ * 	- @ref HAL_SPI_SD_STATUS_ERROR: la última operación falló (ver @ref hal_spi_sd_get_error). Debe volver a
+ * 	inicializarse la tarjeta.
+ *
+ * # Inicialización
+ *
+ * La función @ref hal_spi_sd_init configura el clock de inicialización (a lo sumo 400KHz) mediante
+ * @ref hal_spi_master_mode_tx_config, envía los ciclos de clock iniciales, y los comandos *CMD0* y *CMD8*. La espera
+ * de *ACMD41* se realiza desde @ref hal_spi_sd_process, con un intento por llamado. Al terminar se lee el *OCR* para
+ * determinar el tipo de tarjeta, y se configura el clock de operación.
+ *
+ * # Transferencias de múltiples bloques
+ *
+ * Las lecturas utilizan *CMD18* (*READ_MULTIPLE_BLOCK*) y las escrituras *CMD25* (*WRITE_MULTIPLE_BLOCK*), de modo
+ * que el comando, la dirección y la fase de preparación de la tarjeta se pagan una única vez por transferencia, y no
+ * una vez por bloque.
+ *
+ * Para registrar datos en forma continua se dispone de la escritura abierta (@ref hal_spi_sd_write_open,
+ * @ref hal_spi_sd_write_append y @ref hal_spi_sd_write_close): la tarjeta permanece en modo de escritura de
+ * múltiples bloques entre llamados, y los bloques se agregan a medida que el lazo principal los completa. Si se
+ * conoce la cantidad de bloques a escribir, se informa a la tarjeta mediante *ACMD23* para que pueda borrarlos por
+ * adelantado, lo cual reduce las fases de ocupado en la mayoría de las tarjetas.
+ *
+ * El slave select permanece activo durante toda la transferencia, incluso entre llamados a
+ * @ref hal_spi_sd_process, por lo que la instancia de SPI no puede compartirse con otros dispositivos mientras haya
+ * una operación en curso.
+ *
+ * Los buffers de datos **no se copian**, por lo que no deben modificarse (escritura) ni leerse (lectura) hasta que la
+ * operación termine.
+ *
+ * # CRC
+ *
+ * En modo SPI la verificación de CRC de la tarjeta está inhabilitada por defecto. Si se habilita en la configuración,
+ * se envía *CMD59* al terminar la inicialización y se calcula y verifica el CRC16 de cada bloque. Esto detecta
+ * errores en el bus a costa de tiempo de CPU por bloque. El CRC7 de los comandos se calcula siempre.
+ *
+ * @note Todas las funciones deben llamarse desde el lazo principal.
+ *
+ * @{
+ */
+
+#ifndef HAL_SPI_SD_H_
+#define HAL_SPI_SD_H_
+
+#include <stdint.h>
+#include "HAL_SPI.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Tamaño de bloque */
+#define		HAL_SPI_SD_BLOCK_SIZE			512
+
+#ifndef HAL_SPI_SD_POLL_BYTES
+/** Cantidad máxima de bytes leídos por llamado a @ref hal_spi_sd_process esperando a la tarjeta */
+#define		HAL_SPI_SD_POLL_BYTES			16
+#endif
+
+#ifndef HAL_SPI_SD_TIMEOUT_BYTES
+/** Cantidad máxima de bytes leídos esperando que la tarjeta termine una fase de ocupado. Cada byte dura al menos 8
+ * períodos del clock del SPI */
+#define		HAL_SPI_SD_TIMEOUT_BYTES		500000
+#endif
+
+#ifndef HAL_SPI_SD_INIT_RETRIES
+/** Cantidad máxima de intentos de *ACMD41* durante la inicialización */
+#define		HAL_SPI_SD_INIT_RETRIES			2000
+#endif
+
+/** Resultado de las operaciones sobre la tarjeta */
+typedef enum
+{
+	HAL_SPI_SD_RESULT_OK = 0, /**< Operación iniciada o aceptada */
+	HAL_SPI_SD_RESULT_BUSY, /**< Hay una operación en curso o la tarjeta no está lista */
+	HAL_SPI_SD_RESULT_ERROR /**< El controlador está en estado de error */
+}hal_spi_sd_result_en;
+
+/** Estado del controlador */
+typedef enum
+{
+	HAL_SPI_SD_STATUS_READY = 0, /**< Sin operaciones en curso */
+	HAL_SPI_SD_STATUS_BUSY, /**< Operación en curso */
+	HAL_SPI_SD_STATUS_WRITE_READY, /**< Escritura abierta esperando más bloques */
+	HAL_SPI_SD_STATUS_ERROR /**< Error */
+}hal_spi_sd_status_en;
+
+/** Errores */
+typedef enum
+{
+	HAL_SPI_SD_ERROR_NONE = 0, /**< Sin error */
+	HAL_SPI_SD_ERROR_NO_CARD, /**< La tarjeta no respondió a *CMD0* */
+	HAL_SPI_SD_ERROR_UNSUPPORTED, /**< Tarjeta o tensión de alimentación no soportada */
+	HAL_SPI_SD_ERROR_TIMEOUT, /**< La tarjeta no terminó una fase de ocupado a tiempo */
+	HAL_SPI_SD_ERROR_COMMAND, /**< La tarjeta rechazó un comando */
+	HAL_SPI_SD_ERROR_READ, /**< La tarjeta respondió con un token de error en una lectura */
+	HAL_SPI_SD_ERROR_WRITE, /**< La tarjeta rechazó un bloque escrito */
+	HAL_SPI_SD_ERROR_CRC /**< Error de CRC en un bloque leído o escrito */
+}hal_spi_sd_error_en;
+
+/** Tipo de tarjeta */
+typedef enum
+{
+	HAL_SPI_SD_TYPE_UNKNOWN = 0, /**< Tarjeta no inicializada */
+	HAL_SPI_SD_TYPE_SDSC_V1, /**< SDSC versión 1.x, direccionamiento por byte */
+	HAL_SPI_SD_TYPE_SDSC_V2, /**< SDSC versión 2.0 o posterior, direccionamiento por byte */
+	HAL_SPI_SD_TYPE_SDHC /**< SDHC/SDXC, direccionamiento por bloque */
+}hal_spi_sd_type_en;
+
+/** Estado interno de la máquina de estados */
+typedef enum
+{
+	HAL_SPI_SD_STATE_ERROR = 0, /**< Error o tarjeta no inicializada */
+	HAL_SPI_SD_STATE_INIT, /**< Esperando el fin de la inicialización (*ACMD41*) */
+	HAL_SPI_SD_STATE_READY, /**< Sin operaciones en curso */
+	HAL_SPI_SD_STATE_READ_TOKEN, /**< Esperando el token de inicio del próximo bloque leído */
+	HAL_SPI_SD_STATE_WRITE_BLOCK, /**< Escritura abierta, listo para transmitir el próximo bloque */
+	HAL_SPI_SD_STATE_WRITE_BUSY, /**< Esperando que la tarjeta termine de programar un bloque */
+	HAL_SPI_SD_STATE_STOP_BUSY /**< Esperando que la tarjeta termine una transferencia */
+}hal_spi_sd_state_en;
+
+/** Configuración de una tarjeta */
+typedef struct
+{
+	hal_spi_sel_en spi; /**< Instancia de SPI a la cual está conectada la tarjeta */
+	hal_spi_ssel_sel_en ssel; /**< Slave select de la tarjeta */
+	hal_spi_master_mode_tx_config_t init_tx_config; /**< Configuración de transmisión durante la inicialización (a lo sumo 400KHz, modo 0) */
+	hal_spi_master_mode_tx_config_t tx_config; /**< Configuración de transmisión de operación (a lo sumo 25MHz, modo 0) */
+	uint8_t crc_enable; /**< Distinto de cero para habilitar la verificación de CRC */
+}hal_spi_sd_config_t;
+
+/** Estado de una tarjeta */
+typedef struct
+{
+	hal_spi_sel_en spi; /**< Instancia de SPI */
+	hal_spi_ssel_sel_en ssel; /**< Slave select de la tarjeta */
+	hal_spi_master_mode_tx_config_t tx_config; /**< Configuración de transmisión de operación */
+	uint8_t crc_enable; /**< Distinto de cero si la verificación de CRC está habilitada */
+	hal_spi_sd_type_en type; /**< Tipo de tarjeta */
+	hal_spi_sd_state_en state; /**< Estado de la máquina de estados */
+	hal_spi_sd_error_en error; /**< Último error */
+	uint8_t write_open; /**< Distinto de cero si la escritura en curso acepta más bloques */
+	uint8_t close_requested; /**< Distinto de cero si se pidió cerrar la escritura en curso */
+	uint8_t *rx_data; /**< Buffer del próximo bloque a leer */
+	const uint8_t *tx_data; /**< Datos del próximo bloque a escribir */
+	uint32_t count; /**< Cantidad de bloques restantes de la transferencia o de los datos agregados */
+	uint32_t timeout; /**< Bytes restantes hasta considerar vencida la fase de ocupado en curso */
+}hal_spi_sd_t;
+
+/**
+ * @brief Iniciar la inicialización de una tarjeta
+ *
+ * Envía los ciclos de clock iniciales y los comandos *CMD0* y *CMD8*. La inicialización continúa mediante
+ * @ref hal_spi_sd_process hasta que retorne @ref HAL_SPI_SD_STATUS_READY o @ref HAL_SPI_SD_STATUS_ERROR.
+ *
+ * @param[out] sd Estado de la tarjeta. Debe tener duración estática
+ * @param[in] config Configuración deseada
+ * @pre Haber inicializado la instancia de SPI en modo master, sin callback de recepción registrado
+ */
+void hal_spi_sd_init(hal_spi_sd_t *sd, const hal_spi_sd_config_t *config);
+
+/**
+ * @brief Avanzar la operación en curso
+ * @param[in] sd Estado de la tarjeta
+ * @return Estado del controlador
+ */
+hal_spi_sd_status_en hal_spi_sd_process(hal_spi_sd_t *sd);
+
+/**
+ * @brief Iniciar una lectura de múltiples bloques
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] block Número del primer bloque
+ * @param[out] data Buffer donde guardar los datos. Debe tener lugar para *count* bloques
+ * @param[in] count Cantidad de bloques a leer
+ * @return Resultado de la operación
+ */
+hal_spi_sd_result_en hal_spi_sd_read(hal_spi_sd_t *sd, uint32_t block, uint8_t *data, uint32_t count);
+
+/**
+ * @brief Iniciar una escritura de múltiples bloques
+ *
+ * Equivale a abrir una escritura con borrado anticipado de *count* bloques, agregar los datos y cerrarla.
+ *
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] block Número del primer bloque
+ * @param[in] data Datos a escribir. No se copian
+ * @param[in] count Cantidad de bloques a escribir
+ * @return Resultado de la operación
+ */
+hal_spi_sd_result_en hal_spi_sd_write(hal_spi_sd_t *sd, uint32_t block, const uint8_t *data, uint32_t count);
+
+/**
+ * @brief Abrir una escritura de múltiples bloques
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] block Número del primer bloque
+ * @param[in] erase_count Cantidad de bloques a borrar por adelantado (*ACMD23*). Cero si no se conoce
+ * @return Resultado de la operación
+ */
+hal_spi_sd_result_en hal_spi_sd_write_open(hal_spi_sd_t *sd, uint32_t block, uint32_t erase_count);
+
+/**
+ * @brief Agregar bloques a una escritura abierta
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] data Datos a escribir. No se copian
+ * @param[in] count Cantidad de bloques a escribir
+ * @return @ref HAL_SPI_SD_RESULT_BUSY si todavía no se transmitieron los bloques agregados anteriormente
+ */
+hal_spi_sd_result_en hal_spi_sd_write_append(hal_spi_sd_t *sd, const uint8_t *data, uint32_t count);
+
+/**
+ * @brief Cerrar una escritura abierta
+ *
+ * La escritura termina luego de transmitir los bloques agregados pendientes.
+ *
+ * @param[in] sd Estado de la tarjeta
+ * @return Resultado de la operación
+ */
+hal_spi_sd_result_en hal_spi_sd_write_close(hal_spi_sd_t *sd);
+
+/**
+ * @brief Obtener el último error
+ * @param[in] sd Estado de la tarjeta
+ * @return Último error
+ */
+hal_spi_sd_error_en hal_spi_sd_get_error(const hal_spi_sd_t *sd);
+
+/**
+ * @brief Obtener el tipo de tarjeta
+ * @param[in] sd Estado de la tarjeta
+ * @return Tipo de tarjeta
+ */
+hal_spi_sd_type_en hal_spi_sd_get_type(const hal_spi_sd_t *sd);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_SPI_SD_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,130 @@
+/**
+ * @file HAL_STARTUP.h
+ * @brief Declaraciones a nivel de aplicacion del arranque del sistema (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup STARTUP Arranque del sistema
+ *
+ * # Introducción
+ *
+ * Luego de un reset (incluyendo la salida de *Deep power-down*), el tiempo hasta la primera instrucción de la
+ * aplicación depende de la inicialización de las secciones de datos y de la inicialización de los periféricos. Este
+ * módulo provee un código de arranque propio de la librería, que reemplaza al archivo *cr_startup_lpc84x.c* generado
+ * por MCUXpresso, y un registro de inicializaciones diferidas para que los periféricos que no son críticos se
+ * inicialicen recién cuando son utilizados por primera vez.
+ *
+ * # Código de arranque
+ *
+ * Si el proyecto se compila con el símbolo *HAL_STARTUP_ENABLE* definido, la librería provee la tabla de vectores,
+ * la función *ResetISR* y los *handlers* por defecto, por lo que el archivo *cr_startup_lpc84x.c* debe eliminarse del
+ * proyecto. Los *handlers* de interrupción se definen como *weak*, igual que en el archivo original, por lo que los
+ * definidos en la librería o en la aplicación tienen precedencia.
+ *
+ * Las diferencias con el arranque genérico son:
+ * 	- Las secciones de datos se copian de a 4 palabras por iteración, lo cual permite al compilador utilizar las
+ * 	instrucciones de carga y almacenamiento múltiple.
+ * 	- Las secciones se recorren a partir de la tabla de secciones del *managed linker script* de MCUXpresso, por lo
+ * 	que se inicializan también las secciones de @ref RAMFUNC.
+ * 	- Las variables marcadas con @ref HAL_NOINIT se ubican fuera de la sección *.bss*, por lo que no se ponen en cero.
+ * 	Esto ahorra el tiempo de borrado de buffers grandes y permite conservar valores ante un reset por software o por
+ * 	watchdog.
+ * 	- Antes de los constructores de C++ y de *main*, se llama a @ref hal_startup_early_init, que la aplicación puede
+ * 	definir para configurar lo estrictamente necesario lo antes posible.
+ * 	.
+ *
+ * La definición de *__USE_ROMDIVIDE* se respeta de la misma manera que en el archivo original.
+ *
+ * # Inicializaciones diferidas
+ *
+ * Una inicialización diferida se representa con un objeto del tipo @ref hal_startup_deferred_t, el cual se registra
+ * con @ref hal_startup_deferred_register indicando la función de inicialización. La inicialización se ejecuta como
+ * máximo una vez, en el primero de estos casos:
+ * 	- Al llamar a @ref hal_startup_deferred_require, típicamente desde la primera función que necesita el periférico
+ * 	inicializado.
+ * 	- Al llamar a @ref hal_startup_deferred_run_next, típicamente desde el lazo principal cuando no hay trabajo
+ * 	pendiente.
+ * 	.
+ *
+ * La librería utiliza este mecanismo para la calibración del @ref ADC y para la estabilización del cristal externo
+ * (ver @ref hal_syscon_external_crystal_start).
+ *
+ * @note Las funciones de inicialización diferida deben llamarse fuera de interrupciones.
+ *
+ * @{
+ */
+
+#ifndef HAL_STARTUP_H_
+#define HAL_STARTUP_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Atributo para ubicar una variable en la sección de RAM que no se inicializa en el arranque */
+#define		HAL_NOINIT			__attribute__ ((section(".noinit.$RAM")))
+
+/** Tipo de dato para funciones de inicialización */
+typedef void (*hal_startup_init_t)(void);
+
+/** Inicialización diferida */
+typedef struct hal_startup_deferred_t
+{
+	hal_startup_init_t init; /**< Función de inicialización */
+	struct hal_startup_deferred_t *next; /**< Siguiente inicialización registrada */
+	uint8_t pending; /**< Distinto de cero si la inicialización todavía no se ejecutó */
+}hal_startup_deferred_t;
+
+/**
+ * @brief Inicialización temprana de la aplicación
+ *
+ * Se llama desde el código de arranque luego de inicializar las secciones de datos y antes de *main*. La librería
+ * provee una definición vacía con atributo *weak*, por lo que la aplicación puede redefinirla.
+ */
+void hal_startup_early_init(void);
+
+/**
+ * @brief Registrar una inicialización diferida
+ *
+ * Si la inicialización ya estaba registrada, se vuelve a marcar como pendiente.
+ *
+ * @param[in] entry Objeto de la inicialización diferida. Debe tener duración estática
+ * @param[in] init Función de inicialización
+ */
+void hal_startup_deferred_register(hal_startup_deferred_t *entry, hal_startup_init_t init);
+
+/**
+ * @brief Cancelar una inicialización diferida pendiente
+ * @param[in] entry Objeto de la inicialización diferida
+ */
+void hal_startup_deferred_cancel(hal_startup_deferred_t *entry);
+
+/**
+ * @brief Asegurar que una inicialización diferida se haya ejecutado
+ *
+ * Si la inicialización está pendiente, se ejecuta en este llamado.
+ *
+ * @param[in] entry Objeto de la inicialización diferida
+ */
+void hal_startup_deferred_require(hal_startup_deferred_t *entry);
+
+/**
+ * @brief Ejecutar la siguiente inicialización diferida pendiente
+ * @return Distinto de cero si se ejecutó alguna inicialización, cero si no había ninguna pendiente
+ */
+uint8_t hal_startup_deferred_run_next(void);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_STARTUP_H_ */
+
+/**
+ * @}
+ */
@@ -71,7 +71,8 @@
  * si se utiliza un oscilador externo, se utilizará únicamente el pin P0_1.
  *
  * @note Para configurar el clock externo se utilizan las funciones @ref hal_syscon_external_crystal_config y
- * @ref hal_syscon_external_clock_config.
+ * @ref hal_syscon_external_clock_config. La función @ref hal_syscon_external_crystal_start permite no esperar la
+ * estabilización del cristal durante el arranque.
  *
  * ### Generadores fraccionales de clock
  *
@@ -131,8 +132,8 @@
  * luego de pasar por este divisor. El divisor puede ser configurado en cualquier valor entero entre 0 y 255. Si se
  * coloca en 0, el clock del *SCT* será anulado.
  *
- * @note Este periférico, así como las funciones para configurar su divisor en el *SYSCON*, todavía no
- * está implementado en la librería.
+ * @note El periférico @ref SCT se ocupará de configurar su divisor en sus funciones de inicialización. No se
+ * proveen funciones en este módulo para la configuración del mismo.
  *
  * ### Divisor de la salida CLKOUT
  *
@@ -309,10 +310,24 @@ uint32_t hal_syscon_fro_clock_get(void);
 
 /**
  * @brief Configurar el ext clock a partir de un cristal externo
+ *
+ * Espera la estabilización del cristal antes de retornar.
+ *
  * @param[in] crystal_freq Frecuencia del cristal externo utilizado
  */
 void hal_syscon_external_crystal_config(uint32_t crystal_freq);
 
+/**
+ * @brief Encender el oscilador del cristal externo sin esperar su estabilización
+ *
+ * La estabilización y la selección del cristal como ext clock quedan registradas como inicialización diferida (ver
+ * @ref STARTUP), la cual se completa al seleccionar el ext clock como fuente de un clock, o antes si la aplicación
+ * llama a @ref hal_startup_deferred_run_next.
+ *
+ * @param[in] crystal_freq Frecuencia del cristal externo utilizado
+ */
+void hal_syscon_external_crystal_start(uint32_t crystal_freq);
+
 /**
  * @brief Configurar el ext clock a partir de una fuente de clock externa
  * @param[in] external_clock_freq Frecuencia de la fuente de clock externa en Hz
@@ -352,6 +367,13 @@ void hal_syscon_clkout_config(hal_gpio_portpin_en portpin, hal_syscon_clkout_sou
  */
 void hal_syscon_frg_config(uint8_t inst, hal_syscon_frg_clock_sel_en clock_source, uint32_t mul);
 
+/**
+ * @brief Obtener la frecuencia de entrada de un divisor fraccional
+ * @param[in] inst Instancia de FRG a consultar
+ * @return Frecuencia en Hz de la fuente de clock seleccionada para el FRG
+ */
+uint32_t hal_syscon_frg_input_clock_get(uint8_t inst);
+
 /**
  * @brief Configuración del watchdog oscillator
  * @param[in] clkana_sel Selección de frecuencia base del oscilador
@@ -361,6 +383,12 @@ void hal_syscon_frg_config(uint8_t inst, hal_syscon_frg_clock_sel_en clock_sourc
  */
 void hal_syscon_watchdog_oscillator_config(hal_syscon_watchdog_clkana_sel_en clkana_sel, uint8_t div);
 
+/**
+ * @brief Obtener la frecuencia configurada del watchdog oscillator
+ * @return Frecuencia nominal en Hz del watchdog oscillator, o cero si no fue configurado
+ */
+uint32_t hal_syscon_watchdog_oscillator_get(void);
+
 /**
  * @brief Obtener la frecuencia de clock en Hz configurada para cierto periférico
  * @param[in] peripheral Periférico deseado
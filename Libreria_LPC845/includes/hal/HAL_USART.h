@@ -98,6 +98,76 @@
  * 		BRGVAL = \frac{CLK_{USART}}{(OSRVAL+1) \cdot Baudrate} - 1
  * \f}
  *
+ * ## Cálculo automático del baudrate
+ *
+ * Con un oversampling fijo y el truncamiento de la fórmula anterior, el error a baudrates altos (460800 o 921600
+ * bps a partir de 24MHz o 30MHz) puede superar la tolerancia del otro extremo. La función @ref hal_usart_baud_solve
+ * busca en conjunto el oversampling (x5 a x16), el *BRGVAL* y, si la instancia utiliza un *FRG* como fuente de clock,
+ * el multiplicador del *FRG*, de forma de minimizar el error:
+ *
+ * \f{eqnarray*}{
+ * 		Baudrate = \frac{CLK_{FRG} \cdot 256}{(256 + MULT) \cdot (OSRVAL+1) \cdot (BRGVAL+1)}
+ * \f}
+ *
+ * A igual error se prefiere el mayor oversampling. La función @ref hal_usart_baud_config aplica la solución a una
+ * instancia, y @ref hal_usart_init la utiliza si se configura el oversampling @ref HAL_USART_OVERSAMPLING_AUTO.
+ *
+ * Si la instancia utiliza un *FRG*, el multiplicador del mismo se reconfigura, salvo que otra instancia USART
+ * habilitada utilice el mismo *FRG*: en ese caso el multiplicador se mantiene, y la búsqueda se limita al
+ * oversampling y al *BRGVAL* sobre la frecuencia actual del *FRG*. Si @ref hal_usart_init no encuentra solución con
+ * el cálculo automático, utiliza un oversampling x16.
+ *
+ * @note La librería no verifica el uso del *FRG* por otros periféricos (I2C, SPI), por lo que no debe compartirse
+ * con ellos si necesitan una frecuencia distinta.
+ *
+ * # Modo RS-485 multipunto
+ *
+ * En un bus RS-485 con varios nodos, cada trama comienza con un dato de dirección (con el noveno bit en 1) seguido
+ * de los datos (con el noveno bit en 0). La función @ref hal_usart_rs485_init configura la instancia para este
+ * esquema utilizando los recursos del periférico:
+ * 		- La señal *RTS* se utiliza como habilitación del transmisor (*DE*) del transceptor, con la polaridad
+ * 		configurada. El periférico la activa durante la transmisión sin intervención del software y, si se habilita
+ * 		el *turnaround*, la mantiene activa durante un caracter adicional luego del último bit de stop, para que el
+ * 		último dato no se corte antes de liberar el bus. Sólo las USART 0, 1 y 2 tienen señal *RTS*; las USART 3 y 4
+ * 		pueden utilizarse con transceptores de dirección automática.
+ * 		- La comparación de direcciones se realiza por hardware: mientras el nodo no esté direccionado, los datos con
+ * 		el noveno bit en 0 y las direcciones ajenas se descartan sin generar interrupciones.
+ * 		.
+ *
+ * Al recibir la dirección propia, la librería deja de filtrar y entrega al callback de recepción la dirección (con
+ * el noveno bit en 1, ver @ref HAL_USART_RS485_ADDRESS_FLAG) y los datos siguientes. Si luego se recibe otra
+ * dirección, el filtrado por hardware se rehabilita automáticamente. La aplicación puede rehabilitarlo antes, al
+ * terminar de procesar un mensaje, mediante @ref hal_usart_rs485_listen.
+ *
+ * El dato de dirección de una trama saliente se envía con @ref hal_usart_rs485_tx_address y los datos con
+ * @ref hal_usart_tx_data. Antes de responder, el nodo debe esperar a que el emisor libere el bus; la función
+ * @ref hal_usart_rs485_tx_idle permite a su vez saber cuándo terminó la transmisión propia.
+ *
+ * Cada instancia lleva contadores de tráfico (@ref hal_usart_rs485_stats_t), que se obtienen con
+ * @ref hal_usart_rs485_stats_get.
+ *
+ * @note El receptor del transceptor debe inhabilitarse durante la transmisión (terminales *RE* y *DE* unidos), de lo
+ * contrario el nodo recibe sus propios datos.
+ *
+ * # Recepción de tramas delimitadas por silencio
+ *
+ * Los protocolos del estilo de *Modbus RTU* delimitan las tramas con un silencio en la línea (3.5 caracteres en el
+ * caso de *Modbus RTU*). La función @ref hal_usart_rx_idle_init configura una instancia para acumular los datos
+ * recibidos en un buffer y llamar al callback una única vez por trama, en lugar de una vez por dato.
+ *
+ * El silencio se mide con un canal del *MRT* en modo *one-shot*, que se recarga con cada dato recibido. Al vencer
+ * el canal, si la línea sigue inactiva (flag *RXIDLE*), la trama se da por terminada; si en cambio hay un caracter
+ * en curso, el silencio se interrumpió y la trama continúa. El tiempo de silencio se configura en tiempos de bit,
+ * por lo que no depende del baudrate; la macro @ref HAL_USART_RX_IDLE_MODBUS_BITS calcula los 3.5 caracteres de
+ * *Modbus RTU*.
+ *
+ * Si la instancia está además en modo RS-485, la trama comienza con la dirección propia y termina con el silencio
+ * o con la recepción de una dirección ajena.
+ *
+ * El canal del *MRT* se reserva mediante @ref hal_mrt_channel_claim, por lo que la configuración falla si el canal
+ * está en uso por otra instancia o por otro módulo (por ejemplo, el canal 3 durante la medición de latencia de
+ * @ref hal_nvic_latency_probe_start). La aplicación puede seguir utilizando los canales que no reservó.
+ *
  * @{
  */
 
@@ -215,6 +285,7 @@ typedef enum
 	HAL_USART_OVERSAMPLING_X14, /**< Oversampling x14 */
 	HAL_USART_OVERSAMPLING_X15, /**< Oversampling x15 */
 	HAL_USART_OVERSAMPLING_X16, /**< Oversampling x16 */
+	HAL_USART_OVERSAMPLING_AUTO /**< Oversampling, BRGVAL y FRG calculados por @ref hal_usart_baud_config */
 }hal_usart_oversampling_en;
 
 /** Resultado de un intento de inicio de transmisión */
@@ -231,6 +302,96 @@ typedef enum
 	HAL_USART_RX_RESULT_NOT_READY /**< Resultado de recepción no exitoso, no se había recibido ningún dato */
 }hal_usart_rx_result;
 
+/** Resultado del cálculo de baudrate */
+typedef enum
+{
+	HAL_USART_BAUD_RESULT_OK = 0, /**< Configuración obtenida dentro del error máximo */
+	HAL_USART_BAUD_RESULT_ERROR_TOO_HIGH, /**< El menor error obtenible supera el error máximo */
+	HAL_USART_BAUD_RESULT_INVALID /**< Baudrate o clock de entrada fuera de rango */
+}hal_usart_baud_result_en;
+
+/** Configuración de generación de baudrate */
+typedef struct
+{
+	uint32_t baudrate; /**< Baudrate obtenido */
+	uint32_t error_ppm; /**< Error relativo respecto del baudrate pedido, en partes por millón */
+	uint16_t brgval; /**< Valor del registro *BRG* */
+	hal_usart_oversampling_en oversampling; /**< Oversampling */
+	uint8_t frg_mul; /**< Multiplicador del *FRG*. Cero si no se utiliza un *FRG* */
+}hal_usart_baud_t;
+
+/** Bit que identifica un dato de dirección en el modo RS-485 */
+#define		HAL_USART_RS485_ADDRESS_FLAG		(1 << 8)
+
+/** Polaridad de la señal de habilitación del transmisor RS-485 */
+typedef enum
+{
+	HAL_USART_RS485_OE_ACTIVE_LOW = 0, /**< Transmisor habilitado con nivel bajo */
+	HAL_USART_RS485_OE_ACTIVE_HIGH /**< Transmisor habilitado con nivel alto */
+}hal_usart_rs485_oe_pol_en;
+
+/** Resultado de la configuración del modo RS-485 */
+typedef enum
+{
+	HAL_USART_RS485_RESULT_OK = 0, /**< Configuración exitosa */
+	HAL_USART_RS485_RESULT_NO_OE /**< La instancia no tiene señal *RTS* para habilitar el transmisor */
+}hal_usart_rs485_result_en;
+
+/** Configuración del modo RS-485 */
+typedef struct
+{
+	uint8_t address; /**< Dirección propia del nodo */
+	hal_gpio_portpin_en oe_portpin; /**< Puerto/pin de habilitación del transmisor (*RTS*), o @ref HAL_GPIO_PORTPIN_NOT_USED */
+	hal_usart_rs485_oe_pol_en oe_polarity; /**< Polaridad de la habilitación del transmisor */
+	uint8_t turnaround; /**< Distinto de cero para mantener el transmisor habilitado un caracter luego del último stop */
+}hal_usart_rs485_config_t;
+
+/**
+ * @brief Tipo de dato para los callback de recepción de trama completa
+ *
+ * Recibe la instancia, el buffer con la trama, la cantidad de datos de la trama, un flag distinto de cero si la trama
+ * excedió el tamaño del buffer (en cuyo caso los datos sobrantes fueron descartados) y el dato registrado. El buffer
+ * vuelve a utilizarse para la trama siguiente al retornar el callback. Mientras se ejecuta el callback se posterga
+ * la atención de la recepción de la instancia, por lo que debe durar menos que el tiempo de un caracter.
+ *
+ * @note Estos callbacks son ejecutados desde un contexto de interrupción, por lo que el usuario deberá tener
+ * todas las consideraciones necesarias al respecto.
+ */
+typedef void (*hal_usart_rx_frame_callback)(hal_usart_sel_en, const uint8_t *, uint32_t, uint8_t, void *);
+
+/** Tiempo de silencio entre tramas de *Modbus RTU*, en tiempos de bit, a partir de los bits por caracter */
+#define		HAL_USART_RX_IDLE_MODBUS_BITS(bits_per_char)		(((bits_per_char) * 7) / 2)
+
+/** Resultado de la configuración de la recepción de tramas delimitadas por silencio */
+typedef enum
+{
+	HAL_USART_RX_IDLE_RESULT_OK = 0, /**< Configuración exitosa */
+	HAL_USART_RX_IDLE_RESULT_CHANNEL_BUSY, /**< El canal del *MRT* está en uso por otra instancia u otro módulo */
+	HAL_USART_RX_IDLE_RESULT_INVALID /**< Parámetros inválidos */
+}hal_usart_rx_idle_result_en;
+
+/** Configuración de la recepción de tramas delimitadas por silencio */
+typedef struct
+{
+	uint8_t *buffer; /**< Buffer donde acumular la trama */
+	uint32_t size; /**< Tamaño del buffer. Los datos que excedan el tamaño se descartan y se informa el desborde */
+	uint32_t timeout_bits; /**< Tiempo de silencio que delimita una trama, en tiempos de bit */
+	uint8_t mrt_channel; /**< Canal del *MRT* a utilizar (0 a 3) */
+	hal_usart_rx_frame_callback frame_callback; /**< Callback a ejecutar por cada trama recibida */
+	void *frame_data; /**< Datos a pasar al callback */
+}hal_usart_rx_idle_config_t;
+
+/** Contadores de tráfico del modo RS-485 */
+typedef struct
+{
+	uint32_t rx_frames; /**< Direcciones propias recibidas */
+	uint32_t rx_bytes; /**< Datos recibidos estando direccionado */
+	uint32_t rx_errors; /**< Datos recibidos con error de trama, paridad o ruido */
+	uint32_t foreign_frames; /**< Direcciones ajenas recibidas estando direccionado */
+	uint32_t tx_frames; /**< Direcciones transmitidas */
+	uint32_t tx_bytes; /**< Datos transmitidos */
+}hal_usart_rs485_stats_t;
+
 /**
  * @brief Tipo de dato para los callback en recepción de dato completa.
  * @note Estos callbacks son ejecutados desde un contexto de interrupción, por lo que el usuario deberá tener
@@ -251,7 +412,7 @@ typedef struct
 	hal_usart_datalen_en data_length; /**< Largo en bits de cada dato en la comunicación */
 	hal_usart_parity_en parity; /**< Paridad de la comunicación */
 	hal_usart_stop_en stop_bits; /**< Cantidad de bits de stop de la comunicación */
-	hal_usart_oversampling_en oversampling; /**< Oversampling de la instancia */
+	hal_usart_oversampling_en oversampling; /**< Oversampling de la instancia, o @ref HAL_USART_OVERSAMPLING_AUTO */
 	hal_syscon_peripheral_clock_sel_en clock_selection; /**< Fuente de clock para la instancia */
 	uint32_t baudrate; /**< Baudrate deseado para la comunicación */
 	hal_gpio_portpin_en tx_portpin; /**< Puerto/pin donde configurar las transmisiones */
@@ -319,6 +480,120 @@ void hal_usart_rx_register_callback(hal_usart_sel_en inst, hal_usart_rx_callback
  */
 void hal_usart_tx_register_callback(hal_usart_sel_en inst, hal_usart_tx_callback new_callback, void *cb_data);
 
+/**
+ * @brief Calcular la configuración de menor error para un baudrate
+ *
+ * No modifica ningún registro.
+ *
+ * @param[in] input_clock Frecuencia de entrada en Hz. Si se utiliza un *FRG*, es la frecuencia de entrada del mismo
+ * @param[in] baudrate Baudrate deseado
+ * @param[in] use_frg Distinto de cero para incluir el multiplicador del *FRG* en la búsqueda
+ * @param[out] solution Configuración obtenida
+ * @return @ref HAL_USART_BAUD_RESULT_OK o @ref HAL_USART_BAUD_RESULT_INVALID si no existe ninguna configuración
+ */
+hal_usart_baud_result_en hal_usart_baud_solve(uint32_t input_clock, uint32_t baudrate, uint8_t use_frg, hal_usart_baud_t *solution);
+
+/**
+ * @brief Configurar el baudrate de menor error en una instancia USART
+ *
+ * Utiliza la fuente de clock configurada para la instancia. Si la fuente es un *FRG* que ninguna otra instancia
+ * habilitada utiliza, se reconfigura también su multiplicador; si está compartido, se mantiene su multiplicador y
+ * @p solution informa el actual. La instancia se inhabilita durante la escritura del *FRG*, *OSR* y *BRG*, esperando a que termine
+ * la transmisión en curso, y luego se restaura su estado de habilitación.
+ *
+ * @param[in] inst Instancia a configurar
+ * @param[in] baudrate Baudrate deseado
+ * @param[in] max_error_ppm Error máximo admitido en partes por millón. Si se supera, no se modifica la instancia
+ * @param[out] solution Configuración obtenida. Puede ser NULL
+ * @return Resultado del cálculo
+ * @pre Haber configurado la fuente de clock de la instancia (por ejemplo mediante @ref hal_usart_init)
+ */
+hal_usart_baud_result_en hal_usart_baud_config(hal_usart_sel_en inst, uint32_t baudrate, uint32_t max_error_ppm, hal_usart_baud_t *solution);
+
+/**
+ * @brief Configurar una instancia USART en modo RS-485 multipunto
+ *
+ * Configura datos de 9 bits, la habilitación del transmisor y el filtrado de direcciones por hardware. La instancia
+ * queda esperando su dirección y los contadores de tráfico en cero.
+ *
+ * @param[in] inst Instancia a configurar
+ * @param[in] config Configuración del modo RS-485
+ * @return Resultado de la configuración
+ * @pre Haber inicializado la instancia mediante @ref hal_usart_init con un callback de recepción
+ */
+hal_usart_rs485_result_en hal_usart_rs485_init(hal_usart_sel_en inst, const hal_usart_rs485_config_t *config);
+
+/**
+ * @brief Transmitir un dato de dirección en modo RS-485
+ * @param[in] inst Instancia a utilizar
+ * @param[in] address Dirección del nodo destino
+ * @return Resultado del inicio de la transmisión
+ * @pre Haber configurado la instancia mediante @ref hal_usart_rs485_init
+ */
+hal_usart_tx_result hal_usart_rs485_tx_address(hal_usart_sel_en inst, uint8_t address);
+
+/**
+ * @brief Rehabilitar el filtrado de direcciones por hardware
+ *
+ * Los datos siguientes se descartan hasta recibir nuevamente la dirección propia.
+ *
+ * @param[in] inst Instancia a utilizar
+ */
+void hal_usart_rs485_listen(hal_usart_sel_en inst);
+
+/**
+ * @brief Consultar si el nodo fue direccionado
+ * @param[in] inst Instancia a consultar
+ * @return Distinto de cero si se recibió la dirección propia y no se rehabilitó el filtrado
+ */
+uint8_t hal_usart_rs485_is_addressed(hal_usart_sel_en inst);
+
+/**
+ * @brief Consultar si terminó la transmisión en curso
+ *
+ * Si el *turnaround* está habilitado, el transmisor permanece habilitado un caracter más.
+ *
+ * @param[in] inst Instancia a consultar
+ * @return Distinto de cero si no hay ningún dato transmitiéndose
+ */
+uint8_t hal_usart_rs485_tx_idle(hal_usart_sel_en inst);
+
+/**
+ * @brief Obtener los contadores de tráfico del modo RS-485
+ * @param[in] inst Instancia a consultar
+ * @param[out] stats Contadores
+ */
+void hal_usart_rs485_stats_get(hal_usart_sel_en inst, hal_usart_rs485_stats_t *stats);
+
+/**
+ * @brief Poner en cero los contadores de tráfico del modo RS-485
+ * @param[in] inst Instancia a utilizar
+ */
+void hal_usart_rs485_stats_clear(hal_usart_sel_en inst);
+
+/**
+ * @brief Configurar la recepción de tramas delimitadas por silencio en una instancia USART
+ *
+ * A partir de este llamado, los datos recibidos se acumulan en el buffer y se entregan mediante el callback de
+ * trama, en lugar del callback de recepción de @ref hal_usart_init. El tiempo de silencio se calcula con el
+ * baudrate configurado en ese momento, por lo que la función debe llamarse nuevamente si se cambia el baudrate.
+ *
+ * @param[in] inst Instancia a configurar
+ * @param[in] config Configuración deseada
+ * @return Resultado de la configuración
+ * @pre Haber inicializado la instancia mediante @ref hal_usart_init
+ */
+hal_usart_rx_idle_result_en hal_usart_rx_idle_init(hal_usart_sel_en inst, const hal_usart_rx_idle_config_t *config);
+
+/**
+ * @brief Volver a la recepción de a un dato en una instancia USART
+ *
+ * Se descarta la trama en curso y se libera el canal del *MRT*.
+ *
+ * @param[in] inst Instancia a configurar
+ */
+void hal_usart_rx_idle_deinit(hal_usart_sel_en inst);
+
 #if defined (__cplusplus)
 } // extern "C"
 #endif
@@ -42,8 +42,8 @@
  * @ref hal_wkt_start_count y @ref hal_wkt_start_count_with_value. La diferencia entre una y otra, es que en la
  * primera, la librería pide como argumento un tiempo en microsegundos y hace la cuenta necesaria para aproximarse
  * lo más posible y cargar el conteo adecuado, mientras que la segunda directamente pide el valor a cargar al
- * usuario. Cabe destacar que la primer función, utiliza números con punto flotante, por lo que su ejecución tarda
- * un tiempo considerable, dado que el microcontrolador no tiene unidad de punto flotante de hardware incorporada.
+ * usuario. Cabe destacar que la primer función realiza una división de 64 bits mediante el divisor de hardware
+ * (ver @ref DIV), por lo que su ejecución tarda algo más que la carga directa del valor.
  * El criterio para utilizar una función u otra es:
  * 		- Si los tiempos de conteo son lo suficientemente largos, y/o la presición no es un factor demasiado
  * 		importante (por ejemplo, para salir de un modo de bajo consumo tal vez no sea necesaria una
@@ -135,7 +135,7 @@ void hal_wkt_register_callback(hal_wkt_callback_t new_callback, void *data);
 /**
  * @brief Iniciar el conteo con el WKT en base a un tiempo
  *
- * @note Esta función utiliza variables con punto flotante por lo que tarda un tiempo considerable en ejecutarse.
+ * @note Esta función realiza una división de 64 bits, por lo que tarda más que @ref hal_wkt_start_count_with_value.
  *
  * @param[in] time_useg Tiempo en microsegundos deseado (se redondeará al valor primer posible hacia arriba)
  */
@@ -0,0 +1,169 @@
+/**
+ * @file HAL_WWDT.h
+ * @brief Declaraciones a nivel de aplicacion del periferico WWDT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+/**
+ * @defgroup WATCHDOG Watchdog con ventana (WWDT)
+ *
+ * # Introducción
+ *
+ * El *WWDT* es un contador descendente que, al llegar a cero, resetea el microcontrolador. La aplicación debe
+ * *alimentarlo* periódicamente (recargando el contador) para evitar el reset, de modo que un bloqueo del programa
+ * termina en un reset en lugar de dejar al equipo colgado.
+ *
+ * El contador se excita con el oscilador del watchdog (ver @ref SYSCON) dividido por 4, el cual debe configurarse
+ * mediante @ref hal_syscon_watchdog_oscillator_config antes de inicializar este periférico. Dado que la precisión de
+ * dicho oscilador es de más/menos 40%, los tiempos configurados deben tener un margen acorde.
+ *
+ * @note Una vez habilitado, el watchdog únicamente puede inhabilitarse mediante un reset.
+ *
+ * # Ventana e interrupción de advertencia
+ *
+ * Opcionalmente se puede configurar una *ventana*: alimentar el watchdog antes de que transcurra el tiempo mínimo de
+ * la ventana desde el alimentado anterior también genera un reset. Esto detecta los lazos que, por error, alimentan
+ * al watchdog continuamente.
+ *
+ * La *interrupción de advertencia* se genera un tiempo antes del vencimiento (a lo sumo 1023 cuentas del contador), y
+ * permite guardar información de diagnóstico antes del reset.
+ *
+ * # Supervisión de tareas
+ *
+ * Alimentar el watchdog desde un único punto del programa no detecta el bloqueo de una tarea particular mientras el
+ * resto sigue funcionando. El supervisor mantiene una lista de tareas, cada una con un plazo expresado en períodos de
+ * supervisión: cada tarea indica que está viva mediante @ref hal_wwdt_supervisor_checkin, y
+ * @ref hal_wwdt_supervisor_process (llamada periódicamente, por ejemplo desde el callback del @ref SYSTICK) alimenta
+ * el watchdog únicamente si todas las tareas se reportaron dentro de su plazo.
+ *
+ * Si una tarea excede su plazo, el watchdog deja de alimentarse, y en la interrupción de advertencia se guarda el
+ * número de la tarea en un registro de propósito general del *PMU*, el cual conserva su valor ante el reset del
+ * watchdog. Luego del reset, @ref hal_wwdt_supervisor_last_stall permite leer qué tarea se había bloqueado, sin
+ * necesidad de un depurador.
+ *
+ * Si la ventana está habilitada, el período de supervisión debe ser mayor al tiempo mínimo de la ventana, y en todos
+ * los casos debe ser bastante menor al tiempo de vencimiento.
+ *
+ * @{
+ */
+
+#ifndef HAL_WWDT_H_
+#define HAL_WWDT_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+/** Firma de un registro del supervisor en el registro de propósito general (16 bits superiores) */
+#define		HAL_WWDT_SUPERVISOR_SIGNATURE			0x57440000
+
+/** Número de tarea registrado cuando ninguna tarea excedió su plazo (el supervisor dejó de ejecutarse) */
+#define		HAL_WWDT_SUPERVISOR_NO_TASK				0xFFFF
+
+/** Resultados de las funciones del WWDT */
+typedef enum
+{
+	HAL_WWDT_RESULT_OK = 0, /**< Operación exitosa */
+	HAL_WWDT_RESULT_CLOCK_ERROR, /**< El oscilador del watchdog no fue configurado */
+	HAL_WWDT_RESULT_RANGE_ERROR /**< Tiempos fuera del rango del contador */
+}hal_wwdt_result_en;
+
+/** Callback de la interrupción de advertencia */
+typedef void (*hal_wwdt_warning_callback_t)(void);
+
+/** Configuración del WWDT */
+typedef struct
+{
+	uint32_t timeout_ms; /**< Tiempo desde el alimentado hasta el vencimiento, en milisegundos */
+	uint32_t window_ms; /**< Tiempo mínimo entre alimentados, en milisegundos. Cero para no utilizar ventana */
+	uint32_t warning_ms; /**< Anticipación de la interrupción de advertencia, en milisegundos. Cero para no utilizarla */
+	uint8_t reset; /**< Distinto de cero para resetear al vencer. Si es cero, solo se genera la advertencia */
+	hal_wwdt_warning_callback_t warning_callback; /**< Callback de la advertencia. Puede ser NULL */
+}hal_wwdt_config_t;
+
+/** Tarea supervisada */
+typedef struct
+{
+	uint16_t deadline; /**< Cantidad máxima de períodos de supervisión sin reportarse */
+	uint16_t elapsed; /**< Uso interno */
+	volatile uint8_t checked_in; /**< Uso interno */
+}hal_wwdt_task_t;
+
+/**
+ * @brief Inicializar el WWDT
+ *
+ * Configura los tiempos, habilita el periférico y realiza el primer alimentado, a partir del cual comienza el conteo.
+ *
+ * @param[in] config Configuración deseada
+ * @return Resultado de la operación
+ * @pre Haber configurado el oscilador del watchdog mediante @ref hal_syscon_watchdog_oscillator_config
+ */
+hal_wwdt_result_en hal_wwdt_init(const hal_wwdt_config_t *config);
+
+/**
+ * @brief Alimentar el watchdog
+ *
+ * La secuencia de alimentado se realiza con las interrupciones enmascaradas, ya que un acceso al periférico en medio
+ * de la misma genera un reset.
+ */
+void hal_wwdt_feed(void);
+
+/**
+ * @brief Consultar si el último reset fue causado por el watchdog
+ *
+ * El flag se limpia al consultarlo.
+ *
+ * @return Distinto de cero si el último reset fue causado por el watchdog
+ */
+uint8_t hal_wwdt_reset_caused(void);
+
+/**
+ * @brief Inicializar el supervisor de tareas
+ *
+ * A partir de este llamado, el watchdog solo debe alimentarse mediante @ref hal_wwdt_supervisor_process.
+ *
+ * @param[in] tasks Tareas a supervisar, con sus plazos configurados. Deben permanecer válidas
+ * @param[in] task_amount Cantidad de tareas
+ * @param[in] gpreg Registro de propósito general del *PMU* a utilizar (0 a 3)
+ */
+void hal_wwdt_supervisor_init(hal_wwdt_task_t *tasks, uint16_t task_amount, uint8_t gpreg);
+
+/**
+ * @brief Reportar que una tarea está viva
+ *
+ * Puede llamarse desde interrupciones.
+ *
+ * @param[in] task Número de tarea (índice en el arreglo de tareas)
+ */
+void hal_wwdt_supervisor_checkin(uint16_t task);
+
+/**
+ * @brief Procesar un período de supervisión
+ * @return Distinto de cero si todas las tareas están dentro de su plazo y se alimentó el watchdog
+ */
+uint8_t hal_wwdt_supervisor_process(void);
+
+/**
+ * @brief Obtener la tarea bloqueada registrada antes del último reset
+ *
+ * El registro se limpia al consultarlo.
+ *
+ * @param[in] gpreg Registro de propósito general del *PMU* utilizado por el supervisor (0 a 3)
+ * @param[out] task Número de tarea bloqueada, o @ref HAL_WWDT_SUPERVISOR_NO_TASK
+ * @return Distinto de cero si había un registro del supervisor
+ */
+uint8_t hal_wwdt_supervisor_last_stall(uint8_t gpreg, uint16_t *task);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HAL_WWDT_H_ */
+
+/**
+ * @}
+ */
@@ -69,6 +69,21 @@ static inline void ACMP_voltage_input_select(ACMP_input_voltage_sel_en in_positi
 	ACMP->CTRL.COMP_VM_SEL = in_negative;
 }
 
+static inline ACMP_input_voltage_sel_en ACMP_positive_input_get(void)
+{
+	return (ACMP_input_voltage_sel_en) ACMP->CTRL.COMP_VP_SEL;
+}
+
+static inline ACMP_input_voltage_sel_en ACMP_negative_input_get(void)
+{
+	return (ACMP_input_voltage_sel_en) ACMP->CTRL.COMP_VM_SEL;
+}
+
+static inline void ACMP_edge_select(ACMP_edge_sel_en edge_sel)
+{
+	ACMP->CTRL.EDGESEL = edge_sel;
+}
+
 static inline void ACMP_interrupt_clear(void)
 {
 	ACMP->CTRL.EDGECLR = 1;
@@ -95,6 +110,11 @@ static inline void ACMP_interrupt_disable(void)
 	ACMP->CTRL.INTENA = 0;
 }
 
+static inline uint8_t ACMP_interrupt_enabled_get(void)
+{
+	return ACMP->CTRL.INTENA;
+}
+
 static inline uint8_t ACMP_edge_detected_get(void)
 {
 	return ACMP->CTRL.COMPEDGE;
@@ -110,6 +130,11 @@ static inline void ACMP_ladder_disable(void)
 	ACMP->LAD.LADEN = 0;
 }
 
+static inline uint8_t ACMP_ladder_enabled_get(void)
+{
+	return ACMP->LAD.LADEN;
+}
+
 static inline void ACMP_ladder_step_set(uint8_t ladder_step)
 {
 	ACMP->LAD.LADSEL = ladder_step;
@@ -127,7 +152,7 @@ static inline void ACMP_ladder_vref_select(ACMP_ladder_vref_sel_en vref)
 
 static inline ACMP_ladder_vref_sel_en ACMP_voltage_ladder_vref_get(void)
 {
-	return ACMP->LAD.LADREF;
+	return (ACMP_ladder_vref_sel_en) ACMP->LAD.LADREF;
 }
 
 #if defined (__cplusplus)
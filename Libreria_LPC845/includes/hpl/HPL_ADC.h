@@ -227,7 +227,7 @@ static inline void ADC_sequence_set_start(ADC_sequence_sel_en sequence)
  */
 static inline void ADC_sequence_set_burst(ADC_sequence_sel_en sequence)
 {
-	ADC_SEQ_CTRL_reg_t adc_sec_ctrl = ADC->SEQ_CTRL[sequence];
+	ADC_SEQ_CTRL_reg_t adc_sec_ctrl = *((ADC_SEQ_CTRL_reg_t *) &ADC->SEQ_CTRL[sequence]);
 
 	adc_sec_ctrl.BURST = 1;
 	adc_sec_ctrl.SEQ_ENA = 1;
@@ -296,7 +296,7 @@ static inline void ADC_sequence_config_interrupt_mode(ADC_sequence_sel_en sequen
  */
 static inline ADC_interrupt_mode_en ADC_sequence_get_mode(ADC_sequence_sel_en sequence)
 {
-	return ADC->SEQ_CTRL[sequence].MODE;
+	return (ADC_interrupt_mode_en) ADC->SEQ_CTRL[sequence].MODE;
 }
 
 /**
@@ -487,14 +487,19 @@ static inline void ADC_set_vrange(ADC_vrange_sel_en vrange)
 
 /**
  * @brief Realizacion de calibracion de hardware
- * @param[in] div Divisor utilizado para lograr los 500KHz de clock
+ *
+ * La calibracion se realiza en modo sincronico, ya que en modo asincronico el divisor no tiene efecto. El registro
+ * de control se restaura al finalizar.
+ *
+ * @param[in] div Divisor del clock del sistema utilizado para lograr los 500KHz de clock
  */
 static inline void ADC_hardware_calib(uint8_t div)
 {
-	ADC_CTRL_reg_t adc_ctrl_original = ADC->CTRL;
-	ADC_CTRL_reg_t adc_ctrl_aux = ADC->CTRL;
+	ADC_CTRL_reg_t adc_ctrl_original = *((ADC_CTRL_reg_t *) &ADC->CTRL);
+	ADC_CTRL_reg_t adc_ctrl_aux = *((ADC_CTRL_reg_t *) &ADC->CTRL);
 
 	adc_ctrl_aux.CLKDIV = div;
+	adc_ctrl_aux.ASYNCMODE = 0;
 	adc_ctrl_aux.CALMODE = 1;
 	adc_ctrl_aux.LPWRMODE = 0;
 
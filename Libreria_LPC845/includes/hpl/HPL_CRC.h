@@ -0,0 +1,109 @@
+/**
+ * @file HPL_CRC.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del CRC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_CRC_H_
+#define HPL_CRC_H_
+
+#include "HRI_CRC.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile CRC_per_t * const CRC; //!< Periferico CRC
+
+typedef enum
+{
+	CRC_POLYNOMIAL_CCITT = 0,
+	CRC_POLYNOMIAL_CRC16,
+	CRC_POLYNOMIAL_CRC32
+}CRC_polynomial_en;
+
+/**
+ * @brief Configurar el modo del CRC en una unica escritura
+ * @param[in] polynomial Polinomio a utilizar
+ * @param[in] reverse_input Distinto de cero para invertir el orden de los bits de cada byte escrito
+ * @param[in] complement_input Distinto de cero para complementar los datos escritos
+ * @param[in] reverse_output Distinto de cero para invertir el orden de los bits del resultado
+ * @param[in] complement_output Distinto de cero para complementar el resultado
+ */
+static inline void CRC_set_mode(CRC_polynomial_en polynomial, uint8_t reverse_input, uint8_t complement_input, uint8_t reverse_output, uint8_t complement_output)
+{
+	CRC_MODE_reg_t mode = { 0 };
+
+	mode.CRC_POLY = polynomial;
+	mode.BIT_RVS_WR = (reverse_input != 0);
+	mode.CMPL_WR = (complement_input != 0);
+	mode.BIT_RVS_SUM = (reverse_output != 0);
+	mode.CMPL_SUM = (complement_output != 0);
+
+	CRC->MODE = mode;
+}
+
+/**
+ * @brief Configurar la semilla (reinicia el calculo)
+ * @param[in] seed Semilla deseada
+ */
+static inline void CRC_set_seed(uint32_t seed)
+{
+	CRC->SEED = seed;
+}
+
+/**
+ * @brief Obtener el resultado del calculo
+ * @return Resultado, con las opciones de salida aplicadas
+ */
+static inline uint32_t CRC_get_sum(void)
+{
+	return CRC->SUM;
+}
+
+/**
+ * @brief Escribir un dato de 8 bits
+ * @param[in] data Dato a escribir
+ */
+static inline void CRC_write_data_8(uint8_t data)
+{
+	*((volatile uint8_t *) &CRC->SUM) = data;
+}
+
+/**
+ * @brief Escribir un dato de 16 bits
+ * @param[in] data Dato a escribir
+ */
+static inline void CRC_write_data_16(uint16_t data)
+{
+	*((volatile uint16_t *) &CRC->SUM) = data;
+}
+
+/**
+ * @brief Escribir un dato de 32 bits
+ *
+ * Los bytes se procesan en el orden en que se encuentran en memoria (el menos significativo primero).
+ *
+ * @param[in] data Dato a escribir
+ */
+static inline void CRC_write_data_32(uint32_t data)
+{
+	CRC->SUM = data;
+}
+
+/**
+ * @brief Obtener la direccion del registro de datos (destino de transferencias por DMA)
+ * @return Direccion del registro de datos
+ */
+static inline volatile uint32_t *CRC_get_data_address(void)
+{
+	return &CRC->SUM;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_CRC_H_ */
@@ -39,6 +39,16 @@ static inline void DAC_write(DAC_sel_en dac, uint16_t new_value)
 	DAC[dac]->CR.VALUE = new_value;
 }
 
+/**
+ * @brief Lectura del valor actual del DAC
+ * @param[in] dac Instancia a leer
+ * @return Valor actual del DAC
+ */
+static inline uint16_t DAC_read(DAC_sel_en dac)
+{
+	return DAC[dac]->CR.VALUE;
+}
+
 /**
  * @brief Configuracion del settling time del DAC
  * @param[in] dac Instancia a configurar
@@ -67,6 +77,16 @@ static inline void DAC_disable_DMA_request(DAC_sel_en dac)
 	DAC[dac]->CTRL.INT_DMA_REQ = 0;
 }
 
+/**
+ * @brief Obtener el flag de timeout del timer
+ * @param[in] dac Instancia a consultar
+ * @return Si el timer llego a cero desde la ultima escritura del DAC devuelve 1, caso contrario devuelve 0
+ */
+static inline uint8_t DAC_get_timer_flag(DAC_sel_en dac)
+{
+	return DAC[dac]->CTRL.INT_DMA_REQ;
+}
+
 /**
  * @brief Habilitar double buffering
  * @param[in] dac Instancia a configurar
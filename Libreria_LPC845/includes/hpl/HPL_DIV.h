@@ -0,0 +1,74 @@
+/**
+ * @file HPL_DIV.h
+ * @brief Declaraciones a nivel de abstraccion de periferico de las rutinas de división en ROM (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_DIV_H_
+#define HPL_DIV_H_
+
+#include "HRI_DIV.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern const DIV_rom_driver_table_t * const * const DIV_ROM_DRIVER_TABLE; //!< Tabla de drivers en ROM
+
+/**
+ * @brief Division sin signo mediante la rutina en ROM
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente
+ */
+static inline uint32_t DIV_unsigned(uint32_t numerator, uint32_t denominator)
+{
+	return (*DIV_ROM_DRIVER_TABLE)->DIV_API->uidiv(numerator, denominator);
+}
+
+/**
+ * @brief Division con signo mediante la rutina en ROM
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente
+ */
+static inline int32_t DIV_signed(int32_t numerator, int32_t denominator)
+{
+	return (*DIV_ROM_DRIVER_TABLE)->DIV_API->sidiv(numerator, denominator);
+}
+
+/**
+ * @brief Division sin signo con resto mediante la rutina en ROM
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente y resto
+ */
+static inline DIV_unsigned_result_t DIV_unsigned_divmod(uint32_t numerator, uint32_t denominator)
+{
+	uint64_t packed = (*DIV_ROM_DRIVER_TABLE)->DIV_API->uidivmod(numerator, denominator);
+	DIV_unsigned_result_t result = { .quot = (uint32_t) packed, .rem = (uint32_t) (packed >> 32) };
+
+	return result;
+}
+
+/**
+ * @brief Division con signo con resto mediante la rutina en ROM
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente y resto
+ */
+static inline DIV_signed_result_t DIV_signed_divmod(int32_t numerator, int32_t denominator)
+{
+	uint64_t packed = (*DIV_ROM_DRIVER_TABLE)->DIV_API->sidivmod(numerator, denominator);
+	DIV_signed_result_t result = { .quot = (int32_t) (uint32_t) packed, .rem = (int32_t) (uint32_t) (packed >> 32) };
+
+	return result;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_DIV_H_ */
@@ -0,0 +1,185 @@
+/**
+ * @file HPL_DMA.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del DMA (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_DMA_H_
+#define HPL_DMA_H_
+
+#include "HRI_DMA.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile DMA_per_t * const DMA; //!< Periferico DMA
+
+extern DMA_descriptor_t DMA_DESCRIPTOR_TABLE[DMA_CHANNEL_AMOUNT]; //!< Tabla de descriptores de canal
+
+/** Cantidad maxima de transferencias por descriptor */
+#define		DMA_MAX_TRANSFER_COUNT		1024
+
+typedef enum
+{
+	DMA_WIDTH_8_BITS = 0,
+	DMA_WIDTH_16_BITS,
+	DMA_WIDTH_32_BITS
+}DMA_width_en;
+
+typedef enum
+{
+	DMA_INCREMENT_NONE = 0,
+	DMA_INCREMENT_1_WIDTH,
+	DMA_INCREMENT_2_WIDTHS,
+	DMA_INCREMENT_4_WIDTHS
+}DMA_increment_en;
+
+/**
+ * @brief Habilitar el controlador de DMA
+ */
+static inline void DMA_enable(void)
+{
+	DMA->CTRL.ENABLE = 1;
+}
+
+/**
+ * @brief Inhabilitar el controlador de DMA
+ */
+static inline void DMA_disable(void)
+{
+	DMA->CTRL.ENABLE = 0;
+}
+
+/**
+ * @brief Consultar si el controlador de DMA esta habilitado
+ * @return Distinto de cero si esta habilitado
+ */
+static inline uint8_t DMA_is_enabled(void)
+{
+	return DMA->CTRL.ENABLE;
+}
+
+/**
+ * @brief Configurar la direccion de la tabla de descriptores de canal
+ * @param[in] table Tabla de descriptores (alineada a 512 bytes)
+ */
+static inline void DMA_set_descriptor_table(const DMA_descriptor_t *table)
+{
+	DMA->SRAMBASE = (uint32_t) table;
+}
+
+/**
+ * @brief Habilitar un canal
+ * @param[in] channel Canal a habilitar
+ */
+static inline void DMA_enable_channel(uint8_t channel)
+{
+	DMA->ENABLESET0 = (1UL << channel);
+}
+
+/**
+ * @brief Inhabilitar un canal
+ * @param[in] channel Canal a inhabilitar
+ */
+static inline void DMA_disable_channel(uint8_t channel)
+{
+	DMA->ENABLECLR0 = (1UL << channel);
+}
+
+/**
+ * @brief Consultar si un canal esta activo (disparado y con descriptores pendientes)
+ * @param[in] channel Canal a consultar
+ * @return Distinto de cero si el canal esta activo
+ */
+static inline uint8_t DMA_get_channel_active(uint8_t channel)
+{
+	return (DMA->ACTIVE0 >> channel) & 1;
+}
+
+/**
+ * @brief Consultar si un canal esta realizando una transferencia
+ * @param[in] channel Canal a consultar
+ * @return Distinto de cero si el canal esta ocupado
+ */
+static inline uint8_t DMA_get_channel_busy(uint8_t channel)
+{
+	return (DMA->BUSY0 >> channel) & 1;
+}
+
+/**
+ * @brief Consultar el flag de error de un canal
+ * @param[in] channel Canal a consultar
+ * @return Distinto de cero si ocurrio un error
+ */
+static inline uint8_t DMA_get_channel_error(uint8_t channel)
+{
+	return (DMA->ERRINT0 >> channel) & 1;
+}
+
+/**
+ * @brief Limpiar el flag de error de un canal
+ * @param[in] channel Canal a limpiar
+ */
+static inline void DMA_clear_channel_error(uint8_t channel)
+{
+	DMA->ERRINT0 = (1UL << channel);
+}
+
+/**
+ * @brief Abortar la transferencia de un canal
+ * @param[in] channel Canal a abortar
+ * @pre El canal debe estar inhabilitado
+ */
+static inline void DMA_abort_channel(uint8_t channel)
+{
+	DMA->ABORT0 = (1UL << channel);
+}
+
+/**
+ * @brief Configurar un canal para transferencias disparadas por software (memoria a memoria)
+ * @param[in] channel Canal a configurar
+ * @param[in] priority Prioridad del canal (0 es la mayor, 7 la menor)
+ */
+static inline void DMA_config_channel_software_trigger(uint8_t channel, uint8_t priority)
+{
+	DMA_CFG_reg_t cfg = { 0 };
+
+	cfg.CHPRIORITY = priority;
+
+	DMA->CHANNEL[channel].CFG = cfg;
+}
+
+/**
+ * @brief Configurar y disparar una transferencia de un unico descriptor, sin recarga ni interrupciones
+ *
+ * El descriptor del canal en la tabla debe contener las direcciones finales de origen y destino.
+ *
+ * @param[in] channel Canal a utilizar
+ * @param[in] width Ancho de cada transferencia
+ * @param[in] source_increment Incremento de la direccion de origen
+ * @param[in] dest_increment Incremento de la direccion de destino
+ * @param[in] count Cantidad de transferencias (1 a @ref DMA_MAX_TRANSFER_COUNT)
+ */
+static inline void DMA_start_channel_software_transfer(uint8_t channel, DMA_width_en width, DMA_increment_en source_increment, DMA_increment_en dest_increment, uint16_t count)
+{
+	DMA_XFERCFG_reg_t xfercfg = { 0 };
+
+	xfercfg.CFGVALID = 1;
+	xfercfg.SWTRIG = 1;
+	xfercfg.CLRTRIG = 1;
+	xfercfg.WIDTH = width;
+	xfercfg.SRCINC = source_increment;
+	xfercfg.DSTINC = dest_increment;
+	xfercfg.XFERCOUNT = count - 1;
+
+	DMA->CHANNEL[channel].XFERCFG = xfercfg;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_DMA_H_ */
@@ -0,0 +1,52 @@
+/**
+ * @file HPL_IAP.h
+ * @brief Declaraciones a nivel de abstraccion de periferico de las rutinas de programacion en aplicacion (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_IAP_H_
+#define HPL_IAP_H_
+
+#include "HRI_IAP.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern const IAP_entry_t IAP_ENTRY; //!< Punto de entrada de las rutinas IAP
+
+typedef enum
+{
+	IAP_COMMAND_PREPARE_SECTORS = 50,
+	IAP_COMMAND_COPY_RAM_TO_FLASH,
+	IAP_COMMAND_ERASE_SECTORS,
+	IAP_COMMAND_BLANK_CHECK_SECTORS,
+	IAP_COMMAND_READ_PART_ID,
+	IAP_COMMAND_READ_BOOT_CODE_VERSION,
+	IAP_COMMAND_COMPARE,
+	IAP_COMMAND_REINVOKE_ISP,
+	IAP_COMMAND_READ_UID,
+	IAP_COMMAND_ERASE_PAGES
+}IAP_command_en;
+
+/**
+ * @brief Ejecutar un comando IAP
+ *
+ * El comando se ejecuta en forma sincronica: la rutina en ROM retorna una vez finalizada la operacion sobre la
+ * flash.
+ *
+ * @param[in] command Comando y sus parametros (@ref IAP_COMMAND_LENGTH palabras)
+ * @param[out] result Codigo de estado y resultados (@ref IAP_RESULT_LENGTH palabras)
+ */
+static inline void IAP_execute(uint32_t *command, uint32_t *result)
+{
+	IAP_ENTRY(command, result);
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_IAP_H_ */
@@ -0,0 +1,303 @@
+/**
+ * @file HPL_IIC.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del IIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_IIC_H_
+#define HPL_IIC_H_
+
+#include "HRI_IIC.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile IIC_per_t * const IIC[]; //!< Perifericos IIC
+
+typedef enum
+{
+	IIC_MASTER_STATE_IDLE = 0,
+	IIC_MASTER_STATE_RX_READY,
+	IIC_MASTER_STATE_TX_READY,
+	IIC_MASTER_STATE_NACK_ADDRESS,
+	IIC_MASTER_STATE_NACK_DATA
+}IIC_master_state_en;
+
+typedef enum
+{
+	IIC_SLAVE_STATE_ADDRESS = 0,
+	IIC_SLAVE_STATE_RX,
+	IIC_SLAVE_STATE_TX
+}IIC_slave_state_en;
+
+/** Flags de status que se limpian escribiendo un 1 (el valor es la posicion del bit) */
+typedef enum
+{
+	IIC_STATUS_FLAG_MSTARBLOSS = 4,
+	IIC_STATUS_FLAG_MSTSTSTPERR = 6,
+	IIC_STATUS_FLAG_SLVDESEL = 15,
+	IIC_STATUS_FLAG_MONOV = 17,
+	IIC_STATUS_FLAG_MONIDLE = 19,
+	IIC_STATUS_FLAG_EVENTTIMEOUT = 24,
+	IIC_STATUS_FLAG_SCLTIMEOUT = 25
+}IIC_status_flag_en;
+
+/** Interrupciones (el valor es la posicion del bit) */
+typedef enum
+{
+	IIC_IRQ_MSTPENDING = 0,
+	IIC_IRQ_MSTARBLOSS = 4,
+	IIC_IRQ_MSTSTSTPERR = 6,
+	IIC_IRQ_SLVPENDING = 8,
+	IIC_IRQ_SLVNOTSTR = 11,
+	IIC_IRQ_SLVDESEL = 15,
+	IIC_IRQ_MONRDY = 16,
+	IIC_IRQ_MONOV = 17,
+	IIC_IRQ_MONIDLE = 19,
+	IIC_IRQ_EVENTTIMEOUT = 24,
+	IIC_IRQ_SCLTIMEOUT = 25
+}IIC_irq_sel_en;
+
+/**
+ * @brief Habilitar modo master
+ * @param[in] inst Instancia a configurar
+ */
+static inline void IIC_enable_master_mode(uint8_t inst)
+{
+	IIC[inst]->CFG.MSTEN = 1;
+}
+
+/**
+ * @brief Inhabilitar modo master
+ * @param[in] inst Instancia a configurar
+ */
+static inline void IIC_disable_master_mode(uint8_t inst)
+{
+	IIC[inst]->CFG.MSTEN = 0;
+}
+
+/**
+ * @brief Habilitar modo slave
+ * @param[in] inst Instancia a configurar
+ */
+static inline void IIC_enable_slave_mode(uint8_t inst)
+{
+	IIC[inst]->CFG.SLVEN = 1;
+}
+
+/**
+ * @brief Inhabilitar modo slave
+ * @param[in] inst Instancia a configurar
+ */
+static inline void IIC_disable_slave_mode(uint8_t inst)
+{
+	IIC[inst]->CFG.SLVEN = 0;
+}
+
+/**
+ * @brief Configurar divisor de clock
+ * @param[in] inst Instancia a configurar
+ * @param[in] div Divisor deseado (el valor efectivo es este valor +1)
+ */
+static inline void IIC_set_clock_div(uint8_t inst, uint16_t div)
+{
+	IIC[inst]->CLKDIV.DIVVAL = div;
+}
+
+/**
+ * @brief Configurar duracion de los estados bajo y alto de SCL en modo master
+ * @param[in] inst Instancia a configurar
+ * @param[in] low Ciclos de clock del estado bajo menos 2 (0 a 7)
+ * @param[in] high Ciclos de clock del estado alto menos 2 (0 a 7)
+ */
+static inline void IIC_set_master_scl_time(uint8_t inst, uint8_t low, uint8_t high)
+{
+	IIC[inst]->MSTTIME.MSTSCLLOW = low;
+	IIC[inst]->MSTTIME.MSTSCLHIGH = high;
+}
+
+/**
+ * @brief Leer todos los flags de status en una unica lectura
+ * @param[in] inst Instancia a consultar
+ * @return Registro de status
+ */
+static inline IIC_STAT_reg_t IIC_get_status(uint8_t inst)
+{
+	return *((IIC_STAT_reg_t *) &IIC[inst]->STAT);
+}
+
+/**
+ * @brief Limpiar un flag de status
+ *
+ * Se escribe el registro completo, ya que una escritura de campo de bits leeria y volveria a escribir los demas flags,
+ * limpiandolos tambien.
+ *
+ * @param[in] inst Instancia a limpiar
+ * @param[in] flag Flag a limpiar
+ */
+static inline void IIC_clear_status_flag(uint8_t inst, IIC_status_flag_en flag)
+{
+	*((volatile uint32_t *) &IIC[inst]->STAT) = (1UL << flag);
+}
+
+/**
+ * @brief Habilitar una interrupcion
+ * @param[in] inst Instancia a configurar
+ * @param[in] irq Interrupcion a habilitar
+ */
+static inline void IIC_enable_irq(uint8_t inst, IIC_irq_sel_en irq)
+{
+	*((volatile uint32_t *) &IIC[inst]->INTENSET) = (1UL << irq);
+}
+
+/**
+ * @brief Inhabilitar una interrupcion
+ * @param[in] inst Instancia a configurar
+ * @param[in] irq Interrupcion a inhabilitar
+ */
+static inline void IIC_disable_irq(uint8_t inst, IIC_irq_sel_en irq)
+{
+	*((volatile uint32_t *) &IIC[inst]->INTENCLR) = (1UL << irq);
+}
+
+/**
+ * @brief Leer el estado de una interrupcion habilitada
+ * @param[in] inst Instancia a consultar
+ * @param[in] irq Interrupcion a consultar
+ * @return Distinto de cero si la interrupcion esta habilitada y pendiente
+ */
+static inline uint8_t IIC_get_irq_flag_status(uint8_t inst, IIC_irq_sel_en irq)
+{
+	return (*((volatile const uint32_t *) &IIC[inst]->INTSTAT) >> irq) & 1;
+}
+
+/**
+ * @brief Escribir dato a transmitir en modo master
+ * @param[in] inst Instancia a utilizar
+ * @param[in] data Dato a transmitir
+ */
+static inline void IIC_master_write_data(uint8_t inst, uint8_t data)
+{
+	IIC[inst]->MSTDAT.DATA = data;
+}
+
+/**
+ * @brief Leer dato recibido en modo master
+ * @param[in] inst Instancia a utilizar
+ * @return Dato recibido
+ */
+static inline uint8_t IIC_master_read_data(uint8_t inst)
+{
+	return IIC[inst]->MSTDAT.DATA;
+}
+
+/**
+ * @brief Continuar la transaccion en modo master
+ *
+ * Los bits de control se escriben en una unica escritura del registro completo.
+ *
+ * @param[in] inst Instancia a utilizar
+ */
+static inline void IIC_master_continue(uint8_t inst)
+{
+	*((volatile uint32_t *) &IIC[inst]->MSTCTL) = (1UL << 0);
+}
+
+/**
+ * @brief Generar una condicion de start (o start repetido) en modo master
+ * @param[in] inst Instancia a utilizar
+ * @pre Haber escrito la direccion del slave y el bit de direccion en el registro de datos
+ */
+static inline void IIC_master_start(uint8_t inst)
+{
+	*((volatile uint32_t *) &IIC[inst]->MSTCTL) = (1UL << 1);
+}
+
+/**
+ * @brief Generar una condicion de stop en modo master
+ * @param[in] inst Instancia a utilizar
+ */
+static inline void IIC_master_stop(uint8_t inst)
+{
+	*((volatile uint32_t *) &IIC[inst]->MSTCTL) = (1UL << 2);
+}
+
+/**
+ * @brief Escribir dato a transmitir en modo slave
+ * @param[in] inst Instancia a utilizar
+ * @param[in] data Dato a transmitir
+ */
+static inline void IIC_slave_write_data(uint8_t inst, uint8_t data)
+{
+	IIC[inst]->SLVDAT.DATA = data;
+}
+
+/**
+ * @brief Leer dato recibido (o direccion) en modo slave
+ * @param[in] inst Instancia a utilizar
+ * @return Dato recibido
+ */
+static inline uint8_t IIC_slave_read_data(uint8_t inst)
+{
+	return IIC[inst]->SLVDAT.DATA;
+}
+
+/**
+ * @brief Continuar la transaccion en modo slave (reconocer la direccion o el dato)
+ * @param[in] inst Instancia a utilizar
+ */
+static inline void IIC_slave_continue(uint8_t inst)
+{
+	*((volatile uint32_t *) &IIC[inst]->SLVCTL) = (1UL << 0);
+}
+
+/**
+ * @brief No reconocer la direccion o el dato en modo slave
+ * @param[in] inst Instancia a utilizar
+ */
+static inline void IIC_slave_nack(uint8_t inst)
+{
+	*((volatile uint32_t *) &IIC[inst]->SLVCTL) = (1UL << 1);
+}
+
+/**
+ * @brief Configurar una direccion de slave
+ * @param[in] inst Instancia a configurar
+ * @param[in] index Indice de la direccion (0 a 3)
+ * @param[in] address Direccion de 7 bits
+ */
+static inline void IIC_set_slave_address(uint8_t inst, uint8_t index, uint8_t address)
+{
+	IIC[inst]->SLVADR[index].SLVADR = address;
+	IIC[inst]->SLVADR[index].SADISABLE = 0;
+}
+
+/**
+ * @brief Inhabilitar una direccion de slave
+ * @param[in] inst Instancia a configurar
+ * @param[in] index Indice de la direccion (0 a 3)
+ */
+static inline void IIC_disable_slave_address(uint8_t inst, uint8_t index)
+{
+	IIC[inst]->SLVADR[index].SADISABLE = 1;
+}
+
+/**
+ * @brief Configurar la mascara de la direccion de slave 0
+ * @param[in] inst Instancia a configurar
+ * @param[in] mask Bits de la direccion de 7 bits que se ignoran en la comparacion
+ */
+static inline void IIC_set_slave_address_0_mask(uint8_t inst, uint8_t mask)
+{
+	IIC[inst]->SLVQUAL0.QUALMODE0 = 0;
+	IIC[inst]->SLVQUAL0.SLVQUAL0 = mask;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_IIC_H_ */
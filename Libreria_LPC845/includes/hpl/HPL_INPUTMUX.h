@@ -0,0 +1,46 @@
+/**
+ * @file HPL_INPUTMUX.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del multiplexor de entradas (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_INPUTMUX_H_
+#define HPL_INPUTMUX_H_
+
+#include "HRI_INPUTMUX.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile INPUTMUX_per_t * const INPUTMUX; //!< Multiplexor de entradas
+
+typedef enum
+{
+	INPUTMUX_SCT_INPUT_SEL_SCT_PIN0 = 0,
+	INPUTMUX_SCT_INPUT_SEL_SCT_PIN1,
+	INPUTMUX_SCT_INPUT_SEL_SCT_PIN2,
+	INPUTMUX_SCT_INPUT_SEL_SCT_PIN3,
+	INPUTMUX_SCT_INPUT_SEL_ADC_THCMP_IRQ,
+	INPUTMUX_SCT_INPUT_SEL_ACMP_O,
+	INPUTMUX_SCT_INPUT_SEL_ARM_TXEV,
+	INPUTMUX_SCT_INPUT_SEL_DEBUG_HALTED
+}INPUTMUX_sct_input_sel_en;
+
+/**
+ * @brief Seleccionar la fuente de una entrada del SCT
+ * @param[in] input Entrada del SCT (0 a 3)
+ * @param[in] source Fuente a conectar
+ */
+static inline void INPUTMUX_set_sct_input(uint8_t input, INPUTMUX_sct_input_sel_en source)
+{
+	INPUTMUX->SCT_INMUX[input].INP = source;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_INPUTMUX_H_ */
@@ -74,6 +74,20 @@ static inline void IOCON_deinit(void)
 	SYSCON_disable_clock(SYSCON_ENABLE_CLOCK_SEL_IOCON);
 }
 
+/**
+ * @brief Escribir un conjunto de campos del registro de configuracion de un pin
+ * @param[in] port Numero de puerto
+ * @param[in] pin Numero de pin
+ * @param[in] mask Mascara de los bits a escribir
+ * @param[in] value Valor de los bits a escribir
+ */
+static inline void IOCON_write_masked(uint8_t port, uint8_t pin, uint32_t mask, uint32_t value)
+{
+	volatile uint32_t *reg = (volatile uint32_t *) IOCON_PIN_TABLE[port][pin];
+
+	*reg = (*reg & ~mask) | (value & mask);
+}
+
 /**
  * @brief Configurar modo de funcionamiento (pull up, pull down, etc) en un pin
  * @param[in] port Numero de puerto
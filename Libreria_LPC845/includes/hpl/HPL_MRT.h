@@ -39,7 +39,7 @@ typedef enum
  */
 static inline void MRT_set_interval(MRT_channel_sel_en channel, uint32_t interval)
 {
-	*((uint32_t *) &MRT->CHN[channel].INTVAL.LVALUE) = (interval & 0x80000000);
+	*((uint32_t *) &MRT->CHN[channel].INTVAL) = (interval & ~0x80000000);
 }
 
 /**
@@ -49,7 +49,7 @@ static inline void MRT_set_interval(MRT_channel_sel_en channel, uint32_t interva
  */
 static inline void MRT_set_interval_and_stop_timer(MRT_channel_sel_en channel, uint32_t interval)
 {
-	*((uint32_t *) &MRT->CHN[channel].INTVAL.LVALUE) = (interval | 0x80000000);
+	*((uint32_t *) &MRT->CHN[channel].INTVAL) = (interval | 0x80000000);
 }
 
 /**
@@ -80,6 +80,16 @@ static inline void MRT_disable_irq(MRT_channel_sel_en channel)
 	MRT->CHN[channel].CTRL.INTEN = 0;
 }
 
+/**
+ * @brief Consultar si la interrupcion de un canal del MRT esta habilitada
+ * @param[in] channel Canal a consultar
+ * @return Distinto de cero si la interrupcion esta habilitada
+ */
+static inline uint8_t MRT_get_irq_enabled(MRT_channel_sel_en channel)
+{
+	return MRT->CHN[channel].CTRL.INTEN;
+}
+
 /**
  * @brief Configurar modo de funcionamiento de un canal del MRT
  * @param[in] channel Canal a configurar
@@ -117,19 +127,25 @@ static inline uint8_t MRT_get_irq_flag(MRT_channel_sel_en channel)
 	return 0;
 }
 
+/**
+ * @brief Obtener los flags de interrupcion de todos los canales
+ * @return Flags de interrupcion, el bit 0 corresponde al canal 0
+ */
+static inline uint32_t MRT_get_irq_flags(void)
+{
+	return *((uint32_t *) &MRT->IRQ_FLAG);
+}
+
 /**
  * @brief Limpiar flag de interrupcion de un canal
+ *
+ * El registro se escribe completo, ya que escribir un 1 en el flag de otro canal pendiente tambien lo limpiaria.
+ *
  * @param[in] channel Canal a consultar
  */
 static inline void MRT_clear_irq_flag(MRT_channel_sel_en channel)
 {
-	switch(channel)
-	{
-	case MRT_CHANNEL_0: { MRT->IRQ_FLAG.CFLAG0 = 1; break; }
-	case MRT_CHANNEL_1: { MRT->IRQ_FLAG.CFLAG1 = 1; break; }
-	case MRT_CHANNEL_2: { MRT->IRQ_FLAG.CFLAG2 = 1; break; }
-	case MRT_CHANNEL_3: { MRT->IRQ_FLAG.CFLAG3 = 1; break; }
-	}
+	*((uint32_t *) &MRT->IRQ_FLAG) = (1 << channel);
 }
 
 #if defined (__cplusplus)
@@ -78,6 +78,69 @@ static inline void NVIC_disable_interrupt(NVIC_irq_sel_en irq)
 	*((uint32_t *) &NVIC->ICER0) = (1 << irq);
 }
 
+/**
+ * @brief Obtener estado de habilitacion de una interrupcion
+ * @param[in] irq Seleccion de fuente de interrupcion
+ * @return Si la interrupcion estaba habilitada devuelve 1, caso contrario devuelve 0
+ */
+static inline uint8_t NVIC_get_enabled_interrupt(NVIC_irq_sel_en irq)
+{
+	return (*((uint32_t *) &NVIC->ISER0) & (1 << irq)) >> irq;
+}
+
+/**
+ * @brief Obtener estado de habilitacion de todas las interrupciones
+ * @return Mascara de interrupciones habilitadas. Cada bit representa una fuente de interrupcion
+ */
+static inline uint32_t NVIC_get_enabled_mask(void)
+{
+	return *((uint32_t *) &NVIC->ISER0);
+}
+
+/**
+ * @brief Habilitacion de multiples interrupciones
+ * @param[in] mask Mascara de interrupciones a habilitar. Cada bit representa una fuente de interrupcion
+ */
+static inline void NVIC_enable_mask(uint32_t mask)
+{
+	*((uint32_t *) &NVIC->ISER0) = mask;
+}
+
+/**
+ * @brief Inhabilitacion de multiples interrupciones
+ * @param[in] mask Mascara de interrupciones a inhabilitar. Cada bit representa una fuente de interrupcion
+ */
+static inline void NVIC_disable_mask(uint32_t mask)
+{
+	*((uint32_t *) &NVIC->ICER0) = mask;
+}
+
+/**
+ * @brief Enmascarar todas las interrupciones mediante el registro PRIMASK
+ *
+ * Se fuerza la expansion en linea para que las funciones ubicadas en RAM no llamen a codigo en flash.
+ *
+ * @return Valor previo del registro PRIMASK, a pasar a @ref NVIC_global_restore
+ */
+static inline __attribute__ ((always_inline)) uint32_t NVIC_global_disable(void)
+{
+	uint32_t primask;
+
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i" : : : "memory");
+
+	return primask;
+}
+
+/**
+ * @brief Restaurar el enmascaramiento de interrupciones previo a @ref NVIC_global_disable
+ * @param[in] primask Valor devuelto por @ref NVIC_global_disable
+ */
+static inline __attribute__ ((always_inline)) void NVIC_global_restore(uint32_t primask)
+{
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
 /**
  * @brief Fijar interupcion pendiente por software
  * @param[in] irq Seleccion de fuente de interrupcion
@@ -148,6 +211,21 @@ static inline void NVIC_set_irq_priority(NVIC_irq_sel_en irq, NVIC_irq_priority_
 	}
 }
 
+/**
+ * @brief Obtener prioridad en el NVIC de un periferico
+ *
+ * Los registros de prioridad solo admiten accesos de 32 bits, por lo que se lee el registro completo.
+ *
+ * @param[in] irq Seleccion de fuente de interrupcion
+ * @return Prioridad actual de la fuente de interrupcion
+ */
+static inline NVIC_irq_priority_en NVIC_get_irq_priority(NVIC_irq_sel_en irq)
+{
+	uint32_t ipr = *(((uint32_t *) &NVIC->IPR0) + (irq / 4));
+
+	return (NVIC_irq_priority_en) ((ipr >> (((irq % 4) * 8) + 6)) & 0x03);
+}
+
 #if defined (__cplusplus)
 } // extern "C"
 #endif
@@ -53,7 +53,7 @@ static inline void PININT_set_interrupt_mode(uint8_t channel, PININT_interrupt_m
  */
 static inline PININT_interrupt_mode_en PININT_get_interrupt_mode(uint8_t channel)
 {
-	return (PININT->ISEL.PMODE & (1 << channel)) >> channel;
+	return (PININT_interrupt_mode_en) ((PININT->ISEL.PMODE & (1 << channel)) >> channel);
 }
 
 /**
@@ -0,0 +1,124 @@
+/**
+ * @file HPL_SCB.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del SCB (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_SCB_H_
+#define HPL_SCB_H_
+
+#include "HRI_SCB.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile SCB_per_t * const SCB; //!< Bloque de control del sistema
+
+/** Clave necesaria para escribir el registro AIRCR */
+#define		SCB_AIRCR_VECTKEY		(0x05FA)
+
+/**
+ * @brief Fijar la direccion de la tabla de vectores de interrupcion
+ * @param[in] address Direccion de la tabla. Debe estar alineada al tamaño de la tabla (256 bytes)
+ */
+static inline void SCB_set_vector_table(uint32_t address)
+{
+	*((uint32_t *) &SCB->VTOR) = address;
+}
+
+/**
+ * @brief Obtener la direccion de la tabla de vectores de interrupcion
+ * @return Direccion de la tabla
+ */
+static inline uint32_t SCB_get_vector_table(void)
+{
+	return *((uint32_t *) &SCB->VTOR);
+}
+
+/**
+ * @brief Obtener el numero de excepcion que se esta ejecutando
+ * @return Numero de excepcion activa (0 en modo thread, 16 + n para la interrupcion n)
+ */
+static inline uint8_t SCB_get_active_vector(void)
+{
+	return SCB->ICSR.VECTACTIVE;
+}
+
+/**
+ * @brief Fijar pendiente la excepcion PendSV
+ */
+static inline void SCB_set_pending_pendsv(void)
+{
+	*((uint32_t *) &SCB->ICSR) = (1 << 28);
+}
+
+/**
+ * @brief Fijar prioridad de la excepcion SVCall
+ * @param[in] priority Prioridad deseada (0 a 3)
+ */
+static inline void SCB_set_svcall_priority(uint8_t priority)
+{
+	SCB->SHPR2.PRI_11 = priority;
+}
+
+/**
+ * @brief Obtener prioridad de la excepcion SVCall
+ * @return Prioridad actual (0 a 3)
+ */
+static inline uint8_t SCB_get_svcall_priority(void)
+{
+	return SCB->SHPR2.PRI_11;
+}
+
+/**
+ * @brief Fijar prioridad de la excepcion PendSV
+ * @param[in] priority Prioridad deseada (0 a 3)
+ */
+static inline void SCB_set_pendsv_priority(uint8_t priority)
+{
+	SCB->SHPR3.PRI_14 = priority;
+}
+
+/**
+ * @brief Obtener prioridad de la excepcion PendSV
+ * @return Prioridad actual (0 a 3)
+ */
+static inline uint8_t SCB_get_pendsv_priority(void)
+{
+	return SCB->SHPR3.PRI_14;
+}
+
+/**
+ * @brief Fijar prioridad de la excepcion SysTick
+ * @param[in] priority Prioridad deseada (0 a 3)
+ */
+static inline void SCB_set_systick_priority(uint8_t priority)
+{
+	SCB->SHPR3.PRI_15 = priority;
+}
+
+/**
+ * @brief Obtener prioridad de la excepcion SysTick
+ * @return Prioridad actual (0 a 3)
+ */
+static inline uint8_t SCB_get_systick_priority(void)
+{
+	return SCB->SHPR3.PRI_15;
+}
+
+/**
+ * @brief Pedir un reset del sistema
+ */
+static inline void SCB_system_reset(void)
+{
+	*((uint32_t *) &SCB->AIRCR) = (SCB_AIRCR_VECTKEY << 16) | (1 << 2);
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_SCB_H_ */
@@ -0,0 +1,312 @@
+/**
+ * @file HPL_SCT.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del SCT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_SCT_H_
+#define HPL_SCT_H_
+
+#include "HRI_SCT.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile SCT_per_t * const SCT; //!< Periferico SCT
+
+typedef enum
+{
+	SCT_COMBMODE_OR = 0,
+	SCT_COMBMODE_MATCH,
+	SCT_COMBMODE_IO,
+	SCT_COMBMODE_AND
+}SCT_combmode_en;
+
+typedef enum
+{
+	SCT_IOCOND_LOW = 0,
+	SCT_IOCOND_RISE,
+	SCT_IOCOND_FALL,
+	SCT_IOCOND_HIGH
+}SCT_iocond_en;
+
+typedef enum
+{
+	SCT_CONFLICT_RES_NONE = 0,
+	SCT_CONFLICT_RES_SET,
+	SCT_CONFLICT_RES_CLEAR,
+	SCT_CONFLICT_RES_TOGGLE
+}SCT_conflict_res_en;
+
+typedef enum
+{
+	SCT_OUTPUT_DIR_INDEPENDENT = 0,
+	SCT_OUTPUT_DIR_REVERSED
+}SCT_output_dir_en;
+
+/**
+ * @brief Configurar el SCT como un unico contador de 32 bits excitado por el clock del SCT
+ */
+static inline void SCT_config_unified_counter(void)
+{
+	SCT->CONFIG.UNIFY = 1;
+	SCT->CONFIG.CLKMODE = 0;
+	SCT->CONFIG.AUTOLIMIT_L = 0;
+}
+
+/**
+ * @brief Detener el contador
+ */
+static inline void SCT_halt(void)
+{
+	SCT->CTRL.HALT_L = 1;
+}
+
+/**
+ * @brief Liberar el contador
+ */
+static inline void SCT_run(void)
+{
+	SCT->CTRL.HALT_L = 0;
+}
+
+/**
+ * @brief Consultar si el contador esta detenido
+ * @return Distinto de cero si el contador esta detenido
+ */
+static inline uint8_t SCT_get_halted(void)
+{
+	return SCT->CTRL.HALT_L;
+}
+
+/**
+ * @brief Poner el contador en cero
+ * @pre El contador debe estar detenido
+ */
+static inline void SCT_clear_counter(void)
+{
+	SCT->CTRL.CLRCTR_L = 1;
+}
+
+/**
+ * @brief Configurar el conteo bidireccional
+ * @param[in] bidir Distinto de cero para contar hasta el limite y luego hacia abajo hasta cero
+ */
+static inline void SCT_set_bidirectional(uint8_t bidir)
+{
+	SCT->CTRL.BIDIR_L = (bidir != 0);
+}
+
+/**
+ * @brief Configurar el prescaler del contador
+ * @param[in] pre Division del clock menos 1 (0 a 255)
+ */
+static inline void SCT_set_prescaler(uint8_t pre)
+{
+	SCT->CTRL.PRE_L = pre;
+}
+
+/**
+ * @brief Configurar los eventos que reinician (o invierten) el contador
+ * @param[in] events Mascara de eventos (bit n = evento n)
+ */
+static inline void SCT_set_limit_events(uint32_t events)
+{
+	SCT->LIMIT = events;
+}
+
+/**
+ * @brief Configurar los eventos que detienen el contador
+ * @param[in] events Mascara de eventos (bit n = evento n)
+ */
+static inline void SCT_set_halt_events(uint32_t events)
+{
+	SCT->HALT = events;
+}
+
+/**
+ * @brief Leer el valor del contador
+ * @return Valor del contador
+ */
+static inline uint32_t SCT_get_count(void)
+{
+	return SCT->COUNT;
+}
+
+/**
+ * @brief Escribir el estado actual
+ * @param[in] state Estado (0 a SCT_STATE_AMOUNT - 1)
+ * @pre El contador debe estar detenido
+ */
+static inline void SCT_set_state(uint8_t state)
+{
+	SCT->STATE.STATE_L = state;
+}
+
+/**
+ * @brief Leer el estado actual
+ * @return Estado actual
+ */
+static inline uint8_t SCT_get_state(void)
+{
+	return SCT->STATE.STATE_L;
+}
+
+/**
+ * @brief Leer el estado de las entradas
+ * @return Estado de las entradas (bit n = entrada n)
+ */
+static inline uint32_t SCT_get_inputs(void)
+{
+	return SCT->INPUT & 0x0F;
+}
+
+/**
+ * @brief Escribir el estado de las salidas
+ * @param[in] outputs Estado de las salidas (bit n = salida n)
+ * @pre El contador debe estar detenido
+ */
+static inline void SCT_set_outputs(uint32_t outputs)
+{
+	SCT->OUTPUT = outputs;
+}
+
+/**
+ * @brief Leer el estado de las salidas
+ * @return Estado de las salidas (bit n = salida n)
+ */
+static inline uint32_t SCT_get_outputs(void)
+{
+	return SCT->OUTPUT;
+}
+
+/**
+ * @brief Configurar la inversion de los eventos de una salida al contar hacia abajo
+ * @param[in] output Salida a configurar
+ * @param[in] dir Comportamiento deseado
+ */
+static inline void SCT_set_output_direction(uint8_t output, SCT_output_dir_en dir)
+{
+	SCT->OUTPUTDIRCTRL = (SCT->OUTPUTDIRCTRL & ~(0x03UL << (2 * output))) | ((uint32_t) dir << (2 * output));
+}
+
+/**
+ * @brief Configurar la resolucion de conflictos de una salida
+ *
+ * Un conflicto ocurre cuando un mismo ciclo de clock activa y desactiva la salida.
+ *
+ * @param[in] output Salida a configurar
+ * @param[in] res Resolucion deseada
+ */
+static inline void SCT_set_conflict_resolution(uint8_t output, SCT_conflict_res_en res)
+{
+	SCT->RES = (SCT->RES & ~(0x03UL << (2 * output))) | ((uint32_t) res << (2 * output));
+}
+
+/**
+ * @brief Configurar los eventos que generan interrupcion
+ * @param[in] events Mascara de eventos (bit n = evento n)
+ */
+static inline void SCT_set_event_irq(uint32_t events)
+{
+	SCT->EVEN = events;
+}
+
+/**
+ * @brief Leer los flags de eventos
+ * @return Flags de eventos (bit n = evento n)
+ */
+static inline uint32_t SCT_get_event_flags(void)
+{
+	return SCT->EVFLAG;
+}
+
+/**
+ * @brief Limpiar flags de eventos
+ * @param[in] events Mascara de eventos a limpiar (bit n = evento n)
+ */
+static inline void SCT_clear_event_flags(uint32_t events)
+{
+	SCT->EVFLAG = events;
+}
+
+/**
+ * @brief Configurar todos los registros de match/captura en modo match
+ */
+static inline void SCT_set_all_match_mode(void)
+{
+	SCT->REGMODE = 0;
+}
+
+/**
+ * @brief Escribir un registro de match
+ * @param[in] match Registro de match
+ * @param[in] value Valor a escribir
+ * @pre El contador debe estar detenido
+ */
+static inline void SCT_set_match(uint8_t match, uint32_t value)
+{
+	SCT->MATCH[match] = value;
+}
+
+/**
+ * @brief Escribir el valor de recarga de un registro de match
+ *
+ * El valor se copia al registro de match cada vez que el contador se reinicia por un evento de limite.
+ *
+ * @param[in] match Registro de match
+ * @param[in] value Valor a escribir
+ */
+static inline void SCT_set_match_reload(uint8_t match, uint32_t value)
+{
+	SCT->MATCHREL[match] = value;
+}
+
+/**
+ * @brief Configurar los estados en los cuales un evento esta habilitado
+ * @param[in] event Evento a configurar
+ * @param[in] states Mascara de estados (bit n = estado n)
+ */
+static inline void SCT_set_event_states(uint8_t event, uint32_t states)
+{
+	SCT->EV[event].STATE = states;
+}
+
+/**
+ * @brief Configurar la condicion y el cambio de estado de un evento en una unica escritura
+ * @param[in] event Evento a configurar
+ * @param[in] ctrl Configuracion del evento
+ */
+static inline void SCT_set_event_control(uint8_t event, SCT_EV_CTRL_reg_t ctrl)
+{
+	SCT->EV[event].CTRL = ctrl;
+}
+
+/**
+ * @brief Configurar los eventos que activan una salida
+ * @param[in] output Salida a configurar
+ * @param[in] events Mascara de eventos (bit n = evento n)
+ */
+static inline void SCT_set_output_set_events(uint8_t output, uint32_t events)
+{
+	SCT->OUT[output].SET = events;
+}
+
+/**
+ * @brief Configurar los eventos que desactivan una salida
+ * @param[in] output Salida a configurar
+ * @param[in] events Mascara de eventos (bit n = evento n)
+ */
+static inline void SCT_set_output_clear_events(uint8_t output, uint32_t events)
+{
+	SCT->OUT[output].CLR = events;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_SCT_H_ */
@@ -264,6 +264,16 @@ static inline uint8_t SPI_get_status_flag(uint8_t inst, SPI_status_flag_en flag)
 	return 0;
 }
 
+/**
+ * @brief Leer todos los flags de status en una unica lectura
+ * @param[in] inst Instancia a consultar
+ * @return Registro de status
+ */
+static inline SPI_STAT_reg_t SPI_get_status(uint8_t inst)
+{
+	return *((SPI_STAT_reg_t *) &SPI[inst]->STAT);
+}
+
 /**
  * @brief Limpiar un flag de status
  * @param[in] inst Instancia a limpiar
@@ -336,6 +346,16 @@ static inline uint16_t SPI_read_rx_data(uint8_t inst)
 	return SPI[inst]->RXDAT.RXDAT;
 }
 
+/**
+ * @brief Leer resultado de la recepcion junto con su estado en una unica lectura
+ * @param[in] inst Instancia a consultar
+ * @return Registro de recepcion
+ */
+static inline SPI_RXDAT_reg_t SPI_read_rx_data_and_status(uint8_t inst)
+{
+	return *((SPI_RXDAT_reg_t *) &SPI[inst]->RXDAT);
+}
+
 /**
  * @brief Obtener slave select activo
  * @param[in] inst Instancia a consultar
@@ -462,7 +482,7 @@ static inline void SPI_set_data_length(uint8_t inst, SPI_data_length_en data_len
  */
 static inline void SPI_set_data_and_control(uint8_t inst, SPI_TXDATCTL_reg_t *data_and_control)
 {
-	SPI[inst]->TXDATCTL = *data_and_control;
+	*((uint32_t *) &SPI[inst]->TXDATCTL) = *((uint32_t *) data_and_control);
 }
 
 /**
@@ -41,6 +41,26 @@ static inline void SWM_deinit(void)
 	SYSCON->SYSAHBCLKCTRL0.SWM = 0;
 }
 
+/**
+ * @brief Escribir un registro PINASSIGN completo
+ * @param[in] reg Numero de registro PINASSIGN (0 a 14)
+ * @param[in] value Valor a escribir. Cada byte contiene el puerto/pin (port * 32 + pin) de una funcion, o 0xFF
+ */
+static inline void SWM_set_pinassign(uint8_t reg, uint32_t value)
+{
+	*(((uint32_t *) &SWM->PINASSIGN0) + reg) = value;
+}
+
+/**
+ * @brief Escribir un registro PINENABLE completo
+ * @param[in] reg Numero de registro PINENABLE (0 o 1)
+ * @param[in] value Valor a escribir. Cada bit en cero habilita la funcion fija correspondiente
+ */
+static inline void SWM_set_pinenable(uint8_t reg, uint32_t value)
+{
+	*(((uint32_t *) &SWM->PINENABLE0) + reg) = value;
+}
+
 /**
  * @brief Asignar un pin del MCU a la funcion UARTn TXD
  * @param[in] uart Instancia de UART a la cual asignar
@@ -340,6 +360,43 @@ static inline void SWM_assign_sct_OUT6(uint8_t port, uint8_t pin)
 	SWM->PINASSIGN9.SCT_OUT6_O = (port * 32) + pin;
 }
 
+/**
+ * @brief Asignar un pin del MCU a una entrada del SCT
+ * @param[in] input Numero de entrada a asignar (0 a 3, IN_A a IN_D)
+ * @param[in] port Numero de puerto a asignar
+ * @param[in] pin Numero de pin a asignar
+ */
+static inline void SWM_assign_sct_IN(uint8_t input, uint8_t port, uint8_t pin)
+{
+	switch(input)
+	{
+	case 0: { SWM_assign_sct_IN_A(port, pin); break; }
+	case 1: { SWM_assign_sct_IN_B(port, pin); break; }
+	case 2: { SWM_assign_sct_IN_C(port, pin); break; }
+	case 3: { SWM_assign_sct_IN_D(port, pin); break; }
+	}
+}
+
+/**
+ * @brief Asignar un pin del MCU a una salida del SCT
+ * @param[in] output Numero de salida a asignar (0 a 6)
+ * @param[in] port Numero de puerto a asignar
+ * @param[in] pin Numero de pin a asignar
+ */
+static inline void SWM_assign_sct_OUT(uint8_t output, uint8_t port, uint8_t pin)
+{
+	switch(output)
+	{
+	case 0: { SWM_assign_sct_OUT0(port, pin); break; }
+	case 1: { SWM_assign_sct_OUT1(port, pin); break; }
+	case 2: { SWM_assign_sct_OUT2(port, pin); break; }
+	case 3: { SWM_assign_sct_OUT3(port, pin); break; }
+	case 4: { SWM_assign_sct_OUT4(port, pin); break; }
+	case 5: { SWM_assign_sct_OUT5(port, pin); break; }
+	case 6: { SWM_assign_sct_OUT6(port, pin); break; }
+	}
+}
+
 /**
  * @brief Asignar un pin del MCU a la funcion IICn SDA
  *
@@ -442,7 +442,7 @@ static inline void SYSCON_ext_clock_source_set(SYSCON_ext_clock_source_sel_en so
  */
 static inline SYSCON_ext_clock_source_sel_en SYSCON_ext_clock_source_get(void)
 {
-	return SYSCON->EXTCLKSEL.SEL;
+	return (SYSCON_ext_clock_source_sel_en) SYSCON->EXTCLKSEL.SEL;
 }
 
 /**
@@ -457,8 +457,7 @@ static inline void SYSCON_enable_clock(SYSCON_enable_clock_sel_en peripheral)
 	}
 	else
 	{
-		peripheral -= 32;
-		*((uint32_t *) &SYSCON->SYSAHBCLKCTRL1) |= (1 << peripheral);
+		*((uint32_t *) &SYSCON->SYSAHBCLKCTRL1) |= (1 << (peripheral - 32));
 	}
 }
 
@@ -474,8 +473,24 @@ static inline void SYSCON_disable_clock(SYSCON_enable_clock_sel_en peripheral)
 	}
 	else
 	{
-		peripheral -= 32;
-		*((uint32_t *) &SYSCON->SYSAHBCLKCTRL1) |= (1 << peripheral);
+		*((uint32_t *) &SYSCON->SYSAHBCLKCTRL1) |= (1 << (peripheral - 32));
+	}
+}
+
+/**
+ * @brief Consultar si el clock de un periferico esta habilitado
+ * @param[in] peripheral Periferico a consultar
+ * @return Distinto de cero si el clock esta habilitado
+ */
+static inline uint8_t SYSCON_get_clock_enabled(SYSCON_enable_clock_sel_en peripheral)
+{
+	if(peripheral < 32)
+	{
+		return (*((uint32_t *) &SYSCON->SYSAHBCLKCTRL0) >> peripheral) & 0x01;
+	}
+	else
+	{
+		return (*((uint32_t *) &SYSCON->SYSAHBCLKCTRL1) >> (peripheral - 32)) & 0x01;
 	}
 }
 
@@ -491,8 +506,7 @@ static inline void SYSCON_assert_reset(SYSCON_reset_sel_en peripheral)
 	}
 	else
 	{
-		peripheral -= 32;
-		*((uint32_t *) &SYSCON->PRESETCTRL1) &= ~(1 << peripheral);
+		*((uint32_t *) &SYSCON->PRESETCTRL1) &= ~(1 << (peripheral - 32));
 	}
 }
 
@@ -508,8 +522,7 @@ static inline void SYSCON_clear_reset(SYSCON_reset_sel_en peripheral)
 	}
 	else
 	{
-		peripheral -= 32;
-		*((uint32_t *) &SYSCON->PRESETCTRL1) |= (1 << peripheral);
+		*((uint32_t *) &SYSCON->PRESETCTRL1) |= (1 << (peripheral - 32));
 	}
 }
 
@@ -523,6 +536,16 @@ static inline void SYSCON_set_peripheral_clock_source(SYSCON_peripheral_sel_en p
 	SYSCON->PERCLKSEL[peripheral].SEL = clock;
 }
 
+/**
+ * @brief Obtener la fuente de clock seleccionada para un periferico
+ * @param[in] peripheral Periferico a consultar
+ * @return Fuente de clock del periferico
+ */
+static inline SYSCON_peripheral_clock_sel_en SYSCON_get_peripheral_clock_source(SYSCON_peripheral_sel_en peripheral)
+{
+	return (SYSCON_peripheral_clock_sel_en) SYSCON->PERCLKSEL[peripheral].SEL;
+}
+
 /**
  * @brief Configuracion del FRG
  * @param[in] frg_selection Cual de los FRG configurar, cero o uno
@@ -546,6 +569,40 @@ static inline void SYSCON_set_frg_config(uint8_t frg_selection, SYSCON_frg_clock
 	}
 }
 
+/**
+ * @brief Obtener la fuente de clock de un FRG
+ * @param[in] frg_selection Cual de los FRG consultar, cero o uno
+ * @return Fuente de clock del FRG
+ */
+static inline SYSCON_frg_clock_sel_en SYSCON_get_frg_clock_source(uint8_t frg_selection)
+{
+	if(frg_selection == 0)
+	{
+		return (SYSCON_frg_clock_sel_en) SYSCON->FRG0CLKSEL.SEL;
+	}
+	else
+	{
+		return (SYSCON_frg_clock_sel_en) SYSCON->FRG1CLKSEL.SEL;
+	}
+}
+
+/**
+ * @brief Obtener el multiplicador de un FRG
+ * @param[in] frg_selection Cual de los FRG consultar, cero o uno
+ * @return Multiplicador del FRG 0 ~ 255
+ */
+static inline uint8_t SYSCON_get_frg_mul(uint8_t frg_selection)
+{
+	if(frg_selection == 0)
+	{
+		return SYSCON->FRG0MUL.MULT;
+	}
+	else
+	{
+		return SYSCON->FRG1MUL.MULT;
+	}
+}
+
 /**
  * @brief Seleccion de fuente para el CLOCK OUT
  * @param[in] clock_source Fuente deseada
@@ -617,6 +674,15 @@ static inline uint8_t SYSCON_get_irq_latency(void)
 	return SYSCON->IRQLATENCY.LATENCY;
 }
 
+/**
+ * @brief Fijar el valor de latencia de interrupciones del MCU
+ * @param[in] latency Cantidad minima de ciclos entre el pedido de interrupcion y la entrada a la rutina
+ */
+static inline void SYSCON_set_irq_latency(uint8_t latency)
+{
+	SYSCON->IRQLATENCY.LATENCY = latency;
+}
+
 /**
  * @brief Fijar que numero de interrupcion actuara como NMI
  * @param[in] irq Numero de interrupcion deseado
@@ -650,8 +716,7 @@ static inline void SYSCON_enable_wakeup_source(SYSCON_enable_wakeup_sel_en perip
 	}
 	else
 	{
-		peripheral -= 32;
-		*((uint32_t *) &SYSCON->STARTERP1) |= (1 << peripheral);
+		*((uint32_t *) &SYSCON->STARTERP1) |= (1 << (peripheral - 32));
 	}
 }
 
@@ -667,8 +732,7 @@ static inline void SYSCON_disable_wakeup_source(SYSCON_enable_wakeup_sel_en peri
 	}
 	else
 	{
-		peripheral -= 32;
-		*((uint32_t *) &SYSCON->STARTERP1) &= ~(1 << peripheral);
+		*((uint32_t *) &SYSCON->STARTERP1) &= ~(1 << (peripheral - 32));
 	}
 }
 
@@ -726,6 +790,25 @@ static inline void SYSCON_power_down_peripheral(SYSCON_power_sel_en peripheral)
 	*((uint32_t*) &SYSCON->PDRUNCFG) |= (1 << peripheral);
 }
 
+/**
+ * @brief Obtener el flag de reset por watchdog
+ * @return Distinto de cero si el ultimo reset fue causado por el watchdog
+ */
+static inline uint8_t SYSCON_get_watchdog_reset_flag(void)
+{
+	return SYSCON->SYSRSTSTAT.WDT;
+}
+
+/**
+ * @brief Limpiar el flag de reset por watchdog
+ *
+ * Se escribe el registro completo, ya que una escritura de campo de bits limpiaria tambien los demas flags.
+ */
+static inline void SYSCON_clear_watchdog_reset_flag(void)
+{
+	*((volatile uint32_t *) &SYSCON->SYSRSTSTAT) = (1 << 2);
+}
+
 /**
  * @brief Obtener el Device ID
  * @return Device ID
@@ -55,6 +55,15 @@ static inline void SYSTICK_disable_interrupt(void)
 	SYSTICK->CSR.TICKINT = 0;
 }
 
+/*
+ * @brief Obtener estado de habilitacion de la interrupcion
+ * @return Si la interrupcion esta habilitada devuelve 1, caso contrario devuelve 0
+ */
+static inline uint8_t SYSTICK_get_interrupt_enable(void)
+{
+	return SYSTICK->CSR.TICKINT;
+}
+
 /**
  * @brief Seleccion de fuente de clock
  * @param[in] clock_source Fuente deseada
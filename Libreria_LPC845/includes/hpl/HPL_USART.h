@@ -79,6 +79,16 @@ static inline void USART_disable(uint8_t inst)
 	USART[inst]->CFG.ENABLE = 0;
 }
 
+/**
+ * @brief Obtener el estado de habilitacion de una instancia de USART
+ * @param[in] inst Instancia a consultar
+ * @return Estado de habilitacion de la instancia
+ */
+static inline uint8_t USART_get_enable(uint8_t inst)
+{
+	return USART[inst]->CFG.ENABLE;
+}
+
 /**
  * @brief Configurar largo de palabra
  * @param[in] inst Instancia a configurar
@@ -768,7 +778,7 @@ static inline uint32_t USART_get_data(uint8_t inst)
  */
 static inline uint32_t USART_get_data_and_status(uint8_t inst, uint8_t * frame, uint8_t * parity, uint8_t * noise)
 {
-	USART_RXDATSTAT_reg_t rxdatstat = USART[inst]->RXDATSTAT;
+	USART_RXDATSTAT_reg_t rxdatstat = *((USART_RXDATSTAT_reg_t *) &USART[inst]->RXDATSTAT);
 
 	*frame = rxdatstat.FRAMERR;
 	*parity = rxdatstat.PARITYERR;
@@ -915,6 +925,26 @@ static inline void USART_set_OSRVAL(uint8_t inst, uint32_t osr)
 	USART[inst]->OSR.OSRVAL = osr;
 }
 
+/**
+ * @brief Leer el registro BRG
+ * @param[in] inst Instancia a consultar
+ * @return Valor del registro
+ */
+static inline uint32_t USART_get_BRGVAL(uint8_t inst)
+{
+	return USART[inst]->BRG.BRGVAL;
+}
+
+/**
+ * @brief Leer el registro OSR
+ * @param[in] inst Instancia a consultar
+ * @return Valor del registro
+ */
+static inline uint32_t USART_get_OSRVAL(uint8_t inst)
+{
+	return USART[inst]->OSR.OSRVAL;
+}
+
 /**
  * @brief Escribir el registro ADDR
  * @param[in] inst Instancia a configurar
@@ -0,0 +1,158 @@
+/**
+ * @file HPL_WWDT.h
+ * @brief Declaraciones a nivel de abstraccion de periferico del WWDT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_WWDT_H_
+#define HPL_WWDT_H_
+
+#include "HRI_WWDT.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern volatile WWDT_per_t * const WWDT; //!< Periferico WWDT
+
+/** Division fija del clock del watchdog oscillator antes del contador */
+#define		WWDT_CLOCK_PRESCALER			4
+
+/** Valor minimo del contador */
+#define		WWDT_MIN_COUNT					0xFF
+
+/** Valor maximo del contador */
+#define		WWDT_MAX_COUNT					0xFFFFFF
+
+/** Valor maximo de comparacion de la interrupcion de advertencia */
+#define		WWDT_MAX_WARNING				0x3FF
+
+/**
+ * @brief Habilitar el watchdog
+ *
+ * Una vez habilitado, solo puede inhabilitarse mediante un reset. El contador comienza a decrementar luego del primer
+ * alimentado.
+ */
+static inline void WWDT_enable(void)
+{
+	WWDT->MOD.WDEN = 1;
+}
+
+/**
+ * @brief Habilitar el reset del microcontrolador al vencer el contador
+ *
+ * Una vez habilitado, solo puede inhabilitarse mediante un reset.
+ */
+static inline void WWDT_enable_reset(void)
+{
+	WWDT->MOD.WDRESET = 1;
+}
+
+/**
+ * @brief Impedir la modificacion del valor de recarga salvo cuando el contador esta por debajo de la advertencia y la ventana
+ */
+static inline void WWDT_enable_protect(void)
+{
+	WWDT->MOD.WDPROTECT = 1;
+}
+
+/**
+ * @brief Impedir que se apague el watchdog oscillator hasta el proximo reset
+ */
+static inline void WWDT_lock(void)
+{
+	WWDT->MOD.LOCK = 1;
+}
+
+/**
+ * @brief Obtener el flag de vencimiento del contador
+ * @return Estado del flag
+ */
+static inline uint8_t WWDT_get_timeout_flag(void)
+{
+	return WWDT->MOD.WDTOF;
+}
+
+/**
+ * @brief Limpiar el flag de vencimiento del contador
+ */
+static inline void WWDT_clear_timeout_flag(void)
+{
+	WWDT->MOD.WDTOF = 0;
+}
+
+/**
+ * @brief Obtener el flag de la interrupcion de advertencia
+ * @return Estado del flag
+ */
+static inline uint8_t WWDT_get_warning_flag(void)
+{
+	return WWDT->MOD.WDINT;
+}
+
+/**
+ * @brief Limpiar el flag de la interrupcion de advertencia
+ */
+static inline void WWDT_clear_warning_flag(void)
+{
+	WWDT->MOD.WDINT = 1;
+}
+
+/**
+ * @brief Configurar el valor de recarga del contador
+ * @param[in] count Valor de recarga (WWDT_MIN_COUNT a WWDT_MAX_COUNT)
+ */
+static inline void WWDT_set_timer_constant(uint32_t count)
+{
+	WWDT->TC.COUNT = count;
+}
+
+/**
+ * @brief Alimentar el watchdog
+ *
+ * La secuencia no debe ser interrumpida por otro acceso a los registros del periferico, ya que ello genera un reset
+ * (o una interrupcion) inmediato.
+ */
+static inline void WWDT_feed(void)
+{
+	*((volatile uint32_t *) &WWDT->FEED) = 0xAA;
+	*((volatile uint32_t *) &WWDT->FEED) = 0x55;
+}
+
+/**
+ * @brief Leer el valor actual del contador
+ * @return Valor del contador
+ */
+static inline uint32_t WWDT_get_timer_value(void)
+{
+	return WWDT->TV.COUNT;
+}
+
+/**
+ * @brief Configurar el valor del contador al cual se genera la interrupcion de advertencia
+ * @param[in] warning Valor de comparacion (0 a WWDT_MAX_WARNING)
+ */
+static inline void WWDT_set_warning_compare(uint16_t warning)
+{
+	WWDT->WARNINT.WARNINT = warning;
+}
+
+/**
+ * @brief Configurar la ventana de alimentado
+ *
+ * Alimentar el watchdog mientras el contador es mayor a este valor genera un reset (o una interrupcion).
+ *
+ * @param[in] window Valor de la ventana (WWDT_MAX_COUNT para no utilizar ventana)
+ */
+static inline void WWDT_set_window(uint32_t window)
+{
+	WWDT->WINDOW.WINDOW = window;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_WWDT_H_ */
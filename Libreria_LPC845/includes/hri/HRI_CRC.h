@@ -0,0 +1,41 @@
+/**
+ * @file HRI_CRC.h
+ * @brief Definiciones a nivel de registros del periferico CRC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_CRC_H_
+#define HRI_CRC_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define			CRC_BASE		0x50000000
+
+typedef struct
+{
+	uint32_t CRC_POLY : 2;
+	uint32_t BIT_RVS_WR : 1;
+	uint32_t CMPL_WR : 1;
+	uint32_t BIT_RVS_SUM : 1;
+	uint32_t CMPL_SUM : 1;
+	uint32_t : 26;
+}CRC_MODE_reg_t;
+
+typedef struct
+{
+	CRC_MODE_reg_t MODE;
+	uint32_t SEED;
+	uint32_t SUM; // En escritura es el registro WR_DATA, que acepta escrituras de 8, 16 y 32 bits
+}CRC_per_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_CRC_H_ */
@@ -0,0 +1,55 @@
+/**
+ * @file HRI_DIV.h
+ * @brief Definiciones a nivel de registros de las rutinas de división en ROM (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_DIV_H_
+#define HRI_DIV_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define	DIV_ROM_DRIVER_TABLE_BASE	0x0F001FF8 //!< Posición de memoria que contiene la dirección de la tabla de drivers en ROM
+
+typedef struct
+{
+	int32_t quot;
+	int32_t rem;
+}DIV_signed_result_t;
+
+typedef struct
+{
+	uint32_t quot;
+	uint32_t rem;
+}DIV_unsigned_result_t;
+
+/*
+ * Las rutinas con resto devuelven el cociente en r0 y el resto en r1. Declararlas devolviendo una estructura de
+ * 8 bytes haria que el compilador la espere a traves de un puntero oculto en r0, por lo que se declaran devolviendo
+ * un entero de 64 bits: cociente en la parte baja y resto en la parte alta.
+ */
+typedef struct
+{
+	int32_t (*sidiv)(int32_t numerator, int32_t denominator);
+	uint32_t (*uidiv)(uint32_t numerator, uint32_t denominator);
+	uint64_t (*sidivmod)(int32_t numerator, int32_t denominator);
+	uint64_t (*uidivmod)(uint32_t numerator, uint32_t denominator);
+}DIV_rom_api_t;
+
+typedef struct
+{
+	const void *RESERVED[4];
+	const DIV_rom_api_t *DIV_API;
+}DIV_rom_driver_table_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_DIV_H_ */
@@ -0,0 +1,132 @@
+/**
+ * @file HRI_DMA.h
+ * @brief Definiciones a nivel de registros del periferico DMA (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_DMA_H_
+#define HRI_DMA_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define			DMA_BASE				0x50008000
+
+#define			DMA_CHANNEL_AMOUNT		25
+
+typedef struct
+{
+	uint32_t ENABLE : 1;
+	uint32_t : 31;
+}DMA_CTRL_reg_t;
+
+typedef struct
+{
+	uint32_t : 1;
+	uint32_t ACTIVEINT : 1;
+	uint32_t ACTIVEERRINT : 1;
+	uint32_t : 29;
+}DMA_INTSTAT_reg_t;
+
+typedef struct
+{
+	uint32_t PERIPHREQEN : 1;
+	uint32_t HWTRIGEN : 1;
+	uint32_t : 2;
+	uint32_t TRIGPOL : 1;
+	uint32_t TRIGTYPE : 1;
+	uint32_t TRIGBURST : 1;
+	uint32_t : 1;
+	uint32_t BURSTPOWER : 4;
+	uint32_t : 2;
+	uint32_t SRCBURSTWRAP : 1;
+	uint32_t DSTBURSTWRAP : 1;
+	uint32_t CHPRIORITY : 3;
+	uint32_t : 13;
+}DMA_CFG_reg_t;
+
+typedef struct
+{
+	const uint32_t VALIDPENDING : 1;
+	uint32_t : 1;
+	const uint32_t TRIG : 1;
+	uint32_t : 29;
+}DMA_CTLSTAT_reg_t;
+
+typedef struct
+{
+	uint32_t CFGVALID : 1;
+	uint32_t RELOAD : 1;
+	uint32_t SWTRIG : 1;
+	uint32_t CLRTRIG : 1;
+	uint32_t SETINTA : 1;
+	uint32_t SETINTB : 1;
+	uint32_t : 2;
+	uint32_t WIDTH : 2;
+	uint32_t : 2;
+	uint32_t SRCINC : 2;
+	uint32_t DSTINC : 2;
+	uint32_t XFERCOUNT : 10;
+	uint32_t : 6;
+}DMA_XFERCFG_reg_t;
+
+typedef struct
+{
+	DMA_CFG_reg_t CFG;
+	const DMA_CTLSTAT_reg_t CTLSTAT;
+	DMA_XFERCFG_reg_t XFERCFG;
+	const uint32_t RESERVED;
+}DMA_channel_reg_t;
+
+typedef struct
+{
+	DMA_CTRL_reg_t CTRL;
+	const DMA_INTSTAT_reg_t INTSTAT;
+	uint32_t SRAMBASE;
+	const uint32_t RESERVED_1[5];
+	uint32_t ENABLESET0;
+	const uint32_t RESERVED_2;
+	uint32_t ENABLECLR0;
+	const uint32_t RESERVED_3;
+	const uint32_t ACTIVE0;
+	const uint32_t RESERVED_4;
+	const uint32_t BUSY0;
+	const uint32_t RESERVED_5;
+	uint32_t ERRINT0;
+	const uint32_t RESERVED_6;
+	uint32_t INTENSET0;
+	const uint32_t RESERVED_7;
+	uint32_t INTENCLR0;
+	const uint32_t RESERVED_8;
+	uint32_t INTA0;
+	const uint32_t RESERVED_9;
+	uint32_t INTB0;
+	const uint32_t RESERVED_10;
+	uint32_t SETVALID0;
+	const uint32_t RESERVED_11;
+	uint32_t SETTRIG0;
+	const uint32_t RESERVED_12;
+	uint32_t ABORT0;
+	const uint32_t RESERVED_13[225];
+	DMA_channel_reg_t CHANNEL[DMA_CHANNEL_AMOUNT];
+}DMA_per_t;
+
+/** Descriptor de canal, ubicado en la tabla apuntada por SRAMBASE */
+typedef struct
+{
+	uint32_t XFERCFG; // Reservado en la tabla, configuracion de transferencia en los descriptores encadenados
+	const volatile void *SOURCE_END;
+	volatile void *DEST_END;
+	const void *LINK;
+}DMA_descriptor_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_DMA_H_ */
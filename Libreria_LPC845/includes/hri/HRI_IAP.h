@@ -0,0 +1,29 @@
+/**
+ * @file HRI_IAP.h
+ * @brief Definiciones a nivel de registros de las rutinas de programacion en aplicacion en ROM (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_IAP_H_
+#define HRI_IAP_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define	IAP_ENTRY_LOCATION			0x0F001FF1 //!< Punto de entrada de las rutinas IAP en ROM (modo Thumb)
+
+#define	IAP_COMMAND_LENGTH			5 //!< Cantidad de palabras del comando
+#define	IAP_RESULT_LENGTH			5 //!< Cantidad de palabras del resultado
+
+typedef void (*IAP_entry_t)(uint32_t *command, uint32_t *result);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_IAP_H_ */
@@ -0,0 +1,232 @@
+/**
+ * @file HRI_IIC.h
+ * @brief Definiciones a nivel de registros del periferico IIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_IIC_H_
+#define HRI_IIC_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define	IIC0_BASE		0x40050000
+#define	IIC1_BASE		0x40054000
+#define	IIC2_BASE		0x40030000
+#define	IIC3_BASE		0x40034000
+
+typedef struct
+{
+	uint32_t MSTEN : 1;
+	uint32_t SLVEN : 1;
+	uint32_t MONEN : 1;
+	uint32_t TIMEOUTEN : 1;
+	uint32_t MONCLKSTR : 1;
+	uint32_t HSCAPABLE : 1;
+	uint32_t : 26;
+}IIC_CFG_reg_t;
+
+typedef struct
+{
+	const uint32_t MSTPENDING : 1;
+	const uint32_t MSTSTATE : 3;
+	uint32_t MSTARBLOSS : 1;
+	uint32_t : 1;
+	uint32_t MSTSTSTPERR : 1;
+	uint32_t : 1;
+	const uint32_t SLVPENDING : 1;
+	const uint32_t SLVSTATE : 2;
+	const uint32_t SLVNOTSTR : 1;
+	const uint32_t SLVIDX : 2;
+	const uint32_t SLVSEL : 1;
+	uint32_t SLVDESEL : 1;
+	const uint32_t MONRDY : 1;
+	uint32_t MONOV : 1;
+	const uint32_t MONACTIVE : 1;
+	uint32_t MONIDLE : 1;
+	uint32_t : 4;
+	uint32_t EVENTTIMEOUT : 1;
+	uint32_t SCLTIMEOUT : 1;
+	uint32_t : 6;
+}IIC_STAT_reg_t;
+
+typedef struct
+{
+	uint32_t MSTPENDINGEN : 1;
+	uint32_t : 3;
+	uint32_t MSTARBLOSSEN : 1;
+	uint32_t : 1;
+	uint32_t MSTSTSTPERREN : 1;
+	uint32_t : 1;
+	uint32_t SLVPENDINGEN : 1;
+	uint32_t : 2;
+	uint32_t SLVNOTSTREN : 1;
+	uint32_t : 3;
+	uint32_t SLVDESELEN : 1;
+	uint32_t MONRDYEN : 1;
+	uint32_t MONOVEN : 1;
+	uint32_t : 1;
+	uint32_t MONIDLEEN : 1;
+	uint32_t : 4;
+	uint32_t EVENTTIMEOUTEN : 1;
+	uint32_t SCLTIMEOUTEN : 1;
+	uint32_t : 6;
+}IIC_INTENSET_reg_t;
+
+typedef struct
+{
+	uint32_t MSTPENDINGCLR : 1;
+	uint32_t : 3;
+	uint32_t MSTARBLOSSCLR : 1;
+	uint32_t : 1;
+	uint32_t MSTSTSTPERRCLR : 1;
+	uint32_t : 1;
+	uint32_t SLVPENDINGCLR : 1;
+	uint32_t : 2;
+	uint32_t SLVNOTSTRCLR : 1;
+	uint32_t : 3;
+	uint32_t SLVDESELCLR : 1;
+	uint32_t MONRDYCLR : 1;
+	uint32_t MONOVCLR : 1;
+	uint32_t : 1;
+	uint32_t MONIDLECLR : 1;
+	uint32_t : 4;
+	uint32_t EVENTTIMEOUTCLR : 1;
+	uint32_t SCLTIMEOUTCLR : 1;
+	uint32_t : 6;
+}IIC_INTENCLR_reg_t;
+
+typedef struct
+{
+	uint32_t TOMIN : 4;
+	uint32_t TO : 12;
+	uint32_t : 16;
+}IIC_TIMEOUT_reg_t;
+
+typedef struct
+{
+	uint32_t DIVVAL : 16;
+	uint32_t : 16;
+}IIC_CLKDIV_reg_t;
+
+typedef struct
+{
+	uint32_t MSTPENDING : 1;
+	uint32_t : 3;
+	uint32_t MSTARBLOSS : 1;
+	uint32_t : 1;
+	uint32_t MSTSTSTPERR : 1;
+	uint32_t : 1;
+	uint32_t SLVPENDING : 1;
+	uint32_t : 2;
+	uint32_t SLVNOTSTR : 1;
+	uint32_t : 3;
+	uint32_t SLVDESEL : 1;
+	uint32_t MONRDY : 1;
+	uint32_t MONOV : 1;
+	uint32_t : 1;
+	uint32_t MONIDLE : 1;
+	uint32_t : 4;
+	uint32_t EVENTTIMEOUT : 1;
+	uint32_t SCLTIMEOUT : 1;
+	uint32_t : 6;
+}IIC_INTSTAT_reg_t;
+
+typedef struct
+{
+	uint32_t MSTCONTINUE : 1;
+	uint32_t MSTSTART : 1;
+	uint32_t MSTSTOP : 1;
+	uint32_t MSTDMA : 1;
+	uint32_t : 28;
+}IIC_MSTCTL_reg_t;
+
+typedef struct
+{
+	uint32_t MSTSCLLOW : 3;
+	uint32_t : 1;
+	uint32_t MSTSCLHIGH : 3;
+	uint32_t : 25;
+}IIC_MSTTIME_reg_t;
+
+typedef struct
+{
+	uint32_t DATA : 8;
+	uint32_t : 24;
+}IIC_MSTDAT_reg_t;
+
+typedef struct
+{
+	uint32_t SLVCONTINUE : 1;
+	uint32_t SLVNACK : 1;
+	uint32_t : 1;
+	uint32_t SLVDMA : 1;
+	uint32_t : 4;
+	uint32_t AUTOACK : 1;
+	uint32_t AUTOMATCHREAD : 1;
+	uint32_t : 22;
+}IIC_SLVCTL_reg_t;
+
+typedef struct
+{
+	uint32_t DATA : 8;
+	uint32_t : 24;
+}IIC_SLVDAT_reg_t;
+
+typedef struct
+{
+	uint32_t SADISABLE : 1;
+	uint32_t SLVADR : 7;
+	uint32_t : 7;
+	uint32_t AUTONACK : 1;
+	uint32_t : 16;
+}IIC_SLVADR_reg_t;
+
+typedef struct
+{
+	uint32_t QUALMODE0 : 1;
+	uint32_t SLVQUAL0 : 7;
+	uint32_t : 24;
+}IIC_SLVQUAL0_reg_t;
+
+typedef struct
+{
+	uint32_t MONRXDAT : 8;
+	uint32_t MONSTART : 1;
+	uint32_t MONRESTART : 1;
+	uint32_t MONNACK : 1;
+	uint32_t : 21;
+}IIC_MONRXDAT_reg_t;
+
+typedef struct
+{
+	IIC_CFG_reg_t CFG;
+	IIC_STAT_reg_t STAT;
+	IIC_INTENSET_reg_t INTENSET;
+	IIC_INTENCLR_reg_t INTENCLR;
+	IIC_TIMEOUT_reg_t TIMEOUT;
+	IIC_CLKDIV_reg_t CLKDIV;
+	const IIC_INTSTAT_reg_t INTSTAT;
+	const uint32_t RESERVED_1;
+	IIC_MSTCTL_reg_t MSTCTL;
+	IIC_MSTTIME_reg_t MSTTIME;
+	IIC_MSTDAT_reg_t MSTDAT;
+	const uint32_t RESERVED_2[5];
+	IIC_SLVCTL_reg_t SLVCTL;
+	IIC_SLVDAT_reg_t SLVDAT;
+	IIC_SLVADR_reg_t SLVADR[4];
+	IIC_SLVQUAL0_reg_t SLVQUAL0;
+	const uint32_t RESERVED_3[9];
+	const IIC_MONRXDAT_reg_t MONRXDAT;
+}IIC_per_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_IIC_H_ */
@@ -0,0 +1,37 @@
+/**
+ * @file HRI_INPUTMUX.h
+ * @brief Definiciones a nivel de registros del multiplexor de entradas (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_INPUTMUX_H_
+#define HRI_INPUTMUX_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define			INPUTMUX_BASE			0x4002C000
+
+typedef struct
+{
+	uint32_t INP : 5;
+	uint32_t : 27;
+}INPUTMUX_SCT_INMUX_reg_t;
+
+typedef struct
+{
+	uint32_t DMA_INMUX[2];
+	const uint32_t RESERVED_1[6];
+	INPUTMUX_SCT_INMUX_reg_t SCT_INMUX[4];
+}INPUTMUX_per_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_INPUTMUX_H_ */
@@ -0,0 +1,119 @@
+/**
+ * @file HRI_SCB.h
+ * @brief Definiciones a nivel de registros del bloque de control del sistema SCB (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_SCB_H_
+#define HRI_SCB_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define	SCB_BASE	0xE000ED00 //!< Base del bloque de control del sistema
+
+typedef struct
+{
+	uint32_t REVISION : 4;
+	uint32_t PARTNO : 12;
+	uint32_t ARCHITECTURE : 4;
+	uint32_t VARIANT : 4;
+	uint32_t IMPLEMENTER : 8;
+}SCB_CPUID_reg_t;
+
+typedef struct
+{
+	uint32_t VECTACTIVE : 6;
+	uint32_t : 6;
+	uint32_t VECTPENDING : 6;
+	uint32_t : 4;
+	uint32_t ISRPENDING : 1;
+	uint32_t : 2;
+	uint32_t PENDSTCLR : 1;
+	uint32_t PENDSTSET : 1;
+	uint32_t PENDSVCLR : 1;
+	uint32_t PENDSVSET : 1;
+	uint32_t : 2;
+	uint32_t NMIPENDSET : 1;
+}SCB_ICSR_reg_t;
+
+typedef struct
+{
+	uint32_t : 7;
+	uint32_t TBLOFF : 25;
+}SCB_VTOR_reg_t;
+
+typedef struct
+{
+	uint32_t : 1;
+	uint32_t VECTCLRACTIVE : 1;
+	uint32_t SYSRESETREQ : 1;
+	uint32_t : 12;
+	uint32_t ENDIANNESS : 1;
+	uint32_t VECTKEY : 16;
+}SCB_AIRCR_reg_t;
+
+typedef struct
+{
+	uint32_t : 1;
+	uint32_t SLEEPONEXIT : 1;
+	uint32_t SLEEPDEEP : 1;
+	uint32_t : 1;
+	uint32_t SEVONPEND : 1;
+	uint32_t : 27;
+}SCB_SCR_reg_t;
+
+typedef struct
+{
+	uint32_t : 3;
+	uint32_t UNALIGN_TRP : 1;
+	uint32_t : 5;
+	uint32_t STKALIGN : 1;
+	uint32_t : 22;
+}SCB_CCR_reg_t;
+
+typedef struct
+{
+	uint32_t : 30;
+	uint32_t PRI_11 : 2;
+}SCB_SHPR2_reg_t;
+
+typedef struct
+{
+	uint32_t : 22;
+	uint32_t PRI_14 : 2;
+	uint32_t : 6;
+	uint32_t PRI_15 : 2;
+}SCB_SHPR3_reg_t;
+
+typedef struct
+{
+	uint32_t : 15;
+	uint32_t SVCALLPENDED : 1;
+	uint32_t : 16;
+}SCB_SHCSR_reg_t;
+
+typedef struct
+{
+	const SCB_CPUID_reg_t CPUID;
+	SCB_ICSR_reg_t ICSR;
+	SCB_VTOR_reg_t VTOR;
+	SCB_AIRCR_reg_t AIRCR;
+	SCB_SCR_reg_t SCR;
+	const SCB_CCR_reg_t CCR;
+	const uint32_t RESERVED;
+	SCB_SHPR2_reg_t SHPR2;
+	SCB_SHPR3_reg_t SHPR3;
+	SCB_SHCSR_reg_t SHCSR;
+}SCB_per_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_SCB_H_ */
@@ -0,0 +1,129 @@
+/**
+ * @file HRI_SCT.h
+ * @brief Definiciones a nivel de registros del periferico SCT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_SCT_H_
+#define HRI_SCT_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define			SCT_BASE				0x50004000
+
+#define			SCT_EVENT_AMOUNT		8
+#define			SCT_STATE_AMOUNT		8
+#define			SCT_MATCH_AMOUNT		8
+#define			SCT_INPUT_AMOUNT		4
+#define			SCT_OUTPUT_AMOUNT		7
+
+typedef struct
+{
+	uint32_t UNIFY : 1;
+	uint32_t CLKMODE : 2;
+	uint32_t CKSEL : 4;
+	uint32_t NORELOAD_L : 1;
+	uint32_t NORELOAD_H : 1;
+	uint32_t INSYNC : 4;
+	uint32_t : 4;
+	uint32_t AUTOLIMIT_L : 1;
+	uint32_t AUTOLIMIT_H : 1;
+	uint32_t : 13;
+}SCT_CONFIG_reg_t;
+
+typedef struct
+{
+	uint32_t DOWN_L : 1;
+	uint32_t STOP_L : 1;
+	uint32_t HALT_L : 1;
+	uint32_t CLRCTR_L : 1;
+	uint32_t BIDIR_L : 1;
+	uint32_t PRE_L : 8;
+	uint32_t : 3;
+	uint32_t DOWN_H : 1;
+	uint32_t STOP_H : 1;
+	uint32_t HALT_H : 1;
+	uint32_t CLRCTR_H : 1;
+	uint32_t BIDIR_H : 1;
+	uint32_t PRE_H : 8;
+	uint32_t : 3;
+}SCT_CTRL_reg_t;
+
+typedef struct
+{
+	uint32_t STATE_L : 5;
+	uint32_t : 11;
+	uint32_t STATE_H : 5;
+	uint32_t : 11;
+}SCT_STATE_reg_t;
+
+typedef struct
+{
+	uint32_t MATCHSEL : 4;
+	uint32_t HEVENT : 1;
+	uint32_t OUTSEL : 1;
+	uint32_t IOSEL : 4;
+	uint32_t IOCOND : 2;
+	uint32_t COMBMODE : 2;
+	uint32_t STATELD : 1;
+	uint32_t STATEV : 5;
+	uint32_t MATCHMEM : 1;
+	uint32_t DIRECTION : 2;
+	uint32_t : 9;
+}SCT_EV_CTRL_reg_t;
+
+typedef struct
+{
+	uint32_t STATE;
+	SCT_EV_CTRL_reg_t CTRL;
+}SCT_EV_t;
+
+typedef struct
+{
+	uint32_t SET;
+	uint32_t CLR;
+}SCT_OUT_t;
+
+typedef struct
+{
+	SCT_CONFIG_reg_t CONFIG;
+	SCT_CTRL_reg_t CTRL;
+	uint32_t LIMIT;
+	uint32_t HALT;
+	uint32_t STOP;
+	uint32_t START;
+	const uint32_t RESERVED_1[10];
+	uint32_t COUNT;
+	SCT_STATE_reg_t STATE;
+	const uint32_t INPUT;
+	uint32_t REGMODE;
+	uint32_t OUTPUT;
+	uint32_t OUTPUTDIRCTRL;
+	uint32_t RES;
+	uint32_t DMAREQ0;
+	uint32_t DMAREQ1;
+	const uint32_t RESERVED_2[35];
+	uint32_t EVEN;
+	uint32_t EVFLAG;
+	uint32_t CONEN;
+	uint32_t CONFLAG;
+	uint32_t MATCH[SCT_MATCH_AMOUNT]; // En modo captura son los registros CAP
+	const uint32_t RESERVED_3[56];
+	uint32_t MATCHREL[SCT_MATCH_AMOUNT]; // En modo captura son los registros CAPCTRL
+	const uint32_t RESERVED_4[56];
+	SCT_EV_t EV[SCT_EVENT_AMOUNT];
+	const uint32_t RESERVED_5[112];
+	SCT_OUT_t OUT[SCT_OUTPUT_AMOUNT];
+}SCT_per_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_SCT_H_ */
@@ -0,0 +1,76 @@
+/**
+ * @file HRI_WWDT.h
+ * @brief Definiciones a nivel de registros del periferico WWDT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HRI_WWDT_H_
+#define HRI_WWDT_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define			WWDT_BASE		0x40000000
+
+typedef struct
+{
+	uint32_t WDEN : 1;
+	uint32_t WDRESET : 1;
+	uint32_t WDTOF : 1;
+	uint32_t WDINT : 1;
+	uint32_t WDPROTECT : 1;
+	uint32_t LOCK : 1;
+	uint32_t : 26;
+}WWDT_MOD_reg_t;
+
+typedef struct
+{
+	uint32_t COUNT : 24;
+	uint32_t : 8;
+}WWDT_TC_reg_t;
+
+typedef struct
+{
+	uint32_t FEED : 8;
+	uint32_t : 24;
+}WWDT_FEED_reg_t;
+
+typedef struct
+{
+	uint32_t COUNT : 24;
+	uint32_t : 8;
+}WWDT_TV_reg_t;
+
+typedef struct
+{
+	uint32_t WARNINT : 10;
+	uint32_t : 22;
+}WWDT_WARNINT_reg_t;
+
+typedef struct
+{
+	uint32_t WINDOW : 24;
+	uint32_t : 8;
+}WWDT_WINDOW_reg_t;
+
+typedef struct
+{
+	WWDT_MOD_reg_t MOD;
+	WWDT_TC_reg_t TC;
+	WWDT_FEED_reg_t FEED;
+	const WWDT_TV_reg_t TV;
+	const uint32_t RESERVED_1;
+	WWDT_WARNINT_reg_t WARNINT;
+	WWDT_WINDOW_reg_t WINDOW;
+}WWDT_per_t;
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HRI_WWDT_H_ */
@@ -6,12 +6,69 @@
  * @version 1.0
  */
 
+#include <stddef.h>
 #include <HPL_SYSCON.h>
 #include <HPL_NVIC.h>
 #include <HPL_SWM.h>
 #include <HPL_IOCON.h>
 #include <HPL_ACMP.h>
 #include <HAL_ACMP.h>
+#include <HAL_CTIMER.h>
+#include <HAL_DIV.h>
+
+/** Cantidad de décimas de grado en un ciclo completo */
+#define		ZERO_CROSS_FULL_CYCLE		(3600)
+
+/** Estado de la detección de cruces por cero */
+typedef struct
+{
+	hal_ctimer_capture_sel_en capture; /**< Canal de captura utilizado */
+	hal_ctimer_match_sel_en match; /**< Canal de match utilizado */
+	hal_gpio_portpin_en portpin; /**< Pin utilizado */
+	uint8_t edges_per_cycle; /**< Cantidad de cruces detectados por ciclo de la señal */
+	volatile uint8_t captures; /**< Cantidad de cruces detectados, saturada en 2 */
+	volatile uint16_t phase_angle; /**< Ángulo del callback en décimas de grado */
+	volatile uint32_t period; /**< Cuentas entre los dos últimos cruces */
+	volatile uint32_t last; /**< Valor capturado en el último cruce */
+	void (*callback)(void); /**< Callback sincronizado en fase */
+	hal_div_reciprocal_t full_cycle; /**< Parámetros de división por @ref ZERO_CROSS_FULL_CYCLE */
+}acmp_zero_cross_t;
+
+static acmp_zero_cross_t zero_cross = {
+	.captures = 0,
+	.callback = NULL
+};
+
+/** Cantidad de bits de la conversión por aproximaciones sucesivas */
+#define		LADDER_SAR_BITS				(5)
+
+/** Estado de la supervisión de ventana */
+typedef struct
+{
+	volatile uint8_t active; /**< Flag de supervisión activa */
+	volatile uint8_t armed_high; /**< Flag de umbral superior armado (caso contrario, el inferior) */
+	volatile uint8_t outside_low; /**< Flag de entrada por debajo de la banda ya reportada */
+	volatile uint8_t outside_high; /**< Flag de entrada por encima de la banda ya reportada */
+	uint8_t low_step; /**< Paso de la ladder del umbral inferior */
+	uint8_t high_step; /**< Paso de la ladder del umbral superior */
+	uint32_t settle_loops; /**< Iteraciones de espera de establecimiento */
+	hal_acmp_window_callback_t callback; /**< Callback de salida de la banda */
+}acmp_window_t;
+
+static acmp_window_t window = {
+	.active = 0,
+	.callback = NULL
+};
+
+static void hal_acmp_settle(uint32_t settle_loops);
+
+static void hal_acmp_window_arm(uint8_t high);
+
+static void hal_acmp_window_check(void);
+
+static void hal_acmp_zero_cross_capture_irq(void);
+
+static uint32_t hal_acmp_zero_cross_angle_to_ticks(uint32_t period, uint16_t angle);
 
 /**
  * @brief Inicialización del periférico Comparador Analógico.
@@ -235,3 +292,459 @@ void hal_acmp_output_pin_clear()
 	SWM_assign_COMP0_OUT(HAL_GPIO_PORTPIN_TO_PORT(0xFF), HAL_GPIO_PORTPIN_TO_PIN(0xFF));
 	SWM_deinit();
 }
+
+/**
+ * @brief Realiza una conversión de 5 bits de una entrada por búsqueda binaria sobre la *Voltage Ladder*.
+ *
+ * Al finalizar, las entradas, el paso y la habilitación de la ladder, y la habilitación de interrupciones del
+ * comparador son restaurados a sus valores previos.
+ *
+ * @param[in] input Entrada a convertir. No puede ser la salida de la ladder.
+ * @param[in] settle_loops Iteraciones de espera de establecimiento en cada paso.
+ * @return Paso de la ladder más alto cuya tensión es menor a la de la entrada (0 a 31).
+ * @pre Comparador inicializado, referencia de la ladder configurada y pines de la entrada configurados mediante
+ * hal_acmp_input_select().
+ * @see hal_acmp_ladder_sar_cycles_get
+ */
+uint8_t hal_acmp_ladder_sar_read(hal_acmp_input_voltage_sel_en input, uint32_t settle_loops)
+{
+	ACMP_input_voltage_sel_en saved_positive = ACMP_positive_input_get();
+	ACMP_input_voltage_sel_en saved_negative = ACMP_negative_input_get();
+	uint8_t saved_step = ACMP_ladder_step_get();
+	uint8_t saved_ladder_enable = ACMP_ladder_enabled_get();
+	uint8_t saved_interrupt_enable = ACMP_interrupt_enabled_get();
+	uint8_t result = 0;
+	uint8_t bit;
+
+	// Los flancos generados durante la busqueda no deben generar interrupciones
+	ACMP_interrupt_disable();
+
+	ACMP_voltage_input_select(input, ACMP_INPUT_VOLTAGE_VLADDER_OUT);
+	ACMP_ladder_enable();
+
+	for(bit = (1 << (LADDER_SAR_BITS - 1)); bit != 0; bit >>= 1)
+	{
+		ACMP_ladder_step_set(result | bit);
+		hal_acmp_settle(settle_loops);
+
+		// Salida en alto implica entrada mayor a la tension de la ladder
+		if(ACMP_output_status_get())
+		{
+			result |= bit;
+		}
+	}
+
+	ACMP_ladder_step_set(saved_step);
+	ACMP_voltage_input_select(saved_positive, saved_negative);
+
+	if(!saved_ladder_enable)
+	{
+		ACMP_ladder_disable();
+	}
+
+	ACMP_interrupt_clear();
+
+	if(saved_interrupt_enable)
+	{
+		ACMP_interrupt_enable();
+	}
+
+	return result;
+}
+
+/**
+ * @brief Obtener el costo aproximado en ciclos de CPU de una conversión por aproximaciones sucesivas.
+ * @param[in] settle_loops Iteraciones de espera de establecimiento en cada paso.
+ * @return Ciclos de CPU aproximados de una llamada a hal_acmp_ladder_sar_read().
+ */
+uint32_t hal_acmp_ladder_sar_cycles_get(uint32_t settle_loops)
+{
+	return (LADDER_SAR_BITS * (HAL_ACMP_LADDER_SAR_CYCLES_PER_STEP + (settle_loops * HAL_ACMP_LADDER_SAR_CYCLES_PER_SETTLE_LOOP))) +
+			HAL_ACMP_LADDER_SAR_CYCLES_OVERHEAD;
+}
+
+/**
+ * @brief Comienza la supervisión de ventana de una entrada.
+ *
+ * Si al comenzar la entrada ya se encuentra fuera de la banda, el callback se ejecuta inmediatamente.
+ *
+ * @param[in] config Puntero a estructura con parámetros de configuración deseados.
+ * @pre Comparador inicializado, referencia de la ladder configurada y pines de la entrada configurados mediante
+ * hal_acmp_input_select().
+ * @see hal_acmp_window_watch_tick
+ * @see hal_acmp_window_watch_stop
+ */
+void hal_acmp_window_watch_start(const hal_acmp_window_config_t *config)
+{
+	NVIC_disable_interrupt(NVIC_IRQ_SEL_CMP_CAPT);
+
+	window.low_step = config->low_step & 0x1F;
+	window.high_step = config->high_step & 0x1F;
+	window.settle_loops = config->settle_loops;
+	window.callback = config->callback;
+	window.outside_low = 0;
+	window.outside_high = 0;
+	window.active = 1;
+
+	ACMP_voltage_input_select(config->input, ACMP_INPUT_VOLTAGE_VLADDER_OUT);
+	ACMP_ladder_enable();
+
+	// Se verifican ambos umbrales antes de habilitar la interrupcion
+	hal_acmp_window_arm(0);
+	hal_acmp_window_check();
+	hal_acmp_window_arm(1);
+	hal_acmp_window_check();
+
+	ACMP_interrupt_clear();
+	ACMP_interrupt_enable();
+
+	NVIC_enable_interrupt(NVIC_IRQ_SEL_CMP_CAPT);
+}
+
+/**
+ * @brief Alterna el umbral armado de la supervisión de ventana.
+ *
+ * Debe ser llamada periódicamente. Puede ser llamada desde un contexto de interrupción.
+ *
+ * @see hal_acmp_window_watch_start
+ */
+void hal_acmp_window_watch_tick(void)
+{
+	uint8_t irq_enabled;
+
+	if(!window.active)
+	{
+		return;
+	}
+
+	irq_enabled = NVIC_get_enabled_interrupt(NVIC_IRQ_SEL_CMP_CAPT);
+	NVIC_disable_interrupt(NVIC_IRQ_SEL_CMP_CAPT);
+
+	hal_acmp_window_arm(!window.armed_high);
+
+	// El cambio de umbral puede haber marcado un flanco que no corresponde a una salida de la banda
+	ACMP_interrupt_clear();
+
+	hal_acmp_window_check();
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_CMP_CAPT);
+	}
+}
+
+/**
+ * @brief Detiene la supervisión de ventana.
+ * @see hal_acmp_window_watch_start
+ */
+void hal_acmp_window_watch_stop(void)
+{
+	ACMP_interrupt_disable();
+	ACMP_interrupt_clear();
+
+	window.active = 0;
+	window.callback = NULL;
+}
+
+/**
+ * @brief Inicializa la detección de cruces por cero con marcas de tiempo del *CTIMER*.
+ *
+ * Asigna la salida del comparador y el canal de captura al mismo pin, y configura la interrupción de captura.
+ * Si se especifica un callback, además configura el canal de match para ejecutarlo en el ángulo indicado.
+ *
+ * @param[in] config Puntero a estructura con parámetros de configuración deseados.
+ * @pre Comparador configurado e inicializado, y *CTIMER* inicializado en modo timer y contando.
+ * @see hal_acmp_zero_cross_config_t
+ * @see hal_acmp_zero_cross_deinit
+ */
+void hal_acmp_zero_cross_init(const hal_acmp_zero_cross_config_t *config)
+{
+	hal_ctimer_capture_config_t capture_config;
+
+	zero_cross.capture = config->capture;
+	zero_cross.match = config->match;
+	zero_cross.portpin = config->portpin;
+	zero_cross.phase_angle = config->phase_angle % ZERO_CROSS_FULL_CYCLE;
+	zero_cross.captures = 0;
+	zero_cross.period = 0;
+	zero_cross.callback = config->callback;
+	hal_div_reciprocal_init(&zero_cross.full_cycle, ZERO_CROSS_FULL_CYCLE);
+
+	if(config->callback != NULL)
+	{
+		hal_ctimer_match_config_t match_config = {
+			.interrupt_on_match = 1,
+			.reset_on_match = 0,
+			.stop_on_match = 0,
+			.reload_on_match = 0,
+			.match_value_useg = 0,
+			.match_action = HAL_CTIMER_MATCH_DO_NOTHING,
+			.enable_external_pin = 0,
+			.callback = config->callback
+		};
+
+		hal_ctimer_timer_mode_match_config(config->match, &match_config);
+
+		// Hasta el primer cruce, el match queda lo mas lejos posible en el futuro
+		hal_ctimer_timer_mode_match_change_ticks(config->match, hal_ctimer_timer_mode_counter_read() - 1);
+	}
+
+	// La salida del comparador vuelve a entrar al CTIMER a traves del pin
+	hal_acmp_output_pin_set(config->portpin);
+
+	switch(config->edge_sel)
+	{
+	case HAL_ACMP_EDGE_FALLING: { capture_config.edge = HAL_CTIMER_CAPTURE_EDGE_FALLING; zero_cross.edges_per_cycle = 1; break; }
+	case HAL_ACMP_EDGE_RISING: { capture_config.edge = HAL_CTIMER_CAPTURE_EDGE_RISING; zero_cross.edges_per_cycle = 1; break; }
+	default: { capture_config.edge = HAL_CTIMER_CAPTURE_EDGE_BOTH; zero_cross.edges_per_cycle = 2; break; }
+	}
+
+	capture_config.interrupt_on_capture = 1;
+	capture_config.enable_external_pin = 1;
+	capture_config.capture_pin = config->portpin;
+	capture_config.callback = hal_acmp_zero_cross_capture_irq;
+
+	hal_ctimer_timer_mode_capture_config(config->capture, &capture_config);
+}
+
+/**
+ * @brief De-inicializa la detección de cruces por cero.
+ *
+ * Libera el canal de captura, el canal de match y el pin utilizados.
+ *
+ * @see hal_acmp_zero_cross_init
+ */
+void hal_acmp_zero_cross_deinit(void)
+{
+	hal_ctimer_capture_config_t capture_config = {
+		.edge = HAL_CTIMER_CAPTURE_EDGE_RISING,
+		.interrupt_on_capture = 0,
+		.enable_external_pin = 0,
+		.capture_pin = HAL_GPIO_PORTPIN_NOT_USED,
+		.callback = NULL
+	};
+
+	hal_ctimer_timer_mode_capture_config(zero_cross.capture, &capture_config);
+
+	if(zero_cross.callback != NULL)
+	{
+		hal_ctimer_match_config_t match_config = {
+			.interrupt_on_match = 0,
+			.reset_on_match = 0,
+			.stop_on_match = 0,
+			.reload_on_match = 0,
+			.match_value_useg = 0,
+			.match_action = HAL_CTIMER_MATCH_DO_NOTHING,
+			.enable_external_pin = 0,
+			.callback = NULL
+		};
+
+		hal_ctimer_timer_mode_match_config(zero_cross.match, &match_config);
+		zero_cross.callback = NULL;
+	}
+
+	hal_acmp_output_pin_clear();
+
+	zero_cross.captures = 0;
+}
+
+/**
+ * @brief Cambia el ángulo del callback sincronizado en fase.
+ *
+ * El nuevo ángulo se hace efectivo a partir del próximo cruce.
+ *
+ * @param[in] phase_angle Ángulo respecto del cruce, en décimas de grado (0 a 3599).
+ */
+void hal_acmp_zero_cross_set_phase(uint16_t phase_angle)
+{
+	zero_cross.phase_angle = phase_angle % ZERO_CROSS_FULL_CYCLE;
+}
+
+/**
+ * @brief Obtener las mediciones de la señal.
+ * @param[out] data Puntero a estructura donde guardar las mediciones.
+ * @return Resultado de la operación.
+ * @see hal_acmp_zero_cross_data_t
+ */
+hal_acmp_zero_cross_result_en hal_acmp_zero_cross_get(hal_acmp_zero_cross_data_t *data)
+{
+	uint8_t irq_enabled;
+	uint8_t captures;
+	uint32_t period;
+	uint32_t last;
+	uint32_t elapsed;
+
+	// Periodo y ultimo cruce se leen de manera consistente con la interrupcion inhibida
+	irq_enabled = NVIC_get_enabled_interrupt(NVIC_IRQ_SEL_CTIMER);
+	NVIC_disable_interrupt(NVIC_IRQ_SEL_CTIMER);
+
+	captures = zero_cross.captures;
+	period = zero_cross.period;
+	last = zero_cross.last;
+	elapsed = hal_ctimer_timer_mode_counter_read() - last;
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_CTIMER);
+	}
+
+	if((captures < 2) || (period == 0))
+	{
+		return HAL_ACMP_ZERO_CROSS_RESULT_NOT_LOCKED;
+	}
+
+	data->period_ticks = period;
+	data->last_crossing = last;
+	// Con cruces en ambos flancos el periodo medido es medio ciclo de la señal
+	data->frequency_mhz = (uint32_t) (hal_div_unsigned_64((uint64_t) hal_ctimer_timer_mode_clock_get() * 1000, period) >> (zero_cross.edges_per_cycle - 1));
+
+	// Si el cruce siguiente se demora mas de un periodo, la fase satura
+	if(elapsed >= period)
+	{
+		data->phase = ZERO_CROSS_FULL_CYCLE - 1;
+	}
+	else
+	{
+		data->phase = (uint16_t) hal_div_unsigned_64((uint64_t) elapsed * ZERO_CROSS_FULL_CYCLE, period);
+	}
+
+	return HAL_ACMP_ZERO_CROSS_RESULT_OK;
+}
+
+/**
+ * @brief Espera de establecimiento de la ladder y el comparador
+ * @param[in] settle_loops Cantidad de iteraciones de espera
+ */
+static void hal_acmp_settle(uint32_t settle_loops)
+{
+	volatile uint32_t counter;
+
+	for(counter = settle_loops; counter > 0; counter--);
+}
+
+/**
+ * @brief Armar uno de los umbrales de la supervisión de ventana
+ *
+ * El flanco se configura antes de mover la ladder, de modo que el propio cambio de umbral no marque un flanco de
+ * salida de la banda.
+ *
+ * @param[in] high Si es distinto de cero se arma el umbral superior, caso contrario el inferior
+ */
+static void hal_acmp_window_arm(uint8_t high)
+{
+	if(high)
+	{
+		ACMP_edge_select(ACMP_EDGE_RISING);
+		ACMP_ladder_step_set(window.high_step);
+	}
+	else
+	{
+		ACMP_edge_select(ACMP_EDGE_FALLING);
+		ACMP_ladder_step_set(window.low_step);
+	}
+
+	window.armed_high = high;
+
+	hal_acmp_settle(window.settle_loops);
+}
+
+/**
+ * @brief Verificar la salida del comparador respecto del umbral armado y reportar salidas de la banda
+ */
+static void hal_acmp_window_check(void)
+{
+	uint8_t output = ACMP_output_status_get();
+
+	if(window.callback == NULL)
+	{
+		return;
+	}
+
+	if(window.armed_high)
+	{
+		if(!output)
+		{
+			window.outside_high = 0;
+		}
+		else if(!window.outside_high)
+		{
+			window.outside_high = 1;
+			window.callback(HAL_ACMP_WINDOW_EVENT_ABOVE);
+		}
+	}
+	else
+	{
+		if(output)
+		{
+			window.outside_low = 0;
+		}
+		else if(!window.outside_low)
+		{
+			window.outside_low = 1;
+			window.callback(HAL_ACMP_WINDOW_EVENT_BELOW);
+		}
+	}
+}
+
+/**
+ * @brief Callback de captura del *CTIMER* para la detección de cruces por cero
+ *
+ * Actualiza el período medido y, si corresponde, programa el canal de match para el próximo callback sincronizado
+ * en fase. Ángulos cuyo tiempo sea menor a la latencia de esta interrupción se pierden en ese ciclo.
+ */
+static void hal_acmp_zero_cross_capture_irq(void)
+{
+	uint32_t now = hal_ctimer_timer_mode_capture_read(zero_cross.capture);
+
+	if(zero_cross.captures > 0)
+	{
+		zero_cross.period = now - zero_cross.last;
+
+		if(zero_cross.captures < 2)
+		{
+			zero_cross.captures++;
+		}
+	}
+	else
+	{
+		zero_cross.captures = 1;
+	}
+
+	zero_cross.last = now;
+
+	if((zero_cross.callback != NULL) && (zero_cross.captures >= 2))
+	{
+		hal_ctimer_timer_mode_match_change_ticks(zero_cross.match,
+				now + hal_acmp_zero_cross_angle_to_ticks(zero_cross.period, zero_cross.phase_angle));
+	}
+}
+
+/**
+ * @brief Convertir un ángulo en cuentas del *CTIMER* para un período dado
+ * @param[in] period Período en cuentas del *CTIMER*
+ * @param[in] angle Ángulo en décimas de grado
+ * @return Cuentas correspondientes al ángulo
+ */
+static uint32_t hal_acmp_zero_cross_angle_to_ticks(uint32_t period, uint16_t angle)
+{
+	// Para los periodos habituales alcanza con aritmetica de 32 bits, mucho mas rapida en Cortex-M0+
+	if(period <= (0xFFFFFFFF / ZERO_CROSS_FULL_CYCLE))
+	{
+		return hal_div_reciprocal_apply(&zero_cross.full_cycle, period * angle);
+	}
+
+	return (uint32_t) hal_div_unsigned_64((uint64_t) period * angle, ZERO_CROSS_FULL_CYCLE);
+}
+
+/**
+ * @brief Interrupción del comparador analógico
+ */
+void CMP_IRQHandler(void)
+{
+	ACMP_interrupt_clear();
+
+	if(window.active)
+	{
+		hal_acmp_window_check();
+	}
+}
@@ -9,7 +9,10 @@
 
 #include <stddef.h>
 #include <HAL_ADC.h>
+#include <HAL_DIV.h>
 #include <HAL_SYSCON.h>
+#include <HAL_STARTUP.h>
+#include <HAL_RAMFUNC.h>
 #include <HPL_ADC.h>
 #include <HPL_SYSCON.h>
 #include <HPL_SWM.h>
@@ -22,6 +25,9 @@
 /** Máxima frecuencia de conversión admitida por el ADC (modo asincrónico) */
 #define	ADC_MAX_FREQ_ASYNC		((uint32_t) 0.6e6)
 
+/** Frecuencia de clock del *ADC* durante la calibración de hardware */
+#define	ADC_CALIB_FREQ			(500000)
+
 /** Cantidad de ciclos de clock necesarios por el *ADC* para generar una conversión */
 #define	ADC_CYCLE_DELAY			(25)
 
@@ -30,6 +36,8 @@
 
 static void dummy_irq_callback(void* data);
 
+static hal_startup_deferred_t adc_calibration; //!< Calibración de hardware diferida hasta el primer uso
+
 /** Callback cuando terminan las secuencias de conversión */
 static void (*adc_seq_completed_callback[2])(void *) =
 {
@@ -67,6 +75,47 @@ static flag_sequence_burst_mode_t flag_seq_burst_mode =
 	.SEQB_burst = 0
 };
 
+/** Acumuladores de la ventana de estadísticas de un canal */
+typedef struct
+{
+	uint32_t samples; /**< Cantidad de muestras acumuladas */
+	uint32_t sum; /**< Suma de las muestras */
+	uint64_t sum_sq; /**< Suma de los cuadrados de las muestras */
+	uint16_t min; /**< Mínimo acumulado */
+	uint16_t max; /**< Máximo acumulado */
+	uint8_t saturated; /**< Flag de muestras descartadas por límite de ventana */
+}adc_stats_accumulator_t;
+
+/** Acumuladores de estadísticas de cada canal */
+static adc_stats_accumulator_t adc_stats[ADC_CHANNEL_AMOUNT];
+
+/** Canales con estadísticas habilitadas en cada secuencia */
+static uint16_t adc_stats_channels[2] = {
+	0,
+	0
+};
+
+/**
+ * Resultados leídos en la interrupción para los canales con estadísticas habilitadas. Dado que la lectura del
+ * registro de canal limpia su flag de dato válido, se guardan para @ref hal_adc_sequence_get_result
+ */
+static volatile uint16_t adc_stats_latched_result[ADC_CHANNEL_AMOUNT];
+
+/** Flags de resultados guardados pendientes de ser leídos por el usuario. Cada bit representa el canal */
+static volatile uint16_t adc_stats_latched_valid = 0;
+
+static void hal_adc_stats_reset_channel(uint8_t channel);
+
+static uint8_t hal_adc_stats_lock(void);
+
+static void hal_adc_stats_unlock(uint8_t lock_state);
+
+static inline void hal_adc_stats_update(ADC_sequence_sel_en sequence);
+
+static uint32_t hal_adc_stats_isqrt(uint32_t value);
+
+static void hal_adc_hardware_calib(void);
+
 void hal_adc_init_async_mode(uint32_t sample_freq, uint8_t div, hal_adc_clock_source_en clock_source, hal_adc_low_power_mode_en low_power)
 {
 	uint32_t aux;
@@ -81,8 +130,6 @@ void hal_adc_init_async_mode(uint32_t sample_freq, uint8_t div, hal_adc_clock_so
 
 	ADC_set_vrange(ADC_VRANGE_HIGH_VOLTAGE);
 
-	ADC_hardware_calib(hal_syscon_system_clock_get() / 500e3);
-
 	if(sample_freq > ADC_MAX_FREQ_ASYNC)
 	{
 		sample_freq = ADC_MAX_FREQ_ASYNC;
@@ -96,16 +143,19 @@ void hal_adc_init_async_mode(uint32_t sample_freq, uint8_t div, hal_adc_clock_so
 	 */
 	if(clock_source == HAL_ADC_CLOCK_SOURCE_FRO)
 	{
-		aux = hal_syscon_fro_clock_get() / sample_freq;
+		aux = hal_div_unsigned(hal_syscon_fro_clock_get(), sample_freq);
 	}
 	else
 	{
-		aux = hal_syscon_pll_clock_get() / sample_freq;
+		aux = hal_div_unsigned(hal_syscon_pll_clock_get(), sample_freq);
 	}
 
 	SYSCON_set_adc_clock(clock_source, (uint8_t) aux);
 
 	ADC_control_config(div, ADC_OPERATION_MODE_ASYNCHRONOUS, low_power);
+
+	// La calibración se realiza al configurar la primera secuencia
+	hal_startup_deferred_register(&adc_calibration, hal_adc_hardware_calib);
 }
 
 void hal_adc_init_sync_mode(uint32_t sample_freq, hal_adc_low_power_mode_en low_power)
@@ -121,8 +171,6 @@ void hal_adc_init_sync_mode(uint32_t sample_freq, hal_adc_low_power_mode_en low_
 	SYSCON_set_adc_clock(SYSCON_ADC_CLOCK_SEL_FRO, 1);
 	ADC_set_vrange(ADC_VRANGE_HIGH_VOLTAGE);
 
-	ADC_hardware_calib(hal_syscon_system_clock_get() / 500e3);
-
 	// El cálculo de la frecuencia de muestreo se hace con la frecuencia del main clock
 
 	if(sample_freq > ADC_MAX_FREQ_SYNC)
@@ -132,7 +180,7 @@ void hal_adc_init_sync_mode(uint32_t sample_freq, hal_adc_low_power_mode_en low_
 
 	sample_freq *= ADC_CYCLE_DELAY;
 
-	aux = hal_syscon_system_clock_get() / sample_freq;
+	aux = hal_div_unsigned(hal_syscon_system_clock_get(), sample_freq);
 
 	if(aux > 0)
 	{
@@ -140,10 +188,15 @@ void hal_adc_init_sync_mode(uint32_t sample_freq, hal_adc_low_power_mode_en low_
 	}
 
 	ADC_control_config((uint8_t) aux, ADC_OPERATION_MODE_SYNCHRONOUS, low_power);
+
+	// La calibración se realiza al configurar la primera secuencia
+	hal_startup_deferred_register(&adc_calibration, hal_adc_hardware_calib);
 }
 
 void hal_adc_deinit(void)
 {
+	hal_startup_deferred_cancel(&adc_calibration);
+
 	SYSCON_assert_reset(SYSCON_RESET_SEL_ADC);
 
 	SYSCON_disable_clock(SYSCON_ENABLE_CLOCK_SEL_ADC);
@@ -186,6 +239,8 @@ void hal_adc_sequence_config(hal_adc_sequence_sel_en sequence, const hal_adc_seq
 {
 	uint8_t counter;
 
+	hal_startup_deferred_require(&adc_calibration);
+
 	ADC_sequence_config_channels(sequence, config->channels);
 
 	SWM_init();
@@ -230,6 +285,9 @@ void hal_adc_sequence_config(hal_adc_sequence_sel_en sequence, const hal_adc_seq
 		}
 	}
 
+	// Los canales con estadisticas que ya no pertenecen a la secuencia dejan de acumularse
+	adc_stats_channels[sequence] &= config->channels;
+
 	if(config->callback != NULL)
 	{
 		adc_seq_completed_callback[sequence] = config->callback;
@@ -240,7 +298,12 @@ void hal_adc_sequence_config(hal_adc_sequence_sel_en sequence, const hal_adc_seq
 	{
 		adc_seq_completed_callback[sequence] = dummy_irq_callback;
 		adc_seq_completed_callback_data[sequence] = NULL;
-		ADC_disable_sequence_interrupt(sequence);
+
+		// Si hay estadisticas habilitadas, la interrupcion sigue siendo necesaria
+		if(adc_stats_channels[sequence] == 0)
+		{
+			ADC_disable_sequence_interrupt(sequence);
+		}
 	}
 
 	if(config->burst)
@@ -337,12 +400,26 @@ hal_adc_sequence_result_en hal_adc_sequence_get_result(hal_adc_sequence_sel_en s
 		{
 			if(configured_channels & (1 << channel_counter))
 			{
-				ADC_channel_data_t data = ADC_get_channel_data(channel_counter);
-
-				if(data.DATAVALID)
+				if(adc_stats_latched_valid & (1 << channel_counter))
 				{
+					// El resultado ya fue leido por la interrupcion para las estadisticas
+					uint8_t lock_state = hal_adc_stats_lock();
+
 					(result[result_counter]).channel = (hal_adc_result_channel_en) channel_counter;
-					(result[result_counter++]).result = data.RESULT;
+					(result[result_counter++]).result = adc_stats_latched_result[channel_counter];
+					adc_stats_latched_valid &= ~(1 << channel_counter);
+
+					hal_adc_stats_unlock(lock_state);
+				}
+				else
+				{
+					ADC_channel_data_t data = ADC_get_channel_data(channel_counter);
+
+					if(data.DATAVALID)
+					{
+						(result[result_counter]).channel = (hal_adc_result_channel_en) channel_counter;
+						(result[result_counter++]).result = data.RESULT;
+					}
 				}
 			}
 		}
@@ -413,14 +490,258 @@ void hal_adc_threshold_get_comparison_results(hal_adc_channel_compare_result_t *
 	}
 }
 
+void hal_adc_stats_enable(hal_adc_sequence_sel_en sequence, uint16_t channels)
+{
+	uint8_t lock_state;
+	uint8_t channel;
+
+	channels &= ADC_sequence_get_channels(sequence);
+
+	lock_state = hal_adc_stats_lock();
+
+	for(channel = 0; channel < ADC_CHANNEL_AMOUNT; channel++)
+	{
+		if(channels & (1 << channel))
+		{
+			hal_adc_stats_reset_channel(channel);
+		}
+	}
+
+	adc_stats_channels[sequence] = channels;
+
+	hal_adc_stats_unlock(lock_state);
+
+	if(channels)
+	{
+		ADC_enable_sequence_interrupt(sequence);
+	}
+	else if(adc_seq_completed_callback[sequence] == dummy_irq_callback)
+	{
+		ADC_disable_sequence_interrupt(sequence);
+	}
+}
+
+void hal_adc_stats_disable(hal_adc_sequence_sel_en sequence)
+{
+	hal_adc_stats_enable(sequence, 0);
+}
+
+hal_adc_stats_result_en hal_adc_stats_get(uint8_t channel, hal_adc_stats_t *stats, uint8_t reset)
+{
+	adc_stats_accumulator_t snapshot;
+	uint8_t lock_state;
+	uint32_t mean_sq;
+
+	if((channel >= ADC_CHANNEL_AMOUNT) ||
+		!((adc_stats_channels[HAL_ADC_SEQUENCE_SEL_A] | adc_stats_channels[HAL_ADC_SEQUENCE_SEL_B]) & (1 << channel)))
+	{
+		return HAL_ADC_STATS_RESULT_INVALID_CHANNEL;
+	}
+
+	// Unicamente la copia se hace con las interrupciones inhibidas, los calculos se hacen por fuera
+	lock_state = hal_adc_stats_lock();
+
+	snapshot = adc_stats[channel];
+
+	if(reset)
+	{
+		hal_adc_stats_reset_channel(channel);
+	}
+
+	hal_adc_stats_unlock(lock_state);
+
+	stats->samples = snapshot.samples;
+	stats->sum = snapshot.sum;
+	stats->sum_sq = snapshot.sum_sq;
+	stats->saturated = snapshot.saturated;
+
+	if(snapshot.samples == 0)
+	{
+		stats->min = 0;
+		stats->max = 0;
+		stats->mean = 0;
+		stats->rms = 0;
+		stats->variance = 0;
+
+		return HAL_ADC_STATS_RESULT_NO_SAMPLES;
+	}
+
+	stats->min = snapshot.min;
+	stats->max = snapshot.max;
+	stats->mean = (uint16_t) hal_div_unsigned(snapshot.sum, snapshot.samples);
+
+	// La media de los cuadrados esta acotada por el cuadrado del maximo valor de conversion
+	mean_sq = (uint32_t) hal_div_unsigned_64(snapshot.sum_sq, snapshot.samples);
+	stats->rms = (uint16_t) hal_adc_stats_isqrt(mean_sq);
+
+	// Con aritmetica entera exacta no hay cancelacion: n * var = sum_sq - sum^2 / n
+	stats->variance = (uint32_t) hal_div_unsigned_64(snapshot.sum_sq - hal_div_unsigned_64((uint64_t) snapshot.sum * snapshot.sum, snapshot.samples), snapshot.samples);
+
+	return HAL_ADC_STATS_RESULT_VALID;
+}
+
+/**
+ * @brief Reiniciar la ventana de estadísticas de un canal
+ * @param[in] channel Canal a reiniciar
+ */
+static void hal_adc_stats_reset_channel(uint8_t channel)
+{
+	adc_stats[channel].samples = 0;
+	adc_stats[channel].sum = 0;
+	adc_stats[channel].sum_sq = 0;
+	adc_stats[channel].min = 0xFFFF;
+	adc_stats[channel].max = 0;
+	adc_stats[channel].saturated = 0;
+}
+
+/**
+ * @brief Inhibir las interrupciones de secuencia que estén habilitadas
+ * @return Estado previo de las interrupciones, para pasarle a @ref hal_adc_stats_unlock
+ */
+static uint8_t hal_adc_stats_lock(void)
+{
+	uint8_t lock_state = 0;
+
+	if(NVIC_get_enabled_interrupt(NVIC_IRQ_SEL_ADC_SEQA))
+	{
+		NVIC_disable_interrupt(NVIC_IRQ_SEL_ADC_SEQA);
+		lock_state |= (1 << HAL_ADC_SEQUENCE_SEL_A);
+	}
+
+	if(NVIC_get_enabled_interrupt(NVIC_IRQ_SEL_ADC_SEQB))
+	{
+		NVIC_disable_interrupt(NVIC_IRQ_SEL_ADC_SEQB);
+		lock_state |= (1 << HAL_ADC_SEQUENCE_SEL_B);
+	}
+
+	return lock_state;
+}
+
+/**
+ * @brief Restaurar las interrupciones de secuencia inhibidas por @ref hal_adc_stats_lock
+ * @param[in] lock_state Estado devuelto por @ref hal_adc_stats_lock
+ */
+static void hal_adc_stats_unlock(uint8_t lock_state)
+{
+	if(lock_state & (1 << HAL_ADC_SEQUENCE_SEL_A))
+	{
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_ADC_SEQA);
+	}
+
+	if(lock_state & (1 << HAL_ADC_SEQUENCE_SEL_B))
+	{
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_ADC_SEQB);
+	}
+}
+
+/**
+ * @brief Acumular las conversiones válidas de los canales con estadísticas de una secuencia
+ *
+ * Se ejecuta en el contexto de la interrupción de secuencia, antes del callback del usuario.
+ *
+ * @param[in] sequence Secuencia que generó la interrupción
+ */
+HAL_RAMFUNC static inline void hal_adc_stats_update(ADC_sequence_sel_en sequence)
+{
+	uint16_t pending = adc_stats_channels[sequence];
+	uint8_t channel = 0;
+
+	while(pending)
+	{
+		if(pending & 1)
+		{
+			ADC_channel_data_t data = ADC_get_channel_data(channel);
+
+			if(data.DATAVALID)
+			{
+				adc_stats_accumulator_t *acc = &adc_stats[channel];
+				uint16_t value = data.RESULT;
+
+				adc_stats_latched_result[channel] = value;
+				adc_stats_latched_valid |= (1 << channel);
+
+				if(acc->samples < HAL_ADC_STATS_MAX_SAMPLES)
+				{
+					acc->samples++;
+					acc->sum += value;
+					acc->sum_sq += (uint32_t) value * value;
+
+					if(value < acc->min)
+					{
+						acc->min = value;
+					}
+
+					if(value > acc->max)
+					{
+						acc->max = value;
+					}
+				}
+				else
+				{
+					acc->saturated = 1;
+				}
+			}
+		}
+
+		pending >>= 1;
+		channel++;
+	}
+}
+
+/**
+ * @brief Raíz cuadrada entera (redondeada hacia abajo)
+ * @param[in] value Valor del cual calcular la raíz
+ * @return Raíz cuadrada entera de value
+ */
+static uint32_t hal_adc_stats_isqrt(uint32_t value)
+{
+	uint32_t result = 0;
+	uint32_t bit = 1UL << 30;
+
+	while(bit > value)
+	{
+		bit >>= 2;
+	}
+
+	while(bit)
+	{
+		if(value >= result + bit)
+		{
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+		{
+			result >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	return result;
+}
+
+/**
+ * @brief Calibración de hardware del *ADC*
+ *
+ * La calibración se realiza en modo sincrónico con el clock del sistema dividido a 500KHz, independientemente del
+ * modo de operación configurado, el cual se restaura al finalizar.
+ */
+static void hal_adc_hardware_calib(void)
+{
+	ADC_hardware_calib((uint8_t) hal_div_unsigned(hal_syscon_system_clock_get(), ADC_CALIB_FREQ));
+}
+
 static void dummy_irq_callback(void* data)
 {
 	(void) data;
 	return;
 }
 
-void ADC_SEQA_IRQHandler(void)
+HAL_RAMFUNC void ADC_SEQA_IRQHandler(void)
 {
+	hal_adc_stats_update(ADC_SEQUENCE_SEL_A);
+
 	if (adc_seq_completed_callback[ADC_SEQUENCE_SEL_A] != NULL) {
 		adc_seq_completed_callback[ADC_SEQUENCE_SEL_A](adc_seq_completed_callback_data[ADC_SEQUENCE_SEL_A]);
 	}
@@ -431,8 +752,10 @@ void ADC_SEQA_IRQHandler(void)
 	}
 }
 
-void ADC_SEQB_IRQHandler(void)
+HAL_RAMFUNC void ADC_SEQB_IRQHandler(void)
 {
+	hal_adc_stats_update(ADC_SEQUENCE_SEL_B);
+
 	if (adc_seq_completed_callback[ADC_SEQUENCE_SEL_B] != NULL) {
 		adc_seq_completed_callback[ADC_SEQUENCE_SEL_B](adc_seq_completed_callback_data[ADC_SEQUENCE_SEL_B]);
 	}
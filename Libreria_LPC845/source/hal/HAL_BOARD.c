@@ -0,0 +1,48 @@
+/**
+ * @file HAL_BOARD.c
+ * @brief Funciones a nivel de aplicacion de la tabla de pines de la placa (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HAL_BOARD.h>
+#include <HPL_SWM.h>
+#include <HPL_IOCON.h>
+
+/**
+ * @brief Aplicar la tabla de pines de la placa
+ *
+ * Escribe todos los registros *PINASSIGN* y *PINENABLE* y las configuraciones de *IOCON* de la tabla, habilitando
+ * el clock de la *SWM* y del *IOCON* una única vez.
+ *
+ * @param[in] config Tabla definida mediante @ref HAL_BOARD_DEFINE
+ */
+void hal_board_apply(const hal_board_config_t *config)
+{
+	const hal_board_iocon_t *iocon;
+	uint8_t counter;
+
+	SWM_init();
+
+	for(counter = 0; counter < HAL_BOARD_PINASSIGN_REGS; counter++)
+	{
+		SWM_set_pinassign(counter, ~config->pinassign.words[counter]);
+	}
+
+	// En los registros PINENABLE las funciones se habilitan con el bit en cero
+	SWM_set_pinenable(0, ~((uint32_t) config->fixed));
+	SWM_set_pinenable(1, ~((uint32_t) (config->fixed >> 32)));
+
+	SWM_deinit();
+
+	IOCON_init();
+
+	for(iocon = config->iocon; iocon->portpin != HAL_BOARD_IOCON_END; iocon++)
+	{
+		IOCON_write_masked(HAL_GPIO_PORTPIN_TO_PORT(iocon->portpin), HAL_GPIO_PORTPIN_TO_PIN(iocon->portpin),
+				HAL_BOARD_IOCON_MASK, iocon->flags);
+	}
+
+	IOCON_deinit();
+}
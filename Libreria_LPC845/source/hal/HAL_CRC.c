@@ -0,0 +1,223 @@
+/**
+ * @file HAL_CRC.c
+ * @brief Funciones a nivel de aplicacion del periferico CRC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HAL_CRC.h>
+#include <HPL_CRC.h>
+#include <HPL_DMA.h>
+#include <HPL_SYSCON.h>
+
+/** Prioridad de los canales de DMA utilizados para el calculo */
+#define		CRC_DMA_PRIORITY			7
+
+/** Estado del calculo por DMA */
+typedef struct
+{
+	uint8_t running; /**< Distinto de cero mientras el calculo esta en curso */
+	uint8_t channel; /**< Canal de DMA utilizado */
+	const uint32_t *words; /**< Proxima palabra a transferir */
+	uint32_t word_count; /**< Cantidad de palabras restantes a transferir */
+	const uint8_t *tail; /**< Bytes finales no alineados */
+	uint8_t tail_length; /**< Cantidad de bytes finales no alineados */
+}crc_dma_t;
+
+static const uint8_t *crc_update_head(const uint8_t *data, uint32_t *length);
+
+static void crc_dma_power_up(void);
+
+static void crc_dma_transfer(void);
+
+static crc_dma_t crc_dma; //!< Estado del calculo por DMA
+
+/**
+ * @brief Inicializar el periférico CRC
+ */
+void hal_crc_init(void)
+{
+	SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_CRC);
+	SYSCON_clear_reset(SYSCON_RESET_SEL_CRC);
+}
+
+/**
+ * @brief Comenzar un calculo
+ * @param[in] config Configuracion del calculo
+ */
+void hal_crc_start(const hal_crc_config_t *config)
+{
+	CRC_set_mode((CRC_polynomial_en) config->polynomial, config->reverse_input, config->complement_input, config->reverse_output, config->complement_output);
+	CRC_set_seed(config->seed);
+}
+
+/**
+ * @brief Agregar datos al calculo en curso
+ * @param[in] data Datos a agregar
+ * @param[in] length Cantidad de bytes
+ */
+void hal_crc_update(const void *data, uint32_t length)
+{
+	const uint8_t *bytes = crc_update_head(data, &length);
+	const uint32_t *words = (const uint32_t *) bytes;
+
+	for(; length >= sizeof(uint32_t); length -= sizeof(uint32_t))
+	{
+		CRC_write_data_32(*words++);
+	}
+
+	for(bytes = (const uint8_t *) words; length != 0; length--)
+	{
+		CRC_write_data_8(*bytes++);
+	}
+}
+
+/**
+ * @brief Obtener el resultado del calculo en curso
+ * @return Resultado
+ */
+uint32_t hal_crc_get(void)
+{
+	return CRC_get_sum();
+}
+
+/**
+ * @brief Calcular el CRC de un bloque de datos
+ * @param[in] config Configuracion del calculo
+ * @param[in] data Datos
+ * @param[in] length Cantidad de bytes
+ * @return Resultado
+ */
+uint32_t hal_crc_compute(const hal_crc_config_t *config, const void *data, uint32_t length)
+{
+	hal_crc_start(config);
+	hal_crc_update(data, length);
+
+	return hal_crc_get();
+}
+
+/**
+ * @brief Comenzar a agregar un bloque de datos al calculo en curso mediante DMA
+ * @param[in] channel Canal de DMA a utilizar
+ * @param[in] data Datos a agregar
+ * @param[in] length Cantidad de bytes
+ */
+void hal_crc_dma_start(uint8_t channel, const void *data, uint32_t length)
+{
+	const uint8_t *bytes = crc_update_head(data, &length);
+
+	crc_dma.channel = channel;
+	crc_dma.words = (const uint32_t *) bytes;
+	crc_dma.word_count = length / sizeof(uint32_t);
+	crc_dma.tail = bytes + (length & ~(sizeof(uint32_t) - 1));
+	crc_dma.tail_length = length & (sizeof(uint32_t) - 1);
+	crc_dma.running = 1;
+
+	if(crc_dma.word_count != 0)
+	{
+		crc_dma_power_up();
+
+		DMA_config_channel_software_trigger(channel, CRC_DMA_PRIORITY);
+		DMA_enable_channel(channel);
+
+		crc_dma_transfer();
+	}
+}
+
+/**
+ * @brief Avanzar el calculo por DMA
+ * @return Estado del calculo
+ */
+hal_crc_dma_status_en hal_crc_dma_process(void)
+{
+	if(!crc_dma.running)
+	{
+		return HAL_CRC_DMA_STATUS_DONE;
+	}
+
+	if(crc_dma.word_count != 0)
+	{
+		if(DMA_get_channel_active(crc_dma.channel) || DMA_get_channel_busy(crc_dma.channel))
+		{
+			return HAL_CRC_DMA_STATUS_BUSY;
+		}
+
+		// Los bytes finales se escriben una vez terminado el ultimo bloque, en un llamado posterior
+		crc_dma_transfer();
+
+		return HAL_CRC_DMA_STATUS_BUSY;
+	}
+
+	if(DMA_get_channel_active(crc_dma.channel) || DMA_get_channel_busy(crc_dma.channel))
+	{
+		return HAL_CRC_DMA_STATUS_BUSY;
+	}
+
+	for(; crc_dma.tail_length != 0; crc_dma.tail_length--)
+	{
+		CRC_write_data_8(*crc_dma.tail++);
+	}
+
+	crc_dma.running = 0;
+
+	return HAL_CRC_DMA_STATUS_DONE;
+}
+
+/**
+ * @brief Escribir los bytes iniciales hasta alcanzar una direccion alineada a 32 bits
+ * @param[in] data Datos
+ * @param[in,out] length Cantidad de bytes, se descuentan los bytes escritos
+ * @return Direccion del primer dato alineado
+ */
+static const uint8_t *crc_update_head(const uint8_t *data, uint32_t *length)
+{
+	while((*length != 0) && (((uint32_t) data & (sizeof(uint32_t) - 1)) != 0))
+	{
+		CRC_write_data_8(*data++);
+		(*length)--;
+	}
+
+	return data;
+}
+
+/**
+ * @brief Habilitar el controlador de DMA si no estaba habilitado
+ */
+static void crc_dma_power_up(void)
+{
+	if(DMA_is_enabled())
+	{
+		return;
+	}
+
+	SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_DMA);
+	SYSCON_clear_reset(SYSCON_RESET_SEL_DMA);
+
+	DMA_set_descriptor_table(DMA_DESCRIPTOR_TABLE);
+	DMA_enable();
+}
+
+/**
+ * @brief Programar la transferencia del siguiente bloque de palabras
+ */
+static void crc_dma_transfer(void)
+{
+	DMA_descriptor_t *descriptor = &DMA_DESCRIPTOR_TABLE[crc_dma.channel];
+	uint32_t count = crc_dma.word_count;
+
+	if(count > DMA_MAX_TRANSFER_COUNT)
+	{
+		count = DMA_MAX_TRANSFER_COUNT;
+	}
+
+	// Las direcciones del descriptor son las del ultimo dato de la transferencia
+	descriptor->SOURCE_END = &crc_dma.words[count - 1];
+	descriptor->DEST_END = CRC_get_data_address();
+	descriptor->LINK = 0;
+
+	crc_dma.words += count;
+	crc_dma.word_count -= count;
+
+	DMA_start_channel_software_transfer(crc_dma.channel, DMA_WIDTH_32_BITS, DMA_INCREMENT_1_WIDTH, DMA_INCREMENT_NONE, count);
+}
@@ -9,8 +9,10 @@
 
 #include <stddef.h>
 #include <HAL_CTIMER.h>
+#include <HAL_DIV.h>
 #include <HAL_SYSCON.h>
 #include <HAL_IOCON.h>
+#include <HAL_RAMFUNC.h>
 #include <HPL_CTIMER.h>
 #include <HPL_NVIC.h>
 #include <HPL_SWM.h>
@@ -256,6 +258,132 @@ void hal_ctimer_match_clear_output(hal_ctimer_match_sel_en match)
 	CTIMER_clear_match_output(match);
 }
 
+/**
+ * @brief Cambia el valor de *MATCH* del canal de match especificado, en cuentas del contador.
+ *
+ * A diferencia de hal_ctimer_timer_mode_match_change_value(), el valor no es convertido desde microsegundos, por lo
+ * que esta función es apta para ser llamada desde un contexto de interrupción.
+ *
+ * @param[in] match Canal de *match* a configurar.
+ * @param[in] match_ticks Nuevo valor de match, en cuentas del contador.
+ * @see hal_ctimer_timer_mode_match_change_value
+ * @see hal_ctimer_timer_mode_clock_get
+ */
+void hal_ctimer_timer_mode_match_change_ticks(hal_ctimer_match_sel_en match, uint32_t match_ticks)
+{
+	if(CTIMER_get_reload_on_match(match))
+	{
+		CTIMER_write_shadow_register(match, match_ticks);
+	}
+	else
+	{
+		CTIMER_write_match_value(match, match_ticks);
+	}
+}
+
+/**
+ * @brief Configurar un canal de captura
+ *
+ * El canal de captura especificado por el parámetro *capture_sel* será configurado según la
+ * estructura *capture_config*.
+ *
+ * @note Antes de llamar a esta función, el periférico debiera de haber sido inicializado con
+ * la función hal_ctimer_timer_mode_init().
+ * @note Esta función no dispara ni detiene el contador.
+ *
+ * @param[in] capture_sel Canal de captura a configurar.
+ * @param[in] capture_config Estructura con los parámetros de configuración deseados.
+ * @see hal_ctimer_capture_config_t
+ * @see hal_ctimer_timer_mode_capture_read
+ */
+void hal_ctimer_timer_mode_capture_config(hal_ctimer_capture_sel_en capture_sel, const hal_ctimer_capture_config_t *capture_config)
+{
+	// El canal de captura 3 no tiene funcion asignable en la switch matrix
+	if(capture_sel != HAL_CTIMER_CAPTURE_3)
+	{
+		SWM_init();
+
+		if(capture_config->enable_external_pin)
+		{
+			SWM_assign_T0_CAP(capture_sel, capture_config->capture_pin / 32, capture_config->capture_pin % 32);
+		}
+		else
+		{
+			SWM_assign_T0_CAP(capture_sel, 0xFF, 0xFF);
+		}
+
+		SWM_deinit();
+	}
+
+	if(capture_config->edge != HAL_CTIMER_CAPTURE_EDGE_FALLING)
+	{
+		CTIMER_enable_rising_edge_capture(capture_sel);
+	}
+	else
+	{
+		CTIMER_disable_rising_edge_capture(capture_sel);
+	}
+
+	if(capture_config->edge != HAL_CTIMER_CAPTURE_EDGE_RISING)
+	{
+		CTIMER_enable_falling_edge_capture(capture_sel);
+	}
+	else
+	{
+		CTIMER_disable_falling_edge_capture(capture_sel);
+	}
+
+	if(capture_config->interrupt_on_capture)
+	{
+		if(capture_config->callback != NULL)
+		{
+			capture_callbacks[capture_sel] = capture_config->callback;
+		}
+		else
+		{
+			capture_callbacks[capture_sel] = dummy_irq;
+		}
+
+		CTIMER_clear_capture_irq_flag(capture_sel);
+		CTIMER_enable_interrupt_on_capture(capture_sel);
+	}
+	else
+	{
+		CTIMER_disable_interrupt_on_capture(capture_sel);
+		capture_callbacks[capture_sel] = dummy_irq;
+	}
+}
+
+/**
+ * @brief Lee el último valor capturado por un canal de captura.
+ * @param[in] capture_sel Canal de captura a consultar.
+ * @return Valor del contador en el momento de la última captura.
+ * @see hal_ctimer_timer_mode_capture_config
+ */
+uint32_t hal_ctimer_timer_mode_capture_read(hal_ctimer_capture_sel_en capture_sel)
+{
+	return CTIMER_read_capture_value(capture_sel);
+}
+
+/**
+ * @brief Lee el valor actual del contador del *CTIMER*.
+ * @return Valor actual del contador.
+ */
+uint32_t hal_ctimer_timer_mode_counter_read(void)
+{
+	return CTIMER_read_counter();
+}
+
+/**
+ * @brief Obtener la frecuencia de conteo del *CTIMER*.
+ * @return Frecuencia de conteo en Hz.
+ * @see hal_ctimer_timer_mode_init
+ */
+uint32_t hal_ctimer_timer_mode_clock_get(void)
+{
+	return hal_div_unsigned(hal_syscon_system_clock_get(), CTIMER_read_prescaler() + 1);
+}
+
 /**
  * @brief Inicialización del periférico *CTIMER* en modo PWM.
  *
@@ -330,25 +458,29 @@ void hal_ctimer_pwm_mode_period_set(uint32_t period_useg)
  */
 void hal_ctimer_pwm_mode_channel_config(hal_ctimer_pwm_channel_sel_en channel_sel, const hal_ctimer_pwm_channel_config_t *channel_config)
 {
-	float aux_calc;
+	uint32_t period = CTIMER_read_match_value(CTIMER_MATCH_SEL_3);
+	uint32_t aux_calc;
 
 	CTIMER_enable_reload_on_match(channel_sel);
 
 	if(channel_config->duty >= 1000)
 	{
-		aux_calc = 0.0;
+		aux_calc = 0;
 	}
 	else if(channel_config->duty > 0)
 	{
-		aux_calc = (((float) channel_config->duty) * CTIMER_read_match_value(CTIMER_MATCH_SEL_3)) / 1000.0;
-		aux_calc = ((float) CTIMER_read_match_value(CTIMER_MATCH_SEL_3)) - aux_calc;
+		// Separando cociente y resto del periodo se evita el desborde del producto
+		hal_div_unsigned_result_t period_per_unit = hal_div_unsigned_divmod(period, 1000);
+
+		aux_calc = (channel_config->duty * period_per_unit.quot) + hal_div_unsigned(channel_config->duty * period_per_unit.rem, 1000);
+		aux_calc = period - aux_calc;
 	}
 	else
 	{
-		aux_calc = (float) (CTIMER_read_match_value(CTIMER_MATCH_SEL_3) + 1);
+		aux_calc = period + 1;
 	}
 
-	CTIMER_write_shadow_register(channel_sel, (uint32_t) (aux_calc));
+	CTIMER_write_shadow_register(channel_sel, aux_calc);
 
 	SWM_init();
 	SWM_assign_T0_MAT(channel_sel, channel_config->channel_pin / 32, channel_config->channel_pin % 32);
@@ -382,15 +514,15 @@ static void dummy_irq(void)
  */
 static uint32_t hal_ctimer_calc_match_value(uint32_t match_value_useg)
 {
-	float per_clock = ((float) hal_syscon_system_clock_get()) / ((float) (CTIMER_read_prescaler() + 1));
+	uint64_t ticks = hal_div_unsigned_64((uint64_t) hal_syscon_system_clock_get() * match_value_useg, 1000000);
 
-	return (uint32_t) ((per_clock * match_value_useg) / 1e6);
+	return (uint32_t) hal_div_unsigned_64(ticks, CTIMER_read_prescaler() + 1);
 }
 
 /**
  * @brief Interrupcion de CTIMER
  */
-void CTIMER0_IRQHandler(void)
+HAL_RAMFUNC void CTIMER0_IRQHandler(void)
 {
 	uint8_t counter;
 
@@ -6,11 +6,80 @@
  * @version 1.0
  */
 
+#include <stddef.h>
 #include <HAL_DAC.h>
+#include <HAL_DIV.h>
+#include <HAL_SYSCON.h>
 #include <HPL_DAC.h>
 #include <HPL_SYSCON.h>
 #include <HPL_SWM.h>
 #include <HPL_IOCON.h>
+#include <HPL_NVIC.h>
+
+/** Modos de funcionamiento del contador interno de cada *DAC* */
+typedef enum
+{
+	DAC_WAVE_MODE_NONE = 0, /**< Sin generación de formas de onda */
+	DAC_WAVE_MODE_TABLE, /**< Reproducción cíclica de tabla */
+	DAC_WAVE_MODE_DDS, /**< Síntesis digital directa */
+	DAC_WAVE_MODE_STREAM /**< Streaming desde buffer circular */
+}dac_wave_mode_en;
+
+/** Estado de la generación de formas de onda de un *DAC* */
+typedef struct
+{
+	volatile dac_wave_mode_en mode; /**< Modo de funcionamiento */
+	const uint16_t *table; /**< Tabla de muestras */
+	uint16_t length; /**< Cantidad de muestras (modo tabla) */
+	uint16_t index; /**< Próxima muestra a precargar (modo tabla) */
+	uint8_t phase_shift; /**< Desplazamiento del acumulador para obtener el índice (modo DDS) */
+	uint32_t phase; /**< Acumulador de fase (modo DDS) */
+	volatile uint32_t tuning_word; /**< Incremento de fase por muestra (modo DDS) */
+	uint32_t sample_rate; /**< Frecuencia de muestreo en Hz */
+	volatile uint16_t *buffer; /**< Buffer circular (modo streaming) */
+	uint16_t mask; /**< Máscara de índice del buffer circular (modo streaming) */
+	volatile uint16_t head; /**< Contador de muestras cargadas, solo escrito por el productor (modo streaming) */
+	volatile uint16_t tail; /**< Contador de muestras consumidas, solo escrito por la interrupción (modo streaming) */
+	volatile uint8_t primed; /**< Flag de reproducción comenzada (modo streaming) */
+	volatile uint32_t underruns; /**< Cantidad de underruns (modo streaming) */
+	volatile uint16_t low_watermark; /**< Mínima ocupación observada (modo streaming) */
+	uint16_t high_watermark; /**< Máxima ocupación observada (modo streaming) */
+}dac_wave_t;
+
+static dac_wave_t dac_wave[HAL_DAC_SEL_AMOUNT] = {
+	{ .mode = DAC_WAVE_MODE_NONE },
+	{ .mode = DAC_WAVE_MODE_NONE }
+};
+
+static const NVIC_irq_sel_en DAC_NVICS[] = {
+	NVIC_IRQ_SEL_DAC0,
+	NVIC_IRQ_SEL_PININT5_DAC1
+};
+
+const uint16_t hal_dac_wave_sine_table[1 << HAL_DAC_WAVE_SINE_TABLE_BITS] = {
+	512, 525, 537, 550, 562, 575, 587, 599, 612, 624, 636, 648, 660, 672, 684, 696,
+	708, 719, 730, 742, 753, 764, 775, 785, 796, 806, 816, 826, 836, 846, 855, 864,
+	873, 882, 891, 899, 907, 915, 922, 930, 937, 944, 950, 957, 963, 968, 974, 979,
+	984, 989, 993, 997, 1001, 1004, 1008, 1011, 1013, 1015, 1017, 1019, 1021, 1022, 1022, 1023,
+	1023, 1023, 1022, 1022, 1021, 1019, 1017, 1015, 1013, 1011, 1008, 1004, 1001, 997, 993, 989,
+	984, 979, 974, 968, 963, 957, 950, 944, 937, 930, 922, 915, 907, 899, 891, 882,
+	873, 864, 855, 846, 836, 826, 816, 806, 796, 785, 775, 764, 753, 742, 730, 719,
+	708, 696, 684, 672, 660, 648, 636, 624, 612, 599, 587, 575, 562, 550, 537, 525,
+	512, 499, 487, 474, 462, 449, 437, 425, 412, 400, 388, 376, 364, 352, 340, 328,
+	316, 305, 294, 282, 271, 260, 249, 239, 228, 218, 208, 198, 188, 178, 169, 160,
+	151, 142, 133, 125, 117, 109, 102, 94, 87, 80, 74, 67, 61, 56, 50, 45,
+	40, 35, 31, 27, 23, 20, 16, 13, 11, 9, 7, 5, 3, 2, 2, 1,
+	1, 1, 2, 2, 3, 5, 7, 9, 11, 13, 16, 20, 23, 27, 31, 35,
+	40, 45, 50, 56, 61, 67, 74, 80, 87, 94, 102, 109, 117, 125, 133, 142,
+	151, 160, 169, 178, 188, 198, 208, 218, 228, 239, 249, 260, 271, 282, 294, 305,
+	316, 328, 340, 352, 364, 376, 388, 400, 412, 425, 437, 449, 462, 474, 487, 499
+};
+
+static hal_dac_wave_result_en hal_dac_wave_calculate_reload(uint32_t sample_rate, uint32_t *reload);
+
+static void hal_dac_wave_timer_start(hal_dac_sel_en dac, uint32_t reload, uint16_t first_value);
+
+static void hal_dac_handle_irq(hal_dac_sel_en dac);
 
 /**
  * @brief Inicialización del DAC
@@ -101,3 +170,437 @@ void hal_dac_config_ctrl(hal_dac_sel_en dac, hal_dac_ctrl_config_t * config)
 		DAC_disable_DMA_request(dac);
 	}
 }
+
+/**
+ * @brief Comenzar la reproducción cíclica de una tabla de muestras
+ *
+ * El contador interno del *DAC* y el doble buffer quedan habilitados, y en cada interrupción del *DAC* se precarga
+ * la siguiente muestra de la tabla.
+ *
+ * @param[in] dac Que DAC utilizar
+ * @param[in] table Tabla de muestras a reproducir. Debe permanecer válida mientras dure la reproducción
+ * @param[in] length Cantidad de muestras de la tabla
+ * @param[in] sample_rate Frecuencia de muestreo en Hz
+ * @return Resultado de la operación
+ * @pre Haber inicializado el periférico
+ */
+hal_dac_wave_result_en hal_dac_wave_table_start(hal_dac_sel_en dac, const uint16_t *table, uint16_t length, uint32_t sample_rate)
+{
+	hal_dac_wave_result_en result;
+	uint32_t reload;
+
+	if((table == NULL) || (length == 0))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_TABLE;
+	}
+
+	result = hal_dac_wave_calculate_reload(sample_rate, &reload);
+
+	if(result != HAL_DAC_WAVE_RESULT_OK)
+	{
+		return result;
+	}
+
+	hal_dac_wave_stop(dac);
+
+	dac_wave[dac].table = table;
+	dac_wave[dac].length = length;
+	dac_wave[dac].index = (length > 1) ? 1 : 0;
+	dac_wave[dac].sample_rate = sample_rate;
+	dac_wave[dac].mode = DAC_WAVE_MODE_TABLE;
+
+	hal_dac_wave_timer_start(dac, reload, table[0]);
+
+	return HAL_DAC_WAVE_RESULT_OK;
+}
+
+/**
+ * @brief Comenzar la síntesis digital directa (DDS) de una forma de onda
+ * @param[in] dac Que DAC utilizar
+ * @param[in] table Tabla de un ciclo de la forma de onda, de 2^table_bits muestras. Debe permanecer válida
+ * mientras dure la síntesis
+ * @param[in] table_bits Cantidad de bits de índice de la tabla (de 1 a 16)
+ * @param[in] sample_rate Frecuencia de muestreo en Hz
+ * @param[in] frequency Frecuencia de salida en Hz
+ * @return Resultado de la operación
+ * @pre Haber inicializado el periférico
+ */
+hal_dac_wave_result_en hal_dac_wave_dds_start(hal_dac_sel_en dac, const uint16_t *table, uint8_t table_bits, uint32_t sample_rate, uint32_t frequency)
+{
+	hal_dac_wave_result_en result;
+	uint32_t reload;
+
+	if((table == NULL) || (table_bits == 0) || (table_bits > 16))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_TABLE;
+	}
+
+	result = hal_dac_wave_calculate_reload(sample_rate, &reload);
+
+	if(result != HAL_DAC_WAVE_RESULT_OK)
+	{
+		return result;
+	}
+
+	if(frequency > (sample_rate / 2))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_FREQUENCY;
+	}
+
+	hal_dac_wave_stop(dac);
+
+	dac_wave[dac].table = table;
+	dac_wave[dac].phase_shift = 32 - table_bits;
+	dac_wave[dac].phase = 0;
+	dac_wave[dac].sample_rate = sample_rate;
+	dac_wave[dac].tuning_word = (uint32_t) hal_div_unsigned_64((uint64_t) frequency << 32, sample_rate);
+	dac_wave[dac].mode = DAC_WAVE_MODE_DDS;
+
+	hal_dac_wave_timer_start(dac, reload, table[0]);
+
+	return HAL_DAC_WAVE_RESULT_OK;
+}
+
+/**
+ * @brief Cambiar la frecuencia de salida de la síntesis en curso
+ *
+ * El cambio se aplica en la siguiente muestra, manteniendo la continuidad de fase.
+ *
+ * @param[in] dac Que DAC actualizar
+ * @param[in] frequency Nueva frecuencia de salida en Hz
+ * @return Resultado de la operación
+ * @pre Haber comenzado la síntesis mediante @ref hal_dac_wave_dds_start
+ */
+hal_dac_wave_result_en hal_dac_wave_dds_set_frequency(hal_dac_sel_en dac, uint32_t frequency)
+{
+	if(dac_wave[dac].mode != DAC_WAVE_MODE_DDS)
+	{
+		return HAL_DAC_WAVE_RESULT_WRONG_MODE;
+	}
+
+	if(frequency > (dac_wave[dac].sample_rate / 2))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_FREQUENCY;
+	}
+
+	// La escritura de 32 bits es atomica, no hace falta inhibir la interrupcion
+	dac_wave[dac].tuning_word = (uint32_t) hal_div_unsigned_64((uint64_t) frequency << 32, dac_wave[dac].sample_rate);
+
+	return HAL_DAC_WAVE_RESULT_OK;
+}
+
+/**
+ * @brief Comenzar el streaming de muestras desde un buffer circular
+ * @param[in] dac Que DAC utilizar
+ * @param[in] buffer Memoria para el buffer circular. Debe permanecer válida mientras dure el streaming
+ * @param[in] size Cantidad de muestras del buffer. Debe ser potencia de 2, entre 2 y 32768
+ * @param[in] sample_rate Frecuencia de muestreo en Hz
+ * @return Resultado de la operación
+ * @pre Haber inicializado el periférico
+ */
+hal_dac_wave_result_en hal_dac_stream_start(hal_dac_sel_en dac, uint16_t *buffer, uint16_t size, uint32_t sample_rate)
+{
+	hal_dac_wave_result_en result;
+	uint32_t reload;
+
+	// Los contadores de 16 bits dan la vuelta correctamente solo con tamaños potencia de 2 hasta 32768
+	if((buffer == NULL) || (size < 2) || (size > 32768) || (size & (size - 1)))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_TABLE;
+	}
+
+	result = hal_dac_wave_calculate_reload(sample_rate, &reload);
+
+	if(result != HAL_DAC_WAVE_RESULT_OK)
+	{
+		return result;
+	}
+
+	hal_dac_wave_stop(dac);
+
+	dac_wave[dac].buffer = buffer;
+	dac_wave[dac].mask = size - 1;
+	dac_wave[dac].head = 0;
+	dac_wave[dac].tail = 0;
+	dac_wave[dac].primed = 0;
+	dac_wave[dac].underruns = 0;
+	dac_wave[dac].low_watermark = size;
+	dac_wave[dac].high_watermark = 0;
+	dac_wave[dac].sample_rate = sample_rate;
+	dac_wave[dac].mode = DAC_WAVE_MODE_STREAM;
+
+	hal_dac_wave_timer_start(dac, reload, DAC_read(dac));
+
+	return HAL_DAC_WAVE_RESULT_OK;
+}
+
+/**
+ * @brief Cargar muestras en el buffer circular del streaming
+ *
+ * Se cargan tantas muestras como lugar libre haya en el buffer. Esta función no debe ser llamada en forma
+ * concurrente desde distintos contextos para un mismo *DAC*.
+ *
+ * @param[in] dac Que DAC alimentar
+ * @param[in] samples Muestras a cargar (valores de 10 bits)
+ * @param[in] count Cantidad de muestras a cargar
+ * @return Cantidad de muestras efectivamente cargadas
+ * @pre Haber comenzado el streaming mediante @ref hal_dac_stream_start
+ */
+uint16_t hal_dac_stream_write(hal_dac_sel_en dac, const uint16_t *samples, uint16_t count)
+{
+	dac_wave_t *wave = &dac_wave[dac];
+	uint16_t head = wave->head;
+	uint16_t free_space;
+	uint16_t level;
+	uint16_t counter;
+	uint32_t primask;
+
+	if(wave->mode != DAC_WAVE_MODE_STREAM)
+	{
+		return 0;
+	}
+
+	free_space = (wave->mask + 1) - (uint16_t) (head - wave->tail);
+
+	if(count > free_space)
+	{
+		count = free_space;
+	}
+
+	for(counter = 0; counter < count; counter++)
+	{
+		wave->buffer[(head + counter) & wave->mask] = samples[counter];
+	}
+
+	// Las muestras quedan escritas antes de publicar el nuevo indice, ya que ambos accesos son volatile
+	wave->head = head + count;
+
+	// El productor puede ser otra interrupcion, por lo que el maximo se actualiza con las interrupciones enmascaradas
+	// para no competir con el reinicio de las estadisticas
+	primask = NVIC_global_disable();
+
+	level = (uint16_t) (wave->head - wave->tail);
+
+	if(level > wave->high_watermark)
+	{
+		wave->high_watermark = level;
+	}
+
+	NVIC_global_restore(primask);
+
+	return count;
+}
+
+/**
+ * @brief Obtener la cantidad de lugares libres en el buffer circular del streaming
+ * @param[in] dac Que DAC consultar
+ * @return Cantidad de muestras que pueden cargarse sin descartar datos
+ */
+uint16_t hal_dac_stream_get_free(hal_dac_sel_en dac)
+{
+	if(dac_wave[dac].mode != DAC_WAVE_MODE_STREAM)
+	{
+		return 0;
+	}
+
+	return (dac_wave[dac].mask + 1) - (uint16_t) (dac_wave[dac].head - dac_wave[dac].tail);
+}
+
+/**
+ * @brief Obtener las estadísticas del streaming
+ * @param[in] dac Que DAC consultar
+ * @param[out] stats Estadísticas del streaming
+ * @param[in] reset Si es distinto de cero, reinicia la cuenta de underruns y los niveles máximo y mínimo
+ * @return Resultado de la operación
+ */
+hal_dac_wave_result_en hal_dac_stream_get_stats(hal_dac_sel_en dac, hal_dac_stream_stats_t *stats, uint8_t reset)
+{
+	dac_wave_t *wave = &dac_wave[dac];
+	uint32_t primask;
+
+	if(wave->mode != DAC_WAVE_MODE_STREAM)
+	{
+		return HAL_DAC_WAVE_RESULT_WRONG_MODE;
+	}
+
+	// Los campos escritos por la interrupcion del DAC y por el productor (que puede ser otra interrupcion) se leen y
+	// reinician con las interrupciones enmascaradas
+	primask = NVIC_global_disable();
+
+	stats->underruns = wave->underruns;
+	stats->low_watermark = wave->low_watermark;
+	stats->high_watermark = wave->high_watermark;
+	stats->level = (uint16_t) (wave->head - wave->tail);
+
+	if(reset)
+	{
+		wave->underruns = 0;
+		wave->low_watermark = stats->level;
+		wave->high_watermark = stats->level;
+	}
+
+	NVIC_global_restore(primask);
+
+	return HAL_DAC_WAVE_RESULT_OK;
+}
+
+/**
+ * @brief Detener la generación de formas de onda
+ *
+ * El *DAC* mantiene el último valor convertido.
+ *
+ * @param[in] dac Que DAC detener
+ */
+void hal_dac_wave_stop(hal_dac_sel_en dac)
+{
+	DAC_disable_timer(dac);
+	DAC_disable_double_buffer(dac);
+
+	// La escritura limpia un posible flag de timeout pendiente
+	DAC_write(dac, DAC_read(dac));
+
+	// La interrupcion del DAC1 es compartida con PININT5, por lo que no se inhabilita en el NVIC
+	if(dac == HAL_DAC_SEL_0)
+	{
+		NVIC_disable_interrupt(DAC_NVICS[dac]);
+	}
+
+	dac_wave[dac].mode = DAC_WAVE_MODE_NONE;
+}
+
+/**
+ * @brief Calcular el valor de recarga del contador del DAC para una frecuencia de muestreo
+ * @param[in] sample_rate Frecuencia de muestreo deseada en Hz
+ * @param[out] reload Cantidad de ciclos de clock del sistema por muestra
+ * @return Resultado de la operación
+ */
+static hal_dac_wave_result_en hal_dac_wave_calculate_reload(uint32_t sample_rate, uint32_t *reload)
+{
+	if((sample_rate == 0) || (sample_rate > HAL_DAC_WAVE_MAX_SAMPLE_RATE))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_RATE;
+	}
+
+	*reload = hal_div_unsigned(hal_syscon_system_clock_get(), sample_rate);
+
+	if((*reload < 2) || (*reload > 0x10000))
+	{
+		return HAL_DAC_WAVE_RESULT_INVALID_RATE;
+	}
+
+	return HAL_DAC_WAVE_RESULT_OK;
+}
+
+/**
+ * @brief Poner en marcha el contador del DAC con doble buffer
+ * @param[in] dac Que DAC poner en marcha
+ * @param[in] reload Cantidad de ciclos de clock del sistema por muestra
+ * @param[in] first_value Primer valor a convertir
+ */
+static void hal_dac_wave_timer_start(hal_dac_sel_en dac, uint32_t reload, uint16_t first_value)
+{
+	// Con el doble buffer inhabilitado la escritura va directo a la salida
+	DAC_write(dac, first_value);
+
+	// El contador cuenta desde el valor de recarga hasta cero inclusive
+	DAC_write_reaload_value(dac, reload - 1);
+	DAC_enable_double_buffer(dac);
+	NVIC_enable_interrupt(DAC_NVICS[dac]);
+	DAC_enable_timer(dac);
+}
+
+/**
+ * @brief Manejo de la interrupción del contador de un DAC
+ *
+ * La escritura del valor limpia el flag de timeout del contador.
+ *
+ * @param[in] dac DAC que generó la interrupción
+ */
+static void hal_dac_handle_irq(hal_dac_sel_en dac)
+{
+	dac_wave_t *wave = &dac_wave[dac];
+
+	switch(wave->mode)
+	{
+	case DAC_WAVE_MODE_TABLE:
+	{
+		DAC_write(dac, wave->table[wave->index]);
+
+		if(++wave->index >= wave->length)
+		{
+			wave->index = 0;
+		}
+
+		break;
+	}
+
+	case DAC_WAVE_MODE_DDS:
+	{
+		wave->phase += wave->tuning_word;
+		DAC_write(dac, wave->table[wave->phase >> wave->phase_shift]);
+		break;
+	}
+
+	case DAC_WAVE_MODE_STREAM:
+	{
+		uint16_t tail = wave->tail;
+		uint16_t level = (uint16_t) (wave->head - tail);
+
+		if(!wave->primed)
+		{
+			// Se espera a tener medio buffer cargado antes de comenzar la reproduccion
+			if(level <= (wave->mask >> 1))
+			{
+				DAC_write(dac, DAC_read(dac));
+				break;
+			}
+
+			wave->primed = 1;
+		}
+
+		if(level < wave->low_watermark)
+		{
+			wave->low_watermark = level;
+		}
+
+		if(level == 0)
+		{
+			// Se mantiene el ultimo valor, la escritura es necesaria para limpiar el flag
+			wave->underruns++;
+			DAC_write(dac, DAC_read(dac));
+		}
+		else
+		{
+			DAC_write(dac, wave->buffer[tail & wave->mask]);
+			wave->tail = tail + 1;
+		}
+
+		break;
+	}
+
+	default: { break; }
+	}
+}
+
+/**
+ * @brief Interrupción para DAC0
+ */
+void DAC0_IRQHandler(void)
+{
+	hal_dac_handle_irq(HAL_DAC_SEL_0);
+}
+
+/*
+ * NOTA IMPORTANTE:
+ *
+ * La interrupcion del DAC1 se encuentra en el archivo HAL_PININT.c ya que es compartida con
+ * la interrupcion del canal 5 de PININT. Desde ese archivo se llama a esta funcion.
+ */
+
+void DAC1_irq(void)
+{
+	if((dac_wave[HAL_DAC_SEL_1].mode != DAC_WAVE_MODE_NONE) && DAC_get_timer_flag(HAL_DAC_SEL_1))
+	{
+		hal_dac_handle_irq(HAL_DAC_SEL_1);
+	}
+}
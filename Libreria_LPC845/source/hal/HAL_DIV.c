@@ -0,0 +1,313 @@
+/**
+ * @file HAL_DIV.c
+ * @brief Funciones a nivel de aplicacion de las rutinas de división entera (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HAL_DIV.h>
+#include <HAL_RAMFUNC.h>
+#include <HPL_DIV.h>
+
+/** Incremento del numerador entre iteraciones de la medición, para recorrer todo el rango de 32 bits */
+#define		DIV_BENCHMARK_STEP			0x9E3779B1
+
+static inline uint32_t hal_div_mulhi(uint32_t a, uint32_t b);
+
+static uint32_t hal_div_long_step(uint32_t high, uint32_t low, uint32_t divisor);
+
+/**
+ * @brief División sin signo
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente
+ */
+uint32_t hal_div_unsigned(uint32_t numerator, uint32_t denominator)
+{
+	return DIV_unsigned(numerator, denominator);
+}
+
+/**
+ * @brief División con signo
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente, truncado hacia cero
+ */
+int32_t hal_div_signed(int32_t numerator, int32_t denominator)
+{
+	return DIV_signed(numerator, denominator);
+}
+
+/**
+ * @brief División sin signo obteniendo cociente y resto
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente y resto
+ */
+hal_div_unsigned_result_t hal_div_unsigned_divmod(uint32_t numerator, uint32_t denominator)
+{
+	DIV_unsigned_result_t aux = DIV_unsigned_divmod(numerator, denominator);
+	hal_div_unsigned_result_t result = { .quot = aux.quot, .rem = aux.rem };
+
+	return result;
+}
+
+/**
+ * @brief División con signo obteniendo cociente y resto
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente, truncado hacia cero, y resto con el signo del numerador
+ */
+hal_div_signed_result_t hal_div_signed_divmod(int32_t numerator, int32_t denominator)
+{
+	DIV_signed_result_t aux = DIV_signed_divmod(numerator, denominator);
+	hal_div_signed_result_t result = { .quot = aux.quot, .rem = aux.rem };
+
+	return result;
+}
+
+/**
+ * @brief División sin signo de un numerador de 64 bits
+ *
+ * La parte alta se divide directamente, y el resto junto con la parte baja se dividen en dos pasos de 16 bits
+ * (Hacker's Delight, algoritmo *divlu*), de modo que todas las divisiones son de 32 bits y se resuelven con las
+ * rutinas de la ROM, evitando la división de 64 bits de la biblioteca.
+ *
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. No puede ser cero
+ * @return Cociente
+ */
+uint64_t hal_div_unsigned_64(uint64_t numerator, uint32_t denominator)
+{
+	uint32_t high = (uint32_t) (numerator >> 32);
+	DIV_unsigned_result_t high_div;
+
+	if(high == 0)
+	{
+		return DIV_unsigned((uint32_t) numerator, denominator);
+	}
+
+	high_div = DIV_unsigned_divmod(high, denominator);
+
+	return ((uint64_t) high_div.quot << 32) | hal_div_long_step(high_div.rem, (uint32_t) numerator, denominator);
+}
+
+/**
+ * @brief Calcular los parámetros de división por un divisor constante
+ *
+ * Siendo l = ceil(log2(divisor)), el multiplicador es floor(2^32 * (2^l - divisor) / divisor) + 1, lo cual garantiza
+ * el cociente exacto para todo numerador de 32 bits (Granlund y Montgomery, 1994).
+ *
+ * @param[out] reciprocal Parámetros calculados
+ * @param[in] divisor Divisor
+ * @return Resultado de la operación
+ */
+hal_div_result_en hal_div_reciprocal_init(hal_div_reciprocal_t *reciprocal, uint32_t divisor)
+{
+	uint8_t log2_ceil = 0;
+
+	if(divisor == 0)
+	{
+		return HAL_DIV_RESULT_DIVISION_BY_ZERO;
+	}
+
+	while((log2_ceil < 32) && ((1UL << log2_ceil) < divisor))
+	{
+		log2_ceil++;
+	}
+
+	reciprocal->divisor = divisor;
+	reciprocal->multiplier = (uint32_t) hal_div_unsigned_64((((uint64_t) 1 << log2_ceil) - divisor) << 32, divisor) + 1;
+	reciprocal->shift_1 = (log2_ceil > 0) ? 1 : 0;
+	reciprocal->shift_2 = (log2_ceil > 0) ? (log2_ceil - 1) : 0;
+
+	return HAL_DIV_RESULT_OK;
+}
+
+/**
+ * @brief Dividir por un divisor constante
+ * @param[in] reciprocal Parámetros calculados con @ref hal_div_reciprocal_init
+ * @param[in] numerator Numerador
+ * @return Cociente
+ */
+HAL_RAMFUNC uint32_t hal_div_reciprocal_apply(const hal_div_reciprocal_t *reciprocal, uint32_t numerator)
+{
+	uint32_t high = hal_div_mulhi(reciprocal->multiplier, numerator);
+
+	return (high + ((numerator - high) >> reciprocal->shift_1)) >> reciprocal->shift_2;
+}
+
+/**
+ * @brief Dividir por un divisor constante obteniendo cociente y resto
+ * @param[in] reciprocal Parámetros calculados con @ref hal_div_reciprocal_init
+ * @param[in] numerator Numerador
+ * @return Cociente y resto
+ */
+HAL_RAMFUNC hal_div_unsigned_result_t hal_div_reciprocal_divmod(const hal_div_reciprocal_t *reciprocal, uint32_t numerator)
+{
+	hal_div_unsigned_result_t result;
+
+	result.quot = hal_div_reciprocal_apply(reciprocal, numerator);
+	result.rem = numerator - (result.quot * reciprocal->divisor);
+
+	return result;
+}
+
+/**
+ * @brief Medir el costo de las alternativas de división para un divisor
+ * @param[in] divisor Divisor a medir
+ * @param[in] timestamp Lectura de un contador por hardware
+ * @param[out] result Tiempos medidos
+ * @return Resultado de la operación
+ */
+hal_div_result_en hal_div_benchmark(uint32_t divisor, hal_div_timestamp_callback timestamp, hal_div_benchmark_t *result)
+{
+	// Los resultados se acumulan en una variable volatile para que el compilador no elimine las divisiones, y el
+	// divisor se lee de una variable volatile para que no las reemplace por multiplicaciones
+	volatile uint32_t runtime_divisor = divisor;
+	volatile uint32_t sink = 0;
+	hal_div_reciprocal_t reciprocal;
+	uint32_t numerator;
+	uint32_t counter;
+	uint32_t start;
+
+	if(hal_div_reciprocal_init(&reciprocal, divisor) != HAL_DIV_RESULT_OK)
+	{
+		return HAL_DIV_RESULT_DIVISION_BY_ZERO;
+	}
+
+	start = timestamp();
+	for(counter = 0, numerator = 0; counter < HAL_DIV_BENCHMARK_ITERATIONS; counter++, numerator += DIV_BENCHMARK_STEP)
+	{
+		sink += numerator;
+	}
+	result->overhead = timestamp() - start;
+
+	start = timestamp();
+	for(counter = 0, numerator = 0; counter < HAL_DIV_BENCHMARK_ITERATIONS; counter++, numerator += DIV_BENCHMARK_STEP)
+	{
+		sink += numerator / runtime_divisor;
+	}
+	result->compiler = timestamp() - start;
+
+	start = timestamp();
+	for(counter = 0, numerator = 0; counter < HAL_DIV_BENCHMARK_ITERATIONS; counter++, numerator += DIV_BENCHMARK_STEP)
+	{
+		sink += hal_div_unsigned(numerator, runtime_divisor);
+	}
+	result->rom = timestamp() - start;
+
+	start = timestamp();
+	for(counter = 0, numerator = 0; counter < HAL_DIV_BENCHMARK_ITERATIONS; counter++, numerator += DIV_BENCHMARK_STEP)
+	{
+		sink += hal_div_reciprocal_apply(&reciprocal, numerator);
+	}
+	result->reciprocal = timestamp() - start;
+
+	(void) sink;
+
+	return HAL_DIV_RESULT_OK;
+}
+
+/**
+ * @brief Paso de división de 64 por 32 bits con cociente de 32 bits
+ *
+ * El divisor se normaliza (bit más significativo en uno) y el cociente se obtiene de a 16 bits, estimando cada
+ * dígito con una división de 32 bits por los 16 bits superiores del divisor y corrigiendo la estimación.
+ *
+ * @param[in] high Parte alta del numerador. Debe ser menor al divisor
+ * @param[in] low Parte baja del numerador
+ * @param[in] divisor Divisor
+ * @return Cociente
+ */
+static uint32_t hal_div_long_step(uint32_t high, uint32_t low, uint32_t divisor)
+{
+	DIV_unsigned_result_t digit;
+	uint8_t shift = 0;
+	uint32_t divisor_hi;
+	uint32_t divisor_lo;
+	uint32_t numerator_32;
+	uint32_t numerator_21;
+	uint32_t numerator_10;
+	uint32_t numerator_1;
+	uint32_t numerator_0;
+	uint32_t quot_1;
+	uint32_t quot_0;
+
+	while(!(divisor & 0x80000000))
+	{
+		divisor <<= 1;
+		shift++;
+	}
+
+	divisor_hi = divisor >> 16;
+	divisor_lo = divisor & 0xFFFF;
+
+	numerator_32 = (shift == 0) ? high : ((high << shift) | (low >> (32 - shift)));
+	numerator_10 = low << shift;
+	numerator_1 = numerator_10 >> 16;
+	numerator_0 = numerator_10 & 0xFFFF;
+
+	// Primer dígito del cociente
+	digit = DIV_unsigned_divmod(numerator_32, divisor_hi);
+	quot_1 = digit.quot;
+
+	while((quot_1 > 0xFFFF) || ((quot_1 * divisor_lo) > ((digit.rem << 16) + numerator_1)))
+	{
+		quot_1--;
+		digit.rem += divisor_hi;
+
+		if(digit.rem > 0xFFFF)
+		{
+			break;
+		}
+	}
+
+	// Las restas se hacen modulo 2^32, el resultado es exacto
+	numerator_21 = (numerator_32 << 16) + numerator_1 - (quot_1 * divisor);
+
+	// Segundo dígito del cociente
+	digit = DIV_unsigned_divmod(numerator_21, divisor_hi);
+	quot_0 = digit.quot;
+
+	while((quot_0 > 0xFFFF) || ((quot_0 * divisor_lo) > ((digit.rem << 16) + numerator_0)))
+	{
+		quot_0--;
+		digit.rem += divisor_hi;
+
+		if(digit.rem > 0xFFFF)
+		{
+			break;
+		}
+	}
+
+	return (quot_1 << 16) + quot_0;
+}
+
+/**
+ * @brief Parte alta del producto de 64 bits de dos números de 32 bits
+ *
+ * El Cortex-M0+ solamente multiplica 32x32 bits con resultado de 32 bits, por lo que el producto se arma a partir
+ * de cuatro productos parciales de 16x16 bits, evitando el llamado a la multiplicación de 64 bits de la biblioteca.
+ *
+ * @param[in] a Primer factor
+ * @param[in] b Segundo factor
+ * @return Parte alta (32 bits superiores) del producto
+ */
+static inline uint32_t hal_div_mulhi(uint32_t a, uint32_t b)
+{
+	uint32_t a_lo = a & 0xFFFF;
+	uint32_t a_hi = a >> 16;
+	uint32_t b_lo = b & 0xFFFF;
+	uint32_t b_hi = b >> 16;
+
+	uint32_t lo_lo = a_lo * b_lo;
+	uint32_t lo_hi = a_lo * b_hi;
+	uint32_t hi_lo = a_hi * b_lo;
+	uint32_t hi_hi = a_hi * b_hi;
+
+	uint32_t middle = (lo_lo >> 16) + (lo_hi & 0xFFFF) + (hi_lo & 0xFFFF);
+
+	return hi_hi + (lo_hi >> 16) + (hi_lo >> 16) + (middle >> 16);
+}
@@ -0,0 +1,586 @@
+/**
+ * @file HAL_EEPROM.c
+ * @brief Funciones a nivel de aplicacion de la emulacion de EEPROM en flash (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_IAP.h>
+#include <HAL_DIV.h>
+#include <HAL_EEPROM.h>
+
+/** Marca de encabezado de banco valido */
+#define		HAL_EEPROM_BANK_MAGIC			0x45455042
+
+/** Marca de pagina de registros */
+#define		HAL_EEPROM_PAGE_MAGIC			0x45455052
+
+/** Cantidad de bytes cubiertos por el CRC de una pagina */
+#define		HAL_EEPROM_CRC_LENGTH			(HAL_IAP_PAGE_SIZE - sizeof(uint16_t))
+
+/** Valor de una palabra de flash borrada */
+#define		HAL_EEPROM_ERASED_WORD			0xFFFFFFFF
+
+/** Registro de una clave */
+typedef struct
+{
+	uint16_t key; /**< Clave */
+	uint16_t reserved; /**< Sin uso, 0xFFFF */
+	uint32_t value; /**< Valor */
+}hal_eeprom_record_t;
+
+/** Pagina de registros */
+typedef struct
+{
+	hal_eeprom_record_t record[HAL_EEPROM_RECORDS_PER_PAGE]; /**< Registros, en orden de escritura */
+	uint32_t magic; /**< @ref HAL_EEPROM_PAGE_MAGIC */
+	uint16_t count; /**< Cantidad de registros utilizados */
+	uint16_t crc; /**< CRC de los campos anteriores */
+}hal_eeprom_page_t;
+
+/** Encabezado de banco */
+typedef struct
+{
+	uint32_t magic; /**< @ref HAL_EEPROM_BANK_MAGIC */
+	uint32_t sequence; /**< Numero de secuencia, mayor en el banco mas reciente */
+	uint32_t reserved[13]; /**< Sin uso, borrado */
+	uint16_t reserved_2; /**< Sin uso, borrado */
+	uint16_t crc; /**< CRC de los campos anteriores */
+}hal_eeprom_header_t;
+
+static const uint16_t hal_eeprom_crc16_table[] = { //!< CRC16-CCITT de cada nibble
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static uint16_t hal_eeprom_crc16(const void *data);
+static uint32_t hal_eeprom_bank_size(const hal_eeprom_t *eeprom);
+static uint8_t hal_eeprom_header_valid(uint32_t bank_address, uint32_t *sequence);
+static uint8_t hal_eeprom_page_blank(const hal_eeprom_page_t *page);
+static void hal_eeprom_page_clear(hal_eeprom_page_t *page);
+static void hal_eeprom_page_seal(hal_eeprom_page_t *page, uint8_t count);
+static void hal_eeprom_scan(hal_eeprom_t *eeprom);
+static hal_eeprom_result_en hal_eeprom_erase_bank(const hal_eeprom_t *eeprom, uint32_t bank_address);
+static hal_eeprom_result_en hal_eeprom_write_header(uint32_t bank_address, uint32_t sequence);
+static hal_eeprom_result_en hal_eeprom_compact(hal_eeprom_t *eeprom);
+
+/**
+ * @brief Inicializar una EEPROM emulada
+ * @param[out] eeprom Estado de la EEPROM
+ * @param[in] config Configuracion deseada
+ * @return Resultado de la operacion
+ */
+hal_eeprom_result_en hal_eeprom_init(hal_eeprom_t *eeprom, const hal_eeprom_config_t *config)
+{
+	uint32_t bank_pages = config->bank_sectors * (HAL_IAP_SECTOR_SIZE / HAL_IAP_PAGE_SIZE);
+	uint32_t data_pages = hal_div_unsigned(config->max_keys + HAL_EEPROM_RECORDS_PER_PAGE - 1, HAL_EEPROM_RECORDS_PER_PAGE);
+	uint32_t banks[2];
+	uint32_t sequences[2];
+	uint8_t valid[2];
+	uint8_t bank;
+
+	// Encabezado, registros compactados y al menos una pagina libre, con desplazamientos de 16 bits en el indice
+	if(((1 + data_pages + 1) > bank_pages) || ((config->bank_sectors * HAL_IAP_SECTOR_SIZE) > HAL_EEPROM_INDEX_EMPTY) ||
+			((config->first_sector + (2 * config->bank_sectors)) > HAL_IAP_SECTOR_AMOUNT))
+	{
+		return HAL_EEPROM_RESULT_CONFIG_ERROR;
+	}
+
+	eeprom->config = *config;
+	eeprom->staged_count = 0;
+	eeprom->page_writes = 0;
+	eeprom->compactions = 0;
+
+	hal_eeprom_page_clear((hal_eeprom_page_t *) eeprom->staging);
+
+	banks[0] = config->first_sector * HAL_IAP_SECTOR_SIZE;
+	banks[1] = banks[0] + hal_eeprom_bank_size(eeprom);
+
+	valid[0] = hal_eeprom_header_valid(banks[0], &sequences[0]);
+	valid[1] = hal_eeprom_header_valid(banks[1], &sequences[1]);
+
+	if(!valid[0] && !valid[1])
+	{
+		return hal_eeprom_format(eeprom);
+	}
+
+	if(valid[0] && valid[1])
+	{
+		// Compactacion interrumpida antes de borrar el banco anterior
+		bank = ((int32_t) (sequences[1] - sequences[0]) > 0) ? 1 : 0;
+
+		if(hal_eeprom_erase_bank(eeprom, banks[1 - bank]) != HAL_EEPROM_RESULT_OK)
+		{
+			return HAL_EEPROM_RESULT_FLASH_ERROR;
+		}
+	}
+	else
+	{
+		bank = valid[1] ? 1 : 0;
+	}
+
+	eeprom->bank_address = banks[bank];
+	eeprom->sequence = sequences[bank];
+
+	hal_eeprom_scan(eeprom);
+
+	return HAL_EEPROM_RESULT_OK;
+}
+
+/**
+ * @brief Leer el valor de una clave
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[in] key Clave a leer
+ * @param[out] value Valor de la clave
+ * @return Resultado de la operacion
+ */
+hal_eeprom_result_en hal_eeprom_read(const hal_eeprom_t *eeprom, uint16_t key, uint32_t *value)
+{
+	const hal_eeprom_page_t *staging = (const hal_eeprom_page_t *) eeprom->staging;
+	const hal_eeprom_record_t *record;
+	uint8_t counter;
+
+	if(key >= eeprom->config.max_keys)
+	{
+		return HAL_EEPROM_RESULT_INVALID_KEY;
+	}
+
+	for(counter = 0; counter < eeprom->staged_count; counter++)
+	{
+		if(staging->record[counter].key == key)
+		{
+			*value = staging->record[counter].value;
+
+			return HAL_EEPROM_RESULT_OK;
+		}
+	}
+
+	if(eeprom->config.index[key] == HAL_EEPROM_INDEX_EMPTY)
+	{
+		return HAL_EEPROM_RESULT_NOT_FOUND;
+	}
+
+	record = (const hal_eeprom_record_t *) HAL_EEPROM_FLASH_POINTER(eeprom->bank_address + eeprom->config.index[key]);
+	*value = record->value;
+
+	return HAL_EEPROM_RESULT_OK;
+}
+
+/**
+ * @brief Escribir el valor de una clave
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[in] key Clave a escribir
+ * @param[in] value Valor a escribir
+ * @return Resultado de la operacion
+ */
+hal_eeprom_result_en hal_eeprom_write(hal_eeprom_t *eeprom, uint16_t key, uint32_t value)
+{
+	hal_eeprom_page_t *staging = (hal_eeprom_page_t *) eeprom->staging;
+	hal_eeprom_result_en result;
+	uint32_t current;
+	uint8_t counter;
+
+	result = hal_eeprom_read(eeprom, key, &current);
+
+	if(result == HAL_EEPROM_RESULT_INVALID_KEY)
+	{
+		return result;
+	}
+
+	if((result == HAL_EEPROM_RESULT_OK) && (current == value))
+	{
+		return HAL_EEPROM_RESULT_OK;
+	}
+
+	for(counter = 0; counter < eeprom->staged_count; counter++)
+	{
+		if(staging->record[counter].key == key)
+		{
+			staging->record[counter].value = value;
+
+			return HAL_EEPROM_RESULT_OK;
+		}
+	}
+
+	// Pagina completa que no pudo grabarse anteriormente
+	if(eeprom->staged_count == HAL_EEPROM_RECORDS_PER_PAGE)
+	{
+		if(hal_eeprom_flush(eeprom) != HAL_EEPROM_RESULT_OK)
+		{
+			return HAL_EEPROM_RESULT_FLASH_ERROR;
+		}
+	}
+
+	staging->record[eeprom->staged_count].key = key;
+	staging->record[eeprom->staged_count].value = value;
+	eeprom->staged_count++;
+
+	if(eeprom->staged_count == HAL_EEPROM_RECORDS_PER_PAGE)
+	{
+		return hal_eeprom_flush(eeprom);
+	}
+
+	return HAL_EEPROM_RESULT_OK;
+}
+
+/**
+ * @brief Grabar en flash las escrituras acumuladas
+ * @param[in] eeprom Estado de la EEPROM
+ * @return Resultado de la operacion
+ */
+hal_eeprom_result_en hal_eeprom_flush(hal_eeprom_t *eeprom)
+{
+	hal_eeprom_page_t *staging = (hal_eeprom_page_t *) eeprom->staging;
+	hal_iap_status_en status;
+	uint32_t offset;
+	uint8_t counter;
+
+	if(eeprom->staged_count == 0)
+	{
+		return HAL_EEPROM_RESULT_OK;
+	}
+
+	if(eeprom->next_page >= hal_eeprom_bank_size(eeprom))
+	{
+		if(hal_eeprom_compact(eeprom) != HAL_EEPROM_RESULT_OK)
+		{
+			return HAL_EEPROM_RESULT_FLASH_ERROR;
+		}
+	}
+
+	hal_eeprom_page_seal(staging, eeprom->staged_count);
+
+	// La pagina se considera utilizada aunque la grabacion falle, ya que pudo quedar parcialmente grabada
+	offset = eeprom->next_page;
+	eeprom->next_page += HAL_IAP_PAGE_SIZE;
+	eeprom->page_writes++;
+
+	status = hal_iap_program(eeprom->bank_address + offset, staging, HAL_IAP_PAGE_SIZE);
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		// Los registros quedan acumulados para el proximo intento
+		return HAL_EEPROM_RESULT_FLASH_ERROR;
+	}
+
+	for(counter = 0; counter < eeprom->staged_count; counter++)
+	{
+		eeprom->config.index[staging->record[counter].key] = offset + (counter * sizeof(hal_eeprom_record_t));
+	}
+
+	eeprom->staged_count = 0;
+	hal_eeprom_page_clear(staging);
+
+	return HAL_EEPROM_RESULT_OK;
+}
+
+/**
+ * @brief Borrar todos los valores
+ * @param[in] eeprom Estado de la EEPROM
+ * @return Resultado de la operacion
+ */
+hal_eeprom_result_en hal_eeprom_format(hal_eeprom_t *eeprom)
+{
+	uint32_t bank_address = eeprom->config.first_sector * HAL_IAP_SECTOR_SIZE;
+	uint16_t key;
+
+	for(key = 0; key < eeprom->config.max_keys; key++)
+	{
+		eeprom->config.index[key] = HAL_EEPROM_INDEX_EMPTY;
+	}
+
+	eeprom->staged_count = 0;
+	hal_eeprom_page_clear((hal_eeprom_page_t *) eeprom->staging);
+
+	eeprom->bank_address = bank_address;
+	eeprom->sequence = 0;
+	eeprom->next_page = HAL_IAP_PAGE_SIZE;
+
+	if(hal_iap_erase_sectors(eeprom->config.first_sector, eeprom->config.first_sector + (2 * eeprom->config.bank_sectors) - 1) != HAL_IAP_STATUS_SUCCESS)
+	{
+		return HAL_EEPROM_RESULT_FLASH_ERROR;
+	}
+
+	return hal_eeprom_write_header(bank_address, 0);
+}
+
+/**
+ * @brief Calcular el CRC16 de los campos protegidos de una pagina
+ * @param[in] data Pagina
+ * @return CRC16-CCITT (polinomio x^16 + x^12 + x^5 + 1, valor inicial 0xFFFF)
+ */
+static uint16_t hal_eeprom_crc16(const void *data)
+{
+	const uint8_t *bytes = data;
+	uint16_t crc = 0xFFFF;
+	uint32_t length;
+
+	for(length = HAL_EEPROM_CRC_LENGTH; length != 0; length--)
+	{
+		crc = (crc << 4) ^ hal_eeprom_crc16_table[(crc >> 12) ^ (*bytes >> 4)];
+		crc = (crc << 4) ^ hal_eeprom_crc16_table[(crc >> 12) ^ (*bytes & 0x0F)];
+		bytes++;
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Obtener el tamaño de un banco
+ * @param[in] eeprom Estado de la EEPROM
+ * @return Tamaño de un banco en bytes
+ */
+static uint32_t hal_eeprom_bank_size(const hal_eeprom_t *eeprom)
+{
+	return eeprom->config.bank_sectors * HAL_IAP_SECTOR_SIZE;
+}
+
+/**
+ * @brief Verificar el encabezado de un banco
+ * @param[in] bank_address Direccion del banco
+ * @param[out] sequence Numero de secuencia del banco
+ * @return Distinto de cero si el encabezado es valido
+ */
+static uint8_t hal_eeprom_header_valid(uint32_t bank_address, uint32_t *sequence)
+{
+	const hal_eeprom_header_t *header = (const hal_eeprom_header_t *) HAL_EEPROM_FLASH_POINTER(bank_address);
+
+	if((header->magic != HAL_EEPROM_BANK_MAGIC) || (header->crc != hal_eeprom_crc16(header)))
+	{
+		return 0;
+	}
+
+	*sequence = header->sequence;
+
+	return 1;
+}
+
+/**
+ * @brief Verificar si una pagina esta completamente borrada
+ * @param[in] page Pagina a verificar
+ * @return Distinto de cero si la pagina esta borrada
+ */
+static uint8_t hal_eeprom_page_blank(const hal_eeprom_page_t *page)
+{
+	const uint32_t *words = (const uint32_t *) page;
+	uint8_t counter;
+
+	for(counter = 0; counter < (HAL_IAP_PAGE_SIZE / sizeof(uint32_t)); counter++)
+	{
+		if(words[counter] != HAL_EEPROM_ERASED_WORD)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Llevar una pagina en RAM al estado borrado
+ * @param[out] page Pagina
+ */
+static void hal_eeprom_page_clear(hal_eeprom_page_t *page)
+{
+	uint32_t *words = (uint32_t *) page;
+	uint8_t counter;
+
+	for(counter = 0; counter < (HAL_IAP_PAGE_SIZE / sizeof(uint32_t)); counter++)
+	{
+		words[counter] = HAL_EEPROM_ERASED_WORD;
+	}
+}
+
+/**
+ * @brief Completar la marca, la cantidad de registros y el CRC de una pagina en RAM
+ * @param[in,out] page Pagina
+ * @param[in] count Cantidad de registros
+ */
+static void hal_eeprom_page_seal(hal_eeprom_page_t *page, uint8_t count)
+{
+	page->magic = HAL_EEPROM_PAGE_MAGIC;
+	page->count = count;
+	page->crc = hal_eeprom_crc16(page);
+}
+
+/**
+ * @brief Armar el indice recorriendo las paginas grabadas del banco activo
+ *
+ * Las paginas se graban en orden, por lo que la primera pagina borrada indica el final. Las paginas invalidas
+ * (grabaciones interrumpidas) se saltean.
+ *
+ * @param[in,out] eeprom Estado de la EEPROM
+ */
+static void hal_eeprom_scan(hal_eeprom_t *eeprom)
+{
+	uint32_t bank_size = hal_eeprom_bank_size(eeprom);
+	uint32_t offset;
+	uint16_t key;
+
+	for(key = 0; key < eeprom->config.max_keys; key++)
+	{
+		eeprom->config.index[key] = HAL_EEPROM_INDEX_EMPTY;
+	}
+
+	for(offset = HAL_IAP_PAGE_SIZE; offset < bank_size; offset += HAL_IAP_PAGE_SIZE)
+	{
+		const hal_eeprom_page_t *page = (const hal_eeprom_page_t *) HAL_EEPROM_FLASH_POINTER(eeprom->bank_address + offset);
+		uint8_t counter;
+
+		if(hal_eeprom_page_blank(page))
+		{
+			break;
+		}
+
+		if((page->magic != HAL_EEPROM_PAGE_MAGIC) || (page->count > HAL_EEPROM_RECORDS_PER_PAGE) ||
+				(page->crc != hal_eeprom_crc16(page)))
+		{
+			continue;
+		}
+
+		for(counter = 0; counter < page->count; counter++)
+		{
+			key = page->record[counter].key;
+
+			// Las claves fuera de rango corresponden a una configuracion anterior
+			if(key < eeprom->config.max_keys)
+			{
+				eeprom->config.index[key] = offset + (counter * sizeof(hal_eeprom_record_t));
+			}
+		}
+	}
+
+	eeprom->next_page = offset;
+}
+
+/**
+ * @brief Borrar un banco
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[in] bank_address Direccion del banco
+ * @return Resultado de la operacion
+ */
+static hal_eeprom_result_en hal_eeprom_erase_bank(const hal_eeprom_t *eeprom, uint32_t bank_address)
+{
+	uint32_t sector = HAL_IAP_ADDRESS_TO_SECTOR(bank_address);
+
+	if(hal_iap_erase_sectors(sector, sector + eeprom->config.bank_sectors - 1) != HAL_IAP_STATUS_SUCCESS)
+	{
+		return HAL_EEPROM_RESULT_FLASH_ERROR;
+	}
+
+	return HAL_EEPROM_RESULT_OK;
+}
+
+/**
+ * @brief Grabar el encabezado de un banco, lo cual lo convierte en valido
+ * @param[in] bank_address Direccion del banco
+ * @param[in] sequence Numero de secuencia
+ * @return Resultado de la operacion
+ */
+static hal_eeprom_result_en hal_eeprom_write_header(uint32_t bank_address, uint32_t sequence)
+{
+	uint32_t buffer[HAL_IAP_PAGE_SIZE / sizeof(uint32_t)];
+	hal_eeprom_header_t *header = (hal_eeprom_header_t *) buffer;
+
+	hal_eeprom_page_clear((hal_eeprom_page_t *) buffer);
+
+	header->magic = HAL_EEPROM_BANK_MAGIC;
+	header->sequence = sequence;
+	header->crc = hal_eeprom_crc16(header);
+
+	if(hal_iap_program(bank_address, buffer, HAL_IAP_PAGE_SIZE) != HAL_IAP_STATUS_SUCCESS)
+	{
+		return HAL_EEPROM_RESULT_FLASH_ERROR;
+	}
+
+	return HAL_EEPROM_RESULT_OK;
+}
+
+/**
+ * @brief Copiar el valor vigente de cada clave al otro banco y activarlo
+ *
+ * El encabezado del nuevo banco se graba luego de todos los registros, y el banco anterior se borra recien despues,
+ * por lo que ante un corte en cualquier punto alguno de los dos bancos conserva todos los valores.
+ *
+ * @param[in,out] eeprom Estado de la EEPROM
+ * @return Resultado de la operacion
+ */
+static hal_eeprom_result_en hal_eeprom_compact(hal_eeprom_t *eeprom)
+{
+	uint32_t buffer[HAL_IAP_PAGE_SIZE / sizeof(uint32_t)];
+	hal_eeprom_page_t *page = (hal_eeprom_page_t *) buffer;
+	uint32_t first_bank = eeprom->config.first_sector * HAL_IAP_SECTOR_SIZE;
+	uint32_t old_bank = eeprom->bank_address;
+	uint32_t new_bank;
+	uint32_t offset = HAL_IAP_PAGE_SIZE;
+	uint8_t count = 0;
+	uint16_t key;
+
+	new_bank = (old_bank == first_bank) ? (first_bank + hal_eeprom_bank_size(eeprom)) : first_bank;
+
+	if(hal_eeprom_erase_bank(eeprom, new_bank) != HAL_EEPROM_RESULT_OK)
+	{
+		return HAL_EEPROM_RESULT_FLASH_ERROR;
+	}
+
+	hal_eeprom_page_clear(page);
+
+	for(key = 0; key <= eeprom->config.max_keys; key++)
+	{
+		if(key < eeprom->config.max_keys)
+		{
+			const hal_eeprom_record_t *record;
+
+			if(eeprom->config.index[key] == HAL_EEPROM_INDEX_EMPTY)
+			{
+				continue;
+			}
+
+			record = (const hal_eeprom_record_t *) HAL_EEPROM_FLASH_POINTER(old_bank + eeprom->config.index[key]);
+
+			page->record[count].key = key;
+			page->record[count].value = record->value;
+			count++;
+
+			if(count != HAL_EEPROM_RECORDS_PER_PAGE)
+			{
+				continue;
+			}
+		}
+		else if(count == 0)
+		{
+			break;
+		}
+
+		hal_eeprom_page_seal(page, count);
+
+		if(hal_iap_program(new_bank + offset, buffer, HAL_IAP_PAGE_SIZE) != HAL_IAP_STATUS_SUCCESS)
+		{
+			// El banco anterior sigue siendo el activo
+			return HAL_EEPROM_RESULT_FLASH_ERROR;
+		}
+
+		offset += HAL_IAP_PAGE_SIZE;
+		count = 0;
+		hal_eeprom_page_clear(page);
+	}
+
+	if(hal_eeprom_write_header(new_bank, eeprom->sequence + 1) != HAL_EEPROM_RESULT_OK)
+	{
+		return HAL_EEPROM_RESULT_FLASH_ERROR;
+	}
+
+	eeprom->bank_address = new_bank;
+	eeprom->sequence++;
+	eeprom->compactions++;
+
+	// Un error al borrar el banco anterior no compromete los datos: se vuelve a borrar antes de la proxima
+	// compactacion, y la inicializacion descarta el banco de menor secuencia
+	(void) hal_eeprom_erase_bank(eeprom, old_bank);
+
+	hal_eeprom_scan(eeprom);
+
+	return HAL_EEPROM_RESULT_OK;
+}
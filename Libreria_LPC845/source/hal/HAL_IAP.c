@@ -0,0 +1,322 @@
+/**
+ * @file HAL_IAP.c
+ * @brief Funciones a nivel de aplicacion de la programacion en aplicacion (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_IAP.h>
+#include <HAL_SYSCON.h>
+#include <HAL_DIV.h>
+#include <HAL_RAMFUNC.h>
+#include <HPL_IAP.h>
+#include <HPL_NVIC.h>
+
+/** Tamaños de escritura admitidos por el comando de copia, de mayor a menor */
+static const uint16_t IAP_PROGRAM_SIZES[] = { 1024, 512, 256, 128, 64 };
+
+static hal_iap_status_en iap_command(uint32_t *command, uint32_t *result);
+
+static hal_iap_status_en iap_prepare(uint32_t start_sector, uint32_t end_sector);
+
+static uint32_t iap_clock_khz(void);
+
+/**
+ * @brief Borrar sectores
+ * @param[in] start_sector Primer sector a borrar
+ * @param[in] end_sector Ultimo sector a borrar (inclusive)
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_erase_sectors(uint32_t start_sector, uint32_t end_sector)
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_ERASE_SECTORS, start_sector, end_sector, iap_clock_khz() };
+	uint32_t result[IAP_RESULT_LENGTH];
+	hal_iap_status_en status = iap_prepare(start_sector, end_sector);
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	return iap_command(command, result);
+}
+
+/**
+ * @brief Borrar paginas
+ * @param[in] start_page Primera pagina a borrar
+ * @param[in] end_page Ultima pagina a borrar (inclusive)
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_erase_pages(uint32_t start_page, uint32_t end_page)
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_ERASE_PAGES, start_page, end_page, iap_clock_khz() };
+	uint32_t result[IAP_RESULT_LENGTH];
+	hal_iap_status_en status;
+
+	status = iap_prepare(HAL_IAP_ADDRESS_TO_SECTOR(start_page * HAL_IAP_PAGE_SIZE),
+			HAL_IAP_ADDRESS_TO_SECTOR(end_page * HAL_IAP_PAGE_SIZE));
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	return iap_command(command, result);
+}
+
+/**
+ * @brief Escribir datos en flash
+ * @param[in] address Direccion de flash, alineada a una pagina
+ * @param[in] data Datos a escribir
+ * @param[in] length Cantidad de bytes, multiplo de una pagina
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_program(uint32_t address, const void *data, uint32_t length)
+{
+	const uint8_t *source = data;
+	uint32_t clock_khz = iap_clock_khz();
+
+	if((address % HAL_IAP_PAGE_SIZE) != 0)
+	{
+		return HAL_IAP_STATUS_DST_ADDR_ERROR;
+	}
+
+	if((length % HAL_IAP_PAGE_SIZE) != 0)
+	{
+		return HAL_IAP_STATUS_COUNT_ERROR;
+	}
+
+	while(length != 0)
+	{
+		uint32_t command[IAP_COMMAND_LENGTH];
+		uint32_t result[IAP_RESULT_LENGTH];
+		hal_iap_status_en status;
+		uint32_t size;
+		uint32_t counter;
+
+		// Mayor tamaño admitido que entra en lo restante y para el cual la direccion esta alineada, por lo que la
+		// operacion nunca abarca mas de un sector
+		for(counter = 0; ; counter++)
+		{
+			size = IAP_PROGRAM_SIZES[counter];
+
+			if((size <= length) && ((address % size) == 0))
+			{
+				break;
+			}
+		}
+
+		status = iap_prepare(HAL_IAP_ADDRESS_TO_SECTOR(address), HAL_IAP_ADDRESS_TO_SECTOR(address));
+
+		if(status != HAL_IAP_STATUS_SUCCESS)
+		{
+			return status;
+		}
+
+		command[0] = IAP_COMMAND_COPY_RAM_TO_FLASH;
+		command[1] = address;
+		command[2] = (uint32_t) source;
+		command[3] = size;
+		command[4] = clock_khz;
+
+		status = iap_command(command, result);
+
+		if(status != HAL_IAP_STATUS_SUCCESS)
+		{
+			return status;
+		}
+
+		address += size;
+		source += size;
+		length -= size;
+	}
+
+	return HAL_IAP_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Verificar que un rango de sectores este borrado
+ * @param[in] start_sector Primer sector a verificar
+ * @param[in] end_sector Ultimo sector a verificar (inclusive)
+ * @param[out] non_blank_address Direccion de la primera palabra no borrada
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_blank_check(uint32_t start_sector, uint32_t end_sector, uint32_t *non_blank_address)
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_BLANK_CHECK_SECTORS, start_sector, end_sector };
+	uint32_t result[IAP_RESULT_LENGTH];
+	hal_iap_status_en status = iap_command(command, result);
+
+	if((status == HAL_IAP_STATUS_SECTOR_NOT_BLANK) && (non_blank_address != NULL))
+	{
+		*non_blank_address = (start_sector * HAL_IAP_SECTOR_SIZE) + result[1];
+	}
+
+	return status;
+}
+
+/**
+ * @brief Comparar el contenido de la flash con datos en RAM
+ * @param[in] address Direccion de flash
+ * @param[in] data Datos a comparar
+ * @param[in] length Cantidad de bytes
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_compare(uint32_t address, const void *data, uint32_t length)
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_COMPARE, address, (uint32_t) data, length };
+	uint32_t result[IAP_RESULT_LENGTH];
+
+	return iap_command(command, result);
+}
+
+/**
+ * @brief Leer el identificador de la parte
+ * @param[out] part_id Identificador de la parte
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_read_part_id(uint32_t *part_id)
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_READ_PART_ID };
+	uint32_t result[IAP_RESULT_LENGTH];
+	hal_iap_status_en status = iap_command(command, result);
+
+	*part_id = result[1];
+
+	return status;
+}
+
+/**
+ * @brief Leer el numero de serie unico del dispositivo
+ * @param[out] uid Numero de serie
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_read_uid(uint32_t uid[4])
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_READ_UID };
+	uint32_t result[IAP_RESULT_LENGTH];
+	hal_iap_status_en status = iap_command(command, result);
+	uint8_t counter;
+
+	for(counter = 0; counter < 4; counter++)
+	{
+		uid[counter] = result[counter + 1];
+	}
+
+	return status;
+}
+
+/**
+ * @brief Medir los tiempos de borrado y escritura
+ * @param[in] sector Sector de prueba
+ * @param[in] buffer Datos de prueba de un sector
+ * @param[in] timestamp Lectura de un contador por hardware
+ * @param[out] result Tiempos medidos
+ * @return Codigo de estado
+ */
+hal_iap_status_en hal_iap_benchmark(uint32_t sector, const void *buffer, hal_iap_timestamp_callback timestamp, hal_iap_benchmark_t *result)
+{
+	const uint8_t *source = buffer;
+	uint32_t address = sector * HAL_IAP_SECTOR_SIZE;
+	hal_iap_status_en status;
+	uint32_t start;
+	uint32_t offset;
+
+	// Borrado del sector (el sector puede no estar vacio)
+	start = timestamp();
+	status = hal_iap_erase_sectors(sector, sector);
+	result->sector_erase = timestamp() - start;
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	// Escritura del sector en una unica operacion
+	start = timestamp();
+	status = hal_iap_program(address, source, HAL_IAP_SECTOR_SIZE);
+	result->sector_program = timestamp() - start;
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	// Borrado de una unica pagina
+	start = timestamp();
+	status = hal_iap_erase_pages(HAL_IAP_ADDRESS_TO_PAGE(address), HAL_IAP_ADDRESS_TO_PAGE(address));
+	result->page_erase = timestamp() - start;
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	status = hal_iap_erase_sectors(sector, sector);
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	// Escritura del sector de a una pagina por operacion
+	start = timestamp();
+
+	for(offset = 0; (offset < HAL_IAP_SECTOR_SIZE) && (status == HAL_IAP_STATUS_SUCCESS); offset += HAL_IAP_PAGE_SIZE)
+	{
+		status = hal_iap_program(address + offset, source + offset, HAL_IAP_PAGE_SIZE);
+	}
+
+	result->sector_program_by_pages = timestamp() - start;
+
+	if(status != HAL_IAP_STATUS_SUCCESS)
+	{
+		return status;
+	}
+
+	return hal_iap_erase_sectors(sector, sector);
+}
+
+/**
+ * @brief Ejecutar un comando IAP con las interrupciones enmascaradas
+ * @param[in] command Comando y sus parametros
+ * @param[out] result Codigo de estado y resultados
+ * @return Codigo de estado
+ */
+HAL_RAMFUNC static hal_iap_status_en iap_command(uint32_t *command, uint32_t *result)
+{
+	uint32_t primask;
+
+	primask = NVIC_global_disable();
+
+	IAP_execute(command, result);
+
+	NVIC_global_restore(primask);
+
+	return (hal_iap_status_en) result[0];
+}
+
+/**
+ * @brief Preparar un rango de sectores para borrado o escritura
+ * @param[in] start_sector Primer sector
+ * @param[in] end_sector Ultimo sector (inclusive)
+ * @return Codigo de estado
+ */
+static hal_iap_status_en iap_prepare(uint32_t start_sector, uint32_t end_sector)
+{
+	uint32_t command[IAP_COMMAND_LENGTH] = { IAP_COMMAND_PREPARE_SECTORS, start_sector, end_sector };
+	uint32_t result[IAP_RESULT_LENGTH];
+
+	return iap_command(command, result);
+}
+
+/**
+ * @brief Obtener la frecuencia del clock del sistema en KHz, requerida por los comandos de borrado y escritura
+ * @return Frecuencia del clock del sistema en KHz
+ */
+static uint32_t iap_clock_khz(void)
+{
+	return hal_div_unsigned(hal_syscon_system_clock_get(), 1000);
+}
@@ -0,0 +1,648 @@
+/**
+ * @file HAL_IIC.c
+ * @brief Funciones a nivel de aplicacion del periferico IIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_IIC.h>
+#include <HAL_DIV.h>
+#include <HAL_RAMFUNC.h>
+#include <HPL_IIC.h>
+#include <HPL_IOCON.h>
+#include <HPL_SWM.h>
+#include <HPL_SYSCON.h>
+#include <HPL_NVIC.h>
+
+/** Cantidad maxima de ciclos de clock del periferico por bit (9 en estado bajo y 6 en estado alto) */
+#define		IIC_MAX_CLOCKS_PER_BIT			15
+
+/** Cantidad minima de ciclos de clock del periferico por cada estado de SCL */
+#define		IIC_MIN_SCL_CLOCKS				2
+
+/** Cantidad maxima de ciclos de clock del periferico por cada estado de SCL */
+#define		IIC_MAX_SCL_CLOCKS				9
+
+/** Dato transmitido en modo slave una vez agotada la respuesta */
+#define		IIC_SLAVE_TX_FILL				0xFF
+
+/** Estado del modo master de una instancia */
+typedef struct
+{
+	uint8_t enabled; /**< Distinto de cero si la instancia esta en modo master */
+	uint8_t active; /**< Distinto de cero mientras la transaccion de la cabeza de la cola esta en curso */
+	uint8_t reading; /**< Distinto de cero durante la fase de lectura de la transaccion en curso */
+	uint32_t index; /**< Proximo dato a escribir o leer de la transaccion en curso */
+	hal_iic_master_transaction_t *head; /**< Transaccion en curso o proxima a comenzar. NULL si no hay */
+	hal_iic_master_transaction_t *tail; /**< Ultima transaccion encolada */
+}iic_master_t;
+
+/** Estado del modo slave de una instancia */
+typedef struct
+{
+	uint8_t enabled; /**< Distinto de cero si la instancia esta en modo slave */
+	uint8_t selected; /**< Distinto de cero mientras la instancia esta direccionada */
+	uint8_t address_index; /**< Indice de la direccion de la transferencia en curso */
+	uint8_t *rx_buffer; /**< Buffer de recepcion */
+	uint32_t rx_size; /**< Tamaño del buffer de recepcion */
+	uint32_t rx_length; /**< Cantidad de datos recibidos en el tramo de escritura en curso */
+	const uint8_t *tx_data; /**< Respuesta a las lecturas del master. NULL si no hay */
+	uint32_t tx_length; /**< Cantidad de datos de la respuesta */
+	uint32_t tx_index; /**< Proximo dato de la respuesta a transmitir */
+	hal_iic_slave_select_callback select_callback; /**< Callback de seleccion */
+	hal_iic_slave_rx_callback rx_callback; /**< Callback de recepcion */
+}iic_slave_t;
+
+static void iic_master_start(uint8_t inst);
+
+static void iic_master_finish(uint8_t inst, hal_iic_result_en result);
+
+static void iic_master_irq_handler(uint8_t inst, const IIC_STAT_reg_t *stat);
+
+static void iic_slave_deselect(uint8_t inst);
+
+static void iic_slave_irq_handler(uint8_t inst, const IIC_STAT_reg_t *stat);
+
+static void iic_irq_handler(uint8_t inst);
+
+static iic_master_t iic_master[4]; //!< Estado del modo master de cada instancia
+
+static iic_slave_t iic_slave[4]; //!< Estado del modo slave de cada instancia
+
+static const SYSCON_peripheral_sel_en IIC_SYSCON_PER[] = {
+	SYSCON_PERIPHERAL_SEL_I2C0,
+	SYSCON_PERIPHERAL_SEL_I2C1,
+	SYSCON_PERIPHERAL_SEL_I2C2,
+	SYSCON_PERIPHERAL_SEL_I2C3
+};
+
+static const SYSCON_enable_clock_sel_en IIC_SYSCON_CLOCK_ENABLE[] = {
+	SYSCON_ENABLE_CLOCK_SEL_IIC0,
+	SYSCON_ENABLE_CLOCK_SEL_IIC1,
+	SYSCON_ENABLE_CLOCK_SEL_IIC2,
+	SYSCON_ENABLE_CLOCK_SEL_IIC3
+};
+
+static const SYSCON_reset_sel_en IIC_SYSCON_RESET_SEL[] = {
+	SYSCON_RESET_SEL_IIC0,
+	SYSCON_RESET_SEL_IIC1,
+	SYSCON_RESET_SEL_IIC2,
+	SYSCON_RESET_SEL_IIC3
+};
+
+static const NVIC_irq_sel_en IIC_NVICS[] = {
+	NVIC_IRQ_SEL_IIC0,
+	NVIC_IRQ_SEL_IIC1,
+	NVIC_IRQ_SEL_IIC2,
+	NVIC_IRQ_SEL_IIC3
+};
+
+/**
+ * @brief Inicializar una instancia de IIC
+ * @param[in] inst Instancia a inicializar
+ * @param[in] config Configuracion deseada
+ */
+void hal_iic_init(hal_iic_sel_en inst, const hal_iic_config_t *config)
+{
+	SWM_init();
+	SWM_assign_iic_SDA(inst, HAL_GPIO_PORTPIN_TO_PORT(config->sda_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->sda_portpin));
+	SWM_assign_iic_SCL(inst, HAL_GPIO_PORTPIN_TO_PORT(config->scl_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->scl_portpin));
+	SWM_deinit();
+
+	IOCON_init();
+
+	if(inst == HAL_IIC_0)
+	{
+		// Pines de colector abierto reales, el modo define el filtro y la capacidad de corriente
+		IOCON_iic_mode_en mode = config->fast_mode_plus ? IOCON_IIC_MODE_FAST_MODE : IOCON_IIC_MODE_STANDARD;
+
+		IOCON_select_iic0_scl(mode);
+		IOCON_select_iic0_sda(mode);
+	}
+	else
+	{
+		IOCON_enable_open_drain(HAL_GPIO_PORTPIN_TO_PORT(config->sda_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->sda_portpin));
+		IOCON_enable_open_drain(HAL_GPIO_PORTPIN_TO_PORT(config->scl_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->scl_portpin));
+	}
+
+	IOCON_deinit();
+
+	SYSCON_set_peripheral_clock_source(IIC_SYSCON_PER[inst], config->clock_source);
+	SYSCON_enable_clock(IIC_SYSCON_CLOCK_ENABLE[inst]);
+	SYSCON_clear_reset(IIC_SYSCON_RESET_SEL[inst]);
+	NVIC_enable_interrupt(IIC_NVICS[inst]);
+}
+
+/**
+ * @brief Inicializar el modo master de una instancia
+ * @param[in] inst Instancia a inicializar
+ * @param[in] bitrate Velocidad deseada en Hz
+ * @return Velocidad obtenida en Hz
+ */
+uint32_t hal_iic_master_init(hal_iic_sel_en inst, uint32_t bitrate)
+{
+	uint32_t clock = hal_syscon_peripheral_clock_get(IIC_SYSCON_PER[inst]);
+	uint32_t cycles;
+	uint32_t div;
+	uint32_t scl_clocks;
+	uint32_t low;
+	uint32_t high;
+
+	// Todos los redondeos son hacia arriba, para no superar la velocidad deseada
+	cycles = hal_div_unsigned(clock + bitrate - 1, bitrate);
+	div = hal_div_unsigned(cycles + IIC_MAX_CLOCKS_PER_BIT - 1, IIC_MAX_CLOCKS_PER_BIT);
+
+	if(div == 0)
+	{
+		div = 1;
+	}
+	else if(div > 0x10000)
+	{
+		div = 0x10000;
+	}
+
+	scl_clocks = hal_div_unsigned(cycles + div - 1, div);
+
+	if(scl_clocks < (2 * IIC_MIN_SCL_CLOCKS))
+	{
+		scl_clocks = 2 * IIC_MIN_SCL_CLOCKS;
+	}
+	else if(scl_clocks > (2 * IIC_MAX_SCL_CLOCKS))
+	{
+		scl_clocks = 2 * IIC_MAX_SCL_CLOCKS;
+	}
+
+	// Estado bajo de aproximadamente el 60% del periodo (tLOW minimo es el doble de tHIGH minimo en ambos modos)
+	low = hal_div_unsigned((3 * scl_clocks) + 4, 5);
+
+	if(low > IIC_MAX_SCL_CLOCKS)
+	{
+		low = IIC_MAX_SCL_CLOCKS;
+	}
+
+	high = scl_clocks - low;
+
+	if(high < IIC_MIN_SCL_CLOCKS)
+	{
+		high = IIC_MIN_SCL_CLOCKS;
+		low = scl_clocks - high;
+	}
+
+	IIC_set_clock_div(inst, div - 1);
+	IIC_set_master_scl_time(inst, low - IIC_MIN_SCL_CLOCKS, high - IIC_MIN_SCL_CLOCKS);
+
+	iic_master[inst].active = 0;
+	iic_master[inst].head = NULL;
+	iic_master[inst].tail = NULL;
+	iic_master[inst].enabled = 1;
+
+	IIC_enable_master_mode(inst);
+
+	// La interrupcion de master pendiente se habilita unicamente mientras haya transacciones encoladas
+	IIC_enable_irq(inst, IIC_IRQ_MSTARBLOSS);
+	IIC_enable_irq(inst, IIC_IRQ_MSTSTSTPERR);
+
+	return hal_div_unsigned(clock, div * scl_clocks);
+}
+
+/**
+ * @brief Encolar una transaccion en modo master
+ * @param[in] inst Instancia en la cual encolar la transaccion
+ * @param[in] transaction Transaccion a encolar
+ * @return Resultado de la operacion
+ */
+hal_iic_result_en hal_iic_master_transaction_queue(hal_iic_sel_en inst, hal_iic_master_transaction_t *transaction)
+{
+	iic_master_t *master = &iic_master[inst];
+	uint8_t irq_enabled = NVIC_get_enabled_interrupt(IIC_NVICS[inst]);
+
+	// La cola se modifica desde la interrupcion, que se restaura a su estado previo
+	NVIC_disable_interrupt(IIC_NVICS[inst]);
+
+	if(transaction->result == HAL_IIC_RESULT_PENDING)
+	{
+		if(irq_enabled)
+		{
+			NVIC_enable_interrupt(IIC_NVICS[inst]);
+		}
+
+		return HAL_IIC_RESULT_BUSY;
+	}
+
+	transaction->result = HAL_IIC_RESULT_PENDING;
+	transaction->next = NULL;
+
+	if(master->head == NULL)
+	{
+		master->head = transaction;
+	}
+	else
+	{
+		master->tail->next = transaction;
+	}
+
+	master->tail = transaction;
+
+	// Si el master esta libre, la interrupcion se dispara inmediatamente y comienza la transaccion
+	IIC_enable_irq(inst, IIC_IRQ_MSTPENDING);
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(IIC_NVICS[inst]);
+	}
+
+	return HAL_IIC_RESULT_OK;
+}
+
+/**
+ * @brief Consultar si la cola de transacciones de una instancia esta vacia
+ * @param[in] inst Instancia a consultar
+ * @return Distinto de cero si no hay transacciones encoladas ni en curso
+ */
+uint8_t hal_iic_master_is_idle(hal_iic_sel_en inst)
+{
+	return iic_master[inst].head == NULL;
+}
+
+/**
+ * @brief Inicializar el modo slave de una instancia
+ * @param[in] inst Instancia a inicializar
+ * @param[in] config Configuracion deseada
+ */
+void hal_iic_slave_init(hal_iic_sel_en inst, const hal_iic_slave_config_t *config)
+{
+	iic_slave_t *slave = &iic_slave[inst];
+	uint8_t counter;
+
+	for(counter = 0; counter < 4; counter++)
+	{
+		if(config->address[counter] == HAL_IIC_SLAVE_ADDRESS_NOT_USED)
+		{
+			IIC_disable_slave_address(inst, counter);
+		}
+		else
+		{
+			IIC_set_slave_address(inst, counter, config->address[counter]);
+		}
+	}
+
+	IIC_set_slave_address_0_mask(inst, config->address_0_mask);
+
+	slave->selected = 0;
+	slave->rx_buffer = config->rx_buffer;
+	slave->rx_size = config->rx_size;
+	slave->rx_length = 0;
+	slave->tx_data = NULL;
+	slave->tx_length = 0;
+	slave->tx_index = 0;
+	slave->select_callback = config->select_callback;
+	slave->rx_callback = config->rx_callback;
+	slave->enabled = 1;
+
+	IIC_enable_slave_mode(inst);
+
+	IIC_enable_irq(inst, IIC_IRQ_SLVPENDING);
+	IIC_enable_irq(inst, IIC_IRQ_SLVDESEL);
+}
+
+/**
+ * @brief Configurar la respuesta a las lecturas del master en modo slave
+ * @param[in] inst Instancia a configurar
+ * @param[in] data Datos de la respuesta
+ * @param[in] length Cantidad de datos de la respuesta
+ */
+void hal_iic_slave_tx_set(hal_iic_sel_en inst, const uint8_t *data, uint32_t length)
+{
+	iic_slave_t *slave = &iic_slave[inst];
+	uint8_t irq_enabled = NVIC_get_enabled_interrupt(IIC_NVICS[inst]);
+
+	NVIC_disable_interrupt(IIC_NVICS[inst]);
+
+	slave->tx_data = data;
+	slave->tx_length = length;
+	slave->tx_index = 0;
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(IIC_NVICS[inst]);
+	}
+}
+
+/**
+ * @brief Comenzar la transaccion de la cabeza de la cola
+ *
+ * Una transaccion sin datos a escribir comienza directamente con la lectura.
+ *
+ * @param[in] inst Instancia a utilizar
+ */
+HAL_RAMFUNC static void iic_master_start(uint8_t inst)
+{
+	iic_master_t *master = &iic_master[inst];
+	const hal_iic_master_transaction_t *transaction = master->head;
+
+	master->active = 1;
+	master->index = 0;
+	master->reading = (transaction->tx_length == 0) && (transaction->rx_length != 0);
+
+	IIC_master_write_data(inst, (transaction->address << 1) | master->reading);
+	IIC_master_start(inst);
+}
+
+/**
+ * @brief Finalizar la transaccion en curso y quitarla de la cola
+ *
+ * La siguiente transaccion comienza cuando el master vuelve al estado libre.
+ *
+ * @param[in] inst Instancia a utilizar
+ * @param[in] result Resultado de la transaccion
+ */
+HAL_RAMFUNC static void iic_master_finish(uint8_t inst, hal_iic_result_en result)
+{
+	iic_master_t *master = &iic_master[inst];
+	hal_iic_master_transaction_t *transaction = master->head;
+
+	master->active = 0;
+	master->head = transaction->next;
+
+	if(master->head == NULL)
+	{
+		master->tail = NULL;
+	}
+
+	transaction->result = result;
+
+	if(transaction->callback != NULL)
+	{
+		transaction->callback(inst, transaction);
+	}
+}
+
+/**
+ * @brief Manejador de interrupcion del modo master
+ * @param[in] inst Instancia que genero la interrupcion
+ * @param[in] stat Registro de status leido al comienzo de la interrupcion
+ */
+HAL_RAMFUNC static void iic_master_irq_handler(uint8_t inst, const IIC_STAT_reg_t *stat)
+{
+	iic_master_t *master = &iic_master[inst];
+	hal_iic_master_transaction_t *transaction = master->head;
+
+	// En ambos errores el periferico vuelve al estado libre por si mismo
+	if(stat->MSTARBLOSS)
+	{
+		IIC_clear_status_flag(inst, IIC_STATUS_FLAG_MSTARBLOSS);
+
+		if(master->active)
+		{
+			iic_master_finish(inst, HAL_IIC_RESULT_ARBITRATION_LOST);
+		}
+
+		return;
+	}
+
+	if(stat->MSTSTSTPERR)
+	{
+		IIC_clear_status_flag(inst, IIC_STATUS_FLAG_MSTSTSTPERR);
+
+		if(master->active)
+		{
+			iic_master_finish(inst, HAL_IIC_RESULT_BUS_ERROR);
+		}
+
+		return;
+	}
+
+	if(!stat->MSTPENDING)
+	{
+		return;
+	}
+
+	switch(stat->MSTSTATE)
+	{
+	case IIC_MASTER_STATE_IDLE:
+	{
+		if(transaction != NULL)
+		{
+			iic_master_start(inst);
+		}
+		else
+		{
+			IIC_disable_irq(inst, IIC_IRQ_MSTPENDING);
+		}
+
+		break;
+	}
+
+	case IIC_MASTER_STATE_TX_READY:
+	{
+		if(!master->reading && (master->index < transaction->tx_length))
+		{
+			IIC_master_write_data(inst, transaction->tx_data[master->index++]);
+			IIC_master_continue(inst);
+		}
+		else if(!master->reading && (transaction->rx_length != 0))
+		{
+			// Start repetido para la fase de lectura
+			master->reading = 1;
+			master->index = 0;
+
+			IIC_master_write_data(inst, (transaction->address << 1) | 1);
+			IIC_master_start(inst);
+		}
+		else
+		{
+			IIC_master_stop(inst);
+			iic_master_finish(inst, HAL_IIC_RESULT_OK);
+		}
+
+		break;
+	}
+
+	case IIC_MASTER_STATE_RX_READY:
+	{
+		transaction->rx_data[master->index++] = IIC_master_read_data(inst);
+
+		if(master->index < transaction->rx_length)
+		{
+			IIC_master_continue(inst);
+		}
+		else
+		{
+			// La condicion de stop no reconoce el ultimo dato
+			IIC_master_stop(inst);
+			iic_master_finish(inst, HAL_IIC_RESULT_OK);
+		}
+
+		break;
+	}
+
+	case IIC_MASTER_STATE_NACK_ADDRESS:
+	{
+		IIC_master_stop(inst);
+		iic_master_finish(inst, HAL_IIC_RESULT_NACK_ADDRESS);
+
+		break;
+	}
+
+	case IIC_MASTER_STATE_NACK_DATA:
+	{
+		IIC_master_stop(inst);
+		iic_master_finish(inst, HAL_IIC_RESULT_NACK_DATA);
+
+		break;
+	}
+
+	default: break;
+	}
+}
+
+/**
+ * @brief Finalizar un tramo de escritura del master en modo slave
+ * @param[in] inst Instancia a utilizar
+ */
+HAL_RAMFUNC static void iic_slave_deselect(uint8_t inst)
+{
+	iic_slave_t *slave = &iic_slave[inst];
+
+	if(slave->selected && (slave->rx_length != 0) && (slave->rx_callback != NULL))
+	{
+		slave->rx_callback(inst, slave->address_index, slave->rx_buffer, slave->rx_length);
+	}
+
+	slave->selected = 0;
+	slave->rx_length = 0;
+}
+
+/**
+ * @brief Manejador de interrupcion del modo slave
+ * @param[in] inst Instancia que genero la interrupcion
+ * @param[in] stat Registro de status leido al comienzo de la interrupcion
+ */
+HAL_RAMFUNC static void iic_slave_irq_handler(uint8_t inst, const IIC_STAT_reg_t *stat)
+{
+	iic_slave_t *slave = &iic_slave[inst];
+
+	// Se procesa antes que un nuevo direccionamiento, que puede estar pendiente al mismo tiempo
+	if(stat->SLVDESEL)
+	{
+		IIC_clear_status_flag(inst, IIC_STATUS_FLAG_SLVDESEL);
+		iic_slave_deselect(inst);
+	}
+
+	if(!stat->SLVPENDING)
+	{
+		return;
+	}
+
+	switch(stat->SLVSTATE)
+	{
+	case IIC_SLAVE_STATE_ADDRESS:
+	{
+		hal_iic_slave_direction_en direction = IIC_slave_read_data(inst) & 1;
+
+		// Un start repetido finaliza el tramo anterior sin deseleccionar al slave
+		iic_slave_deselect(inst);
+
+		slave->selected = 1;
+		slave->address_index = stat->SLVIDX;
+		slave->tx_index = 0;
+
+		if(slave->select_callback != NULL)
+		{
+			slave->select_callback(inst, slave->address_index, direction);
+		}
+
+		IIC_slave_continue(inst);
+
+		break;
+	}
+
+	case IIC_SLAVE_STATE_RX:
+	{
+		uint8_t data = IIC_slave_read_data(inst);
+
+		if(slave->rx_length < slave->rx_size)
+		{
+			slave->rx_buffer[slave->rx_length++] = data;
+			IIC_slave_continue(inst);
+		}
+		else
+		{
+			IIC_slave_nack(inst);
+		}
+
+		break;
+	}
+
+	case IIC_SLAVE_STATE_TX:
+	{
+		if((slave->tx_data != NULL) && (slave->tx_index < slave->tx_length))
+		{
+			IIC_slave_write_data(inst, slave->tx_data[slave->tx_index++]);
+		}
+		else
+		{
+			IIC_slave_write_data(inst, IIC_SLAVE_TX_FILL);
+		}
+
+		IIC_slave_continue(inst);
+
+		break;
+	}
+
+	default: break;
+	}
+}
+
+/**
+ * @brief Manejador de interrupcion comun a todas las instancias
+ * @param[in] inst Instancia que genero la interrupcion
+ */
+HAL_RAMFUNC static void iic_irq_handler(uint8_t inst)
+{
+	IIC_STAT_reg_t stat = IIC_get_status(inst);
+
+	if(iic_master[inst].enabled)
+	{
+		iic_master_irq_handler(inst, &stat);
+	}
+
+	if(iic_slave[inst].enabled)
+	{
+		iic_slave_irq_handler(inst, &stat);
+	}
+}
+
+/**
+ * @brief Manejador de interrupcion de IIC0
+ */
+HAL_RAMFUNC void I2C0_IRQHandler(void)
+{
+	iic_irq_handler(0);
+}
+
+/**
+ * @brief Manejador de interrupcion de IIC1
+ */
+HAL_RAMFUNC void I2C1_IRQHandler(void)
+{
+	iic_irq_handler(1);
+}
+
+/**
+ * @brief Manejador de interrupcion de IIC2
+ */
+HAL_RAMFUNC void I2C2_IRQHandler(void)
+{
+	iic_irq_handler(2);
+}
+
+/**
+ * @brief Manejador de interrupcion de IIC3
+ */
+HAL_RAMFUNC void I2C3_IRQHandler(void)
+{
+	iic_irq_handler(3);
+}
@@ -0,0 +1,185 @@
+/**
+ * @file HAL_MRT.c
+ * @brief Funciones a nivel de aplicacion del periferico MRT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_MRT.h>
+#include <HAL_NVIC.h>
+#include <HAL_RAMFUNC.h>
+#include <HPL_MRT.h>
+#include <HPL_SYSCON.h>
+#include <HPL_NVIC.h>
+
+/** Mascara de los flags de interrupcion de todos los canales */
+#define		MRT_IRQ_FLAGS_MASK			((1 << HAL_MRT_CHANNEL_AMOUNT) - 1)
+
+static void hal_mrt_irq(void);
+
+static hal_mrt_callback_t mrt_callbacks[HAL_MRT_CHANNEL_AMOUNT] = { NULL }; //!< Callback de cada canal, NULL si esta libre
+
+static hal_nvic_handler_t mrt_previous_handler = NULL; //!< Rutina de interrupcion instalada antes que la propia
+
+static uint8_t mrt_handler_installed = 0; //!< Flag de rutina de interrupcion propia instalada
+
+/**
+ * @brief Reservar y configurar un canal del MRT
+ * @param[in] channel Canal a reservar
+ * @param[in] mode Modo de funcionamiento del canal
+ * @param[in] callback Callback de interrupcion del canal
+ * @return Resultado de la operacion
+ */
+hal_mrt_result_en hal_mrt_channel_claim(uint8_t channel, hal_mrt_mode_en mode, hal_mrt_callback_t callback)
+{
+	uint32_t primask;
+
+	if((channel >= HAL_MRT_CHANNEL_AMOUNT) || (callback == NULL))
+	{
+		return HAL_MRT_RESULT_INVALID;
+	}
+
+	// La reserva puede competir con otra hecha desde una interrupcion
+	primask = NVIC_global_disable();
+
+	if(mrt_callbacks[channel] != NULL)
+	{
+		NVIC_global_restore(primask);
+		return HAL_MRT_RESULT_CHANNEL_BUSY;
+	}
+
+	mrt_callbacks[channel] = callback;
+
+	if(!mrt_handler_installed)
+	{
+		mrt_previous_handler = hal_nvic_install_handler(HAL_NVIC_IRQ_SEL_MRT, hal_mrt_irq);
+		mrt_handler_installed = 1;
+	}
+
+	NVIC_global_restore(primask);
+
+	// Liberar el reset no afecta a los canales ya en uso
+	SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_MRT);
+	SYSCON_clear_reset(SYSCON_RESET_SEL_MRT);
+
+	MRT_disable_irq(channel);
+	MRT_set_interval_and_stop_timer(channel, 0);
+	MRT_config_mode(channel, (MRT_mode_en) mode);
+	MRT_clear_irq_flag(channel);
+	MRT_enable_irq(channel);
+
+	NVIC_enable_interrupt(NVIC_IRQ_SEL_MRT);
+
+	return HAL_MRT_RESULT_OK;
+}
+
+/**
+ * @brief Liberar un canal del MRT
+ * @param[in] channel Canal a liberar
+ */
+void hal_mrt_channel_release(uint8_t channel)
+{
+	if((channel >= HAL_MRT_CHANNEL_AMOUNT) || (mrt_callbacks[channel] == NULL))
+	{
+		return;
+	}
+
+	MRT_disable_irq(channel);
+	MRT_set_interval_and_stop_timer(channel, 0);
+	MRT_clear_irq_flag(channel);
+
+	mrt_callbacks[channel] = NULL;
+}
+
+/**
+ * @brief Comenzar el conteo de un canal
+ * @param[in] channel Canal a utilizar
+ * @param[in] interval Intervalo en ciclos del clock del sistema
+ * @return Resultado de la operacion
+ */
+hal_mrt_result_en hal_mrt_channel_start(uint8_t channel, uint32_t interval)
+{
+	if((channel >= HAL_MRT_CHANNEL_AMOUNT) || (interval > HAL_MRT_MAX_INTERVAL))
+	{
+		return HAL_MRT_RESULT_INVALID;
+	}
+
+	MRT_set_interval_and_stop_timer(channel, interval);
+
+	return HAL_MRT_RESULT_OK;
+}
+
+/**
+ * @brief Detener el conteo de un canal
+ * @param[in] channel Canal a detener
+ */
+void hal_mrt_channel_stop(uint8_t channel)
+{
+	if(channel >= HAL_MRT_CHANNEL_AMOUNT)
+	{
+		return;
+	}
+
+	MRT_set_interval_and_stop_timer(channel, 0);
+}
+
+/**
+ * @brief Obtener la cuenta actual de un canal
+ * @param[in] channel Canal a consultar
+ * @return Cuenta actual
+ */
+uint32_t hal_mrt_channel_get_value(uint8_t channel)
+{
+	if(channel >= HAL_MRT_CHANNEL_AMOUNT)
+	{
+		return 0;
+	}
+
+	return MRT_get_current_value(channel);
+}
+
+/**
+ * @brief Rutina de interrupcion del MRT
+ *
+ * Atiende unicamente los canales reservados, y deriva los flags de los demas canales a la rutina instalada
+ * previamente.
+ */
+HAL_RAMFUNC static void hal_mrt_irq(void)
+{
+	uint32_t flags = MRT_get_irq_flags() & MRT_IRQ_FLAGS_MASK;
+	uint8_t channel;
+
+	for(channel = 0; channel < HAL_MRT_CHANNEL_AMOUNT; channel++)
+	{
+		hal_mrt_callback_t callback = mrt_callbacks[channel];
+
+		if(!(flags & (1 << channel)))
+		{
+			continue;
+		}
+
+		if(callback == NULL)
+		{
+			// Los canales ajenos sin interrupcion habilitada no piden la interrupcion, y su flag no se toca
+			if(!MRT_get_irq_enabled(channel))
+			{
+				flags &= ~(1 << channel);
+			}
+
+			continue;
+		}
+
+		flags &= ~(1 << channel);
+
+		MRT_clear_irq_flag(channel);
+
+		callback(channel);
+	}
+
+	if((flags != 0) && (mrt_previous_handler != NULL))
+	{
+		mrt_previous_handler();
+	}
+}
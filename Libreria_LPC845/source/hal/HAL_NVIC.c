@@ -0,0 +1,492 @@
+/**
+ * @file HAL_NVIC.c
+ * @brief Funciones a nivel de aplicacion del controlador de interrupciones NVIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_NVIC.h>
+#include <HAL_MRT.h>
+#include <HPL_SCB.h>
+#include <HPL_NVIC.h>
+#include <HPL_SYSTICK.h>
+#include <HPL_SYSCON.h>
+#include <HPL_MRT.h>
+
+/** Cantidad de excepciones del núcleo al comienzo de la tabla de vectores */
+#define		NVIC_CORE_EXCEPTIONS		(16)
+
+/** Cantidad de entradas de la tabla de vectores */
+#define		NVIC_VECTOR_TABLE_ENTRIES	(NVIC_CORE_EXCEPTIONS + 32)
+
+/** Tabla de vectores en RAM. El registro *VTOR* requiere alineación a la potencia de 2 mayor al tamaño de la tabla */
+static uint32_t ram_vector_table[NVIC_VECTOR_TABLE_ENTRIES] __attribute__ ((aligned(256)));
+
+/** Cantidad de niveles de prioridad */
+#define		NVIC_PRIORITY_LEVELS		(4)
+
+/** Valor de fuente de interrupción para lugares de medición de latencia libres */
+#define		NVIC_LATENCY_SLOT_FREE		(-128)
+
+/** Canal del *MRT* utilizado por la medición periódica de latencia */
+#define		NVIC_LATENCY_PROBE_CHANNEL	(MRT_CHANNEL_3)
+
+/** Para cada nivel de prioridad, fuentes de interrupción con prioridad igual o menos urgente */
+static uint32_t priority_level_masks[NVIC_PRIORITY_LEVELS];
+
+/** Flag de máscaras por nivel de prioridad calculadas */
+static volatile uint8_t priority_level_masks_valid = 0;
+
+/** Mediciones de latencia de una fuente de interrupción */
+typedef struct
+{
+	int8_t irq; /**< Fuente de interrupción asignada al lugar */
+	hal_nvic_latency_stats_t stats; /**< Estadísticas acumuladas */
+}nvic_latency_slot_t;
+
+static nvic_latency_slot_t latency_slots[HAL_NVIC_LATENCY_SLOTS] = {
+	{ .irq = NVIC_LATENCY_SLOT_FREE },
+	{ .irq = NVIC_LATENCY_SLOT_FREE },
+	{ .irq = NVIC_LATENCY_SLOT_FREE },
+	{ .irq = NVIC_LATENCY_SLOT_FREE }
+};
+
+/** Período de la medición periódica de latencia */
+static uint32_t latency_probe_interval;
+
+/** Flag de medición periódica de latencia en curso */
+static uint8_t latency_probe_running = 0;
+
+static inline void hal_nvic_barrier(void);
+
+static void hal_nvic_update_priority_masks(void);
+
+static nvic_latency_slot_t *hal_nvic_latency_find_slot(hal_nvic_irq_sel_en irq);
+
+static void hal_nvic_latency_reset_stats(hal_nvic_latency_stats_t *stats);
+
+static void hal_nvic_latency_probe_irq(uint8_t channel);
+
+/**
+ * @brief Copiar la tabla de vectores a RAM y reubicarla mediante el registro *VTOR*
+ *
+ * Si la tabla ya fue reubicada, la función no tiene efecto.
+ */
+void hal_nvic_vector_table_relocate(void)
+{
+	const uint32_t *current_table = (const uint32_t *) SCB_get_vector_table();
+	uint8_t counter;
+
+	if(current_table == ram_vector_table)
+	{
+		return;
+	}
+
+	for(counter = 0; counter < NVIC_VECTOR_TABLE_ENTRIES; counter++)
+	{
+		ram_vector_table[counter] = current_table[counter];
+	}
+
+	// Ambas tablas son identicas, por lo que el cambio puede hacerse con las interrupciones habilitadas
+	SCB_set_vector_table((uint32_t) ram_vector_table);
+}
+
+/**
+ * @brief Instalar una rutina de interrupción directamente en la tabla de vectores
+ *
+ * Si la tabla de vectores todavía no fue reubicada a RAM, se reubica en este momento.
+ *
+ * @param[in] irq Fuente de interrupción o excepción
+ * @param[in] handler Rutina de interrupción a instalar
+ * @return Rutina de interrupción anteriormente instalada
+ */
+hal_nvic_handler_t hal_nvic_install_handler(hal_nvic_irq_sel_en irq, hal_nvic_handler_t handler)
+{
+	hal_nvic_handler_t previous;
+
+	hal_nvic_vector_table_relocate();
+
+	previous = (hal_nvic_handler_t) ram_vector_table[NVIC_CORE_EXCEPTIONS + irq];
+
+	// La escritura de una palabra es atomica, no hace falta inhibir la interrupcion
+	ram_vector_table[NVIC_CORE_EXCEPTIONS + irq] = (uint32_t) handler;
+
+	return previous;
+}
+
+/**
+ * @brief Fijar la prioridad de una fuente de interrupción o excepción
+ * @param[in] irq Fuente de interrupción o excepción (no admite @ref HAL_NVIC_IRQ_SEL_HARDFAULT)
+ * @param[in] priority Prioridad deseada
+ */
+void hal_nvic_set_priority(hal_nvic_irq_sel_en irq, hal_nvic_priority_en priority)
+{
+	switch(irq)
+	{
+	case HAL_NVIC_IRQ_SEL_HARDFAULT: { break; }
+	case HAL_NVIC_IRQ_SEL_SVCALL: { SCB_set_svcall_priority(priority); break; }
+	case HAL_NVIC_IRQ_SEL_PENDSV: { SCB_set_pendsv_priority(priority); break; }
+	case HAL_NVIC_IRQ_SEL_SYSTICK: { SCB_set_systick_priority(priority); break; }
+	default: { NVIC_set_irq_priority((NVIC_irq_sel_en) irq, (NVIC_irq_priority_en) priority); break; }
+	}
+
+	priority_level_masks_valid = 0;
+}
+
+/**
+ * @brief Obtener la prioridad de una fuente de interrupción o excepción
+ * @param[in] irq Fuente de interrupción o excepción
+ * @return Prioridad actual
+ */
+hal_nvic_priority_en hal_nvic_get_priority(hal_nvic_irq_sel_en irq)
+{
+	switch(irq)
+	{
+	case HAL_NVIC_IRQ_SEL_HARDFAULT: { return HAL_NVIC_PRIORITY_HIGHEST; }
+	case HAL_NVIC_IRQ_SEL_SVCALL: { return (hal_nvic_priority_en) SCB_get_svcall_priority(); }
+	case HAL_NVIC_IRQ_SEL_PENDSV: { return (hal_nvic_priority_en) SCB_get_pendsv_priority(); }
+	case HAL_NVIC_IRQ_SEL_SYSTICK: { return (hal_nvic_priority_en) SCB_get_systick_priority(); }
+	default: { return (hal_nvic_priority_en) NVIC_get_irq_priority((NVIC_irq_sel_en) irq); }
+	}
+}
+
+/**
+ * @brief Aplicar una tabla de prioridades
+ * @param[in] map Tabla de pares fuente/prioridad
+ * @param[in] entries Cantidad de entradas de la tabla
+ */
+void hal_nvic_priority_map_apply(const hal_nvic_priority_map_t *map, uint8_t entries)
+{
+	uint8_t counter;
+
+	for(counter = 0; counter < entries; counter++)
+	{
+		hal_nvic_set_priority(map[counter].irq, map[counter].priority);
+	}
+}
+
+/**
+ * @brief Comenzar una sección crítica
+ *
+ * Se inhabilitan las fuentes de interrupción habilitadas cuya prioridad sea igual o menos urgente que la indicada,
+ * incluyendo la del @ref SYSTICK. Las de prioridad más urgente continúan atendiéndose.
+ *
+ * @param[in] priority Prioridad más urgente a enmascarar
+ * @return Estado a pasar a @ref hal_nvic_critical_exit
+ */
+hal_nvic_critical_t hal_nvic_critical_enter(hal_nvic_priority_en priority)
+{
+	hal_nvic_critical_t state;
+
+	if(!priority_level_masks_valid)
+	{
+		hal_nvic_update_priority_masks();
+	}
+
+	state.irq_mask = NVIC_get_enabled_mask() & priority_level_masks[priority];
+	NVIC_disable_mask(state.irq_mask);
+
+	if((SCB_get_systick_priority() >= priority) && SYSTICK_get_interrupt_enable())
+	{
+		SYSTICK_disable_interrupt();
+		state.systick = 1;
+	}
+	else
+	{
+		state.systick = 0;
+	}
+
+	// Se asegura que ninguna de las interrupciones inhabilitadas sea tomada luego de este punto
+	hal_nvic_barrier();
+
+	return state;
+}
+
+/**
+ * @brief Terminar una sección crítica
+ * @param[in] state Estado devuelto por @ref hal_nvic_critical_enter
+ */
+void hal_nvic_critical_exit(hal_nvic_critical_t state)
+{
+	if(state.systick)
+	{
+		SYSTICK_enable_interrupt();
+	}
+
+	NVIC_enable_mask(state.irq_mask);
+}
+
+/**
+ * @brief Fijar la latencia mínima de interrupciones del MCU
+ * @param[in] cycles Cantidad mínima de ciclos entre el pedido de interrupción y la entrada a la rutina
+ */
+void hal_nvic_irq_latency_set(uint8_t cycles)
+{
+	SYSCON_set_irq_latency(cycles);
+}
+
+/**
+ * @brief Obtener la latencia mínima de interrupciones del MCU
+ * @return Cantidad mínima de ciclos entre el pedido de interrupción y la entrada a la rutina
+ */
+uint8_t hal_nvic_irq_latency_get(void)
+{
+	return SYSCON_get_irq_latency();
+}
+
+/**
+ * @brief Registrar una medición de latencia de una fuente de interrupción
+ *
+ * Pensada para ser llamada al comienzo de la rutina o callback de la interrupción medida.
+ *
+ * @param[in] irq Fuente de interrupción medida
+ * @param[in] cycles Latencia medida en ciclos de clock
+ * @return Resultado de la operación
+ */
+hal_nvic_latency_result_en hal_nvic_latency_record(hal_nvic_irq_sel_en irq, uint32_t cycles)
+{
+	nvic_latency_slot_t *slot = hal_nvic_latency_find_slot(irq);
+	hal_nvic_latency_stats_t *stats;
+	uint32_t bin_limit = HAL_NVIC_LATENCY_HISTOGRAM_FIRST_BIN;
+	uint8_t bin = 0;
+
+	if(slot == NULL)
+	{
+		return HAL_NVIC_LATENCY_RESULT_NO_SLOT;
+	}
+
+	stats = &slot->stats;
+
+	if(cycles > 0xFFFF)
+	{
+		cycles = 0xFFFF;
+	}
+
+	if(cycles < stats->min)
+	{
+		stats->min = cycles;
+	}
+
+	if(cycles > stats->max)
+	{
+		stats->max = cycles;
+	}
+
+	while((cycles >= bin_limit) && (bin < (HAL_NVIC_LATENCY_HISTOGRAM_BINS - 1)))
+	{
+		bin_limit <<= 1;
+		bin++;
+	}
+
+	stats->histogram[bin]++;
+	stats->samples++;
+
+	return HAL_NVIC_LATENCY_RESULT_OK;
+}
+
+/**
+ * @brief Obtener las estadísticas de latencia de una fuente de interrupción
+ * @param[in] irq Fuente de interrupción
+ * @param[out] stats Estadísticas de latencia
+ * @param[in] reset Si es distinto de cero, se reinician las estadísticas de la fuente
+ * @return Resultado de la operación
+ */
+hal_nvic_latency_result_en hal_nvic_latency_get(hal_nvic_irq_sel_en irq, hal_nvic_latency_stats_t *stats, uint8_t reset)
+{
+	hal_nvic_critical_t critical;
+	uint8_t counter;
+
+	for(counter = 0; counter < HAL_NVIC_LATENCY_SLOTS; counter++)
+	{
+		if(latency_slots[counter].irq == irq)
+		{
+			break;
+		}
+	}
+
+	if(counter == HAL_NVIC_LATENCY_SLOTS)
+	{
+		return HAL_NVIC_LATENCY_RESULT_NO_SAMPLES;
+	}
+
+	// La copia se hace con todas las fuentes enmascaradas, para que sea consistente
+	critical = hal_nvic_critical_enter(HAL_NVIC_PRIORITY_HIGHEST);
+
+	*stats = latency_slots[counter].stats;
+
+	if(reset)
+	{
+		hal_nvic_latency_reset_stats(&latency_slots[counter].stats);
+	}
+
+	hal_nvic_critical_exit(critical);
+
+	if(stats->samples == 0)
+	{
+		return HAL_NVIC_LATENCY_RESULT_NO_SAMPLES;
+	}
+
+	return HAL_NVIC_LATENCY_RESULT_OK;
+}
+
+/**
+ * @brief Comenzar la medición periódica de latencia mediante el *MRT*
+ *
+ * El canal 3 del *MRT* se reserva mediante @ref hal_mrt_channel_claim y genera una interrupción cada
+ * *interval_cycles* ciclos del clock del sistema, cuya latencia se registra bajo la fuente @ref HAL_NVIC_IRQ_SEL_MRT.
+ * Los demás canales del *MRT* siguen siendo atendidos por sus respectivos callbacks.
+ *
+ * @param[in] interval_cycles Período de las interrupciones generadas, en ciclos del clock del sistema (1 a
+ * @ref HAL_MRT_MAX_INTERVAL)
+ * @param[in] priority Prioridad con la cual medir
+ * @return Resultado de la operación
+ * @see hal_nvic_latency_probe_stop
+ */
+hal_nvic_latency_result_en hal_nvic_latency_probe_start(uint32_t interval_cycles, hal_nvic_priority_en priority)
+{
+	if((interval_cycles == 0) || (interval_cycles > HAL_MRT_MAX_INTERVAL))
+	{
+		return HAL_NVIC_LATENCY_RESULT_INVALID_INTERVAL;
+	}
+
+	hal_nvic_latency_probe_stop();
+
+	if(hal_mrt_channel_claim(NVIC_LATENCY_PROBE_CHANNEL, HAL_MRT_MODE_REPEAT, hal_nvic_latency_probe_irq) != HAL_MRT_RESULT_OK)
+	{
+		return HAL_NVIC_LATENCY_RESULT_BUSY;
+	}
+
+	latency_probe_interval = interval_cycles;
+	latency_probe_running = 1;
+
+	hal_nvic_set_priority(HAL_NVIC_IRQ_SEL_MRT, priority);
+
+	hal_mrt_channel_start(NVIC_LATENCY_PROBE_CHANNEL, latency_probe_interval);
+
+	return HAL_NVIC_LATENCY_RESULT_OK;
+}
+
+/**
+ * @brief Detener la medición periódica de latencia
+ *
+ * Se libera el canal 3 del *MRT*.
+ */
+void hal_nvic_latency_probe_stop(void)
+{
+	if(!latency_probe_running)
+	{
+		return;
+	}
+
+	hal_mrt_channel_release(NVIC_LATENCY_PROBE_CHANNEL);
+	latency_probe_running = 0;
+}
+
+/**
+ * @brief Barrera de sincronización de datos e instrucciones
+ */
+static inline void hal_nvic_barrier(void)
+{
+	__asm volatile ("dsb\n\tisb" : : : "memory");
+}
+
+/**
+ * @brief Calcular, para cada nivel de prioridad, las fuentes de interrupción a enmascarar
+ */
+static void hal_nvic_update_priority_masks(void)
+{
+	uint32_t masks[NVIC_PRIORITY_LEVELS] = { 0, 0, 0, 0 };
+	uint8_t irq;
+	uint8_t level;
+
+	for(irq = 0; irq < 32; irq++)
+	{
+		uint8_t priority = NVIC_get_irq_priority((NVIC_irq_sel_en) irq);
+
+		for(level = 0; level <= priority; level++)
+		{
+			masks[level] |= (1UL << irq);
+		}
+	}
+
+	for(level = 0; level < NVIC_PRIORITY_LEVELS; level++)
+	{
+		priority_level_masks[level] = masks[level];
+	}
+
+	priority_level_masks_valid = 1;
+}
+
+/**
+ * @brief Buscar el lugar de medición de latencia de una fuente, asignando uno libre si no tiene
+ * @param[in] irq Fuente de interrupción
+ * @return Lugar asignado, o NULL si no quedan lugares libres
+ */
+static nvic_latency_slot_t *hal_nvic_latency_find_slot(hal_nvic_irq_sel_en irq)
+{
+	nvic_latency_slot_t *slot = NULL;
+	hal_nvic_critical_t critical;
+	uint8_t counter;
+
+	for(counter = 0; counter < HAL_NVIC_LATENCY_SLOTS; counter++)
+	{
+		if(latency_slots[counter].irq == irq)
+		{
+			return &latency_slots[counter];
+		}
+	}
+
+	// La asignacion puede ocurrir desde interrupciones de distinta prioridad
+	critical = hal_nvic_critical_enter(HAL_NVIC_PRIORITY_HIGHEST);
+
+	for(counter = 0; counter < HAL_NVIC_LATENCY_SLOTS; counter++)
+	{
+		if(latency_slots[counter].irq == NVIC_LATENCY_SLOT_FREE)
+		{
+			slot = &latency_slots[counter];
+			hal_nvic_latency_reset_stats(&slot->stats);
+			slot->irq = irq;
+			break;
+		}
+	}
+
+	hal_nvic_critical_exit(critical);
+
+	return slot;
+}
+
+/**
+ * @brief Reiniciar las estadísticas de latencia
+ * @param[out] stats Estadísticas a reiniciar
+ */
+static void hal_nvic_latency_reset_stats(hal_nvic_latency_stats_t *stats)
+{
+	uint8_t counter;
+
+	stats->samples = 0;
+	stats->min = 0xFFFF;
+	stats->max = 0;
+
+	for(counter = 0; counter < HAL_NVIC_LATENCY_HISTOGRAM_BINS; counter++)
+	{
+		stats->histogram[counter] = 0;
+	}
+}
+
+/**
+ * @brief Callback del canal del *MRT* para la medición periódica de latencia
+ *
+ * El canal cuenta en forma descendente y se recarga al llegar a cero, momento en el cual pide la interrupción. Los
+ * ciclos transcurridos desde la recarga son la latencia de la interrupción, incluyendo el despacho de la rutina de
+ * interrupción del @ref MRT.
+ *
+ * @param[in] channel Canal que pidió la interrupción
+ */
+static void hal_nvic_latency_probe_irq(uint8_t channel)
+{
+	uint32_t elapsed = latency_probe_interval - MRT_get_current_value(channel);
+
+	hal_nvic_latency_record(HAL_NVIC_IRQ_SEL_MRT, elapsed);
+}
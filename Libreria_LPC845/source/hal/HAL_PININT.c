@@ -8,6 +8,7 @@
 
 #include <stddef.h>
 #include <HAL_PININT.h>
+#include <HAL_RAMFUNC.h>
 #include <HAL_USART.h>
 #include <HPL_PININT.h>
 #include <HPL_SYSCON.h>
@@ -27,6 +28,11 @@ extern void UART3_irq(void);
  */
 extern void UART4_irq(void);
 
+/**
+ * @brief Interrupcion de DAC1
+ */
+extern void DAC1_irq(void);
+
 static void dummy_irq_callback(void);
 
 static void (*pinint_callbacks[PININT_CHANNEL_AMOUNT])(void) = { //!< Callbacks para las 8 interrupciones disponibles
@@ -74,9 +80,8 @@ void hal_pinint_deinit(void)
 	NVIC_disable_interrupt(NVIC_IRQ_SEL_PININT2);
 	NVIC_disable_interrupt(NVIC_IRQ_SEL_PININT3);
 	NVIC_disable_interrupt(NVIC_IRQ_SEL_PININT4);
-	NVIC_disable_interrupt(NVIC_IRQ_SEL_PININT5_DAC1);
 
-	// Para el canal 6 y 7 no deshabilito interrupciones, dado que pueden ser usadas por UART3 y 4
+	// Para el canal 5, 6 y 7 no deshabilito interrupciones, dado que pueden ser usadas por DAC1, UART3 y 4
 
 	SYSCON_disable_clock(SYSCON_ENABLE_CLOCK_SEL_GPIO_INT);
 }
@@ -239,17 +244,22 @@ void PININT4_IRQHandler(void)
 }
 
 /**
- * @brief Interrupción para PININT5
+ * @brief Interrupción para PININT5 y DAC1
  */
 void PININT5_IRQHandler(void)
 {
-	hal_pinint_handle_irq(5);
+	if(PININT->IST.PSTAT & (1 << 5))
+	{
+		hal_pinint_handle_irq(5);
+	}
+
+	DAC1_irq();
 }
 
 /**
  * @brief Interrupción para PININT6 y USART3
  */
-void PININT6_IRQHandler(void)
+HAL_RAMFUNC void PININT6_IRQHandler(void)
 {
 	if(PININT->IST.PSTAT & (1 << 6))
 	{
@@ -262,7 +272,7 @@ void PININT6_IRQHandler(void)
 /**
  * @brief Interrupción para PININT7 y USART4
  */
-void PININT7_IRQHandler(void)
+HAL_RAMFUNC void PININT7_IRQHandler(void)
 {
 	if(PININT->IST.PSTAT & (1 << 7))
 	{
@@ -0,0 +1,123 @@
+/**
+ * @file HAL_RAMFUNC.c
+ * @brief Funciones a nivel de aplicacion para medir la ejecucion desde RAM (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HAL_RAMFUNC.h>
+
+/** Cantidad de elementos del buffer circular de la rutina de medicion (potencia de dos) */
+#define		RAMFUNC_BENCHMARK_BUFFER_SIZE		16
+
+/** Estado de la rutina de medicion */
+typedef struct
+{
+	uint32_t buffer[RAMFUNC_BENCHMARK_BUFFER_SIZE]; /**< Buffer circular */
+	uint32_t head; /**< Indice de escritura */
+	uint32_t count; /**< Datos recibidos */
+	uint32_t errors; /**< Datos con error */
+}ramfunc_benchmark_state_t;
+
+extern const uint8_t __hal_ramfunc_start[] __attribute__ ((weak)); //!< Comienzo de las secciones .ramfunc (linker)
+extern const uint8_t __hal_ramfunc_end[] __attribute__ ((weak)); //!< Fin de las secciones .ramfunc (linker)
+
+static void ramfunc_benchmark_flash(uint32_t data) __attribute__ ((noinline));
+static void ramfunc_benchmark_ram(uint32_t data) __attribute__ ((noinline, section(HAL_RAMFUNC_SECTION)));
+
+static volatile uint32_t ramfunc_benchmark_register; //!< Registro simulado de la rutina de medicion
+
+static ramfunc_benchmark_state_t ramfunc_benchmark_state; //!< Estado de la rutina de medicion
+
+/**
+ * @brief Obtener el tamaño de las funciones ubicadas en RAM
+ * @return Bytes entre los simbolos del linker, o cero si no estan definidos
+ */
+uint32_t hal_ramfunc_footprint(void)
+{
+	if((__hal_ramfunc_start == 0) || (__hal_ramfunc_end == 0))
+	{
+		return 0;
+	}
+
+	return (uint32_t) (__hal_ramfunc_end - __hal_ramfunc_start);
+}
+
+/**
+ * @brief Medir la misma rutina ejecutada desde flash y desde RAM
+ * @param[in] timestamp Lectura de un contador por hardware
+ * @param[out] result Tiempos medidos y tamaño de las funciones en RAM
+ */
+void hal_ramfunc_benchmark(hal_ramfunc_timestamp_callback timestamp, hal_ramfunc_benchmark_t *result)
+{
+	uint32_t counter;
+	uint32_t start;
+
+	// Una primera pasada de cada rutina, para que la medicion no dependa del estado del buffer de la flash
+	ramfunc_benchmark_flash(0);
+	ramfunc_benchmark_ram(0);
+
+	start = timestamp();
+	for(counter = 0; counter < HAL_RAMFUNC_BENCHMARK_ITERATIONS; counter++)
+	{
+		ramfunc_benchmark_flash(counter);
+	}
+	result->flash = timestamp() - start;
+
+	start = timestamp();
+	for(counter = 0; counter < HAL_RAMFUNC_BENCHMARK_ITERATIONS; counter++)
+	{
+		ramfunc_benchmark_ram(counter);
+	}
+	result->ram = timestamp() - start;
+
+	result->footprint = hal_ramfunc_footprint();
+}
+
+/**
+ * @brief Cuerpo de la rutina de medicion, comun a ambas copias
+ *
+ * Representa una rutina de interrupcion de recepcion: lee un registro, guarda el dato en un buffer circular y
+ * actualiza los contadores.
+ *
+ * @param[in] data Dato a escribir en el registro simulado
+ */
+static inline __attribute__ ((always_inline)) void ramfunc_benchmark_body(uint32_t data)
+{
+	ramfunc_benchmark_state_t *state = &ramfunc_benchmark_state;
+	uint32_t received;
+
+	ramfunc_benchmark_register = data;
+	received = ramfunc_benchmark_register;
+
+	if(received & (1 << 15))
+	{
+		state->errors++;
+	}
+	else
+	{
+		state->buffer[state->head] = received;
+		state->head = (state->head + 1) & (RAMFUNC_BENCHMARK_BUFFER_SIZE - 1);
+	}
+
+	state->count++;
+}
+
+/**
+ * @brief Rutina de medicion ubicada en flash
+ * @param[in] data Dato a procesar
+ */
+static void ramfunc_benchmark_flash(uint32_t data)
+{
+	ramfunc_benchmark_body(data);
+}
+
+/**
+ * @brief Rutina de medicion ubicada en RAM
+ * @param[in] data Dato a procesar
+ */
+static void ramfunc_benchmark_ram(uint32_t data)
+{
+	ramfunc_benchmark_body(data);
+}
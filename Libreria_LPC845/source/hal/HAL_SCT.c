@@ -0,0 +1,647 @@
+/**
+ * @file HAL_SCT.c
+ * @brief Funciones a nivel de aplicacion del periferico SCT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_SCT.h>
+#include <HAL_SYSCON.h>
+#include <HAL_DIV.h>
+#include <HAL_RAMFUNC.h>
+#include <HPL_SCT.h>
+#include <HPL_INPUTMUX.h>
+#include <HPL_SWM.h>
+#include <HPL_SYSCON.h>
+#include <HPL_NVIC.h>
+
+/** Valor de evento o registro de match no utilizado */
+#define		SCT_NOT_USED					0xFF
+
+/** Evento (y registro de match) que delimita el periodo del PWM */
+#define		SCT_PWM_PERIOD_EVENT			0
+
+/** Maximo duty en decimas de porciento */
+#define		SCT_PWM_DUTY_MAX				1000
+
+/** Maximo tiempo muerto en nanosegundos */
+#define		SCT_PWM_DEAD_TIME_MAX_NS		100000
+
+/** Estado del modo PWM */
+typedef struct
+{
+	hal_sct_pwm_align_en align; /**< Alineacion */
+	uint32_t period; /**< Cuentas por periodo (alineado al flanco) o por semiperiodo (centrado) */
+	uint8_t event_amount; /**< Cantidad de eventos utilizados, incluyendo el del periodo */
+	uint8_t event[HAL_SCT_OUTPUT_AMOUNT]; /**< Evento y registro de match de cada salida */
+	uint8_t active_low[HAL_SCT_OUTPUT_AMOUNT]; /**< Polaridad de cada salida */
+	uint8_t pair_low[HAL_SCT_OUTPUT_AMOUNT]; /**< Salida del lado bajo, para las salidas del lado alto de un par */
+	uint32_t dead_time[HAL_SCT_OUTPUT_AMOUNT]; /**< Tiempo muerto en cuentas, para las salidas del lado alto de un par */
+}sct_pwm_t;
+
+static void sct_init(hal_sct_clock_source_en clock_source, uint16_t prescaler);
+
+static hal_sct_result_en sct_pwm_output_setup(uint8_t output, hal_gpio_portpin_en portpin, uint8_t active_low);
+
+static uint32_t sct_pwm_duty_to_ticks(uint32_t duty);
+
+static void sct_pwm_output_apply(uint8_t output, uint32_t ticks);
+
+static const SCT_combmode_en sct_combmodes[] = { //!< Modo de combinacion de cada condicion de evento
+		SCT_COMBMODE_MATCH,
+		SCT_COMBMODE_IO,
+		SCT_COMBMODE_OR,
+		SCT_COMBMODE_AND
+};
+
+static sct_pwm_t sct_pwm; //!< Estado del modo PWM
+
+static uint8_t sct_machine_match[HAL_SCT_EVENT_AMOUNT]; //!< Registro de match de cada evento de la maquina de estados
+
+static uint32_t sct_counter_freq = 0; //!< Frecuencia del contador
+
+static uint32_t sct_irq_events = 0; //!< Eventos que generan interrupcion
+
+static hal_sct_callback_t sct_callback = NULL; //!< Callback de eventos
+
+/**
+ * @brief Asignar una salida del SCT a un pin
+ * @param[in] output Salida
+ * @param[in] portpin Puerto/pin a asignar
+ */
+void hal_sct_output_pin_assign(uint8_t output, hal_gpio_portpin_en portpin)
+{
+	SWM_init();
+	SWM_assign_sct_OUT(output, HAL_GPIO_PORTPIN_TO_PORT(portpin), HAL_GPIO_PORTPIN_TO_PIN(portpin));
+	SWM_deinit();
+}
+
+/**
+ * @brief Asignar una entrada del SCT a un pin
+ * @param[in] input Entrada
+ * @param[in] portpin Puerto/pin a asignar
+ */
+void hal_sct_input_pin_assign(uint8_t input, hal_gpio_portpin_en portpin)
+{
+	SWM_init();
+	SWM_assign_sct_IN(input, HAL_GPIO_PORTPIN_TO_PORT(portpin), HAL_GPIO_PORTPIN_TO_PIN(portpin));
+	SWM_deinit();
+
+	INPUTMUX_set_sct_input(input, (INPUTMUX_sct_input_sel_en) (INPUTMUX_SCT_INPUT_SEL_SCT_PIN0 + input));
+}
+
+/**
+ * @brief Inicializar el modo PWM
+ * @param[in] config Configuracion deseada
+ * @return Resultado de la operacion
+ */
+hal_sct_result_en hal_sct_pwm_init(const hal_sct_pwm_config_t *config)
+{
+	SCT_EV_CTRL_reg_t ctrl = { 0 };
+	if(config->frequency == 0)
+	{
+		return HAL_SCT_RESULT_PARAM_ERROR;
+	}
+
+	sct_init(config->clock_source, 1);
+
+	// En modo centrado el contador recorre el limite dos veces por periodo
+	if(config->align == HAL_SCT_PWM_ALIGN_CENTER)
+	{
+		sct_pwm.period = hal_div_unsigned(sct_counter_freq, 2 * config->frequency);
+	}
+	else
+	{
+		sct_pwm.period = hal_div_unsigned(sct_counter_freq, config->frequency);
+	}
+
+	if(sct_pwm.period < 2)
+	{
+		return HAL_SCT_RESULT_PARAM_ERROR;
+	}
+
+	sct_pwm.align = config->align;
+	sct_pwm.event_amount = SCT_PWM_PERIOD_EVENT + 1;
+
+	if(config->align == HAL_SCT_PWM_ALIGN_CENTER)
+	{
+		SCT_set_bidirectional(1);
+		SCT_set_match(SCT_PWM_PERIOD_EVENT, sct_pwm.period);
+		SCT_set_match_reload(SCT_PWM_PERIOD_EVENT, sct_pwm.period);
+	}
+	else
+	{
+		SCT_set_match(SCT_PWM_PERIOD_EVENT, sct_pwm.period - 1);
+		SCT_set_match_reload(SCT_PWM_PERIOD_EVENT, sct_pwm.period - 1);
+	}
+
+	ctrl.MATCHSEL = SCT_PWM_PERIOD_EVENT;
+	ctrl.COMBMODE = SCT_COMBMODE_MATCH;
+
+	SCT_set_event_states(SCT_PWM_PERIOD_EVENT, 1 << 0);
+	SCT_set_event_control(SCT_PWM_PERIOD_EVENT, ctrl);
+	SCT_set_limit_events(1 << SCT_PWM_PERIOD_EVENT);
+
+	return HAL_SCT_RESULT_OK;
+}
+
+/**
+ * @brief Configurar un canal de PWM
+ * @param[in] config Configuracion del canal
+ * @return Resultado de la operacion
+ */
+hal_sct_result_en hal_sct_pwm_channel_config(const hal_sct_pwm_channel_config_t *config)
+{
+	hal_sct_result_en result;
+
+	result = sct_pwm_output_setup(config->output, config->portpin, config->active_low);
+
+	if(result != HAL_SCT_RESULT_OK)
+	{
+		return result;
+	}
+
+	hal_sct_pwm_duty_set(config->output, config->duty);
+
+	return HAL_SCT_RESULT_OK;
+}
+
+/**
+ * @brief Configurar un par complementario de PWM con tiempo muerto
+ * @param[in] config Configuracion del par
+ * @return Resultado de la operacion
+ */
+hal_sct_result_en hal_sct_pwm_pair_config(const hal_sct_pwm_pair_config_t *config)
+{
+	hal_sct_result_en result;
+
+	if((sct_pwm.align != HAL_SCT_PWM_ALIGN_CENTER) || (config->output_high == config->output_low) ||
+			(config->dead_time_ns > SCT_PWM_DEAD_TIME_MAX_NS))
+	{
+		return HAL_SCT_RESULT_PARAM_ERROR;
+	}
+
+	if((sct_pwm.event_amount + 2) > HAL_SCT_EVENT_AMOUNT)
+	{
+		return HAL_SCT_RESULT_RESOURCE_ERROR;
+	}
+
+	result = sct_pwm_output_setup(config->output_high, config->portpin_high, 0);
+
+	if(result != HAL_SCT_RESULT_OK)
+	{
+		return result;
+	}
+
+	// El lado bajo es un canal de polaridad invertida: queda en estado bajo mientras el contador supera su match
+	result = sct_pwm_output_setup(config->output_low, config->portpin_low, 1);
+
+	if(result != HAL_SCT_RESULT_OK)
+	{
+		return result;
+	}
+
+	sct_pwm.pair_low[config->output_high] = config->output_low;
+	// El producto supera los 32 bits con el contador a mas de 43MHz, por lo que se calcula en 64 bits
+	sct_pwm.dead_time[config->output_high] = (uint32_t) hal_div_unsigned_64(((uint64_t) config->dead_time_ns *
+			sct_counter_freq) + 999999999, 1000000000);
+
+	hal_sct_pwm_duty_set(config->output_high, config->duty);
+
+	return HAL_SCT_RESULT_OK;
+}
+
+/**
+ * @brief Modificar el duty de un canal o par de PWM
+ * @param[in] output Salida del canal, o salida del lado alto del par
+ * @param[in] duty Duty en decimas de porciento
+ */
+void hal_sct_pwm_duty_set(uint8_t output, uint32_t duty)
+{
+	uint32_t ticks;
+	uint8_t low;
+
+	if((output >= HAL_SCT_OUTPUT_AMOUNT) || (sct_pwm.event[output] == SCT_NOT_USED))
+	{
+		return;
+	}
+
+	ticks = sct_pwm_duty_to_ticks(duty);
+
+	sct_pwm_output_apply(output, ticks);
+
+	low = sct_pwm.pair_low[output];
+
+	if(low != SCT_NOT_USED)
+	{
+		// El lado bajo se desactiva un tiempo muerto antes de que se active el lado alto, y viceversa
+		ticks += sct_pwm.dead_time[output];
+
+		if(ticks > sct_pwm.period)
+		{
+			ticks = sct_pwm.period;
+		}
+
+		sct_pwm_output_apply(low, ticks);
+	}
+}
+
+/**
+ * @brief Inicializar el modo maquina de estados
+ * @param[in] config Configuracion deseada
+ * @return Resultado de la operacion
+ */
+hal_sct_result_en hal_sct_machine_init(const hal_sct_machine_config_t *config)
+{
+	uint32_t match_values[HAL_SCT_EVENT_AMOUNT];
+	uint32_t set_events[HAL_SCT_OUTPUT_AMOUNT] = { 0 };
+	uint32_t clear_events[HAL_SCT_OUTPUT_AMOUNT] = { 0 };
+	uint32_t limit_events = 0;
+	uint32_t halt_events = 0;
+	uint8_t match_amount = 0;
+	uint8_t event;
+	uint8_t output;
+
+	if((config->event_amount > HAL_SCT_EVENT_AMOUNT) || (config->prescaler == 0) || (config->prescaler > 256) ||
+			(config->initial_state >= HAL_SCT_STATE_AMOUNT))
+	{
+		return HAL_SCT_RESULT_PARAM_ERROR;
+	}
+
+	sct_init(config->clock_source, config->prescaler);
+
+	for(event = 0; event < config->event_amount; event++)
+	{
+		const hal_sct_event_t *current = &config->events[event];
+		SCT_EV_CTRL_reg_t ctrl = { 0 };
+		uint8_t match;
+
+		sct_machine_match[event] = SCT_NOT_USED;
+
+		if(current->next_state != HAL_SCT_STATE_KEEP)
+		{
+			if(current->next_state >= HAL_SCT_STATE_AMOUNT)
+			{
+				return HAL_SCT_RESULT_PARAM_ERROR;
+			}
+
+			ctrl.STATELD = 1;
+			ctrl.STATEV = current->next_state;
+		}
+
+		if(current->condition != HAL_SCT_EVENT_CONDITION_INPUT)
+		{
+			// Los eventos con igual valor de match comparten el registro
+			for(match = 0; (match < match_amount) && (match_values[match] != current->match_value); match++);
+
+			if(match == match_amount)
+			{
+				match_values[match_amount++] = current->match_value;
+
+				SCT_set_match(match, current->match_value);
+				SCT_set_match_reload(match, current->match_value);
+			}
+
+			ctrl.MATCHSEL = match;
+			sct_machine_match[event] = match;
+		}
+
+		if(current->condition != HAL_SCT_EVENT_CONDITION_MATCH)
+		{
+			if(current->input >= HAL_SCT_INPUT_AMOUNT)
+			{
+				return HAL_SCT_RESULT_PARAM_ERROR;
+			}
+
+			ctrl.IOSEL = current->input;
+			ctrl.IOCOND = current->input_condition;
+		}
+
+		ctrl.COMBMODE = sct_combmodes[current->condition];
+
+		SCT_set_event_states(event, current->states);
+		SCT_set_event_control(event, ctrl);
+
+		for(output = 0; output < HAL_SCT_OUTPUT_AMOUNT; output++)
+		{
+			if(current->set_outputs & (1 << output))
+			{
+				set_events[output] |= (1 << event);
+			}
+
+			if(current->clear_outputs & (1 << output))
+			{
+				clear_events[output] |= (1 << event);
+			}
+		}
+
+		if(current->limit)
+		{
+			limit_events |= (1 << event);
+		}
+
+		if(current->halt)
+		{
+			halt_events |= (1 << event);
+		}
+
+		if(current->interrupt)
+		{
+			sct_irq_events |= (1 << event);
+		}
+	}
+
+	for(output = 0; output < HAL_SCT_OUTPUT_AMOUNT; output++)
+	{
+		SCT_set_output_set_events(output, set_events[output]);
+		SCT_set_output_clear_events(output, clear_events[output]);
+	}
+
+	SCT_set_limit_events(limit_events);
+	SCT_set_halt_events(halt_events);
+	SCT_set_state(config->initial_state);
+	SCT_set_outputs(config->initial_outputs);
+
+	sct_callback = config->callback;
+	SCT_set_event_irq(sct_irq_events);
+
+	if(sct_irq_events != 0)
+	{
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_SCT);
+	}
+
+	return HAL_SCT_RESULT_OK;
+}
+
+/**
+ * @brief Modificar el valor de match de un evento de la maquina de estados
+ * @param[in] event Indice del evento en la tabla de eventos
+ * @param[in] value Nuevo valor de match
+ */
+void hal_sct_machine_match_set(uint8_t event, uint32_t value)
+{
+	if((event < HAL_SCT_EVENT_AMOUNT) && (sct_machine_match[event] != SCT_NOT_USED))
+	{
+		SCT_set_match_reload(sct_machine_match[event], value);
+	}
+}
+
+/**
+ * @brief Obtener el estado actual de la maquina de estados
+ * @return Estado actual
+ */
+uint8_t hal_sct_state_get(void)
+{
+	return SCT_get_state();
+}
+
+/**
+ * @brief Obtener la frecuencia del contador
+ * @return Frecuencia del contador en Hz
+ */
+uint32_t hal_sct_counter_freq_get(void)
+{
+	return sct_counter_freq;
+}
+
+/**
+ * @brief Poner en marcha el contador
+ */
+void hal_sct_start(void)
+{
+	SCT_run();
+}
+
+/**
+ * @brief Detener el contador
+ */
+void hal_sct_stop(void)
+{
+	SCT_halt();
+}
+
+/**
+ * @brief Habilitar el periferico y llevarlo a su estado inicial, con el contador detenido
+ * @param[in] clock_source Fuente de clock
+ * @param[in] prescaler Division del clock del contador (1 a 256)
+ */
+static void sct_init(hal_sct_clock_source_en clock_source, uint16_t prescaler)
+{
+	uint32_t source_freq;
+	uint8_t counter;
+
+	SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_SCT);
+	SYSCON_assert_reset(SYSCON_RESET_SEL_SCT);
+	SYSCON_clear_reset(SYSCON_RESET_SEL_SCT);
+
+	SYSCON_set_sct_clock((SYSCON_sct_clock_sel_en) clock_source, 1);
+
+	if(clock_source == HAL_SCT_CLOCK_SOURCE_SYS_PLL)
+	{
+		source_freq = hal_syscon_pll_clock_get();
+	}
+	else
+	{
+		source_freq = hal_syscon_fro_clock_get();
+	}
+
+	sct_counter_freq = hal_div_unsigned(source_freq, prescaler);
+
+	// El reset del periferico deja el contador detenido y todos los eventos inhabilitados
+	SCT_config_unified_counter();
+	SCT_set_all_match_mode();
+	SCT_set_prescaler(prescaler - 1);
+	SCT_clear_counter();
+
+	for(counter = 0; counter < HAL_SCT_EVENT_AMOUNT; counter++)
+	{
+		sct_machine_match[counter] = SCT_NOT_USED;
+	}
+
+	for(counter = 0; counter < HAL_SCT_OUTPUT_AMOUNT; counter++)
+	{
+		sct_pwm.event[counter] = SCT_NOT_USED;
+		sct_pwm.pair_low[counter] = SCT_NOT_USED;
+	}
+
+	sct_pwm.event_amount = 0;
+	sct_irq_events = 0;
+	sct_callback = NULL;
+
+	NVIC_disable_interrupt(NVIC_IRQ_SEL_SCT);
+}
+
+/**
+ * @brief Asignar un evento y un registro de match a una salida de PWM
+ * @param[in] output Salida
+ * @param[in] portpin Puerto/pin de la salida
+ * @param[in] active_low Distinto de cero si la salida esta activa en estado bajo
+ * @return Resultado de la operacion
+ */
+static hal_sct_result_en sct_pwm_output_setup(uint8_t output, hal_gpio_portpin_en portpin, uint8_t active_low)
+{
+	SCT_EV_CTRL_reg_t ctrl = { 0 };
+	uint8_t event;
+
+	if((sct_pwm.event_amount == 0) || (output >= HAL_SCT_OUTPUT_AMOUNT) || (sct_pwm.event[output] != SCT_NOT_USED))
+	{
+		return HAL_SCT_RESULT_PARAM_ERROR;
+	}
+
+	if(sct_pwm.event_amount >= HAL_SCT_EVENT_AMOUNT)
+	{
+		return HAL_SCT_RESULT_RESOURCE_ERROR;
+	}
+
+	event = sct_pwm.event_amount++;
+
+	sct_pwm.event[output] = event;
+	sct_pwm.active_low[output] = (active_low != 0);
+
+	ctrl.MATCHSEL = event;
+	ctrl.COMBMODE = SCT_COMBMODE_MATCH;
+
+	SCT_set_event_states(event, 1 << 0);
+	SCT_set_event_control(event, ctrl);
+
+	if(sct_pwm.align == HAL_SCT_PWM_ALIGN_CENTER)
+	{
+		// Los eventos que activan la salida al contar hacia arriba la desactivan al contar hacia abajo
+		SCT_set_output_direction(output, SCT_OUTPUT_DIR_REVERSED);
+	}
+
+	// Salida en estado inactivo hasta el primer pulso
+	if(active_low)
+	{
+		SCT_set_outputs(SCT_get_outputs() | (1 << output));
+	}
+	else
+	{
+		SCT_set_outputs(SCT_get_outputs() & ~(1 << output));
+	}
+
+	hal_sct_output_pin_assign(output, portpin);
+
+	return HAL_SCT_RESULT_OK;
+}
+
+/**
+ * @brief Convertir un duty a cuentas activas por periodo (o semiperiodo)
+ * @param[in] duty Duty en decimas de porciento
+ * @return Cuentas activas
+ */
+static uint32_t sct_pwm_duty_to_ticks(uint32_t duty)
+{
+	hal_div_unsigned_result_t ticks_per_unit;
+
+	if(duty > SCT_PWM_DUTY_MAX)
+	{
+		duty = SCT_PWM_DUTY_MAX;
+	}
+
+	// Separando cociente y resto se evita el desborde del producto
+	ticks_per_unit = hal_div_unsigned_divmod(sct_pwm.period, SCT_PWM_DUTY_MAX);
+
+	return (duty * ticks_per_unit.quot) + hal_div_unsigned(duty * ticks_per_unit.rem, SCT_PWM_DUTY_MAX);
+}
+
+/**
+ * @brief Configurar una salida de PWM para una cantidad de cuentas activas
+ *
+ * Las salidas permanentemente inactivas (y las permanentemente activas en modo centrado) se resuelven mediante la
+ * resolucion de conflictos, activando y desactivando la salida con el mismo evento. En modo alineado al flanco, la
+ * salida permanentemente activa utiliza un match mayor al limite, que nunca se produce.
+ *
+ * @param[in] output Salida
+ * @param[in] ticks Cuentas activas por periodo (alineado al flanco) o por semiperiodo (centrado)
+ */
+static void sct_pwm_output_apply(uint8_t output, uint32_t ticks)
+{
+	uint8_t event = sct_pwm.event[output];
+	uint32_t event_mask = 1 << event;
+	SCT_conflict_res_en inactive = sct_pwm.active_low[output] ? SCT_CONFLICT_RES_SET : SCT_CONFLICT_RES_CLEAR;
+	SCT_conflict_res_en active = sct_pwm.active_low[output] ? SCT_CONFLICT_RES_CLEAR : SCT_CONFLICT_RES_SET;
+	uint32_t activate_events;
+	uint32_t deactivate_events;
+	uint32_t match_value;
+
+	if(sct_pwm.align == HAL_SCT_PWM_ALIGN_EDGE)
+	{
+		// El evento del periodo activa la salida, y el de la salida la desactiva
+		activate_events = 1 << SCT_PWM_PERIOD_EVENT;
+		deactivate_events = event_mask;
+
+		if(ticks == 0)
+		{
+			// Coincide con el evento del periodo, y el conflicto se resuelve desactivando
+			match_value = sct_pwm.period - 1;
+		}
+		else if(ticks >= sct_pwm.period)
+		{
+			// El contador se reinicia en (periodo - 1), por lo que este match nunca se produce
+			match_value = sct_pwm.period;
+		}
+		else
+		{
+			match_value = ticks - 1;
+		}
+
+		SCT_set_conflict_resolution(output, inactive);
+	}
+	else
+	{
+		// La salida esta activa mientras el contador supera el match
+		match_value = sct_pwm.period - ticks;
+
+		activate_events = event_mask;
+		deactivate_events = 0;
+
+		if((ticks == 0) || (ticks >= sct_pwm.period))
+		{
+			deactivate_events = event_mask;
+		}
+
+		SCT_set_conflict_resolution(output, (ticks == 0) ? inactive : active);
+	}
+
+	// El valor de recarga recien se copia al match al terminar el periodo en curso. Con el contador detenido se
+	// escribe tambien el match, para que el primer periodo ya utilice el valor nuevo
+	SCT_set_match_reload(event, match_value);
+
+	if(SCT_get_halted())
+	{
+		SCT_set_match(event, match_value);
+	}
+
+	if(sct_pwm.active_low[output])
+	{
+		SCT_set_output_set_events(output, deactivate_events);
+		SCT_set_output_clear_events(output, activate_events);
+	}
+	else
+	{
+		SCT_set_output_set_events(output, activate_events);
+		SCT_set_output_clear_events(output, deactivate_events);
+	}
+}
+
+/**
+ * @brief Interrupcion del SCT
+ */
+HAL_RAMFUNC void SCT_IRQHandler(void)
+{
+	uint32_t flags = SCT_get_event_flags() & sct_irq_events;
+	uint8_t event;
+
+	SCT_clear_event_flags(flags);
+
+	for(event = 0; flags != 0; event++, flags >>= 1)
+	{
+		if((flags & 1) && (sct_callback != NULL))
+		{
+			sct_callback(event);
+		}
+	}
+}
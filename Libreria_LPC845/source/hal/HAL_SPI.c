@@ -8,15 +8,59 @@
 
 #include <stddef.h>
 #include <HAL_SPI.h>
+#include <HAL_RAMFUNC.h>
 #include <HPL_SPI.h>
 #include <HPL_SWM.h>
 #include <HPL_SYSCON.h>
 #include <HPL_NVIC.h>
 
+/** Estado del modo slave de una instancia */
+typedef struct
+{
+	uint8_t enabled; /**< Distinto de cero si la instancia esta en modo slave */
+	uint8_t in_transfer; /**< Distinto de cero mientras el slave select esta activo */
+	uint8_t ssel_count; /**< Cantidad de slave select configurados */
+	hal_spi_ssel_sel_en ssel; /**< Slave select de la transaccion en curso */
+	hal_gpio_portpin_en ssel_portpin[4]; /**< Puertos/pines de los slave select */
+	uint8_t *rx_buffer; /**< Buffer de recepcion */
+	uint32_t rx_size; /**< Tamaño del buffer de recepcion */
+	uint32_t rx_length; /**< Cantidad de datos recibidos en la transaccion en curso */
+	const uint8_t *tx_data; /**< Respuesta de la transaccion en curso o de la proxima. NULL si no hay */
+	uint32_t tx_length; /**< Cantidad de datos de la respuesta */
+	uint32_t tx_index; /**< Proximo dato de la respuesta a escribir en el periferico */
+	const uint8_t *tx_pending_data; /**< Respuesta en espera. NULL si no hay */
+	uint32_t tx_pending_length; /**< Cantidad de datos de la respuesta en espera */
+	hal_spi_slave_mode_select_callback select_callback; /**< Callback de activacion de slave select */
+	hal_spi_slave_mode_transfer_callback transfer_callback; /**< Callback de fin de transaccion */
+}spi_slave_t;
+
 static void dummy_irq(void);
 
+static void spi_assign_pins(hal_spi_sel_en inst, hal_gpio_portpin_en sck, hal_gpio_portpin_en miso, hal_gpio_portpin_en mosi, const hal_gpio_portpin_en *ssel);
+
+static void spi_power_up(hal_spi_sel_en inst, hal_syscon_peripheral_clock_sel_en clock_source);
+
+static void spi_set_clock_mode(hal_spi_sel_en inst, hal_spi_clock_mode_en clock_mode);
+
+static void spi_master_write_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint16_t *data, uint16_t value, uint32_t length, uint8_t end_of_transfer);
+
+static void spi_slave_preload(uint8_t inst);
+
+static hal_spi_ssel_sel_en spi_slave_rx_ssel(uint8_t inst, SPI_RXDAT_reg_t rxdat);
+
+static hal_spi_ssel_sel_en spi_slave_single_ssel(uint8_t inst);
+
+static void spi_slave_irq_handler(uint8_t inst);
+
 static void spi_irq_handler(uint8_t inst);
 
+static spi_slave_t spi_slave[2]; //!< Estado del modo slave de cada instancia
+
+static const NVIC_irq_sel_en SPI_NVICS[] = {
+	NVIC_IRQ_SEL_SPI0,
+	NVIC_IRQ_SEL_SPI1
+};
+
 static void (*spi_rx_callback[])(void) = //!< Callbacks registrados a la recepcion de un dato por SPI
 {
 	dummy_irq,
@@ -38,44 +82,7 @@ void hal_spi_master_mode_init(hal_spi_sel_en inst, const hal_spi_master_mode_con
 {
 	uint8_t counter;
 
-	SWM_init();
-
-	if(config->miso_portpin != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_MISO(inst, HAL_GPIO_PORTPIN_TO_PORT(config->miso_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->miso_portpin));
-	}
-
-	if(config->mosi_portpin != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_MOSI(inst, HAL_GPIO_PORTPIN_TO_PORT(config->mosi_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->mosi_portpin));
-	}
-
-	if(config->sck_portpin != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_SCK(inst, HAL_GPIO_PORTPIN_TO_PORT(config->sck_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->sck_portpin));
-	}
-
-	if(config->ssel_portpin[0] != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_SSEL0(inst, HAL_GPIO_PORTPIN_TO_PORT(config->ssel_portpin[0]), HAL_GPIO_PORTPIN_TO_PIN(config->ssel_portpin[0]));
-	}
-
-	if(config->ssel_portpin[1] != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_SSEL1(inst, HAL_GPIO_PORTPIN_TO_PORT(config->ssel_portpin[1]), HAL_GPIO_PORTPIN_TO_PIN(config->ssel_portpin[1]));
-	}
-
-	if(config->ssel_portpin[2] != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_SSEL2(inst, HAL_GPIO_PORTPIN_TO_PORT(config->ssel_portpin[2]), HAL_GPIO_PORTPIN_TO_PIN(config->ssel_portpin[2]));
-	}
-
-	if(config->ssel_portpin[3] != HAL_GPIO_PORTPIN_NOT_USED)
-	{
-		SWM_assign_spi_SSEL3(inst, HAL_GPIO_PORTPIN_TO_PORT(config->ssel_portpin[3]), HAL_GPIO_PORTPIN_TO_PIN(config->ssel_portpin[3]));
-	}
-
-	SWM_deinit();
+	spi_assign_pins(inst, config->sck_portpin, config->miso_portpin, config->mosi_portpin, config->ssel_portpin);
 
 	for(counter = 0; counter < 4; counter++)
 	{
@@ -89,34 +96,7 @@ void hal_spi_master_mode_init(hal_spi_sel_en inst, const hal_spi_master_mode_con
 		}
 	}
 
-	switch(inst)
-	{
-	case HAL_SPI_0:
-	{
-		SYSCON_set_peripheral_clock_source(SYSCON_PERIPHERAL_SEL_SPI0, config->clock_source);
-
-		SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_SPI0);
-
-		SYSCON_clear_reset(SYSCON_RESET_SEL_SPI0);
-
-		NVIC_enable_interrupt(NVIC_IRQ_SEL_SPI0);
-
-		break;
-	}
-
-	case HAL_SPI_1:
-	{
-		SYSCON_set_peripheral_clock_source(SYSCON_PERIPHERAL_SEL_SPI1, config->clock_source);
-
-		SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_SPI1);
-
-		SYSCON_clear_reset(SYSCON_RESET_SEL_SPI1);
-
-		NVIC_enable_interrupt(NVIC_IRQ_SEL_SPI1);
-
-		break;
-	}
-	}
+	spi_power_up(inst, config->clock_source);
 
 	SPI_enable(inst);
 
@@ -159,13 +139,7 @@ uint16_t hal_spi_master_mode_rx_data(hal_spi_sel_en inst)
  */
 void hal_spi_master_mode_tx_config(hal_spi_sel_en inst, const hal_spi_master_mode_tx_config_t *config)
 {
-	switch(config->clock_mode)
-	{
-	case HAL_SPI_CLOCK_MODE_0: { SPI_set_cpha_change(inst); SPI_set_cpol_low(inst); break; }
-	case HAL_SPI_CLOCK_MODE_1: { SPI_set_cpha_capture(inst); SPI_set_cpol_low(inst); break; }
-	case HAL_SPI_CLOCK_MODE_2: { SPI_set_cpha_change(inst); SPI_set_cpol_high(inst); break; }
-	case HAL_SPI_CLOCK_MODE_3: { SPI_set_cpha_capture(inst); SPI_set_cpol_high(inst); break; }
-	}
+	spi_set_clock_mode(inst, config->clock_mode);
 
 	SPI_set_clock_div(inst, config->clock_div);
 }
@@ -217,6 +191,203 @@ void hal_spi_master_mode_rx_register_callback(hal_spi_sel_en inst, void (*new_ca
 	}
 }
 
+/**
+ * @brief Transferir un bloque de datos de 8 bits por encuesta
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] tx Datos a transmitir. Si es NULL se transmite HAL_SPI_DUMMY_BYTE
+ * @param[out] rx Buffer donde guardar los datos recibidos. Puede ser NULL
+ * @param[in] length Cantidad de datos a transferir
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ */
+void hal_spi_master_mode_transfer(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint8_t *tx, uint8_t *rx, uint32_t length, uint8_t end_of_transfer)
+{
+	hal_spi_master_mode_tx_data_t word = { 0 };
+	uint32_t tx_count = 0;
+	uint32_t rx_count = 0;
+
+	word.ssel0_n = (ssel != HAL_SPI_SSEL_SELECTION_0);
+	word.ssel1_n = (ssel != HAL_SPI_SSEL_SELECTION_1);
+	word.ssel2_n = (ssel != HAL_SPI_SSEL_SELECTION_2);
+	word.ssel3_n = (ssel != HAL_SPI_SSEL_SELECTION_3);
+	word.rxignore = (rx == NULL);
+	word.data_length = HAL_SPI_DATA_LENGTH_8_BIT;
+
+	// Se escribe la palabra siguiente mientras se transmite la actual, para no dejar huecos entre palabras
+	while((tx_count < length) || ((rx != NULL) && (rx_count < length)))
+	{
+		if((tx_count < length) && SPI_get_status_flag(inst, SPI_STATUS_FLAG_TXRDY))
+		{
+			word.data = (tx != NULL) ? tx[tx_count] : HAL_SPI_DUMMY_BYTE;
+			word.eot = (end_of_transfer && (tx_count == (length - 1)));
+
+			SPI_set_data_and_control(inst, (SPI_TXDATCTL_reg_t *) &word);
+			tx_count++;
+		}
+
+		if((rx != NULL) && SPI_get_status_flag(inst, SPI_STATUS_FLAG_RXRDY))
+		{
+			rx[rx_count++] = SPI_read_rx_data(inst);
+		}
+	}
+
+	while(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_MSTIDLE));
+}
+
+/**
+ * @brief Desactivar el slave select de una transferencia que quedó abierta
+ * @param[in] inst Instancia a utilizar
+ */
+void hal_spi_master_mode_end_transfer(hal_spi_sel_en inst)
+{
+	while(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_MSTIDLE));
+
+	// Escribir un 1 en ENDTRANSFER desactiva los slave select al terminar la palabra en curso
+	SPI_clear_status_flag(inst, SPI_STATUS_FLAG_ENDTRANSFER);
+
+	while(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_MSTIDLE));
+}
+
+/**
+ * @brief Transmitir un bloque de datos de 16 bits por encuesta
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] data Datos a transmitir
+ * @param[in] length Cantidad de datos a transmitir
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ */
+void hal_spi_master_mode_write_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint16_t *data, uint32_t length, uint8_t end_of_transfer)
+{
+	spi_master_write_16(inst, ssel, data, 0, length, end_of_transfer);
+}
+
+/**
+ * @brief Transmitir un mismo dato de 16 bits repetidas veces por encuesta
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] value Dato a transmitir
+ * @param[in] count Cantidad de veces a transmitir el dato
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ */
+void hal_spi_master_mode_fill_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, uint16_t value, uint32_t count, uint8_t end_of_transfer)
+{
+	spi_master_write_16(inst, ssel, NULL, value, count, end_of_transfer);
+}
+
+/**
+ * @brief Inicializar SPI en modo slave
+ * @param[in] inst Instancia de SPI a inicializar
+ * @param[in] config Configuracion deseada
+ */
+hal_spi_slave_mode_init_result_en hal_spi_slave_mode_init(hal_spi_sel_en inst, const hal_spi_slave_mode_config_t *config)
+{
+	spi_slave_t *slave = &spi_slave[inst];
+	uint8_t counter;
+
+	// Los buffers de transmision y recepcion son de 8 bits
+	if(config->data_length > HAL_SPI_DATA_LENGTH_8_BIT)
+	{
+		return HAL_SPI_SLAVE_MODE_INIT_RESULT_INVALID_DATA_LENGTH;
+	}
+
+	spi_assign_pins(inst, config->sck_portpin, config->miso_portpin, config->mosi_portpin, config->ssel_portpin);
+
+	spi_power_up(inst, config->clock_source);
+
+	NVIC_disable_interrupt(SPI_NVICS[inst]);
+
+	slave->ssel_count = 0;
+
+	for(counter = 0; counter < 4; counter++)
+	{
+		if(config->ssel_polarity[counter] == HAL_SPI_SSEL_POLARITY_LOW)
+		{
+			SPI_set_ssel_active_low(inst, counter);
+		}
+		else
+		{
+			SPI_set_ssel_active_high(inst, counter);
+		}
+
+		slave->ssel_portpin[counter] = config->ssel_portpin[counter];
+
+		if(config->ssel_portpin[counter] != HAL_GPIO_PORTPIN_NOT_USED)
+		{
+			slave->ssel_count++;
+		}
+	}
+
+	SPI_set_slave_mode(inst);
+	spi_set_clock_mode(inst, config->clock_mode);
+	SPI_set_data_length(inst, (SPI_data_length_en) config->data_length);
+	SPI_clear_end_of_transmission(inst);
+	SPI_clear_rx_ignore(inst);
+
+	slave->in_transfer = 0;
+	slave->ssel = HAL_SPI_SSEL_SELECTION_OTHER;
+	slave->rx_buffer = config->rx_buffer;
+	slave->rx_size = (config->rx_buffer == NULL) ? 0 : config->rx_size;
+	slave->rx_length = 0;
+	slave->tx_data = NULL;
+	slave->tx_pending_data = NULL;
+	slave->select_callback = config->select_callback;
+	slave->transfer_callback = config->transfer_callback;
+	slave->enabled = 1;
+
+	SPI_clear_status_flag(inst, SPI_STATUS_FLAG_SSA);
+	SPI_clear_status_flag(inst, SPI_STATUS_FLAG_SSD);
+	SPI_enable_irq(inst, SPI_IRQ_SSA);
+	SPI_enable_irq(inst, SPI_IRQ_SSD);
+	SPI_enable_irq(inst, SPI_IRQ_RXRDY);
+
+	SPI_enable(inst);
+
+	NVIC_enable_interrupt(SPI_NVICS[inst]);
+
+	return HAL_SPI_SLAVE_MODE_INIT_RESULT_OK;
+}
+
+/**
+ * @brief Cargar la respuesta de una transacción en modo slave
+ * @param[in] inst Instancia a utilizar
+ * @param[in] data Datos a transmitir
+ * @param[in] length Cantidad de datos a transmitir
+ * @return Resultado de la carga
+ */
+hal_spi_slave_mode_tx_result_en hal_spi_slave_mode_tx_queue(hal_spi_sel_en inst, const uint8_t *data, uint32_t length)
+{
+	spi_slave_t *slave = &spi_slave[inst];
+	hal_spi_slave_mode_tx_result_en ret = HAL_SPI_SLAVE_MODE_TX_RESULT_OK;
+	uint8_t irq_enabled = NVIC_get_enabled_interrupt(SPI_NVICS[inst]);
+
+	NVIC_disable_interrupt(SPI_NVICS[inst]);
+
+	// Con el slave select recien activado la transaccion ya comenzo, aunque todavia no se haya atendido la interrupcion
+	if((slave->tx_data == NULL) && !slave->in_transfer && !SPI_get_status_flag(inst, SPI_STATUS_FLAG_SSA))
+	{
+		slave->tx_data = data;
+		slave->tx_length = length;
+		spi_slave_preload(inst);
+	}
+	else if(slave->tx_pending_data == NULL)
+	{
+		slave->tx_pending_data = data;
+		slave->tx_pending_length = length;
+	}
+	else
+	{
+		ret = HAL_SPI_SLAVE_MODE_TX_RESULT_BUSY;
+	}
+
+	// Se restaura el estado previo, ya que quien llama puede tener la interrupcion inhabilitada
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(SPI_NVICS[inst]);
+	}
+
+	return ret;
+}
+
 /*
  * @brief Funcion dummy para inicialiar punteros de interrupcion
  */
@@ -225,12 +396,293 @@ static void dummy_irq(void)
 	return;
 }
 
+/**
+ * @brief Asignar los pines de una instancia de SPI
+ * @param[in] inst Instancia a configurar
+ * @param[in] sck Puerto/pin de SCK
+ * @param[in] miso Puerto/pin de MISO
+ * @param[in] mosi Puerto/pin de MOSI
+ * @param[in] ssel Puertos/pines de los cuatro slave select
+ */
+static void spi_assign_pins(hal_spi_sel_en inst, hal_gpio_portpin_en sck, hal_gpio_portpin_en miso, hal_gpio_portpin_en mosi, const hal_gpio_portpin_en *ssel)
+{
+	SWM_init();
+
+	if(miso != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_MISO(inst, HAL_GPIO_PORTPIN_TO_PORT(miso), HAL_GPIO_PORTPIN_TO_PIN(miso));
+	}
+
+	if(mosi != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_MOSI(inst, HAL_GPIO_PORTPIN_TO_PORT(mosi), HAL_GPIO_PORTPIN_TO_PIN(mosi));
+	}
+
+	if(sck != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_SCK(inst, HAL_GPIO_PORTPIN_TO_PORT(sck), HAL_GPIO_PORTPIN_TO_PIN(sck));
+	}
+
+	if(ssel[0] != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_SSEL0(inst, HAL_GPIO_PORTPIN_TO_PORT(ssel[0]), HAL_GPIO_PORTPIN_TO_PIN(ssel[0]));
+	}
+
+	if(ssel[1] != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_SSEL1(inst, HAL_GPIO_PORTPIN_TO_PORT(ssel[1]), HAL_GPIO_PORTPIN_TO_PIN(ssel[1]));
+	}
+
+	if(ssel[2] != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_SSEL2(inst, HAL_GPIO_PORTPIN_TO_PORT(ssel[2]), HAL_GPIO_PORTPIN_TO_PIN(ssel[2]));
+	}
+
+	if(ssel[3] != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		SWM_assign_spi_SSEL3(inst, HAL_GPIO_PORTPIN_TO_PORT(ssel[3]), HAL_GPIO_PORTPIN_TO_PIN(ssel[3]));
+	}
+
+	SWM_deinit();
+}
+
+/**
+ * @brief Seleccionar la fuente de clock, habilitar el clock y liberar el reset de una instancia de SPI
+ * @param[in] inst Instancia a configurar
+ * @param[in] clock_source Fuente de clock
+ */
+static void spi_power_up(hal_spi_sel_en inst, hal_syscon_peripheral_clock_sel_en clock_source)
+{
+	switch(inst)
+	{
+	case HAL_SPI_0:
+	{
+		SYSCON_set_peripheral_clock_source(SYSCON_PERIPHERAL_SEL_SPI0, clock_source);
+
+		SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_SPI0);
+
+		SYSCON_clear_reset(SYSCON_RESET_SEL_SPI0);
+
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_SPI0);
+
+		break;
+	}
+
+	case HAL_SPI_1:
+	{
+		SYSCON_set_peripheral_clock_source(SYSCON_PERIPHERAL_SEL_SPI1, clock_source);
+
+		SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_SPI1);
+
+		SYSCON_clear_reset(SYSCON_RESET_SEL_SPI1);
+
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_SPI1);
+
+		break;
+	}
+	}
+}
+
+/**
+ * @brief Configurar el modo de clock (CPHA y CPOL)
+ * @param[in] inst Instancia a configurar
+ * @param[in] clock_mode Modo de clock
+ */
+static void spi_set_clock_mode(hal_spi_sel_en inst, hal_spi_clock_mode_en clock_mode)
+{
+	switch(clock_mode)
+	{
+	case HAL_SPI_CLOCK_MODE_0: { SPI_set_cpha_change(inst); SPI_set_cpol_low(inst); break; }
+	case HAL_SPI_CLOCK_MODE_1: { SPI_set_cpha_capture(inst); SPI_set_cpol_low(inst); break; }
+	case HAL_SPI_CLOCK_MODE_2: { SPI_set_cpha_change(inst); SPI_set_cpol_high(inst); break; }
+	case HAL_SPI_CLOCK_MODE_3: { SPI_set_cpha_capture(inst); SPI_set_cpol_high(inst); break; }
+	}
+}
+
+/**
+ * @brief Escribir la primera palabra de la respuesta en el periferico, antes de que comience la transaccion
+ * @param[in] inst Instancia a utilizar
+ * @pre El buffer de transmision del periferico debe estar vacio
+ */
+HAL_RAMFUNC static void spi_slave_preload(uint8_t inst)
+{
+	spi_slave_t *slave = &spi_slave[inst];
+
+	slave->tx_index = 0;
+
+	if((slave->tx_data != NULL) && (slave->tx_length != 0))
+	{
+		SPI_write_txdata(inst, slave->tx_data[slave->tx_index++]);
+	}
+}
+
+/**
+ * @brief Obtener el slave select activo a partir del estado guardado junto con un dato recibido
+ * @param[in] inst Instancia que recibio el dato
+ * @param[in] rxdat Dato recibido y estado de los slave select al recibirlo
+ * @return Slave select activo
+ */
+HAL_RAMFUNC static hal_spi_ssel_sel_en spi_slave_rx_ssel(uint8_t inst, SPI_RXDAT_reg_t rxdat)
+{
+	spi_slave_t *slave = &spi_slave[inst];
+	uint8_t active_n[4] = { rxdat.RXSSEL0_N, rxdat.RXSSEL1_N, rxdat.RXSSEL2_N, rxdat.RXSSEL3_N };
+	uint8_t counter;
+
+	for(counter = 0; counter < 4; counter++)
+	{
+		if((slave->ssel_portpin[counter] != HAL_GPIO_PORTPIN_NOT_USED) && (active_n[counter] == 0))
+		{
+			return (hal_spi_ssel_sel_en) counter;
+		}
+	}
+
+	return HAL_SPI_SSEL_SELECTION_OTHER;
+}
+
+/**
+ * @brief Obtener el unico slave select configurado
+ * @param[in] inst Instancia a consultar
+ * @return Slave select configurado
+ */
+HAL_RAMFUNC static hal_spi_ssel_sel_en spi_slave_single_ssel(uint8_t inst)
+{
+	spi_slave_t *slave = &spi_slave[inst];
+	uint8_t counter;
+
+	for(counter = 0; counter < 4; counter++)
+	{
+		if(slave->ssel_portpin[counter] != HAL_GPIO_PORTPIN_NOT_USED)
+		{
+			return (hal_spi_ssel_sel_en) counter;
+		}
+	}
+
+	return HAL_SPI_SSEL_SELECTION_OTHER;
+}
+
+/**
+ * @brief Manejador de interrupciones de SPI en modo slave
+ * @param[in] inst Instancia que genero la interrupcion
+ */
+HAL_RAMFUNC static void spi_slave_irq_handler(uint8_t inst)
+{
+	spi_slave_t *slave = &spi_slave[inst];
+
+	if(SPI_get_status_flag(inst, SPI_STATUS_FLAG_SSA) && !slave->in_transfer)
+	{
+		SPI_clear_status_flag(inst, SPI_STATUS_FLAG_SSA);
+
+		slave->in_transfer = 1;
+		slave->rx_length = 0;
+
+		SPI_enable_irq(inst, SPI_IRQ_TXRDY);
+
+		// Con varios slave select, el activo se conoce recien con el primer dato recibido, ya que los pines pueden
+		// haber cambiado al atender la interrupcion
+		if(slave->ssel_count == 1)
+		{
+			slave->ssel = spi_slave_single_ssel(inst);
+
+			if(slave->select_callback != NULL)
+			{
+				slave->select_callback(inst, slave->ssel);
+			}
+		}
+		else
+		{
+			slave->ssel = HAL_SPI_SSEL_SELECTION_OTHER;
+		}
+	}
+
+	// Con SCK alto y palabras consecutivas, se atienden todas sin salir de la interrupcion
+	for(;;)
+	{
+		SPI_STAT_reg_t stat = SPI_get_status(inst);
+
+		if(!stat.RXRDY && !(stat.TXRDY && slave->in_transfer))
+		{
+			break;
+		}
+
+		if(stat.RXRDY)
+		{
+			// El dato y el estado de los slave select se leen juntos, ya que la lectura retira el dato
+			SPI_RXDAT_reg_t rxdat = SPI_read_rx_data_and_status(inst);
+
+			if((slave->ssel == HAL_SPI_SSEL_SELECTION_OTHER) && slave->in_transfer)
+			{
+				slave->ssel = spi_slave_rx_ssel(inst, rxdat);
+
+				if(slave->select_callback != NULL)
+				{
+					slave->select_callback(inst, slave->ssel);
+				}
+			}
+
+			if(slave->rx_length < slave->rx_size)
+			{
+				slave->rx_buffer[slave->rx_length++] = (uint8_t) rxdat.RXDAT;
+			}
+		}
+
+		if(stat.TXRDY && slave->in_transfer)
+		{
+			if((slave->tx_data != NULL) && (slave->tx_index < slave->tx_length))
+			{
+				SPI_write_txdata(inst, slave->tx_data[slave->tx_index++]);
+			}
+			else
+			{
+				SPI_write_txdata(inst, HAL_SPI_DUMMY_BYTE);
+			}
+		}
+	}
+
+	if(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_SSD))
+	{
+		return;
+	}
+
+	SPI_clear_status_flag(inst, SPI_STATUS_FLAG_SSD);
+
+	if(slave->in_transfer)
+	{
+		SPI_disable_irq(inst, SPI_IRQ_TXRDY);
+
+		slave->in_transfer = 0;
+
+		if(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_TXRDY))
+		{
+			// Se descarta la palabra escrita por adelantado que no llego a transmitirse
+			SPI_disable(inst);
+			SPI_enable(inst);
+		}
+
+		// La respuesta en espera pasa a ser la de la proxima transaccion
+		slave->tx_data = slave->tx_pending_data;
+		slave->tx_length = slave->tx_pending_length;
+		slave->tx_pending_data = NULL;
+		spi_slave_preload(inst);
+
+		if(slave->transfer_callback != NULL)
+		{
+			slave->transfer_callback(inst, slave->ssel, slave->rx_buffer, slave->rx_length);
+		}
+	}
+}
+
 /**
  * @brief Manejador generico de interrupciones de SPI
  * @param[in] inst Instancia que genero la interrupcion
  */
-static void spi_irq_handler(uint8_t inst)
+HAL_RAMFUNC static void spi_irq_handler(uint8_t inst)
 {
+	if(spi_slave[inst].enabled)
+	{
+		spi_slave_irq_handler(inst);
+		return;
+	}
+
 	if(SPI_get_irq_flag_status(inst, SPI_IRQ_RXRDY) && SPI_get_status_flag(inst, SPI_STATUS_FLAG_RXRDY))
 	{
 		spi_rx_callback[inst]();
@@ -252,7 +704,7 @@ static void spi_irq_handler(uint8_t inst)
 /**
  * @brief Manejador de interrupcion de SPI0
  */
-void SPI0_IRQHandler(void)
+HAL_RAMFUNC void SPI0_IRQHandler(void)
 {
 	spi_irq_handler(0);
 }
@@ -260,7 +712,58 @@ void SPI0_IRQHandler(void)
 /**
  * @brief Manejador de interrupcion de SPI1
  */
-void SPI1_IRQHandler(void)
+HAL_RAMFUNC void SPI1_IRQHandler(void)
 {
 	spi_irq_handler(1);
 }
+
+/**
+ * @brief Transmitir datos de 16 bits por encuesta, sin leer los datos recibidos
+ *
+ * La primera palabra se escribe en TXDATCTL, lo cual actualiza tambien TXCTL. Las siguientes se escriben unicamente
+ * en TXDAT, de modo que cada palabra es una escritura de 16 bits sin armar el control.
+ *
+ * @param[in] inst Instancia a utilizar
+ * @param[in] ssel Slave select a activar
+ * @param[in] data Datos a transmitir. Si es NULL se transmite value
+ * @param[in] value Dato a transmitir si data es NULL
+ * @param[in] length Cantidad de datos a transmitir
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ */
+static void spi_master_write_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint16_t *data, uint16_t value, uint32_t length, uint8_t end_of_transfer)
+{
+	hal_spi_master_mode_tx_data_t word = { 0 };
+	uint32_t counter;
+
+	if(length == 0)
+	{
+		return;
+	}
+
+	word.data = (data != NULL) ? data[0] : value;
+	word.ssel0_n = (ssel != HAL_SPI_SSEL_SELECTION_0);
+	word.ssel1_n = (ssel != HAL_SPI_SSEL_SELECTION_1);
+	word.ssel2_n = (ssel != HAL_SPI_SSEL_SELECTION_2);
+	word.ssel3_n = (ssel != HAL_SPI_SSEL_SELECTION_3);
+	word.eot = (end_of_transfer && (length == 1));
+	word.rxignore = 1;
+	word.data_length = HAL_SPI_DATA_LENGTH_16_BIT;
+
+	while(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_TXRDY));
+
+	SPI_set_data_and_control(inst, (SPI_TXDATCTL_reg_t *) &word);
+
+	for(counter = 1; counter < length; counter++)
+	{
+		while(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_TXRDY));
+
+		if(end_of_transfer && (counter == (length - 1)))
+		{
+			SPI_set_end_of_transmission(inst);
+		}
+
+		SPI_write_txdata(inst, (data != NULL) ? data[counter] : value);
+	}
+
+	while(!SPI_get_status_flag(inst, SPI_STATUS_FLAG_MSTIDLE));
+}
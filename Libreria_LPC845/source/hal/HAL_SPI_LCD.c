@@ -0,0 +1,348 @@
+/**
+ * @file HAL_SPI_LCD.c
+ * @brief Funciones a nivel de aplicacion del controlador de displays SPI (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_SPI.h>
+#include <HAL_GPIO.h>
+#include <HAL_SPI_LCD.h>
+
+/** Comando de configuracion del rango de columnas */
+#define		HAL_SPI_LCD_CMD_CASET				0x2A
+
+/** Comando de configuracion del rango de filas */
+#define		HAL_SPI_LCD_CMD_RASET				0x2B
+
+/** Comando de escritura de memoria */
+#define		HAL_SPI_LCD_CMD_RAMWR				0x2C
+
+/** Valor de ventana que no coincide con ningun rango valido */
+#define		HAL_SPI_LCD_WINDOW_INVALID			0xFFFFFFFF
+
+#if (HAL_SPI_LCD_TILE_SIZE & (HAL_SPI_LCD_TILE_SIZE - 1)) != 0
+#error "HAL_SPI_LCD_TILE_SIZE debe ser una potencia de 2"
+#endif
+
+static uint8_t hal_spi_lcd_clip(const hal_spi_lcd_t *lcd, uint16_t *x, uint16_t *y, uint16_t *width, uint16_t *height);
+static void hal_spi_lcd_send_command(hal_spi_lcd_t *lcd, uint8_t command);
+static void hal_spi_lcd_send_range(hal_spi_lcd_t *lcd, uint8_t command, uint32_t *last, uint16_t start, uint16_t end);
+static void hal_spi_lcd_window(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+static void hal_spi_lcd_render(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+hal_spi_lcd_result_en hal_spi_lcd_init(hal_spi_lcd_t *lcd, const hal_spi_lcd_config_t *config)
+{
+	uint32_t row;
+
+	// Con el buffer de linea vacio el redibujado no avanzaria
+	if((config->width > HAL_SPI_LCD_MAX_WIDTH) || (config->height > HAL_SPI_LCD_MAX_HEIGHT) ||
+		(config->line_buffer == NULL) || (config->line_buffer_length == 0))
+	{
+		return HAL_SPI_LCD_RESULT_INVALID_CONFIG;
+	}
+
+	lcd->config = *config;
+	lcd->column_window = HAL_SPI_LCD_WINDOW_INVALID;
+	lcd->row_window = HAL_SPI_LCD_WINDOW_INVALID;
+	lcd->bytes_sent = 0;
+
+	for(row = 0; row < HAL_SPI_LCD_TILE_ROWS; row++)
+	{
+		lcd->dirty[row] = 0;
+	}
+
+	hal_gpio_init(HAL_GPIO_PORTPIN_TO_PORT(config->dc_portpin));
+	hal_gpio_set_dir(config->dc_portpin, HAL_GPIO_DIR_OUTPUT, 1);
+
+	hal_spi_lcd_invalidate_all(lcd);
+
+	return HAL_SPI_LCD_RESULT_OK;
+}
+
+void hal_spi_lcd_command(hal_spi_lcd_t *lcd, uint8_t command, const uint8_t *params, uint32_t length)
+{
+	hal_spi_lcd_send_command(lcd, command);
+
+	if(length != 0)
+	{
+		hal_spi_master_mode_transfer(lcd->config.spi, lcd->config.ssel, params, NULL, length, 0);
+		lcd->bytes_sent += length;
+	}
+
+	hal_spi_master_mode_end_transfer(lcd->config.spi);
+
+	// El comando pudo haber modificado la ventana o la orientacion
+	lcd->column_window = HAL_SPI_LCD_WINDOW_INVALID;
+	lcd->row_window = HAL_SPI_LCD_WINDOW_INVALID;
+}
+
+void hal_spi_lcd_invalidate(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+	uint32_t first_column;
+	uint32_t last_column;
+	uint32_t last_row;
+	uint32_t mask;
+	uint32_t row;
+
+	if(!hal_spi_lcd_clip(lcd, &x, &y, &width, &height))
+	{
+		return;
+	}
+
+	first_column = x / HAL_SPI_LCD_TILE_SIZE;
+	last_column = (x + width - 1) / HAL_SPI_LCD_TILE_SIZE;
+	last_row = (y + height - 1) / HAL_SPI_LCD_TILE_SIZE;
+
+	mask = (0xFFFFFFFF >> (31 - last_column)) & (0xFFFFFFFF << first_column);
+
+	for(row = y / HAL_SPI_LCD_TILE_SIZE; row <= last_row; row++)
+	{
+		lcd->dirty[row] |= mask;
+	}
+}
+
+void hal_spi_lcd_invalidate_all(hal_spi_lcd_t *lcd)
+{
+	hal_spi_lcd_invalidate(lcd, 0, 0, lcd->config.width, lcd->config.height);
+}
+
+void hal_spi_lcd_flush(hal_spi_lcd_t *lcd)
+{
+	uint32_t row;
+	uint8_t flushed = 0;
+
+	for(row = 0; row < HAL_SPI_LCD_TILE_ROWS; row++)
+	{
+		while(lcd->dirty[row] != 0)
+		{
+			uint32_t first = 0;
+			uint32_t count = 0;
+			uint32_t last_row;
+			uint32_t mask;
+			uint32_t aux;
+
+			// Grupo de baldosas contiguas a partir de la primera marcada
+			while((lcd->dirty[row] & (1UL << first)) == 0)
+			{
+				first++;
+			}
+
+			while(((first + count) < 32) && (lcd->dirty[row] & (1UL << (first + count))))
+			{
+				count++;
+			}
+
+			mask = (0xFFFFFFFF >> (32 - count)) << first;
+
+			// Las filas siguientes con el mismo grupo marcado se agregan al mismo rectangulo
+			for(last_row = row + 1; (last_row < HAL_SPI_LCD_TILE_ROWS) && ((lcd->dirty[last_row] & mask) == mask); last_row++);
+
+			for(aux = row; aux < last_row; aux++)
+			{
+				lcd->dirty[aux] &= ~mask;
+			}
+
+			hal_spi_lcd_render(lcd, first * HAL_SPI_LCD_TILE_SIZE, row * HAL_SPI_LCD_TILE_SIZE,
+					count * HAL_SPI_LCD_TILE_SIZE, (last_row - row) * HAL_SPI_LCD_TILE_SIZE);
+
+			flushed = 1;
+		}
+	}
+
+	if(flushed)
+	{
+		hal_spi_master_mode_end_transfer(lcd->config.spi);
+	}
+}
+
+void hal_spi_lcd_fill(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+	uint32_t count;
+
+	if(!hal_spi_lcd_clip(lcd, &x, &y, &width, &height))
+	{
+		return;
+	}
+
+	count = (uint32_t) width * height;
+
+	hal_spi_lcd_window(lcd, x, y, width, height);
+	hal_spi_master_mode_fill_16(lcd->config.spi, lcd->config.ssel, color, count, 1);
+
+	lcd->bytes_sent += count * 2;
+}
+
+void hal_spi_lcd_draw(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels)
+{
+	uint16_t stride = width;
+	uint16_t line;
+
+	if(!hal_spi_lcd_clip(lcd, &x, &y, &width, &height))
+	{
+		return;
+	}
+
+	hal_spi_lcd_window(lcd, x, y, width, height);
+
+	if(width == stride)
+	{
+		hal_spi_master_mode_write_16(lcd->config.spi, lcd->config.ssel, pixels, (uint32_t) width * height, 1);
+	}
+	else
+	{
+		// Recortado a la derecha, cada fila visible se transmite por separado salteando el resto de la fila de origen
+		for(line = 0; line < height; line++)
+		{
+			hal_spi_master_mode_write_16(lcd->config.spi, lcd->config.ssel, pixels, width, line == (height - 1));
+			pixels += stride;
+		}
+	}
+
+	lcd->bytes_sent += (uint32_t) width * height * 2;
+}
+
+/**
+ * @brief Recortar un rectangulo a los limites de la pantalla
+ * @param[in] lcd Estado del display
+ * @param[in,out] x Columna del rectangulo
+ * @param[in,out] y Fila del rectangulo
+ * @param[in,out] width Ancho del rectangulo
+ * @param[in,out] height Alto del rectangulo
+ * @return Distinto de cero si el rectangulo recortado no es vacio
+ */
+static uint8_t hal_spi_lcd_clip(const hal_spi_lcd_t *lcd, uint16_t *x, uint16_t *y, uint16_t *width, uint16_t *height)
+{
+	if((*x >= lcd->config.width) || (*y >= lcd->config.height) || (*width == 0) || (*height == 0))
+	{
+		return 0;
+	}
+
+	if(*width > (lcd->config.width - *x))
+	{
+		*width = lcd->config.width - *x;
+	}
+
+	if(*height > (lcd->config.height - *y))
+	{
+		*height = lcd->config.height - *y;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Enviar un comando sin parametros y dejar el pin de datos/comando en datos
+ *
+ * El slave select queda activo.
+ *
+ * @param[in] lcd Estado del display
+ * @param[in] command Comando
+ */
+static void hal_spi_lcd_send_command(hal_spi_lcd_t *lcd, uint8_t command)
+{
+	// Las transferencias por encuesta terminan con el bus libre, por lo que el pin puede cambiar sin cortar un dato
+	hal_gpio_clear_pin(lcd->config.dc_portpin);
+	hal_spi_master_mode_transfer(lcd->config.spi, lcd->config.ssel, &command, NULL, 1, 0);
+	hal_gpio_set_pin(lcd->config.dc_portpin);
+
+	lcd->bytes_sent++;
+}
+
+/**
+ * @brief Enviar un comando de rango de columnas o filas, si el rango cambio
+ *
+ * Los parametros son el inicio y el fin en 16 bits, con el byte mas significativo primero, por lo que se transmiten
+ * como dos palabras de 16 bits.
+ *
+ * @param[in] lcd Estado del display
+ * @param[in] command Comando de rango
+ * @param[in,out] last Ultimo rango enviado con el mismo comando
+ * @param[in] start Inicio del rango
+ * @param[in] end Fin del rango (inclusive)
+ */
+static void hal_spi_lcd_send_range(hal_spi_lcd_t *lcd, uint8_t command, uint32_t *last, uint16_t start, uint16_t end)
+{
+	uint32_t range = ((uint32_t) start << 16) | end;
+	uint16_t params[2];
+
+	if(range == *last)
+	{
+		return;
+	}
+
+	params[0] = start;
+	params[1] = end;
+
+	hal_spi_lcd_send_command(lcd, command);
+	hal_spi_master_mode_write_16(lcd->config.spi, lcd->config.ssel, params, 2, 0);
+
+	lcd->bytes_sent += 4;
+	*last = range;
+}
+
+/**
+ * @brief Configurar la ventana de escritura y comenzar la escritura de memoria
+ *
+ * El slave select queda activo y el pin de datos/comando en datos.
+ *
+ * @param[in] lcd Estado del display
+ * @param[in] x Columna de la ventana
+ * @param[in] y Fila de la ventana
+ * @param[in] width Ancho de la ventana
+ * @param[in] height Alto de la ventana
+ */
+static void hal_spi_lcd_window(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+	x += lcd->config.x_offset;
+	y += lcd->config.y_offset;
+
+	hal_spi_lcd_send_range(lcd, HAL_SPI_LCD_CMD_CASET, &lcd->column_window, x, x + width - 1);
+	hal_spi_lcd_send_range(lcd, HAL_SPI_LCD_CMD_RASET, &lcd->row_window, y, y + height - 1);
+
+	hal_spi_lcd_send_command(lcd, HAL_SPI_LCD_CMD_RAMWR);
+}
+
+/**
+ * @brief Redibujar un rectangulo mediante el callback de dibujo
+ * @param[in] lcd Estado del display
+ * @param[in] x Columna del rectangulo
+ * @param[in] y Fila del rectangulo
+ * @param[in] width Ancho del rectangulo
+ * @param[in] height Alto del rectangulo
+ */
+static void hal_spi_lcd_render(hal_spi_lcd_t *lcd, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+	const hal_spi_lcd_config_t *config = &lcd->config;
+	uint16_t line;
+
+	if((config->render_callback == NULL) || !hal_spi_lcd_clip(lcd, &x, &y, &width, &height))
+	{
+		return;
+	}
+
+	hal_spi_lcd_window(lcd, x, y, width, height);
+
+	for(line = y; line < (y + height); line++)
+	{
+		uint16_t column;
+
+		for(column = x; column < (x + width); )
+		{
+			uint16_t length = x + width - column;
+
+			if(length > config->line_buffer_length)
+			{
+				length = config->line_buffer_length;
+			}
+
+			config->render_callback(column, line, length, config->line_buffer, config->render_data);
+			hal_spi_master_mode_write_16(config->spi, config->ssel, config->line_buffer, length, 0);
+
+			lcd->bytes_sent += length * 2;
+			column += length;
+		}
+	}
+}
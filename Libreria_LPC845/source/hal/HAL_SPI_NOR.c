@@ -0,0 +1,354 @@
+/**
+ * @file HAL_SPI_NOR.c
+ * @brief Funciones a nivel de aplicacion del controlador de memorias flash NOR SPI (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <HAL_SPI.h>
+#include <HAL_SPI_NOR.h>
+
+/** Comando de habilitacion de escritura */
+#define		HAL_SPI_NOR_CMD_WRITE_ENABLE		0x06
+
+/** Comando de lectura del registro de estado */
+#define		HAL_SPI_NOR_CMD_READ_STATUS			0x05
+
+/** Comando de lectura de datos */
+#define		HAL_SPI_NOR_CMD_READ_DATA			0x03
+
+/** Comando de programacion de pagina */
+#define		HAL_SPI_NOR_CMD_PAGE_PROGRAM		0x02
+
+/** Comando de lectura de identificacion JEDEC */
+#define		HAL_SPI_NOR_CMD_READ_ID				0x9F
+
+/** Comando de borrado de la memoria completa */
+#define		HAL_SPI_NOR_CMD_ERASE_CHIP			0xC7
+
+/** Bit de escritura en curso del registro de estado */
+#define		HAL_SPI_NOR_STATUS_WIP				(1 << 0)
+
+/** Mascara de los indices de la cola */
+#define		HAL_SPI_NOR_QUEUE_MASK				(HAL_SPI_NOR_QUEUE_LENGTH - 1)
+
+#if ((HAL_SPI_NOR_QUEUE_LENGTH & HAL_SPI_NOR_QUEUE_MASK) != 0) || (HAL_SPI_NOR_QUEUE_LENGTH > 128)
+#error "HAL_SPI_NOR_QUEUE_LENGTH debe ser una potencia de 2 no mayor a 128"
+#endif
+
+static const uint8_t hal_spi_nor_erase_commands[] = { //!< Comandos de borrado segun el tamaño
+		0x20,
+		0x52,
+		0xD8,
+		HAL_SPI_NOR_CMD_ERASE_CHIP
+};
+
+static void hal_spi_nor_command(const hal_spi_nor_t *nor, uint8_t command, uint32_t address, uint8_t address_bytes, uint8_t end_of_transfer);
+static uint8_t hal_spi_nor_read_status(const hal_spi_nor_t *nor);
+static uint8_t hal_spi_nor_lock(hal_spi_nor_t *nor);
+static void hal_spi_nor_unlock(hal_spi_nor_t *nor);
+static hal_spi_nor_result_en hal_spi_nor_enqueue(hal_spi_nor_t *nor, uint8_t command, uint32_t address, const uint8_t *data, uint32_t length);
+
+void hal_spi_nor_init(hal_spi_nor_t *nor, hal_spi_sel_en spi, hal_spi_ssel_sel_en ssel)
+{
+	nor->spi = spi;
+	nor->ssel = ssel;
+	nor->bus_locked = 0;
+	nor->write_in_progress = 0;
+	nor->queue_head = 0;
+	nor->queue_tail = 0;
+	nor->cache_address = 0;
+	nor->cache_length = 0;
+}
+
+hal_spi_nor_result_en hal_spi_nor_read_id(hal_spi_nor_t *nor, uint32_t *id)
+{
+	uint8_t aux[3];
+
+	if(!hal_spi_nor_lock(nor))
+	{
+		return HAL_SPI_NOR_RESULT_BUSY;
+	}
+
+	hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_READ_ID, 0, 0, 0);
+	hal_spi_master_mode_transfer(nor->spi, nor->ssel, NULL, aux, sizeof(aux), 1);
+
+	hal_spi_nor_unlock(nor);
+
+	*id = (aux[0] << 16) | (aux[1] << 8) | aux[2];
+
+	return HAL_SPI_NOR_RESULT_OK;
+}
+
+hal_spi_nor_result_en hal_spi_nor_read(hal_spi_nor_t *nor, uint32_t address, uint8_t *data, uint32_t length)
+{
+	if(!hal_spi_nor_lock(nor))
+	{
+		return HAL_SPI_NOR_RESULT_BUSY;
+	}
+
+	while(length != 0)
+	{
+		uint32_t chunk;
+
+		if((address >= nor->cache_address) && ((address - nor->cache_address) < nor->cache_length))
+		{
+			// Acierto en el cache
+			chunk = nor->cache_length - (address - nor->cache_address);
+
+			if(chunk > length)
+			{
+				chunk = length;
+			}
+
+			memcpy(data, &nor->cache[address - nor->cache_address], chunk);
+		}
+		else if(length >= HAL_SPI_NOR_CACHE_SIZE)
+		{
+			// Las lecturas grandes no pasan por el cache
+			chunk = length;
+
+			hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_READ_DATA, address, 3, 0);
+			hal_spi_master_mode_transfer(nor->spi, nor->ssel, NULL, data, chunk, 1);
+		}
+		else
+		{
+			// Lectura anticipada de un bloque completo, sin avanzar sobre el pedido
+			hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_READ_DATA, address, 3, 0);
+			hal_spi_master_mode_transfer(nor->spi, nor->ssel, NULL, nor->cache, HAL_SPI_NOR_CACHE_SIZE, 1);
+
+			nor->cache_address = address;
+			nor->cache_length = HAL_SPI_NOR_CACHE_SIZE;
+
+			continue;
+		}
+
+		address += chunk;
+		data += chunk;
+		length -= chunk;
+	}
+
+	hal_spi_nor_unlock(nor);
+
+	return HAL_SPI_NOR_RESULT_OK;
+}
+
+hal_spi_nor_result_en hal_spi_nor_program(hal_spi_nor_t *nor, uint32_t address, const uint8_t *data, uint32_t length)
+{
+	if(length == 0)
+	{
+		return HAL_SPI_NOR_RESULT_OK;
+	}
+
+	return hal_spi_nor_enqueue(nor, HAL_SPI_NOR_CMD_PAGE_PROGRAM, address, data, length);
+}
+
+hal_spi_nor_result_en hal_spi_nor_erase(hal_spi_nor_t *nor, hal_spi_nor_erase_en size, uint32_t address)
+{
+	if((uint32_t) size >= sizeof(hal_spi_nor_erase_commands))
+	{
+		return HAL_SPI_NOR_RESULT_PARAM_ERROR;
+	}
+
+	return hal_spi_nor_enqueue(nor, hal_spi_nor_erase_commands[size], address, NULL, 0);
+}
+
+void hal_spi_nor_poll(hal_spi_nor_t *nor)
+{
+	hal_spi_nor_op_t *op;
+
+	if(nor->bus_locked)
+	{
+		return;
+	}
+
+	if(nor->write_in_progress)
+	{
+		if(hal_spi_nor_read_status(nor) & HAL_SPI_NOR_STATUS_WIP)
+		{
+			return;
+		}
+
+		nor->write_in_progress = 0;
+	}
+
+	if(nor->queue_head == nor->queue_tail)
+	{
+		return;
+	}
+
+	op = &nor->queue[nor->queue_tail & HAL_SPI_NOR_QUEUE_MASK];
+
+	hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_WRITE_ENABLE, 0, 0, 1);
+
+	if(op->command == HAL_SPI_NOR_CMD_PAGE_PROGRAM)
+	{
+		// Una programacion no puede cruzar el limite de pagina
+		uint32_t chunk = HAL_SPI_NOR_PAGE_SIZE - (op->address & (HAL_SPI_NOR_PAGE_SIZE - 1));
+
+		if(chunk > op->length)
+		{
+			chunk = op->length;
+		}
+
+		hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_PAGE_PROGRAM, op->address, 3, 0);
+		hal_spi_master_mode_transfer(nor->spi, nor->ssel, op->data, NULL, chunk, 1);
+
+		op->address += chunk;
+		op->data += chunk;
+		op->length -= chunk;
+	}
+	else if(op->command == HAL_SPI_NOR_CMD_ERASE_CHIP)
+	{
+		hal_spi_nor_command(nor, op->command, 0, 0, 1);
+	}
+	else
+	{
+		hal_spi_nor_command(nor, op->command, op->address, 3, 1);
+	}
+
+	nor->write_in_progress = 1;
+
+	if(op->length == 0)
+	{
+		nor->queue_tail++;
+	}
+}
+
+uint8_t hal_spi_nor_is_idle(const hal_spi_nor_t *nor)
+{
+	return (nor->queue_head == nor->queue_tail) && !nor->write_in_progress;
+}
+
+hal_spi_nor_result_en hal_spi_nor_stream_begin(hal_spi_nor_t *nor, uint32_t address)
+{
+	if(!hal_spi_nor_lock(nor))
+	{
+		return HAL_SPI_NOR_RESULT_BUSY;
+	}
+
+	// El bus queda tomado hasta hal_spi_nor_stream_end
+	hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_READ_DATA, address, 3, 0);
+
+	return HAL_SPI_NOR_RESULT_OK;
+}
+
+void hal_spi_nor_stream_read(hal_spi_nor_t *nor, uint8_t *data, uint32_t length)
+{
+	hal_spi_master_mode_transfer(nor->spi, nor->ssel, NULL, data, length, 0);
+}
+
+void hal_spi_nor_stream_end(hal_spi_nor_t *nor)
+{
+	hal_spi_master_mode_end_transfer(nor->spi);
+	hal_spi_nor_unlock(nor);
+}
+
+/**
+ * @brief Enviar un comando con o sin direccion
+ * @param[in] nor Estado de la memoria
+ * @param[in] command Comando
+ * @param[in] address Direccion
+ * @param[in] address_bytes Cantidad de bytes de direccion a enviar (0 o 3)
+ * @param[in] end_of_transfer Distinto de cero para desactivar el slave select al terminar
+ */
+static void hal_spi_nor_command(const hal_spi_nor_t *nor, uint8_t command, uint32_t address, uint8_t address_bytes, uint8_t end_of_transfer)
+{
+	uint8_t header[4];
+
+	header[0] = command;
+	header[1] = (uint8_t) (address >> 16);
+	header[2] = (uint8_t) (address >> 8);
+	header[3] = (uint8_t) address;
+
+	// Fase de solo escritura, no se leen los datos recibidos
+	hal_spi_master_mode_transfer(nor->spi, nor->ssel, header, NULL, 1 + address_bytes, end_of_transfer);
+}
+
+/**
+ * @brief Leer el registro de estado
+ * @param[in] nor Estado de la memoria
+ * @return Registro de estado
+ */
+static uint8_t hal_spi_nor_read_status(const hal_spi_nor_t *nor)
+{
+	uint8_t status;
+
+	hal_spi_nor_command(nor, HAL_SPI_NOR_CMD_READ_STATUS, 0, 0, 0);
+	hal_spi_master_mode_transfer(nor->spi, nor->ssel, NULL, &status, 1, 1);
+
+	return status;
+}
+
+/**
+ * @brief Tomar el bus desde el lazo principal
+ *
+ * El bus se marca como tomado antes de verificar la cola, de modo que una llamada a hal_spi_nor_poll desde una
+ * interrupcion no pueda iniciar una operacion luego de la verificacion.
+ *
+ * @param[in] nor Estado de la memoria
+ * @return Distinto de cero si se tomo el bus, cero si hay operaciones pendientes o el bus ya estaba tomado
+ */
+static uint8_t hal_spi_nor_lock(hal_spi_nor_t *nor)
+{
+	if(nor->bus_locked)
+	{
+		return 0;
+	}
+
+	nor->bus_locked = 1;
+
+	if(!hal_spi_nor_is_idle(nor))
+	{
+		nor->bus_locked = 0;
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Liberar el bus
+ * @param[in] nor Estado de la memoria
+ */
+static void hal_spi_nor_unlock(hal_spi_nor_t *nor)
+{
+	nor->bus_locked = 0;
+}
+
+/**
+ * @brief Agregar una operacion a la cola
+ * @param[in] nor Estado de la memoria
+ * @param[in] command Comando de la operacion
+ * @param[in] address Direccion
+ * @param[in] data Datos a programar
+ * @param[in] length Cantidad de datos a programar
+ * @return Resultado de la operacion
+ */
+static hal_spi_nor_result_en hal_spi_nor_enqueue(hal_spi_nor_t *nor, uint8_t command, uint32_t address, const uint8_t *data, uint32_t length)
+{
+	hal_spi_nor_op_t *op;
+
+	if((uint8_t) (nor->queue_head - nor->queue_tail) >= HAL_SPI_NOR_QUEUE_LENGTH)
+	{
+		return HAL_SPI_NOR_RESULT_QUEUE_FULL;
+	}
+
+	op = &nor->queue[nor->queue_head & HAL_SPI_NOR_QUEUE_MASK];
+
+	op->command = command;
+	op->address = address;
+	op->data = data;
+	op->length = length;
+
+	// El contenido del cache puede dejar de coincidir con la memoria
+	nor->cache_length = 0;
+
+	// La operacion queda visible para hal_spi_nor_poll recien al avanzar el indice
+	nor->queue_head++;
+
+	return HAL_SPI_NOR_RESULT_OK;
+}
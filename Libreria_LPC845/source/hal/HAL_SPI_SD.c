@@ -0,0 +1,759 @@
+/**
+ * @file HAL_SPI_SD.c
+ * @brief Funciones a nivel de aplicacion del controlador de tarjetas SD en modo SPI (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_SPI.h>
+#include <HAL_SPI_SD.h>
+
+/** Comando de reset (*GO_IDLE_STATE*) */
+#define		HAL_SPI_SD_CMD_GO_IDLE_STATE			0
+
+/** Comando de verificacion de tension (*SEND_IF_COND*) */
+#define		HAL_SPI_SD_CMD_SEND_IF_COND				8
+
+/** Comando de fin de lectura de multiples bloques (*STOP_TRANSMISSION*) */
+#define		HAL_SPI_SD_CMD_STOP_TRANSMISSION		12
+
+/** Comando de configuracion del tamaño de bloque (*SET_BLOCKLEN*) */
+#define		HAL_SPI_SD_CMD_SET_BLOCKLEN				16
+
+/** Comando de lectura de multiples bloques (*READ_MULTIPLE_BLOCK*) */
+#define		HAL_SPI_SD_CMD_READ_MULTIPLE_BLOCK		18
+
+/** Comando de escritura de multiples bloques (*WRITE_MULTIPLE_BLOCK*) */
+#define		HAL_SPI_SD_CMD_WRITE_MULTIPLE_BLOCK		25
+
+/** Prefijo de comandos de aplicacion (*APP_CMD*) */
+#define		HAL_SPI_SD_CMD_APP_CMD					55
+
+/** Comando de lectura del OCR (*READ_OCR*) */
+#define		HAL_SPI_SD_CMD_READ_OCR					58
+
+/** Comando de habilitacion de CRC (*CRC_ON_OFF*) */
+#define		HAL_SPI_SD_CMD_CRC_ON_OFF				59
+
+/** Comando de aplicacion de borrado anticipado (*SET_WR_BLK_ERASE_COUNT*) */
+#define		HAL_SPI_SD_ACMD_SET_WR_BLK_ERASE_COUNT	23
+
+/** Comando de aplicacion de inicializacion (*SD_SEND_OP_COND*) */
+#define		HAL_SPI_SD_ACMD_SD_SEND_OP_COND			41
+
+/** Bit de estado de inicializacion de la respuesta R1 */
+#define		HAL_SPI_SD_R1_IDLE						(1 << 0)
+
+/** Bit de comando invalido de la respuesta R1 */
+#define		HAL_SPI_SD_R1_ILLEGAL_COMMAND			(1 << 2)
+
+/** Argumento de *CMD8*: tension de 2.7V a 3.6V y patron de verificacion */
+#define		HAL_SPI_SD_IF_COND_ARG					0x1AA
+
+/** Bit de soporte de tarjetas de alta capacidad del argumento de *ACMD41* */
+#define		HAL_SPI_SD_ACMD41_HCS					(1UL << 30)
+
+/** Bit de tarjeta de alta capacidad del OCR, dentro del primer byte recibido */
+#define		HAL_SPI_SD_OCR_CCS						(1 << 6)
+
+/** Cantidad maxima de bytes de espera de la respuesta a un comando */
+#define		HAL_SPI_SD_RESPONSE_BYTES				8
+
+/** Cantidad de intentos de *CMD0* */
+#define		HAL_SPI_SD_GO_IDLE_RETRIES				10
+
+/** Token de inicio de bloque leido */
+#define		HAL_SPI_SD_TOKEN_START_BLOCK			0xFE
+
+/** Token de inicio de bloque de una escritura de multiples bloques */
+#define		HAL_SPI_SD_TOKEN_START_MULTIPLE_WRITE	0xFC
+
+/** Token de fin de una escritura de multiples bloques */
+#define		HAL_SPI_SD_TOKEN_STOP_TRANSMISSION		0xFD
+
+/** Mascara de la respuesta a un bloque escrito */
+#define		HAL_SPI_SD_DATA_RESPONSE_MASK			0x1F
+
+/** Respuesta a un bloque escrito: aceptado */
+#define		HAL_SPI_SD_DATA_RESPONSE_ACCEPTED		0x05
+
+/** Respuesta a un bloque escrito: error de CRC */
+#define		HAL_SPI_SD_DATA_RESPONSE_CRC_ERROR		0x0B
+
+static const uint16_t hal_spi_sd_crc16_table[] = { //!< CRC16-CCITT de cada nibble
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static uint8_t hal_spi_sd_command(const hal_spi_sd_t *sd, uint8_t command, uint32_t argument);
+static uint8_t hal_spi_sd_app_command(const hal_spi_sd_t *sd, uint8_t command, uint32_t argument);
+static void hal_spi_sd_deselect(const hal_spi_sd_t *sd);
+static void hal_spi_sd_fail(hal_spi_sd_t *sd, hal_spi_sd_error_en error);
+static uint8_t hal_spi_sd_poll(hal_spi_sd_t *sd, uint8_t busy, uint8_t *data);
+static void hal_spi_sd_init_step(hal_spi_sd_t *sd);
+static void hal_spi_sd_read_block(hal_spi_sd_t *sd, uint8_t token);
+static void hal_spi_sd_write_block(hal_spi_sd_t *sd);
+static hal_spi_sd_result_en hal_spi_sd_write_start(hal_spi_sd_t *sd, uint32_t block, uint32_t erase_count);
+static uint8_t hal_spi_sd_append_ready(const hal_spi_sd_t *sd);
+static uint32_t hal_spi_sd_address(const hal_spi_sd_t *sd, uint32_t block);
+static uint8_t hal_spi_sd_crc7(const uint8_t *data, uint32_t length);
+static uint16_t hal_spi_sd_crc16(const uint8_t *data, uint32_t length);
+
+void hal_spi_sd_init(hal_spi_sd_t *sd, const hal_spi_sd_config_t *config)
+{
+	uint8_t aux[4];
+	uint8_t r1 = 0xFF;
+	uint8_t counter;
+
+	sd->spi = config->spi;
+	sd->ssel = config->ssel;
+	sd->tx_config = config->tx_config;
+	sd->crc_enable = config->crc_enable;
+	sd->type = HAL_SPI_SD_TYPE_UNKNOWN;
+	sd->state = HAL_SPI_SD_STATE_ERROR;
+	sd->error = HAL_SPI_SD_ERROR_NONE;
+	sd->write_open = 0;
+	sd->close_requested = 0;
+	sd->count = 0;
+
+	hal_spi_master_mode_tx_config(sd->spi, &config->init_tx_config);
+
+	// Al menos 74 ciclos de clock con el slave select inactivo
+	hal_spi_master_mode_transfer(sd->spi, HAL_SPI_SSEL_SELECTION_OTHER, NULL, NULL, 10, 1);
+
+	for(counter = 0; (counter < HAL_SPI_SD_GO_IDLE_RETRIES) && (r1 != HAL_SPI_SD_R1_IDLE); counter++)
+	{
+		r1 = hal_spi_sd_command(sd, HAL_SPI_SD_CMD_GO_IDLE_STATE, 0);
+		hal_spi_sd_deselect(sd);
+	}
+
+	if(r1 != HAL_SPI_SD_R1_IDLE)
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_NO_CARD);
+		return;
+	}
+
+	r1 = hal_spi_sd_command(sd, HAL_SPI_SD_CMD_SEND_IF_COND, HAL_SPI_SD_IF_COND_ARG);
+
+	if(r1 & HAL_SPI_SD_R1_ILLEGAL_COMMAND)
+	{
+		// Las tarjetas version 1.x no reconocen CMD8
+		sd->type = HAL_SPI_SD_TYPE_SDSC_V1;
+	}
+	else
+	{
+		hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, aux, sizeof(aux), 0);
+
+		if((r1 != HAL_SPI_SD_R1_IDLE) || (((aux[2] << 8) | aux[3]) & 0xFFF) != HAL_SPI_SD_IF_COND_ARG)
+		{
+			hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_UNSUPPORTED);
+			return;
+		}
+
+		// El tipo definitivo se conoce al leer el OCR
+		sd->type = HAL_SPI_SD_TYPE_SDSC_V2;
+	}
+
+	hal_spi_sd_deselect(sd);
+
+	sd->timeout = HAL_SPI_SD_INIT_RETRIES;
+	sd->state = HAL_SPI_SD_STATE_INIT;
+}
+
+hal_spi_sd_status_en hal_spi_sd_process(hal_spi_sd_t *sd)
+{
+	uint8_t data;
+
+	switch(sd->state)
+	{
+	case HAL_SPI_SD_STATE_INIT:
+		hal_spi_sd_init_step(sd);
+		break;
+
+	case HAL_SPI_SD_STATE_READ_TOKEN:
+		if(hal_spi_sd_poll(sd, 0, &data))
+		{
+			hal_spi_sd_read_block(sd, data);
+		}
+		break;
+
+	case HAL_SPI_SD_STATE_WRITE_BLOCK:
+		hal_spi_sd_write_block(sd);
+		break;
+
+	case HAL_SPI_SD_STATE_WRITE_BUSY:
+		if(hal_spi_sd_poll(sd, 1, &data))
+		{
+			// Se transmite el proximo bloque en el mismo llamado, para no desperdiciar un periodo de encuesta
+			sd->state = HAL_SPI_SD_STATE_WRITE_BLOCK;
+			hal_spi_sd_write_block(sd);
+		}
+		break;
+
+	case HAL_SPI_SD_STATE_STOP_BUSY:
+		if(hal_spi_sd_poll(sd, 1, &data))
+		{
+			hal_spi_sd_deselect(sd);
+			sd->state = HAL_SPI_SD_STATE_READY;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if(sd->state == HAL_SPI_SD_STATE_ERROR)
+	{
+		return HAL_SPI_SD_STATUS_ERROR;
+	}
+	else if(sd->state == HAL_SPI_SD_STATE_READY)
+	{
+		return HAL_SPI_SD_STATUS_READY;
+	}
+	else if(hal_spi_sd_append_ready(sd))
+	{
+		return HAL_SPI_SD_STATUS_WRITE_READY;
+	}
+
+	return HAL_SPI_SD_STATUS_BUSY;
+}
+
+hal_spi_sd_result_en hal_spi_sd_read(hal_spi_sd_t *sd, uint32_t block, uint8_t *data, uint32_t count)
+{
+	if(sd->state == HAL_SPI_SD_STATE_ERROR)
+	{
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	if(sd->state != HAL_SPI_SD_STATE_READY)
+	{
+		return HAL_SPI_SD_RESULT_BUSY;
+	}
+
+	if(count == 0)
+	{
+		return HAL_SPI_SD_RESULT_OK;
+	}
+
+	if(hal_spi_sd_command(sd, HAL_SPI_SD_CMD_READ_MULTIPLE_BLOCK, hal_spi_sd_address(sd, block)) != 0)
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	sd->rx_data = data;
+	sd->count = count;
+	sd->timeout = HAL_SPI_SD_TIMEOUT_BYTES;
+	sd->state = HAL_SPI_SD_STATE_READ_TOKEN;
+
+	return HAL_SPI_SD_RESULT_OK;
+}
+
+hal_spi_sd_result_en hal_spi_sd_write(hal_spi_sd_t *sd, uint32_t block, const uint8_t *data, uint32_t count)
+{
+	hal_spi_sd_result_en result;
+
+	if((count == 0) && (sd->state == HAL_SPI_SD_STATE_READY))
+	{
+		return HAL_SPI_SD_RESULT_OK;
+	}
+
+	result = hal_spi_sd_write_start(sd, block, count);
+
+	if(result == HAL_SPI_SD_RESULT_OK)
+	{
+		// La escritura se cierra sola al transmitir el ultimo bloque
+		sd->write_open = 0;
+		sd->tx_data = data;
+		sd->count = count;
+	}
+
+	return result;
+}
+
+hal_spi_sd_result_en hal_spi_sd_write_open(hal_spi_sd_t *sd, uint32_t block, uint32_t erase_count)
+{
+	hal_spi_sd_result_en result;
+
+	result = hal_spi_sd_write_start(sd, block, erase_count);
+
+	if(result == HAL_SPI_SD_RESULT_OK)
+	{
+		sd->write_open = 1;
+		sd->count = 0;
+	}
+
+	return result;
+}
+
+hal_spi_sd_result_en hal_spi_sd_write_append(hal_spi_sd_t *sd, const uint8_t *data, uint32_t count)
+{
+	if(sd->state == HAL_SPI_SD_STATE_ERROR)
+	{
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	if(!hal_spi_sd_append_ready(sd))
+	{
+		return HAL_SPI_SD_RESULT_BUSY;
+	}
+
+	sd->tx_data = data;
+	sd->count = count;
+
+	return HAL_SPI_SD_RESULT_OK;
+}
+
+hal_spi_sd_result_en hal_spi_sd_write_close(hal_spi_sd_t *sd)
+{
+	if(sd->state == HAL_SPI_SD_STATE_ERROR)
+	{
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	if(!sd->write_open)
+	{
+		return HAL_SPI_SD_RESULT_BUSY;
+	}
+
+	sd->close_requested = 1;
+
+	return HAL_SPI_SD_RESULT_OK;
+}
+
+hal_spi_sd_error_en hal_spi_sd_get_error(const hal_spi_sd_t *sd)
+{
+	return sd->error;
+}
+
+hal_spi_sd_type_en hal_spi_sd_get_type(const hal_spi_sd_t *sd)
+{
+	return sd->type;
+}
+
+/**
+ * @brief Enviar un comando y leer la respuesta R1
+ *
+ * El slave select queda activo, para poder leer el resto de la respuesta o continuar con la fase de datos.
+ *
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] command Indice del comando
+ * @param[in] argument Argumento del comando
+ * @return Respuesta R1, o 0xFF si la tarjeta no respondio
+ */
+static uint8_t hal_spi_sd_command(const hal_spi_sd_t *sd, uint8_t command, uint32_t argument)
+{
+	uint8_t frame[6];
+	uint8_t response = 0xFF;
+	uint8_t counter;
+
+	frame[0] = 0x40 | command;
+	frame[1] = (uint8_t) (argument >> 24);
+	frame[2] = (uint8_t) (argument >> 16);
+	frame[3] = (uint8_t) (argument >> 8);
+	frame[4] = (uint8_t) argument;
+	frame[5] = (hal_spi_sd_crc7(frame, 5) << 1) | 1;
+
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, frame, NULL, sizeof(frame), 0);
+
+	if(command == HAL_SPI_SD_CMD_STOP_TRANSMISSION)
+	{
+		// El byte siguiente a CMD12 es un resto de la lectura en curso
+		hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, &response, 1, 0);
+	}
+
+	for(counter = 0; counter < HAL_SPI_SD_RESPONSE_BYTES; counter++)
+	{
+		hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, &response, 1, 0);
+
+		if((response & 0x80) == 0)
+		{
+			break;
+		}
+	}
+
+	return response;
+}
+
+/**
+ * @brief Enviar un comando de aplicacion (*CMD55* seguido del comando)
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] command Indice del comando de aplicacion
+ * @param[in] argument Argumento del comando
+ * @return Respuesta R1
+ */
+static uint8_t hal_spi_sd_app_command(const hal_spi_sd_t *sd, uint8_t command, uint32_t argument)
+{
+	uint8_t r1;
+
+	r1 = hal_spi_sd_command(sd, HAL_SPI_SD_CMD_APP_CMD, 0);
+
+	if(r1 & ~HAL_SPI_SD_R1_IDLE)
+	{
+		return r1;
+	}
+
+	return hal_spi_sd_command(sd, command, argument);
+}
+
+/**
+ * @brief Desactivar el slave select
+ *
+ * Se transmite un byte adicional con el slave select inactivo para que la tarjeta libere la linea MISO.
+ *
+ * @param[in] sd Estado de la tarjeta
+ */
+static void hal_spi_sd_deselect(const hal_spi_sd_t *sd)
+{
+	hal_spi_master_mode_end_transfer(sd->spi);
+	hal_spi_master_mode_transfer(sd->spi, HAL_SPI_SSEL_SELECTION_OTHER, NULL, NULL, 1, 1);
+}
+
+/**
+ * @brief Abortar la operacion en curso
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] error Error a informar
+ */
+static void hal_spi_sd_fail(hal_spi_sd_t *sd, hal_spi_sd_error_en error)
+{
+	hal_spi_sd_deselect(sd);
+
+	sd->error = error;
+	sd->state = HAL_SPI_SD_STATE_ERROR;
+}
+
+/**
+ * @brief Leer bytes mientras la tarjeta este ocupada
+ *
+ * Lee a lo sumo @ref HAL_SPI_SD_POLL_BYTES bytes. Durante una fase de ocupado la tarjeta mantiene MISO en bajo y la
+ * espera termina al leer 0xFF; esperando un token la tarjeta mantiene MISO en alto y la espera termina al leer
+ * cualquier otro valor.
+ *
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] busy Distinto de cero para esperar el fin de una fase de ocupado, cero para esperar un token
+ * @param[out] data Ultimo byte leido
+ * @return Distinto de cero si termino la espera. Cero si la tarjeta sigue ocupada o vencio el tiempo de espera
+ */
+static uint8_t hal_spi_sd_poll(hal_spi_sd_t *sd, uint8_t busy, uint8_t *data)
+{
+	uint8_t counter;
+
+	for(counter = 0; counter < HAL_SPI_SD_POLL_BYTES; counter++)
+	{
+		hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, data, 1, 0);
+
+		if((*data == 0xFF) == (busy != 0))
+		{
+			return 1;
+		}
+	}
+
+	if(sd->timeout <= HAL_SPI_SD_POLL_BYTES)
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_TIMEOUT);
+		return 0;
+	}
+
+	sd->timeout -= HAL_SPI_SD_POLL_BYTES;
+
+	return 0;
+}
+
+/**
+ * @brief Realizar un intento de *ACMD41* y, si la tarjeta esta lista, terminar la inicializacion
+ * @param[in] sd Estado de la tarjeta
+ */
+static void hal_spi_sd_init_step(hal_spi_sd_t *sd)
+{
+	uint8_t ocr[4];
+	uint8_t r1;
+
+	r1 = hal_spi_sd_app_command(sd, HAL_SPI_SD_ACMD_SD_SEND_OP_COND,
+			(sd->type == HAL_SPI_SD_TYPE_SDSC_V1) ? 0 : HAL_SPI_SD_ACMD41_HCS);
+	hal_spi_sd_deselect(sd);
+
+	if(r1 == HAL_SPI_SD_R1_IDLE)
+	{
+		if(--sd->timeout == 0)
+		{
+			hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_TIMEOUT);
+		}
+
+		return;
+	}
+
+	if(r1 != 0)
+	{
+		// Las tarjetas MMC no reconocen ACMD41
+		hal_spi_sd_fail(sd, (sd->type == HAL_SPI_SD_TYPE_SDSC_V1) ? HAL_SPI_SD_ERROR_UNSUPPORTED : HAL_SPI_SD_ERROR_COMMAND);
+		return;
+	}
+
+	if(sd->type == HAL_SPI_SD_TYPE_SDSC_V2)
+	{
+		r1 = hal_spi_sd_command(sd, HAL_SPI_SD_CMD_READ_OCR, 0);
+		hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, ocr, sizeof(ocr), 0);
+		hal_spi_sd_deselect(sd);
+
+		if(r1 != 0)
+		{
+			hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+			return;
+		}
+
+		if(ocr[0] & HAL_SPI_SD_OCR_CCS)
+		{
+			sd->type = HAL_SPI_SD_TYPE_SDHC;
+		}
+	}
+
+	if(sd->type != HAL_SPI_SD_TYPE_SDHC)
+	{
+		r1 = hal_spi_sd_command(sd, HAL_SPI_SD_CMD_SET_BLOCKLEN, HAL_SPI_SD_BLOCK_SIZE);
+		hal_spi_sd_deselect(sd);
+
+		if(r1 != 0)
+		{
+			hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+			return;
+		}
+	}
+
+	if(sd->crc_enable)
+	{
+		r1 = hal_spi_sd_command(sd, HAL_SPI_SD_CMD_CRC_ON_OFF, 1);
+		hal_spi_sd_deselect(sd);
+
+		if(r1 != 0)
+		{
+			hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+			return;
+		}
+	}
+
+	hal_spi_master_mode_tx_config(sd->spi, &sd->tx_config);
+
+	sd->state = HAL_SPI_SD_STATE_READY;
+}
+
+/**
+ * @brief Leer un bloque luego de recibir su token y, si era el ultimo, terminar la lectura
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] token Token recibido
+ */
+static void hal_spi_sd_read_block(hal_spi_sd_t *sd, uint8_t token)
+{
+	uint8_t crc[2];
+
+	if(token != HAL_SPI_SD_TOKEN_START_BLOCK)
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_READ);
+		return;
+	}
+
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, sd->rx_data, HAL_SPI_SD_BLOCK_SIZE, 0);
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, crc, sizeof(crc), 0);
+
+	if(sd->crc_enable && (hal_spi_sd_crc16(sd->rx_data, HAL_SPI_SD_BLOCK_SIZE) != ((crc[0] << 8) | crc[1])))
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_CRC);
+		return;
+	}
+
+	sd->rx_data += HAL_SPI_SD_BLOCK_SIZE;
+	sd->timeout = HAL_SPI_SD_TIMEOUT_BYTES;
+
+	if(--sd->count != 0)
+	{
+		return;
+	}
+
+	if(hal_spi_sd_command(sd, HAL_SPI_SD_CMD_STOP_TRANSMISSION, 0) != 0)
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+		return;
+	}
+
+	sd->state = HAL_SPI_SD_STATE_STOP_BUSY;
+}
+
+/**
+ * @brief Transmitir el proximo bloque de una escritura, o terminarla si no quedan bloques
+ * @param[in] sd Estado de la tarjeta
+ */
+static void hal_spi_sd_write_block(hal_spi_sd_t *sd)
+{
+	uint8_t aux[2];
+	uint16_t crc = 0xFFFF;
+
+	if(sd->count == 0)
+	{
+		if(sd->write_open && !sd->close_requested)
+		{
+			// Se espera a que el lazo principal agregue mas bloques
+			return;
+		}
+
+		// Token de fin y un byte de espera antes de que la tarjeta indique ocupado
+		aux[0] = HAL_SPI_SD_TOKEN_STOP_TRANSMISSION;
+		aux[1] = HAL_SPI_DUMMY_BYTE;
+
+		hal_spi_master_mode_transfer(sd->spi, sd->ssel, aux, NULL, sizeof(aux), 0);
+
+		sd->write_open = 0;
+		sd->close_requested = 0;
+		sd->timeout = HAL_SPI_SD_TIMEOUT_BYTES;
+		sd->state = HAL_SPI_SD_STATE_STOP_BUSY;
+
+		return;
+	}
+
+	// Un byte de espera antes del token de inicio
+	aux[0] = HAL_SPI_DUMMY_BYTE;
+	aux[1] = HAL_SPI_SD_TOKEN_START_MULTIPLE_WRITE;
+
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, aux, NULL, sizeof(aux), 0);
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, sd->tx_data, NULL, HAL_SPI_SD_BLOCK_SIZE, 0);
+
+	if(sd->crc_enable)
+	{
+		crc = hal_spi_sd_crc16(sd->tx_data, HAL_SPI_SD_BLOCK_SIZE);
+	}
+
+	aux[0] = (uint8_t) (crc >> 8);
+	aux[1] = (uint8_t) crc;
+
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, aux, NULL, sizeof(aux), 0);
+	hal_spi_master_mode_transfer(sd->spi, sd->ssel, NULL, aux, 1, 0);
+
+	if((aux[0] & HAL_SPI_SD_DATA_RESPONSE_MASK) != HAL_SPI_SD_DATA_RESPONSE_ACCEPTED)
+	{
+		hal_spi_sd_fail(sd, ((aux[0] & HAL_SPI_SD_DATA_RESPONSE_MASK) == HAL_SPI_SD_DATA_RESPONSE_CRC_ERROR) ?
+				HAL_SPI_SD_ERROR_CRC : HAL_SPI_SD_ERROR_WRITE);
+		return;
+	}
+
+	sd->tx_data += HAL_SPI_SD_BLOCK_SIZE;
+	sd->count--;
+	sd->timeout = HAL_SPI_SD_TIMEOUT_BYTES;
+	sd->state = HAL_SPI_SD_STATE_WRITE_BUSY;
+}
+
+/**
+ * @brief Enviar el borrado anticipado y el comando de escritura de multiples bloques
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] block Numero del primer bloque
+ * @param[in] erase_count Cantidad de bloques a borrar por adelantado. Cero si no se conoce
+ * @return Resultado de la operacion
+ */
+static hal_spi_sd_result_en hal_spi_sd_write_start(hal_spi_sd_t *sd, uint32_t block, uint32_t erase_count)
+{
+	if(sd->state == HAL_SPI_SD_STATE_ERROR)
+	{
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	if(sd->state != HAL_SPI_SD_STATE_READY)
+	{
+		return HAL_SPI_SD_RESULT_BUSY;
+	}
+
+	// El argumento de ACMD23 tiene 23 bits
+	if((erase_count != 0) &&
+			(hal_spi_sd_app_command(sd, HAL_SPI_SD_ACMD_SET_WR_BLK_ERASE_COUNT, erase_count & 0x7FFFFF) != 0))
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	if(hal_spi_sd_command(sd, HAL_SPI_SD_CMD_WRITE_MULTIPLE_BLOCK, hal_spi_sd_address(sd, block)) != 0)
+	{
+		hal_spi_sd_fail(sd, HAL_SPI_SD_ERROR_COMMAND);
+		return HAL_SPI_SD_RESULT_ERROR;
+	}
+
+	sd->close_requested = 0;
+	sd->state = HAL_SPI_SD_STATE_WRITE_BLOCK;
+
+	return HAL_SPI_SD_RESULT_OK;
+}
+
+/**
+ * @brief Consultar si una escritura abierta acepta mas bloques
+ * @param[in] sd Estado de la tarjeta
+ * @return Distinto de cero si se transmitieron todos los bloques agregados y la escritura sigue abierta
+ */
+static uint8_t hal_spi_sd_append_ready(const hal_spi_sd_t *sd)
+{
+	return sd->write_open && !sd->close_requested && (sd->count == 0) &&
+			((sd->state == HAL_SPI_SD_STATE_WRITE_BLOCK) || (sd->state == HAL_SPI_SD_STATE_WRITE_BUSY));
+}
+
+/**
+ * @brief Calcular el argumento de direccion de un bloque
+ * @param[in] sd Estado de la tarjeta
+ * @param[in] block Numero de bloque
+ * @return Numero de bloque para tarjetas SDHC, direccion en bytes para tarjetas SDSC
+ */
+static uint32_t hal_spi_sd_address(const hal_spi_sd_t *sd, uint32_t block)
+{
+	if(sd->type == HAL_SPI_SD_TYPE_SDHC)
+	{
+		return block;
+	}
+
+	return block * HAL_SPI_SD_BLOCK_SIZE;
+}
+
+/**
+ * @brief Calcular el CRC7 de un comando
+ * @param[in] data Datos
+ * @param[in] length Cantidad de datos
+ * @return CRC7 (polinomio x^7 + x^3 + 1)
+ */
+static uint8_t hal_spi_sd_crc7(const uint8_t *data, uint32_t length)
+{
+	uint8_t crc = 0;
+	uint8_t bit;
+
+	while(length--)
+	{
+		uint8_t byte = *data++;
+
+		for(bit = 0; bit < 8; bit++)
+		{
+			crc <<= 1;
+
+			if((byte ^ crc) & 0x80)
+			{
+				crc ^= 0x09;
+			}
+
+			byte <<= 1;
+		}
+	}
+
+	return crc & 0x7F;
+}
+
+/**
+ * @brief Calcular el CRC16 de un bloque de datos
+ * @param[in] data Datos
+ * @param[in] length Cantidad de datos
+ * @return CRC16-CCITT (polinomio x^16 + x^12 + x^5 + 1, valor inicial 0)
+ */
+static uint16_t hal_spi_sd_crc16(const uint8_t *data, uint32_t length)
+{
+	uint16_t crc = 0;
+
+	while(length--)
+	{
+		crc = (crc << 4) ^ hal_spi_sd_crc16_table[(crc >> 12) ^ (*data >> 4)];
+		crc = (crc << 4) ^ hal_spi_sd_crc16_table[(crc >> 12) ^ (*data & 0x0F)];
+		data++;
+	}
+
+	return crc;
+}
@@ -0,0 +1,363 @@
+/**
+ * @file HAL_STARTUP.c
+ * @brief Funciones a nivel de aplicacion del arranque del sistema (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_STARTUP.h>
+
+static hal_startup_deferred_t *deferred_head = NULL; //!< Primera inicialización diferida registrada
+
+static hal_startup_deferred_t *deferred_tail = NULL; //!< Última inicialización diferida registrada
+
+/**
+ * @brief Inicialización temprana de la aplicación
+ *
+ * Se llama desde el código de arranque luego de inicializar las secciones de datos y antes de *main*. La librería
+ * provee una definición vacía con atributo *weak*, por lo que la aplicación puede redefinirla.
+ */
+__attribute__ ((weak)) void hal_startup_early_init(void)
+{
+	return;
+}
+
+/**
+ * @brief Registrar una inicialización diferida
+ *
+ * Si la inicialización ya estaba registrada, se vuelve a marcar como pendiente.
+ *
+ * @param[in] entry Objeto de la inicialización diferida. Debe tener duración estática
+ * @param[in] init Función de inicialización
+ */
+void hal_startup_deferred_register(hal_startup_deferred_t *entry, hal_startup_init_t init)
+{
+	if(entry->init == NULL)
+	{
+		entry->next = NULL;
+
+		if(deferred_tail == NULL)
+		{
+			deferred_head = entry;
+		}
+		else
+		{
+			deferred_tail->next = entry;
+		}
+
+		deferred_tail = entry;
+	}
+
+	entry->init = init;
+	entry->pending = 1;
+}
+
+/**
+ * @brief Cancelar una inicialización diferida pendiente
+ * @param[in] entry Objeto de la inicialización diferida
+ */
+void hal_startup_deferred_cancel(hal_startup_deferred_t *entry)
+{
+	entry->pending = 0;
+}
+
+/**
+ * @brief Asegurar que una inicialización diferida se haya ejecutado
+ *
+ * Si la inicialización está pendiente, se ejecuta en este llamado.
+ *
+ * @param[in] entry Objeto de la inicialización diferida
+ */
+void hal_startup_deferred_require(hal_startup_deferred_t *entry)
+{
+	if(entry->pending)
+	{
+		entry->pending = 0;
+		entry->init();
+	}
+}
+
+/**
+ * @brief Ejecutar la siguiente inicialización diferida pendiente
+ * @return Distinto de cero si se ejecutó alguna inicialización, cero si no había ninguna pendiente
+ */
+uint8_t hal_startup_deferred_run_next(void)
+{
+	hal_startup_deferred_t *entry;
+
+	for(entry = deferred_head; entry != NULL; entry = entry->next)
+	{
+		if(entry->pending)
+		{
+			hal_startup_deferred_require(entry);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+#if defined (HAL_STARTUP_ENABLE)
+
+#if defined (__cplusplus)
+extern "C" {
+	extern void __libc_init_array(void);
+}
+#endif
+
+/** Atributo para handlers por defecto reemplazables por la aplicación */
+#define		STARTUP_ALIAS(f)		__attribute__ ((weak, alias (#f)))
+
+/** Sección de los handlers del código de arranque, a continuación de la tabla de vectores */
+#define		STARTUP_SECTION			__attribute__ ((section(".after_vectors")))
+
+#ifdef __USE_ROMDIVIDE
+/** Dirección de memoria que contiene la dirección de la tabla de drivers en ROM */
+#define		PTR_ROM_DRIVER_TABLE	((uint32_t *) (0x0F001FF8))
+
+unsigned int *pDivRom_idiv; //!< Dirección de la división con signo en ROM (utilizada por aeabi_romdiv_patch.s)
+unsigned int *pDivRom_uidiv; //!< Dirección de la división sin signo en ROM (utilizada por aeabi_romdiv_patch.s)
+#endif
+
+void ResetISR(void);
+void IntDefaultHandler(void);
+
+void NMI_Handler(void) STARTUP_ALIAS(IntDefaultHandler);
+void HardFault_Handler(void) STARTUP_ALIAS(IntDefaultHandler);
+void SVC_Handler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PendSV_Handler(void) STARTUP_ALIAS(IntDefaultHandler);
+void SysTick_Handler(void) STARTUP_ALIAS(IntDefaultHandler);
+void SPI0_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void SPI1_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void DAC0_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void UART0_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void UART1_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void UART2_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void FAIM_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void I2C1_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void I2C0_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void SCT_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void MRT_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void CMP_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void WDT_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void BOD_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void FLASH_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void WKT_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void ADC_SEQA_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void ADC_SEQB_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void ADC_THCMP_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void ADC_OVR_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void DMA_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void I2C2_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void I2C3_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void CTIMER0_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT0_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT1_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT2_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT3_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT4_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT5_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT6_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+void PININT7_IRQHandler(void) STARTUP_ALIAS(IntDefaultHandler);
+
+#if defined (__REDLIB__)
+extern void __main(void);
+#else
+extern int main(void);
+#endif
+
+extern void _vStackTop(void); //!< Tope del stack, definido por el linker script
+
+__attribute__ ((weak)) extern void __valid_user_code_checksum(); //!< Checksum de la tabla, calculado por el linker
+
+/*
+ * Tabla de secciones generada por el managed linker script. Para cada sección de datos contiene la dirección de
+ * carga, la dirección de ejecución y el largo. Para cada sección bss contiene la dirección y el largo.
+ */
+extern uint32_t __data_section_table;
+extern uint32_t __data_section_table_end;
+extern uint32_t __bss_section_table;
+extern uint32_t __bss_section_table_end;
+
+/** Tabla de vectores */
+__attribute__ ((used, section(".isr_vector")))
+void (* const g_pfnVectors[])(void) = {
+	// Núcleo Cortex-M0+
+	&_vStackTop,
+	ResetISR,
+	NMI_Handler,
+	HardFault_Handler,
+	0,
+	0,
+	0,
+	__valid_user_code_checksum,
+	0,
+	0,
+	0,
+	SVC_Handler,
+	0,
+	0,
+	PendSV_Handler,
+	SysTick_Handler,
+
+	// Periféricos LPC845
+	SPI0_IRQHandler,
+	SPI1_IRQHandler,
+	DAC0_IRQHandler,
+	UART0_IRQHandler,
+	UART1_IRQHandler,
+	UART2_IRQHandler,
+	FAIM_IRQHandler,
+	I2C1_IRQHandler,
+	I2C0_IRQHandler,
+	SCT_IRQHandler,
+	MRT_IRQHandler,
+	CMP_IRQHandler,
+	WDT_IRQHandler,
+	BOD_IRQHandler,
+	FLASH_IRQHandler,
+	WKT_IRQHandler,
+	ADC_SEQA_IRQHandler,
+	ADC_SEQB_IRQHandler,
+	ADC_THCMP_IRQHandler,
+	ADC_OVR_IRQHandler,
+	DMA_IRQHandler,
+	I2C2_IRQHandler,
+	I2C3_IRQHandler,
+	CTIMER0_IRQHandler,
+	PININT0_IRQHandler,
+	PININT1_IRQHandler,
+	PININT2_IRQHandler,
+	PININT3_IRQHandler,
+	PININT4_IRQHandler,
+	PININT5_IRQHandler, // Compartida con DAC1
+	PININT6_IRQHandler, // Compartida con USART3
+	PININT7_IRQHandler // Compartida con USART4
+};
+
+/**
+ * @brief Copiar una sección de datos de flash a RAM
+ *
+ * La copia se hace de a 4 palabras por iteración, y el resto palabra por palabra. Los largos de las secciones
+ * generadas por el linker son siempre múltiplos de 4 bytes.
+ *
+ * @param[in] src Dirección de carga
+ * @param[out] dst Dirección de ejecución
+ * @param[in] len Largo de la sección en bytes
+ */
+STARTUP_SECTION static void startup_data_init(const uint32_t *src, uint32_t *dst, uint32_t len)
+{
+	uint32_t words = len >> 2;
+
+	if(src == dst)
+	{
+		return;
+	}
+
+	while(words >= 4)
+	{
+		uint32_t w0 = src[0];
+		uint32_t w1 = src[1];
+		uint32_t w2 = src[2];
+		uint32_t w3 = src[3];
+
+		dst[0] = w0;
+		dst[1] = w1;
+		dst[2] = w2;
+		dst[3] = w3;
+
+		src += 4;
+		dst += 4;
+		words -= 4;
+	}
+
+	while(words--)
+	{
+		*dst++ = *src++;
+	}
+}
+
+/**
+ * @brief Poner en cero una sección bss
+ * @param[out] dst Dirección de la sección
+ * @param[in] len Largo de la sección en bytes
+ */
+STARTUP_SECTION static void startup_bss_init(uint32_t *dst, uint32_t len)
+{
+	uint32_t words = len >> 2;
+
+	while(words >= 4)
+	{
+		dst[0] = 0;
+		dst[1] = 0;
+		dst[2] = 0;
+		dst[3] = 0;
+
+		dst += 4;
+		words -= 4;
+	}
+
+	while(words--)
+	{
+		*dst++ = 0;
+	}
+}
+
+/**
+ * @brief Punto de entrada luego de un reset
+ */
+STARTUP_SECTION void ResetISR(void)
+{
+	uint32_t *section_table = &__data_section_table;
+
+	while(section_table < &__data_section_table_end)
+	{
+		const uint32_t *load_addr = (const uint32_t *) section_table[0];
+		uint32_t *exe_addr = (uint32_t *) section_table[1];
+
+		startup_data_init(load_addr, exe_addr, section_table[2]);
+		section_table += 3;
+	}
+
+	// Las secciones .noinit no figuran en esta tabla, por lo que no se ponen en cero
+	while(section_table < &__bss_section_table_end)
+	{
+		startup_bss_init((uint32_t *) section_table[0], section_table[1]);
+		section_table += 2;
+	}
+
+#ifdef __USE_ROMDIVIDE
+	{
+		uint32_t *div_ptr = (uint32_t *) ((uint32_t *) *(PTR_ROM_DRIVER_TABLE))[4];
+
+		pDivRom_idiv = (unsigned int *) div_ptr[0];
+		pDivRom_uidiv = (unsigned int *) div_ptr[1];
+	}
+#endif
+
+	hal_startup_early_init();
+
+#if defined (__cplusplus)
+	__libc_init_array();
+#endif
+
+#if defined (__REDLIB__)
+	__main();
+#else
+	main();
+#endif
+
+	while(1);
+}
+
+/**
+ * @brief Handler por defecto para excepciones e interrupciones no definidas por la aplicación
+ */
+STARTUP_SECTION void IntDefaultHandler(void)
+{
+	while(1);
+}
+
+#endif /* HAL_STARTUP_ENABLE */
@@ -7,6 +7,8 @@
  */
 
 #include <HAL_SYSCON.h>
+#include <HAL_DIV.h>
+#include <HAL_STARTUP.h>
 #include <HPL_SYSCON.h>
 #include <HPL_IOCON.h>
 #include <HPL_SWM.h>
@@ -37,6 +39,12 @@ static uint32_t current_watchdog_freq = 0; //!< Frecuencia del watchod oscillato
 
 static uint32_t *current_main_freq = &current_fro_freq; //!< Frecuencia actual del main clock
 
+static hal_startup_deferred_t crystal_settle; //!< Estabilización del cristal diferida hasta el primer uso
+static uint32_t pending_crystal_freq = 0; //!< Frecuencia del cristal en proceso de estabilización
+
+static void hal_syscon_external_crystal_settle(void);
+static uint32_t hal_syscon_frg_source_freq(hal_syscon_frg_clock_sel_en clock_source);
+
 static const uint32_t base_watchdog_freq[] = //!< Frecuencias bases posibles del watchod oscillator
 {
 	0, 0.6e6, 1.05e6, 1.4e6, 1.75e6, 2.1e6, 2.4e6, 2.7e6,
@@ -49,7 +57,12 @@ static const uint32_t base_watchdog_freq[] = //!< Frecuencias bases posibles del
  */
 uint32_t hal_syscon_system_clock_get(void)
 {
-	return (*current_main_freq) / current_main_div;
+	if(current_main_div == 0)
+	{
+		return 0;
+	}
+
+	return hal_div_unsigned(*current_main_freq, current_main_div);
 }
 
 /**
@@ -58,6 +71,11 @@ uint32_t hal_syscon_system_clock_get(void)
  */
 void hal_syscon_system_clock_set_source(hal_syscon_system_clock_sel_en clock_source)
 {
+	if(clock_source == HAL_SYSCON_SYSTEM_CLOCK_SEL_EXT)
+	{
+		hal_startup_deferred_require(&crystal_settle);
+	}
+
 	SYSCON_set_system_clock_source(clock_source);
 
 	switch(clock_source)
@@ -103,12 +121,28 @@ uint32_t hal_syscon_fro_clock_get(void)
 
 /**
  * @brief Configurar el ext clock a partir de un cristal externo
+ *
+ * Espera la estabilización del cristal antes de retornar.
+ *
  * @param[in] crystal_freq Frecuencia del cristal externo utilizado
  */
 void hal_syscon_external_crystal_config(uint32_t crystal_freq)
 {
-	uint8_t counter;
+	hal_syscon_external_crystal_start(crystal_freq);
+	hal_startup_deferred_require(&crystal_settle);
+}
 
+/**
+ * @brief Encender el oscilador del cristal externo sin esperar su estabilización
+ *
+ * La estabilización y la selección del cristal como ext clock quedan registradas como inicialización diferida (ver
+ * @ref STARTUP), la cual se completa al seleccionar el ext clock como fuente de un clock, o antes si la aplicación
+ * llama a @ref hal_startup_deferred_run_next.
+ *
+ * @param[in] crystal_freq Frecuencia del cristal externo utilizado
+ */
+void hal_syscon_external_crystal_start(uint32_t crystal_freq)
+{
 	// Remocion de pull ups en los pines XTAL
 	IOCON_init();
 	IOCON_config_pull_mode(XTALIN_PORT, XTALIN_PIN, IOCON_PULL_NONE);
@@ -131,11 +165,8 @@ void hal_syscon_external_crystal_config(uint32_t crystal_freq)
 
 	SYSCON_power_up_peripheral(SYSCON_POWER_SEL_SYSOSC);
 
-	counter = crystal_freq / 100; // Delay de aprox 1mseg a lo guaso
-	while(counter) counter--; // Estabilizacion del cristal
-
-	SYSCON_ext_clock_source_set(SYSCON_EXT_CLOCK_SOURCE_SEL_CRYSTAL);
-	current_crystal_freq = crystal_freq;
+	pending_crystal_freq = crystal_freq;
+	hal_startup_deferred_register(&crystal_settle, hal_syscon_external_crystal_settle);
 }
 
 /**
@@ -192,6 +223,11 @@ void hal_syscon_fro_clock_disable(void)
  */
 void hal_syscon_clkout_config(hal_gpio_portpin_en portpin, hal_syscon_clkout_source_sel_en clock_source, uint8_t divider)
 {
+	if(clock_source == HAL_SYSCON_CLKOUT_SOURCE_SEL_EXT_CLOCK)
+	{
+		hal_startup_deferred_require(&crystal_settle);
+	}
+
 	SYSCON_set_clkout_config(clock_source, divider);
 
 	SWM_init();
@@ -210,19 +246,24 @@ void hal_syscon_clkout_config(hal_gpio_portpin_en portpin, hal_syscon_clkout_sou
  */
 void hal_syscon_frg_config(uint8_t inst, hal_syscon_frg_clock_sel_en clock_source, uint32_t mul)
 {
-	uint32_t aux_freq;
+	hal_div_unsigned_result_t aux;
 
 	SYSCON_set_frg_config(inst, clock_source, mul, 0xFF);
 
-	switch(clock_source)
-	{
-	case HAL_SYSCON_FRG_CLOCK_SEL_FRO: { aux_freq = current_fro_freq; break; }
-	case HAL_SYSCON_FRG_CLOCK_SEL_MAIN_CLOCK: { aux_freq = *current_main_freq; break; }
-	case HAL_SYSCON_FRG_CLOCK_SEL_NONE: { aux_freq = 0; break; }
-	case HAL_SYSCON_FRG_CLOCK_SEL_SYS_PLL: { aux_freq = current_pll_freq; break; }
-	}
+	// Frecuencia de salida: entrada * 256 / (256 + mul), sin exceder 32 bits en los calculos intermedios
+	aux = hal_div_unsigned_divmod(hal_syscon_frg_source_freq(clock_source), 256 + mul);
+
+	current_frg_freq[inst] = (aux.quot * 256) + hal_div_unsigned(aux.rem * 256, 256 + mul);
+}
 
-	current_frg_freq[inst] = (uint32_t) (aux_freq / (1 + ((float) mul / 256)));
+/**
+ * @brief Obtener la frecuencia de entrada de un divisor fraccional
+ * @param[in] inst Instancia de FRG a consultar
+ * @return Frecuencia en Hz de la fuente de clock seleccionada para el FRG
+ */
+uint32_t hal_syscon_frg_input_clock_get(uint8_t inst)
+{
+	return hal_syscon_frg_source_freq((hal_syscon_frg_clock_sel_en) SYSCON_get_frg_clock_source(inst));
 }
 
 /**
@@ -236,7 +277,16 @@ void hal_syscon_watchdog_oscillator_config(hal_syscon_watchdog_clkana_sel_en clk
 {
 	SYSCON_set_watchdog_oscillator_control(div, clkana_sel);
 
-	current_watchdog_freq = base_watchdog_freq[clkana_sel] / (2 * (1 + div));
+	current_watchdog_freq = hal_div_unsigned(base_watchdog_freq[clkana_sel], 2 * (1 + div));
+}
+
+/**
+ * @brief Obtener la frecuencia configurada del watchdog oscillator
+ * @return Frecuencia nominal en Hz del watchdog oscillator, o cero si no fue configurado
+ */
+uint32_t hal_syscon_watchdog_oscillator_get(void)
+{
+	return current_watchdog_freq;
 }
 
 /**
@@ -290,3 +340,37 @@ uint32_t hal_syscon_pll_clock_get(void)
 {
 	return current_pll_freq;
 }
+
+/**
+ * @brief Esperar la estabilización del cristal externo y seleccionarlo como ext clock
+ */
+static void hal_syscon_external_crystal_settle(void)
+{
+	uint8_t counter;
+
+	counter = pending_crystal_freq / 100; // Delay de aprox 1mseg a lo guaso
+	while(counter) counter--; // Estabilizacion del cristal
+
+	SYSCON_ext_clock_source_set(SYSCON_EXT_CLOCK_SOURCE_SEL_CRYSTAL);
+	current_crystal_freq = pending_crystal_freq;
+}
+
+/**
+ * @brief Obtener la frecuencia de una fuente de clock de los divisores fraccionales
+ * @param[in] clock_source Fuente de clock
+ * @return Frecuencia en Hz de la fuente
+ */
+static uint32_t hal_syscon_frg_source_freq(hal_syscon_frg_clock_sel_en clock_source)
+{
+	uint32_t ret = 0;
+
+	switch(clock_source)
+	{
+	case HAL_SYSCON_FRG_CLOCK_SEL_FRO: { ret = current_fro_freq; break; }
+	case HAL_SYSCON_FRG_CLOCK_SEL_MAIN_CLOCK: { ret = *current_main_freq; break; }
+	case HAL_SYSCON_FRG_CLOCK_SEL_NONE: { ret = 0; break; }
+	case HAL_SYSCON_FRG_CLOCK_SEL_SYS_PLL: { ret = current_pll_freq; break; }
+	}
+
+	return ret;
+}
@@ -9,6 +9,8 @@
 #include <stddef.h>
 #include <HAL_SYSTICK.h>
 #include <HAL_SYSCON.h>
+#include <HAL_DIV.h>
+#include <HAL_RAMFUNC.h>
 #include <HPL_SYSTICK.h>
 
 static void dummy_irq(void);
@@ -22,12 +24,12 @@ static void (*systick_callback)(void) = dummy_irq; //!< Callback a llamar en la
  */
 void hal_systick_init(uint32_t tick_us, void (*callback)(void))
 {
-	float aux_f;
+	uint64_t aux_64;
 	uint32_t aux;
 
 	// En base a los us deseados calculo el valor de STRELOAD
-	aux_f = ((float) hal_syscon_system_clock_get()) * ((float) tick_us);
-	aux = aux_f / 1e6;
+	aux_64 = hal_div_unsigned_64((uint64_t) hal_syscon_system_clock_get() * tick_us, 1000000);
+	aux = (aux_64 > (1 << 24)) ? (1 << 24) : (uint32_t) aux_64;
 
 	aux--;
 
@@ -87,7 +89,7 @@ void hal_systick_inhibit_clear(void)
 /**
  * @brief Interrupcion de SYSTICK
  */
-void SysTick_Handler(void)
+HAL_RAMFUNC void SysTick_Handler(void)
 {
 	systick_callback();
 }
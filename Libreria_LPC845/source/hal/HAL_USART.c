@@ -9,6 +9,10 @@
 #include <stddef.h>
 #include <HAL_SYSCON.h>
 #include <HAL_USART.h>
+#include <HAL_DIV.h>
+#include <HAL_MRT.h>
+#include <HAL_RAMFUNC.h>
+#include <HPL_MRT.h>
 #include <HPL_NVIC.h>
 #include <HPL_SWM.h>
 #include <HPL_SYSCON.h>
@@ -50,7 +54,59 @@ static void *usart_tx_data[] = { //!< Datos registrados a la transmision de un d
 		NULL
 };
 
+/** Estado del modo RS-485 de una instancia */
+typedef struct
+{
+	uint8_t enabled; /**< Distinto de cero si la instancia esta en modo RS-485 */
+	uint8_t address; /**< Direccion propia */
+	uint8_t addressed; /**< Distinto de cero si se recibio la direccion propia */
+	uint8_t rx_pending; /**< Distinto de cero si rx_data todavia no fue leido por el callback */
+	uint32_t rx_data; /**< Ultimo dato recibido, leido por la rutina de interrupcion */
+	hal_usart_rs485_stats_t stats; /**< Contadores de trafico */
+}hal_usart_rs485_t;
+
+static hal_usart_rs485_t usart_rs485[HAL_USART_SEL_AMOUNT]; //!< Estado del modo RS-485 de cada instancia
+
+/** Valor de usart_rx_idle_owner para un canal del MRT libre */
+#define		HAL_USART_RX_IDLE_NO_OWNER		0xFF
+
+/** Estado de la recepcion de tramas delimitadas por silencio de una instancia */
+typedef struct
+{
+	uint8_t enabled; /**< Distinto de cero si la instancia recibe de a tramas */
+	uint8_t channel; /**< Canal del MRT utilizado */
+	uint8_t *buffer; /**< Buffer de la trama */
+	uint32_t size; /**< Tamaño del buffer */
+	uint32_t length; /**< Cantidad de datos recibidos de la trama en curso */
+	uint8_t overflow; /**< Distinto de cero si la trama en curso excedio el buffer */
+	uint32_t timeout_ticks; /**< Tiempo de silencio en ciclos del clock del sistema */
+	hal_usart_rx_frame_callback callback; /**< Callback de trama completa */
+	void *data; /**< Datos a pasar al callback */
+}hal_usart_rx_idle_t;
+
+static hal_usart_rx_idle_t usart_rx_idle[HAL_USART_SEL_AMOUNT]; //!< Estado de la recepcion de a tramas de cada instancia
+
+static uint8_t usart_rx_idle_owner[HAL_MRT_CHANNEL_AMOUNT] = { //!< Instancia que utiliza cada canal del MRT
+		HAL_USART_RX_IDLE_NO_OWNER,
+		HAL_USART_RX_IDLE_NO_OWNER,
+		HAL_USART_RX_IDLE_NO_OWNER,
+		HAL_USART_RX_IDLE_NO_OWNER
+};
+
+/** Máximo producto (OSRVAL + 1) * (BRGVAL + 1) evaluado por el cálculo de baudrate */
+#define		HAL_USART_BAUD_MAX_DIVIDER		(1 << 19)
+
+/** Cantidad de valores de BRGVAL evaluados por cada oversampling cuando se utiliza un FRG */
+#define		HAL_USART_BAUD_FRG_CANDIDATES	64
+
 static inline uint16_t hal_usart_calculate_brgval(uint32_t usart_clock, uint32_t baudrate, uint8_t oversampling);
+static uint32_t hal_usart_scaled_div(uint32_t numerator, uint32_t denominator, uint8_t nibbles);
+static uint32_t hal_usart_error_ppm(uint32_t error, uint32_t baudrate);
+static uint8_t hal_usart_frg_shared(hal_usart_sel_en inst, SYSCON_peripheral_clock_sel_en clock_source);
+static void hal_usart_rs485_handle_rx(uint8_t inst);
+static void hal_usart_rx_idle_store(uint8_t inst, uint32_t data);
+static void hal_usart_rx_idle_timeout(uint8_t inst);
+static void hal_usart_rx_idle_mrt_callback(uint8_t channel);
 static void hal_usart_handle_irq(uint8_t inst);
 
 static const SYSCON_peripheral_sel_en USART_SYSCON_PER[] = {
@@ -87,6 +143,7 @@ static const NVIC_irq_sel_en USART_NVICS[] = {
 
 void hal_usart_init(hal_usart_sel_en inst, const hal_usart_config_t * config)
 {
+	hal_usart_oversampling_en oversampling = config->oversampling;
 	uint32_t aux;
 
 	SWM_init();
@@ -105,19 +162,32 @@ void hal_usart_init(hal_usart_sel_en inst, const hal_usart_config_t * config)
 
 	SYSCON_set_peripheral_clock_source(USART_SYSCON_PER[inst], config->clock_selection);
 
-	aux = hal_usart_calculate_brgval(hal_syscon_peripheral_clock_get(USART_SYSCON_PER[inst]),
-									config->baudrate,
-									config->oversampling);
-
 	SYSCON_enable_clock(USART_SYSCON_CLOCK_ENABLE[inst]);
 	SYSCON_clear_reset(USART_SYSCON_RESET_SEL[inst]);
 	NVIC_enable_interrupt(USART_NVICS[inst]);
 
-	USART_set_OSRVAL(inst, config->oversampling);
+	if(oversampling == HAL_USART_OVERSAMPLING_AUTO)
+	{
+		if(hal_usart_baud_config(inst, config->baudrate, 0xFFFFFFFF, NULL) != HAL_USART_BAUD_RESULT_OK)
+		{
+			// Sin solucion en el calculo automatico, se utiliza el oversampling por defecto del periferico
+			oversampling = HAL_USART_OVERSAMPLING_X16;
+		}
+	}
+
+	if(oversampling != HAL_USART_OVERSAMPLING_AUTO)
+	{
+		aux = hal_usart_calculate_brgval(hal_syscon_peripheral_clock_get(USART_SYSCON_PER[inst]),
+										config->baudrate,
+										oversampling);
+
+		USART_set_OSRVAL(inst, oversampling);
+		USART_set_BRGVAL(inst, aux);
+	}
+
 	USART_config_data_length(inst, config->data_length);
 	USART_config_parity(inst, config->parity);
 	USART_config_stop_bits(inst, config->stop_bits);
-	USART_set_BRGVAL(inst, aux);
 
 	// Las interrupciones de TX se habilitaran cuando se envie algun byte
 
@@ -143,6 +213,11 @@ hal_usart_tx_result hal_usart_tx_data(hal_usart_sel_en inst, uint32_t data)
 		// Escribo data
 		USART_write_data(inst, data);
 
+		if(usart_rs485[inst].enabled)
+		{
+			usart_rs485[inst].stats.tx_bytes++;
+		}
+
 		if(usart_tx_callback[inst] != dummy_callback)
 		{
 			// Habilito interrupciones de TXRDY unicamente si se paso un callback
@@ -159,7 +234,13 @@ hal_usart_tx_result hal_usart_tx_data(hal_usart_sel_en inst, uint32_t data)
 
 hal_usart_rx_result hal_usart_rx_data(hal_usart_sel_en inst, uint32_t *data)
 {
-	if(USART_get_flag_RXRDY(inst))
+	if(usart_rs485[inst].rx_pending)
+	{
+		// En modo RS-485 el dato ya fue leido por la rutina de interrupcion
+		*data = usart_rs485[inst].rx_data;
+		usart_rs485[inst].rx_pending = 0;
+	}
+	else if(USART_get_flag_RXRDY(inst))
 	{
 		*data = USART_get_data(inst);
 	}
@@ -210,6 +291,386 @@ void hal_usart_tx_register_callback(hal_usart_sel_en inst, hal_usart_tx_callback
 	}
 }
 
+hal_usart_baud_result_en hal_usart_baud_solve(uint32_t input_clock, uint32_t baudrate, uint8_t use_frg, hal_usart_baud_t *solution)
+{
+	uint32_t best_error = 0xFFFFFFFF;
+	uint32_t osr;
+
+	if((baudrate == 0) || (hal_div_unsigned(input_clock, 5) < baudrate))
+	{
+		return HAL_USART_BAUD_RESULT_INVALID;
+	}
+
+	// A igual error se conserva la primera solucion encontrada, es decir la de mayor oversampling
+	for(osr = 16; (osr >= 5) && (best_error != 0); osr--)
+	{
+		uint32_t bit_clock = baudrate * osr;
+		uint32_t first;
+		uint32_t last;
+		uint32_t brg;
+
+		if(use_frg)
+		{
+			// El FRG divide entre 1 y 511/256, por lo que (BRGVAL + 1) queda entre clock / (2 * bit_clock) y
+			// clock / bit_clock. Los valores mas chicos dejan mas resolucion al multiplicador
+			first = hal_div_unsigned(input_clock + (2 * bit_clock) - 1, 2 * bit_clock);
+			last = hal_div_unsigned(input_clock, bit_clock);
+
+			if(last >= (first + HAL_USART_BAUD_FRG_CANDIDATES))
+			{
+				last = first + HAL_USART_BAUD_FRG_CANDIDATES - 1;
+			}
+		}
+		else
+		{
+			first = hal_div_unsigned(input_clock + (bit_clock / 2), bit_clock);
+			last = first;
+		}
+
+		if(first == 0)
+		{
+			first = 1;
+		}
+
+		if(last > 65536)
+		{
+			last = 65536;
+		}
+
+		for(brg = first; (brg <= last) && ((osr * brg) < HAL_USART_BAUD_MAX_DIVIDER); brg++)
+		{
+			uint32_t frg_div = 256;
+			uint32_t achieved;
+			uint32_t error;
+
+			if(use_frg)
+			{
+				// Divisor ideal del FRG (256 + MULT), redondeado y limitado al rango del registro
+				frg_div = hal_usart_scaled_div(input_clock, bit_clock * brg, 2);
+
+				if(frg_div < 256)
+				{
+					frg_div = 256;
+				}
+				else if(frg_div > 511)
+				{
+					frg_div = 511;
+				}
+			}
+
+			// Baudrate obtenido y error en 1/256 bps, para distinguir soluciones a baudrates bajos
+			achieved = hal_usart_scaled_div(input_clock, frg_div * osr * brg, 4);
+			error = (achieved > (baudrate * 256)) ? (achieved - (baudrate * 256)) : ((baudrate * 256) - achieved);
+
+			if(error < best_error)
+			{
+				best_error = error;
+
+				solution->baudrate = (achieved + 128) / 256;
+				solution->brgval = brg - 1;
+				solution->oversampling = (hal_usart_oversampling_en) (osr - 1);
+				solution->frg_mul = frg_div - 256;
+			}
+		}
+	}
+
+	if(best_error == 0xFFFFFFFF)
+	{
+		return HAL_USART_BAUD_RESULT_INVALID;
+	}
+
+	solution->error_ppm = hal_usart_error_ppm(best_error, baudrate);
+
+	return HAL_USART_BAUD_RESULT_OK;
+}
+
+hal_usart_baud_result_en hal_usart_baud_config(hal_usart_sel_en inst, uint32_t baudrate, uint32_t max_error_ppm, hal_usart_baud_t *solution)
+{
+	SYSCON_peripheral_clock_sel_en clock_source = SYSCON_get_peripheral_clock_source(USART_SYSCON_PER[inst]);
+	hal_usart_baud_result_en result;
+	hal_usart_baud_t aux;
+	uint8_t use_frg = 0;
+	uint8_t frg_fixed = 0;
+	uint8_t frg = 0;
+	uint32_t input_clock;
+	uint8_t enabled;
+
+	if((clock_source == SYSCON_PERIPHERAL_CLOCK_SEL_FRG0) || (clock_source == SYSCON_PERIPHERAL_CLOCK_SEL_FRG1))
+	{
+		frg = clock_source - SYSCON_PERIPHERAL_CLOCK_SEL_FRG0;
+
+		// Si otra instancia habilitada utiliza el mismo FRG, su multiplicador no puede modificarse
+		frg_fixed = hal_usart_frg_shared(inst, clock_source);
+		use_frg = !frg_fixed;
+	}
+
+	if(use_frg)
+	{
+		input_clock = hal_syscon_frg_input_clock_get(frg);
+	}
+	else
+	{
+		input_clock = hal_syscon_peripheral_clock_get(USART_SYSCON_PER[inst]);
+	}
+
+	result = hal_usart_baud_solve(input_clock, baudrate, use_frg, &aux);
+
+	if((result == HAL_USART_BAUD_RESULT_OK) && frg_fixed)
+	{
+		aux.frg_mul = SYSCON_get_frg_mul(frg);
+	}
+
+	if((result == HAL_USART_BAUD_RESULT_OK) && (aux.error_ppm > max_error_ppm))
+	{
+		result = HAL_USART_BAUD_RESULT_ERROR_TOO_HIGH;
+	}
+
+	if(result == HAL_USART_BAUD_RESULT_OK)
+	{
+		enabled = USART_get_enable(inst);
+
+		if(enabled)
+		{
+			// No se corta la trama en curso
+			while(!USART_get_flag_TXIDLE(inst));
+
+			USART_disable(inst);
+		}
+
+		if(use_frg)
+		{
+			hal_syscon_frg_config(frg, (hal_syscon_frg_clock_sel_en) SYSCON_get_frg_clock_source(frg), aux.frg_mul);
+		}
+
+		USART_set_OSRVAL(inst, aux.oversampling);
+		USART_set_BRGVAL(inst, aux.brgval);
+
+		if(enabled)
+		{
+			USART_enable(inst);
+		}
+	}
+
+	if((solution != NULL) && (result != HAL_USART_BAUD_RESULT_INVALID))
+	{
+		*solution = aux;
+	}
+
+	return result;
+}
+
+hal_usart_rs485_result_en hal_usart_rs485_init(hal_usart_sel_en inst, const hal_usart_rs485_config_t *config)
+{
+	if(config->oe_portpin != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		if(inst > HAL_USART_SEL_2)
+		{
+			return HAL_USART_RS485_RESULT_NO_OE;
+		}
+
+		SWM_init();
+		SWM_assign_uart_RTS(inst, HAL_GPIO_PORTPIN_TO_PORT(config->oe_portpin), HAL_GPIO_PORTPIN_TO_PIN(config->oe_portpin));
+		SWM_deinit();
+	}
+
+	// No se corta la trama en curso
+	while(!USART_get_flag_TXIDLE(inst));
+
+	USART_disable(inst);
+
+	USART_config_data_length(inst, USART_DATALEN_9BIT);
+
+	if(config->oe_portpin != HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		USART_config_OEPOL(inst, (USART_output_enable_pol_en) config->oe_polarity);
+		USART_enable_OESEL(inst);
+	}
+	else
+	{
+		USART_disable_OESEL(inst);
+	}
+
+	if(config->turnaround)
+	{
+		USART_enable_OETA(inst);
+	}
+	else
+	{
+		USART_disable_OETA(inst);
+	}
+
+	NVIC_disable_interrupt(USART_NVICS[inst]);
+
+	usart_rs485[inst].enabled = 1;
+	usart_rs485[inst].address = config->address;
+	usart_rs485[inst].addressed = 0;
+	usart_rs485[inst].rx_pending = 0;
+	hal_usart_rs485_stats_clear(inst);
+
+	NVIC_enable_interrupt(USART_NVICS[inst]);
+
+	USART_set_address(inst, config->address);
+	USART_enable_auto_address(inst);
+	USART_enable_address_detect(inst);
+
+	// La comparacion de direcciones se resuelve en la interrupcion de recepcion
+	USART_enable_irq_RXRDY(inst);
+
+	USART_enable(inst);
+
+	return HAL_USART_RS485_RESULT_OK;
+}
+
+hal_usart_tx_result hal_usart_rs485_tx_address(hal_usart_sel_en inst, uint8_t address)
+{
+	if(!USART_get_flag_TXRDY(inst))
+	{
+		return HAL_USART_TX_RESULT_NOT_READY;
+	}
+
+	USART_write_data(inst, HAL_USART_RS485_ADDRESS_FLAG | address);
+
+	usart_rs485[inst].stats.tx_frames++;
+
+	if(usart_tx_callback[inst] != dummy_callback)
+	{
+		USART_enable_irq_TXRDY(inst);
+	}
+
+	return HAL_USART_TX_RESULT_OK;
+}
+
+void hal_usart_rs485_listen(hal_usart_sel_en inst)
+{
+	usart_rs485[inst].addressed = 0;
+	USART_enable_address_detect(inst);
+}
+
+uint8_t hal_usart_rs485_is_addressed(hal_usart_sel_en inst)
+{
+	return usart_rs485[inst].addressed;
+}
+
+uint8_t hal_usart_rs485_tx_idle(hal_usart_sel_en inst)
+{
+	return USART_get_flag_TXIDLE(inst);
+}
+
+void hal_usart_rs485_stats_get(hal_usart_sel_en inst, hal_usart_rs485_stats_t *stats)
+{
+	uint8_t irq_enabled = NVIC_get_enabled_interrupt(USART_NVICS[inst]);
+
+	// Los contadores se actualizan desde la interrupcion, que se restaura a su estado previo
+	NVIC_disable_interrupt(USART_NVICS[inst]);
+
+	*stats = usart_rs485[inst].stats;
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(USART_NVICS[inst]);
+	}
+}
+
+void hal_usart_rs485_stats_clear(hal_usart_sel_en inst)
+{
+	uint8_t irq_enabled = NVIC_get_enabled_interrupt(USART_NVICS[inst]);
+
+	NVIC_disable_interrupt(USART_NVICS[inst]);
+
+	usart_rs485[inst].stats.rx_frames = 0;
+	usart_rs485[inst].stats.rx_bytes = 0;
+	usart_rs485[inst].stats.rx_errors = 0;
+	usart_rs485[inst].stats.foreign_frames = 0;
+	usart_rs485[inst].stats.tx_frames = 0;
+	usart_rs485[inst].stats.tx_bytes = 0;
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(USART_NVICS[inst]);
+	}
+}
+
+hal_usart_rx_idle_result_en hal_usart_rx_idle_init(hal_usart_sel_en inst, const hal_usart_rx_idle_config_t *config)
+{
+	uint32_t usart_clock;
+	uint32_t baudrate;
+	uint32_t bit_ticks;
+
+	if((config->buffer == NULL) || (config->size == 0) || (config->frame_callback == NULL) ||
+		(config->timeout_bits == 0) || (config->mrt_channel >= HAL_MRT_CHANNEL_AMOUNT))
+	{
+		return HAL_USART_RX_IDLE_RESULT_INVALID;
+	}
+
+	if((usart_rx_idle_owner[config->mrt_channel] != HAL_USART_RX_IDLE_NO_OWNER) &&
+		(usart_rx_idle_owner[config->mrt_channel] != inst))
+	{
+		return HAL_USART_RX_IDLE_RESULT_CHANNEL_BUSY;
+	}
+
+	// Baudrate efectivo a partir de la configuracion actual de la instancia
+	usart_clock = hal_syscon_peripheral_clock_get(USART_SYSCON_PER[inst]);
+	baudrate = hal_div_unsigned(usart_clock, (USART_get_OSRVAL(inst) + 1) * (USART_get_BRGVAL(inst) + 1));
+
+	if(baudrate == 0)
+	{
+		return HAL_USART_RX_IDLE_RESULT_INVALID;
+	}
+
+	bit_ticks = hal_div_unsigned(hal_syscon_system_clock_get() + (baudrate / 2), baudrate);
+
+	hal_usart_rx_idle_deinit(inst);
+
+	// El canal puede estar reservado por otro modulo, por ejemplo por la medicion de latencia del NVIC
+	if(hal_mrt_channel_claim(config->mrt_channel, HAL_MRT_MODE_ONE_SHOT, hal_usart_rx_idle_mrt_callback) != HAL_MRT_RESULT_OK)
+	{
+		return HAL_USART_RX_IDLE_RESULT_CHANNEL_BUSY;
+	}
+
+	NVIC_disable_interrupt(USART_NVICS[inst]);
+
+	usart_rx_idle[inst].channel = config->mrt_channel;
+	usart_rx_idle[inst].buffer = config->buffer;
+	usart_rx_idle[inst].size = config->size;
+	usart_rx_idle[inst].length = 0;
+	usart_rx_idle[inst].overflow = 0;
+	usart_rx_idle[inst].timeout_ticks = config->timeout_bits * bit_ticks;
+	usart_rx_idle[inst].callback = config->frame_callback;
+	usart_rx_idle[inst].data = config->frame_data;
+	usart_rx_idle_owner[config->mrt_channel] = inst;
+
+	usart_rx_idle[inst].enabled = 1;
+
+	USART_enable_irq_RXRDY(inst);
+	NVIC_enable_interrupt(USART_NVICS[inst]);
+
+	return HAL_USART_RX_IDLE_RESULT_OK;
+}
+
+void hal_usart_rx_idle_deinit(hal_usart_sel_en inst)
+{
+	uint8_t channel = usart_rx_idle[inst].channel;
+	uint8_t irq_enabled;
+
+	if(!usart_rx_idle[inst].enabled)
+	{
+		return;
+	}
+
+	irq_enabled = NVIC_get_enabled_interrupt(USART_NVICS[inst]);
+	NVIC_disable_interrupt(USART_NVICS[inst]);
+
+	usart_rx_idle[inst].enabled = 0;
+
+	hal_mrt_channel_release(channel);
+	usart_rx_idle_owner[channel] = HAL_USART_RX_IDLE_NO_OWNER;
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(USART_NVICS[inst]);
+	}
+}
+
 /**
  * @brief Llamado a funcion dummy para irq iniciales
  */
@@ -222,20 +683,211 @@ static void dummy_callback(hal_usart_sel_en d, void *e)
 
 static inline uint16_t hal_usart_calculate_brgval(uint32_t uart_clock, uint32_t baudrate, uint8_t oversampling)
 {
-	return ((uart_clock) / ((oversampling + 1) * baudrate)) - 1;
+	return hal_div_unsigned(uart_clock, (oversampling + 1) * baudrate) - 1;
+}
+
+/**
+ * @brief Calcular (numerator * 16^nibbles) / denominator redondeado, sin exceder 32 bits en los calculos intermedios
+ * @param[in] numerator Numerador
+ * @param[in] denominator Denominador. Debe ser menor a 2^28
+ * @param[in] nibbles Cantidad de pasos de 4 bits de escalado. El resultado debe entrar en 32 bits
+ * @return Resultado redondeado
+ */
+static uint32_t hal_usart_scaled_div(uint32_t numerator, uint32_t denominator, uint8_t nibbles)
+{
+	hal_div_unsigned_result_t aux;
+	uint32_t ret;
+
+	// Division larga, de a 4 bits por paso
+	aux = hal_div_unsigned_divmod(numerator, denominator);
+	ret = aux.quot;
+
+	while(nibbles--)
+	{
+		aux = hal_div_unsigned_divmod(aux.rem * 16, denominator);
+		ret = (ret * 16) + aux.quot;
+	}
+
+	if((aux.rem * 2) >= denominator)
+	{
+		ret++;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Calcular el error relativo en partes por millon
+ * @param[in] error Error absoluto en 1/256 bps
+ * @param[in] baudrate Baudrate pedido
+ * @return Error relativo en partes por millon
+ */
+static uint32_t hal_usart_error_ppm(uint32_t error, uint32_t baudrate)
+{
+	if(error > (0xFFFFFFFF / 15625))
+	{
+		// Errores de este orden no son utilizables, se informan con menor resolucion
+		return hal_div_unsigned(error, hal_div_unsigned((baudrate * 4) + 15624, 15625));
+	}
+
+	// error * 10^6 / (baudrate * 256) = error * 15625 / (baudrate * 4)
+	return hal_div_unsigned(error * 15625, baudrate * 4);
 }
 
-static void hal_usart_handle_irq(uint8_t inst)
+/**
+ * @brief Determinar si otra instancia habilitada utiliza la misma fuente de clock
+ * @param[in] inst Instancia a configurar, excluida de la busqueda
+ * @param[in] clock_source Fuente de clock (FRG) de la instancia
+ * @return Distinto de cero si el FRG esta en uso por otra instancia
+ */
+static uint8_t hal_usart_frg_shared(hal_usart_sel_en inst, SYSCON_peripheral_clock_sel_en clock_source)
+{
+	uint8_t other;
+
+	for(other = 0; other < (sizeof(USART_SYSCON_PER) / sizeof(USART_SYSCON_PER[0])); other++)
+	{
+		// Los registros de una instancia sin clock no se consultan
+		if((other == inst) ||
+			!SYSCON_get_clock_enabled(USART_SYSCON_CLOCK_ENABLE[other]) ||
+			(SYSCON_get_peripheral_clock_source(USART_SYSCON_PER[other]) != clock_source))
+		{
+			continue;
+		}
+
+		if(USART_get_enable(other))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Procesar un dato recibido en modo RS-485
+ *
+ * Con el filtrado por hardware habilitado, solo se recibe la direccion propia. Con el filtrado inhabilitado se
+ * reciben todos los datos, por lo que una direccion ajena marca el fin de la trama propia.
+ *
+ * @param[in] inst Instancia que recibio el dato
+ */
+HAL_RAMFUNC static void hal_usart_rs485_handle_rx(uint8_t inst)
+{
+	hal_usart_rs485_t *rs485 = &usart_rs485[inst];
+	uint8_t frame;
+	uint8_t parity;
+	uint8_t noise;
+	uint32_t data;
+
+	data = USART_get_data_and_status(inst, &frame, &parity, &noise);
+
+	if(frame || parity || noise)
+	{
+		rs485->stats.rx_errors++;
+	}
+
+	if(data & HAL_USART_RS485_ADDRESS_FLAG)
+	{
+		if((data & 0xFF) != rs485->address)
+		{
+			rs485->stats.foreign_frames++;
+			rs485->addressed = 0;
+			USART_enable_address_detect(inst);
+
+			if(usart_rx_idle[inst].enabled && (usart_rx_idle[inst].length != 0))
+			{
+				// La trama propia termino antes del silencio
+				hal_usart_rx_idle_timeout(inst);
+			}
+
+			return;
+		}
+
+		// Direccion propia, se reciben los datos siguientes
+		USART_disable_address_detect(inst);
+		rs485->addressed = 1;
+		rs485->stats.rx_frames++;
+	}
+	else
+	{
+		rs485->stats.rx_bytes++;
+	}
+
+	if(usart_rx_idle[inst].enabled)
+	{
+		hal_usart_rx_idle_store(inst, data);
+		return;
+	}
+
+	rs485->rx_data = data;
+	rs485->rx_pending = 1;
+
+	usart_rx_callback[inst](inst, usart_rx_data[inst]);
+
+	rs485->rx_pending = 0;
+}
+
+/**
+ * @brief Acumular un dato recibido en la trama en curso y recargar el tiempo de silencio
+ * @param[in] inst Instancia que recibio el dato
+ * @param[in] data Dato recibido
+ */
+HAL_RAMFUNC static void hal_usart_rx_idle_store(uint8_t inst, uint32_t data)
+{
+	hal_usart_rx_idle_t *rx_idle = &usart_rx_idle[inst];
+
+	if(rx_idle->length < rx_idle->size)
+	{
+		rx_idle->buffer[rx_idle->length++] = (uint8_t) data;
+	}
+	else
+	{
+		rx_idle->overflow = 1;
+	}
+
+	MRT_set_interval_and_stop_timer(rx_idle->channel, rx_idle->timeout_ticks);
+}
+
+/**
+ * @brief Entregar la trama en curso al callback de trama completa
+ * @param[in] inst Instancia que recibio la trama
+ */
+HAL_RAMFUNC static void hal_usart_rx_idle_timeout(uint8_t inst)
+{
+	hal_usart_rx_idle_t *rx_idle = &usart_rx_idle[inst];
+	uint32_t length = rx_idle->length;
+	uint8_t overflow = rx_idle->overflow;
+
+	MRT_set_interval_and_stop_timer(rx_idle->channel, 0);
+
+	rx_idle->length = 0;
+	rx_idle->overflow = 0;
+
+	rx_idle->callback(inst, rx_idle->buffer, length, overflow, rx_idle->data);
+}
+
+HAL_RAMFUNC static void hal_usart_handle_irq(uint8_t inst)
 {
 	if(USART_get_irq_status_RXRDY(inst) && USART_get_flag_RXRDY(inst))
 	{
-		uint32_t dummy_data;
+		if(usart_rs485[inst].enabled)
+		{
+			hal_usart_rs485_handle_rx(inst);
+		}
+		else if(usart_rx_idle[inst].enabled)
+		{
+			hal_usart_rx_idle_store(inst, USART_get_data(inst));
+		}
+		else
+		{
+			uint32_t dummy_data;
 
-		usart_rx_callback[inst](inst, usart_rx_data[inst]);
+			usart_rx_callback[inst](inst, usart_rx_data[inst]);
 
-		// Limpio flag de interrupcion leyendo el registro correspondiente
-		dummy_data = USART_get_data(inst);
-		(void) dummy_data;
+			// Limpio flag de interrupcion leyendo el registro correspondiente
+			dummy_data = USART_get_data(inst);
+			(void) dummy_data;
+		}
 	}
 
 	if(USART_get_irq_status_TXRDY(inst) && USART_get_flag_TXRDY(inst))
@@ -248,17 +900,48 @@ static void hal_usart_handle_irq(uint8_t inst)
 	}
 }
 
-void UART0_IRQHandler(void)
+/**
+ * @brief Callback del canal del MRT que mide el silencio de una instancia
+ * @param[in] channel Canal que vencio
+ */
+HAL_RAMFUNC static void hal_usart_rx_idle_mrt_callback(uint8_t channel)
+{
+	uint8_t inst = usart_rx_idle_owner[channel];
+	uint8_t irq_enabled;
+
+	if((inst == HAL_USART_RX_IDLE_NO_OWNER) || (usart_rx_idle[inst].length == 0))
+	{
+		return;
+	}
+
+	// Si hay un caracter en curso el silencio se interrumpio, y el dato recargara el canal al completarse
+	if(!USART_get_flag_RXIDLE(inst))
+	{
+		return;
+	}
+
+	irq_enabled = NVIC_get_enabled_interrupt(USART_NVICS[inst]);
+
+	NVIC_disable_interrupt(USART_NVICS[inst]);
+	hal_usart_rx_idle_timeout(inst);
+
+	if(irq_enabled)
+	{
+		NVIC_enable_interrupt(USART_NVICS[inst]);
+	}
+}
+
+HAL_RAMFUNC void UART0_IRQHandler(void)
 {
 	hal_usart_handle_irq(0);
 }
 
-void UART1_IRQHandler(void)
+HAL_RAMFUNC void UART1_IRQHandler(void)
 {
 	hal_usart_handle_irq(1);
 }
 
-void UART2_IRQHandler(void)
+HAL_RAMFUNC void UART2_IRQHandler(void)
 {
 	hal_usart_handle_irq(2);
 }
@@ -275,12 +958,12 @@ void UART2_IRQHandler(void)
  * o fue llamada porque tambien estaba configurada alguna PININT.
  */
 
-void UART3_irq(void)
+HAL_RAMFUNC void UART3_irq(void)
 {
 	hal_usart_handle_irq(3);
 }
 
-void UART4_irq(void)
+HAL_RAMFUNC void UART4_irq(void)
 {
 	hal_usart_handle_irq(4);
 }
@@ -9,6 +9,7 @@
 #include <stddef.h>
 #include <HAL_WKT.h>
 #include <HAL_SYSCON.h>
+#include <HAL_DIV.h>
 #include <HPL_WKT.h>
 #include <HPL_NVIC.h>
 #include <HPL_SYSCON.h>
@@ -18,7 +19,7 @@
 #define		HAL_WKT_DIVIDE_VALUE		(16)
 
 /** Frecuencia del oscilador de bajo consumo */
-#define		HAL_WKT_LOW_POWER_OSC_FREQ	(10e3)
+#define		HAL_WKT_LOW_POWER_OSC_FREQ	(10000)
 
 /** Fuente actual configurada para el *WKT* */
 static hal_wkt_clock_source_en current_clock_source = HAL_WKT_CLOCK_SOURCE_FRO_DIV;
@@ -99,17 +100,17 @@ void hal_wkt_register_callback(hal_wkt_callback_t new_callback, void *data)
 
 void hal_wkt_start_count(uint32_t time_useg)
 {
-	float clock_base_value;
+	uint32_t clock_base_value = 0;
 	uint32_t calculated_count;
 
 	switch(current_clock_source)
 	{
-	case HAL_WKT_CLOCK_SOURCE_FRO_DIV: { clock_base_value = (float) (hal_syscon_fro_clock_get() / HAL_WKT_DIVIDE_VALUE); break; }
-	case HAL_WKT_CLOCK_SOURCE_LOW_POWER_OSC: { clock_base_value = (float) (HAL_WKT_LOW_POWER_OSC_FREQ); break; }
-	case HAL_WKT_CLOCK_SOURCE_EXTERNAL: { clock_base_value = (float) (current_ext_clock); break; }
+	case HAL_WKT_CLOCK_SOURCE_FRO_DIV: { clock_base_value = hal_syscon_fro_clock_get() / HAL_WKT_DIVIDE_VALUE; break; }
+	case HAL_WKT_CLOCK_SOURCE_LOW_POWER_OSC: { clock_base_value = HAL_WKT_LOW_POWER_OSC_FREQ; break; }
+	case HAL_WKT_CLOCK_SOURCE_EXTERNAL: { clock_base_value = current_ext_clock; break; }
 	}
 
-	calculated_count = (uint32_t) ((clock_base_value * time_useg) / 1e6);
+	calculated_count = (uint32_t) hal_div_unsigned_64((uint64_t) clock_base_value * time_useg, 1000000);
 
 	WKT_write_count(calculated_count);
 }
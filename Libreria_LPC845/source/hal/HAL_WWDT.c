@@ -0,0 +1,278 @@
+/**
+ * @file HAL_WWDT.c
+ * @brief Funciones a nivel de aplicacion del periferico WWDT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include <HAL_WWDT.h>
+#include <HAL_SYSCON.h>
+#include <HAL_DIV.h>
+#include <HPL_WWDT.h>
+#include <HPL_SYSCON.h>
+#include <HPL_NVIC.h>
+#include <HPL_PMU.h>
+
+/** Mascara de la firma del supervisor en el registro de proposito general */
+#define		WWDT_SUPERVISOR_SIGNATURE_MASK		0xFFFF0000
+
+/** Estado del supervisor de tareas */
+typedef struct
+{
+	hal_wwdt_task_t *tasks; /**< Tareas supervisadas */
+	uint16_t task_amount; /**< Cantidad de tareas, cero si el supervisor no esta inicializado */
+	uint8_t gpreg; /**< Registro de proposito general del PMU utilizado */
+}wwdt_supervisor_t;
+
+static uint32_t wwdt_ms_to_ticks(uint32_t ms);
+
+static hal_wwdt_warning_callback_t wwdt_warning_callback = NULL; //!< Callback de la advertencia
+
+static wwdt_supervisor_t wwdt_supervisor; //!< Estado del supervisor de tareas
+
+/**
+ * @brief Inicializar el WWDT
+ * @param[in] config Configuracion deseada
+ * @return Resultado de la operacion
+ */
+hal_wwdt_result_en hal_wwdt_init(const hal_wwdt_config_t *config)
+{
+	uint32_t timeout;
+	uint32_t window = WWDT_MAX_COUNT;
+	uint32_t warning = 0;
+
+	if(hal_syscon_watchdog_oscillator_get() == 0)
+	{
+		return HAL_WWDT_RESULT_CLOCK_ERROR;
+	}
+
+	timeout = wwdt_ms_to_ticks(config->timeout_ms);
+
+	if((timeout < WWDT_MIN_COUNT) || (timeout > WWDT_MAX_COUNT) || (config->window_ms >= config->timeout_ms))
+	{
+		return HAL_WWDT_RESULT_RANGE_ERROR;
+	}
+
+	if(config->window_ms != 0)
+	{
+		// La ventana es el valor del contador por debajo del cual se permite alimentar
+		window = timeout - wwdt_ms_to_ticks(config->window_ms);
+	}
+
+	if(config->warning_ms != 0)
+	{
+		warning = wwdt_ms_to_ticks(config->warning_ms);
+
+		if(warning > WWDT_MAX_WARNING)
+		{
+			warning = WWDT_MAX_WARNING;
+		}
+	}
+
+	SYSCON_power_up_peripheral(SYSCON_POWER_SEL_WDTOSC);
+	SYSCON_enable_clock(SYSCON_ENABLE_CLOCK_SEL_WWDT);
+
+	WWDT_set_timer_constant(timeout);
+	WWDT_set_warning_compare(warning);
+	WWDT_set_window(window);
+
+	wwdt_warning_callback = config->warning_callback;
+
+	WWDT_clear_warning_flag();
+
+	if(config->warning_ms != 0)
+	{
+		NVIC_enable_interrupt(NVIC_IRQ_SEL_WDT);
+	}
+
+	WWDT_enable();
+
+	if(config->reset)
+	{
+		WWDT_enable_reset();
+
+		// El oscilador del watchdog no puede apagarse mientras el watchdog protege al sistema
+		WWDT_lock();
+	}
+
+	hal_wwdt_feed();
+
+	return HAL_WWDT_RESULT_OK;
+}
+
+/**
+ * @brief Alimentar el watchdog
+ */
+void hal_wwdt_feed(void)
+{
+	uint32_t primask;
+
+	primask = NVIC_global_disable();
+
+	WWDT_feed();
+
+	NVIC_global_restore(primask);
+}
+
+/**
+ * @brief Consultar si el ultimo reset fue causado por el watchdog
+ * @return Distinto de cero si el ultimo reset fue causado por el watchdog
+ */
+uint8_t hal_wwdt_reset_caused(void)
+{
+	uint8_t caused = SYSCON_get_watchdog_reset_flag();
+
+	if(caused)
+	{
+		SYSCON_clear_watchdog_reset_flag();
+	}
+
+	return caused;
+}
+
+/**
+ * @brief Inicializar el supervisor de tareas
+ * @param[in] tasks Tareas a supervisar
+ * @param[in] task_amount Cantidad de tareas
+ * @param[in] gpreg Registro de proposito general del PMU a utilizar
+ */
+void hal_wwdt_supervisor_init(hal_wwdt_task_t *tasks, uint16_t task_amount, uint8_t gpreg)
+{
+	uint16_t task;
+
+	for(task = 0; task < task_amount; task++)
+	{
+		tasks[task].elapsed = 0;
+		tasks[task].checked_in = 0;
+	}
+
+	wwdt_supervisor.tasks = tasks;
+	wwdt_supervisor.gpreg = gpreg;
+	wwdt_supervisor.task_amount = task_amount;
+}
+
+/**
+ * @brief Reportar que una tarea esta viva
+ * @param[in] task Numero de tarea
+ */
+void hal_wwdt_supervisor_checkin(uint16_t task)
+{
+	if(task < wwdt_supervisor.task_amount)
+	{
+		wwdt_supervisor.tasks[task].checked_in = 1;
+	}
+}
+
+/**
+ * @brief Procesar un periodo de supervision
+ * @return Distinto de cero si se alimento el watchdog
+ */
+uint8_t hal_wwdt_supervisor_process(void)
+{
+	uint8_t stalled = 0;
+	uint16_t task;
+
+	for(task = 0; task < wwdt_supervisor.task_amount; task++)
+	{
+		hal_wwdt_task_t *current = &wwdt_supervisor.tasks[task];
+
+		if(current->checked_in)
+		{
+			current->checked_in = 0;
+			current->elapsed = 0;
+		}
+		else if(current->elapsed != 0xFFFF)
+		{
+			current->elapsed++;
+		}
+
+		if(current->elapsed > current->deadline)
+		{
+			stalled = 1;
+		}
+	}
+
+	if(stalled)
+	{
+		return 0;
+	}
+
+	hal_wwdt_feed();
+
+	return 1;
+}
+
+/**
+ * @brief Obtener la tarea bloqueada registrada antes del ultimo reset
+ * @param[in] gpreg Registro de proposito general del PMU utilizado por el supervisor
+ * @param[out] task Numero de tarea bloqueada
+ * @return Distinto de cero si habia un registro del supervisor
+ */
+uint8_t hal_wwdt_supervisor_last_stall(uint8_t gpreg, uint16_t *task)
+{
+	uint32_t record = PMU_read_general_purpouse_register(gpreg);
+
+	if((record & WWDT_SUPERVISOR_SIGNATURE_MASK) != HAL_WWDT_SUPERVISOR_SIGNATURE)
+	{
+		return 0;
+	}
+
+	*task = record & ~WWDT_SUPERVISOR_SIGNATURE_MASK;
+
+	PMU_write_general_purpouse_register(gpreg, 0);
+
+	return 1;
+}
+
+/**
+ * @brief Convertir un tiempo en milisegundos a cuentas del contador
+ * @param[in] ms Tiempo en milisegundos
+ * @return Cuentas del contador
+ */
+static uint32_t wwdt_ms_to_ticks(uint32_t ms)
+{
+	uint32_t freq = hal_syscon_watchdog_oscillator_get() / WWDT_CLOCK_PRESCALER;
+	hal_div_unsigned_result_t seconds = hal_div_unsigned_divmod(ms, 1000);
+
+	// Los tiempos fuera de rango se saturan, evitando el desborde del producto
+	if(seconds.quot > hal_div_unsigned(WWDT_MAX_COUNT, freq))
+	{
+		return WWDT_MAX_COUNT + 1;
+	}
+
+	return (seconds.quot * freq) + hal_div_unsigned(seconds.rem * freq, 1000);
+}
+
+/**
+ * @brief Interrupcion de advertencia del WWDT
+ *
+ * Si el supervisor esta inicializado, registra la primera tarea que excedio su plazo antes de llamar al callback.
+ */
+void WDT_IRQHandler(void)
+{
+	WWDT_clear_warning_flag();
+
+	if(wwdt_supervisor.task_amount != 0)
+	{
+		uint16_t stalled = HAL_WWDT_SUPERVISOR_NO_TASK;
+		uint16_t task;
+
+		for(task = 0; task < wwdt_supervisor.task_amount; task++)
+		{
+			if(wwdt_supervisor.tasks[task].elapsed > wwdt_supervisor.tasks[task].deadline)
+			{
+				stalled = task;
+				break;
+			}
+		}
+
+		PMU_write_general_purpouse_register(wwdt_supervisor.gpreg, HAL_WWDT_SUPERVISOR_SIGNATURE | stalled);
+	}
+
+	if(wwdt_warning_callback != NULL)
+	{
+		wwdt_warning_callback();
+	}
+}
@@ -0,0 +1,11 @@
+/**
+ * @file HRI_CRC.c
+ * @brief Declaración del periférico CRC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_CRC.h>
+
+volatile CRC_per_t * const CRC = (volatile CRC_per_t *) CRC_BASE; //!< Periferico CRC
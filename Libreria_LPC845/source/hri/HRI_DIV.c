@@ -0,0 +1,11 @@
+/**
+ * @file HRI_DIV.c
+ * @brief Declaración de la tabla de drivers en ROM para las rutinas de división (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_DIV.h>
+
+const DIV_rom_driver_table_t * const * const DIV_ROM_DRIVER_TABLE = (const DIV_rom_driver_table_t * const *) DIV_ROM_DRIVER_TABLE_BASE; //!< Tabla de drivers en ROM
@@ -0,0 +1,13 @@
+/**
+ * @file HRI_DMA.c
+ * @brief Declaración del periférico DMA (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_DMA.h>
+
+volatile DMA_per_t * const DMA = (volatile DMA_per_t *) DMA_BASE; //!< Periferico DMA
+
+DMA_descriptor_t DMA_DESCRIPTOR_TABLE[DMA_CHANNEL_AMOUNT] __attribute__ ((aligned(512))); //!< Tabla de descriptores de canal
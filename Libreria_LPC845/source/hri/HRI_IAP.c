@@ -0,0 +1,11 @@
+/**
+ * @file HRI_IAP.c
+ * @brief Declaración del punto de entrada de las rutinas de programacion en aplicacion en ROM (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_IAP.h>
+
+const IAP_entry_t IAP_ENTRY = (IAP_entry_t) IAP_ENTRY_LOCATION; //!< Punto de entrada de las rutinas IAP
@@ -0,0 +1,16 @@
+/**
+ * @file HRI_IIC.c
+ * @brief Declaración del periférico IIC (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_IIC.h>
+
+volatile IIC_per_t * const IIC[] = { //!< Perifericos IIC
+		(IIC_per_t *) IIC0_BASE,
+		(IIC_per_t *) IIC1_BASE,
+		(IIC_per_t *) IIC2_BASE,
+		(IIC_per_t *) IIC3_BASE
+};
@@ -0,0 +1,11 @@
+/**
+ * @file HRI_INPUTMUX.c
+ * @brief Declaración del multiplexor de entradas (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_INPUTMUX.h>
+
+volatile INPUTMUX_per_t * const INPUTMUX = (volatile INPUTMUX_per_t *) INPUTMUX_BASE; //!< Multiplexor de entradas
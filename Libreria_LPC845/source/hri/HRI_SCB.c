@@ -0,0 +1,11 @@
+/**
+ * @file HRI_SCB.c
+ * @brief Declaración del bloque de control del sistema SCB (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_SCB.h>
+
+volatile SCB_per_t * const SCB = (SCB_per_t *) SCB_BASE; //!< Bloque de control del sistema
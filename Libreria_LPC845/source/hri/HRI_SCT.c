@@ -0,0 +1,11 @@
+/**
+ * @file HRI_SCT.c
+ * @brief Declaración del periférico SCT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_SCT.h>
+
+volatile SCT_per_t * const SCT = (volatile SCT_per_t *) SCT_BASE; //!< Periferico SCT
@@ -0,0 +1,11 @@
+/**
+ * @file HRI_WWDT.c
+ * @brief Declaración del periférico WWDT (LPC845)
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_WWDT.h>
+
+volatile WWDT_per_t * const WWDT = (volatile WWDT_per_t *) WWDT_BASE; //!< Periferico WWDT
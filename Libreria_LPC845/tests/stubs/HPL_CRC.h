@@ -0,0 +1,46 @@
+/**
+ * @file HPL_CRC.h
+ * @brief Reemplazo para pruebas en la PC del periferico CRC
+ *
+ * Las funciones se implementan en crc_sim.c, sobre un motor de CRC serial por software.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_CRC_H_
+#define HPL_CRC_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+typedef enum
+{
+	CRC_POLYNOMIAL_CCITT = 0,
+	CRC_POLYNOMIAL_CRC16,
+	CRC_POLYNOMIAL_CRC32
+}CRC_polynomial_en;
+
+void CRC_set_mode(CRC_polynomial_en polynomial, uint8_t reverse_input, uint8_t complement_input, uint8_t reverse_output, uint8_t complement_output);
+
+void CRC_set_seed(uint32_t seed);
+
+uint32_t CRC_get_sum(void);
+
+void CRC_write_data_8(uint8_t data);
+
+void CRC_write_data_16(uint16_t data);
+
+void CRC_write_data_32(uint32_t data);
+
+volatile uint32_t *CRC_get_data_address(void);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_CRC_H_ */
@@ -0,0 +1,61 @@
+/**
+ * @file HPL_DMA.h
+ * @brief Reemplazo para pruebas en la PC del periferico DMA
+ *
+ * Las funciones se implementan en dma_sim.c. Cada transferencia se completa luego de algunas consultas de estado.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_DMA_H_
+#define HPL_DMA_H_
+
+#include "HRI_DMA.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+extern DMA_descriptor_t DMA_DESCRIPTOR_TABLE[DMA_CHANNEL_AMOUNT]; //!< Tabla de descriptores de canal
+
+/** Cantidad maxima de transferencias por descriptor */
+#define		DMA_MAX_TRANSFER_COUNT		1024
+
+typedef enum
+{
+	DMA_WIDTH_8_BITS = 0,
+	DMA_WIDTH_16_BITS,
+	DMA_WIDTH_32_BITS
+}DMA_width_en;
+
+typedef enum
+{
+	DMA_INCREMENT_NONE = 0,
+	DMA_INCREMENT_1_WIDTH,
+	DMA_INCREMENT_2_WIDTHS,
+	DMA_INCREMENT_4_WIDTHS
+}DMA_increment_en;
+
+void DMA_enable(void);
+
+uint8_t DMA_is_enabled(void);
+
+void DMA_set_descriptor_table(const DMA_descriptor_t *table);
+
+void DMA_enable_channel(uint8_t channel);
+
+uint8_t DMA_get_channel_active(uint8_t channel);
+
+uint8_t DMA_get_channel_busy(uint8_t channel);
+
+void DMA_config_channel_software_trigger(uint8_t channel, uint8_t priority);
+
+void DMA_start_channel_software_transfer(uint8_t channel, DMA_width_en width, DMA_increment_en source_increment, DMA_increment_en dest_increment, uint16_t count);
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_DMA_H_ */
@@ -0,0 +1,47 @@
+/**
+ * @file HPL_SYSCON.h
+ * @brief Reemplazo para pruebas en la PC del periferico SYSCON
+ *
+ * Solo incluye lo necesario para los modulos probados. Los clocks y resets no tienen efecto.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef HPL_SYSCON_H_
+#define HPL_SYSCON_H_
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+typedef enum
+{
+	SYSCON_ENABLE_CLOCK_SEL_CRC = 0,
+	SYSCON_ENABLE_CLOCK_SEL_DMA
+}SYSCON_enable_clock_sel_en;
+
+typedef enum
+{
+	SYSCON_RESET_SEL_CRC = 0,
+	SYSCON_RESET_SEL_DMA
+}SYSCON_reset_sel_en;
+
+static inline void SYSCON_enable_clock(SYSCON_enable_clock_sel_en peripheral)
+{
+	(void) peripheral;
+}
+
+static inline void SYSCON_clear_reset(SYSCON_reset_sel_en peripheral)
+{
+	(void) peripheral;
+}
+
+#if defined (__cplusplus)
+} // extern "C"
+#endif
+
+#endif /* HPL_SYSCON_H_ */
@@ -0,0 +1,253 @@
+/**
+ * @file crc_sim.c
+ * @brief Motor de CRC y DMA simulados para las pruebas de la libreria en la PC
+ *
+ * El motor procesa cada byte bit a bit, del mas significativo al menos significativo, como el periferico. La
+ * inversion de bits de la entrada se aplica a cada byte, y la del resultado al ancho del polinomio. Las escrituras de
+ * 16 y 32 bits se procesan en el orden de los bytes en memoria.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HPL_CRC.h>
+#include <HPL_DMA.h>
+#include "crc_sim.h"
+
+/** Consultas de estado que demora en completarse cada transferencia de DMA */
+#define		DMA_SIM_LATENCY				3
+
+DMA_descriptor_t DMA_DESCRIPTOR_TABLE[DMA_CHANNEL_AMOUNT];
+
+static const uint32_t crc_sim_polynomials[] = { 0x1021, 0x8005, 0x04C11DB7 }; //!< Polinomio de cada modo
+static const uint8_t crc_sim_widths[] = { 16, 16, 32 }; //!< Ancho de cada modo
+
+static CRC_polynomial_en crc_sim_polynomial; //!< Polinomio configurado
+static uint8_t crc_sim_reverse_input; //!< Inversion de bits de la entrada
+static uint8_t crc_sim_complement_input; //!< Complemento de la entrada
+static uint8_t crc_sim_reverse_output; //!< Inversion de bits del resultado
+static uint8_t crc_sim_complement_output; //!< Complemento del resultado
+static uint32_t crc_sim_register; //!< Registro de desplazamiento
+static volatile uint32_t crc_sim_data; //!< Registro de datos, destino del DMA
+static uint32_t crc_sim_concurrent; //!< Escrituras del CPU durante una transferencia de DMA
+
+static uint8_t dma_sim_enabled; //!< Controlador habilitado
+static const DMA_descriptor_t *dma_sim_table; //!< Tabla de descriptores configurada
+static uint8_t dma_sim_channel; //!< Canal de la transferencia en curso
+static uint16_t dma_sim_count; //!< Palabras de la transferencia en curso
+static uint8_t dma_sim_pending; //!< Consultas restantes para completar la transferencia en curso
+static uint32_t dma_sim_words; //!< Palabras transferidas
+
+/**
+ * @brief Procesar un byte en el motor
+ * @param[in] data Byte
+ */
+static void crc_sim_process(uint8_t data)
+{
+	uint8_t width = crc_sim_widths[crc_sim_polynomial];
+	uint32_t top = 1UL << (width - 1);
+	uint8_t bit;
+
+	if(crc_sim_complement_input)
+	{
+		data = ~data;
+	}
+
+	for(bit = 0; bit < 8; bit++)
+	{
+		// Sin inversion, el primer bit es el mas significativo del byte
+		uint8_t input = crc_sim_reverse_input ? ((data >> bit) & 1) : ((data >> (7 - bit)) & 1);
+		uint8_t feedback = ((crc_sim_register & top) != 0) ^ input;
+
+		crc_sim_register = (crc_sim_register << 1) & (width == 32 ? 0xFFFFFFFF : ((1UL << width) - 1));
+
+		if(feedback)
+		{
+			crc_sim_register ^= crc_sim_polynomials[crc_sim_polynomial];
+		}
+	}
+}
+
+/**
+ * @brief Registrar una escritura del CPU en el motor
+ */
+static void crc_sim_cpu_write(void)
+{
+	if(dma_sim_pending != 0)
+	{
+		crc_sim_concurrent++;
+	}
+}
+
+void CRC_set_mode(CRC_polynomial_en polynomial, uint8_t reverse_input, uint8_t complement_input, uint8_t reverse_output, uint8_t complement_output)
+{
+	crc_sim_polynomial = polynomial;
+	crc_sim_reverse_input = reverse_input;
+	crc_sim_complement_input = complement_input;
+	crc_sim_reverse_output = reverse_output;
+	crc_sim_complement_output = complement_output;
+}
+
+void CRC_set_seed(uint32_t seed)
+{
+	uint8_t width = crc_sim_widths[crc_sim_polynomial];
+
+	crc_sim_register = (width == 32) ? seed : (seed & ((1UL << width) - 1));
+}
+
+uint32_t CRC_get_sum(void)
+{
+	uint8_t width = crc_sim_widths[crc_sim_polynomial];
+	uint32_t sum = crc_sim_register;
+	uint8_t bit;
+
+	if(crc_sim_reverse_output)
+	{
+		sum = 0;
+
+		for(bit = 0; bit < width; bit++)
+		{
+			if(crc_sim_register & (1UL << bit))
+			{
+				sum |= 1UL << (width - 1 - bit);
+			}
+		}
+	}
+
+	if(crc_sim_complement_output)
+	{
+		sum = ~sum;
+	}
+
+	return (width == 32) ? sum : (sum & ((1UL << width) - 1));
+}
+
+void CRC_write_data_8(uint8_t data)
+{
+	crc_sim_cpu_write();
+	crc_sim_process(data);
+}
+
+void CRC_write_data_16(uint16_t data)
+{
+	crc_sim_cpu_write();
+	crc_sim_process(data & 0xFF);
+	crc_sim_process(data >> 8);
+}
+
+/**
+ * @brief Procesar una palabra de 32 bits, sin registrarla como escritura del CPU
+ * @param[in] data Palabra
+ */
+static void crc_sim_process_32(uint32_t data)
+{
+	crc_sim_process(data & 0xFF);
+	crc_sim_process((data >> 8) & 0xFF);
+	crc_sim_process((data >> 16) & 0xFF);
+	crc_sim_process(data >> 24);
+}
+
+void CRC_write_data_32(uint32_t data)
+{
+	crc_sim_cpu_write();
+	crc_sim_process_32(data);
+}
+
+volatile uint32_t *CRC_get_data_address(void)
+{
+	return &crc_sim_data;
+}
+
+uint32_t crc_sim_concurrent_writes(void)
+{
+	return crc_sim_concurrent;
+}
+
+void DMA_enable(void)
+{
+	dma_sim_enabled = 1;
+}
+
+uint8_t DMA_is_enabled(void)
+{
+	return dma_sim_enabled;
+}
+
+void DMA_set_descriptor_table(const DMA_descriptor_t *table)
+{
+	dma_sim_table = table;
+}
+
+void DMA_enable_channel(uint8_t channel)
+{
+	(void) channel;
+}
+
+void DMA_config_channel_software_trigger(uint8_t channel, uint8_t priority)
+{
+	(void) channel;
+	(void) priority;
+}
+
+void DMA_start_channel_software_transfer(uint8_t channel, DMA_width_en width, DMA_increment_en source_increment, DMA_increment_en dest_increment, uint16_t count)
+{
+	const DMA_descriptor_t *descriptor = &dma_sim_table[channel];
+
+	// Solo se simulan las transferencias de memoria al registro de datos del CRC
+	if(!dma_sim_enabled || (dma_sim_table != DMA_DESCRIPTOR_TABLE) || (dma_sim_pending != 0) ||
+			(width != DMA_WIDTH_32_BITS) || (source_increment != DMA_INCREMENT_1_WIDTH) ||
+			(dest_increment != DMA_INCREMENT_NONE) || (descriptor->DEST_END != CRC_get_data_address()) ||
+			(count == 0) || (count > DMA_MAX_TRANSFER_COUNT))
+	{
+		crc_sim_concurrent++;
+		return;
+	}
+
+	dma_sim_channel = channel;
+	dma_sim_count = count;
+	dma_sim_pending = DMA_SIM_LATENCY;
+}
+
+uint8_t DMA_get_channel_active(uint8_t channel)
+{
+	if((dma_sim_pending == 0) || (channel != dma_sim_channel))
+	{
+		return 0;
+	}
+
+	if(--dma_sim_pending == 0)
+	{
+		// La direccion de origen del descriptor es la del ultimo dato
+		const uint32_t *source = (const uint32_t *) dma_sim_table[channel].SOURCE_END - (dma_sim_count - 1);
+		uint16_t counter;
+
+		for(counter = 0; counter < dma_sim_count; counter++)
+		{
+			crc_sim_process_32(source[counter]);
+		}
+
+		dma_sim_words += dma_sim_count;
+
+		return 0;
+	}
+
+	return 1;
+}
+
+uint8_t DMA_get_channel_busy(uint8_t channel)
+{
+	(void) channel;
+
+	return 0;
+}
+
+uint32_t dma_sim_words_transferred(void)
+{
+	return dma_sim_words;
+}
+
+uint8_t dma_sim_busy(void)
+{
+	return dma_sim_pending != 0;
+}
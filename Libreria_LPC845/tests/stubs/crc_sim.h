@@ -0,0 +1,32 @@
+/**
+ * @file crc_sim.h
+ * @brief Motor de CRC y DMA simulados para las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef CRC_SIM_H_
+#define CRC_SIM_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Obtener la cantidad de palabras escritas en el motor de CRC por DMA
+ * @return Palabras escritas desde el inicio del programa
+ */
+uint32_t dma_sim_words_transferred(void);
+
+/**
+ * @brief Consultar si hay una transferencia de DMA en curso
+ * @return Distinto de cero si hay una transferencia en curso
+ */
+uint8_t dma_sim_busy(void);
+
+/**
+ * @brief Obtener la cantidad de escrituras del CPU en el motor de CRC durante una transferencia de DMA
+ * @return Escrituras concurrentes desde el inicio del programa
+ */
+uint32_t crc_sim_concurrent_writes(void);
+
+#endif /* CRC_SIM_H_ */
@@ -0,0 +1,56 @@
+/**
+ * @file div_sim.c
+ * @brief Tabla de drivers en ROM simulada con las rutinas de división, para las pruebas de la libreria en la PC
+ *
+ * Las rutinas tienen la misma firma que las de la ROM, de modo que la capa HPL real se prueba tal como se usa en el
+ * microcontrolador: las rutinas con resto devuelven el cociente en la parte baja y el resto en la parte alta de un
+ * entero de 64 bits (registros r0 y r1).
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <HRI_DIV.h>
+
+static int32_t div_sim_sidiv(int32_t numerator, int32_t denominator);
+
+static uint32_t div_sim_uidiv(uint32_t numerator, uint32_t denominator);
+
+static uint64_t div_sim_sidivmod(int32_t numerator, int32_t denominator);
+
+static uint64_t div_sim_uidivmod(uint32_t numerator, uint32_t denominator);
+
+static const DIV_rom_api_t div_sim_api =
+{
+	.sidiv = div_sim_sidiv,
+	.uidiv = div_sim_uidiv,
+	.sidivmod = div_sim_sidivmod,
+	.uidivmod = div_sim_uidivmod
+}; //!< Rutinas de division simuladas
+
+static const DIV_rom_driver_table_t div_sim_driver_table = { .DIV_API = &div_sim_api }; //!< Tabla de drivers simulada
+
+static const DIV_rom_driver_table_t * const div_sim_driver_table_pointer = &div_sim_driver_table; //!< Puntero en ROM
+
+const DIV_rom_driver_table_t * const * const DIV_ROM_DRIVER_TABLE = &div_sim_driver_table_pointer; //!< Tabla de drivers
+
+static int32_t div_sim_sidiv(int32_t numerator, int32_t denominator)
+{
+	return numerator / denominator;
+}
+
+static uint32_t div_sim_uidiv(uint32_t numerator, uint32_t denominator)
+{
+	return numerator / denominator;
+}
+
+static uint64_t div_sim_sidivmod(int32_t numerator, int32_t denominator)
+{
+	return (uint32_t) (numerator / denominator) | ((uint64_t) (uint32_t) (numerator % denominator) << 32);
+}
+
+static uint64_t div_sim_uidivmod(uint32_t numerator, uint32_t denominator)
+{
+	return (numerator / denominator) | ((uint64_t) (numerator % denominator) << 32);
+}
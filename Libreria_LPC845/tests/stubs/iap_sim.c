@@ -0,0 +1,155 @@
+/**
+ * @file iap_sim.c
+ * @brief Flash simulada en RAM para las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <string.h>
+#include "iap_sim.h"
+
+uint8_t iap_sim_flash[HAL_IAP_FLASH_SIZE];
+
+static uint32_t iap_sim_operation; //!< Numero de la proxima operacion
+static uint32_t iap_sim_fault_operation = IAP_SIM_NO_FAULT; //!< Operacion a fallar
+static uint8_t iap_sim_power_loss; //!< Las operaciones siguientes a la falla tambien fallan
+static uint8_t iap_sim_faulted; //!< La falla ya se produjo
+
+/**
+ * @brief Avanzar el contador de operaciones
+ * @return Distinto de cero si la operacion debe fallar
+ */
+static uint8_t iap_sim_next_fails(void)
+{
+	if(iap_sim_faulted && iap_sim_power_loss)
+	{
+		return 1;
+	}
+
+	if(iap_sim_operation++ == iap_sim_fault_operation)
+	{
+		iap_sim_faulted = 1;
+		return 1;
+	}
+
+	return 0;
+}
+
+void iap_sim_reset(void)
+{
+	memset(iap_sim_flash, 0xFF, sizeof(iap_sim_flash));
+	iap_sim_power_on();
+}
+
+void iap_sim_fault(uint32_t operation, uint8_t power_loss)
+{
+	iap_sim_operation = 0;
+	iap_sim_fault_operation = operation;
+	iap_sim_power_loss = power_loss;
+	iap_sim_faulted = 0;
+}
+
+uint8_t iap_sim_fault_done(void)
+{
+	return iap_sim_faulted;
+}
+
+void iap_sim_power_on(void)
+{
+	iap_sim_fault(IAP_SIM_NO_FAULT, 0);
+}
+
+hal_iap_status_en hal_iap_erase_sectors(uint32_t start_sector, uint32_t end_sector)
+{
+	uint8_t already_faulted = iap_sim_faulted;
+
+	if((start_sector > end_sector) || (end_sector >= HAL_IAP_SECTOR_AMOUNT))
+	{
+		return HAL_IAP_STATUS_INVALID_SECTOR;
+	}
+
+	if(iap_sim_next_fails())
+	{
+		// Un corte durante el borrado deja borrado solo el primer sector
+		if(!already_faulted)
+		{
+			memset(&iap_sim_flash[start_sector * HAL_IAP_SECTOR_SIZE], 0xFF, HAL_IAP_SECTOR_SIZE);
+		}
+
+		return HAL_IAP_STATUS_BUSY;
+	}
+
+	memset(&iap_sim_flash[start_sector * HAL_IAP_SECTOR_SIZE], 0xFF, (end_sector - start_sector + 1) * HAL_IAP_SECTOR_SIZE);
+
+	return HAL_IAP_STATUS_SUCCESS;
+}
+
+hal_iap_status_en hal_iap_erase_pages(uint32_t start_page, uint32_t end_page)
+{
+	if((start_page > end_page) || (end_page >= HAL_IAP_PAGE_AMOUNT))
+	{
+		return HAL_IAP_STATUS_INVALID_SECTOR;
+	}
+
+	if(iap_sim_next_fails())
+	{
+		return HAL_IAP_STATUS_BUSY;
+	}
+
+	memset(&iap_sim_flash[start_page * HAL_IAP_PAGE_SIZE], 0xFF, (end_page - start_page + 1) * HAL_IAP_PAGE_SIZE);
+
+	return HAL_IAP_STATUS_SUCCESS;
+}
+
+hal_iap_status_en hal_iap_program(uint32_t address, const void *data, uint32_t length)
+{
+	const uint8_t *source = data;
+	uint32_t offset;
+	uint32_t counter;
+
+	if((address % HAL_IAP_PAGE_SIZE) != 0)
+	{
+		return HAL_IAP_STATUS_DST_ADDR_ERROR;
+	}
+
+	if(((uintptr_t) data % sizeof(uint32_t)) != 0)
+	{
+		return HAL_IAP_STATUS_SRC_ADDR_ERROR;
+	}
+
+	if(((length % HAL_IAP_PAGE_SIZE) != 0) || ((address + length) > HAL_IAP_FLASH_SIZE))
+	{
+		return HAL_IAP_STATUS_COUNT_ERROR;
+	}
+
+	for(offset = 0; offset < length; offset += HAL_IAP_PAGE_SIZE)
+	{
+		uint8_t already_faulted = iap_sim_faulted;
+		uint32_t amount = HAL_IAP_PAGE_SIZE;
+
+		if(iap_sim_next_fails())
+		{
+			if(already_faulted)
+			{
+				return HAL_IAP_STATUS_BUSY;
+			}
+
+			// Un corte durante la escritura deja grabada solo la primera mitad de la pagina
+			amount = HAL_IAP_PAGE_SIZE / 2;
+		}
+
+		// La escritura solo puede llevar bits de uno a cero
+		for(counter = 0; counter < amount; counter++)
+		{
+			iap_sim_flash[address + offset + counter] &= source[offset + counter];
+		}
+
+		if(amount != HAL_IAP_PAGE_SIZE)
+		{
+			return HAL_IAP_STATUS_BUSY;
+		}
+	}
+
+	return HAL_IAP_STATUS_SUCCESS;
+}
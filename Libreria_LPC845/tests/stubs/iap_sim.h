@@ -0,0 +1,47 @@
+/**
+ * @file iap_sim.h
+ * @brief Flash simulada en RAM para las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef IAP_SIM_H_
+#define IAP_SIM_H_
+
+#include <stdint.h>
+#include <HAL_IAP.h>
+
+/** Valor del contador de operaciones que no provoca fallas */
+#define		IAP_SIM_NO_FAULT			0xFFFFFFFF
+
+extern uint8_t iap_sim_flash[HAL_IAP_FLASH_SIZE]; //!< Contenido de la flash simulada
+
+/**
+ * @brief Borrar toda la flash simulada y reiniciar el contador de operaciones
+ */
+void iap_sim_reset(void);
+
+/**
+ * @brief Programar una falla
+ *
+ * Las operaciones (cada pagina escrita y cada llamado de borrado) se numeran desde cero. La operacion indicada queda
+ * a medio hacer (media pagina escrita, o solo el primer sector borrado) y devuelve error.
+ *
+ * @param[in] operation Numero de operacion a fallar, o @ref IAP_SIM_NO_FAULT
+ * @param[in] power_loss Distinto de cero para que tambien fallen, sin efecto, todas las operaciones siguientes
+ */
+void iap_sim_fault(uint32_t operation, uint8_t power_loss);
+
+/**
+ * @brief Consultar si la falla programada ya se produjo
+ * @return Distinto de cero si se produjo
+ */
+uint8_t iap_sim_fault_done(void);
+
+/**
+ * @brief Restablecer el funcionamiento normal, conservando el contenido de la flash
+ */
+void iap_sim_power_on(void);
+
+#endif /* IAP_SIM_H_ */
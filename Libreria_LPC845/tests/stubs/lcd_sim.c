@@ -0,0 +1,257 @@
+/**
+ * @file lcd_sim.c
+ * @brief Controlador de display SPI simulado para las pruebas de la libreria en la PC
+ *
+ * Reemplaza las transferencias de @ref SPI en modo master y el manejo del pin de datos/comando por un controlador
+ * con los comandos MIPI DCS de ventana y escritura de memoria. Como un controlador real, la escritura de memoria
+ * recorre la ventana por filas y, al completarla, continua desde el comienzo de la ventana.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <string.h>
+#include <HAL_SPI.h>
+#include <HAL_GPIO.h>
+#include "lcd_sim.h"
+
+/** Comando de rango de columnas */
+#define		LCD_SIM_CMD_CASET			0x2A
+
+/** Comando de rango de filas */
+#define		LCD_SIM_CMD_RASET			0x2B
+
+/** Comando de escritura de memoria */
+#define		LCD_SIM_CMD_RAMWR			0x2C
+
+/** Sin comando en curso */
+#define		LCD_SIM_CMD_NONE			0xFFFF
+
+uint16_t lcd_sim_memory[LCD_SIM_MEMORY_HEIGHT][LCD_SIM_MEMORY_WIDTH];
+lcd_sim_stats_t lcd_sim_stats;
+
+static uint8_t lcd_sim_port_init; //!< Puertos de GPIO inicializados, un bit por puerto
+static hal_gpio_portpin_en lcd_sim_dc_portpin = HAL_GPIO_PORTPIN_NOT_USED; //!< Pin de datos/comando configurado
+static uint8_t lcd_sim_dc; //!< Nivel del pin de datos/comando
+static uint16_t lcd_sim_command = LCD_SIM_CMD_NONE; //!< Comando en curso
+static uint32_t lcd_sim_position; //!< Bytes de parametros o datos del comando en curso
+static uint8_t lcd_sim_params[4]; //!< Parametros del comando de rango en curso
+static uint16_t lcd_sim_column_start; //!< Rango de columnas
+static uint16_t lcd_sim_column_end;
+static uint16_t lcd_sim_row_start; //!< Rango de filas
+static uint16_t lcd_sim_row_end;
+static uint16_t lcd_sim_column; //!< Posicion de escritura
+static uint16_t lcd_sim_row;
+static uint8_t lcd_sim_pixel_high; //!< Byte mas significativo del pixel en curso
+
+void lcd_sim_reset(uint16_t color)
+{
+	uint32_t row;
+	uint32_t column;
+
+	for(row = 0; row < LCD_SIM_MEMORY_HEIGHT; row++)
+	{
+		for(column = 0; column < LCD_SIM_MEMORY_WIDTH; column++)
+		{
+			lcd_sim_memory[row][column] = color;
+		}
+	}
+
+	memset(&lcd_sim_stats, 0, sizeof(lcd_sim_stats));
+
+	lcd_sim_port_init = 0;
+	lcd_sim_dc_portpin = HAL_GPIO_PORTPIN_NOT_USED;
+	lcd_sim_command = LCD_SIM_CMD_NONE;
+	lcd_sim_column_start = 0;
+	lcd_sim_column_end = LCD_SIM_MEMORY_WIDTH - 1;
+	lcd_sim_row_start = 0;
+	lcd_sim_row_end = LCD_SIM_MEMORY_HEIGHT - 1;
+}
+
+/**
+ * @brief Recibir un byte
+ * @param[in] data Byte recibido
+ */
+static void lcd_sim_byte(uint8_t data)
+{
+	lcd_sim_stats.bytes++;
+
+	if(lcd_sim_dc_portpin == HAL_GPIO_PORTPIN_NOT_USED)
+	{
+		lcd_sim_stats.protocol_errors++;
+		return;
+	}
+
+	if(!lcd_sim_dc)
+	{
+		lcd_sim_command = data;
+		lcd_sim_position = 0;
+
+		switch(data)
+		{
+		case LCD_SIM_CMD_CASET: { lcd_sim_stats.caset++; break; }
+		case LCD_SIM_CMD_RASET: { lcd_sim_stats.raset++; break; }
+		case LCD_SIM_CMD_RAMWR:
+		{
+			lcd_sim_stats.ramwr++;
+			lcd_sim_column = lcd_sim_column_start;
+			lcd_sim_row = lcd_sim_row_start;
+			break;
+		}
+		}
+
+		return;
+	}
+
+	switch(lcd_sim_command)
+	{
+	case LCD_SIM_CMD_CASET:
+	case LCD_SIM_CMD_RASET:
+	{
+		if(lcd_sim_position < 4)
+		{
+			lcd_sim_params[lcd_sim_position] = data;
+		}
+
+		if(++lcd_sim_position == 4)
+		{
+			uint16_t start = (lcd_sim_params[0] << 8) | lcd_sim_params[1];
+			uint16_t end = (lcd_sim_params[2] << 8) | lcd_sim_params[3];
+			uint16_t size = (lcd_sim_command == LCD_SIM_CMD_CASET) ? LCD_SIM_MEMORY_WIDTH : LCD_SIM_MEMORY_HEIGHT;
+
+			if((start > end) || (end >= size))
+			{
+				lcd_sim_stats.protocol_errors++;
+			}
+			else if(lcd_sim_command == LCD_SIM_CMD_CASET)
+			{
+				lcd_sim_column_start = start;
+				lcd_sim_column_end = end;
+			}
+			else
+			{
+				lcd_sim_row_start = start;
+				lcd_sim_row_end = end;
+			}
+		}
+
+		break;
+	}
+
+	case LCD_SIM_CMD_RAMWR:
+	{
+		if((lcd_sim_position++ & 1) == 0)
+		{
+			lcd_sim_pixel_high = data;
+			break;
+		}
+
+		lcd_sim_memory[lcd_sim_row][lcd_sim_column] = (lcd_sim_pixel_high << 8) | data;
+		lcd_sim_stats.pixels++;
+
+		// La escritura recorre la ventana por filas, y al completarla vuelve al comienzo
+		if(lcd_sim_column++ == lcd_sim_column_end)
+		{
+			lcd_sim_column = lcd_sim_column_start;
+
+			if(lcd_sim_row++ == lcd_sim_row_end)
+			{
+				lcd_sim_row = lcd_sim_row_start;
+			}
+		}
+
+		break;
+	}
+
+	case LCD_SIM_CMD_NONE: { lcd_sim_stats.protocol_errors++; break; }
+	}
+}
+
+void hal_spi_master_mode_transfer(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint8_t *tx, uint8_t *rx,
+		uint32_t length, uint8_t end_of_transfer)
+{
+	uint32_t counter;
+
+	for(counter = 0; counter < length; counter++)
+	{
+		lcd_sim_byte(tx[counter]);
+	}
+
+	if(end_of_transfer)
+	{
+		hal_spi_master_mode_end_transfer(inst);
+	}
+}
+
+void hal_spi_master_mode_end_transfer(hal_spi_sel_en inst)
+{
+	lcd_sim_command = LCD_SIM_CMD_NONE;
+}
+
+void hal_spi_master_mode_write_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint16_t *data, uint32_t length,
+		uint8_t end_of_transfer)
+{
+	uint32_t counter;
+
+	for(counter = 0; counter < length; counter++)
+	{
+		lcd_sim_byte(data[counter] >> 8);
+		lcd_sim_byte(data[counter] & 0xFF);
+	}
+
+	if(end_of_transfer)
+	{
+		hal_spi_master_mode_end_transfer(inst);
+	}
+}
+
+void hal_spi_master_mode_fill_16(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, uint16_t value, uint32_t count,
+		uint8_t end_of_transfer)
+{
+	uint32_t counter;
+
+	for(counter = 0; counter < count; counter++)
+	{
+		lcd_sim_byte(value >> 8);
+		lcd_sim_byte(value & 0xFF);
+	}
+
+	if(end_of_transfer)
+	{
+		hal_spi_master_mode_end_transfer(inst);
+	}
+}
+
+void hal_gpio_init(hal_gpio_port_en port)
+{
+	lcd_sim_port_init |= 1 << port;
+}
+
+void hal_gpio_set_dir(hal_gpio_portpin_en portpin, hal_gpio_dir_en dir, uint8_t initial_state)
+{
+	// El pin solo puede configurarse con su puerto inicializado
+	if(!(lcd_sim_port_init & (1 << HAL_GPIO_PORTPIN_TO_PORT(portpin))) || (dir != HAL_GPIO_DIR_OUTPUT))
+	{
+		return;
+	}
+
+	lcd_sim_dc_portpin = portpin;
+	lcd_sim_dc = initial_state;
+}
+
+void hal_gpio_set_pin(hal_gpio_portpin_en portpin)
+{
+	if(portpin == lcd_sim_dc_portpin)
+	{
+		lcd_sim_dc = 1;
+	}
+}
+
+void hal_gpio_clear_pin(hal_gpio_portpin_en portpin)
+{
+	if(portpin == lcd_sim_dc_portpin)
+	{
+		lcd_sim_dc = 0;
+	}
+}
@@ -0,0 +1,40 @@
+/**
+ * @file lcd_sim.h
+ * @brief Controlador de display SPI simulado para las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef LCD_SIM_H_
+#define LCD_SIM_H_
+
+#include <stdint.h>
+
+/** Columnas de la memoria del controlador simulado */
+#define		LCD_SIM_MEMORY_WIDTH		240
+
+/** Filas de la memoria del controlador simulado */
+#define		LCD_SIM_MEMORY_HEIGHT		320
+
+/** Estadisticas del controlador simulado */
+typedef struct
+{
+	uint32_t caset; /**< Comandos de rango de columnas */
+	uint32_t raset; /**< Comandos de rango de filas */
+	uint32_t ramwr; /**< Comandos de escritura de memoria */
+	uint32_t pixels; /**< Pixeles escritos */
+	uint32_t bytes; /**< Bytes recibidos */
+	uint32_t protocol_errors; /**< Datos sin comando, ventanas fuera de la memoria o pin D/C sin configurar */
+}lcd_sim_stats_t;
+
+extern uint16_t lcd_sim_memory[LCD_SIM_MEMORY_HEIGHT][LCD_SIM_MEMORY_WIDTH]; //!< Memoria del controlador simulado
+extern lcd_sim_stats_t lcd_sim_stats; //!< Estadisticas del controlador simulado
+
+/**
+ * @brief Llenar la memoria del controlador simulado y borrar sus estadisticas
+ * @param[in] color Color con el cual llenar la memoria
+ */
+void lcd_sim_reset(uint16_t color);
+
+#endif /* LCD_SIM_H_ */
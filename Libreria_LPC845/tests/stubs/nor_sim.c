@@ -0,0 +1,254 @@
+/**
+ * @file nor_sim.c
+ * @brief Memoria flash NOR SPI simulada para las pruebas de la libreria en la PC
+ *
+ * Reemplaza las transferencias de @ref SPI en modo master por una memoria con el juego de comandos JEDEC basico.
+ * Como una memoria real, la programacion de pagina que excede el limite de la pagina continua desde el comienzo de
+ * la misma pagina, y la programacion solo puede llevar bits de uno a cero.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <string.h>
+#include <HAL_SPI.h>
+#include "nor_sim.h"
+
+/** Tamaño de pagina de la memoria simulada */
+#define		NOR_SIM_PAGE_SIZE			256
+
+/** Bit de escritura en curso del registro de estado */
+#define		NOR_SIM_STATUS_WIP			(1 << 0)
+
+/** Bit de escritura habilitada del registro de estado */
+#define		NOR_SIM_STATUS_WEL			(1 << 1)
+
+uint8_t nor_sim_memory[NOR_SIM_SIZE];
+nor_sim_stats_t nor_sim_stats;
+
+static uint32_t nor_sim_busy_polls; //!< Lecturas de estado que dura cada operacion
+static uint32_t nor_sim_busy; //!< Lecturas de estado restantes de la operacion en curso
+static uint8_t nor_sim_wel; //!< Escritura habilitada
+static uint8_t nor_sim_selected; //!< Slave select activo
+static uint8_t nor_sim_command; //!< Comando de la transaccion en curso
+static uint32_t nor_sim_position; //!< Bytes recibidos en la transaccion en curso
+static uint32_t nor_sim_address; //!< Direccion de la transaccion en curso
+static uint32_t nor_sim_page_bytes; //!< Bytes de datos programados en la transaccion en curso
+static uint8_t nor_sim_page[NOR_SIM_PAGE_SIZE]; //!< Buffer de programacion de la transaccion en curso
+
+void nor_sim_reset(uint32_t busy_polls)
+{
+	memset(nor_sim_memory, 0xFF, sizeof(nor_sim_memory));
+	memset(&nor_sim_stats, 0, sizeof(nor_sim_stats));
+
+	nor_sim_busy_polls = busy_polls;
+	nor_sim_busy = 0;
+	nor_sim_wel = 0;
+	nor_sim_selected = 0;
+}
+
+/**
+ * @brief Verificar que la memoria acepte un comando de escritura o borrado
+ * @return Distinto de cero si lo acepta
+ */
+static uint8_t nor_sim_write_allowed(void)
+{
+	if((nor_sim_busy != 0) || !nor_sim_wel)
+	{
+		nor_sim_stats.protocol_errors++;
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Ejecutar el comando de la transaccion al desactivar el slave select
+ */
+static void nor_sim_deselect(void)
+{
+	uint32_t base = nor_sim_address & (NOR_SIM_SIZE - 1);
+	uint32_t size = 0;
+	uint32_t counter;
+
+	if(!nor_sim_selected)
+	{
+		return;
+	}
+
+	nor_sim_selected = 0;
+
+	switch(nor_sim_command)
+	{
+	case 0x06: { nor_sim_wel = (nor_sim_busy == 0); break; }
+	case 0x02:
+	{
+		if((nor_sim_position < 4) || !nor_sim_write_allowed())
+		{
+			break;
+		}
+
+		nor_sim_stats.page_programs++;
+
+		if(((base & (NOR_SIM_PAGE_SIZE - 1)) + nor_sim_page_bytes) > NOR_SIM_PAGE_SIZE)
+		{
+			nor_sim_stats.page_overruns++;
+		}
+
+		// Los datos que exceden la pagina continuan desde el comienzo de la misma
+		for(counter = 0; counter < nor_sim_page_bytes && counter < NOR_SIM_PAGE_SIZE; counter++)
+		{
+			uint32_t address = (base & ~(NOR_SIM_PAGE_SIZE - 1)) | ((base + counter) & (NOR_SIM_PAGE_SIZE - 1));
+			uint8_t data = nor_sim_page[((base + counter) & (NOR_SIM_PAGE_SIZE - 1))];
+
+			if(data & ~nor_sim_memory[address])
+			{
+				nor_sim_stats.protocol_errors++;
+			}
+
+			nor_sim_memory[address] &= data;
+		}
+
+		nor_sim_wel = 0;
+		nor_sim_busy = nor_sim_busy_polls;
+		break;
+	}
+	case 0x20: { size = 4 * 1024; break; }
+	case 0x52: { size = 32 * 1024; break; }
+	case 0xD8: { size = 64 * 1024; break; }
+	case 0xC7: { size = NOR_SIM_SIZE; base = 0; break; }
+	}
+
+	if(size != 0)
+	{
+		if(((nor_sim_command != 0xC7) && (nor_sim_position < 4)) || !nor_sim_write_allowed())
+		{
+			return;
+		}
+
+		nor_sim_stats.erases++;
+
+		memset(&nor_sim_memory[base & ~(size - 1)], 0xFF, size);
+
+		nor_sim_wel = 0;
+		nor_sim_busy = nor_sim_busy_polls;
+	}
+}
+
+/**
+ * @brief Transferir un byte con la memoria
+ * @param[in] tx Byte recibido por la memoria
+ * @return Byte transmitido por la memoria
+ */
+static uint8_t nor_sim_byte(uint8_t tx)
+{
+	uint32_t position = nor_sim_position++;
+	uint8_t rx = 0xFF;
+
+	if(position == 0)
+	{
+		nor_sim_command = tx;
+		nor_sim_address = 0;
+		nor_sim_page_bytes = 0;
+
+		if(tx == 0x03)
+		{
+			nor_sim_stats.read_commands++;
+		}
+
+		// Con la memoria ocupada solo se acepta la lectura del registro de estado
+		if((nor_sim_busy != 0) && (tx != 0x05))
+		{
+			nor_sim_stats.protocol_errors++;
+		}
+
+		return rx;
+	}
+
+	switch(nor_sim_command)
+	{
+	case 0x05:
+	{
+		rx = (nor_sim_busy != 0 ? NOR_SIM_STATUS_WIP : 0) | (nor_sim_wel ? NOR_SIM_STATUS_WEL : 0);
+
+		if(nor_sim_busy != 0)
+		{
+			nor_sim_busy--;
+		}
+
+		break;
+	}
+	case 0x9F:
+	{
+		if(position <= 3)
+		{
+			rx = (uint8_t) (NOR_SIM_JEDEC_ID >> (8 * (3 - position)));
+		}
+
+		break;
+	}
+	case 0x03:
+	case 0x02:
+	case 0x20:
+	case 0x52:
+	case 0xD8:
+	{
+		if(position <= 3)
+		{
+			nor_sim_address = (nor_sim_address << 8) | tx;
+		}
+		else if(nor_sim_command == 0x03)
+		{
+			rx = nor_sim_memory[(nor_sim_address + position - 4) & (NOR_SIM_SIZE - 1)];
+		}
+		else if(nor_sim_command == 0x02)
+		{
+			// Los datos que exceden la pagina continuan desde el comienzo de la misma
+			nor_sim_page[(nor_sim_address + nor_sim_page_bytes) & (NOR_SIM_PAGE_SIZE - 1)] = tx;
+			nor_sim_page_bytes++;
+		}
+
+		break;
+	}
+	}
+
+	return rx;
+}
+
+void hal_spi_master_mode_transfer(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint8_t *tx, uint8_t *rx,
+		uint32_t length, uint8_t end_of_transfer)
+{
+	uint32_t counter;
+
+	(void) inst;
+	(void) ssel;
+
+	if(!nor_sim_selected)
+	{
+		nor_sim_selected = 1;
+		nor_sim_position = 0;
+	}
+
+	for(counter = 0; counter < length; counter++)
+	{
+		uint8_t data = nor_sim_byte((tx != NULL) ? tx[counter] : HAL_SPI_DUMMY_BYTE);
+
+		if(rx != NULL)
+		{
+			rx[counter] = data;
+		}
+	}
+
+	if(end_of_transfer)
+	{
+		nor_sim_deselect();
+	}
+}
+
+void hal_spi_master_mode_end_transfer(hal_spi_sel_en inst)
+{
+	(void) inst;
+
+	nor_sim_deselect();
+}
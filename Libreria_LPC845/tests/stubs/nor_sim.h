@@ -0,0 +1,39 @@
+/**
+ * @file nor_sim.h
+ * @brief Memoria flash NOR SPI simulada para las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef NOR_SIM_H_
+#define NOR_SIM_H_
+
+#include <stdint.h>
+
+/** Tamaño de la memoria simulada */
+#define		NOR_SIM_SIZE				(256 * 1024)
+
+/** Identificacion JEDEC de la memoria simulada */
+#define		NOR_SIM_JEDEC_ID			0xEF4012
+
+/** Estadisticas de la memoria simulada */
+typedef struct
+{
+	uint32_t read_commands; /**< Comandos de lectura */
+	uint32_t page_programs; /**< Comandos de programacion de pagina */
+	uint32_t erases; /**< Comandos de borrado */
+	uint32_t page_overruns; /**< Programaciones que cruzaron un limite de pagina */
+	uint32_t protocol_errors; /**< Comandos con la memoria ocupada, sin habilitar la escritura o sobre bits en cero */
+}nor_sim_stats_t;
+
+extern uint8_t nor_sim_memory[NOR_SIM_SIZE]; //!< Contenido de la memoria simulada
+extern nor_sim_stats_t nor_sim_stats; //!< Estadisticas de la memoria simulada
+
+/**
+ * @brief Borrar la memoria simulada y sus estadisticas
+ * @param[in] busy_polls Lecturas del registro de estado que la memoria permanece ocupada luego de cada operacion
+ */
+void nor_sim_reset(uint32_t busy_polls);
+
+#endif /* NOR_SIM_H_ */
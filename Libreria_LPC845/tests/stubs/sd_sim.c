@@ -0,0 +1,668 @@
+/**
+ * @file sd_sim.c
+ * @brief Tarjeta SD en modo SPI simulada para las pruebas de la libreria en la PC
+ *
+ * Reemplaza las transferencias de @ref SPI en modo master por una tarjeta SD que responde byte a byte como una
+ * tarjeta real: la respuesta a cada byte se decide antes de recibirlo, las respuestas llegan luego de *NCR* bytes,
+ * los bloques leidos luego de *NAC* bytes, y las fases de ocupado mantienen MISO en bajo. Verifica el CRC7 de todos
+ * los comandos con una implementacion propia, aunque la tarjeta solo lo exija para *CMD0*, *CMD8* y luego de
+ * *CMD59*.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <string.h>
+#include <HAL_SPI.h>
+#include "sd_sim.h"
+
+/** Bit de estado de inicializacion de la respuesta R1 */
+#define		SD_SIM_R1_IDLE				(1 << 0)
+
+/** Bit de comando invalido de la respuesta R1 */
+#define		SD_SIM_R1_ILLEGAL_COMMAND	(1 << 2)
+
+/** Bit de error de CRC de la respuesta R1 */
+#define		SD_SIM_R1_CRC_ERROR			(1 << 3)
+
+/** Bit de direccion desalineada de la respuesta R1 */
+#define		SD_SIM_R1_ADDRESS_ERROR		(1 << 5)
+
+/** Bit de parametro fuera de rango de la respuesta R1 */
+#define		SD_SIM_R1_PARAMETER_ERROR	(1 << 6)
+
+/** Bit de soporte de tarjetas de alta capacidad del argumento de *ACMD41* */
+#define		SD_SIM_ACMD41_HCS			(1UL << 30)
+
+/** Token de error de lectura: direccion fuera de rango */
+#define		SD_SIM_TOKEN_OUT_OF_RANGE	0x08
+
+/**
+ * Byte transmitido a continuacion de *CMD12*. En una tarjeta real es un resto de la lectura en curso, con cualquier
+ * valor; se elige uno con el bit 7 en cero para que no pueda confundirse con la espera de la respuesta R1
+ */
+#define		SD_SIM_STUFF_BYTE			0x3C
+
+/** Tamaño de la cola de bytes a transmitir por la tarjeta */
+#define		SD_SIM_QUEUE_SIZE			1024
+
+/** Modo de transferencia de datos */
+typedef enum
+{
+	SD_SIM_MODE_NONE = 0,
+	SD_SIM_MODE_READ,
+	SD_SIM_MODE_WRITE_TOKEN,
+	SD_SIM_MODE_WRITE_DATA
+}sd_sim_mode_en;
+
+uint8_t sd_sim_memory[SD_SIM_BLOCKS][SD_SIM_BLOCK_SIZE];
+sd_sim_stats_t sd_sim_stats;
+uint16_t sd_sim_clock_div;
+uint8_t sd_sim_selected;
+
+static sd_sim_config_t sd_sim_card; //!< Caracteristicas y fallas de la tarjeta
+static hal_spi_clock_mode_en sd_sim_clock_mode; //!< Modo de clock de la ultima configuracion de transmision
+static uint32_t sd_sim_clocks; //!< Bytes transferidos con el slave select inactivo
+static uint8_t sd_sim_spi_mode; //!< La tarjeta recibio *CMD0* y esta en modo SPI
+static uint8_t sd_sim_idle; //!< La tarjeta no termino la inicializacion
+static uint8_t sd_sim_app; //!< El comando anterior fue *CMD55*
+static uint8_t sd_sim_crc_on; //!< Verificacion de CRC habilitada mediante *CMD59*
+static uint32_t sd_sim_init_count; //!< *ACMD41* recibidos
+static uint8_t sd_sim_frame[6]; //!< Trama del comando en curso
+static uint32_t sd_sim_frame_bytes; //!< Bytes recibidos del comando en curso
+static uint8_t sd_sim_queue[SD_SIM_QUEUE_SIZE]; //!< Bytes a transmitir por la tarjeta
+static uint32_t sd_sim_queue_head; //!< Indice de lectura de la cola
+static uint32_t sd_sim_queue_tail; //!< Indice de escritura de la cola
+static uint32_t sd_sim_busy; //!< Bytes de ocupado restantes, a transmitir al vaciarse la cola
+static uint32_t sd_sim_gap; //!< Bytes restantes antes del token del proximo bloque leido
+static sd_sim_mode_en sd_sim_mode; //!< Modo de transferencia de datos
+static uint32_t sd_sim_block; //!< Proximo bloque a leer o escribir
+static uint8_t sd_sim_buffer[SD_SIM_BLOCK_SIZE + 2]; //!< Bloque escrito en curso, con su CRC
+static uint32_t sd_sim_buffer_bytes; //!< Bytes recibidos del bloque escrito en curso
+
+void sd_sim_reset(const sd_sim_config_t *config)
+{
+	memset(&sd_sim_stats, 0, sizeof(sd_sim_stats));
+
+	sd_sim_card = *config;
+	sd_sim_clock_div = 0;
+	sd_sim_clock_mode = HAL_SPI_CLOCK_MODE_0;
+	sd_sim_selected = 0;
+	sd_sim_clocks = 0;
+	sd_sim_spi_mode = 0;
+	sd_sim_idle = 1;
+	sd_sim_app = 0;
+	sd_sim_crc_on = 0;
+	sd_sim_init_count = 0;
+	sd_sim_frame_bytes = 0;
+	sd_sim_queue_head = 0;
+	sd_sim_queue_tail = 0;
+	sd_sim_busy = 0;
+	sd_sim_mode = SD_SIM_MODE_NONE;
+}
+
+/**
+ * @brief Calcular el CRC7 de una trama bit a bit, independientemente de la implementacion de la libreria
+ * @param[in] frame Trama de comando (se utilizan los primeros 5 bytes)
+ * @return CRC7 (polinomio x^7 + x^3 + 1)
+ */
+static uint8_t sd_sim_crc7(const uint8_t *frame)
+{
+	uint8_t crc = 0;
+	uint32_t bit;
+
+	for(bit = 0; bit < 40; bit++)
+	{
+		uint8_t feedback = ((crc >> 6) ^ (frame[bit / 8] >> (7 - (bit % 8)))) & 1;
+
+		crc = (crc << 1) & 0x7F;
+
+		if(feedback)
+		{
+			crc ^= 0x09;
+		}
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Calcular el CRC16 de un bloque bit a bit, independientemente de la implementacion de la libreria
+ * @param[in] data Bloque de datos
+ * @return CRC16-CCITT (polinomio x^16 + x^12 + x^5 + 1, valor inicial 0)
+ */
+static uint16_t sd_sim_crc16(const uint8_t *data)
+{
+	uint16_t crc = 0;
+	uint32_t counter;
+	uint8_t bit;
+
+	for(counter = 0; counter < SD_SIM_BLOCK_SIZE; counter++)
+	{
+		crc ^= (uint16_t) (data[counter] << 8);
+
+		for(bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Agregar un byte a transmitir por la tarjeta
+ * @param[in] data Byte a transmitir
+ */
+static void sd_sim_push(uint8_t data)
+{
+	if(sd_sim_queue_tail >= SD_SIM_QUEUE_SIZE)
+	{
+		sd_sim_stats.protocol_errors++;
+		return;
+	}
+
+	sd_sim_queue[sd_sim_queue_tail++] = data;
+}
+
+/**
+ * @brief Encolar la respuesta a un comando luego de *NCR* bytes
+ * @param[in] r1 Respuesta R1
+ * @param[in] extra Resto de la respuesta (R3 o R7)
+ * @param[in] length Cantidad de bytes del resto de la respuesta
+ */
+static void sd_sim_respond(uint8_t r1, const uint8_t *extra, uint32_t length)
+{
+	uint32_t counter;
+
+	for(counter = 0; counter < sd_sim_card.response_bytes; counter++)
+	{
+		sd_sim_push(0xFF);
+	}
+
+	sd_sim_push(r1);
+
+	for(counter = 0; counter < length; counter++)
+	{
+		sd_sim_push(extra[counter]);
+	}
+}
+
+/**
+ * @brief Convertir el argumento de direccion de un comando en numero de bloque
+ * @param[in] argument Argumento del comando
+ * @param[out] block Numero de bloque
+ * @return Bits de error de la respuesta R1
+ */
+static uint8_t sd_sim_address(uint32_t argument, uint32_t *block)
+{
+	if(!sd_sim_card.high_capacity)
+	{
+		// Las tarjetas SDSC se direccionan por byte
+		if(argument % SD_SIM_BLOCK_SIZE)
+		{
+			return SD_SIM_R1_ADDRESS_ERROR;
+		}
+
+		argument /= SD_SIM_BLOCK_SIZE;
+	}
+
+	if(argument >= SD_SIM_BLOCKS)
+	{
+		return SD_SIM_R1_PARAMETER_ERROR;
+	}
+
+	*block = argument;
+
+	return 0;
+}
+
+/**
+ * @brief Ejecutar el comando recibido y encolar su respuesta
+ */
+static void sd_sim_command(void)
+{
+	uint8_t index = sd_sim_frame[0] & 0x3F;
+	uint32_t argument = ((uint32_t) sd_sim_frame[1] << 24) | (sd_sim_frame[2] << 16) | (sd_sim_frame[3] << 8) |
+			sd_sim_frame[4];
+	uint8_t app = sd_sim_app;
+	uint8_t crc_error = 0;
+	uint8_t extra[4];
+	uint32_t length = 0;
+	uint8_t r1 = 0;
+
+	sd_sim_app = 0;
+
+	memcpy(sd_sim_stats.frames[index], sd_sim_frame, sizeof(sd_sim_frame));
+
+	if(app)
+	{
+		sd_sim_stats.app_commands[index]++;
+	}
+	else
+	{
+		sd_sim_stats.commands[index]++;
+	}
+
+	if(!(sd_sim_frame[5] & 1))
+	{
+		sd_sim_stats.framing_errors++;
+	}
+
+	if((sd_sim_frame[5] >> 1) != sd_sim_crc7(sd_sim_frame))
+	{
+		sd_sim_stats.crc7_errors++;
+		crc_error = 1;
+	}
+
+	// Fuera del modo SPI solo se reconoce CMD0 con CRC valido, luego de al menos 74 ciclos de clock
+	if(!sd_sim_spi_mode)
+	{
+		if((index != 0) || crc_error || (sd_sim_clocks < 10))
+		{
+			return;
+		}
+
+		sd_sim_spi_mode = 1;
+	}
+
+	// La inicializacion debe hacerse a lo sumo a 400KHz, y siempre en modo 0
+	if((sd_sim_clock_mode != HAL_SPI_CLOCK_MODE_0) || (sd_sim_idle && (sd_sim_clock_div < SD_SIM_INIT_CLOCK_DIV)))
+	{
+		sd_sim_stats.protocol_errors++;
+	}
+
+	if((sd_sim_mode == SD_SIM_MODE_READ) && (index != 12))
+	{
+		sd_sim_stats.protocol_errors++;
+	}
+
+	// CMD0 y CMD8 se verifican siempre, el resto solo con el CRC habilitado
+	if(crc_error && (sd_sim_crc_on || (index == 0) || (index == 8)))
+	{
+		sd_sim_respond(SD_SIM_R1_CRC_ERROR | (sd_sim_idle ? SD_SIM_R1_IDLE : 0), NULL, 0);
+		return;
+	}
+
+	if(app && (index == 41))
+	{
+		if(sd_sim_card.mmc)
+		{
+			r1 = SD_SIM_R1_ILLEGAL_COMMAND;
+		}
+		else if((!sd_sim_card.high_capacity || (argument & SD_SIM_ACMD41_HCS)) &&
+				(++sd_sim_init_count >= sd_sim_card.init_polls))
+		{
+			// Una tarjeta SDHC no termina la inicializacion si el host no indica soporte de alta capacidad
+			sd_sim_idle = 0;
+		}
+	}
+	else if(app && (index == 23) && !sd_sim_idle)
+	{
+		sd_sim_stats.erase_count = argument;
+	}
+	else
+	{
+		switch(index)
+		{
+		case 0:
+		{
+			sd_sim_idle = 1;
+			sd_sim_crc_on = 0;
+			sd_sim_init_count = 0;
+			break;
+		}
+		case 8:
+		{
+			if(sd_sim_card.version_1)
+			{
+				r1 = SD_SIM_R1_ILLEGAL_COMMAND;
+				break;
+			}
+
+			// Respuesta R7: eco de la tension aceptada y del patron de verificacion
+			extra[0] = 0x00;
+			extra[1] = 0x00;
+			extra[2] = sd_sim_card.voltage_rejected ? 0x00 : ((argument >> 8) & 0x0F);
+			extra[3] = (uint8_t) argument;
+			length = 4;
+			break;
+		}
+		case 55: { sd_sim_app = 1; break; }
+		case 58:
+		{
+			// Respuesta R3: el bit de alta capacidad solo es valido terminada la inicializacion
+			extra[0] = sd_sim_idle ? 0x00 : (0x80 | (sd_sim_card.high_capacity ? 0x40 : 0x00));
+			extra[1] = 0xFF;
+			extra[2] = 0x80;
+			extra[3] = 0x00;
+			length = 4;
+			break;
+		}
+		case 59: { sd_sim_crc_on = argument & 1; break; }
+		case 16:
+		{
+			if(sd_sim_idle)
+			{
+				r1 = SD_SIM_R1_ILLEGAL_COMMAND;
+			}
+			else if(argument != SD_SIM_BLOCK_SIZE)
+			{
+				r1 = SD_SIM_R1_PARAMETER_ERROR;
+			}
+
+			break;
+		}
+		case 18:
+		case 25:
+		{
+			if(sd_sim_idle)
+			{
+				r1 = SD_SIM_R1_ILLEGAL_COMMAND;
+				break;
+			}
+
+			r1 = sd_sim_address(argument, &sd_sim_block);
+
+			if(r1 == 0)
+			{
+				sd_sim_mode = (index == 18) ? SD_SIM_MODE_READ : SD_SIM_MODE_WRITE_TOKEN;
+				sd_sim_gap = sd_sim_card.access_bytes;
+			}
+
+			break;
+		}
+		case 12:
+		{
+			if(sd_sim_idle)
+			{
+				r1 = SD_SIM_R1_ILLEGAL_COMMAND;
+				break;
+			}
+
+			// Se descarta el resto del bloque en curso
+			sd_sim_queue_head = 0;
+			sd_sim_queue_tail = 0;
+			sd_sim_push(SD_SIM_STUFF_BYTE);
+			sd_sim_mode = SD_SIM_MODE_NONE;
+			sd_sim_busy = sd_sim_card.busy_bytes;
+			break;
+		}
+		default: { r1 = SD_SIM_R1_ILLEGAL_COMMAND; break; }
+		}
+	}
+
+	sd_sim_respond(r1 | (sd_sim_idle ? SD_SIM_R1_IDLE : 0), extra, length);
+}
+
+/**
+ * @brief Encolar el proximo bloque de una lectura de multiples bloques
+ */
+static void sd_sim_read_next(void)
+{
+	uint16_t crc;
+	uint32_t counter;
+
+	if(sd_sim_block >= SD_SIM_BLOCKS)
+	{
+		sd_sim_push(SD_SIM_TOKEN_OUT_OF_RANGE);
+		sd_sim_mode = SD_SIM_MODE_NONE;
+		return;
+	}
+
+	crc = sd_sim_crc16(sd_sim_memory[sd_sim_block]);
+
+	if(sd_sim_block == sd_sim_card.read_crc_block)
+	{
+		crc ^= 0x0001;
+	}
+
+	sd_sim_push(0xFE);
+
+	for(counter = 0; counter < SD_SIM_BLOCK_SIZE; counter++)
+	{
+		sd_sim_push(sd_sim_memory[sd_sim_block][counter]);
+	}
+
+	sd_sim_push((uint8_t) (crc >> 8));
+	sd_sim_push((uint8_t) crc);
+
+	sd_sim_block++;
+	sd_sim_gap = sd_sim_card.access_bytes;
+}
+
+/**
+ * @brief Recibir un byte durante una escritura de multiples bloques
+ * @param[in] data Byte recibido
+ */
+static void sd_sim_write_byte(uint8_t data)
+{
+	uint16_t crc;
+
+	if(sd_sim_mode == SD_SIM_MODE_WRITE_DATA)
+	{
+		sd_sim_buffer[sd_sim_buffer_bytes++] = data;
+
+		if(sd_sim_buffer_bytes < sizeof(sd_sim_buffer))
+		{
+			return;
+		}
+
+		sd_sim_mode = SD_SIM_MODE_WRITE_TOKEN;
+		crc = (sd_sim_buffer[SD_SIM_BLOCK_SIZE] << 8) | sd_sim_buffer[SD_SIM_BLOCK_SIZE + 1];
+
+		// Respuesta de datos: xxx0sss1, con los bits superiores indefinidos
+		if(sd_sim_crc_on && (crc != sd_sim_crc16(sd_sim_buffer)))
+		{
+			sd_sim_stats.data_crc_errors++;
+			sd_sim_push(0xEB);
+		}
+		else if(sd_sim_block == sd_sim_card.write_crc_block)
+		{
+			sd_sim_push(0xEB);
+		}
+		else if((sd_sim_block == sd_sim_card.write_reject_block) || (sd_sim_block >= SD_SIM_BLOCKS))
+		{
+			sd_sim_push(0xED);
+		}
+		else
+		{
+			memcpy(sd_sim_memory[sd_sim_block++], sd_sim_buffer, SD_SIM_BLOCK_SIZE);
+			sd_sim_stats.blocks_written++;
+			sd_sim_push(0xE5);
+			sd_sim_busy = sd_sim_card.busy_bytes;
+		}
+
+		return;
+	}
+
+	// Esperando un token la tarjeta ignora los bytes en 0xFF
+	if(data == 0xFF)
+	{
+		return;
+	}
+
+	if((sd_sim_busy != 0) || (sd_sim_queue_head != sd_sim_queue_tail))
+	{
+		sd_sim_stats.protocol_errors++;
+	}
+
+	if(data == 0xFC)
+	{
+		sd_sim_stats.start_tokens++;
+		sd_sim_buffer_bytes = 0;
+		sd_sim_mode = SD_SIM_MODE_WRITE_DATA;
+	}
+	else if(data == 0xFD)
+	{
+		// Un byte antes de indicar ocupado
+		sd_sim_stats.stop_tokens++;
+		sd_sim_push(0xFF);
+		sd_sim_busy = sd_sim_card.busy_bytes;
+		sd_sim_mode = SD_SIM_MODE_NONE;
+	}
+	else
+	{
+		sd_sim_stats.protocol_errors++;
+	}
+}
+
+/**
+ * @brief Obtener el proximo byte a transmitir por la tarjeta
+ * @return Byte transmitido
+ */
+static uint8_t sd_sim_output(void)
+{
+	if(sd_sim_queue_head == sd_sim_queue_tail)
+	{
+		sd_sim_queue_head = 0;
+		sd_sim_queue_tail = 0;
+
+		if(sd_sim_busy != 0)
+		{
+			sd_sim_busy--;
+			return 0x00;
+		}
+
+		if(sd_sim_mode == SD_SIM_MODE_READ)
+		{
+			if(sd_sim_gap != 0)
+			{
+				sd_sim_gap--;
+				return 0xFF;
+			}
+
+			sd_sim_read_next();
+		}
+	}
+
+	if(sd_sim_queue_head != sd_sim_queue_tail)
+	{
+		return sd_sim_queue[sd_sim_queue_head++];
+	}
+
+	return 0xFF;
+}
+
+/**
+ * @brief Transferir un byte con la tarjeta seleccionada
+ *
+ * Como en una tarjeta real, el byte transmitido no depende del byte recibido al mismo tiempo.
+ *
+ * @param[in] data Byte recibido por la tarjeta
+ * @return Byte transmitido por la tarjeta
+ */
+static uint8_t sd_sim_byte(uint8_t data)
+{
+	uint8_t output = sd_sim_output();
+
+	sd_sim_stats.bytes++;
+
+	if((sd_sim_mode == SD_SIM_MODE_WRITE_TOKEN) || (sd_sim_mode == SD_SIM_MODE_WRITE_DATA))
+	{
+		sd_sim_write_byte(data);
+		return output;
+	}
+
+	if(sd_sim_frame_bytes == 0)
+	{
+		// Los comandos comienzan con los bits 01
+		if((data & 0xC0) != 0x40)
+		{
+			return output;
+		}
+
+		if(sd_sim_busy != 0)
+		{
+			sd_sim_stats.protocol_errors++;
+		}
+	}
+
+	sd_sim_frame[sd_sim_frame_bytes++] = data;
+
+	if(sd_sim_frame_bytes == sizeof(sd_sim_frame))
+	{
+		sd_sim_frame_bytes = 0;
+		sd_sim_command();
+	}
+
+	return output;
+}
+
+/**
+ * @brief Desactivar el slave select de la tarjeta
+ */
+static void sd_sim_deselect(void)
+{
+	if(!sd_sim_selected)
+	{
+		return;
+	}
+
+	sd_sim_selected = 0;
+
+	// Las transferencias y fases de ocupado deben terminarse antes de liberar la tarjeta
+	if((sd_sim_mode != SD_SIM_MODE_NONE) || (sd_sim_busy != 0) || (sd_sim_frame_bytes != 0))
+	{
+		sd_sim_stats.protocol_errors++;
+	}
+
+	sd_sim_mode = SD_SIM_MODE_NONE;
+	sd_sim_frame_bytes = 0;
+	sd_sim_queue_head = 0;
+	sd_sim_queue_tail = 0;
+}
+
+void hal_spi_master_mode_transfer(hal_spi_sel_en inst, hal_spi_ssel_sel_en ssel, const uint8_t *tx, uint8_t *rx,
+		uint32_t length, uint8_t end_of_transfer)
+{
+	uint32_t counter;
+
+	(void) inst;
+
+	for(counter = 0; counter < length; counter++)
+	{
+		uint8_t data = 0xFF;
+
+		if(ssel == HAL_SPI_SSEL_SELECTION_OTHER)
+		{
+			sd_sim_deselect();
+			sd_sim_clocks++;
+		}
+		else
+		{
+			sd_sim_selected = 1;
+
+			if(sd_sim_card.present)
+			{
+				data = sd_sim_byte((tx != NULL) ? tx[counter] : HAL_SPI_DUMMY_BYTE);
+			}
+		}
+
+		if(rx != NULL)
+		{
+			rx[counter] = data;
+		}
+	}
+
+	if(end_of_transfer)
+	{
+		sd_sim_deselect();
+	}
+}
+
+void hal_spi_master_mode_end_transfer(hal_spi_sel_en inst)
+{
+	(void) inst;
+
+	sd_sim_deselect();
+}
+
+void hal_spi_master_mode_tx_config(hal_spi_sel_en inst, const hal_spi_master_mode_tx_config_t *config)
+{
+	(void) inst;
+
+	sd_sim_clock_div = config->clock_div;
+	sd_sim_clock_mode = config->clock_mode;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file sd_sim.h
+ * @brief Tarjeta SD en modo SPI simulada para las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef SD_SIM_H_
+#define SD_SIM_H_
+
+#include <stdint.h>
+
+/** Cantidad de bloques de la tarjeta simulada */
+#define		SD_SIM_BLOCKS				256
+
+/** Tamaño de bloque de la tarjeta simulada */
+#define		SD_SIM_BLOCK_SIZE			512
+
+/** Minimo divisor de clock durante la inicializacion (400KHz con 30MHz de clock de SPI) */
+#define		SD_SIM_INIT_CLOCK_DIV		75
+
+/** Valor de los campos de bloque de @ref sd_sim_config_t que no inyectan fallas */
+#define		SD_SIM_NO_BLOCK				0xFFFFFFFF
+
+/** Caracteristicas y fallas de la tarjeta simulada */
+typedef struct
+{
+	uint8_t present; /**< Distinto de cero si hay una tarjeta conectada */
+	uint8_t version_1; /**< Distinto de cero para una tarjeta version 1.x, que no reconoce *CMD8* */
+	uint8_t high_capacity; /**< Distinto de cero para una tarjeta SDHC, con direccionamiento por bloque */
+	uint8_t voltage_rejected; /**< Distinto de cero si la tarjeta no acepta la tension pedida en *CMD8* */
+	uint8_t mmc; /**< Distinto de cero para una tarjeta MMC, que no reconoce *ACMD41* */
+	uint32_t init_polls; /**< Cantidad de *ACMD41* hasta que la tarjeta termina la inicializacion */
+	uint32_t response_bytes; /**< Bytes entre el fin de un comando y su respuesta (*NCR*) */
+	uint32_t access_bytes; /**< Bytes antes del token de cada bloque leido (*NAC*) */
+	uint32_t busy_bytes; /**< Bytes de ocupado luego de cada bloque escrito y de cada fin de transferencia */
+	uint32_t read_crc_block; /**< Bloque que se lee con el CRC alterado */
+	uint32_t write_reject_block; /**< Bloque cuya escritura se responde con error de escritura */
+	uint32_t write_crc_block; /**< Bloque cuya escritura se responde con error de CRC */
+}sd_sim_config_t;
+
+/** Estadisticas de la tarjeta simulada */
+typedef struct
+{
+	uint32_t commands[64]; /**< Comandos recibidos, por indice */
+	uint32_t app_commands[64]; /**< Comandos de aplicacion recibidos, por indice */
+	uint8_t frames[64][6]; /**< Ultima trama recibida de cada indice de comando */
+	uint32_t crc7_errors; /**< Comandos con el CRC7 incorrecto */
+	uint32_t framing_errors; /**< Comandos sin el bit de fin */
+	uint32_t start_tokens; /**< Tokens de inicio de bloque escrito */
+	uint32_t stop_tokens; /**< Tokens de fin de escritura */
+	uint32_t blocks_written; /**< Bloques escritos y aceptados */
+	uint32_t data_crc_errors; /**< Bloques escritos con el CRC16 incorrecto, con el CRC habilitado */
+	uint32_t erase_count; /**< Argumento del ultimo *ACMD23* */
+	uint32_t bytes; /**< Bytes transferidos con la tarjeta seleccionada */
+	uint32_t protocol_errors; /**< Bytes o comandos fuera de secuencia, o durante una fase de ocupado */
+}sd_sim_stats_t;
+
+extern uint8_t sd_sim_memory[SD_SIM_BLOCKS][SD_SIM_BLOCK_SIZE]; //!< Contenido de la tarjeta simulada
+extern sd_sim_stats_t sd_sim_stats; //!< Estadisticas de la tarjeta simulada
+extern uint16_t sd_sim_clock_div; //!< Divisor de clock de la ultima configuracion de transmision
+extern uint8_t sd_sim_selected; //!< Distinto de cero con el slave select de la tarjeta activo
+
+/**
+ * @brief Reiniciar la tarjeta simulada y sus estadisticas, sin modificar su contenido
+ * @param[in] config Caracteristicas y fallas de la tarjeta
+ */
+void sd_sim_reset(const sd_sim_config_t *config);
+
+#endif /* SD_SIM_H_ */
@@ -0,0 +1,23 @@
+/**
+ * @file test.h
+ * @brief Macros de verificacion de las pruebas de la libreria en la PC
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+extern unsigned int test_failures; //!< Cantidad de verificaciones fallidas
+
+/** Verificar una condicion, informando el archivo y la linea si no se cumple */
+#define		TEST_CHECK(cond, ...)		do { if(!(cond)) { test_failures++; \
+										printf("%s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } } while(0)
+
+/** Informar el resultado y devolver el codigo de salida */
+#define		TEST_EXIT(name)				(printf("%s: %s\n", (name), test_failures ? "FALLO" : "ok"), (test_failures != 0))
+
+#endif /* TEST_H_ */
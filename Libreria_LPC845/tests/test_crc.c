@@ -0,0 +1,288 @@
+/**
+ * @file test_crc.c
+ * @brief Prueba en la PC del calculo de CRC incremental y por DMA
+ *
+ * Los resultados de @ref hal_crc_update (en fragmentos de distintos tamaños) y de @ref hal_crc_dma_start se comparan
+ * con un CRC por software sobre el mismo bloque, para todos los desplazamientos de la direccion inicial respecto de
+ * la alineacion a 32 bits y largos con bytes finales no alineados, incluyendo bloques de mas de una transferencia de
+ * DMA.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <HAL_CRC.h>
+#include "crc_sim.h"
+#include "test.h"
+
+/** Tamaño del bloque de datos de prueba */
+#define		CRC_BUFFER_SIZE				10000
+
+/** Canal de DMA utilizado */
+#define		CRC_DMA_CHANNEL				3
+
+/** Maxima cantidad de llamados a @ref hal_crc_dma_process por calculo */
+#define		CRC_DMA_MAX_POLLS			1000
+
+/** Configuracion de prueba y su descripcion */
+typedef struct
+{
+	hal_crc_config_t config; /**< Configuracion */
+	const char *name; /**< Nombre, para el informe */
+	uint32_t check; /**< CRC de "123456789" */
+}crc_case_t;
+
+unsigned int test_failures;
+
+static const crc_case_t crc_cases[] = {
+		{ HAL_CRC_CONFIG_CRC32, "CRC-32", 0xCBF43926 },
+		{ HAL_CRC_CONFIG_CCITT_FALSE, "CCITT-FALSE", 0x29B1 },
+		{ HAL_CRC_CONFIG_XMODEM, "XMODEM", 0x31C3 },
+		{ HAL_CRC_CONFIG_MODBUS, "MODBUS", 0x4B37 },
+		// CRC-32/BZIP2: sin inversion de bits
+		{ { HAL_CRC_POLYNOMIAL_CRC32, 0, 0, 0, 1, 0xFFFFFFFF }, "CRC-32/BZIP2", 0xFC891918 },
+		// Entrada complementada e inversion solo de la entrada, sin valor de verificacion publicado
+		{ { HAL_CRC_POLYNOMIAL_CRC16, 1, 1, 0, 0, 0x1234 }, "CRC-16 mixto", 0 },
+};
+
+static const uint32_t crc_lengths[] = {
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 63, 64, 65, 255,
+		4095, 4096, 4097, 4098, 4099, 4100, 8191, 8192, 8193, 9001, CRC_BUFFER_SIZE - 4
+};
+
+static uint32_t crc_buffer_words[(CRC_BUFFER_SIZE / sizeof(uint32_t)) + 1]; //!< Datos de prueba, alineados a 32 bits
+
+/**
+ * @brief Invertir el orden de los bits de un valor
+ * @param[in] value Valor
+ * @param[in] width Cantidad de bits
+ * @return Valor invertido
+ */
+static uint32_t crc_reflect(uint32_t value, uint8_t width)
+{
+	uint32_t result = 0;
+	uint8_t bit;
+
+	for(bit = 0; bit < width; bit++)
+	{
+		result = (result << 1) | ((value >> bit) & 1);
+	}
+
+	return result;
+}
+
+/**
+ * @brief Calcular un CRC por software (modelo de Williams)
+ *
+ * Con la entrada invertida se utiliza el algoritmo desplazando a la derecha con el polinomio invertido, y sin
+ * inversion el algoritmo desplazando a la izquierda.
+ *
+ * @param[in] config Configuracion
+ * @param[in] data Datos
+ * @param[in] length Cantidad de bytes
+ * @return CRC
+ */
+static uint32_t crc_reference(const hal_crc_config_t *config, const uint8_t *data, uint32_t length)
+{
+	static const uint32_t polynomials[] = { 0x1021, 0x8005, 0x04C11DB7 };
+	uint8_t width = (config->polynomial == HAL_CRC_POLYNOMIAL_CRC32) ? 32 : 16;
+	uint32_t mask = (width == 32) ? 0xFFFFFFFF : ((1UL << width) - 1);
+	uint32_t polynomial = polynomials[config->polynomial];
+	uint32_t crc = config->seed & mask;
+	uint32_t counter;
+	uint8_t bit;
+
+	if(config->reverse_input)
+	{
+		polynomial = crc_reflect(polynomial, width);
+		crc = crc_reflect(crc, width);
+	}
+
+	for(counter = 0; counter < length; counter++)
+	{
+		uint8_t byte = config->complement_input ? (uint8_t) ~data[counter] : data[counter];
+
+		if(config->reverse_input)
+		{
+			crc ^= byte;
+
+			for(bit = 0; bit < 8; bit++)
+			{
+				crc = (crc & 1) ? ((crc >> 1) ^ polynomial) : (crc >> 1);
+			}
+		}
+		else
+		{
+			crc ^= (uint32_t) byte << (width - 8);
+
+			for(bit = 0; bit < 8; bit++)
+			{
+				crc = (crc & (1UL << (width - 1))) ? ((crc << 1) ^ polynomial) : (crc << 1);
+			}
+
+			crc &= mask;
+		}
+	}
+
+	// El registro del algoritmo invertido ya esta invertido respecto del registro del periferico
+	if(config->reverse_input != config->reverse_output)
+	{
+		crc = crc_reflect(crc, width);
+	}
+
+	if(config->complement_output)
+	{
+		crc = ~crc;
+	}
+
+	return crc & mask;
+}
+
+/**
+ * @brief Calcular mediante fragmentos de tamaño pseudoaleatorio
+ * @param[in] config Configuracion
+ * @param[in] data Datos
+ * @param[in] length Cantidad de bytes
+ * @param[in] max_chunk Maximo tamaño de cada fragmento
+ * @return CRC
+ */
+static uint32_t crc_incremental(const hal_crc_config_t *config, const uint8_t *data, uint32_t length, uint32_t max_chunk)
+{
+	hal_crc_start(config);
+
+	while(length != 0)
+	{
+		uint32_t chunk = 1 + (rand() % max_chunk);
+
+		if(chunk > length)
+		{
+			chunk = length;
+		}
+
+		hal_crc_update(data, chunk);
+
+		data += chunk;
+		length -= chunk;
+	}
+
+	return hal_crc_get();
+}
+
+/**
+ * @brief Calcular por DMA, con bytes previos y posteriores agregados en forma incremental
+ * @param[in] config Configuracion
+ * @param[in] data Datos
+ * @param[in] length Cantidad de bytes
+ * @param[in] prefix Bytes iniciales agregados con @ref hal_crc_update
+ * @param[in] suffix Bytes finales agregados con @ref hal_crc_update
+ * @param[out] crc CRC
+ * @return Distinto de cero si el calculo termino
+ */
+static uint8_t crc_dma(const hal_crc_config_t *config, const uint8_t *data, uint32_t length, uint32_t prefix,
+		uint32_t suffix, uint32_t *crc)
+{
+	uint32_t polls = 0;
+
+	hal_crc_start(config);
+	hal_crc_update(data, prefix);
+	hal_crc_dma_start(CRC_DMA_CHANNEL, data + prefix, length - prefix - suffix);
+
+	while(hal_crc_dma_process() != HAL_CRC_DMA_STATUS_DONE)
+	{
+		if(++polls == CRC_DMA_MAX_POLLS)
+		{
+			return 0;
+		}
+	}
+
+	hal_crc_update(data + length - suffix, suffix);
+	*crc = hal_crc_get();
+
+	return !dma_sim_busy();
+}
+
+int main(void)
+{
+	const uint8_t *buffer = (const uint8_t *) crc_buffer_words;
+	uint8_t *fill = (uint8_t *) crc_buffer_words;
+	uint32_t words_before;
+	uint32_t counter;
+	uint8_t config;
+
+	srand(845);
+
+	for(counter = 0; counter < sizeof(crc_buffer_words); counter++)
+	{
+		fill[counter] = rand();
+	}
+
+	hal_crc_init();
+
+	for(config = 0; config < (sizeof(crc_cases) / sizeof(crc_cases[0])); config++)
+	{
+		const crc_case_t *test = &crc_cases[config];
+		uint8_t length_index;
+		uint8_t offset;
+
+		// La referencia se valida con el valor de verificacion publicado
+		if(test->check != 0)
+		{
+			TEST_CHECK(crc_reference(&test->config, (const uint8_t *) "123456789", 9) == test->check,
+					"%s: referencia 0x%08X, verificacion 0x%08X", test->name,
+					crc_reference(&test->config, (const uint8_t *) "123456789", 9), test->check);
+			TEST_CHECK(hal_crc_compute(&test->config, "123456789", 9) == test->check,
+					"%s: hal_crc_compute 0x%08X, verificacion 0x%08X", test->name,
+					hal_crc_compute(&test->config, "123456789", 9), test->check);
+		}
+
+		for(offset = 0; offset < sizeof(uint32_t); offset++)
+		{
+			for(length_index = 0; length_index < (sizeof(crc_lengths) / sizeof(crc_lengths[0])); length_index++)
+			{
+				uint32_t length = crc_lengths[length_index];
+				const uint8_t *data = buffer + offset;
+				uint32_t expected = crc_reference(&test->config, data, length);
+				uint32_t result;
+				uint32_t prefix;
+
+				result = hal_crc_compute(&test->config, data, length);
+				TEST_CHECK(result == expected, "%s: compute desplazamiento %u largo %u: 0x%08X, se esperaba 0x%08X",
+						test->name, offset, length, result, expected);
+
+				result = crc_incremental(&test->config, data, length, 7);
+				TEST_CHECK(result == expected, "%s: update desplazamiento %u largo %u: 0x%08X, se esperaba 0x%08X",
+						test->name, offset, length, result, expected);
+
+				result = crc_incremental(&test->config, data, length, 300);
+				TEST_CHECK(result == expected, "%s: update desplazamiento %u largo %u: 0x%08X, se esperaba 0x%08X",
+						test->name, offset, length, result, expected);
+
+				for(prefix = 0; (prefix < 3) && ((2 * prefix) <= length); prefix++)
+				{
+					words_before = dma_sim_words_transferred();
+
+					TEST_CHECK(crc_dma(&test->config, data, length, prefix, prefix, &result),
+							"%s: DMA desplazamiento %u largo %u: no termina", test->name, offset, length);
+					TEST_CHECK(result == expected, "%s: DMA desplazamiento %u largo %u extremos %u: 0x%08X, se esperaba 0x%08X",
+							test->name, offset, length, prefix, result, expected);
+
+					// Todas las palabras alineadas del bloque deben transferirse por DMA
+					if((length - (2 * prefix)) >= (2 * sizeof(uint32_t)))
+					{
+						TEST_CHECK((dma_sim_words_transferred() - words_before) >= ((length - (2 * prefix)) / sizeof(uint32_t)) - 1,
+								"%s: DMA desplazamiento %u largo %u: solo %u palabras por DMA", test->name, offset, length,
+								dma_sim_words_transferred() - words_before);
+					}
+				}
+			}
+		}
+	}
+
+	TEST_CHECK(crc_sim_concurrent_writes() == 0, "%u escrituras del CPU durante transferencias de DMA o transferencias invalidas",
+			crc_sim_concurrent_writes());
+
+	return TEST_EXIT("test_crc");
+}
@@ -0,0 +1,121 @@
+/**
+ * @file test_div.c
+ * @brief Prueba en la PC de las rutinas de división entera a través de la tabla de drivers en ROM
+ *
+ * Las funciones de la HAL se llaman a través de la capa HPL real y de una tabla de punteros a función con la firma
+ * de las rutinas de la ROM, y sus resultados se comparan con los operadores de C.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <HAL_DIV.h>
+#include <HRI_DIV.h>
+#include "test.h"
+
+/** Cantidad de pares numerador/divisor aleatorios */
+#define		DIV_RANDOM_CASES			100000
+
+// Las rutinas con resto de la ROM devuelven cociente y resto en r0 y r1, no una estructura a traves de un puntero
+_Static_assert(__builtin_types_compatible_p(__typeof__(((DIV_rom_api_t *) 0)->uidivmod),
+		uint64_t (*)(uint32_t, uint32_t)), "firma de uidivmod distinta a la de la ROM");
+_Static_assert(__builtin_types_compatible_p(__typeof__(((DIV_rom_api_t *) 0)->sidivmod),
+		uint64_t (*)(int32_t, int32_t)), "firma de sidivmod distinta a la de la ROM");
+
+unsigned int test_failures;
+
+/**
+ * @brief Numero aleatorio de 32 bits, con distinta cantidad de bits significativos
+ * @return Numero aleatorio
+ */
+static uint32_t div_random(void)
+{
+	uint32_t value = ((uint32_t) rand() << 16) ^ (uint32_t) rand() ^ ((uint32_t) rand() << 31);
+
+	return value >> (rand() % 32);
+}
+
+/**
+ * @brief Verificar las divisiones de 32 bits para un par numerador/divisor
+ * @param[in] numerator Numerador
+ * @param[in] denominator Divisor, distinto de cero
+ */
+static void div_check_32(uint32_t numerator, uint32_t denominator)
+{
+	hal_div_unsigned_result_t unsigned_result = hal_div_unsigned_divmod(numerator, denominator);
+	int32_t signed_numerator = (int32_t) numerator;
+	int32_t signed_denominator = (int32_t) denominator;
+	hal_div_reciprocal_t reciprocal;
+
+	TEST_CHECK(hal_div_unsigned(numerator, denominator) == numerator / denominator, "%u / %u", numerator, denominator);
+	TEST_CHECK((unsigned_result.quot == numerator / denominator) && (unsigned_result.rem == numerator % denominator),
+			"%u divmod %u: %u, %u", numerator, denominator, unsigned_result.quot, unsigned_result.rem);
+
+	TEST_CHECK(hal_div_reciprocal_init(&reciprocal, denominator) == HAL_DIV_RESULT_OK, "reciproco de %u", denominator);
+	TEST_CHECK(hal_div_reciprocal_apply(&reciprocal, numerator) == numerator / denominator, "%u / reciproco de %u",
+			numerator, denominator);
+
+	// La division con signo de INT32_MIN por -1 no esta definida
+	if((signed_numerator != INT32_MIN) || (signed_denominator != -1))
+	{
+		hal_div_signed_result_t signed_result = hal_div_signed_divmod(signed_numerator, signed_denominator);
+
+		TEST_CHECK(hal_div_signed(signed_numerator, signed_denominator) == signed_numerator / signed_denominator,
+				"%d / %d", signed_numerator, signed_denominator);
+		TEST_CHECK((signed_result.quot == signed_numerator / signed_denominator) &&
+				(signed_result.rem == signed_numerator % signed_denominator), "%d divmod %d: %d, %d", signed_numerator,
+				signed_denominator, signed_result.quot, signed_result.rem);
+	}
+}
+
+/**
+ * @brief Verificar la division de 64 bits para un par numerador/divisor
+ * @param[in] numerator Numerador
+ * @param[in] denominator Divisor, distinto de cero
+ */
+static void div_check_64(uint64_t numerator, uint32_t denominator)
+{
+	uint64_t quot = hal_div_unsigned_64(numerator, denominator);
+
+	TEST_CHECK(quot == numerator / denominator, "%llu / %u: %llu", (unsigned long long) numerator, denominator,
+			(unsigned long long) quot);
+}
+
+int main(void)
+{
+	static const uint32_t edges[] = { 1, 2, 3, 7, 10, 1000, 0xFFFF, 0x10000, 0x10001, 0x7FFFFFFF, 0x80000000,
+			0x80000001, 0xFFFFFFFE, 0xFFFFFFFF };
+	uint32_t numerator;
+	uint32_t denominator;
+	uint32_t counter;
+
+	srand(845);
+
+	for(numerator = 0; numerator < (sizeof(edges) / sizeof(edges[0])); numerator++)
+	{
+		for(denominator = 0; denominator < (sizeof(edges) / sizeof(edges[0])); denominator++)
+		{
+			div_check_32(edges[numerator], edges[denominator]);
+			div_check_64(((uint64_t) edges[numerator] << 32) | edges[denominator], edges[denominator]);
+			div_check_64(((uint64_t) edges[denominator] << 32) | edges[numerator], edges[denominator]);
+		}
+	}
+
+	for(counter = 0; counter < DIV_RANDOM_CASES; counter++)
+	{
+		do
+		{
+			denominator = div_random();
+		}while(denominator == 0);
+
+		div_check_32(div_random(), denominator);
+		div_check_64(((uint64_t) div_random() << 32) | div_random(), denominator);
+	}
+
+	TEST_CHECK(hal_div_reciprocal_init(NULL, 0) == HAL_DIV_RESULT_DIVISION_BY_ZERO, "division por cero");
+
+	return TEST_EXIT("test_div");
+}
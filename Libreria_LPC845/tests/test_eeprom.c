@@ -0,0 +1,225 @@
+/**
+ * @file test_eeprom.c
+ * @brief Prueba en la PC de la recuperacion de la EEPROM emulada ante fallas de la flash
+ *
+ * Se repite una misma secuencia de escrituras (con varias compactaciones) haciendo fallar, en cada repeticion, una
+ * operacion de flash distinta: cada pagina escrita (registros, compactacion y encabezados) y cada borrado. Luego de
+ * la falla se vuelve a inicializar la EEPROM sobre el contenido de la flash, y se verifica que se recuperen los
+ * valores de la ultima grabacion exitosa.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <HAL_EEPROM.h>
+#include "iap_sim.h"
+#include "test.h"
+
+/** Primer sector de la EEPROM */
+#define		EEPROM_FIRST_SECTOR			60
+
+/** Sectores por banco: encabezado y 15 paginas, de las cuales dos se ocupan al compactar */
+#define		EEPROM_BANK_SECTORS			1
+
+/** Cantidad de claves */
+#define		EEPROM_MAX_KEYS				12
+
+/** Cantidad de escrituras de la secuencia */
+#define		EEPROM_STEPS				400
+
+/** Cada cuantas escrituras se fuerza la grabacion de la pagina en curso */
+#define		EEPROM_FLUSH_PERIOD			5
+
+/** Valor de una clave sin valor grabado en el modelo */
+#define		EEPROM_NO_VALUE				0xFFFFFFFFFFFFFFFFULL
+
+unsigned int test_failures;
+
+/** Valores grabados segun el modelo */
+typedef struct
+{
+	uint64_t value[EEPROM_MAX_KEYS]; /**< Valor de cada clave, o @ref EEPROM_NO_VALUE */
+}eeprom_model_t;
+
+/**
+ * @brief Inicializar una EEPROM con la configuracion de la prueba
+ * @param[out] eeprom Estado de la EEPROM
+ * @param[out] index Indice de la EEPROM
+ * @return Resultado de la inicializacion
+ */
+static hal_eeprom_result_en eeprom_open(hal_eeprom_t *eeprom, uint16_t *index)
+{
+	hal_eeprom_config_t config;
+
+	config.first_sector = EEPROM_FIRST_SECTOR;
+	config.bank_sectors = EEPROM_BANK_SECTORS;
+	config.index = index;
+	config.max_keys = EEPROM_MAX_KEYS;
+
+	// El estado previo no debe influir en la inicializacion
+	memset(eeprom, 0xA5, sizeof(*eeprom));
+	memset(index, 0xA5, EEPROM_MAX_KEYS * sizeof(uint16_t));
+
+	return hal_eeprom_init(eeprom, &config);
+}
+
+/**
+ * @brief Tomar los valores leidos de la EEPROM como grabados, si no quedan escrituras pendientes
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[out] model Valores grabados
+ */
+static void eeprom_snapshot(const hal_eeprom_t *eeprom, eeprom_model_t *model)
+{
+	uint32_t value;
+	uint16_t key;
+
+	if(eeprom->staged_count != 0)
+	{
+		return;
+	}
+
+	for(key = 0; key < EEPROM_MAX_KEYS; key++)
+	{
+		model->value[key] = (hal_eeprom_read(eeprom, key, &value) == HAL_EEPROM_RESULT_OK) ? value : EEPROM_NO_VALUE;
+	}
+}
+
+/**
+ * @brief Verificar que la EEPROM contenga los valores del modelo
+ * @param[in] eeprom Estado de la EEPROM
+ * @param[in] model Valores esperados
+ * @param[in] fault Operacion que fallo, para el informe
+ * @param[in] power_loss Modo de la falla, para el informe
+ */
+static void eeprom_check(const hal_eeprom_t *eeprom, const eeprom_model_t *model, uint32_t fault, uint8_t power_loss)
+{
+	hal_eeprom_result_en result;
+	uint32_t value;
+	uint16_t key;
+
+	for(key = 0; key < EEPROM_MAX_KEYS; key++)
+	{
+		result = hal_eeprom_read(eeprom, key, &value);
+
+		if(model->value[key] == EEPROM_NO_VALUE)
+		{
+			TEST_CHECK(result == HAL_EEPROM_RESULT_NOT_FOUND,
+					"falla %u (corte %u): clave %u con valor 0x%08X, se esperaba sin valor", fault, power_loss, key, value);
+		}
+		else
+		{
+			TEST_CHECK((result == HAL_EEPROM_RESULT_OK) && (value == model->value[key]),
+					"falla %u (corte %u): clave %u = 0x%08X (resultado %d), se esperaba 0x%08X",
+					fault, power_loss, key, value, result, (uint32_t) model->value[key]);
+		}
+	}
+}
+
+/**
+ * @brief Ejecutar la secuencia de escrituras con una falla programada y verificar la recuperacion
+ * @param[in] fault Operacion de flash a fallar, o @ref IAP_SIM_NO_FAULT
+ * @param[in] power_loss Distinto de cero si la falla es un corte de alimentacion, cero si la flash sigue funcionando
+ * @param[out] compactions Compactaciones realizadas por la secuencia. Puede ser NULL
+ * @return Distinto de cero si la falla se produjo
+ */
+static uint8_t eeprom_run(uint32_t fault, uint8_t power_loss, uint32_t *compactions)
+{
+	uint16_t index[EEPROM_MAX_KEYS];
+	hal_eeprom_t eeprom;
+	eeprom_model_t committed;
+	uint32_t step;
+	uint8_t faulted;
+	uint16_t key;
+
+	for(key = 0; key < EEPROM_MAX_KEYS; key++)
+	{
+		committed.value[key] = EEPROM_NO_VALUE;
+	}
+
+	iap_sim_reset();
+	iap_sim_fault(fault, power_loss);
+
+	if(eeprom_open(&eeprom, index) != HAL_EEPROM_RESULT_OK)
+	{
+		// Falla durante el formateo inicial: con la flash funcionando se vuelve a intentar
+		TEST_CHECK(iap_sim_fault_done(), "inicializacion fallida sin falla programada");
+
+		if(power_loss || (eeprom_open(&eeprom, index) != HAL_EEPROM_RESULT_OK))
+		{
+			goto recover;
+		}
+	}
+
+	for(step = 0; step < EEPROM_STEPS; step++)
+	{
+		key = (step * 5) % EEPROM_MAX_KEYS;
+
+		hal_eeprom_write(&eeprom, key, (step * 0x01000193) ^ key);
+		eeprom_snapshot(&eeprom, &committed);
+
+		if((step % EEPROM_FLUSH_PERIOD) == (EEPROM_FLUSH_PERIOD - 1))
+		{
+			hal_eeprom_flush(&eeprom);
+			eeprom_snapshot(&eeprom, &committed);
+		}
+
+		if(power_loss && iap_sim_fault_done())
+		{
+			break;
+		}
+	}
+
+	if(!power_loss)
+	{
+		// Sin corte, la ultima grabacion debe completar todas las escrituras pendientes
+		TEST_CHECK(hal_eeprom_flush(&eeprom) == HAL_EEPROM_RESULT_OK, "falla %u: grabacion final fallida", fault);
+		eeprom_snapshot(&eeprom, &committed);
+		eeprom_check(&eeprom, &committed, fault, power_loss);
+	}
+
+	if(compactions != NULL)
+	{
+		*compactions = eeprom.compactions;
+	}
+
+recover:
+	faulted = iap_sim_fault_done();
+
+	iap_sim_power_on();
+
+	TEST_CHECK(eeprom_open(&eeprom, index) == HAL_EEPROM_RESULT_OK, "falla %u (corte %u): inicializacion fallida",
+			fault, power_loss);
+	eeprom_check(&eeprom, &committed, fault, power_loss);
+
+	// La EEPROM recuperada debe seguir siendo utilizable
+	TEST_CHECK(hal_eeprom_write(&eeprom, 0, 0x5A5A5A5A) == HAL_EEPROM_RESULT_OK, "falla %u: escritura posterior", fault);
+	TEST_CHECK(hal_eeprom_flush(&eeprom) == HAL_EEPROM_RESULT_OK, "falla %u: grabacion posterior", fault);
+	committed.value[0] = 0x5A5A5A5A;
+
+	TEST_CHECK(eeprom_open(&eeprom, index) == HAL_EEPROM_RESULT_OK, "falla %u: reinicializacion fallida", fault);
+	eeprom_check(&eeprom, &committed, fault, power_loss);
+
+	return faulted;
+}
+
+int main(void)
+{
+	uint32_t compactions = 0;
+	uint32_t fault;
+	uint8_t power_loss;
+
+	eeprom_run(IAP_SIM_NO_FAULT, 0, &compactions);
+	TEST_CHECK(compactions >= 3, "la secuencia realizo %u compactaciones", compactions);
+
+	for(power_loss = 0; power_loss < 2; power_loss++)
+	{
+		for(fault = 0; eeprom_run(fault, power_loss, NULL); fault++);
+
+		TEST_CHECK(fault > 100, "solo se probaron %u operaciones", fault);
+	}
+
+	return TEST_EXIT("test_eeprom");
+}
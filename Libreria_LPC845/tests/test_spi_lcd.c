@@ -0,0 +1,365 @@
+/**
+ * @file test_spi_lcd.c
+ * @brief Prueba en la PC del controlador de displays SPI sobre un controlador simulado
+ *
+ * Verifica el seguimiento de baldosas modificadas, el recorte de los rectangulos en los bordes de la pantalla, y que
+ * ninguna escritura salga del panel dentro de la memoria del controlador.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <HAL_SPI_LCD.h>
+#include "lcd_sim.h"
+#include "test.h"
+
+/** Ancho del panel, no multiplo del tamaño de baldosa */
+#define		LCD_WIDTH					130
+
+/** Alto del panel, no multiplo del tamaño de baldosa */
+#define		LCD_HEIGHT					100
+
+/** Columna de la memoria del controlador correspondiente a la columna 0 del panel */
+#define		LCD_X_OFFSET				2
+
+/** Fila de la memoria del controlador correspondiente a la fila 0 del panel */
+#define		LCD_Y_OFFSET				1
+
+/** Tamaño del buffer de linea, menor al ancho de una baldosa */
+#define		LCD_LINE_BUFFER_LENGTH		7
+
+/** Color de la memoria fuera del panel */
+#define		LCD_OUTSIDE_COLOR			0xDEAD
+
+/** Color de un pixel de la escena */
+#define		LCD_SCENE_COLOR(x, y, generation)	((uint16_t) (((x) * 7) + ((y) * 131) + ((generation) * 4099)))
+
+/** Estadisticas del callback de dibujo */
+typedef struct
+{
+	uint32_t pixels; /**< Pixeles pedidos al callback de dibujo */
+	uint32_t overruns; /**< Segmentos fuera del panel o mayores al buffer de linea */
+}lcd_render_stats_t;
+
+unsigned int test_failures;
+
+static hal_spi_lcd_t lcd; //!< Display bajo prueba
+
+static uint16_t lcd_line_buffer[LCD_LINE_BUFFER_LENGTH]; //!< Buffer de linea
+
+static uint8_t lcd_generation[LCD_HEIGHT][LCD_WIDTH]; //!< Generacion de la escena de cada pixel
+
+static uint8_t lcd_scene_generation; //!< Generacion actual de la escena
+
+static lcd_render_stats_t lcd_render_stats; //!< Estadisticas del callback de dibujo
+
+/**
+ * @brief Callback de dibujo de la escena, verificando que cada segmento este dentro del panel y del buffer de linea
+ * @param[in] x Columna del primer pixel
+ * @param[in] y Fila de los pixeles
+ * @param[in] length Cantidad de pixeles
+ * @param[out] pixels Buffer de linea
+ * @param[in] data Dato de usuario
+ */
+static void lcd_render(uint16_t x, uint16_t y, uint16_t length, uint16_t *pixels, void *data)
+{
+	uint16_t counter;
+
+	if((length == 0) || (length > LCD_LINE_BUFFER_LENGTH) || ((x + length) > LCD_WIDTH) || (y >= LCD_HEIGHT) ||
+		(pixels != lcd_line_buffer))
+	{
+		lcd_render_stats.overruns++;
+		return;
+	}
+
+	for(counter = 0; counter < length; counter++)
+	{
+		pixels[counter] = LCD_SCENE_COLOR(x + counter, y, lcd_scene_generation);
+	}
+
+	lcd_render_stats.pixels += length;
+}
+
+/**
+ * @brief Obtener un pixel del panel de la memoria del controlador
+ * @param[in] x Columna del panel
+ * @param[in] y Fila del panel
+ * @return Color del pixel
+ */
+static uint16_t lcd_panel_pixel(uint16_t x, uint16_t y)
+{
+	return lcd_sim_memory[y + LCD_Y_OFFSET][x + LCD_X_OFFSET];
+}
+
+/**
+ * @brief Verificar que la memoria fuera del panel no se haya modificado
+ */
+static void lcd_check_outside(void)
+{
+	uint32_t errors = 0;
+	uint16_t row;
+	uint16_t column;
+
+	for(row = 0; row < LCD_SIM_MEMORY_HEIGHT; row++)
+	{
+		for(column = 0; column < LCD_SIM_MEMORY_WIDTH; column++)
+		{
+			uint8_t inside = (row >= LCD_Y_OFFSET) && (row < (LCD_Y_OFFSET + LCD_HEIGHT)) &&
+					(column >= LCD_X_OFFSET) && (column < (LCD_X_OFFSET + LCD_WIDTH));
+
+			if(!inside && (lcd_sim_memory[row][column] != LCD_OUTSIDE_COLOR))
+			{
+				errors++;
+			}
+		}
+	}
+
+	TEST_CHECK(errors == 0, "%u pixeles escritos fuera del panel", errors);
+}
+
+/**
+ * @brief Verificar que el panel muestre la escena con la generacion esperada de cada pixel
+ * @param[in] name Nombre del caso
+ */
+static void lcd_check_scene(const char *name)
+{
+	uint32_t errors = 0;
+	uint16_t x;
+	uint16_t y;
+
+	for(y = 0; y < LCD_HEIGHT; y++)
+	{
+		for(x = 0; x < LCD_WIDTH; x++)
+		{
+			if(lcd_panel_pixel(x, y) != LCD_SCENE_COLOR(x, y, lcd_generation[y][x]))
+			{
+				errors++;
+			}
+		}
+	}
+
+	TEST_CHECK(errors == 0, "%s: %u pixeles distintos a la escena", name, errors);
+	TEST_CHECK(lcd_render_stats.overruns == 0, "%s: segmentos de dibujo invalidos", name);
+	lcd_check_outside();
+}
+
+/**
+ * @brief Cambiar la escena en un rectangulo, marcando las baldosas esperadas en la generacion de referencia
+ * @param[in] x Columna del rectangulo
+ * @param[in] y Fila del rectangulo
+ * @param[in] width Ancho del rectangulo
+ * @param[in] height Alto del rectangulo
+ * @return Cantidad de pixeles que deben redibujarse
+ */
+static uint32_t lcd_invalidate(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+	uint32_t pixels = 0;
+	uint16_t column;
+	uint16_t row;
+
+	hal_spi_lcd_invalidate(&lcd, x, y, width, height);
+
+	if((x >= LCD_WIDTH) || (y >= LCD_HEIGHT) || (width == 0) || (height == 0))
+	{
+		return 0;
+	}
+
+	// Toda baldosa que interseca el rectangulo se redibuja completa, recortada al panel
+	for(row = 0; row < LCD_HEIGHT; row++)
+	{
+		for(column = 0; column < LCD_WIDTH; column++)
+		{
+			uint16_t tile_x = column / HAL_SPI_LCD_TILE_SIZE;
+			uint16_t tile_y = row / HAL_SPI_LCD_TILE_SIZE;
+
+			if((tile_x >= (x / HAL_SPI_LCD_TILE_SIZE)) && (tile_x <= ((x + width - 1) / HAL_SPI_LCD_TILE_SIZE)) &&
+				(tile_y >= (y / HAL_SPI_LCD_TILE_SIZE)) && (tile_y <= ((y + height - 1) / HAL_SPI_LCD_TILE_SIZE)) &&
+				(lcd_generation[row][column] != lcd_scene_generation))
+			{
+				lcd_generation[row][column] = lcd_scene_generation;
+				pixels++;
+			}
+		}
+	}
+
+	return pixels;
+}
+
+/**
+ * @brief Redibujar y verificar la cantidad de pixeles pedidos y la escena resultante
+ * @param[in] name Nombre del caso
+ * @param[in] pixels Pixeles que deben redibujarse
+ * @param[in] windows Cantidad de escrituras de memoria esperadas
+ */
+static void lcd_flush_check(const char *name, uint32_t pixels, uint32_t windows)
+{
+	uint32_t ramwr = lcd_sim_stats.ramwr;
+
+	memset(&lcd_render_stats, 0, sizeof(lcd_render_stats));
+
+	hal_spi_lcd_flush(&lcd);
+
+	TEST_CHECK(lcd_render_stats.pixels == pixels, "%s: %u pixeles dibujados, se esperaban %u", name,
+			lcd_render_stats.pixels, pixels);
+	TEST_CHECK(lcd_sim_stats.ramwr - ramwr == windows, "%s: %u ventanas, se esperaban %u", name,
+			lcd_sim_stats.ramwr - ramwr, windows);
+
+	lcd_check_scene(name);
+}
+
+/**
+ * @brief Seguimiento de baldosas modificadas
+ */
+static void lcd_test_dirty(void)
+{
+	uint32_t bytes;
+	uint32_t pixels;
+
+	// Al inicializar se redibuja la pantalla completa
+	lcd_flush_check("inicial", LCD_WIDTH * LCD_HEIGHT, 1);
+
+	// Sin zonas marcadas no se transmite nada
+	bytes = lcd_sim_stats.bytes;
+	lcd_flush_check("sin cambios", 0, 0);
+	TEST_CHECK(lcd_sim_stats.bytes == bytes, "sin cambios: %u bytes transmitidos", lcd_sim_stats.bytes - bytes);
+
+	// Rectangulo no alineado: columnas de baldosas 1 a 3 y filas 0 y 1, en una unica ventana
+	lcd_scene_generation = 1;
+	pixels = lcd_invalidate(20, 5, 30, 20);
+	TEST_CHECK(pixels == (3 * 2 * HAL_SPI_LCD_TILE_SIZE * HAL_SPI_LCD_TILE_SIZE), "baldosas de referencia");
+	lcd_flush_check("rectangulo", pixels, 1);
+
+	// Dos grupos separados en la misma fila de baldosas
+	lcd_scene_generation = 2;
+	pixels = lcd_invalidate(0, 40, 1, 1);
+	pixels += lcd_invalidate(100, 40, 10, 1);
+	lcd_flush_check("dos grupos", pixels, 2);
+
+	// Grupos distintos en filas consecutivas no se combinan
+	lcd_scene_generation = 3;
+	pixels = lcd_invalidate(16, 64, 32, 16);
+	pixels += lcd_invalidate(16, 80, 16, 16);
+	lcd_flush_check("filas distintas", pixels, 2);
+
+	// Rectangulos que exceden la pantalla marcan unicamente las baldosas del borde
+	lcd_scene_generation = 4;
+	pixels = lcd_invalidate(LCD_WIDTH - 2, LCD_HEIGHT - 3, 100, 100);
+	TEST_CHECK(pixels == ((LCD_WIDTH % HAL_SPI_LCD_TILE_SIZE) * (LCD_HEIGHT % HAL_SPI_LCD_TILE_SIZE)), "borde");
+	lcd_flush_check("borde", pixels, 1);
+
+	// Rectangulos fuera de la pantalla no marcan nada
+	lcd_scene_generation = 5;
+	hal_spi_lcd_invalidate(&lcd, LCD_WIDTH, 0, 10, 10);
+	hal_spi_lcd_invalidate(&lcd, 0, LCD_HEIGHT, 10, 10);
+	hal_spi_lcd_invalidate(&lcd, 0, 0, 0, 10);
+	lcd_flush_check("fuera de la pantalla", 0, 0);
+
+	// Pantalla completa
+	lcd_scene_generation = 6;
+	pixels = lcd_invalidate(0, 0, LCD_WIDTH, LCD_HEIGHT);
+	hal_spi_lcd_invalidate_all(&lcd);
+	lcd_flush_check("completa", pixels, 1);
+}
+
+/**
+ * @brief Primitivas directas recortadas en los bordes y omision de ventanas repetidas
+ */
+static void lcd_test_direct(void)
+{
+	static uint16_t icon[12][20];
+	uint32_t errors = 0;
+	uint32_t bytes;
+	uint32_t caset;
+	uint16_t x;
+	uint16_t y;
+
+	for(y = 0; y < 12; y++)
+	{
+		for(x = 0; x < 20; x++)
+		{
+			icon[y][x] = (uint16_t) ((y << 8) | x);
+		}
+	}
+
+	// Dibujo recortado a la derecha y abajo: solo la parte visible, con el paso de fila del origen
+	hal_spi_lcd_draw(&lcd, LCD_WIDTH - 8, LCD_HEIGHT - 5, 20, 12, &icon[0][0]);
+
+	for(y = 0; y < 5; y++)
+	{
+		for(x = 0; x < 8; x++)
+		{
+			if(lcd_panel_pixel(LCD_WIDTH - 8 + x, LCD_HEIGHT - 5 + y) != icon[y][x])
+			{
+				errors++;
+			}
+		}
+	}
+
+	TEST_CHECK(errors == 0, "dibujo recortado: %u pixeles distintos", errors);
+	lcd_check_outside();
+
+	// Dibujo completamente dentro de la pantalla
+	hal_spi_lcd_draw(&lcd, 3, 4, 20, 12, &icon[0][0]);
+	TEST_CHECK((lcd_panel_pixel(3, 4) == icon[0][0]) && (lcd_panel_pixel(22, 15) == icon[11][19]), "dibujo");
+
+	// Fuera de la pantalla no se transmite nada
+	bytes = lcd_sim_stats.bytes;
+	hal_spi_lcd_draw(&lcd, LCD_WIDTH, 0, 20, 12, &icon[0][0]);
+	hal_spi_lcd_fill(&lcd, 0, LCD_HEIGHT, 20, 12, 0x1234);
+	TEST_CHECK(lcd_sim_stats.bytes == bytes, "primitivas fuera de la pantalla transmitieron datos");
+
+	// Relleno recortado
+	hal_spi_lcd_fill(&lcd, LCD_WIDTH - 2, LCD_HEIGHT - 2, 50, 50, 0x1234);
+	TEST_CHECK((lcd_panel_pixel(LCD_WIDTH - 1, LCD_HEIGHT - 1) == 0x1234) &&
+			(lcd_panel_pixel(LCD_WIDTH - 2, LCD_HEIGHT - 2) == 0x1234), "relleno recortado");
+	lcd_check_outside();
+
+	// La misma ventana no vuelve a enviarse, salvo luego de un comando de la aplicacion
+	caset = lcd_sim_stats.caset;
+	hal_spi_lcd_fill(&lcd, 10, 10, 5, 5, 0);
+	hal_spi_lcd_fill(&lcd, 10, 10, 5, 5, 0);
+	TEST_CHECK(lcd_sim_stats.caset - caset == 1, "ventana repetida enviada %u veces", lcd_sim_stats.caset - caset);
+
+	hal_spi_lcd_command(&lcd, 0x29, NULL, 0);
+	hal_spi_lcd_fill(&lcd, 10, 10, 5, 5, 0);
+	TEST_CHECK(lcd_sim_stats.caset - caset == 2, "ventana no enviada luego de un comando");
+}
+
+int main(void)
+{
+	hal_spi_lcd_config_t config =
+	{
+		.spi = HAL_SPI_0,
+		.ssel = HAL_SPI_SSEL_SELECTION_0,
+		.dc_portpin = HAL_GPIO_PORTPIN_1_5,
+		.width = LCD_WIDTH,
+		.height = LCD_HEIGHT,
+		.x_offset = LCD_X_OFFSET,
+		.y_offset = LCD_Y_OFFSET,
+		.line_buffer = lcd_line_buffer,
+		.line_buffer_length = 0,
+		.render_callback = lcd_render,
+		.render_data = NULL
+	};
+
+	lcd_sim_reset(LCD_OUTSIDE_COLOR);
+
+	TEST_CHECK(hal_spi_lcd_init(&lcd, &config) == HAL_SPI_LCD_RESULT_INVALID_CONFIG, "buffer de linea vacio aceptado");
+
+	config.line_buffer_length = LCD_LINE_BUFFER_LENGTH;
+	config.width = HAL_SPI_LCD_MAX_WIDTH + 1;
+	TEST_CHECK(hal_spi_lcd_init(&lcd, &config) == HAL_SPI_LCD_RESULT_INVALID_CONFIG, "ancho excesivo aceptado");
+
+	config.width = LCD_WIDTH;
+	TEST_CHECK(hal_spi_lcd_init(&lcd, &config) == HAL_SPI_LCD_RESULT_OK, "inicializacion");
+
+	lcd_test_dirty();
+	lcd_test_direct();
+
+	TEST_CHECK(lcd_sim_stats.protocol_errors == 0, "%u errores de protocolo", lcd_sim_stats.protocol_errors);
+
+	return TEST_EXIT("test_spi_lcd");
+}
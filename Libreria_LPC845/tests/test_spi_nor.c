@@ -0,0 +1,218 @@
+/**
+ * @file test_spi_nor.c
+ * @brief Prueba en la PC del controlador de memorias flash NOR SPI sobre una memoria simulada
+ *
+ * Verifica la division de las programaciones encoladas en los limites de pagina, el respeto del bit *WIP* entre
+ * operaciones, y la invalidacion del cache de lectura al encolar programaciones y borrados.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <HAL_SPI_NOR.h>
+#include "nor_sim.h"
+#include "test.h"
+
+/** Lecturas de estado que la memoria simulada permanece ocupada luego de cada operacion */
+#define		NOR_BUSY_POLLS				3
+
+/** Maxima cantidad de llamados a @ref hal_spi_nor_poll para vaciar la cola */
+#define		NOR_MAX_POLLS				100000
+
+unsigned int test_failures;
+
+static hal_spi_nor_t nor; //!< Memoria bajo prueba
+
+static uint8_t nor_data[4096]; //!< Datos a programar
+
+/**
+ * @brief Llamar a @ref hal_spi_nor_poll hasta que terminen todas las operaciones
+ * @return Distinto de cero si terminaron
+ */
+static uint8_t nor_drain(void)
+{
+	uint32_t polls;
+
+	for(polls = 0; polls < NOR_MAX_POLLS; polls++)
+	{
+		if(hal_spi_nor_is_idle(&nor))
+		{
+			return 1;
+		}
+
+		hal_spi_nor_poll(&nor);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Programar un bloque y verificar el contenido de la memoria y la cantidad de paginas programadas
+ * @param[in] address Direccion inicial
+ * @param[in] data Datos
+ * @param[in] length Cantidad de bytes
+ */
+static void nor_program_check(uint32_t address, const uint8_t *data, uint32_t length)
+{
+	uint32_t pages = ((address + length - 1) / HAL_SPI_NOR_PAGE_SIZE) - (address / HAL_SPI_NOR_PAGE_SIZE) + 1;
+	uint32_t programs = nor_sim_stats.page_programs;
+	uint8_t readback[sizeof(nor_data)];
+
+	TEST_CHECK(hal_spi_nor_program(&nor, address, data, length) == HAL_SPI_NOR_RESULT_OK, "encolado en 0x%X", address);
+	TEST_CHECK(nor_drain(), "programacion en 0x%X largo %u no termina", address, length);
+
+	TEST_CHECK(memcmp(&nor_sim_memory[address], data, length) == 0, "contenido en 0x%X largo %u", address, length);
+	TEST_CHECK(nor_sim_stats.page_programs - programs == pages, "0x%X largo %u: %u paginas, se esperaban %u", address,
+			length, nor_sim_stats.page_programs - programs, pages);
+
+	// Los bytes vecinos no deben modificarse
+	TEST_CHECK((address == 0) || (nor_sim_memory[address - 1] == 0xFF), "byte anterior a 0x%X modificado", address);
+	TEST_CHECK(nor_sim_memory[address + length] == 0xFF, "byte posterior a 0x%X largo %u modificado", address, length);
+
+	TEST_CHECK(hal_spi_nor_read(&nor, address, readback, length) == HAL_SPI_NOR_RESULT_OK, "lectura en 0x%X", address);
+	TEST_CHECK(memcmp(readback, data, length) == 0, "lectura en 0x%X largo %u", address, length);
+}
+
+/**
+ * @brief Division de programaciones en los limites de pagina
+ */
+static void nor_test_page_split(void)
+{
+	static const uint32_t offsets[] = { 0, 1, 128, 255 };
+	static const uint32_t lengths[] = { 1, 2, 255, 256, 257, 511, 512, 513, 1000, 4096 };
+	uint32_t address = 0;
+	uint8_t offset;
+	uint8_t length;
+
+	nor_sim_reset(NOR_BUSY_POLLS);
+	hal_spi_nor_init(&nor, HAL_SPI_0, HAL_SPI_SSEL_SELECTION_0);
+
+	for(offset = 0; offset < (sizeof(offsets) / sizeof(offsets[0])); offset++)
+	{
+		for(length = 0; length < (sizeof(lengths) / sizeof(lengths[0])); length++)
+		{
+			// Cada caso en paginas nuevas, dejando una pagina libre entre casos
+			address = ((address + HAL_SPI_NOR_PAGE_SIZE - 1) & ~(HAL_SPI_NOR_PAGE_SIZE - 1)) + HAL_SPI_NOR_PAGE_SIZE;
+
+			nor_program_check(address + offsets[offset], &nor_data[offset], lengths[length]);
+
+			address += offsets[offset] + lengths[length];
+		}
+	}
+
+	TEST_CHECK(nor_sim_stats.page_overruns == 0, "%u programaciones cruzaron un limite de pagina",
+			nor_sim_stats.page_overruns);
+}
+
+/**
+ * @brief Varias programaciones encoladas a la vez, y cola llena
+ */
+static void nor_test_queue(void)
+{
+	uint32_t address = 0x1000 + 200;
+	uint8_t counter;
+
+	nor_sim_reset(NOR_BUSY_POLLS);
+	hal_spi_nor_init(&nor, HAL_SPI_0, HAL_SPI_SSEL_SELECTION_0);
+
+	for(counter = 0; counter < HAL_SPI_NOR_QUEUE_LENGTH; counter++)
+	{
+		TEST_CHECK(hal_spi_nor_program(&nor, address + (counter * 300), &nor_data[counter], 300) ==
+				HAL_SPI_NOR_RESULT_OK, "encolado %u", counter);
+	}
+
+	TEST_CHECK(hal_spi_nor_program(&nor, 0, nor_data, 1) == HAL_SPI_NOR_RESULT_QUEUE_FULL, "cola llena no informada");
+	TEST_CHECK(hal_spi_nor_erase(&nor, (hal_spi_nor_erase_en) (HAL_SPI_NOR_ERASE_CHIP + 1), 0) ==
+			HAL_SPI_NOR_RESULT_PARAM_ERROR, "tamaño de borrado invalido aceptado");
+	TEST_CHECK(hal_spi_nor_read(&nor, address, nor_data, 1) == HAL_SPI_NOR_RESULT_BUSY, "lectura con la cola ocupada");
+
+	TEST_CHECK(nor_drain(), "la cola no termina");
+
+	for(counter = 0; counter < HAL_SPI_NOR_QUEUE_LENGTH; counter++)
+	{
+		TEST_CHECK(memcmp(&nor_sim_memory[address + (counter * 300)], &nor_data[counter], 300) == 0, "contenido %u",
+				counter);
+	}
+
+	TEST_CHECK(nor_sim_stats.page_overruns == 0, "%u programaciones cruzaron un limite de pagina",
+			nor_sim_stats.page_overruns);
+}
+
+/**
+ * @brief Invalidacion del cache de lectura al programar y borrar
+ */
+static void nor_test_cache(void)
+{
+	uint32_t address = 0x3000 + 10;
+	uint32_t reads;
+	uint8_t data[8];
+	uint32_t id;
+
+	nor_sim_reset(NOR_BUSY_POLLS);
+	hal_spi_nor_init(&nor, HAL_SPI_0, HAL_SPI_SSEL_SELECTION_0);
+
+	TEST_CHECK((hal_spi_nor_read_id(&nor, &id) == HAL_SPI_NOR_RESULT_OK) && (id == NOR_SIM_JEDEC_ID), "id 0x%06X", id);
+
+	// La lectura chica llena el cache, y las siguientes dentro del mismo bloque no leen la memoria
+	reads = nor_sim_stats.read_commands;
+	TEST_CHECK(hal_spi_nor_read(&nor, address, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(hal_spi_nor_read(&nor, address + 4, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(nor_sim_stats.read_commands - reads == 1, "%u lecturas en lugar de una",
+			nor_sim_stats.read_commands - reads);
+	TEST_CHECK(data[0] == 0xFF, "memoria borrada");
+
+	// Programacion sobre el bloque en el cache
+	TEST_CHECK(hal_spi_nor_program(&nor, address + 4, nor_data, 4) == HAL_SPI_NOR_RESULT_OK, "programacion");
+	TEST_CHECK(nor_drain(), "programacion no termina");
+
+	TEST_CHECK(hal_spi_nor_read(&nor, address + 4, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(memcmp(data, nor_data, 4) == 0, "lectura luego de programar devuelve el cache anterior");
+
+	// Borrado del sector que contiene el bloque en el cache
+	TEST_CHECK(hal_spi_nor_read(&nor, address, data, 8) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(hal_spi_nor_erase(&nor, HAL_SPI_NOR_ERASE_4K, address) == HAL_SPI_NOR_RESULT_OK, "borrado");
+	TEST_CHECK(nor_drain(), "borrado no termina");
+
+	TEST_CHECK(hal_spi_nor_read(&nor, address + 4, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK((data[0] == 0xFF) && (data[3] == 0xFF), "lectura luego de borrar devuelve el cache anterior");
+
+	// Programacion encolada y leida antes de terminar: la lectura se rechaza, y al terminar se lee el dato nuevo
+	TEST_CHECK(hal_spi_nor_read(&nor, address, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(hal_spi_nor_program(&nor, address, &nor_data[100], 4) == HAL_SPI_NOR_RESULT_OK, "programacion");
+	hal_spi_nor_poll(&nor);
+	TEST_CHECK(hal_spi_nor_read(&nor, address, data, 4) == HAL_SPI_NOR_RESULT_BUSY, "lectura con la memoria ocupada");
+	TEST_CHECK(nor_drain(), "programacion no termina");
+	TEST_CHECK(hal_spi_nor_read(&nor, address, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(memcmp(data, &nor_data[100], 4) == 0, "lectura luego de programar devuelve el cache anterior");
+
+	// Las lecturas grandes no pasan por el cache, pero deben ver el contenido actual
+	TEST_CHECK(hal_spi_nor_erase(&nor, HAL_SPI_NOR_ERASE_CHIP, 0) == HAL_SPI_NOR_RESULT_OK, "borrado total");
+	TEST_CHECK(nor_drain(), "borrado total no termina");
+	TEST_CHECK(hal_spi_nor_read(&nor, address, data, 4) == HAL_SPI_NOR_RESULT_OK, "lectura");
+	TEST_CHECK(data[0] == 0xFF, "lectura luego del borrado total devuelve el cache anterior");
+}
+
+int main(void)
+{
+	uint32_t counter;
+
+	srand(845);
+
+	for(counter = 0; counter < sizeof(nor_data); counter++)
+	{
+		// Datos sin bytes 0xFF, para detectar bytes no programados
+		nor_data[counter] = rand() % 0xFF;
+	}
+
+	nor_test_page_split();
+	nor_test_queue();
+	nor_test_cache();
+
+	TEST_CHECK(nor_sim_stats.protocol_errors == 0, "%u errores de protocolo", nor_sim_stats.protocol_errors);
+
+	return TEST_EXIT("test_spi_nor");
+}
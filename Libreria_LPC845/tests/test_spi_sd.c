@@ -0,0 +1,469 @@
+/**
+ * @file test_spi_sd.c
+ * @brief Prueba en la PC del controlador de tarjetas SD en modo SPI sobre una tarjeta simulada
+ *
+ * Verifica el armado de las tramas de comando y su CRC7, la inicializacion y el direccionamiento de cada tipo de
+ * tarjeta, las respuestas R1 de error, los tokens de las lecturas y escrituras de multiples bloques (con y sin CRC),
+ * y que las fases de ocupado se encuesten de a pocos bytes por llamado a @ref hal_spi_sd_process.
+ *
+ * @author Augusto Santini
+ * @date 6/2020
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <HAL_SPI_SD.h>
+#include "sd_sim.h"
+#include "test.h"
+
+/** Divisor de clock de operacion */
+#define		SD_CLOCK_DIV				2
+
+/** Maxima cantidad de llamados a @ref hal_spi_sd_process para terminar una operacion */
+#define		SD_MAX_CALLS				100000
+
+/**
+ * Maxima cantidad de bytes transferidos en un llamado a @ref hal_spi_sd_process: una encuesta, un bloque con su
+ * token y CRC, y un comando con su respuesta
+ */
+#define		SD_MAX_CALL_BYTES			(HAL_SPI_SD_POLL_BYTES + HAL_SPI_SD_BLOCK_SIZE + 32)
+
+/** Tipos de tarjeta a probar */
+typedef enum
+{
+	SD_CARD_V1 = 0,
+	SD_CARD_V2,
+	SD_CARD_SDHC
+}sd_card_en;
+
+unsigned int test_failures;
+
+static hal_spi_sd_t sd; //!< Tarjeta bajo prueba
+
+static uint8_t sd_data[8 * HAL_SPI_SD_BLOCK_SIZE]; //!< Datos a escribir
+
+static uint8_t sd_readback[8 * HAL_SPI_SD_BLOCK_SIZE]; //!< Datos leidos
+
+static uint32_t sd_max_call_bytes; //!< Maxima cantidad de bytes transferidos en un llamado
+
+/**
+ * @brief Obtener la configuracion de una tarjeta sin fallas
+ * @param[in] card Tipo de tarjeta
+ * @return Configuracion de la tarjeta simulada
+ */
+static sd_sim_config_t sd_card(sd_card_en card)
+{
+	sd_sim_config_t config =
+	{
+		.present = 1,
+		.version_1 = (card == SD_CARD_V1),
+		.high_capacity = (card == SD_CARD_SDHC),
+		.init_polls = 5,
+		.response_bytes = 2,
+		.access_bytes = 40,
+		.busy_bytes = 40,
+		.read_crc_block = SD_SIM_NO_BLOCK,
+		.write_reject_block = SD_SIM_NO_BLOCK,
+		.write_crc_block = SD_SIM_NO_BLOCK
+	};
+
+	return config;
+}
+
+/**
+ * @brief Reiniciar la tarjeta simulada e inicializar el controlador
+ * @param[in] card Configuracion de la tarjeta simulada
+ * @param[in] crc_enable Distinto de cero para habilitar la verificacion de CRC
+ */
+static void sd_start(const sd_sim_config_t *card, uint8_t crc_enable)
+{
+	hal_spi_sd_config_t config =
+	{
+		.spi = HAL_SPI_0,
+		.ssel = HAL_SPI_SSEL_SELECTION_0,
+		.init_tx_config = { .clock_mode = HAL_SPI_CLOCK_MODE_0, .clock_div = SD_SIM_INIT_CLOCK_DIV },
+		.tx_config = { .clock_mode = HAL_SPI_CLOCK_MODE_0, .clock_div = SD_CLOCK_DIV },
+		.crc_enable = crc_enable
+	};
+
+	sd_sim_reset(card);
+	hal_spi_sd_init(&sd, &config);
+}
+
+/**
+ * @brief Llamar a @ref hal_spi_sd_process hasta que la operacion en curso termine o espere mas bloques
+ * @return Ultimo estado devuelto
+ */
+static hal_spi_sd_status_en sd_run(void)
+{
+	hal_spi_sd_status_en status = HAL_SPI_SD_STATUS_BUSY;
+	uint32_t calls;
+
+	for(calls = 0; (calls < SD_MAX_CALLS) && (status == HAL_SPI_SD_STATUS_BUSY); calls++)
+	{
+		uint32_t bytes = sd_sim_stats.bytes;
+
+		status = hal_spi_sd_process(&sd);
+
+		if((sd_sim_stats.bytes - bytes) > sd_max_call_bytes)
+		{
+			sd_max_call_bytes = sd_sim_stats.bytes - bytes;
+		}
+	}
+
+	return status;
+}
+
+/**
+ * @brief Verificar que la tarjeta no haya detectado errores de protocolo ni de CRC, y que haya sido liberada
+ * @param[in] name Nombre del caso
+ */
+static void sd_check_clean(const char *name)
+{
+	TEST_CHECK(sd_sim_stats.crc7_errors == 0, "%s: %u comandos con CRC7 incorrecto", name, sd_sim_stats.crc7_errors);
+	TEST_CHECK(sd_sim_stats.framing_errors == 0, "%s: %u comandos sin bit de fin", name, sd_sim_stats.framing_errors);
+	TEST_CHECK(sd_sim_stats.data_crc_errors == 0, "%s: %u bloques con CRC16 incorrecto", name,
+			sd_sim_stats.data_crc_errors);
+	TEST_CHECK(sd_sim_stats.protocol_errors == 0, "%s: %u errores de protocolo", name, sd_sim_stats.protocol_errors);
+	TEST_CHECK(!sd_sim_selected, "%s: slave select activo al terminar", name);
+}
+
+/**
+ * @brief Obtener el argumento del ultimo comando recibido con un indice
+ * @param[in] index Indice del comando
+ * @return Argumento
+ */
+static uint32_t sd_argument(uint8_t index)
+{
+	const uint8_t *frame = sd_sim_stats.frames[index];
+
+	return ((uint32_t) frame[1] << 24) | (frame[2] << 16) | (frame[3] << 8) | frame[4];
+}
+
+/**
+ * @brief Inicializar cada tipo de tarjeta y verificar la secuencia de comandos
+ */
+static void sd_test_init(void)
+{
+	static const uint8_t cmd0[] = { 0x40, 0x00, 0x00, 0x00, 0x00, 0x95 };
+	static const uint8_t cmd8[] = { 0x48, 0x00, 0x00, 0x01, 0xAA, 0x87 };
+	static const hal_spi_sd_type_en types[] =
+	{
+			HAL_SPI_SD_TYPE_SDSC_V1, HAL_SPI_SD_TYPE_SDSC_V2, HAL_SPI_SD_TYPE_SDHC
+	};
+	sd_card_en card;
+	uint8_t crc_enable;
+
+	for(card = SD_CARD_V1; card <= SD_CARD_SDHC; card++)
+	{
+		for(crc_enable = 0; crc_enable <= 1; crc_enable++)
+		{
+			sd_sim_config_t config = sd_card(card);
+
+			sd_start(&config, crc_enable);
+
+			TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "tarjeta %u crc %u: no se inicializa", card, crc_enable);
+			TEST_CHECK(hal_spi_sd_get_type(&sd) == types[card], "tarjeta %u: tipo %u", card, hal_spi_sd_get_type(&sd));
+			TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_NONE, "tarjeta %u: error %u", card,
+					hal_spi_sd_get_error(&sd));
+
+			// Tramas conocidas: el CRC de CMD0 y CMD8 se verifica aun sin habilitar el CRC
+			TEST_CHECK(memcmp(sd_sim_stats.frames[0], cmd0, sizeof(cmd0)) == 0, "trama de CMD0");
+			TEST_CHECK((card == SD_CARD_V1) || (memcmp(sd_sim_stats.frames[8], cmd8, sizeof(cmd8)) == 0),
+					"trama de CMD8");
+
+			TEST_CHECK(sd_sim_stats.app_commands[41] == config.init_polls, "tarjeta %u: %u ACMD41", card,
+					sd_sim_stats.app_commands[41]);
+			TEST_CHECK(!(sd_argument(41) & (1UL << 30)) == (card == SD_CARD_V1), "tarjeta %u: bit HCS de ACMD41", card);
+			TEST_CHECK(sd_sim_stats.commands[58] == (card != SD_CARD_V1), "tarjeta %u: %u CMD58", card,
+					sd_sim_stats.commands[58]);
+			TEST_CHECK(sd_sim_stats.commands[16] == (card != SD_CARD_SDHC), "tarjeta %u: %u CMD16", card,
+					sd_sim_stats.commands[16]);
+			TEST_CHECK(sd_sim_stats.commands[59] == crc_enable, "tarjeta %u: %u CMD59", card,
+					sd_sim_stats.commands[59]);
+			TEST_CHECK(sd_sim_clock_div == SD_CLOCK_DIV, "tarjeta %u: sin configurar el clock de operacion", card);
+
+			sd_check_clean("inicializacion");
+		}
+	}
+}
+
+/**
+ * @brief Verificar los errores de inicializacion
+ */
+static void sd_test_init_errors(void)
+{
+	sd_sim_config_t config;
+
+	config = sd_card(SD_CARD_SDHC);
+	config.present = 0;
+	sd_start(&config, 0);
+	TEST_CHECK(hal_spi_sd_process(&sd) == HAL_SPI_SD_STATUS_ERROR, "sin tarjeta");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_NO_CARD, "sin tarjeta: error %u",
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(hal_spi_sd_read(&sd, 0, sd_readback, 1) == HAL_SPI_SD_RESULT_ERROR, "lectura sin tarjeta");
+
+	// Eco de CMD8 sin la tension pedida
+	config = sd_card(SD_CARD_SDHC);
+	config.voltage_rejected = 1;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "tension rechazada");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_UNSUPPORTED, "tension rechazada: error %u",
+			hal_spi_sd_get_error(&sd));
+
+	// Tarjeta MMC: sin CMD8 ni ACMD41
+	config = sd_card(SD_CARD_V1);
+	config.mmc = 1;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "MMC");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_UNSUPPORTED, "MMC: error %u", hal_spi_sd_get_error(&sd));
+
+	// Tarjeta que nunca termina la inicializacion
+	config = sd_card(SD_CARD_SDHC);
+	config.init_polls = SD_SIM_NO_BLOCK;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "inicializacion sin fin");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_TIMEOUT, "inicializacion sin fin: error %u",
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(sd_sim_stats.app_commands[41] == HAL_SPI_SD_INIT_RETRIES, "%u ACMD41, se esperaban %u",
+			sd_sim_stats.app_commands[41], HAL_SPI_SD_INIT_RETRIES);
+}
+
+/**
+ * @brief Leer bloques y verificar el contenido, el direccionamiento y el fin de la lectura
+ * @param[in] block Primer bloque
+ * @param[in] count Cantidad de bloques
+ * @param[in] name Nombre del caso
+ */
+static void sd_read_check(uint32_t block, uint32_t count, const char *name)
+{
+	uint32_t reads = sd_sim_stats.commands[18];
+	uint32_t stops = sd_sim_stats.commands[12];
+
+	memset(sd_readback, 0, sizeof(sd_readback));
+
+	TEST_CHECK(hal_spi_sd_read(&sd, block, sd_readback, count) == HAL_SPI_SD_RESULT_OK, "%s: lectura", name);
+	TEST_CHECK(hal_spi_sd_read(&sd, block, sd_readback, count) == HAL_SPI_SD_RESULT_BUSY, "%s: lectura en curso", name);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "%s: lectura no termina, error %u", name,
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(memcmp(sd_readback, sd_sim_memory[block], count * HAL_SPI_SD_BLOCK_SIZE) == 0, "%s: contenido", name);
+
+	TEST_CHECK(sd_sim_stats.commands[18] - reads == 1, "%s: %u CMD18", name, sd_sim_stats.commands[18] - reads);
+	TEST_CHECK(sd_sim_stats.commands[12] - stops == 1, "%s: %u CMD12", name, sd_sim_stats.commands[12] - stops);
+	TEST_CHECK(sd_argument(18) == ((hal_spi_sd_get_type(&sd) == HAL_SPI_SD_TYPE_SDHC) ? block :
+			block * HAL_SPI_SD_BLOCK_SIZE), "%s: direccion 0x%X", name, sd_argument(18));
+}
+
+/**
+ * @brief Escribir bloques y verificar el contenido, los tokens y el borrado anticipado
+ * @param[in] block Primer bloque
+ * @param[in] data Datos a escribir
+ * @param[in] count Cantidad de bloques
+ * @param[in] name Nombre del caso
+ */
+static void sd_write_check(uint32_t block, const uint8_t *data, uint32_t count, const char *name)
+{
+	sd_sim_stats_t before = sd_sim_stats;
+
+	memset(sd_sim_memory[block - 1], 0xA5, HAL_SPI_SD_BLOCK_SIZE);
+	memset(sd_sim_memory[block + count], 0xA5, HAL_SPI_SD_BLOCK_SIZE);
+
+	TEST_CHECK(hal_spi_sd_write(&sd, block, data, count) == HAL_SPI_SD_RESULT_OK, "%s: escritura", name);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "%s: escritura no termina, error %u", name,
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(memcmp(sd_sim_memory[block], data, count * HAL_SPI_SD_BLOCK_SIZE) == 0, "%s: contenido", name);
+	TEST_CHECK((sd_sim_memory[block - 1][HAL_SPI_SD_BLOCK_SIZE - 1] == 0xA5) &&
+			(sd_sim_memory[block + count][0] == 0xA5), "%s: bloques vecinos modificados", name);
+
+	TEST_CHECK(sd_sim_stats.app_commands[23] - before.app_commands[23] == 1, "%s: sin ACMD23", name);
+	TEST_CHECK(sd_sim_stats.erase_count == count, "%s: ACMD23 con %u bloques", name, sd_sim_stats.erase_count);
+	TEST_CHECK(sd_sim_stats.commands[25] - before.commands[25] == 1, "%s: CMD25", name);
+	TEST_CHECK(sd_argument(25) == ((hal_spi_sd_get_type(&sd) == HAL_SPI_SD_TYPE_SDHC) ? block :
+			block * HAL_SPI_SD_BLOCK_SIZE), "%s: direccion 0x%X", name, sd_argument(25));
+	TEST_CHECK(sd_sim_stats.start_tokens - before.start_tokens == count, "%s: %u tokens de inicio", name,
+			sd_sim_stats.start_tokens - before.start_tokens);
+	TEST_CHECK(sd_sim_stats.blocks_written - before.blocks_written == count, "%s: %u bloques escritos", name,
+			sd_sim_stats.blocks_written - before.blocks_written);
+	TEST_CHECK(sd_sim_stats.stop_tokens - before.stop_tokens == 1, "%s: token de fin", name);
+}
+
+/**
+ * @brief Lecturas y escrituras de multiples bloques en cada tipo de tarjeta, con y sin CRC
+ */
+static void sd_test_transfers(void)
+{
+	sd_card_en card;
+	uint8_t crc_enable;
+	uint32_t counter;
+
+	for(card = SD_CARD_V1; card <= SD_CARD_SDHC; card++)
+	{
+		for(crc_enable = 0; crc_enable <= 1; crc_enable++)
+		{
+			sd_sim_config_t config = sd_card(card);
+			uint8_t *memory = &sd_sim_memory[0][0];
+
+			for(counter = 0; counter < sizeof(sd_sim_memory); counter++)
+			{
+				memory[counter] = rand();
+			}
+
+			sd_start(&config, crc_enable);
+			TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "tarjeta %u: no se inicializa", card);
+
+			sd_read_check(10, 5, "lectura de 5 bloques");
+			sd_read_check(SD_SIM_BLOCKS - 1, 1, "lectura del ultimo bloque");
+			sd_write_check(20, sd_data, 4, "escritura de 4 bloques");
+			sd_write_check(30, &sd_data[HAL_SPI_SD_BLOCK_SIZE], 1, "escritura de 1 bloque");
+			sd_read_check(20, 4, "lectura de lo escrito");
+
+			sd_check_clean("transferencias");
+		}
+	}
+
+	// Las fases de ocupado y las esperas de token no se resuelven en un solo llamado
+	TEST_CHECK(sd_max_call_bytes <= SD_MAX_CALL_BYTES, "%u bytes en un llamado", sd_max_call_bytes);
+}
+
+/**
+ * @brief Escritura abierta con bloques agregados de a partes
+ */
+static void sd_test_open_write(void)
+{
+	sd_sim_config_t config = sd_card(SD_CARD_SDHC);
+
+	sd_start(&config, 1);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+
+	TEST_CHECK(hal_spi_sd_write_close(&sd) == HAL_SPI_SD_RESULT_BUSY, "cierre sin escritura abierta");
+	TEST_CHECK(hal_spi_sd_write_open(&sd, 40, 0) == HAL_SPI_SD_RESULT_OK, "apertura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_WRITE_READY, "escritura abierta");
+
+	TEST_CHECK(hal_spi_sd_write_append(&sd, sd_data, 2) == HAL_SPI_SD_RESULT_OK, "agregado");
+	TEST_CHECK(hal_spi_sd_write_append(&sd, sd_data, 2) == HAL_SPI_SD_RESULT_BUSY, "agregado en curso");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_WRITE_READY, "primer agregado no termina");
+	TEST_CHECK(hal_spi_sd_write_append(&sd, &sd_data[2 * HAL_SPI_SD_BLOCK_SIZE], 3) == HAL_SPI_SD_RESULT_OK,
+			"agregado");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_WRITE_READY, "segundo agregado no termina");
+	TEST_CHECK(sd_sim_stats.stop_tokens == 0, "escritura cerrada antes de tiempo");
+
+	TEST_CHECK(hal_spi_sd_write_close(&sd) == HAL_SPI_SD_RESULT_OK, "cierre");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "cierre no termina");
+	TEST_CHECK(memcmp(sd_sim_memory[40], sd_data, 5 * HAL_SPI_SD_BLOCK_SIZE) == 0, "contenido");
+
+	TEST_CHECK(sd_sim_stats.app_commands[23] == 0, "ACMD23 sin cantidad de bloques");
+	TEST_CHECK(sd_sim_stats.commands[25] == 1, "%u CMD25", sd_sim_stats.commands[25]);
+	TEST_CHECK(sd_sim_stats.start_tokens == 5, "%u tokens de inicio", sd_sim_stats.start_tokens);
+	TEST_CHECK(sd_sim_stats.stop_tokens == 1, "%u tokens de fin", sd_sim_stats.stop_tokens);
+
+	sd_check_clean("escritura abierta");
+}
+
+/**
+ * @brief Respuestas R1 de error, tokens de error, errores de CRC, rechazos de escritura y tiempos de espera
+ */
+static void sd_test_errors(void)
+{
+	sd_sim_config_t config;
+
+	// Comandos rechazados por direccion fuera de rango
+	config = sd_card(SD_CARD_SDHC);
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_read(&sd, SD_SIM_BLOCKS, sd_readback, 1) == HAL_SPI_SD_RESULT_ERROR, "CMD18 rechazado");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_COMMAND, "CMD18 rechazado: error %u",
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(hal_spi_sd_process(&sd) == HAL_SPI_SD_STATUS_ERROR, "estado luego de un comando rechazado");
+	TEST_CHECK(hal_spi_sd_read(&sd, 0, sd_readback, 1) == HAL_SPI_SD_RESULT_ERROR, "lectura en estado de error");
+
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_write(&sd, SD_SIM_BLOCKS, sd_data, 1) == HAL_SPI_SD_RESULT_ERROR, "CMD25 rechazado");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_COMMAND, "CMD25 rechazado: error %u",
+			hal_spi_sd_get_error(&sd));
+
+	// Token de error al leer mas alla del final de la tarjeta
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_read(&sd, SD_SIM_BLOCKS - 2, sd_readback, 4) == HAL_SPI_SD_RESULT_OK, "lectura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "lectura fuera de rango");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_READ, "token de error: error %u",
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(memcmp(sd_readback, sd_sim_memory[SD_SIM_BLOCKS - 2], 2 * HAL_SPI_SD_BLOCK_SIZE) == 0,
+			"bloques previos al token de error");
+
+	// CRC alterado en un bloque leido: solo se detecta con el CRC habilitado
+	config.read_crc_block = 12;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_read(&sd, 10, sd_readback, 5) == HAL_SPI_SD_RESULT_OK, "lectura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "CRC de lectura verificado sin habilitarlo");
+
+	sd_start(&config, 1);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_read(&sd, 10, sd_readback, 5) == HAL_SPI_SD_RESULT_OK, "lectura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "CRC de lectura alterado");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_CRC, "CRC de lectura: error %u",
+			hal_spi_sd_get_error(&sd));
+
+	// Bloques escritos rechazados por la tarjeta
+	config = sd_card(SD_CARD_SDHC);
+	config.write_reject_block = 21;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_write(&sd, 20, sd_data, 4) == HAL_SPI_SD_RESULT_OK, "escritura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "escritura rechazada");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_WRITE, "escritura rechazada: error %u",
+			hal_spi_sd_get_error(&sd));
+	TEST_CHECK(sd_sim_stats.blocks_written == 1, "%u bloques escritos antes del rechazo", sd_sim_stats.blocks_written);
+
+	config = sd_card(SD_CARD_SDHC);
+	config.write_crc_block = 20;
+	sd_start(&config, 1);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_write(&sd, 20, sd_data, 4) == HAL_SPI_SD_RESULT_OK, "escritura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "CRC de escritura rechazado");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_CRC, "CRC de escritura: error %u",
+			hal_spi_sd_get_error(&sd));
+
+	// Fase de ocupado y espera de token que no terminan
+	config = sd_card(SD_CARD_SDHC);
+	config.busy_bytes = 2 * HAL_SPI_SD_TIMEOUT_BYTES;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_write(&sd, 20, sd_data, 1) == HAL_SPI_SD_RESULT_OK, "escritura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "ocupado sin fin");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_TIMEOUT, "ocupado sin fin: error %u",
+			hal_spi_sd_get_error(&sd));
+
+	config = sd_card(SD_CARD_SDHC);
+	config.access_bytes = 2 * HAL_SPI_SD_TIMEOUT_BYTES;
+	sd_start(&config, 0);
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_READY, "no se inicializa");
+	TEST_CHECK(hal_spi_sd_read(&sd, 10, sd_readback, 1) == HAL_SPI_SD_RESULT_OK, "lectura");
+	TEST_CHECK(sd_run() == HAL_SPI_SD_STATUS_ERROR, "token sin fin");
+	TEST_CHECK(hal_spi_sd_get_error(&sd) == HAL_SPI_SD_ERROR_TIMEOUT, "token sin fin: error %u",
+			hal_spi_sd_get_error(&sd));
+}
+
+int main(void)
+{
+	uint32_t counter;
+
+	srand(845);
+
+	for(counter = 0; counter < sizeof(sd_data); counter++)
+	{
+		sd_data[counter] = rand();
+	}
+
+	sd_test_init();
+	sd_test_init_errors();
+	sd_test_transfers();
+	sd_test_open_write();
+	sd_test_errors();
+
+	return TEST_EXIT("test_spi_sd");
+}